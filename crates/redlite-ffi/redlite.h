@@ -13,6 +13,41 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+/**
+ * Reply kinds stored in `RedliteReply.kind`
+ */
+#define REDLITE_REPLY_NIL 0
+
+#define REDLITE_REPLY_INTEGER 1
+
+#define REDLITE_REPLY_DOUBLE 2
+
+#define REDLITE_REPLY_BYTES 3
+
+#define REDLITE_REPLY_OK 4
+
+#define REDLITE_REPLY_ERROR 5
+
+/**
+ * Bulk load record kinds
+ */
+#define REDLITE_BULK_STRING 0
+
+#define REDLITE_BULK_HASH 1
+
+#define REDLITE_BULK_SET 2
+
+#define REDLITE_BULK_ZSET 3
+
+/**
+ * FT.CREATE field types
+ */
+#define REDLITE_FT_TEXT 0
+
+#define REDLITE_FT_NUMERIC 1
+
+#define REDLITE_FT_TAG 2
+
 /**
  * Opaque handle to a redlite database
  */
@@ -216,6 +251,45 @@ typedef struct RedliteGeoPosArray {
   size_t len;
 } RedliteGeoPosArray;
 
+/**
+ * GEOSEARCH options for redlite_geosearch_hits
+ */
+typedef struct RedliteGeoSearchOptions {
+  const char *from_member;
+  size_t from_member_len;
+  double from_lon;
+  double from_lat;
+  double radius;
+  double width;
+  double height;
+  int unit;
+  int64_t count;
+  int any;
+  int desc;
+} RedliteGeoSearchOptions;
+
+/**
+ * One GEOSEARCH match; `dist` is in the search's unit
+ */
+typedef struct RedliteGeoHit {
+  const uint8_t *member;
+  size_t member_len;
+  double longitude;
+  double latitude;
+  double dist;
+} RedliteGeoHit;
+
+/**
+ * GEOSEARCH matches. Members point into `data`, one buffer owned by the
+ * array, so a result is two allocations however many points match.
+ */
+typedef struct RedliteGeoHitArray {
+  struct RedliteGeoHit *hits;
+  size_t len;
+  uint8_t *data;
+  size_t data_len;
+} RedliteGeoHitArray;
+
 /**
  * Key-value pair for hash operations
  */
@@ -234,6 +308,266 @@ typedef struct RedliteZMember {
   size_t member_len;
 } RedliteZMember;
 
+/**
+ * Sorted set members with binary scores. Each member points into `data`,
+ * a single buffer owned by the array, so a range is two allocations.
+ */
+typedef struct RedliteZMemberArray {
+  struct RedliteZMember *members;
+  size_t len;
+  uint8_t *data;
+  size_t data_len;
+} RedliteZMemberArray;
+
+/**
+ * One SCHEMA entry for redlite_ft_create_schema
+ */
+typedef struct RedliteFtSchemaField {
+  const char *name;
+  size_t name_len;
+  /**
+   * REDLITE_FT_TEXT, _NUMERIC or _TAG
+   */
+  int field_type;
+  int sortable;
+  /**
+   * TEXT weight; 0 means 1.0
+   */
+  double weight;
+} RedliteFtSchemaField;
+
+/**
+ * Returned field of a search hit
+ */
+typedef struct RedliteFtField {
+  const uint8_t *name;
+  size_t name_len;
+  const uint8_t *value;
+  size_t value_len;
+} RedliteFtField;
+
+/**
+ * FT.SEARCH hit; `fields` points into the owning array's field records
+ */
+typedef struct RedliteFtHit {
+  const uint8_t *key;
+  size_t key_len;
+  double score;
+  const struct RedliteFtField *fields;
+  size_t fields_len;
+} RedliteFtHit;
+
+/**
+ * One page of FT.SEARCH hits. Keys, field names and values all point into
+ * `data`, so a page is three allocations however many fields it returns.
+ * `total` counts every match, not just this page; -1 on error.
+ */
+typedef struct RedliteFtHitArray {
+  int64_t total;
+  struct RedliteFtHit *hits;
+  size_t len;
+  struct RedliteFtField *fields;
+  size_t fields_len;
+  uint8_t *data;
+  size_t data_len;
+} RedliteFtHitArray;
+
+/**
+ * FT.SEARCH options for redlite_ft_search_hits
+ */
+typedef struct RedliteFtSearchOptions {
+  /**
+   * LIMIT offset num
+   */
+  int64_t offset;
+  int64_t num;
+  int nocontent;
+  int verbatim;
+  int withscores;
+  /**
+   * RETURN fields; every field when empty
+   */
+  const struct RedliteBytes *return_fields;
+  size_t return_fields_len;
+  /**
+   * SORTBY field, or NULL
+   */
+  const char *sortby;
+  size_t sortby_len;
+  int sortby_desc;
+} RedliteFtSearchOptions;
+
+/**
+ * One record for redlite_bulk_load
+ */
+typedef struct RedliteBulkRecord {
+  /**
+   * REDLITE_BULK_STRING, _HASH, _SET or _ZSET
+   */
+  int kind;
+  const char *key;
+  size_t key_len;
+  /**
+   * Hash field (hash records only)
+   */
+  const char *field;
+  size_t field_len;
+  /**
+   * String value, hash value, or set/sorted set member
+   */
+  const uint8_t *value;
+  size_t value_len;
+  /**
+   * Sorted set score (zset records only)
+   */
+  double score;
+  /**
+   * String TTL in milliseconds, 0 for none (string records only)
+   */
+  int64_t ttl_ms;
+} RedliteBulkRecord;
+
+/**
+ * Connection counters returned by redlite_stats
+ *
+ * Page cache and statement counters are cumulative since open; a cache miss
+ * reads a page from the database file. lock_* counts threads of this process
+ * waiting on each other for the handle.
+ */
+typedef struct RedliteStats {
+  uint64_t cache_hits;
+  uint64_t cache_misses;
+  uint64_t cache_writes;
+  uint64_t cache_spills;
+  uint64_t cache_bytes;
+  /**
+   * Live prepared statements (the statement cache) and their memory
+   */
+  uint64_t statements;
+  uint64_t statement_bytes;
+  /**
+   * Executions of live statements; runs beyond one per statement are cache reuses
+   */
+  uint64_t statement_runs;
+  /**
+   * Explicit WAL checkpoints (redlite_checkpoint) and their durations
+   */
+  uint64_t checkpoints;
+  uint64_t checkpoint_total_us;
+  uint64_t checkpoint_max_us;
+  uint64_t lock_waits;
+  uint64_t lock_wait_ns;
+} RedliteStats;
+
+/**
+ * Connection settings for redlite_open_with_options
+ *
+ * Start from redlite_open_options_default() and change the fields you need.
+ */
+typedef struct RedliteOpenOptions {
+  /**
+   * Page cache size in MB
+   */
+  int64_t cache_mb;
+  /**
+   * Bytes read through memory-mapped I/O (0 disables)
+   */
+  int64_t mmap_size;
+  /**
+   * PRAGMA synchronous: 0 OFF, 1 NORMAL, 2 FULL, 3 EXTRA
+   */
+  int synchronous;
+  /**
+   * Page size for a new database (0 keeps SQLite's default)
+   */
+  uint32_t page_size;
+  /**
+   * WAL pages that trigger an automatic checkpoint (0 disables)
+   */
+  int64_t wal_autocheckpoint;
+  /**
+   * Keep temporary tables and indexes in memory (0 or 1)
+   */
+  int temp_store_memory;
+  int64_t busy_timeout_ms;
+  /**
+   * Prepared statements kept per connection
+   */
+  uintptr_t statement_cache;
+  /**
+   * Create new files with auto_vacuum = INCREMENTAL (0 or 1)
+   */
+  int incremental_vacuum;
+  /**
+   * Memory budget in bytes (0 = unlimited)
+   */
+  uint64_t max_memory;
+  /**
+   * Budget for database pages in use, in bytes (0 = unlimited)
+   */
+  uint64_t max_disk;
+  /**
+   * 0 noeviction, 1 allkeys-lru, 2 allkeys-lfu, 3 allkeys-random,
+   * 4 volatile-lru, 5 volatile-lfu, 6 volatile-ttl, 7 volatile-random
+   */
+  int eviction_policy;
+} RedliteOpenOptions;
+
+/**
+ * Result of one redlite_maintenance_step slice
+ */
+typedef struct RedliteMaintenanceStep {
+  uint64_t keys_reclaimed;
+  uint64_t pages_freed;
+  /**
+   * 1 if an idle WAL checkpoint ran
+   */
+  int checkpointed;
+  /**
+   * 1 if the budget ran out with work left; call again soon
+   */
+  int more;
+  /**
+   * How long the database was held, in microseconds
+   */
+  uint64_t pause_us;
+  /**
+   * Live keys evicted to meet max_disk / max_memory
+   */
+  uint64_t keys_evicted;
+} RedliteMaintenanceStep;
+
+/**
+ * Cumulative counters returned by redlite_maintenance_stats
+ */
+typedef struct RedliteMaintenanceStats {
+  uint64_t steps;
+  uint64_t keys_reclaimed;
+  uint64_t pages_freed;
+  uint64_t checkpoints;
+  uint64_t pause_total_us;
+  uint64_t pause_max_us;
+  uint64_t keys_evicted;
+} RedliteMaintenanceStats;
+
+/**
+ * Result of redlite_export_snapshot / redlite_import_snapshot
+ */
+typedef struct RedliteSnapshotStats {
+  /**
+   * Keys written or loaded (expired keys are skipped)
+   */
+  uint64_t keys;
+  /**
+   * Values, fields, members, entries and coordinates of those keys
+   */
+  uint64_t items;
+  /**
+   * Snapshot file size in bytes
+   */
+  uint64_t bytes;
+} RedliteSnapshotStats;
+
 /**
  * KeyInfo result struct
  */
@@ -260,6 +594,59 @@ typedef struct RedliteKeyInfo {
   int valid;
 } RedliteKeyInfo;
 
+/**
+ * Key version stamp for client-side cache validation
+ */
+typedef struct RedliteKeyVersion {
+  /**
+   * Incremented on every write to the key
+   */
+  uint64_t version;
+  /**
+   * Created at timestamp in milliseconds (changes when a key is recreated)
+   */
+  int64_t created_at;
+} RedliteKeyVersion;
+
+/**
+ * A queued command. `argv[0]` is the command name, the rest are its arguments.
+ */
+typedef struct RedliteCommand {
+  const uint8_t *const *argv;
+  const size_t *argv_len;
+  size_t argc;
+} RedliteCommand;
+
+/**
+ * Result of a single pipelined command
+ */
+typedef struct RedliteReply {
+  /**
+   * One of the REDLITE_REPLY_* kinds
+   */
+  int kind;
+  /**
+   * Set for REDLITE_REPLY_INTEGER
+   */
+  int64_t integer;
+  /**
+   * Set for REDLITE_REPLY_DOUBLE
+   */
+  double number;
+  /**
+   * Set for REDLITE_REPLY_BYTES, or the message for REDLITE_REPLY_ERROR
+   */
+  struct RedliteBytes value;
+} RedliteReply;
+
+/**
+ * Pipeline results, one reply per command in submission order
+ */
+typedef struct RedliteReplyArray {
+  struct RedliteReply *replies;
+  size_t len;
+} RedliteReplyArray;
+
 /**
  * Open a database at the given path
  *
@@ -277,6 +664,17 @@ struct RedliteDb *redlite_open_memory(void);
  */
 struct RedliteDb *redlite_open_with_cache(const char *path, int64_t cache_mb);
 
+/**
+ * Default connection settings (what redlite_open uses)
+ */
+struct RedliteOpenOptions redlite_open_options_default(void);
+
+/**
+ * Open a database with explicit SQLite connection settings
+ */
+struct RedliteDb *redlite_open_with_options(const char *path,
+                                            const struct RedliteOpenOptions *options);
+
 /**
  * Close a database and free resources
  */
@@ -327,6 +725,16 @@ void redlite_free_sscan_result(struct RedliteSScanResult result);
  */
 void redlite_free_zscan_result(struct RedliteZScanResult result);
 
+/**
+ * Free a scored member array
+ */
+void redlite_free_zmember_array(struct RedliteZMemberArray arr);
+
+/**
+ * Free a page of search hits
+ */
+void redlite_free_ft_hit_array(struct RedliteFtHitArray arr);
+
 /**
  * Free a stream entry
  */
@@ -367,6 +775,11 @@ void redlite_free_geo_member_array(struct RedliteGeoMemberArray arr);
  */
 void redlite_free_geo_pos_array(struct RedliteGeoPosArray arr);
 
+/**
+ * Free GEOSEARCH matches
+ */
+void redlite_free_geo_hit_array(struct RedliteGeoHitArray arr);
+
 /**
  * GET key
  */
@@ -1339,6 +1752,16 @@ struct RedliteGeoMemberArray redlite_geosearch(struct RedliteDb *db,
                                                int64_t count,
                                                int withdist);
 
+/**
+ * GEOSEARCH key FROMMEMBER|FROMLONLAT BYRADIUS|BYBOX [ASC|DESC] [COUNT n [ANY]] WITHCOORD WITHDIST
+ * Always returns coordinates and distances, nearest first unless `desc`.
+ * An empty array with redlite_last_error() set means the call failed.
+ */
+struct RedliteGeoHitArray redlite_geosearch_hits(struct RedliteDb *db,
+                                                 const char *key,
+                                                 size_t key_len,
+                                                 const struct RedliteGeoSearchOptions *options);
+
 /**
  * GEOSEARCHSTORE dest source <GEOSEARCH args>
  * Returns number of elements stored
@@ -1360,6 +1783,19 @@ int64_t redlite_geosearchstore(struct RedliteDb *db,
  */
 int64_t redlite_ft_create(struct RedliteDb *db, const char *index_name);
 
+/**
+ * FT.CREATE index ON HASH|JSON PREFIX n prefix... SCHEMA field type [SORTABLE]...
+ * Returns 0 on success, -1 on error
+ */
+int redlite_ft_create_schema(struct RedliteDb *db,
+                             const char *index,
+                             size_t index_len,
+                             int on_json,
+                             const struct RedliteBytes *prefixes,
+                             size_t prefixes_len,
+                             const struct RedliteFtSchemaField *fields,
+                             size_t fields_len);
+
 /**
  * FT.DROPINDEX - Drop search index
  */
@@ -1381,9 +1817,24 @@ int64_t redlite_ft_info(struct RedliteDb *db, const char *_index);
 int64_t redlite_ft_alter(struct RedliteDb *db, const char *_index);
 
 /**
- * FT.SEARCH - stub
+ * FT.SEARCH index query LIMIT 0 0
+ * Returns the number of matching documents, -1 on error.
+ * Use redlite_ft_search_hits for the documents themselves.
  */
-int64_t redlite_ft_search(struct RedliteDb *db, const char *_index, const char *_query);
+int64_t redlite_ft_search(struct RedliteDb *db, const char *index, const char *query);
+
+/**
+ * FT.SEARCH index query [NOCONTENT] [VERBATIM] [WITHSCORES] [RETURN ...]
+ * [SORTBY field [ASC|DESC]] [LIMIT offset num]
+ * NULL options means LIMIT 0 10 with every field. Returns one page of
+ * hits; free with redlite_free_ft_hit_array. total is -1 on error.
+ */
+struct RedliteFtHitArray redlite_ft_search_hits(struct RedliteDb *db,
+                                                const char *index,
+                                                size_t index_len,
+                                                const char *query,
+                                                size_t query_len,
+                                                const struct RedliteFtSearchOptions *options);
 
 /**
  * FT.ALIASADD - stub
@@ -1433,6 +1884,46 @@ int64_t redlite_ft_sugdel(struct RedliteDb *db, const char *_key, const char *_s
  */
 int64_t redlite_ft_suglen(struct RedliteDb *db, const char *_key);
 
+/**
+ * VADD key FP32 values element [SETATTR attributes]
+ * Returns 1 if added, 0 if updated, -1 on error
+ */
+int redlite_vadd(struct RedliteDb *db,
+                 const char *key,
+                 const float *values,
+                 size_t dim,
+                 const char *element,
+                 const char *attributes);
+
+/**
+ * VSIM key FP32 query COUNT count
+ * Writes up to `count` scores (descending) into `scores_out` and, if
+ * `elements_out` is non-NULL, the matching element names into it.
+ * nprobe: IVF lists to scan (-1 = default, 0 = exact scan)
+ * Returns the number of results, -1 on error
+ */
+int64_t redlite_vsim(struct RedliteDb *db,
+                     const char *key,
+                     const float *query,
+                     size_t dim,
+                     size_t count,
+                     int64_t nprobe,
+                     struct RedliteStringArray *elements_out,
+                     double *scores_out);
+
+/**
+ * VINDEX key [NLIST nlist]
+ * Builds the IVF index used by VSIM (nlist 0 = sqrt of the cardinality)
+ * Returns the number of lists built, -1 on error
+ */
+int64_t redlite_vindex(struct RedliteDb *db, const char *key, size_t nlist);
+
+/**
+ * Drop the IVF index of a vector set
+ * Returns 1 if an index was dropped, 0 if none existed, -1 on error
+ */
+int redlite_vindex_drop(struct RedliteDb *db, const char *key);
+
 /**
  * HISTORY GET key [LIMIT limit] [SINCE timestamp] [UNTIL timestamp]
  * Returns array of history entries for the key
@@ -1474,11 +1965,73 @@ int64_t redlite_history_clear(struct RedliteDb *db, const char *key, int64_t bef
  */
 int64_t redlite_history_prune(struct RedliteDb *db, int64_t before_timestamp);
 
+/**
+ * HISTORY PRUNE before_timestamp, at most `limit` of the oldest entries
+ * Returns number deleted, fewer than `limit` once none are left; -1 on error
+ */
+int64_t redlite_history_prune_batch(struct RedliteDb *db, int64_t before_timestamp, int64_t limit);
+
 /**
  * VACUUM - compact the database
  */
 int64_t redlite_vacuum(struct RedliteDb *db);
 
+/**
+ * Enable or disable automatic cleanup of expired keys on this handle
+ * Returns 0 on success, -1 on error
+ */
+int redlite_set_autovacuum(struct RedliteDb *db, int enabled);
+
+/**
+ * Set the autovacuum interval in milliseconds (minimum 1000)
+ * Returns 0 on success, -1 on error
+ */
+int redlite_set_autovacuum_interval(struct RedliteDb *db, int64_t interval_ms);
+
+/**
+ * Get the autovacuum interval in milliseconds, -1 on error
+ */
+int64_t redlite_autovacuum_interval(struct RedliteDb *db);
+
+/**
+ * Set the time budget of one expiration / vacuum slice in microseconds
+ * (minimum 100)
+ * Returns 0 on success, -1 on error
+ */
+int redlite_set_autovacuum_budget(struct RedliteDb *db, int64_t budget_us);
+
+/**
+ * Get the autovacuum slice budget in microseconds, -1 on error
+ */
+int64_t redlite_autovacuum_budget(struct RedliteDb *db);
+
+/**
+ * Run one bounded maintenance slice: expire keys, incremental vacuum, and an
+ * idle WAL checkpoint. budget_us <= 0 uses the autovacuum budget.
+ * Returns 0 on success, -1 on error
+ */
+int redlite_maintenance_step(struct RedliteDb *db,
+                             int64_t budget_us,
+                             struct RedliteMaintenanceStep *out);
+
+/**
+ * Fill `out` with cumulative maintenance counters
+ * Returns 0 on success, -1 on error
+ */
+int redlite_maintenance_stats(struct RedliteDb *db, struct RedliteMaintenanceStats *out);
+
+/**
+ * Checkpoint the WAL and truncate it
+ * Returns 0 on success, -1 on error
+ */
+int redlite_checkpoint(struct RedliteDb *db);
+
+/**
+ * Fill `out` with page cache, statement, checkpoint and lock-wait counters
+ * Returns 0 on success, -1 on error
+ */
+int redlite_stats(struct RedliteDb *db, struct RedliteStats *out);
+
 /**
  * Get library version
  */
@@ -1573,8 +2126,31 @@ char *redlite_json_arrpop(struct RedliteDb *db,
 int64_t redlite_json_clear(struct RedliteDb *db, const char *key, const char *path);
 
 /**
- * HISTORY ENABLE GLOBAL [retention_type] [retention_value]
- * Enable history tracking globally.
+ * JSON.SET many paths on one document: paths[i] gets values[i], applied in
+ * order with a single parse and write. Returns 1 on success, 0 if a path
+ * could not be set, -1 on error (nothing is written unless it returns 1).
+ */
+int redlite_json_set_many(struct RedliteDb *db,
+                          const char *key,
+                          size_t key_len,
+                          const struct RedliteBytes *paths,
+                          const struct RedliteBytes *values,
+                          size_t len);
+
+/**
+ * JSON.GET many paths from one document, one item per path. An item with
+ * NULL data means nothing matched that path. A NULL array with
+ * redlite_last_error() set means the call failed.
+ */
+struct RedliteBytesArray redlite_json_get_many(struct RedliteDb *db,
+                                               const char *key,
+                                               size_t key_len,
+                                               const struct RedliteBytes *paths,
+                                               size_t paths_len);
+
+/**
+ * HISTORY ENABLE GLOBAL [retention_type] [retention_value]
+ * Enable history tracking globally.
  * retention_type: 0=Unlimited, 1=Time(ms), 2=Count
  */
 int redlite_history_enable_global(struct RedliteDb *db,
@@ -1688,4 +2264,940 @@ void redlite_free_keyinfo(struct RedliteKeyInfo info);
  */
 struct RedliteKeyInfo redlite_keyinfo(struct RedliteDb *db, const char *key);
 
+/**
+ * Get the version stamp of a key (data + length).
+ * Returns 1 and fills `out` if the key exists, 0 if it doesn't, -1 on error.
+ */
+int redlite_key_version_len(struct RedliteDb *db,
+                            const char *key,
+                            size_t key_len,
+                            struct RedliteKeyVersion *out);
+
+/**
+ * GET key
+ */
+struct RedliteBytes redlite_get_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * SET key value [ttl_seconds]
+ * Returns 0 on success, -1 on error
+ */
+int redlite_set_len(struct RedliteDb *db,
+                    const char *key,
+                    size_t key_len,
+                    const uint8_t *value,
+                    size_t value_len,
+                    int64_t ttl_seconds);
+
+/**
+ * SETEX key seconds value
+ */
+int redlite_setex_len(struct RedliteDb *db,
+                      const char *key,
+                      size_t key_len,
+                      int64_t seconds,
+                      const uint8_t *value,
+                      size_t value_len);
+
+/**
+ * PSETEX key milliseconds value
+ */
+int redlite_psetex_len(struct RedliteDb *db,
+                       const char *key,
+                       size_t key_len,
+                       int64_t milliseconds,
+                       const uint8_t *value,
+                       size_t value_len);
+
+/**
+ * GETDEL key
+ */
+struct RedliteBytes redlite_getdel_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * APPEND key value
+ * Returns new length, or -1 on error
+ */
+int64_t redlite_append_len(struct RedliteDb *db,
+                           const char *key,
+                           size_t key_len,
+                           const uint8_t *value,
+                           size_t value_len);
+
+/**
+ * STRLEN key
+ */
+int64_t redlite_strlen_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * GETRANGE key start end
+ */
+struct RedliteBytes redlite_getrange_len(struct RedliteDb *db,
+                                         const char *key,
+                                         size_t key_len,
+                                         int64_t start,
+                                         int64_t end);
+
+/**
+ * SETRANGE key offset value
+ */
+int64_t redlite_setrange_len(struct RedliteDb *db,
+                             const char *key,
+                             size_t key_len,
+                             int64_t offset,
+                             const uint8_t *value,
+                             size_t value_len);
+
+/**
+ * INCR key
+ */
+int64_t redlite_incr_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * DECR key
+ */
+int64_t redlite_decr_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * INCRBY key increment
+ */
+int64_t redlite_incrby_len(struct RedliteDb *db,
+                           const char *key,
+                           size_t key_len,
+                           int64_t increment);
+
+/**
+ * DECRBY key decrement
+ */
+int64_t redlite_decrby_len(struct RedliteDb *db,
+                           const char *key,
+                           size_t key_len,
+                           int64_t decrement);
+
+/**
+ * INCRBYFLOAT key increment
+ * Returns result as string (caller must free), NULL on error
+ */
+char *redlite_incrbyfloat_len(struct RedliteDb *db,
+                              const char *key,
+                              size_t key_len,
+                              double increment);
+
+/**
+ * MGET key [key ...]
+ * Missing keys are returned as NULL items
+ */
+struct RedliteBytesArray redlite_mget_len(struct RedliteDb *db,
+                                          const struct RedliteBytes *keys,
+                                          size_t keys_len);
+
+/**
+ * MSET key value [key value ...]
+ * `keys` and `values` are parallel arrays of `count` items
+ */
+int redlite_mset_len(struct RedliteDb *db,
+                     const struct RedliteBytes *keys,
+                     const struct RedliteBytes *values,
+                     size_t count);
+
+/**
+ * DEL key [key ...]
+ */
+int64_t redlite_del_len(struct RedliteDb *db, const struct RedliteBytes *keys, size_t keys_len);
+
+/**
+ * EXISTS key [key ...]
+ */
+int64_t redlite_exists_len(struct RedliteDb *db, const struct RedliteBytes *keys, size_t keys_len);
+
+/**
+ * TYPE key
+ * Returns type string (caller must free), NULL on error
+ */
+char *redlite_type_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * TTL key
+ * Returns -2 if key doesn't exist, -1 if no TTL, otherwise seconds
+ */
+int64_t redlite_ttl_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * PTTL key
+ * Returns -2 if key doesn't exist, -1 if no TTL, otherwise milliseconds
+ */
+int64_t redlite_pttl_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * EXPIRE key seconds
+ */
+int redlite_expire_len(struct RedliteDb *db, const char *key, size_t key_len, int64_t seconds);
+
+/**
+ * PEXPIRE key milliseconds
+ */
+int redlite_pexpire_len(struct RedliteDb *db,
+                        const char *key,
+                        size_t key_len,
+                        int64_t milliseconds);
+
+/**
+ * EXPIREAT key unix_seconds
+ */
+int redlite_expireat_len(struct RedliteDb *db,
+                         const char *key,
+                         size_t key_len,
+                         int64_t unix_seconds);
+
+/**
+ * PEXPIREAT key unix_ms
+ */
+int redlite_pexpireat_len(struct RedliteDb *db, const char *key, size_t key_len, int64_t unix_ms);
+
+/**
+ * PERSIST key
+ */
+int redlite_persist_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * RENAME key newkey
+ */
+int redlite_rename_len(struct RedliteDb *db,
+                       const char *key,
+                       size_t key_len,
+                       const char *newkey,
+                       size_t newkey_len);
+
+/**
+ * RENAMENX key newkey
+ */
+int redlite_renamenx_len(struct RedliteDb *db,
+                         const char *key,
+                         size_t key_len,
+                         const char *newkey,
+                         size_t newkey_len);
+
+/**
+ * HSET key field value [field value ...]
+ * `fields` and `values` are parallel arrays of `count` items
+ */
+int64_t redlite_hset_len(struct RedliteDb *db,
+                         const char *key,
+                         size_t key_len,
+                         const struct RedliteBytes *fields,
+                         const struct RedliteBytes *values,
+                         size_t count);
+
+/**
+ * HGET key field
+ */
+struct RedliteBytes redlite_hget_len(struct RedliteDb *db,
+                                     const char *key,
+                                     size_t key_len,
+                                     const char *field,
+                                     size_t field_len);
+
+/**
+ * HDEL key field [field ...]
+ */
+int64_t redlite_hdel_len(struct RedliteDb *db,
+                         const char *key,
+                         size_t key_len,
+                         const struct RedliteBytes *fields,
+                         size_t fields_len);
+
+/**
+ * HEXISTS key field
+ */
+int redlite_hexists_len(struct RedliteDb *db,
+                        const char *key,
+                        size_t key_len,
+                        const char *field,
+                        size_t field_len);
+
+/**
+ * HLEN key
+ */
+int64_t redlite_hlen_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * HKEYS key
+ */
+struct RedliteStringArray redlite_hkeys_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * HVALS key
+ */
+struct RedliteBytesArray redlite_hvals_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * HINCRBY key field increment
+ */
+int64_t redlite_hincrby_len(struct RedliteDb *db,
+                            const char *key,
+                            size_t key_len,
+                            const char *field,
+                            size_t field_len,
+                            int64_t increment);
+
+/**
+ * HGETALL key
+ * Returns alternating field-value pairs
+ */
+struct RedliteBytesArray redlite_hgetall_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * HMGET key field [field ...]
+ */
+struct RedliteBytesArray redlite_hmget_len(struct RedliteDb *db,
+                                           const char *key,
+                                           size_t key_len,
+                                           const struct RedliteBytes *fields,
+                                           size_t fields_len);
+
+/**
+ * LPUSH key value [value ...]
+ */
+int64_t redlite_lpush_len(struct RedliteDb *db,
+                          const char *key,
+                          size_t key_len,
+                          const struct RedliteBytes *values,
+                          size_t values_len);
+
+/**
+ * RPUSH key value [value ...]
+ */
+int64_t redlite_rpush_len(struct RedliteDb *db,
+                          const char *key,
+                          size_t key_len,
+                          const struct RedliteBytes *values,
+                          size_t values_len);
+
+/**
+ * LPOP key [count]
+ */
+struct RedliteBytesArray redlite_lpop_len(struct RedliteDb *db,
+                                          const char *key,
+                                          size_t key_len,
+                                          size_t count);
+
+/**
+ * RPOP key [count]
+ */
+struct RedliteBytesArray redlite_rpop_len(struct RedliteDb *db,
+                                          const char *key,
+                                          size_t key_len,
+                                          size_t count);
+
+/**
+ * LLEN key
+ */
+int64_t redlite_llen_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * LRANGE key start stop
+ */
+struct RedliteBytesArray redlite_lrange_len(struct RedliteDb *db,
+                                            const char *key,
+                                            size_t key_len,
+                                            int64_t start,
+                                            int64_t stop);
+
+/**
+ * LINDEX key index
+ */
+struct RedliteBytes redlite_lindex_len(struct RedliteDb *db,
+                                       const char *key,
+                                       size_t key_len,
+                                       int64_t index);
+
+/**
+ * SADD key member [member ...]
+ */
+int64_t redlite_sadd_len(struct RedliteDb *db,
+                         const char *key,
+                         size_t key_len,
+                         const struct RedliteBytes *members,
+                         size_t members_len);
+
+/**
+ * SREM key member [member ...]
+ */
+int64_t redlite_srem_len(struct RedliteDb *db,
+                         const char *key,
+                         size_t key_len,
+                         const struct RedliteBytes *members,
+                         size_t members_len);
+
+/**
+ * SMEMBERS key
+ */
+struct RedliteBytesArray redlite_smembers_len(struct RedliteDb *db,
+                                              const char *key,
+                                              size_t key_len);
+
+/**
+ * SISMEMBER key member
+ */
+int redlite_sismember_len(struct RedliteDb *db,
+                          const char *key,
+                          size_t key_len,
+                          const uint8_t *member,
+                          size_t member_len);
+
+/**
+ * SCARD key
+ */
+int64_t redlite_scard_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * ZADD key score member [score member ...]
+ */
+int64_t redlite_zadd_len(struct RedliteDb *db,
+                         const char *key,
+                         size_t key_len,
+                         const struct RedliteZMember *members,
+                         size_t members_len);
+
+/**
+ * ZREM key member [member ...]
+ */
+int64_t redlite_zrem_len(struct RedliteDb *db,
+                         const char *key,
+                         size_t key_len,
+                         const struct RedliteBytes *members,
+                         size_t members_len);
+
+/**
+ * ZSCORE key member
+ * Returns NaN if not found or on error
+ */
+double redlite_zscore_len(struct RedliteDb *db,
+                          const char *key,
+                          size_t key_len,
+                          const uint8_t *member,
+                          size_t member_len);
+
+/**
+ * ZCARD key
+ */
+int64_t redlite_zcard_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * ZCOUNT key min max
+ */
+int64_t redlite_zcount_len(struct RedliteDb *db,
+                           const char *key,
+                           size_t key_len,
+                           double min,
+                           double max);
+
+/**
+ * ZINCRBY key increment member
+ */
+double redlite_zincrby_len(struct RedliteDb *db,
+                           const char *key,
+                           size_t key_len,
+                           double increment,
+                           const uint8_t *member,
+                           size_t member_len);
+
+/**
+ * ZRANGE key start stop [withscores]
+ * If withscores is true, returns alternating member-score pairs
+ */
+struct RedliteBytesArray redlite_zrange_len(struct RedliteDb *db,
+                                            const char *key,
+                                            size_t key_len,
+                                            int64_t start,
+                                            int64_t stop,
+                                            int with_scores);
+
+/**
+ * ZREVRANGE key start stop [withscores]
+ * If withscores is true, returns alternating member-score pairs
+ */
+struct RedliteBytesArray redlite_zrevrange_len(struct RedliteDb *db,
+                                               const char *key,
+                                               size_t key_len,
+                                               int64_t start,
+                                               int64_t stop,
+                                               int with_scores);
+
+/**
+ * ZRANGE key start stop WITHSCORES
+ * Returns members with binary scores; free with redlite_free_zmember_array
+ */
+struct RedliteZMemberArray redlite_zrange_scored_len(struct RedliteDb *db,
+                                                     const char *key,
+                                                     size_t key_len,
+                                                     int64_t start,
+                                                     int64_t stop);
+
+/**
+ * ZREVRANGE key start stop WITHSCORES
+ * Returns members with binary scores; free with redlite_free_zmember_array
+ */
+struct RedliteZMemberArray redlite_zrevrange_scored_len(struct RedliteDb *db,
+                                                        const char *key,
+                                                        size_t key_len,
+                                                        int64_t start,
+                                                        int64_t stop);
+
+/**
+ * ZRANGEBYSCORE key min max WITHSCORES [LIMIT offset count]
+ * offset/count: use -1 for none
+ * Returns members with binary scores; free with redlite_free_zmember_array
+ */
+struct RedliteZMemberArray redlite_zrangebyscore_scored_len(struct RedliteDb *db,
+                                                            const char *key,
+                                                            size_t key_len,
+                                                            double min,
+                                                            double max,
+                                                            int64_t offset,
+                                                            int64_t count);
+
+/**
+ * ZRANK key member
+ * Returns rank (0-based), -1 if not found, -2 on error
+ */
+int64_t redlite_zrank_len(struct RedliteDb *db,
+                          const char *key,
+                          size_t key_len,
+                          const uint8_t *member,
+                          size_t member_len);
+
+/**
+ * ZREVRANK key member
+ * Returns reverse rank (0-based), -1 if not found, -2 on error
+ */
+int64_t redlite_zrevrank_len(struct RedliteDb *db,
+                             const char *key,
+                             size_t key_len,
+                             const uint8_t *member,
+                             size_t member_len);
+
+/**
+ * GETBIT key offset
+ * Returns bit value (0 or 1), or -1 on error
+ */
+int64_t redlite_getbit_len(struct RedliteDb *db, const char *key, size_t key_len, uint64_t offset);
+
+/**
+ * SETBIT key offset value
+ * Returns previous bit value (0 or 1), or -1 on error
+ */
+int64_t redlite_setbit_len(struct RedliteDb *db,
+                           const char *key,
+                           size_t key_len,
+                           uint64_t offset,
+                           int value);
+
+/**
+ * BITCOUNT key [start end]
+ * Returns number of set bits, or -1 on error
+ */
+int64_t redlite_bitcount_len(struct RedliteDb *db,
+                             const char *key,
+                             size_t key_len,
+                             int64_t start,
+                             int64_t end,
+                             int use_range);
+
+/**
+ * BITOP operation destkey key [key ...]
+ * Returns length of result string, or -1 on error
+ * operation: "AND", "OR", "XOR", "NOT"
+ */
+int64_t redlite_bitop_len(struct RedliteDb *db,
+                          const char *operation,
+                          const char *destkey,
+                          size_t destkey_len,
+                          const struct RedliteBytes *keys,
+                          size_t keys_len);
+
+/**
+ * XADD key [NOMKSTREAM] [MAXLEN threshold] *|ID field value [field value ...]
+ * Returns the entry ID, or {-1, -1} on error. An ID of {0, 0} auto-generates one.
+ */
+struct RedliteStreamId redlite_xadd_len(struct RedliteDb *db,
+                                        const char *key,
+                                        size_t key_len,
+                                        int64_t id_ms,
+                                        int64_t id_seq,
+                                        const struct RedliteStreamField *fields,
+                                        size_t fields_len,
+                                        int nomkstream,
+                                        int64_t maxlen,
+                                        int use_maxlen);
+
+/**
+ * XLEN key
+ * Returns stream length, or -1 on error
+ */
+int64_t redlite_xlen_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * XRANGE key start end [COUNT count]
+ */
+struct RedliteStreamEntryArray redlite_xrange_len(struct RedliteDb *db,
+                                                  const char *key,
+                                                  size_t key_len,
+                                                  int64_t start_ms,
+                                                  int64_t start_seq,
+                                                  int64_t end_ms,
+                                                  int64_t end_seq,
+                                                  int64_t count,
+                                                  int use_count);
+
+/**
+ * XREVRANGE key end start [COUNT count]
+ */
+struct RedliteStreamEntryArray redlite_xrevrange_len(struct RedliteDb *db,
+                                                     const char *key,
+                                                     size_t key_len,
+                                                     int64_t end_ms,
+                                                     int64_t end_seq,
+                                                     int64_t start_ms,
+                                                     int64_t start_seq,
+                                                     int64_t count,
+                                                     int use_count);
+
+/**
+ * XREAD [COUNT count] STREAMS key id - single key
+ */
+struct RedliteStreamEntryArray redlite_xread_len(struct RedliteDb *db,
+                                                 const char *key,
+                                                 size_t key_len,
+                                                 int64_t id_ms,
+                                                 int64_t id_seq,
+                                                 int64_t count,
+                                                 int use_count);
+
+/**
+ * XTRIM key MAXLEN count
+ * Returns number of entries deleted, or -1 on error
+ */
+int64_t redlite_xtrim_len(struct RedliteDb *db, const char *key, size_t key_len, int64_t maxlen);
+
+/**
+ * XDEL key id [id ...]
+ * Returns number of entries deleted, or -1 on error
+ */
+int64_t redlite_xdel_len(struct RedliteDb *db,
+                         const char *key,
+                         size_t key_len,
+                         const struct RedliteStreamId *ids,
+                         size_t ids_len);
+
+/**
+ * XGROUP CREATE key group id [MKSTREAM]
+ * Returns 1 on success, 0 on error
+ */
+int redlite_xgroup_create_len(struct RedliteDb *db,
+                              const char *key,
+                              size_t key_len,
+                              const char *group,
+                              size_t group_len,
+                              int64_t id_ms,
+                              int64_t id_seq,
+                              int mkstream);
+
+/**
+ * XGROUP DESTROY key group
+ * Returns 1 if group was destroyed, 0 otherwise
+ */
+int redlite_xgroup_destroy_len(struct RedliteDb *db,
+                               const char *key,
+                               size_t key_len,
+                               const char *group,
+                               size_t group_len);
+
+/**
+ * XGROUP SETID key group id
+ * Returns 1 on success, 0 if group doesn't exist, -1 on error
+ */
+int64_t redlite_xgroup_setid_len(struct RedliteDb *db,
+                                 const char *key,
+                                 size_t key_len,
+                                 const char *group,
+                                 size_t group_len,
+                                 int64_t id_ms,
+                                 int64_t id_seq);
+
+/**
+ * XGROUP CREATECONSUMER key group consumer
+ * Returns 1 if consumer was created, 0 if it already existed, -1 on error
+ */
+int64_t redlite_xgroup_createconsumer_len(struct RedliteDb *db,
+                                          const char *key,
+                                          size_t key_len,
+                                          const char *group,
+                                          size_t group_len,
+                                          const char *consumer,
+                                          size_t consumer_len);
+
+/**
+ * XGROUP DELCONSUMER key group consumer
+ * Returns number of pending messages consumer had, or -1 on error
+ */
+int64_t redlite_xgroup_delconsumer_len(struct RedliteDb *db,
+                                       const char *key,
+                                       size_t key_len,
+                                       const char *group,
+                                       size_t group_len,
+                                       const char *consumer,
+                                       size_t consumer_len);
+
+/**
+ * XREADGROUP GROUP group consumer [COUNT count] [NOACK] STREAMS key id - single key
+ * Use ">" for id to get new messages
+ */
+struct RedliteStreamEntryArray redlite_xreadgroup_len(struct RedliteDb *db,
+                                                      const char *group,
+                                                      size_t group_len,
+                                                      const char *consumer,
+                                                      size_t consumer_len,
+                                                      const char *key,
+                                                      size_t key_len,
+                                                      const char *id,
+                                                      size_t id_len,
+                                                      int64_t count,
+                                                      int use_count,
+                                                      int noack);
+
+/**
+ * XACK key group id [id ...]
+ * Returns number of messages acknowledged, or -1 on error
+ */
+int64_t redlite_xack_len(struct RedliteDb *db,
+                         const char *key,
+                         size_t key_len,
+                         const char *group,
+                         size_t group_len,
+                         const struct RedliteStreamId *ids,
+                         size_t ids_len);
+
+/**
+ * VADD key FP32 values element [SETATTR attributes]
+ * `attributes` NULL means none. Returns 1 if added, 0 if updated, -1 on error
+ */
+int redlite_vadd_len(struct RedliteDb *db,
+                     const char *key,
+                     size_t key_len,
+                     const float *values,
+                     size_t dim,
+                     const char *element,
+                     size_t element_len,
+                     const char *attributes,
+                     size_t attributes_len);
+
+/**
+ * VSIM key FP32 query COUNT count, as `redlite_vsim`
+ * Returns the number of results, -1 on error
+ */
+int64_t redlite_vsim_len(struct RedliteDb *db,
+                         const char *key,
+                         size_t key_len,
+                         const float *query,
+                         size_t dim,
+                         size_t count,
+                         int64_t nprobe,
+                         struct RedliteStringArray *elements_out,
+                         double *scores_out);
+
+/**
+ * VINDEX key [NLIST nlist]
+ * Returns the number of lists built, -1 on error
+ */
+int64_t redlite_vindex_len(struct RedliteDb *db, const char *key, size_t key_len, size_t nlist);
+
+/**
+ * Drop the IVF index of a vector set
+ * Returns 1 if an index was dropped, 0 if none existed, -1 on error
+ */
+int redlite_vindex_drop_len(struct RedliteDb *db, const char *key, size_t key_len);
+
+/**
+ * GEOADD key [NX|XX] [CH] longitude latitude member [...]
+ * Member names in `members` are NUL-terminated. Returns the count, or -1 on error
+ */
+int64_t redlite_geoadd_len(struct RedliteDb *db,
+                           const char *key,
+                           size_t key_len,
+                           const struct RedliteGeoMember *members,
+                           size_t members_len,
+                           int nx,
+                           int xx,
+                           int ch);
+
+/**
+ * GEOPOS key member [member ...]
+ * Returns one position per member (`exists` 0 where missing)
+ */
+struct RedliteGeoPosArray redlite_geopos_len(struct RedliteDb *db,
+                                             const char *key,
+                                             size_t key_len,
+                                             const struct RedliteBytes *members,
+                                             size_t members_len);
+
+/**
+ * GEODIST key member1 member2 [M|KM|FT|MI]
+ * unit: 0=M, 1=KM, 2=FT, 3=MI
+ * Returns distance or -1.0 on error/not found
+ */
+double redlite_geodist_len(struct RedliteDb *db,
+                           const char *key,
+                           size_t key_len,
+                           const char *member1,
+                           size_t member1_len,
+                           const char *member2,
+                           size_t member2_len,
+                           int unit);
+
+/**
+ * GEOHASH key member [member ...]
+ * Returns one geohash per member (NULL where missing)
+ */
+struct RedliteStringArray redlite_geohash_len(struct RedliteDb *db,
+                                              const char *key,
+                                              size_t key_len,
+                                              const struct RedliteBytes *members,
+                                              size_t members_len);
+
+/**
+ * GEOSEARCHSTORE dest src FROMMEMBER|FROMLONLAT BYRADIUS radius [COUNT count] [STOREDIST]
+ * `from_member` NULL searches from from_lon/from_lat. Returns number stored, or -1 on error
+ */
+int64_t redlite_geosearchstore_len(struct RedliteDb *db,
+                                   const char *dest,
+                                   size_t dest_len,
+                                   const char *src,
+                                   size_t src_len,
+                                   const char *from_member,
+                                   size_t from_member_len,
+                                   double from_lon,
+                                   double from_lat,
+                                   double radius,
+                                   int unit,
+                                   int64_t count,
+                                   int store_dist);
+
+/**
+ * HISTORY GET key [LIMIT limit] [SINCE timestamp] [UNTIL timestamp]
+ * 0 leaves a bound off. Empty with redlite_last_error() set on error
+ */
+struct RedliteHistoryEntryArray redlite_history_get_len(struct RedliteDb *db,
+                                                        const char *key,
+                                                        size_t key_len,
+                                                        int64_t limit,
+                                                        int64_t since,
+                                                        int64_t until);
+
+/**
+ * HISTORY GETAT key timestamp
+ * NULL data if the key had no value then (or on error, with redlite_last_error() set)
+ */
+struct RedliteBytes redlite_history_getat_len(struct RedliteDb *db,
+                                              const char *key,
+                                              size_t key_len,
+                                              int64_t timestamp);
+
+/**
+ * HISTORY CLEAR key [BEFORE timestamp]; 0 clears everything
+ * Returns number of entries deleted, or -1 on error
+ */
+int64_t redlite_history_clear_len(struct RedliteDb *db,
+                                  const char *key,
+                                  size_t key_len,
+                                  int64_t before);
+
+/**
+ * BEGIN
+ * Start an explicit write transaction. Commands on this handle share one
+ * SQLite commit until `redlite_commit` or `redlite_rollback`.
+ * Returns 0 on success, -1 on error.
+ */
+int redlite_begin(struct RedliteDb *db);
+
+/**
+ * COMMIT
+ * Commit the transaction started by `redlite_begin`.
+ * Returns 0 on success, -1 on error.
+ */
+int redlite_commit(struct RedliteDb *db);
+
+/**
+ * ROLLBACK
+ * Discard the transaction started by `redlite_begin`.
+ * Returns 0 on success, -1 on error.
+ */
+int redlite_rollback(struct RedliteDb *db);
+
+/**
+ * Check whether an explicit transaction is open
+ * Returns: 1 if open, 0 if not, -1 on error
+ */
+int redlite_in_transaction(struct RedliteDb *db);
+
+/**
+ * Start a bulk load
+ * defer_indexes: drop secondary key/zset indexes until redlite_bulk_finish
+ * Returns 0 on success, -1 on error
+ */
+int redlite_bulk_begin(struct RedliteDb *db, int defer_indexes);
+
+/**
+ * Load a batch of records in one transaction
+ * defer_fts: leave full-text indexing to redlite_bulk_finish
+ * Returns number of records loaded, -1 on error (the batch is rolled back)
+ */
+int64_t redlite_bulk_load(struct RedliteDb *db,
+                          const struct RedliteBulkRecord *records,
+                          size_t records_len,
+                          int defer_fts);
+
+/**
+ * Finish a bulk load: rebuild deferred indexes and, with reindex_fts,
+ * index all strings and hashes for full-text search
+ * Returns 0 on success, -1 on error
+ */
+int redlite_bulk_finish(struct RedliteDb *db, int reindex_fts);
+
+/**
+ * Write every key of every database to a snapshot file, from one
+ * consistent read; file databases are read without blocking writers.
+ * `out` may be NULL. Returns 0 on success, -1 on error
+ */
+int redlite_export_snapshot(struct RedliteDb *db,
+                            const char *path,
+                            struct RedliteSnapshotStats *out);
+
+/**
+ * Load a snapshot file through the bulk-load path, replacing keys of the
+ * same name. `out` may be NULL. Returns 0 on success, -1 on error
+ */
+int redlite_import_snapshot(struct RedliteDb *db,
+                            const char *path,
+                            struct RedliteSnapshotStats *out);
+
+/**
+ * Execute a batch of commands under one lock and one SQLite transaction.
+ *
+ * Each command gets a reply in the same position. A failing command stores
+ * a REDLITE_REPLY_ERROR reply and does not abort the rest of the batch.
+ * Returns an empty array (and sets the last error) only if the transaction
+ * itself could not be started or committed. Inside `redlite_begin` the batch
+ * runs in a savepoint and commits with the enclosing transaction.
+ * Free the result with `redlite_free_reply_array`.
+ */
+struct RedliteReplyArray redlite_pipeline_exec(struct RedliteDb *db,
+                                               const struct RedliteCommand *cmds,
+                                               size_t cmds_len);
+
+/**
+ * Free a reply array returned by `redlite_pipeline_exec`
+ */
+void redlite_free_reply_array(struct RedliteReplyArray arr);
+
 #endif /* REDLITE_H */
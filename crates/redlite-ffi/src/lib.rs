@@ -18,12 +18,13 @@
 //! Functions returning data use out-parameters with NULL indicating no value.
 
 use libc::{c_char, c_int, size_t};
-use redlite::Db;
+use redlite::{Db, EvictionPolicy, OpenOptions, Synchronous};
 use std::ffi::{CStr, CString};
 use std::ptr;
 use std::slice;
-use std::sync::Mutex;
-use std::time::Duration;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::{Mutex, MutexGuard, TryLockError};
+use std::time::{Duration, Instant};
 
 // Thread-local error storage
 thread_local! {
@@ -41,6 +42,35 @@ fn clear_error() {
 /// Opaque handle to a redlite database
 pub struct RedliteDb {
     db: Mutex<Db>,
+    /// Lock acquisitions that had to wait for another thread, and the total wait
+    lock_waits: AtomicU64,
+    lock_wait_ns: AtomicU64,
+}
+
+impl RedliteDb {
+    fn new(db: Db) -> Self {
+        Self {
+            db: Mutex::new(db),
+            lock_waits: AtomicU64::new(0),
+            lock_wait_ns: AtomicU64::new(0),
+        }
+    }
+
+    /// Lock the handle, timing the wait only when another thread holds it
+    fn lock(&self) -> MutexGuard<'_, Db> {
+        match self.db.try_lock() {
+            Ok(guard) => guard,
+            Err(TryLockError::WouldBlock) => {
+                let start = Instant::now();
+                let guard = self.db.lock().unwrap();
+                self.lock_waits.fetch_add(1, Ordering::Relaxed);
+                self.lock_wait_ns
+                    .fetch_add(start.elapsed().as_nanos() as u64, Ordering::Relaxed);
+                guard
+            }
+            Err(TryLockError::Poisoned(_)) => self.db.lock().unwrap(),
+        }
+    }
 }
 
 /// Result of operations that return bytes
@@ -80,6 +110,203 @@ pub struct RedliteZMember {
     pub member_len: size_t,
 }
 
+/// Sorted set members with binary scores. Each member points into `data`,
+/// a single buffer owned by the array, so a range is two allocations.
+#[repr(C)]
+pub struct RedliteZMemberArray {
+    pub members: *mut RedliteZMember,
+    pub len: size_t,
+    pub data: *mut u8,
+    pub data_len: size_t,
+}
+
+/// FT.CREATE field types
+pub const REDLITE_FT_TEXT: c_int = 0;
+pub const REDLITE_FT_NUMERIC: c_int = 1;
+pub const REDLITE_FT_TAG: c_int = 2;
+
+/// One SCHEMA entry for redlite_ft_create_schema
+#[repr(C)]
+pub struct RedliteFtSchemaField {
+    pub name: *const c_char,
+    pub name_len: size_t,
+    /// REDLITE_FT_TEXT, _NUMERIC or _TAG
+    pub field_type: c_int,
+    pub sortable: c_int,
+    /// TEXT weight; 0 means 1.0
+    pub weight: f64,
+}
+
+/// Returned field of a search hit
+#[repr(C)]
+pub struct RedliteFtField {
+    pub name: *const u8,
+    pub name_len: size_t,
+    pub value: *const u8,
+    pub value_len: size_t,
+}
+
+/// FT.SEARCH hit; `fields` points into the owning array's field records
+#[repr(C)]
+pub struct RedliteFtHit {
+    pub key: *const u8,
+    pub key_len: size_t,
+    pub score: f64,
+    pub fields: *const RedliteFtField,
+    pub fields_len: size_t,
+}
+
+/// One page of FT.SEARCH hits. Keys, field names and values all point into
+/// `data`, so a page is three allocations however many fields it returns.
+/// `total` counts every match, not just this page; -1 on error.
+#[repr(C)]
+pub struct RedliteFtHitArray {
+    pub total: i64,
+    pub hits: *mut RedliteFtHit,
+    pub len: size_t,
+    pub fields: *mut RedliteFtField,
+    pub fields_len: size_t,
+    pub data: *mut u8,
+    pub data_len: size_t,
+}
+
+/// FT.SEARCH options for redlite_ft_search_hits
+#[repr(C)]
+pub struct RedliteFtSearchOptions {
+    /// LIMIT offset num
+    pub offset: i64,
+    pub num: i64,
+    pub nocontent: c_int,
+    pub verbatim: c_int,
+    pub withscores: c_int,
+    /// RETURN fields; every field when empty
+    pub return_fields: *const RedliteBytes,
+    pub return_fields_len: size_t,
+    /// SORTBY field, or NULL
+    pub sortby: *const c_char,
+    pub sortby_len: size_t,
+    pub sortby_desc: c_int,
+}
+
+/// Bulk load record kinds
+pub const REDLITE_BULK_STRING: c_int = 0;
+pub const REDLITE_BULK_HASH: c_int = 1;
+pub const REDLITE_BULK_SET: c_int = 2;
+pub const REDLITE_BULK_ZSET: c_int = 3;
+
+/// One record for redlite_bulk_load
+#[repr(C)]
+pub struct RedliteBulkRecord {
+    /// REDLITE_BULK_STRING, _HASH, _SET or _ZSET
+    pub kind: c_int,
+    pub key: *const c_char,
+    pub key_len: size_t,
+    /// Hash field (hash records only)
+    pub field: *const c_char,
+    pub field_len: size_t,
+    /// String value, hash value, or set/sorted set member
+    pub value: *const u8,
+    pub value_len: size_t,
+    /// Sorted set score (zset records only)
+    pub score: f64,
+    /// String TTL in milliseconds, 0 for none (string records only)
+    pub ttl_ms: i64,
+}
+
+/// Connection counters returned by redlite_stats
+///
+/// Page cache and statement counters are cumulative since open; a cache miss
+/// reads a page from the database file. lock_* counts threads of this process
+/// waiting on each other for the handle.
+#[repr(C)]
+pub struct RedliteStats {
+    pub cache_hits: u64,
+    pub cache_misses: u64,
+    pub cache_writes: u64,
+    pub cache_spills: u64,
+    pub cache_bytes: u64,
+    /// Live prepared statements (the statement cache) and their memory
+    pub statements: u64,
+    pub statement_bytes: u64,
+    /// Executions of live statements; runs beyond one per statement are cache reuses
+    pub statement_runs: u64,
+    /// Explicit WAL checkpoints (redlite_checkpoint) and their durations
+    pub checkpoints: u64,
+    pub checkpoint_total_us: u64,
+    pub checkpoint_max_us: u64,
+    pub lock_waits: u64,
+    pub lock_wait_ns: u64,
+}
+
+/// Connection settings for redlite_open_with_options
+///
+/// Start from redlite_open_options_default() and change the fields you need.
+#[repr(C)]
+pub struct RedliteOpenOptions {
+    /// Page cache size in MB
+    pub cache_mb: i64,
+    /// Bytes read through memory-mapped I/O (0 disables)
+    pub mmap_size: i64,
+    /// PRAGMA synchronous: 0 OFF, 1 NORMAL, 2 FULL, 3 EXTRA
+    pub synchronous: c_int,
+    /// Page size for a new database (0 keeps SQLite's default)
+    pub page_size: u32,
+    /// WAL pages that trigger an automatic checkpoint (0 disables)
+    pub wal_autocheckpoint: i64,
+    /// Keep temporary tables and indexes in memory (0 or 1)
+    pub temp_store_memory: c_int,
+    pub busy_timeout_ms: i64,
+    /// Prepared statements kept per connection
+    pub statement_cache: size_t,
+    /// Create new files with auto_vacuum = INCREMENTAL (0 or 1)
+    pub incremental_vacuum: c_int,
+    /// Memory budget in bytes (0 = unlimited)
+    pub max_memory: u64,
+    /// Budget for database pages in use, in bytes (0 = unlimited)
+    pub max_disk: u64,
+    /// 0 noeviction, 1 allkeys-lru, 2 allkeys-lfu, 3 allkeys-random,
+    /// 4 volatile-lru, 5 volatile-lfu, 6 volatile-ttl, 7 volatile-random
+    pub eviction_policy: c_int,
+}
+
+/// Result of one redlite_maintenance_step slice
+#[repr(C)]
+pub struct RedliteMaintenanceStep {
+    pub keys_reclaimed: u64,
+    pub pages_freed: u64,
+    /// 1 if an idle WAL checkpoint ran
+    pub checkpointed: c_int,
+    /// 1 if the budget ran out with work left; call again soon
+    pub more: c_int,
+    /// How long the database was held, in microseconds
+    pub pause_us: u64,
+    /// Live keys evicted to meet max_disk / max_memory
+    pub keys_evicted: u64,
+}
+
+/// Cumulative counters returned by redlite_maintenance_stats
+#[repr(C)]
+pub struct RedliteMaintenanceStats {
+    pub steps: u64,
+    pub keys_reclaimed: u64,
+    pub pages_freed: u64,
+    pub checkpoints: u64,
+    pub pause_total_us: u64,
+    pub pause_max_us: u64,
+    pub keys_evicted: u64,
+}
+
+/// Result of redlite_export_snapshot / redlite_import_snapshot
+#[repr(C)]
+pub struct RedliteSnapshotStats {
+    /// Keys written or loaded (expired keys are skipped)
+    pub keys: u64,
+    /// Values, fields, members, entries and coordinates of those keys
+    pub items: u64,
+    /// Snapshot file size in bytes
+    pub bytes: u64,
+}
+
 /// Stream ID (ms-seq)
 #[repr(C)]
 pub struct RedliteStreamId {
@@ -234,6 +461,42 @@ pub struct RedliteGeoPosArray {
     pub len: size_t,
 }
 
+/// GEOSEARCH options for redlite_geosearch_hits
+#[repr(C)]
+pub struct RedliteGeoSearchOptions {
+    pub from_member: *const c_char,  // NULL to search from from_lon/from_lat
+    pub from_member_len: size_t,
+    pub from_lon: f64,
+    pub from_lat: f64,
+    pub radius: f64,                 // > 0 for BYRADIUS, otherwise BYBOX width x height
+    pub width: f64,
+    pub height: f64,
+    pub unit: c_int,                 // 0=M, 1=KM, 2=FT, 3=MI
+    pub count: i64,                  // 0 for no limit
+    pub any: c_int,                  // with count: stop at the first `count` matches
+    pub desc: c_int,                 // farthest first
+}
+
+/// One GEOSEARCH match; `dist` is in the search's unit
+#[repr(C)]
+pub struct RedliteGeoHit {
+    pub member: *const u8,
+    pub member_len: size_t,
+    pub longitude: f64,
+    pub latitude: f64,
+    pub dist: f64,
+}
+
+/// GEOSEARCH matches. Members point into `data`, one buffer owned by the
+/// array, so a result is two allocations however many points match.
+#[repr(C)]
+pub struct RedliteGeoHitArray {
+    pub hits: *mut RedliteGeoHit,
+    pub len: size_t,
+    pub data: *mut u8,
+    pub data_len: size_t,
+}
+
 // =============================================================================
 // Lifecycle
 // =============================================================================
@@ -254,7 +517,7 @@ pub extern "C" fn redlite_open(path: *const c_char) -> *mut RedliteDb {
     };
 
     match Db::open(path) {
-        Ok(db) => Box::into_raw(Box::new(RedliteDb { db: Mutex::new(db) })),
+        Ok(db) => Box::into_raw(Box::new(RedliteDb::new(db))),
         Err(e) => {
             set_error(format!("Failed to open database: {}", e));
             ptr::null_mut()
@@ -268,7 +531,7 @@ pub extern "C" fn redlite_open_memory() -> *mut RedliteDb {
     clear_error();
 
     match Db::open_memory() {
-        Ok(db) => Box::into_raw(Box::new(RedliteDb { db: Mutex::new(db) })),
+        Ok(db) => Box::into_raw(Box::new(RedliteDb::new(db))),
         Err(e) => {
             set_error(format!("Failed to open memory database: {}", e));
             ptr::null_mut()
@@ -290,7 +553,97 @@ pub extern "C" fn redlite_open_with_cache(path: *const c_char, cache_mb: i64) ->
     };
 
     match Db::open_with_cache(path, cache_mb) {
-        Ok(db) => Box::into_raw(Box::new(RedliteDb { db: Mutex::new(db) })),
+        Ok(db) => Box::into_raw(Box::new(RedliteDb::new(db))),
+        Err(e) => {
+            set_error(format!("Failed to open database: {}", e));
+            ptr::null_mut()
+        }
+    }
+}
+
+/// Default connection settings (what redlite_open uses)
+#[no_mangle]
+pub extern "C" fn redlite_open_options_default() -> RedliteOpenOptions {
+    let o = OpenOptions::default();
+    RedliteOpenOptions {
+        cache_mb: o.cache_mb,
+        mmap_size: o.mmap_size,
+        synchronous: o.synchronous as c_int,
+        page_size: o.page_size.unwrap_or(0),
+        wal_autocheckpoint: o.wal_autocheckpoint,
+        temp_store_memory: o.temp_store_memory as c_int,
+        busy_timeout_ms: o.busy_timeout_ms,
+        statement_cache: o.statement_cache,
+        incremental_vacuum: o.incremental_vacuum as c_int,
+        max_memory: o.max_memory,
+        max_disk: o.max_disk,
+        eviction_policy: o.eviction_policy as c_int,
+    }
+}
+
+/// Open a database with explicit SQLite connection settings
+#[no_mangle]
+pub extern "C" fn redlite_open_with_options(
+    path: *const c_char,
+    options: *const RedliteOpenOptions,
+) -> *mut RedliteDb {
+    clear_error();
+
+    let path = match unsafe { CStr::from_ptr(path) }.to_str() {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(format!("Invalid path: {}", e));
+            return ptr::null_mut();
+        }
+    };
+
+    if options.is_null() {
+        set_error("NULL options pointer".to_string());
+        return ptr::null_mut();
+    }
+    let o = unsafe { &*options };
+
+    let synchronous = match o.synchronous {
+        0 => Synchronous::Off,
+        1 => Synchronous::Normal,
+        2 => Synchronous::Full,
+        3 => Synchronous::Extra,
+        n => {
+            set_error(format!("Invalid synchronous level: {}", n));
+            return ptr::null_mut();
+        }
+    };
+    let eviction_policy = match o.eviction_policy {
+        0 => EvictionPolicy::NoEviction,
+        1 => EvictionPolicy::AllKeysLRU,
+        2 => EvictionPolicy::AllKeysLFU,
+        3 => EvictionPolicy::AllKeysRandom,
+        4 => EvictionPolicy::VolatileLRU,
+        5 => EvictionPolicy::VolatileLFU,
+        6 => EvictionPolicy::VolatileTTL,
+        7 => EvictionPolicy::VolatileRandom,
+        n => {
+            set_error(format!("Invalid eviction policy: {}", n));
+            return ptr::null_mut();
+        }
+    };
+    let options = OpenOptions {
+        cache_mb: o.cache_mb,
+        mmap_size: o.mmap_size,
+        synchronous,
+        page_size: if o.page_size == 0 { None } else { Some(o.page_size) },
+        wal_autocheckpoint: o.wal_autocheckpoint,
+        temp_store_memory: o.temp_store_memory != 0,
+        busy_timeout_ms: o.busy_timeout_ms,
+        statement_cache: o.statement_cache,
+        incremental_vacuum: o.incremental_vacuum != 0,
+        max_memory: o.max_memory,
+        max_disk: o.max_disk,
+        eviction_policy,
+    };
+
+    match Db::open_with_options(path, &options) {
+        Ok(db) => Box::into_raw(Box::new(RedliteDb::new(db))),
         Err(e) => {
             set_error(format!("Failed to open database: {}", e));
             ptr::null_mut()
@@ -402,6 +755,35 @@ pub extern "C" fn redlite_free_zscan_result(result: RedliteZScanResult) {
     }
 }
 
+/// Free a scored member array
+#[no_mangle]
+pub extern "C" fn redlite_free_zmember_array(arr: RedliteZMemberArray) {
+    unsafe {
+        if !arr.members.is_null() && arr.len > 0 {
+            drop(Vec::from_raw_parts(arr.members, arr.len, arr.len));
+        }
+        if !arr.data.is_null() && arr.data_len > 0 {
+            drop(Vec::from_raw_parts(arr.data, arr.data_len, arr.data_len));
+        }
+    }
+}
+
+/// Free a page of search hits
+#[no_mangle]
+pub extern "C" fn redlite_free_ft_hit_array(arr: RedliteFtHitArray) {
+    unsafe {
+        if !arr.hits.is_null() && arr.len > 0 {
+            drop(Vec::from_raw_parts(arr.hits, arr.len, arr.len));
+        }
+        if !arr.fields.is_null() && arr.fields_len > 0 {
+            drop(Vec::from_raw_parts(arr.fields, arr.fields_len, arr.fields_len));
+        }
+        if !arr.data.is_null() && arr.data_len > 0 {
+            drop(Vec::from_raw_parts(arr.data, arr.data_len, arr.data_len));
+        }
+    }
+}
+
 /// Free a stream entry
 #[no_mangle]
 pub extern "C" fn redlite_free_stream_entry(entry: RedliteStreamEntry) {
@@ -510,6 +892,19 @@ pub extern "C" fn redlite_free_geo_pos_array(arr: RedliteGeoPosArray) {
     }
 }
 
+/// Free GEOSEARCH matches
+#[no_mangle]
+pub extern "C" fn redlite_free_geo_hit_array(arr: RedliteGeoHitArray) {
+    unsafe {
+        if !arr.hits.is_null() && arr.len > 0 {
+            drop(Vec::from_raw_parts(arr.hits, arr.len, arr.len));
+        }
+        if !arr.data.is_null() && arr.data_len > 0 {
+            drop(Vec::from_raw_parts(arr.data, arr.data_len, arr.data_len));
+        }
+    }
+}
+
 // =============================================================================
 // Helper macros and functions
 // =============================================================================
@@ -534,6 +929,19 @@ macro_rules! get_db_ret {
     }};
 }
 
+/// Resolve a length-delimited string argument or set the error and return `$ret`
+macro_rules! key_arg {
+    ($data:expr, $len:expr, $ret:expr) => {{
+        match str_from_raw($data, $len) {
+            Ok(s) => s,
+            Err(e) => {
+                set_error(e);
+                return $ret;
+            }
+        }
+    }};
+}
+
 fn cstr_to_str(s: *const c_char) -> Result<&'static str, String> {
     if s.is_null() {
         return Err("NULL string".to_string());
@@ -543,6 +951,44 @@ fn cstr_to_str(s: *const c_char) -> Result<&'static str, String> {
         .map_err(|e| format!("Invalid UTF-8: {}", e))
 }
 
+/// Borrow a length-delimited string (no NUL terminator required).
+/// A NULL pointer is accepted only with a zero length.
+fn str_from_raw(data: *const c_char, len: size_t) -> Result<&'static str, String> {
+    if data.is_null() {
+        return if len == 0 { Ok("") } else { Err("NULL string".to_string()) };
+    }
+    let bytes = unsafe { slice::from_raw_parts(data as *const u8, len) };
+    std::str::from_utf8(bytes).map_err(|e| format!("Invalid UTF-8: {}", e))
+}
+
+/// Borrow an array of length-delimited strings
+fn strs_from_bytes(items: *const RedliteBytes, len: size_t) -> Result<Vec<&'static str>, String> {
+    if items.is_null() || len == 0 {
+        return Ok(Vec::new());
+    }
+    unsafe { slice::from_raw_parts(items, len) }
+        .iter()
+        .map(|b| str_from_raw(b.data as *const c_char, b.len))
+        .collect()
+}
+
+/// Borrow an array of byte buffers without copying
+fn bytes_slices(items: *const RedliteBytes, len: size_t) -> Vec<&'static [u8]> {
+    if items.is_null() || len == 0 {
+        return Vec::new();
+    }
+    unsafe { slice::from_raw_parts(items, len) }
+        .iter()
+        .map(|b| {
+            if b.data.is_null() || b.len == 0 {
+                &[][..]
+            } else {
+                unsafe { slice::from_raw_parts(b.data as *const u8, b.len) }
+            }
+        })
+        .collect()
+}
+
 fn bytes_to_vec(data: *const u8, len: size_t) -> Vec<u8> {
     if data.is_null() || len == 0 {
         Vec::new()
@@ -601,6 +1047,79 @@ fn vecs_to_bytes_array(vecs: Vec<Vec<u8>>) -> RedliteBytesArray {
     RedliteBytesArray { items: ptr, len }
 }
 
+/// Borrow one byte buffer without copying
+fn bytes_slice(data: *const u8, len: size_t) -> &'static [u8] {
+    if data.is_null() || len == 0 {
+        &[]
+    } else {
+        unsafe { slice::from_raw_parts(data, len) }
+    }
+}
+
+fn stream_ids_from_raw(ids: *const RedliteStreamId, len: size_t) -> Vec<redlite::StreamId> {
+    if ids.is_null() || len == 0 {
+        return Vec::new();
+    }
+    unsafe { slice::from_raw_parts(ids, len) }
+        .iter()
+        .map(|id| redlite::StreamId { ms: id.ms, seq: id.seq })
+        .collect()
+}
+
+fn stream_entries_to_array(entries: Vec<redlite::StreamEntry>) -> RedliteStreamEntryArray {
+    let len = entries.len();
+    if len == 0 {
+        return RedliteStreamEntryArray { entries: ptr::null_mut(), len: 0 };
+    }
+
+    let mut c_entries: Vec<RedliteStreamEntry> = entries
+        .into_iter()
+        .map(|entry| {
+            let fields_len = entry.fields.len();
+            let mut fields: Vec<RedliteStreamField> = entry
+                .fields
+                .into_iter()
+                .map(|(k, v)| {
+                    let k = vec_to_bytes(k);
+                    let v = vec_to_bytes(v);
+                    RedliteStreamField { key: k.data, key_len: k.len, value: v.data, value_len: v.len }
+                })
+                .collect();
+            let fields_ptr = fields.as_mut_ptr();
+            std::mem::forget(fields);
+            RedliteStreamEntry {
+                id: RedliteStreamId { ms: entry.id.ms, seq: entry.id.seq },
+                fields: fields_ptr,
+                fields_len,
+            }
+        })
+        .collect();
+
+    let ptr = c_entries.as_mut_ptr();
+    std::mem::forget(c_entries);
+
+    RedliteStreamEntryArray { entries: ptr, len }
+}
+
+fn history_entries_to_array(entries: Vec<redlite::HistoryEntry>) -> RedliteHistoryEntryArray {
+    let len = entries.len();
+    if len == 0 {
+        return RedliteHistoryEntryArray { entries: ptr::null_mut(), len: 0 };
+    }
+
+    let mut c_entries: Vec<RedliteHistoryEntry> = entries
+        .into_iter()
+        .map(|entry| RedliteHistoryEntry {
+            timestamp: entry.timestamp_ms,
+            value: vec_to_bytes(entry.data_snapshot.unwrap_or_default()),
+        })
+        .collect();
+    let ptr = c_entries.as_mut_ptr();
+    std::mem::forget(c_entries);
+
+    RedliteHistoryEntryArray { entries: ptr, len }
+}
+
 // =============================================================================
 // String Commands
 // =============================================================================
@@ -619,7 +1138,7 @@ pub extern "C" fn redlite_get(db: *mut RedliteDb, key: *const c_char) -> Redlite
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.get(key) {
         Ok(v) => opt_vec_to_bytes(v),
         Err(e) => {
@@ -657,7 +1176,7 @@ pub extern "C" fn redlite_set(
         None
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.set(key, &value, ttl) {
         Ok(()) => 0,
         Err(e) => {
@@ -688,7 +1207,7 @@ pub extern "C" fn redlite_setex(
     };
 
     let value = bytes_to_vec(value, value_len);
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
 
     match guard.setex(key, seconds, &value) {
         Ok(()) => 0,
@@ -720,7 +1239,7 @@ pub extern "C" fn redlite_psetex(
     };
 
     let value = bytes_to_vec(value, value_len);
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
 
     match guard.psetex(key, milliseconds, &value) {
         Ok(()) => 0,
@@ -745,7 +1264,7 @@ pub extern "C" fn redlite_getdel(db: *mut RedliteDb, key: *const c_char) -> Redl
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.getdel(key) {
         Ok(v) => opt_vec_to_bytes(v),
         Err(e) => {
@@ -776,7 +1295,7 @@ pub extern "C" fn redlite_append(
     };
 
     let value = bytes_to_vec(value, value_len);
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
 
     match guard.append(key, &value) {
         Ok(len) => len,
@@ -801,7 +1320,7 @@ pub extern "C" fn redlite_strlen(db: *mut RedliteDb, key: *const c_char) -> i64
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.strlen(key) {
         Ok(len) => len,
         Err(e) => {
@@ -830,7 +1349,7 @@ pub extern "C" fn redlite_getrange(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.getrange(key, start, end) {
         Ok(v) => vec_to_bytes(v),
         Err(e) => {
@@ -861,7 +1380,7 @@ pub extern "C" fn redlite_setrange(
     };
 
     let value = bytes_to_vec(value, value_len);
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
 
     match guard.setrange(key, offset, &value) {
         Ok(len) => len,
@@ -886,7 +1405,7 @@ pub extern "C" fn redlite_incr(db: *mut RedliteDb, key: *const c_char) -> i64 {
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.incr(key) {
         Ok(v) => v,
         Err(e) => {
@@ -910,7 +1429,7 @@ pub extern "C" fn redlite_decr(db: *mut RedliteDb, key: *const c_char) -> i64 {
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.decr(key) {
         Ok(v) => v,
         Err(e) => {
@@ -934,7 +1453,7 @@ pub extern "C" fn redlite_incrby(db: *mut RedliteDb, key: *const c_char, increme
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.incrby(key, increment) {
         Ok(v) => v,
         Err(e) => {
@@ -958,7 +1477,7 @@ pub extern "C" fn redlite_decrby(db: *mut RedliteDb, key: *const c_char, decreme
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.decrby(key, decrement) {
         Ok(v) => v,
         Err(e) => {
@@ -987,7 +1506,7 @@ pub extern "C" fn redlite_incrbyfloat(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.incrbyfloat(key, increment) {
         Ok(v) => CString::new(v).unwrap().into_raw(),
         Err(e) => {
@@ -1025,7 +1544,7 @@ pub extern "C" fn redlite_mget(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     let results = guard.mget(&keys_vec);
 
     // Convert Vec<Option<Vec<u8>>> to RedliteBytesArray
@@ -1070,7 +1589,7 @@ pub extern "C" fn redlite_mset(
 
     let kv_refs: Vec<(&str, &[u8])> = kv_pairs.iter().map(|(k, v)| (*k, v.as_slice())).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.mset(&kv_refs) {
         Ok(()) => 0,
         Err(e) => {
@@ -1102,7 +1621,7 @@ pub extern "C" fn redlite_setnx(
 
     let value = bytes_to_vec(value, value_len);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.set_opts(key, &value, redlite::SetOptions::new().nx()) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -1155,7 +1674,7 @@ pub extern "C" fn redlite_getex(
         None
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.getex(key, option) {
         Ok(v) => opt_vec_to_bytes(v),
         Err(e) => {
@@ -1198,7 +1717,7 @@ pub extern "C" fn redlite_del(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.del(&keys_vec) {
         Ok(n) => n,
         Err(e) => {
@@ -1236,7 +1755,7 @@ pub extern "C" fn redlite_exists(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.exists(&keys_vec) {
         Ok(n) => n,
         Err(e) => {
@@ -1261,7 +1780,7 @@ pub extern "C" fn redlite_type(db: *mut RedliteDb, key: *const c_char) -> *mut c
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.key_type(key) {
         Ok(Some(t)) => {
             let type_str = match t {
@@ -1298,7 +1817,7 @@ pub extern "C" fn redlite_ttl(db: *mut RedliteDb, key: *const c_char) -> i64 {
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.ttl(key) {
         Ok(v) => v,
         Err(e) => {
@@ -1322,7 +1841,7 @@ pub extern "C" fn redlite_pttl(db: *mut RedliteDb, key: *const c_char) -> i64 {
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.pttl(key) {
         Ok(v) => v,
         Err(e) => {
@@ -1346,7 +1865,7 @@ pub extern "C" fn redlite_expire(db: *mut RedliteDb, key: *const c_char, seconds
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.expire(key, seconds) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -1371,7 +1890,7 @@ pub extern "C" fn redlite_pexpire(db: *mut RedliteDb, key: *const c_char, millis
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.pexpire(key, milliseconds) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -1396,7 +1915,7 @@ pub extern "C" fn redlite_expireat(db: *mut RedliteDb, key: *const c_char, unix_
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.expireat(key, unix_seconds) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -1421,7 +1940,7 @@ pub extern "C" fn redlite_pexpireat(db: *mut RedliteDb, key: *const c_char, unix
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.pexpireat(key, unix_ms) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -1446,7 +1965,7 @@ pub extern "C" fn redlite_persist(db: *mut RedliteDb, key: *const c_char) -> c_i
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.persist(key) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -1483,7 +2002,7 @@ pub extern "C" fn redlite_rename(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.rename(key, newkey) {
         Ok(()) => 0,
         Err(e) => {
@@ -1519,7 +2038,7 @@ pub extern "C" fn redlite_renamenx(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.renamenx(key, newkey) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -1544,7 +2063,7 @@ pub extern "C" fn redlite_keys(db: *mut RedliteDb, pattern: *const c_char) -> Re
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.keys(pattern) {
         Ok(keys) => strings_to_array(keys),
         Err(e) => {
@@ -1560,7 +2079,7 @@ pub extern "C" fn redlite_dbsize(db: *mut RedliteDb) -> i64 {
     clear_error();
     let handle = get_db_ret!(db, -1);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.dbsize() {
         Ok(n) => n,
         Err(e) => {
@@ -1576,7 +2095,7 @@ pub extern "C" fn redlite_flushdb(db: *mut RedliteDb) -> c_int {
     clear_error();
     let handle = get_db!(db);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.flushdb() {
         Ok(()) => 0,
         Err(e) => {
@@ -1592,7 +2111,7 @@ pub extern "C" fn redlite_select(db: *mut RedliteDb, db_num: c_int) -> c_int {
     clear_error();
     let handle = get_db!(db);
 
-    let mut guard = handle.db.lock().unwrap();
+    let mut guard = handle.lock();
     match guard.select(db_num) {
         Ok(()) => 0,
         Err(e) => {
@@ -1652,7 +2171,7 @@ pub extern "C" fn redlite_hset(
 
     let pairs_refs: Vec<(&str, &[u8])> = pairs.iter().map(|(k, v)| (*k, v.as_slice())).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hset(key, &pairs_refs) {
         Ok(n) => n,
         Err(e) => {
@@ -1688,7 +2207,7 @@ pub extern "C" fn redlite_hget(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hget(key, field) {
         Ok(v) => opt_vec_to_bytes(v),
         Err(e) => {
@@ -1735,7 +2254,7 @@ pub extern "C" fn redlite_hdel(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hdel(key, &fields_vec) {
         Ok(n) => n,
         Err(e) => {
@@ -1771,7 +2290,7 @@ pub extern "C" fn redlite_hexists(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hexists(key, field) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -1796,7 +2315,7 @@ pub extern "C" fn redlite_hlen(db: *mut RedliteDb, key: *const c_char) -> i64 {
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hlen(key) {
         Ok(n) => n,
         Err(e) => {
@@ -1820,7 +2339,7 @@ pub extern "C" fn redlite_hkeys(db: *mut RedliteDb, key: *const c_char) -> Redli
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hkeys(key) {
         Ok(keys) => strings_to_array(keys),
         Err(e) => {
@@ -1844,7 +2363,7 @@ pub extern "C" fn redlite_hvals(db: *mut RedliteDb, key: *const c_char) -> Redli
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hvals(key) {
         Ok(vals) => vecs_to_bytes_array(vals),
         Err(e) => {
@@ -1881,7 +2400,7 @@ pub extern "C" fn redlite_hincrby(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hincrby(key, field, increment) {
         Ok(v) => v,
         Err(e) => {
@@ -1906,7 +2425,7 @@ pub extern "C" fn redlite_hgetall(db: *mut RedliteDb, key: *const c_char) -> Red
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hgetall(key) {
         Ok(pairs) => {
             // Convert Vec<(String, Vec<u8>)> to flat array of field-value pairs
@@ -1961,7 +2480,7 @@ pub extern "C" fn redlite_hmget(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hmget(key, &fields_vec) {
         Ok(results) => {
             let vecs: Vec<Vec<u8>> = results.into_iter().map(|opt| opt.unwrap_or_default()).collect();
@@ -2005,7 +2524,7 @@ pub extern "C" fn redlite_hsetnx(
 
     let value = bytes_to_vec(value, value_len);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hsetnx(key, field, &value) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -2044,7 +2563,7 @@ pub extern "C" fn redlite_hincrbyfloat(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hincrbyfloat(key, field, increment) {
         Ok(v) => CString::new(v).unwrap().into_raw(),
         Err(e) => {
@@ -2096,7 +2615,7 @@ pub extern "C" fn redlite_lpush(
 
     let values_refs: Vec<&[u8]> = values_vecs.iter().map(|v| v.as_slice()).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.lpush(key, &values_refs) {
         Ok(n) => n,
         Err(e) => {
@@ -2144,7 +2663,7 @@ pub extern "C" fn redlite_rpush(
 
     let values_refs: Vec<&[u8]> = values_vecs.iter().map(|v| v.as_slice()).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.rpush(key, &values_refs) {
         Ok(n) => n,
         Err(e) => {
@@ -2174,7 +2693,7 @@ pub extern "C" fn redlite_lpop(
 
     let count_opt = if count > 0 { Some(count) } else { Some(1) };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.lpop(key, count_opt) {
         Ok(vals) => vecs_to_bytes_array(vals),
         Err(e) => {
@@ -2204,7 +2723,7 @@ pub extern "C" fn redlite_rpop(
 
     let count_opt = if count > 0 { Some(count) } else { Some(1) };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.rpop(key, count_opt) {
         Ok(vals) => vecs_to_bytes_array(vals),
         Err(e) => {
@@ -2228,7 +2747,7 @@ pub extern "C" fn redlite_llen(db: *mut RedliteDb, key: *const c_char) -> i64 {
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.llen(key) {
         Ok(n) => n,
         Err(e) => {
@@ -2257,7 +2776,7 @@ pub extern "C" fn redlite_lrange(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.lrange(key, start, stop) {
         Ok(vals) => vecs_to_bytes_array(vals),
         Err(e) => {
@@ -2285,7 +2804,7 @@ pub extern "C" fn redlite_lindex(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.lindex(key, index) {
         Ok(v) => opt_vec_to_bytes(v),
         Err(e) => {
@@ -2317,7 +2836,7 @@ pub extern "C" fn redlite_lset(
 
     let value = bytes_to_vec(value, value_len);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.lset(key, index, &value) {
         Ok(()) => 0,
         Err(e) => {
@@ -2346,7 +2865,7 @@ pub extern "C" fn redlite_ltrim(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.ltrim(key, start, stop) {
         Ok(()) => 0,
         Err(e) => {
@@ -2379,7 +2898,7 @@ pub extern "C" fn redlite_lrem(
 
     let element = bytes_to_vec(element, element_len);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.lrem(key, count, &element) {
         Ok(n) => n,
         Err(e) => {
@@ -2416,7 +2935,7 @@ pub extern "C" fn redlite_linsert(
     let pivot = bytes_to_vec(pivot, pivot_len);
     let element = bytes_to_vec(element, element_len);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.linsert(key, before != 0, &pivot, &element) {
         Ok(n) => n,
         Err(e) => {
@@ -2465,7 +2984,7 @@ pub extern "C" fn redlite_lpushx(
 
     let values_refs: Vec<&[u8]> = values_vecs.iter().map(|v| v.as_slice()).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.lpushx(key, &values_refs) {
         Ok(n) => n,
         Err(e) => {
@@ -2514,7 +3033,7 @@ pub extern "C" fn redlite_rpushx(
 
     let values_refs: Vec<&[u8]> = values_vecs.iter().map(|v| v.as_slice()).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.rpushx(key, &values_refs) {
         Ok(n) => n,
         Err(e) => {
@@ -2559,7 +3078,7 @@ pub extern "C" fn redlite_lmove(
     let from_dir = if wherefrom == 0 { ListDirection::Left } else { ListDirection::Right };
     let to_dir = if whereto == 0 { ListDirection::Left } else { ListDirection::Right };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.lmove(source_str, dest_str, from_dir, to_dir) {
         Ok(Some(v)) => vec_to_bytes(v),
         Ok(None) => RedliteBytes { data: ptr::null_mut(), len: 0 },
@@ -2601,7 +3120,7 @@ pub extern "C" fn redlite_lpos(
     let count_opt = if count == 0 { None } else { Some(count) };
     let maxlen_opt = if maxlen == 0 { None } else { Some(maxlen) };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.lpos(key_str, &element_bytes, rank_opt, count_opt, maxlen_opt) {
         Ok(positions) => {
             // Convert Vec<i64> to bytes array where each position is encoded as 8 bytes
@@ -2665,7 +3184,7 @@ pub extern "C" fn redlite_sadd(
 
     let members_refs: Vec<&[u8]> = members_vecs.iter().map(|v| v.as_slice()).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.sadd(key, &members_refs) {
         Ok(n) => n,
         Err(e) => {
@@ -2712,7 +3231,7 @@ pub extern "C" fn redlite_srem(
 
     let members_refs: Vec<&[u8]> = members_vecs.iter().map(|v| v.as_slice()).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.srem(key, &members_refs) {
         Ok(n) => n,
         Err(e) => {
@@ -2736,7 +3255,7 @@ pub extern "C" fn redlite_smembers(db: *mut RedliteDb, key: *const c_char) -> Re
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.smembers(key) {
         Ok(members) => vecs_to_bytes_array(members),
         Err(e) => {
@@ -2767,7 +3286,7 @@ pub extern "C" fn redlite_sismember(
 
     let member = bytes_to_vec(member, member_len);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.sismember(key, &member) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -2792,7 +3311,7 @@ pub extern "C" fn redlite_scard(db: *mut RedliteDb, key: *const c_char) -> i64 {
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.scard(key) {
         Ok(n) => n,
         Err(e) => {
@@ -2822,7 +3341,7 @@ pub extern "C" fn redlite_spop(
 
     let count_opt = if count > 0 { Some(count) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.spop(key, count_opt) {
         Ok(members) => vecs_to_bytes_array(members),
         Err(e) => {
@@ -2854,7 +3373,7 @@ pub extern "C" fn redlite_srandmember(
 
     let count_opt = if count != 0 { Some(count) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.srandmember(key, count_opt) {
         Ok(members) => vecs_to_bytes_array(members),
         Err(e) => {
@@ -2892,7 +3411,7 @@ pub extern "C" fn redlite_sdiff(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.sdiff(&keys_vec) {
         Ok(members) => vecs_to_bytes_array(members),
         Err(e) => {
@@ -2930,7 +3449,7 @@ pub extern "C" fn redlite_sinter(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.sinter(&keys_vec) {
         Ok(members) => vecs_to_bytes_array(members),
         Err(e) => {
@@ -2968,7 +3487,7 @@ pub extern "C" fn redlite_sunion(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.sunion(&keys_vec) {
         Ok(members) => vecs_to_bytes_array(members),
         Err(e) => {
@@ -3009,7 +3528,7 @@ pub extern "C" fn redlite_smove(
 
     let member = bytes_to_vec(member, member_len);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.smove(source, destination, &member) {
         Ok(n) => n as c_int,
         Err(e) => {
@@ -3057,7 +3576,7 @@ pub extern "C" fn redlite_sdiffstore(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.sdiffstore(destination, &keys_vec) {
         Ok(n) => n,
         Err(e) => {
@@ -3105,7 +3624,7 @@ pub extern "C" fn redlite_sinterstore(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.sinterstore(destination, &keys_vec) {
         Ok(n) => n,
         Err(e) => {
@@ -3153,7 +3672,7 @@ pub extern "C" fn redlite_sunionstore(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.sunionstore(destination, &keys_vec) {
         Ok(n) => n,
         Err(e) => {
@@ -3206,7 +3725,7 @@ pub extern "C" fn redlite_zadd(
         })
         .collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zadd(key, &zmembers) {
         Ok(n) => n,
         Err(e) => {
@@ -3253,7 +3772,7 @@ pub extern "C" fn redlite_zrem(
 
     let members_refs: Vec<&[u8]> = members_vecs.iter().map(|v| v.as_slice()).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zrem(key, &members_refs) {
         Ok(n) => n,
         Err(e) => {
@@ -3285,7 +3804,7 @@ pub extern "C" fn redlite_zscore(
 
     let member = bytes_to_vec(member, member_len);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zscore(key, &member) {
         Ok(Some(score)) => score,
         Ok(None) => f64::NAN,
@@ -3310,7 +3829,7 @@ pub extern "C" fn redlite_zcard(db: *mut RedliteDb, key: *const c_char) -> i64 {
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zcard(key) {
         Ok(n) => n,
         Err(e) => {
@@ -3339,7 +3858,7 @@ pub extern "C" fn redlite_zcount(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zcount(key, min, max) {
         Ok(n) => n,
         Err(e) => {
@@ -3371,7 +3890,7 @@ pub extern "C" fn redlite_zincrby(
 
     let member = bytes_to_vec(member, member_len);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zincrby(key, increment, &member) {
         Ok(score) => score,
         Err(e) => {
@@ -3402,7 +3921,7 @@ pub extern "C" fn redlite_zrange(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zrange(key, start, stop, with_scores != 0) {
         Ok(members) => {
             if with_scores != 0 {
@@ -3447,7 +3966,7 @@ pub extern "C" fn redlite_zrevrange(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zrevrange(key, start, stop, with_scores != 0) {
         Ok(members) => {
             if with_scores != 0 {
@@ -3493,7 +4012,7 @@ pub extern "C" fn redlite_zrank(
 
     let member = bytes_to_vec(member, member_len);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zrank(key, &member) {
         Ok(Some(rank)) => rank,
         Ok(None) => -1,
@@ -3526,7 +4045,7 @@ pub extern "C" fn redlite_zrevrank(
 
     let member = bytes_to_vec(member, member_len);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zrevrank(key, &member) {
         Ok(Some(rank)) => rank,
         Ok(None) => -1,
@@ -3563,7 +4082,7 @@ pub extern "C" fn redlite_zrangebyscore(
     let offset_opt = if offset >= 0 { Some(offset) } else { None };
     let count_opt = if count >= 0 { Some(count) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zrangebyscore(key, min, max, offset_opt, count_opt) {
         Ok(members) => {
             let members_only: Vec<Vec<u8>> = members.into_iter().map(|zm| zm.member).collect();
@@ -3596,7 +4115,7 @@ pub extern "C" fn redlite_zremrangebyrank(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zremrangebyrank(key, start, stop) {
         Ok(n) => n,
         Err(e) => {
@@ -3626,7 +4145,7 @@ pub extern "C" fn redlite_zremrangebyscore(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zremrangebyscore(key, min, max) {
         Ok(n) => n,
         Err(e) => {
@@ -3659,7 +4178,7 @@ pub extern "C" fn redlite_getbit(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.getbit(key, offset) {
         Ok(bit) => bit,
         Err(e) => {
@@ -3689,7 +4208,7 @@ pub extern "C" fn redlite_setbit(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.setbit(key, offset, value != 0) {
         Ok(prev) => prev,
         Err(e) => {
@@ -3723,7 +4242,7 @@ pub extern "C" fn redlite_bitcount(
     let start_opt = if use_range != 0 { Some(start) } else { None };
     let end_opt = if use_range != 0 { Some(end) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.bitcount(key, start_opt, end_opt) {
         Ok(count) => count,
         Err(e) => {
@@ -3780,7 +4299,7 @@ pub extern "C" fn redlite_bitop(
         }
     }
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.bitop(op, dest, &key_strs) {
         Ok(len) => len,
         Err(e) => {
@@ -3835,7 +4354,7 @@ pub extern "C" fn redlite_scan(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.scan(cursor_str, pattern_opt, count) {
         Ok((next_cursor, keys)) => {
             let cursor_cstr = CString::new(next_cursor).unwrap().into_raw();
@@ -3908,7 +4427,7 @@ pub extern "C" fn redlite_hscan(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.hscan(key_str, cursor_str, pattern_opt, count) {
         Ok((next_cursor, pairs)) => {
             let cursor_cstr = CString::new(next_cursor).unwrap().into_raw();
@@ -3987,7 +4506,7 @@ pub extern "C" fn redlite_sscan(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.sscan(key_str, cursor_str, pattern_opt, count) {
         Ok((next_cursor, members)) => {
             let cursor_cstr = CString::new(next_cursor).unwrap().into_raw();
@@ -4064,7 +4583,7 @@ pub extern "C" fn redlite_zscan(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zscan(key_str, cursor_str, pattern_opt, count) {
         Ok((next_cursor, pairs)) => {
             let cursor_cstr = CString::new(next_cursor).unwrap().into_raw();
@@ -4167,7 +4686,7 @@ pub extern "C" fn redlite_zinterstore(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zinterstore(dest_str, &key_refs, weights_opt, agg_opt) {
         Ok(n) => n,
         Err(e) => {
@@ -4239,7 +4758,7 @@ pub extern "C" fn redlite_zunionstore(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.zunionstore(dest_str, &key_refs, weights_opt, agg_opt) {
         Ok(n) => n,
         Err(e) => {
@@ -4305,7 +4824,7 @@ pub extern "C" fn redlite_xadd(
 
     let maxlen_opt = if use_maxlen != 0 { Some(maxlen) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xadd(
         key_str,
         stream_id,
@@ -4342,7 +4861,7 @@ pub extern "C" fn redlite_xlen(db: *mut RedliteDb, key: *const c_char) -> i64 {
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xlen(key_str) {
         Ok(len) => len,
         Err(e) => {
@@ -4386,7 +4905,7 @@ pub extern "C" fn redlite_xrange(
     let end_id = redlite::StreamId { ms: end_ms, seq: end_seq };
     let count_opt = if use_count != 0 { Some(count) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xrange(key_str, start_id, end_id, count_opt) {
         Ok(entries) => {
             let len = entries.len();
@@ -4479,7 +4998,7 @@ pub extern "C" fn redlite_xrevrange(
     let start_id = redlite::StreamId { ms: start_ms, seq: start_seq };
     let count_opt = if use_count != 0 { Some(count) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xrevrange(key_str, end_id, start_id, count_opt) {
         Ok(entries) => {
             let len = entries.len();
@@ -4570,7 +5089,7 @@ pub extern "C" fn redlite_xread(
     let start_id = redlite::StreamId { ms: id_ms, seq: id_seq };
     let count_opt = if use_count != 0 { Some(count) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xread(&[key_str], &[start_id], count_opt) {
         Ok(results) => {
             // Results is Vec<(String, Vec<StreamEntry>)>
@@ -4655,7 +5174,7 @@ pub extern "C" fn redlite_xtrim(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xtrim(key_str, Some(maxlen), None, false) {
         Ok(count) => count,
         Err(e) => {
@@ -4695,7 +5214,7 @@ pub extern "C" fn redlite_xdel(
         .map(|id| redlite::StreamId { ms: id.ms, seq: id.seq })
         .collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xdel(key_str, &stream_ids) {
         Ok(count) => count,
         Err(e) => {
@@ -4741,7 +5260,7 @@ pub extern "C" fn redlite_xgroup_create(
 
     let stream_id = redlite::StreamId { ms: id_ms, seq: id_seq };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xgroup_create(key_str, group_str, stream_id, mkstream != 0) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -4779,7 +5298,7 @@ pub extern "C" fn redlite_xgroup_destroy(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xgroup_destroy(key_str, group_str) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -4856,7 +5375,7 @@ pub extern "C" fn redlite_xreadgroup(
 
     let count_opt = if use_count != 0 { Some(count) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xreadgroup(
         group_str,
         consumer_str,
@@ -4966,7 +5485,7 @@ pub extern "C" fn redlite_xack(
         .map(|id| redlite::StreamId { ms: id.ms, seq: id.seq })
         .collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xack(key_str, group_str, &stream_ids) {
         Ok(count) => count,
         Err(e) => {
@@ -5007,7 +5526,7 @@ pub extern "C" fn redlite_xgroup_setid(
 
     let stream_id = redlite::StreamId { ms: id_ms, seq: id_seq };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xgroup_setid(key_str, group_str, stream_id) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -5054,7 +5573,7 @@ pub extern "C" fn redlite_xgroup_createconsumer(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xgroup_createconsumer(key_str, group_str, consumer_str) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -5101,7 +5620,7 @@ pub extern "C" fn redlite_xgroup_delconsumer(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xgroup_delconsumer(key_str, group_str, consumer_str) {
         Ok(count) => count,
         Err(e) => {
@@ -5185,7 +5704,7 @@ pub extern "C" fn redlite_xclaim(
     let time_opt = if time_ms > 0 { Some(time_ms) } else { None };
     let retry_opt = if retry_count >= 0 { Some(retry_count) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xclaim(
         key_str,
         group_str,
@@ -5273,7 +5792,7 @@ pub extern "C" fn redlite_xinfo_stream(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xinfo_stream(key_str) {
         Ok(Some(info)) => {
             let first_entry_ptr = if let Some(entry) = info.first_entry {
@@ -5384,7 +5903,7 @@ pub extern "C" fn redlite_xinfo_groups(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xinfo_groups(key_str) {
         Ok(groups_vec) => {
             let len = groups_vec.len();
@@ -5459,7 +5978,7 @@ pub extern "C" fn redlite_xinfo_consumers(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.xinfo_consumers(key_str, group_str) {
         Ok(consumers_vec) => {
             let len = consumers_vec.len();
@@ -5540,7 +6059,7 @@ pub extern "C" fn redlite_geoadd(
 
     let geo_refs: Vec<(f64, f64, &str)> = geo_members.iter().map(|(lon, lat, m)| (*lon, *lat, m.as_ref())).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.geoadd(key_str, &geo_refs, nx != 0, xx != 0, ch != 0) {
         Ok(count) => count,
         Err(e) => {
@@ -5600,7 +6119,7 @@ pub extern "C" fn redlite_geopos(
 
     let member_refs: Vec<&str> = member_strs.iter().map(|s| s.as_ref()).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.geopos(key_str, &member_refs) {
         Ok(positions) => {
             let len = positions.len();
@@ -5684,7 +6203,7 @@ pub extern "C" fn redlite_geodist(
         _ => GeoUnit::Meters,
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.geodist(key_str, member1_str, member2_str, geo_unit) {
         Ok(Some(dist)) => dist,
         Ok(None) => -1.0,
@@ -5745,7 +6264,7 @@ pub extern "C" fn redlite_geohash(
 
     let member_refs: Vec<&str> = member_strs.iter().map(|s| s.as_ref()).collect();
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.geohash(key_str, &member_refs) {
         Ok(hashes) => {
             let len = hashes.len();
@@ -5848,7 +6367,7 @@ pub extern "C" fn redlite_geosearch(
         with_hash: false,
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.geosearch(key_str, &options) {
         Ok(members) => {
             let len = members.len();
@@ -5884,6 +6403,114 @@ pub extern "C" fn redlite_geosearch(
     }
 }
 
+const EMPTY_GEO_HIT_ARRAY: RedliteGeoHitArray = RedliteGeoHitArray {
+    hits: ptr::null_mut(),
+    len: 0,
+    data: ptr::null_mut(),
+    data_len: 0,
+};
+
+/// Pack members into one byte buffer plus hit records pointing into it
+fn geo_hits_to_packed(members: Vec<redlite::types::GeoMember>) -> RedliteGeoHitArray {
+    if members.is_empty() {
+        return EMPTY_GEO_HIT_ARRAY;
+    }
+
+    let data_len: usize = members.iter().map(|m| m.member.len()).sum();
+    let mut data: Vec<u8> = Vec::with_capacity(data_len);
+    for m in &members {
+        data.extend_from_slice(m.member.as_bytes());
+    }
+    let mut data = data.into_boxed_slice();
+    let base = if data_len == 0 { ptr::null_mut() } else { data.as_mut_ptr() };
+
+    let mut offset = 0;
+    let mut hits: Vec<RedliteGeoHit> = Vec::with_capacity(members.len());
+    for m in &members {
+        let len = m.member.len();
+        hits.push(RedliteGeoHit {
+            member: if len == 0 { ptr::null() } else { unsafe { base.add(offset) } },
+            member_len: len,
+            longitude: m.longitude,
+            latitude: m.latitude,
+            dist: m.distance.unwrap_or(0.0),
+        });
+        offset += len;
+    }
+    let mut hits = hits.into_boxed_slice();
+    let len = hits.len();
+    let hits_ptr = hits.as_mut_ptr();
+    std::mem::forget(hits);
+    std::mem::forget(data);
+
+    RedliteGeoHitArray {
+        hits: hits_ptr,
+        len,
+        data: base,
+        data_len,
+    }
+}
+
+/// GEOSEARCH key FROMMEMBER|FROMLONLAT BYRADIUS|BYBOX [ASC|DESC] [COUNT n [ANY]] WITHCOORD WITHDIST
+/// Always returns coordinates and distances, nearest first unless `desc`.
+/// An empty array with redlite_last_error() set means the call failed.
+#[no_mangle]
+pub extern "C" fn redlite_geosearch_hits(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    options: *const RedliteGeoSearchOptions,
+) -> RedliteGeoHitArray {
+    clear_error();
+    let handle = get_db_ret!(db, EMPTY_GEO_HIT_ARRAY);
+    let key = key_arg!(key, key_len, EMPTY_GEO_HIT_ARRAY);
+    if options.is_null() {
+        set_error("NULL options".to_string());
+        return EMPTY_GEO_HIT_ARRAY;
+    }
+    let opts = unsafe { &*options };
+
+    use redlite::types::{GeoSearchOptions, GeoUnit};
+    let geo_unit = match opts.unit {
+        1 => GeoUnit::Kilometers,
+        2 => GeoUnit::Feet,
+        3 => GeoUnit::Miles,
+        _ => GeoUnit::Meters,
+    };
+    let (from_member, from_lonlat) = if opts.from_member.is_null() {
+        (None, Some((opts.from_lon, opts.from_lat)))
+    } else {
+        (Some(key_arg!(opts.from_member, opts.from_member_len, EMPTY_GEO_HIT_ARRAY).to_string()), None)
+    };
+    let (by_radius, by_box) = if opts.radius > 0.0 {
+        (Some((opts.radius, geo_unit)), None)
+    } else {
+        (None, Some((opts.width, opts.height, geo_unit)))
+    };
+
+    let options = GeoSearchOptions {
+        from_member,
+        from_lonlat,
+        by_radius,
+        by_box,
+        ascending: opts.desc == 0,
+        count: if opts.count > 0 { Some(opts.count as usize) } else { None },
+        any: opts.any != 0,
+        with_coord: true,
+        with_dist: true,
+        with_hash: false,
+    };
+
+    let guard = handle.lock();
+    match guard.geosearch(key, &options) {
+        Ok(members) => geo_hits_to_packed(members),
+        Err(e) => {
+            set_error(format!("GEOSEARCH failed: {}", e));
+            EMPTY_GEO_HIT_ARRAY
+        }
+    }
+}
+
 /// GEOSEARCHSTORE dest source <GEOSEARCH args>
 /// Returns number of elements stored
 #[no_mangle]
@@ -5951,7 +6578,7 @@ pub extern "C" fn redlite_geosearchstore(
         with_hash: false,
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.geosearchstore(dest_str, src_str, &options, store_dist != 0) {
         Ok(n) => n,
         Err(e) => {
@@ -5980,11 +6607,73 @@ pub extern "C" fn redlite_ft_create(
     };
 
     // Simplified stub - full implementation would need schema definition
-    let _guard = handle.db.lock().unwrap();
+    let _guard = handle.lock();
     set_error("FT.CREATE not fully implemented in FFI (complex schema types)".to_string());
     -1
 }
 
+/// FT.CREATE index ON HASH|JSON PREFIX n prefix... SCHEMA field type [SORTABLE]...
+/// Returns 0 on success, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_ft_create_schema(
+    db: *mut RedliteDb,
+    index: *const c_char,
+    index_len: size_t,
+    on_json: c_int,
+    prefixes: *const RedliteBytes,
+    prefixes_len: size_t,
+    fields: *const RedliteFtSchemaField,
+    fields_len: size_t,
+) -> c_int {
+    use redlite::{FtField, FtFieldType, FtOnType};
+
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let index = key_arg!(index, index_len, -1);
+    let prefixes = match strs_from_bytes(prefixes, prefixes_len) {
+        Ok(p) => p,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+
+    let defs: &[RedliteFtSchemaField] = if fields.is_null() || fields_len == 0 {
+        &[]
+    } else {
+        unsafe { slice::from_raw_parts(fields, fields_len) }
+    };
+    let mut schema = Vec::with_capacity(defs.len());
+    for def in defs {
+        let name = key_arg!(def.name, def.name_len, -1);
+        let field_type = match def.field_type {
+            REDLITE_FT_TEXT => FtFieldType::Text,
+            REDLITE_FT_NUMERIC => FtFieldType::Numeric,
+            REDLITE_FT_TAG => FtFieldType::Tag,
+            other => {
+                set_error(format!("FT.CREATE failed: unknown field type {}", other));
+                return -1;
+            }
+        };
+        let mut field = FtField::new(name, field_type);
+        field.sortable = def.sortable != 0;
+        if def.weight > 0.0 {
+            field.weight = def.weight;
+        }
+        schema.push(field);
+    }
+
+    let on_type = if on_json != 0 { FtOnType::Json } else { FtOnType::Hash };
+    let guard = handle.lock();
+    match guard.ft_create(index, on_type, &prefixes, &schema) {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("FT.CREATE failed: {}", e));
+            -1
+        }
+    }
+}
+
 /// FT.DROPINDEX - Drop search index
 #[no_mangle]
 pub extern "C" fn redlite_ft_dropindex(
@@ -6003,7 +6692,7 @@ pub extern "C" fn redlite_ft_dropindex(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.ft_dropindex(name, delete_docs != 0) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -6023,7 +6712,7 @@ pub extern "C" fn redlite_ft_list(db: *mut RedliteDb) -> RedliteStringArray {
         len: 0,
     });
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.ft_list() {
         Ok(indexes) => {
             let len = indexes.len();
@@ -6074,28 +6763,186 @@ pub extern "C" fn redlite_ft_alter(db: *mut RedliteDb, _index: *const c_char) ->
     -1
 }
 
-/// FT.SEARCH - stub
+/// FT.SEARCH index query LIMIT 0 0
+/// Returns the number of matching documents, -1 on error.
+/// Use redlite_ft_search_hits for the documents themselves.
 #[no_mangle]
-pub extern "C" fn redlite_ft_search(db: *mut RedliteDb, _index: *const c_char, _query: *const c_char) -> i64 {
+pub extern "C" fn redlite_ft_search(db: *mut RedliteDb, index: *const c_char, query: *const c_char) -> i64 {
     clear_error();
-    let _handle = get_db_ret!(db, -1);
-    set_error("FT.SEARCH not fully implemented in FFI (complex options/results)".to_string());
-    -1
-}
+    let handle = get_db_ret!(db, -1);
 
-/// FT.ALIASADD - stub
-#[no_mangle]
-pub extern "C" fn redlite_ft_aliasadd(db: *mut RedliteDb, _alias: *const c_char, _index: *const c_char) -> i64 {
-    clear_error();
-    let _handle = get_db_ret!(db, -1);
-    set_error("FT.ALIASADD not fully implemented in FFI".to_string());
-    -1
-}
+    let (index, query) = match (cstr_to_str(index), cstr_to_str(query)) {
+        (Ok(i), Ok(q)) => (i, q),
+        (Err(e), _) | (_, Err(e)) => {
+            set_error(e);
+            return -1;
+        }
+    };
 
-/// FT.ALIASDEL - stub
-#[no_mangle]
-pub extern "C" fn redlite_ft_aliasdel(db: *mut RedliteDb, _alias: *const c_char) -> i64 {
-    clear_error();
+    let options = redlite::FtSearchOptions {
+        nocontent: true,
+        limit_num: 0,
+        ..Default::default()
+    };
+    let guard = handle.lock();
+    match guard.ft_search(index, query, &options) {
+        Ok((total, _)) => total,
+        Err(e) => {
+            set_error(format!("FT.SEARCH failed: {}", e));
+            -1
+        }
+    }
+}
+
+const EMPTY_FT_HIT_ARRAY: RedliteFtHitArray = RedliteFtHitArray {
+    total: -1,
+    hits: ptr::null_mut(),
+    len: 0,
+    fields: ptr::null_mut(),
+    fields_len: 0,
+    data: ptr::null_mut(),
+    data_len: 0,
+};
+
+/// Pack hits into one byte buffer plus hit and field records pointing into it
+fn ft_hits_to_packed(total: i64, results: Vec<redlite::FtSearchResult>) -> RedliteFtHitArray {
+    if results.is_empty() {
+        return RedliteFtHitArray { total, ..EMPTY_FT_HIT_ARRAY };
+    }
+
+    let data_len: usize = results
+        .iter()
+        .map(|r| r.key.len() + r.fields.iter().map(|(n, v)| n.len() + v.len()).sum::<usize>())
+        .sum();
+    let mut data: Vec<u8> = Vec::with_capacity(data_len);
+    for r in &results {
+        data.extend_from_slice(r.key.as_bytes());
+        for (name, value) in &r.fields {
+            data.extend_from_slice(name.as_bytes());
+            data.extend_from_slice(value);
+        }
+    }
+    let mut data = data.into_boxed_slice();
+    let base = if data_len == 0 { ptr::null_mut() } else { data.as_mut_ptr() };
+
+    let mut offset = 0;
+    let mut take = |len: usize| -> *const u8 {
+        let p = if len == 0 { ptr::null() } else { unsafe { base.add(offset) as *const u8 } };
+        offset += len;
+        p
+    };
+
+    let fields_len: usize = results.iter().map(|r| r.fields.len()).sum();
+    let mut fields: Vec<RedliteFtField> = Vec::with_capacity(fields_len);
+    let mut hits: Vec<RedliteFtHit> = Vec::with_capacity(results.len());
+    for r in &results {
+        let key = take(r.key.len());
+        let first = fields.len();
+        for (name, value) in &r.fields {
+            fields.push(RedliteFtField {
+                name: take(name.len()),
+                name_len: name.len(),
+                value: take(value.len()),
+                value_len: value.len(),
+            });
+        }
+        hits.push(RedliteFtHit {
+            key,
+            key_len: r.key.len(),
+            score: r.score,
+            fields: ptr::null(),
+            fields_len: fields.len() - first,
+        });
+    }
+
+    let mut fields = fields.into_boxed_slice();
+    let fields_ptr = if fields_len == 0 { ptr::null_mut() } else { fields.as_mut_ptr() };
+    let mut first = 0;
+    for hit in hits.iter_mut() {
+        if hit.fields_len > 0 {
+            hit.fields = unsafe { fields_ptr.add(first) };
+        }
+        first += hit.fields_len;
+    }
+    let mut hits = hits.into_boxed_slice();
+    let len = hits.len();
+    let hits_ptr = hits.as_mut_ptr();
+    std::mem::forget(hits);
+    std::mem::forget(fields);
+    std::mem::forget(data);
+
+    RedliteFtHitArray {
+        total,
+        hits: hits_ptr,
+        len,
+        fields: fields_ptr,
+        fields_len,
+        data: base,
+        data_len,
+    }
+}
+
+/// FT.SEARCH index query [NOCONTENT] [VERBATIM] [WITHSCORES] [RETURN ...]
+/// [SORTBY field [ASC|DESC]] [LIMIT offset num]
+/// NULL options means LIMIT 0 10 with every field. Returns one page of
+/// hits; free with redlite_free_ft_hit_array. total is -1 on error.
+#[no_mangle]
+pub extern "C" fn redlite_ft_search_hits(
+    db: *mut RedliteDb,
+    index: *const c_char,
+    index_len: size_t,
+    query: *const c_char,
+    query_len: size_t,
+    options: *const RedliteFtSearchOptions,
+) -> RedliteFtHitArray {
+    clear_error();
+    let handle = get_db_ret!(db, EMPTY_FT_HIT_ARRAY);
+    let index = key_arg!(index, index_len, EMPTY_FT_HIT_ARRAY);
+    let query = key_arg!(query, query_len, EMPTY_FT_HIT_ARRAY);
+
+    let mut search = redlite::FtSearchOptions::default();
+    if let Some(o) = unsafe { options.as_ref() } {
+        search.limit_offset = o.offset;
+        search.limit_num = o.num;
+        search.nocontent = o.nocontent != 0;
+        search.verbatim = o.verbatim != 0;
+        search.withscores = o.withscores != 0;
+        search.return_fields = match strs_from_bytes(o.return_fields, o.return_fields_len) {
+            Ok(fields) => fields.into_iter().map(String::from).collect(),
+            Err(e) => {
+                set_error(e);
+                return EMPTY_FT_HIT_ARRAY;
+            }
+        };
+        if !o.sortby.is_null() {
+            let field = key_arg!(o.sortby, o.sortby_len, EMPTY_FT_HIT_ARRAY);
+            search.sortby = Some((field.to_string(), o.sortby_desc == 0));
+        }
+    }
+
+    let guard = handle.lock();
+    match guard.ft_search(index, query, &search) {
+        Ok((total, results)) => ft_hits_to_packed(total, results),
+        Err(e) => {
+            set_error(format!("FT.SEARCH failed: {}", e));
+            EMPTY_FT_HIT_ARRAY
+        }
+    }
+}
+
+/// FT.ALIASADD - stub
+#[no_mangle]
+pub extern "C" fn redlite_ft_aliasadd(db: *mut RedliteDb, _alias: *const c_char, _index: *const c_char) -> i64 {
+    clear_error();
+    let _handle = get_db_ret!(db, -1);
+    set_error("FT.ALIASADD not fully implemented in FFI".to_string());
+    -1
+}
+
+/// FT.ALIASDEL - stub
+#[no_mangle]
+pub extern "C" fn redlite_ft_aliasdel(db: *mut RedliteDb, _alias: *const c_char) -> i64 {
+    clear_error();
     let _handle = get_db_ret!(db, -1);
     set_error("FT.ALIASDEL not fully implemented in FFI".to_string());
     -1
@@ -6164,6 +7011,189 @@ pub extern "C" fn redlite_ft_suglen(db: *mut RedliteDb, _key: *const c_char) ->
     -1
 }
 
+// =============================================================================
+// Vector Set Commands
+// =============================================================================
+
+/// VADD key FP32 values element [SETATTR attributes]
+/// Returns 1 if added, 0 if updated, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_vadd(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    values: *const f32,
+    dim: size_t,
+    element: *const c_char,
+    attributes: *const c_char,
+) -> c_int {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+
+    let key_str = match cstr_to_str(key) {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+    let element_str = match cstr_to_str(element) {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+    let attributes_opt = if attributes.is_null() {
+        None
+    } else {
+        match cstr_to_str(attributes) {
+            Ok(s) => Some(s),
+            Err(e) => {
+                set_error(e);
+                return -1;
+            }
+        }
+    };
+    if values.is_null() || dim == 0 {
+        set_error("VADD failed: empty vector".to_string());
+        return -1;
+    }
+    let embedding = unsafe { slice::from_raw_parts(values, dim) };
+
+    let guard = handle.lock();
+    match guard.vadd(
+        key_str,
+        embedding,
+        element_str,
+        attributes_opt,
+        redlite::types::VectorQuantization::NoQuant,
+    ) {
+        Ok(added) => added as c_int,
+        Err(e) => {
+            set_error(format!("VADD failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// VSIM key FP32 query COUNT count
+/// Writes up to `count` scores (descending) into `scores_out` and, if
+/// `elements_out` is non-NULL, the matching element names into it.
+/// nprobe: IVF lists to scan (-1 = default, 0 = exact scan)
+/// Returns the number of results, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_vsim(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    query: *const f32,
+    dim: size_t,
+    count: size_t,
+    nprobe: i64,
+    elements_out: *mut RedliteStringArray,
+    scores_out: *mut f64,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+
+    let key_str = match cstr_to_str(key) {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+    if query.is_null() || dim == 0 {
+        set_error("VSIM failed: empty query vector".to_string());
+        return -1;
+    }
+    if scores_out.is_null() && count > 0 {
+        set_error("VSIM failed: NULL score buffer".to_string());
+        return -1;
+    }
+    let values = unsafe { slice::from_raw_parts(query, dim) }.to_vec();
+    let nprobe = if nprobe < 0 { None } else { Some(nprobe as usize) };
+
+    let guard = handle.lock();
+    match guard.vsim_nprobe(
+        key_str,
+        redlite::types::VectorInput::Values(values),
+        Some(count.min(i64::MAX as usize) as i64),
+        false,
+        None,
+        nprobe,
+    ) {
+        Ok(results) => {
+            if !results.is_empty() {
+                let scores = unsafe { slice::from_raw_parts_mut(scores_out, results.len()) };
+                for (slot, r) in scores.iter_mut().zip(&results) {
+                    *slot = r.score;
+                }
+            }
+            let n = results.len() as i64;
+            if !elements_out.is_null() {
+                let names = results.into_iter().map(|r| r.element).collect();
+                unsafe { *elements_out = strings_to_array(names) };
+            }
+            n
+        }
+        Err(e) => {
+            set_error(format!("VSIM failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// VINDEX key [NLIST nlist]
+/// Builds the IVF index used by VSIM (nlist 0 = sqrt of the cardinality)
+/// Returns the number of lists built, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_vindex(db: *mut RedliteDb, key: *const c_char, nlist: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+
+    let key_str = match cstr_to_str(key) {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+
+    let guard = handle.lock();
+    match guard.vindex(key_str, if nlist == 0 { None } else { Some(nlist) }) {
+        Ok(n) => n as i64,
+        Err(e) => {
+            set_error(format!("VINDEX failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// Drop the IVF index of a vector set
+/// Returns 1 if an index was dropped, 0 if none existed, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_vindex_drop(db: *mut RedliteDb, key: *const c_char) -> c_int {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+
+    let key_str = match cstr_to_str(key) {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+
+    let guard = handle.lock();
+    match guard.vindex_drop(key_str) {
+        Ok(dropped) => dropped as c_int,
+        Err(e) => {
+            set_error(format!("VINDEX failed: {}", e));
+            -1
+        }
+    }
+}
+
 // =============================================================================
 // History Commands
 // =============================================================================
@@ -6199,7 +7229,7 @@ pub extern "C" fn redlite_history_get(
     let since_opt = if since > 0 { Some(since) } else { None };
     let until_opt = if until > 0 { Some(until) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_get(key_str, limit_opt, since_opt, until_opt) {
         Ok(entries) => {
             let len = entries.len();
@@ -6252,7 +7282,7 @@ pub extern "C" fn redlite_history_getat(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_get_at(key_str, timestamp) {
         Ok(Some(v)) => vec_to_bytes(v),
         Ok(None) => RedliteBytes { data: ptr::null_mut(), len: 0 },
@@ -6291,7 +7321,7 @@ pub extern "C" fn redlite_history_list(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_list_keys(pattern_opt) {
         Ok(keys) => {
             let len = keys.len();
@@ -6346,7 +7376,7 @@ pub extern "C" fn redlite_history_stats(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_stats(key_opt) {
         Ok(_stats) => {
             // For simplicity, return 0 for success (would need complex struct for full stats)
@@ -6380,7 +7410,7 @@ pub extern "C" fn redlite_history_clear(
 
     let before_opt = if before > 0 { Some(before) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_clear_key(key_str, before_opt) {
         Ok(count) => count,
         Err(e) => {
@@ -6400,7 +7430,7 @@ pub extern "C" fn redlite_history_prune(
     clear_error();
     let handle = get_db_ret!(db, -1);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_prune(before_timestamp) {
         Ok(count) => count,
         Err(e) => {
@@ -6410,6 +7440,27 @@ pub extern "C" fn redlite_history_prune(
     }
 }
 
+/// HISTORY PRUNE before_timestamp, at most `limit` of the oldest entries
+/// Returns number deleted, fewer than `limit` once none are left; -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_history_prune_batch(
+    db: *mut RedliteDb,
+    before_timestamp: i64,
+    limit: i64,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+
+    let guard = handle.lock();
+    match guard.history_prune_batch(before_timestamp, limit) {
+        Ok(count) => count,
+        Err(e) => {
+            set_error(format!("HISTORY PRUNE failed: {}", e));
+            -1
+        }
+    }
+}
+
 // =============================================================================
 // Server Commands
 // =============================================================================
@@ -6420,7 +7471,7 @@ pub extern "C" fn redlite_vacuum(db: *mut RedliteDb) -> i64 {
     clear_error();
     let handle = get_db_ret!(db, -1);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.vacuum() {
         Ok(n) => n,
         Err(e) => {
@@ -6430,71 +7481,259 @@ pub extern "C" fn redlite_vacuum(db: *mut RedliteDb) -> i64 {
     }
 }
 
-/// Get library version
+/// Enable or disable automatic cleanup of expired keys on this handle
+/// Returns 0 on success, -1 on error
 #[no_mangle]
-pub extern "C" fn redlite_version() -> *mut c_char {
-    CString::new(env!("CARGO_PKG_VERSION")).unwrap().into_raw()
+pub extern "C" fn redlite_set_autovacuum(db: *mut RedliteDb, enabled: c_int) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+
+    let guard = handle.lock();
+    guard.set_autovacuum(enabled != 0);
+    0
 }
 
-// =============================================================================
-// JSON Commands
-// =============================================================================
+/// Set the autovacuum interval in milliseconds (minimum 1000)
+/// Returns 0 on success, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_set_autovacuum_interval(db: *mut RedliteDb, interval_ms: i64) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
 
-/// JSON.SET key path value [NX|XX]
-/// Set JSON value at path. Returns true on success.
+    let guard = handle.lock();
+    guard.set_autovacuum_interval(interval_ms);
+    0
+}
+
+/// Get the autovacuum interval in milliseconds, -1 on error
 #[no_mangle]
-pub extern "C" fn redlite_json_set(
+pub extern "C" fn redlite_autovacuum_interval(db: *mut RedliteDb) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+
+    let guard = handle.lock();
+    guard.autovacuum_interval()
+}
+
+/// Set the time budget of one expiration / vacuum slice in microseconds
+/// (minimum 100)
+/// Returns 0 on success, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_set_autovacuum_budget(db: *mut RedliteDb, budget_us: i64) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+
+    let guard = handle.lock();
+    guard.set_autovacuum_budget(budget_us);
+    0
+}
+
+/// Get the autovacuum slice budget in microseconds, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_autovacuum_budget(db: *mut RedliteDb) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+
+    let guard = handle.lock();
+    guard.autovacuum_budget()
+}
+
+/// Run one bounded maintenance slice: expire keys, incremental vacuum, and an
+/// idle WAL checkpoint. budget_us <= 0 uses the autovacuum budget.
+/// Returns 0 on success, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_maintenance_step(
     db: *mut RedliteDb,
-    key: *const c_char,
-    path: *const c_char,
-    value: *const c_char,
-    nx: c_int,
-    xx: c_int,
+    budget_us: i64,
+    out: *mut RedliteMaintenanceStep,
 ) -> c_int {
     clear_error();
-    let handle = get_db_ret!(db, -1);
+    let handle = get_db!(db);
+    if out.is_null() {
+        set_error("NULL step pointer".to_string());
+        return -1;
+    }
 
-    let key_str = match cstr_to_str(key) {
-        Ok(s) => s,
-        Err(e) => {
-            set_error(e);
-            return -1;
-        }
-    };
-    let path_str = match cstr_to_str(path) {
-        Ok(s) => s,
-        Err(e) => {
-            set_error(e);
-            return -1;
-        }
-    };
-    let value_str = match cstr_to_str(value) {
-        Ok(s) => s,
-        Err(e) => {
-            set_error(e);
-            return -1;
+    let step = {
+        let guard = handle.lock();
+        let budget_us = if budget_us > 0 {
+            budget_us
+        } else {
+            guard.autovacuum_budget()
+        };
+        match guard.maintenance_step(Duration::from_micros(budget_us as u64)) {
+            Ok(s) => s,
+            Err(e) => {
+                set_error(format!("MAINTENANCE failed: {}", e));
+                return -1;
+            }
         }
     };
-
-    let guard = handle.db.lock().unwrap();
-    match guard.json_set(key_str, path_str, value_str, nx != 0, xx != 0) {
-        Ok(true) => 1,
-        Ok(false) => 0,
-        Err(e) => {
-            set_error(format!("JSON.SET failed: {}", e));
-            -1
-        }
+    unsafe {
+        *out = RedliteMaintenanceStep {
+            keys_reclaimed: step.keys_reclaimed,
+            pages_freed: step.pages_freed,
+            checkpointed: step.checkpointed as c_int,
+            more: step.more as c_int,
+            pause_us: step.pause_us,
+            keys_evicted: step.keys_evicted,
+        };
     }
+    0
 }
 
-/// JSON.GET key [path...]
-/// Get JSON value at path(s). Returns JSON string or null.
+/// Fill `out` with cumulative maintenance counters
+/// Returns 0 on success, -1 on error
 #[no_mangle]
-pub extern "C" fn redlite_json_get(
+pub extern "C" fn redlite_maintenance_stats(
     db: *mut RedliteDb,
-    key: *const c_char,
-    paths: *const *const c_char,
-    paths_len: usize,
+    out: *mut RedliteMaintenanceStats,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    if out.is_null() {
+        set_error("NULL stats pointer".to_string());
+        return -1;
+    }
+
+    let stats = handle.lock().maintenance_stats();
+    unsafe {
+        *out = RedliteMaintenanceStats {
+            steps: stats.steps,
+            keys_reclaimed: stats.keys_reclaimed,
+            pages_freed: stats.pages_freed,
+            checkpoints: stats.checkpoints,
+            pause_total_us: stats.pause_total_us,
+            pause_max_us: stats.pause_max_us,
+            keys_evicted: stats.keys_evicted,
+        };
+    }
+    0
+}
+
+/// Checkpoint the WAL and truncate it
+/// Returns 0 on success, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_checkpoint(db: *mut RedliteDb) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+
+    let guard = handle.lock();
+    match guard.checkpoint() {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("CHECKPOINT failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// Fill `out` with page cache, statement, checkpoint and lock-wait counters
+/// Returns 0 on success, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_stats(db: *mut RedliteDb, out: *mut RedliteStats) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    if out.is_null() {
+        set_error("NULL stats pointer".to_string());
+        return -1;
+    }
+
+    let stats = {
+        let guard = handle.lock();
+        match guard.sqlite_stats() {
+            Ok(s) => s,
+            Err(e) => {
+                set_error(format!("STATS failed: {}", e));
+                return -1;
+            }
+        }
+    };
+    unsafe {
+        *out = RedliteStats {
+            cache_hits: stats.cache_hits,
+            cache_misses: stats.cache_misses,
+            cache_writes: stats.cache_writes,
+            cache_spills: stats.cache_spills,
+            cache_bytes: stats.cache_bytes,
+            statements: stats.statements,
+            statement_bytes: stats.statement_bytes,
+            statement_runs: stats.statement_runs,
+            checkpoints: stats.checkpoints,
+            checkpoint_total_us: stats.checkpoint_total_us,
+            checkpoint_max_us: stats.checkpoint_max_us,
+            lock_waits: handle.lock_waits.load(Ordering::Relaxed),
+            lock_wait_ns: handle.lock_wait_ns.load(Ordering::Relaxed),
+        };
+    }
+    0
+}
+
+/// Get library version
+#[no_mangle]
+pub extern "C" fn redlite_version() -> *mut c_char {
+    CString::new(env!("CARGO_PKG_VERSION")).unwrap().into_raw()
+}
+
+// =============================================================================
+// JSON Commands
+// =============================================================================
+
+/// JSON.SET key path value [NX|XX]
+/// Set JSON value at path. Returns true on success.
+#[no_mangle]
+pub extern "C" fn redlite_json_set(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    path: *const c_char,
+    value: *const c_char,
+    nx: c_int,
+    xx: c_int,
+) -> c_int {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+
+    let key_str = match cstr_to_str(key) {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+    let path_str = match cstr_to_str(path) {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+    let value_str = match cstr_to_str(value) {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+
+    let guard = handle.lock();
+    match guard.json_set(key_str, path_str, value_str, nx != 0, xx != 0) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("JSON.SET failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// JSON.GET key [path...]
+/// Get JSON value at path(s). Returns JSON string or null.
+#[no_mangle]
+pub extern "C" fn redlite_json_get(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    paths: *const *const c_char,
+    paths_len: usize,
 ) -> *mut c_char {
     clear_error();
     let handle = get_db_ret!(db, ptr::null_mut());
@@ -6524,7 +7763,7 @@ pub extern "C" fn redlite_json_get(
         v
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.json_get(key_str, &path_vec) {
         Ok(Some(s)) => CString::new(s).unwrap().into_raw(),
         Ok(None) => ptr::null_mut(),
@@ -6565,7 +7804,7 @@ pub extern "C" fn redlite_json_del(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.json_del(key_str, path_opt) {
         Ok(n) => n,
         Err(e) => {
@@ -6605,7 +7844,7 @@ pub extern "C" fn redlite_json_type(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.json_type(key_str, path_opt) {
         Ok(Some(s)) => CString::new(s).unwrap().into_raw(),
         Ok(None) => ptr::null_mut(),
@@ -6643,7 +7882,7 @@ pub extern "C" fn redlite_json_numincrby(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.json_numincrby(key_str, path_str, increment) {
         Ok(s) => CString::new(s).unwrap().into_raw(),
         Err(e) => {
@@ -6691,7 +7930,7 @@ pub extern "C" fn redlite_json_strappend(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.json_strappend(key_str, path_opt, value_str) {
         Ok(n) => n,
         Err(e) => {
@@ -6731,7 +7970,7 @@ pub extern "C" fn redlite_json_strlen(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.json_strlen(key_str, path_opt) {
         Ok(Some(n)) => n,
         Ok(None) => -2, // Indicates null/not found (different from error)
@@ -6787,7 +8026,7 @@ pub extern "C" fn redlite_json_arrappend(
         }
     }
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.json_arrappend(key_str, path_str, &value_vec) {
         Ok(n) => n,
         Err(e) => {
@@ -6827,7 +8066,7 @@ pub extern "C" fn redlite_json_arrlen(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.json_arrlen(key_str, path_opt) {
         Ok(Some(n)) => n,
         Ok(None) => -2,
@@ -6871,7 +8110,7 @@ pub extern "C" fn redlite_json_arrpop(
     };
     let index_opt = if use_index != 0 { Some(index) } else { None };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.json_arrpop(key_str, path_opt, index_opt) {
         Ok(Some(s)) => CString::new(s).unwrap().into_raw(),
         Ok(None) => ptr::null_mut(),
@@ -6912,7 +8151,7 @@ pub extern "C" fn redlite_json_clear(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.json_clear(key_str, path_opt) {
         Ok(n) => n,
         Err(e) => {
@@ -6922,6 +8161,84 @@ pub extern "C" fn redlite_json_clear(
     }
 }
 
+/// JSON.SET many paths on one document: paths[i] gets values[i], applied in
+/// order with a single parse and write. Returns 1 on success, 0 if a path
+/// could not be set, -1 on error (nothing is written unless it returns 1).
+#[no_mangle]
+pub extern "C" fn redlite_json_set_many(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    paths: *const RedliteBytes,
+    values: *const RedliteBytes,
+    len: size_t,
+) -> c_int {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+    let (paths, values) = match (strs_from_bytes(paths, len), strs_from_bytes(values, len)) {
+        (Ok(p), Ok(v)) => (p, v),
+        (Err(e), _) | (_, Err(e)) => {
+            set_error(e);
+            return -1;
+        }
+    };
+    let updates: Vec<(&str, &str)> = paths.into_iter().zip(values).collect();
+
+    let guard = handle.lock();
+    match guard.json_set_many(key, &updates) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("JSON.SET failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// JSON.GET many paths from one document, one item per path. An item with
+/// NULL data means nothing matched that path. A NULL array with
+/// redlite_last_error() set means the call failed.
+#[no_mangle]
+pub extern "C" fn redlite_json_get_many(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    paths: *const RedliteBytes,
+    paths_len: size_t,
+) -> RedliteBytesArray {
+    clear_error();
+    let empty = RedliteBytesArray { items: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+    let paths = match strs_from_bytes(paths, paths_len) {
+        Ok(p) => p,
+        Err(e) => {
+            set_error(e);
+            return empty;
+        }
+    };
+    if paths.is_empty() {
+        return empty;
+    }
+
+    let guard = handle.lock();
+    match guard.json_get_many(key, &paths) {
+        Ok(results) => {
+            let mut items: Vec<RedliteBytes> =
+                results.into_iter().map(|r| opt_vec_to_bytes(r.map(String::into_bytes))).collect();
+            let len = items.len();
+            let ptr = items.as_mut_ptr();
+            std::mem::forget(items);
+            RedliteBytesArray { items: ptr, len }
+        }
+        Err(e) => {
+            set_error(format!("JSON.GET failed: {}", e));
+            empty
+        }
+    }
+}
+
 // =============================================================================
 // History Enable/Disable Commands
 // =============================================================================
@@ -6948,7 +8265,7 @@ pub extern "C" fn redlite_history_enable_global(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_enable_global(retention) {
         Ok(()) => 0,
         Err(e) => {
@@ -6980,7 +8297,7 @@ pub extern "C" fn redlite_history_enable_database(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_enable_database(db_num, retention) {
         Ok(()) => 0,
         Err(e) => {
@@ -7020,7 +8337,7 @@ pub extern "C" fn redlite_history_enable_key(
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_enable_key(key_str, retention) {
         Ok(()) => 0,
         Err(e) => {
@@ -7037,7 +8354,7 @@ pub extern "C" fn redlite_history_disable_global(db: *mut RedliteDb) -> c_int {
     clear_error();
     let handle = get_db_ret!(db, -1);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_disable_global() {
         Ok(()) => 0,
         Err(e) => {
@@ -7054,7 +8371,7 @@ pub extern "C" fn redlite_history_disable_database(db: *mut RedliteDb, db_num: c
     clear_error();
     let handle = get_db_ret!(db, -1);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_disable_database(db_num) {
         Ok(()) => 0,
         Err(e) => {
@@ -7079,7 +8396,7 @@ pub extern "C" fn redlite_history_disable_key(db: *mut RedliteDb, key: *const c_
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.history_disable_key(key_str) {
         Ok(()) => 0,
         Err(e) => {
@@ -7104,7 +8421,7 @@ pub extern "C" fn redlite_is_history_enabled(db: *mut RedliteDb, key: *const c_c
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.is_history_enabled(key_str) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -7126,7 +8443,7 @@ pub extern "C" fn redlite_fts_enable_global(db: *mut RedliteDb) -> c_int {
     clear_error();
     let handle = get_db_ret!(db, -1);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.fts_enable_global() {
         Ok(()) => 0,
         Err(e) => {
@@ -7143,7 +8460,7 @@ pub extern "C" fn redlite_fts_enable_database(db: *mut RedliteDb, db_num: c_int)
     clear_error();
     let handle = get_db_ret!(db, -1);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.fts_enable_database(db_num) {
         Ok(()) => 0,
         Err(e) => {
@@ -7168,7 +8485,7 @@ pub extern "C" fn redlite_fts_enable_pattern(db: *mut RedliteDb, pattern: *const
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.fts_enable_pattern(pattern_str) {
         Ok(()) => 0,
         Err(e) => {
@@ -7193,7 +8510,7 @@ pub extern "C" fn redlite_fts_enable_key(db: *mut RedliteDb, key: *const c_char)
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.fts_enable_key(key_str) {
         Ok(()) => 0,
         Err(e) => {
@@ -7210,7 +8527,7 @@ pub extern "C" fn redlite_fts_disable_global(db: *mut RedliteDb) -> c_int {
     clear_error();
     let handle = get_db_ret!(db, -1);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.fts_disable_global() {
         Ok(()) => 0,
         Err(e) => {
@@ -7227,7 +8544,7 @@ pub extern "C" fn redlite_fts_disable_database(db: *mut RedliteDb, db_num: c_int
     clear_error();
     let handle = get_db_ret!(db, -1);
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.fts_disable_database(db_num) {
         Ok(()) => 0,
         Err(e) => {
@@ -7252,7 +8569,7 @@ pub extern "C" fn redlite_fts_disable_pattern(db: *mut RedliteDb, pattern: *cons
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.fts_disable_pattern(pattern_str) {
         Ok(()) => 0,
         Err(e) => {
@@ -7277,7 +8594,7 @@ pub extern "C" fn redlite_fts_disable_key(db: *mut RedliteDb, key: *const c_char
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.fts_disable_key(key_str) {
         Ok(()) => 0,
         Err(e) => {
@@ -7302,7 +8619,7 @@ pub extern "C" fn redlite_is_fts_enabled(db: *mut RedliteDb, key: *const c_char)
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.is_fts_enabled(key_str) {
         Ok(true) => 1,
         Ok(false) => 0,
@@ -7370,7 +8687,7 @@ pub extern "C" fn redlite_keyinfo(db: *mut RedliteDb, key: *const c_char) -> Red
         }
     };
 
-    let guard = handle.db.lock().unwrap();
+    let guard = handle.lock();
     match guard.keyinfo(key_str) {
         Ok(Some(info)) => {
             let type_str = match info.key_type {
@@ -7397,3 +8714,3246 @@ pub extern "C" fn redlite_keyinfo(db: *mut RedliteDb, key: *const c_char) -> Red
         }
     }
 }
+
+/// Key version stamp for client-side cache validation
+#[repr(C)]
+pub struct RedliteKeyVersion {
+    /// Incremented on every write to the key
+    pub version: u64,
+    /// Created at timestamp in milliseconds (changes when a key is recreated)
+    pub created_at: i64,
+}
+
+/// Get the version stamp of a key (data + length).
+/// Returns 1 and fills `out` if the key exists, 0 if it doesn't, -1 on error.
+#[no_mangle]
+pub extern "C" fn redlite_key_version_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    out: *mut RedliteKeyVersion,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.key_version(key) {
+        Ok(Some((version, created_at))) => {
+            if !out.is_null() {
+                unsafe { *out = RedliteKeyVersion { version, created_at }; }
+            }
+            1
+        }
+        Ok(None) => 0,
+        Err(e) => {
+            set_error(format!("KEY_VERSION failed: {}", e));
+            -1
+        }
+    }
+}
+
+// =============================================================================
+// Length-delimited Variants
+// =============================================================================
+//
+// `_len` variants take `(const char* key, size_t key_len)` instead of
+// NUL-terminated strings, so callers can pass string views straight through
+// without copying. Multi-key/field arguments are passed as `RedliteBytes`
+// arrays. Keys must still be valid UTF-8 but may contain NUL bytes.
+
+/// GET key
+#[no_mangle]
+pub extern "C" fn redlite_get_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> RedliteBytes {
+    clear_error();
+    let null = RedliteBytes { data: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, null);
+    let key = key_arg!(key, key_len, null);
+
+    let guard = handle.lock();
+    match guard.get(key) {
+        Ok(v) => opt_vec_to_bytes(v),
+        Err(e) => {
+            set_error(format!("GET failed: {}", e));
+            null
+        }
+    }
+}
+
+/// SET key value [ttl_seconds]
+/// Returns 0 on success, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_set_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    value: *const u8,
+    value_len: size_t,
+    ttl_seconds: i64,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+
+    let value = bytes_to_vec(value, value_len);
+    let ttl = if ttl_seconds > 0 {
+        Some(Duration::from_secs(ttl_seconds as u64))
+    } else {
+        None
+    };
+
+    let guard = handle.lock();
+    match guard.set(key, &value, ttl) {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("SET failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// SETEX key seconds value
+#[no_mangle]
+pub extern "C" fn redlite_setex_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    seconds: i64,
+    value: *const u8,
+    value_len: size_t,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+
+    let value = bytes_to_vec(value, value_len);
+    let guard = handle.lock();
+    match guard.setex(key, seconds, &value) {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("SETEX failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// PSETEX key milliseconds value
+#[no_mangle]
+pub extern "C" fn redlite_psetex_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    milliseconds: i64,
+    value: *const u8,
+    value_len: size_t,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+
+    let value = bytes_to_vec(value, value_len);
+    let guard = handle.lock();
+    match guard.psetex(key, milliseconds, &value) {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("PSETEX failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// GETDEL key
+#[no_mangle]
+pub extern "C" fn redlite_getdel_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> RedliteBytes {
+    clear_error();
+    let null = RedliteBytes { data: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, null);
+    let key = key_arg!(key, key_len, null);
+
+    let guard = handle.lock();
+    match guard.getdel(key) {
+        Ok(v) => opt_vec_to_bytes(v),
+        Err(e) => {
+            set_error(format!("GETDEL failed: {}", e));
+            null
+        }
+    }
+}
+
+/// APPEND key value
+/// Returns new length, or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_append_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    value: *const u8,
+    value_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let value = bytes_to_vec(value, value_len);
+    let guard = handle.lock();
+    match guard.append(key, &value) {
+        Ok(len) => len,
+        Err(e) => {
+            set_error(format!("APPEND failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// STRLEN key
+#[no_mangle]
+pub extern "C" fn redlite_strlen_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.strlen(key) {
+        Ok(len) => len,
+        Err(e) => {
+            set_error(format!("STRLEN failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// GETRANGE key start end
+#[no_mangle]
+pub extern "C" fn redlite_getrange_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    start: i64,
+    end: i64,
+) -> RedliteBytes {
+    clear_error();
+    let null = RedliteBytes { data: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, null);
+    let key = key_arg!(key, key_len, null);
+
+    let guard = handle.lock();
+    match guard.getrange(key, start, end) {
+        Ok(v) => vec_to_bytes(v),
+        Err(e) => {
+            set_error(format!("GETRANGE failed: {}", e));
+            null
+        }
+    }
+}
+
+/// SETRANGE key offset value
+#[no_mangle]
+pub extern "C" fn redlite_setrange_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    offset: i64,
+    value: *const u8,
+    value_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let value = bytes_to_vec(value, value_len);
+    let guard = handle.lock();
+    match guard.setrange(key, offset, &value) {
+        Ok(len) => len,
+        Err(e) => {
+            set_error(format!("SETRANGE failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// INCR key
+#[no_mangle]
+pub extern "C" fn redlite_incr_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, i64::MIN);
+    let key = key_arg!(key, key_len, i64::MIN);
+
+    let guard = handle.lock();
+    match guard.incr(key) {
+        Ok(v) => v,
+        Err(e) => {
+            set_error(format!("INCR failed: {}", e));
+            i64::MIN
+        }
+    }
+}
+
+/// DECR key
+#[no_mangle]
+pub extern "C" fn redlite_decr_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, i64::MIN);
+    let key = key_arg!(key, key_len, i64::MIN);
+
+    let guard = handle.lock();
+    match guard.decr(key) {
+        Ok(v) => v,
+        Err(e) => {
+            set_error(format!("DECR failed: {}", e));
+            i64::MIN
+        }
+    }
+}
+
+/// INCRBY key increment
+#[no_mangle]
+pub extern "C" fn redlite_incrby_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    increment: i64,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, i64::MIN);
+    let key = key_arg!(key, key_len, i64::MIN);
+
+    let guard = handle.lock();
+    match guard.incrby(key, increment) {
+        Ok(v) => v,
+        Err(e) => {
+            set_error(format!("INCRBY failed: {}", e));
+            i64::MIN
+        }
+    }
+}
+
+/// DECRBY key decrement
+#[no_mangle]
+pub extern "C" fn redlite_decrby_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    decrement: i64,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, i64::MIN);
+    let key = key_arg!(key, key_len, i64::MIN);
+
+    let guard = handle.lock();
+    match guard.decrby(key, decrement) {
+        Ok(v) => v,
+        Err(e) => {
+            set_error(format!("DECRBY failed: {}", e));
+            i64::MIN
+        }
+    }
+}
+
+/// INCRBYFLOAT key increment
+/// Returns result as string (caller must free), NULL on error
+#[no_mangle]
+pub extern "C" fn redlite_incrbyfloat_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    increment: f64,
+) -> *mut c_char {
+    clear_error();
+    let handle = get_db_ret!(db, ptr::null_mut());
+    let key = key_arg!(key, key_len, ptr::null_mut());
+
+    let guard = handle.lock();
+    match guard.incrbyfloat(key, increment) {
+        Ok(v) => CString::new(v).unwrap().into_raw(),
+        Err(e) => {
+            set_error(format!("INCRBYFLOAT failed: {}", e));
+            ptr::null_mut()
+        }
+    }
+}
+
+/// MGET key [key ...]
+/// Missing keys are returned as NULL items
+#[no_mangle]
+pub extern "C" fn redlite_mget_len(
+    db: *mut RedliteDb,
+    keys: *const RedliteBytes,
+    keys_len: size_t,
+) -> RedliteBytesArray {
+    clear_error();
+    let empty = RedliteBytesArray { items: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+
+    let keys = match strs_from_bytes(keys, keys_len) {
+        Ok(k) if !k.is_empty() => k,
+        Ok(_) => return empty,
+        Err(e) => {
+            set_error(e);
+            return empty;
+        }
+    };
+
+    let guard = handle.lock();
+    let results = guard.mget(&keys);
+    vecs_to_bytes_array(results.into_iter().map(|v| v.unwrap_or_default()).collect())
+}
+
+/// MSET key value [key value ...]
+/// `keys` and `values` are parallel arrays of `count` items
+#[no_mangle]
+pub extern "C" fn redlite_mset_len(
+    db: *mut RedliteDb,
+    keys: *const RedliteBytes,
+    values: *const RedliteBytes,
+    count: size_t,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+
+    if keys.is_null() || values.is_null() || count == 0 {
+        return 0;
+    }
+
+    let keys = match strs_from_bytes(keys, count) {
+        Ok(k) => k,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+    let values = bytes_slices(values, count);
+    let pairs: Vec<(&str, &[u8])> = keys.into_iter().zip(values).collect();
+
+    let guard = handle.lock();
+    match guard.mset(&pairs) {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("MSET failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// DEL key [key ...]
+#[no_mangle]
+pub extern "C" fn redlite_del_len(db: *mut RedliteDb, keys: *const RedliteBytes, keys_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+
+    let keys = match strs_from_bytes(keys, keys_len) {
+        Ok(k) if !k.is_empty() => k,
+        Ok(_) => return 0,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+
+    let guard = handle.lock();
+    match guard.del(&keys) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("DEL failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// EXISTS key [key ...]
+#[no_mangle]
+pub extern "C" fn redlite_exists_len(db: *mut RedliteDb, keys: *const RedliteBytes, keys_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+
+    let keys = match strs_from_bytes(keys, keys_len) {
+        Ok(k) if !k.is_empty() => k,
+        Ok(_) => return 0,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+
+    let guard = handle.lock();
+    match guard.exists(&keys) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("EXISTS failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// TYPE key
+/// Returns type string (caller must free), NULL on error
+#[no_mangle]
+pub extern "C" fn redlite_type_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> *mut c_char {
+    clear_error();
+    let handle = get_db_ret!(db, ptr::null_mut());
+    let key = key_arg!(key, key_len, ptr::null_mut());
+
+    let guard = handle.lock();
+    match guard.key_type(key) {
+        Ok(Some(t)) => {
+            let type_str = match t {
+                redlite::KeyType::String => "string",
+                redlite::KeyType::List => "list",
+                redlite::KeyType::Set => "set",
+                redlite::KeyType::ZSet => "zset",
+                redlite::KeyType::Hash => "hash",
+                redlite::KeyType::Stream => "stream",
+                redlite::KeyType::Json => "ReJSON-RL",
+            };
+            CString::new(type_str).unwrap().into_raw()
+        }
+        Ok(None) => CString::new("none").unwrap().into_raw(),
+        Err(e) => {
+            set_error(format!("TYPE failed: {}", e));
+            ptr::null_mut()
+        }
+    }
+}
+
+/// TTL key
+/// Returns -2 if key doesn't exist, -1 if no TTL, otherwise seconds
+#[no_mangle]
+pub extern "C" fn redlite_ttl_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -3);
+    let key = key_arg!(key, key_len, -3);
+
+    let guard = handle.lock();
+    match guard.ttl(key) {
+        Ok(v) => v,
+        Err(e) => {
+            set_error(format!("TTL failed: {}", e));
+            -3
+        }
+    }
+}
+
+/// PTTL key
+/// Returns -2 if key doesn't exist, -1 if no TTL, otherwise milliseconds
+#[no_mangle]
+pub extern "C" fn redlite_pttl_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -3);
+    let key = key_arg!(key, key_len, -3);
+
+    let guard = handle.lock();
+    match guard.pttl(key) {
+        Ok(v) => v,
+        Err(e) => {
+            set_error(format!("PTTL failed: {}", e));
+            -3
+        }
+    }
+}
+
+/// EXPIRE key seconds
+#[no_mangle]
+pub extern "C" fn redlite_expire_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t, seconds: i64) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.expire(key, seconds) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("EXPIRE failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// PEXPIRE key milliseconds
+#[no_mangle]
+pub extern "C" fn redlite_pexpire_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    milliseconds: i64,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.pexpire(key, milliseconds) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("PEXPIRE failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// EXPIREAT key unix_seconds
+#[no_mangle]
+pub extern "C" fn redlite_expireat_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    unix_seconds: i64,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.expireat(key, unix_seconds) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("EXPIREAT failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// PEXPIREAT key unix_ms
+#[no_mangle]
+pub extern "C" fn redlite_pexpireat_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    unix_ms: i64,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.pexpireat(key, unix_ms) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("PEXPIREAT failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// PERSIST key
+#[no_mangle]
+pub extern "C" fn redlite_persist_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.persist(key) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("PERSIST failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// RENAME key newkey
+#[no_mangle]
+pub extern "C" fn redlite_rename_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    newkey: *const c_char,
+    newkey_len: size_t,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+    let newkey = key_arg!(newkey, newkey_len, -1);
+
+    let guard = handle.lock();
+    match guard.rename(key, newkey) {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("RENAME failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// RENAMENX key newkey
+#[no_mangle]
+pub extern "C" fn redlite_renamenx_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    newkey: *const c_char,
+    newkey_len: size_t,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+    let newkey = key_arg!(newkey, newkey_len, -1);
+
+    let guard = handle.lock();
+    match guard.renamenx(key, newkey) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("RENAMENX failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// HSET key field value [field value ...]
+/// `fields` and `values` are parallel arrays of `count` items
+#[no_mangle]
+pub extern "C" fn redlite_hset_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    fields: *const RedliteBytes,
+    values: *const RedliteBytes,
+    count: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    if fields.is_null() || values.is_null() || count == 0 {
+        return 0;
+    }
+
+    let fields = match strs_from_bytes(fields, count) {
+        Ok(f) => f,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+    let values = bytes_slices(values, count);
+    let pairs: Vec<(&str, &[u8])> = fields.into_iter().zip(values).collect();
+
+    let guard = handle.lock();
+    match guard.hset(key, &pairs) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("HSET failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// HGET key field
+#[no_mangle]
+pub extern "C" fn redlite_hget_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    field: *const c_char,
+    field_len: size_t,
+) -> RedliteBytes {
+    clear_error();
+    let null = RedliteBytes { data: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, null);
+    let key = key_arg!(key, key_len, null);
+    let field = key_arg!(field, field_len, null);
+
+    let guard = handle.lock();
+    match guard.hget(key, field) {
+        Ok(v) => opt_vec_to_bytes(v),
+        Err(e) => {
+            set_error(format!("HGET failed: {}", e));
+            null
+        }
+    }
+}
+
+/// HDEL key field [field ...]
+#[no_mangle]
+pub extern "C" fn redlite_hdel_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    fields: *const RedliteBytes,
+    fields_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let fields = match strs_from_bytes(fields, fields_len) {
+        Ok(f) if !f.is_empty() => f,
+        Ok(_) => return 0,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+
+    let guard = handle.lock();
+    match guard.hdel(key, &fields) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("HDEL failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// HEXISTS key field
+#[no_mangle]
+pub extern "C" fn redlite_hexists_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    field: *const c_char,
+    field_len: size_t,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+    let field = key_arg!(field, field_len, -1);
+
+    let guard = handle.lock();
+    match guard.hexists(key, field) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("HEXISTS failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// HLEN key
+#[no_mangle]
+pub extern "C" fn redlite_hlen_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.hlen(key) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("HLEN failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// HKEYS key
+#[no_mangle]
+pub extern "C" fn redlite_hkeys_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> RedliteStringArray {
+    clear_error();
+    let empty = RedliteStringArray { strings: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let guard = handle.lock();
+    match guard.hkeys(key) {
+        Ok(keys) => strings_to_array(keys),
+        Err(e) => {
+            set_error(format!("HKEYS failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// HVALS key
+#[no_mangle]
+pub extern "C" fn redlite_hvals_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> RedliteBytesArray {
+    clear_error();
+    let empty = RedliteBytesArray { items: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let guard = handle.lock();
+    match guard.hvals(key) {
+        Ok(vals) => vecs_to_bytes_array(vals),
+        Err(e) => {
+            set_error(format!("HVALS failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// HINCRBY key field increment
+#[no_mangle]
+pub extern "C" fn redlite_hincrby_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    field: *const c_char,
+    field_len: size_t,
+    increment: i64,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, i64::MIN);
+    let key = key_arg!(key, key_len, i64::MIN);
+    let field = key_arg!(field, field_len, i64::MIN);
+
+    let guard = handle.lock();
+    match guard.hincrby(key, field, increment) {
+        Ok(v) => v,
+        Err(e) => {
+            set_error(format!("HINCRBY failed: {}", e));
+            i64::MIN
+        }
+    }
+}
+
+/// HGETALL key
+/// Returns alternating field-value pairs
+#[no_mangle]
+pub extern "C" fn redlite_hgetall_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> RedliteBytesArray {
+    clear_error();
+    let empty = RedliteBytesArray { items: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let guard = handle.lock();
+    match guard.hgetall(key) {
+        Ok(pairs) => {
+            let mut flat: Vec<Vec<u8>> = Vec::with_capacity(pairs.len() * 2);
+            for (field, value) in pairs {
+                flat.push(field.into_bytes());
+                flat.push(value);
+            }
+            vecs_to_bytes_array(flat)
+        }
+        Err(e) => {
+            set_error(format!("HGETALL failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// HMGET key field [field ...]
+#[no_mangle]
+pub extern "C" fn redlite_hmget_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    fields: *const RedliteBytes,
+    fields_len: size_t,
+) -> RedliteBytesArray {
+    clear_error();
+    let empty = RedliteBytesArray { items: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let fields = match strs_from_bytes(fields, fields_len) {
+        Ok(f) if !f.is_empty() => f,
+        Ok(_) => return empty,
+        Err(e) => {
+            set_error(e);
+            return empty;
+        }
+    };
+
+    let guard = handle.lock();
+    match guard.hmget(key, &fields) {
+        Ok(results) => vecs_to_bytes_array(results.into_iter().map(|v| v.unwrap_or_default()).collect()),
+        Err(e) => {
+            set_error(format!("HMGET failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// LPUSH key value [value ...]
+#[no_mangle]
+pub extern "C" fn redlite_lpush_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    values: *const RedliteBytes,
+    values_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    if values.is_null() || values_len == 0 {
+        set_error("No values provided".to_string());
+        return -1;
+    }
+    let values = bytes_slices(values, values_len);
+
+    let guard = handle.lock();
+    match guard.lpush(key, &values) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("LPUSH failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// RPUSH key value [value ...]
+#[no_mangle]
+pub extern "C" fn redlite_rpush_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    values: *const RedliteBytes,
+    values_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    if values.is_null() || values_len == 0 {
+        set_error("No values provided".to_string());
+        return -1;
+    }
+    let values = bytes_slices(values, values_len);
+
+    let guard = handle.lock();
+    match guard.rpush(key, &values) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("RPUSH failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// LPOP key [count]
+#[no_mangle]
+pub extern "C" fn redlite_lpop_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    count: size_t,
+) -> RedliteBytesArray {
+    clear_error();
+    let empty = RedliteBytesArray { items: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let guard = handle.lock();
+    match guard.lpop(key, Some(count.max(1))) {
+        Ok(vals) => vecs_to_bytes_array(vals),
+        Err(e) => {
+            set_error(format!("LPOP failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// RPOP key [count]
+#[no_mangle]
+pub extern "C" fn redlite_rpop_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    count: size_t,
+) -> RedliteBytesArray {
+    clear_error();
+    let empty = RedliteBytesArray { items: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let guard = handle.lock();
+    match guard.rpop(key, Some(count.max(1))) {
+        Ok(vals) => vecs_to_bytes_array(vals),
+        Err(e) => {
+            set_error(format!("RPOP failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// LLEN key
+#[no_mangle]
+pub extern "C" fn redlite_llen_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.llen(key) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("LLEN failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// LRANGE key start stop
+#[no_mangle]
+pub extern "C" fn redlite_lrange_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    start: i64,
+    stop: i64,
+) -> RedliteBytesArray {
+    clear_error();
+    let empty = RedliteBytesArray { items: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let guard = handle.lock();
+    match guard.lrange(key, start, stop) {
+        Ok(vals) => vecs_to_bytes_array(vals),
+        Err(e) => {
+            set_error(format!("LRANGE failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// LINDEX key index
+#[no_mangle]
+pub extern "C" fn redlite_lindex_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    index: i64,
+) -> RedliteBytes {
+    clear_error();
+    let null = RedliteBytes { data: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, null);
+    let key = key_arg!(key, key_len, null);
+
+    let guard = handle.lock();
+    match guard.lindex(key, index) {
+        Ok(v) => opt_vec_to_bytes(v),
+        Err(e) => {
+            set_error(format!("LINDEX failed: {}", e));
+            null
+        }
+    }
+}
+
+/// SADD key member [member ...]
+#[no_mangle]
+pub extern "C" fn redlite_sadd_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    members: *const RedliteBytes,
+    members_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    if members.is_null() || members_len == 0 {
+        return 0;
+    }
+    let members = bytes_slices(members, members_len);
+
+    let guard = handle.lock();
+    match guard.sadd(key, &members) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("SADD failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// SREM key member [member ...]
+#[no_mangle]
+pub extern "C" fn redlite_srem_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    members: *const RedliteBytes,
+    members_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    if members.is_null() || members_len == 0 {
+        return 0;
+    }
+    let members = bytes_slices(members, members_len);
+
+    let guard = handle.lock();
+    match guard.srem(key, &members) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("SREM failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// SMEMBERS key
+#[no_mangle]
+pub extern "C" fn redlite_smembers_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> RedliteBytesArray {
+    clear_error();
+    let empty = RedliteBytesArray { items: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let guard = handle.lock();
+    match guard.smembers(key) {
+        Ok(members) => vecs_to_bytes_array(members),
+        Err(e) => {
+            set_error(format!("SMEMBERS failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// SISMEMBER key member
+#[no_mangle]
+pub extern "C" fn redlite_sismember_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    member: *const u8,
+    member_len: size_t,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let key = key_arg!(key, key_len, -1);
+
+    let member = bytes_to_vec(member, member_len);
+    let guard = handle.lock();
+    match guard.sismember(key, &member) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("SISMEMBER failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// SCARD key
+#[no_mangle]
+pub extern "C" fn redlite_scard_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.scard(key) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("SCARD failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// ZADD key score member [score member ...]
+#[no_mangle]
+pub extern "C" fn redlite_zadd_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    members: *const RedliteZMember,
+    members_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    if members.is_null() || members_len == 0 {
+        return 0;
+    }
+
+    let zmembers: Vec<redlite::ZMember> = unsafe { slice::from_raw_parts(members, members_len) }
+        .iter()
+        .map(|m| redlite::ZMember::new(m.score, bytes_to_vec(m.member, m.member_len)))
+        .collect();
+
+    let guard = handle.lock();
+    match guard.zadd(key, &zmembers) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("ZADD failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// ZREM key member [member ...]
+#[no_mangle]
+pub extern "C" fn redlite_zrem_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    members: *const RedliteBytes,
+    members_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    if members.is_null() || members_len == 0 {
+        return 0;
+    }
+    let members = bytes_slices(members, members_len);
+
+    let guard = handle.lock();
+    match guard.zrem(key, &members) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("ZREM failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// ZSCORE key member
+/// Returns NaN if not found or on error
+#[no_mangle]
+pub extern "C" fn redlite_zscore_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    member: *const u8,
+    member_len: size_t,
+) -> f64 {
+    clear_error();
+    let handle = get_db_ret!(db, f64::NAN);
+    let key = key_arg!(key, key_len, f64::NAN);
+
+    let member = bytes_to_vec(member, member_len);
+    let guard = handle.lock();
+    match guard.zscore(key, &member) {
+        Ok(Some(score)) => score,
+        Ok(None) => f64::NAN,
+        Err(e) => {
+            set_error(format!("ZSCORE failed: {}", e));
+            f64::NAN
+        }
+    }
+}
+
+/// ZCARD key
+#[no_mangle]
+pub extern "C" fn redlite_zcard_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.zcard(key) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("ZCARD failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// ZCOUNT key min max
+#[no_mangle]
+pub extern "C" fn redlite_zcount_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    min: f64,
+    max: f64,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.zcount(key, min, max) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("ZCOUNT failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// ZINCRBY key increment member
+#[no_mangle]
+pub extern "C" fn redlite_zincrby_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    increment: f64,
+    member: *const u8,
+    member_len: size_t,
+) -> f64 {
+    clear_error();
+    let handle = get_db_ret!(db, f64::NAN);
+    let key = key_arg!(key, key_len, f64::NAN);
+
+    let member = bytes_to_vec(member, member_len);
+    let guard = handle.lock();
+    match guard.zincrby(key, increment, &member) {
+        Ok(score) => score,
+        Err(e) => {
+            set_error(format!("ZINCRBY failed: {}", e));
+            f64::NAN
+        }
+    }
+}
+
+/// Flatten sorted set members, optionally as alternating member-score pairs
+fn zmembers_to_bytes_array(members: Vec<redlite::ZMember>, with_scores: bool) -> RedliteBytesArray {
+    if with_scores {
+        let mut flat: Vec<Vec<u8>> = Vec::with_capacity(members.len() * 2);
+        for zm in members {
+            flat.push(zm.member);
+            flat.push(zm.score.to_string().into_bytes());
+        }
+        vecs_to_bytes_array(flat)
+    } else {
+        vecs_to_bytes_array(members.into_iter().map(|zm| zm.member).collect())
+    }
+}
+
+/// ZRANGE key start stop [withscores]
+/// If withscores is true, returns alternating member-score pairs
+#[no_mangle]
+pub extern "C" fn redlite_zrange_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    start: i64,
+    stop: i64,
+    with_scores: c_int,
+) -> RedliteBytesArray {
+    clear_error();
+    let empty = RedliteBytesArray { items: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let guard = handle.lock();
+    match guard.zrange(key, start, stop, with_scores != 0) {
+        Ok(members) => zmembers_to_bytes_array(members, with_scores != 0),
+        Err(e) => {
+            set_error(format!("ZRANGE failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// ZREVRANGE key start stop [withscores]
+/// If withscores is true, returns alternating member-score pairs
+#[no_mangle]
+pub extern "C" fn redlite_zrevrange_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    start: i64,
+    stop: i64,
+    with_scores: c_int,
+) -> RedliteBytesArray {
+    clear_error();
+    let empty = RedliteBytesArray { items: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let guard = handle.lock();
+    match guard.zrevrange(key, start, stop, with_scores != 0) {
+        Ok(members) => zmembers_to_bytes_array(members, with_scores != 0),
+        Err(e) => {
+            set_error(format!("ZREVRANGE failed: {}", e));
+            empty
+        }
+    }
+}
+
+const EMPTY_ZMEMBER_ARRAY: RedliteZMemberArray = RedliteZMemberArray {
+    members: ptr::null_mut(),
+    len: 0,
+    data: ptr::null_mut(),
+    data_len: 0,
+};
+
+/// Pack members into one byte buffer plus (score, member) records pointing into it
+fn zmembers_to_packed(members: Vec<redlite::ZMember>) -> RedliteZMemberArray {
+    if members.is_empty() {
+        return EMPTY_ZMEMBER_ARRAY;
+    }
+
+    let data_len: usize = members.iter().map(|zm| zm.member.len()).sum();
+    let mut data: Vec<u8> = Vec::with_capacity(data_len);
+    for zm in &members {
+        data.extend_from_slice(&zm.member);
+    }
+    let mut data = data.into_boxed_slice();
+    let base = if data_len == 0 { ptr::null_mut() } else { data.as_mut_ptr() };
+
+    let mut offset = 0;
+    let mut records: Vec<RedliteZMember> = Vec::with_capacity(members.len());
+    for zm in &members {
+        let len = zm.member.len();
+        records.push(RedliteZMember {
+            score: zm.score,
+            member: if len == 0 { ptr::null() } else { unsafe { base.add(offset) } },
+            member_len: len,
+        });
+        offset += len;
+    }
+    let mut records = records.into_boxed_slice();
+    let len = records.len();
+    let records_ptr = records.as_mut_ptr();
+    std::mem::forget(records);
+    std::mem::forget(data);
+
+    RedliteZMemberArray {
+        members: records_ptr,
+        len,
+        data: base,
+        data_len,
+    }
+}
+
+/// ZRANGE key start stop WITHSCORES
+/// Returns members with binary scores; free with redlite_free_zmember_array
+#[no_mangle]
+pub extern "C" fn redlite_zrange_scored_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    start: i64,
+    stop: i64,
+) -> RedliteZMemberArray {
+    clear_error();
+    let handle = get_db_ret!(db, EMPTY_ZMEMBER_ARRAY);
+    let key = key_arg!(key, key_len, EMPTY_ZMEMBER_ARRAY);
+
+    let guard = handle.lock();
+    match guard.zrange(key, start, stop, true) {
+        Ok(members) => zmembers_to_packed(members),
+        Err(e) => {
+            set_error(format!("ZRANGE failed: {}", e));
+            EMPTY_ZMEMBER_ARRAY
+        }
+    }
+}
+
+/// ZREVRANGE key start stop WITHSCORES
+/// Returns members with binary scores; free with redlite_free_zmember_array
+#[no_mangle]
+pub extern "C" fn redlite_zrevrange_scored_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    start: i64,
+    stop: i64,
+) -> RedliteZMemberArray {
+    clear_error();
+    let handle = get_db_ret!(db, EMPTY_ZMEMBER_ARRAY);
+    let key = key_arg!(key, key_len, EMPTY_ZMEMBER_ARRAY);
+
+    let guard = handle.lock();
+    match guard.zrevrange(key, start, stop, true) {
+        Ok(members) => zmembers_to_packed(members),
+        Err(e) => {
+            set_error(format!("ZREVRANGE failed: {}", e));
+            EMPTY_ZMEMBER_ARRAY
+        }
+    }
+}
+
+/// ZRANGEBYSCORE key min max WITHSCORES [LIMIT offset count]
+/// offset/count: use -1 for none
+/// Returns members with binary scores; free with redlite_free_zmember_array
+#[no_mangle]
+pub extern "C" fn redlite_zrangebyscore_scored_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    min: f64,
+    max: f64,
+    offset: i64,
+    count: i64,
+) -> RedliteZMemberArray {
+    clear_error();
+    let handle = get_db_ret!(db, EMPTY_ZMEMBER_ARRAY);
+    let key = key_arg!(key, key_len, EMPTY_ZMEMBER_ARRAY);
+
+    let offset_opt = if offset >= 0 { Some(offset) } else { None };
+    let count_opt = if count >= 0 { Some(count) } else { None };
+
+    let guard = handle.lock();
+    match guard.zrangebyscore(key, min, max, offset_opt, count_opt) {
+        Ok(members) => zmembers_to_packed(members),
+        Err(e) => {
+            set_error(format!("ZRANGEBYSCORE failed: {}", e));
+            EMPTY_ZMEMBER_ARRAY
+        }
+    }
+}
+
+/// ZRANK key member
+/// Returns rank (0-based), -1 if not found, -2 on error
+#[no_mangle]
+pub extern "C" fn redlite_zrank_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    member: *const u8,
+    member_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -2);
+    let key = key_arg!(key, key_len, -2);
+    let member = bytes_to_vec(member, member_len);
+
+    let guard = handle.lock();
+    match guard.zrank(key, &member) {
+        Ok(Some(rank)) => rank,
+        Ok(None) => -1,
+        Err(e) => {
+            set_error(format!("ZRANK failed: {}", e));
+            -2
+        }
+    }
+}
+
+/// ZREVRANK key member
+/// Returns reverse rank (0-based), -1 if not found, -2 on error
+#[no_mangle]
+pub extern "C" fn redlite_zrevrank_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    member: *const u8,
+    member_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -2);
+    let key = key_arg!(key, key_len, -2);
+    let member = bytes_to_vec(member, member_len);
+
+    let guard = handle.lock();
+    match guard.zrevrank(key, &member) {
+        Ok(Some(rank)) => rank,
+        Ok(None) => -1,
+        Err(e) => {
+            set_error(format!("ZREVRANK failed: {}", e));
+            -2
+        }
+    }
+}
+
+/// GETBIT key offset
+/// Returns bit value (0 or 1), or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_getbit_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    offset: u64,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.getbit(key, offset) {
+        Ok(bit) => bit,
+        Err(e) => {
+            set_error(format!("GETBIT failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// SETBIT key offset value
+/// Returns previous bit value (0 or 1), or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_setbit_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    offset: u64,
+    value: c_int,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.setbit(key, offset, value != 0) {
+        Ok(prev) => prev,
+        Err(e) => {
+            set_error(format!("SETBIT failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// BITCOUNT key [start end]
+/// Returns number of set bits, or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_bitcount_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    start: i64,
+    end: i64,
+    use_range: c_int,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let start_opt = if use_range != 0 { Some(start) } else { None };
+    let end_opt = if use_range != 0 { Some(end) } else { None };
+
+    let guard = handle.lock();
+    match guard.bitcount(key, start_opt, end_opt) {
+        Ok(count) => count,
+        Err(e) => {
+            set_error(format!("BITCOUNT failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// BITOP operation destkey key [key ...]
+/// Returns length of result string, or -1 on error
+/// operation: "AND", "OR", "XOR", "NOT"
+#[no_mangle]
+pub extern "C" fn redlite_bitop_len(
+    db: *mut RedliteDb,
+    operation: *const c_char,
+    destkey: *const c_char,
+    destkey_len: size_t,
+    keys: *const RedliteBytes,
+    keys_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+
+    let op = match cstr_to_str(operation) {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+    let dest = key_arg!(destkey, destkey_len, -1);
+    let keys = match strs_from_bytes(keys, keys_len) {
+        Ok(k) if !k.is_empty() => k,
+        Ok(_) => {
+            set_error("BITOP requires at least one source key".to_string());
+            return -1;
+        }
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+
+    let guard = handle.lock();
+    match guard.bitop(op, dest, &keys) {
+        Ok(len) => len,
+        Err(e) => {
+            set_error(format!("BITOP failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// XADD key [NOMKSTREAM] [MAXLEN threshold] *|ID field value [field value ...]
+/// Returns the entry ID, or {-1, -1} on error. An ID of {0, 0} auto-generates one.
+#[no_mangle]
+pub extern "C" fn redlite_xadd_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    id_ms: i64,
+    id_seq: i64,
+    fields: *const RedliteStreamField,
+    fields_len: size_t,
+    nomkstream: c_int,
+    maxlen: i64,
+    use_maxlen: c_int,
+) -> RedliteStreamId {
+    clear_error();
+    let failed = RedliteStreamId { ms: -1, seq: -1 };
+    let handle = get_db_ret!(db, failed);
+    let key = key_arg!(key, key_len, failed);
+
+    if fields.is_null() || fields_len == 0 {
+        set_error("XADD requires at least one field-value pair".to_string());
+        return failed;
+    }
+
+    let field_refs: Vec<(&[u8], &[u8])> = unsafe { slice::from_raw_parts(fields, fields_len) }
+        .iter()
+        .map(|f| (bytes_slice(f.key, f.key_len), bytes_slice(f.value, f.value_len)))
+        .collect();
+    let stream_id = if id_ms == 0 && id_seq == 0 {
+        None
+    } else {
+        Some(redlite::StreamId { ms: id_ms, seq: id_seq })
+    };
+    let maxlen_opt = if use_maxlen != 0 { Some(maxlen) } else { None };
+
+    let guard = handle.lock();
+    match guard.xadd(key, stream_id, &field_refs, nomkstream != 0, maxlen_opt, None, false) {
+        Ok(Some(id)) => RedliteStreamId { ms: id.ms, seq: id.seq },
+        Ok(None) => {
+            set_error("XADD returned no ID (stream not created)".to_string());
+            failed
+        }
+        Err(e) => {
+            set_error(format!("XADD failed: {}", e));
+            failed
+        }
+    }
+}
+
+/// XLEN key
+/// Returns stream length, or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_xlen_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.xlen(key) {
+        Ok(len) => len,
+        Err(e) => {
+            set_error(format!("XLEN failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// XRANGE key start end [COUNT count]
+#[no_mangle]
+pub extern "C" fn redlite_xrange_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    start_ms: i64,
+    start_seq: i64,
+    end_ms: i64,
+    end_seq: i64,
+    count: i64,
+    use_count: c_int,
+) -> RedliteStreamEntryArray {
+    clear_error();
+    let empty = RedliteStreamEntryArray { entries: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let start = redlite::StreamId { ms: start_ms, seq: start_seq };
+    let end = redlite::StreamId { ms: end_ms, seq: end_seq };
+    let count_opt = if use_count != 0 { Some(count) } else { None };
+
+    let guard = handle.lock();
+    match guard.xrange(key, start, end, count_opt) {
+        Ok(entries) => stream_entries_to_array(entries),
+        Err(e) => {
+            set_error(format!("XRANGE failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// XREVRANGE key end start [COUNT count]
+#[no_mangle]
+pub extern "C" fn redlite_xrevrange_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    end_ms: i64,
+    end_seq: i64,
+    start_ms: i64,
+    start_seq: i64,
+    count: i64,
+    use_count: c_int,
+) -> RedliteStreamEntryArray {
+    clear_error();
+    let empty = RedliteStreamEntryArray { entries: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let end = redlite::StreamId { ms: end_ms, seq: end_seq };
+    let start = redlite::StreamId { ms: start_ms, seq: start_seq };
+    let count_opt = if use_count != 0 { Some(count) } else { None };
+
+    let guard = handle.lock();
+    match guard.xrevrange(key, end, start, count_opt) {
+        Ok(entries) => stream_entries_to_array(entries),
+        Err(e) => {
+            set_error(format!("XREVRANGE failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// XREAD [COUNT count] STREAMS key id - single key
+#[no_mangle]
+pub extern "C" fn redlite_xread_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    id_ms: i64,
+    id_seq: i64,
+    count: i64,
+    use_count: c_int,
+) -> RedliteStreamEntryArray {
+    clear_error();
+    let empty = RedliteStreamEntryArray { entries: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let after = redlite::StreamId { ms: id_ms, seq: id_seq };
+    let count_opt = if use_count != 0 { Some(count) } else { None };
+
+    let guard = handle.lock();
+    match guard.xread(&[key], &[after], count_opt) {
+        Ok(results) => stream_entries_to_array(results.into_iter().flat_map(|(_, e)| e).collect()),
+        Err(e) => {
+            set_error(format!("XREAD failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// XTRIM key MAXLEN count
+/// Returns number of entries deleted, or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_xtrim_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t, maxlen: i64) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.xtrim(key, Some(maxlen), None, false) {
+        Ok(count) => count,
+        Err(e) => {
+            set_error(format!("XTRIM failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// XDEL key id [id ...]
+/// Returns number of entries deleted, or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_xdel_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    ids: *const RedliteStreamId,
+    ids_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let ids = stream_ids_from_raw(ids, ids_len);
+    if ids.is_empty() {
+        return 0;
+    }
+
+    let guard = handle.lock();
+    match guard.xdel(key, &ids) {
+        Ok(count) => count,
+        Err(e) => {
+            set_error(format!("XDEL failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// XGROUP CREATE key group id [MKSTREAM]
+/// Returns 1 on success, 0 on error
+#[no_mangle]
+pub extern "C" fn redlite_xgroup_create_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    group: *const c_char,
+    group_len: size_t,
+    id_ms: i64,
+    id_seq: i64,
+    mkstream: c_int,
+) -> c_int {
+    clear_error();
+    let handle = get_db_ret!(db, 0);
+    let key = key_arg!(key, key_len, 0);
+    let group = key_arg!(group, group_len, 0);
+
+    let guard = handle.lock();
+    match guard.xgroup_create(key, group, redlite::StreamId { ms: id_ms, seq: id_seq }, mkstream != 0) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("XGROUP CREATE failed: {}", e));
+            0
+        }
+    }
+}
+
+/// XGROUP DESTROY key group
+/// Returns 1 if group was destroyed, 0 otherwise
+#[no_mangle]
+pub extern "C" fn redlite_xgroup_destroy_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    group: *const c_char,
+    group_len: size_t,
+) -> c_int {
+    clear_error();
+    let handle = get_db_ret!(db, 0);
+    let key = key_arg!(key, key_len, 0);
+    let group = key_arg!(group, group_len, 0);
+
+    let guard = handle.lock();
+    match guard.xgroup_destroy(key, group) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("XGROUP DESTROY failed: {}", e));
+            0
+        }
+    }
+}
+
+/// XGROUP SETID key group id
+/// Returns 1 on success, 0 if group doesn't exist, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_xgroup_setid_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    group: *const c_char,
+    group_len: size_t,
+    id_ms: i64,
+    id_seq: i64,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+    let group = key_arg!(group, group_len, -1);
+
+    let guard = handle.lock();
+    match guard.xgroup_setid(key, group, redlite::StreamId { ms: id_ms, seq: id_seq }) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("XGROUP SETID failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// XGROUP CREATECONSUMER key group consumer
+/// Returns 1 if consumer was created, 0 if it already existed, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_xgroup_createconsumer_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    group: *const c_char,
+    group_len: size_t,
+    consumer: *const c_char,
+    consumer_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+    let group = key_arg!(group, group_len, -1);
+    let consumer = key_arg!(consumer, consumer_len, -1);
+
+    let guard = handle.lock();
+    match guard.xgroup_createconsumer(key, group, consumer) {
+        Ok(true) => 1,
+        Ok(false) => 0,
+        Err(e) => {
+            set_error(format!("XGROUP CREATECONSUMER failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// XGROUP DELCONSUMER key group consumer
+/// Returns number of pending messages consumer had, or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_xgroup_delconsumer_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    group: *const c_char,
+    group_len: size_t,
+    consumer: *const c_char,
+    consumer_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+    let group = key_arg!(group, group_len, -1);
+    let consumer = key_arg!(consumer, consumer_len, -1);
+
+    let guard = handle.lock();
+    match guard.xgroup_delconsumer(key, group, consumer) {
+        Ok(count) => count,
+        Err(e) => {
+            set_error(format!("XGROUP DELCONSUMER failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// XREADGROUP GROUP group consumer [COUNT count] [NOACK] STREAMS key id - single key
+/// Use ">" for id to get new messages
+#[no_mangle]
+pub extern "C" fn redlite_xreadgroup_len(
+    db: *mut RedliteDb,
+    group: *const c_char,
+    group_len: size_t,
+    consumer: *const c_char,
+    consumer_len: size_t,
+    key: *const c_char,
+    key_len: size_t,
+    id: *const c_char,
+    id_len: size_t,
+    count: i64,
+    use_count: c_int,
+    noack: c_int,
+) -> RedliteStreamEntryArray {
+    clear_error();
+    let empty = RedliteStreamEntryArray { entries: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let group = key_arg!(group, group_len, empty);
+    let consumer = key_arg!(consumer, consumer_len, empty);
+    let key = key_arg!(key, key_len, empty);
+    let id = key_arg!(id, id_len, empty);
+
+    let count_opt = if use_count != 0 { Some(count) } else { None };
+
+    let guard = handle.lock();
+    match guard.xreadgroup(group, consumer, &[key], &[id], count_opt, noack != 0) {
+        Ok(results) => stream_entries_to_array(results.into_iter().flat_map(|(_, e)| e).collect()),
+        Err(e) => {
+            set_error(format!("XREADGROUP failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// XACK key group id [id ...]
+/// Returns number of messages acknowledged, or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_xack_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    group: *const c_char,
+    group_len: size_t,
+    ids: *const RedliteStreamId,
+    ids_len: size_t,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+    let group = key_arg!(group, group_len, -1);
+
+    let ids = stream_ids_from_raw(ids, ids_len);
+    if ids.is_empty() {
+        return 0;
+    }
+
+    let guard = handle.lock();
+    match guard.xack(key, group, &ids) {
+        Ok(count) => count,
+        Err(e) => {
+            set_error(format!("XACK failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// VADD key FP32 values element [SETATTR attributes]
+/// `attributes` NULL means none. Returns 1 if added, 0 if updated, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_vadd_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    values: *const f32,
+    dim: size_t,
+    element: *const c_char,
+    element_len: size_t,
+    attributes: *const c_char,
+    attributes_len: size_t,
+) -> c_int {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+    let element = key_arg!(element, element_len, -1);
+    let attributes = if attributes.is_null() {
+        None
+    } else {
+        Some(key_arg!(attributes, attributes_len, -1))
+    };
+    if values.is_null() || dim == 0 {
+        set_error("VADD failed: empty vector".to_string());
+        return -1;
+    }
+    let embedding = unsafe { slice::from_raw_parts(values, dim) };
+
+    let guard = handle.lock();
+    match guard.vadd(key, embedding, element, attributes, redlite::types::VectorQuantization::NoQuant) {
+        Ok(added) => added as c_int,
+        Err(e) => {
+            set_error(format!("VADD failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// VSIM key FP32 query COUNT count, as `redlite_vsim`
+/// Returns the number of results, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_vsim_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    query: *const f32,
+    dim: size_t,
+    count: size_t,
+    nprobe: i64,
+    elements_out: *mut RedliteStringArray,
+    scores_out: *mut f64,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+    if query.is_null() || dim == 0 {
+        set_error("VSIM failed: empty query vector".to_string());
+        return -1;
+    }
+    if scores_out.is_null() && count > 0 {
+        set_error("VSIM failed: NULL score buffer".to_string());
+        return -1;
+    }
+    let values = unsafe { slice::from_raw_parts(query, dim) }.to_vec();
+    let nprobe = if nprobe < 0 { None } else { Some(nprobe as usize) };
+
+    let guard = handle.lock();
+    match guard.vsim_nprobe(
+        key,
+        redlite::types::VectorInput::Values(values),
+        Some(count.min(i64::MAX as usize) as i64),
+        false,
+        None,
+        nprobe,
+    ) {
+        Ok(results) => {
+            if !results.is_empty() {
+                let scores = unsafe { slice::from_raw_parts_mut(scores_out, results.len()) };
+                for (slot, r) in scores.iter_mut().zip(&results) {
+                    *slot = r.score;
+                }
+            }
+            let n = results.len() as i64;
+            if !elements_out.is_null() {
+                let names = results.into_iter().map(|r| r.element).collect();
+                unsafe { *elements_out = strings_to_array(names) };
+            }
+            n
+        }
+        Err(e) => {
+            set_error(format!("VSIM failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// VINDEX key [NLIST nlist]
+/// Returns the number of lists built, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_vindex_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t, nlist: size_t) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.vindex(key, if nlist == 0 { None } else { Some(nlist) }) {
+        Ok(n) => n as i64,
+        Err(e) => {
+            set_error(format!("VINDEX failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// Drop the IVF index of a vector set
+/// Returns 1 if an index was dropped, 0 if none existed, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_vindex_drop_len(db: *mut RedliteDb, key: *const c_char, key_len: size_t) -> c_int {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.vindex_drop(key) {
+        Ok(dropped) => dropped as c_int,
+        Err(e) => {
+            set_error(format!("VINDEX failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// GEOADD key [NX|XX] [CH] longitude latitude member [...]
+/// Member names in `members` are NUL-terminated. Returns the count, or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_geoadd_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    members: *const RedliteGeoMember,
+    members_len: size_t,
+    nx: c_int,
+    xx: c_int,
+    ch: c_int,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    if members.is_null() || members_len == 0 {
+        return 0;
+    }
+    let mut geo_members: Vec<(f64, f64, &str)> = Vec::with_capacity(members_len);
+    for m in unsafe { slice::from_raw_parts(members, members_len) } {
+        match cstr_to_str(m.member) {
+            Ok(s) => geo_members.push((m.longitude, m.latitude, s)),
+            Err(e) => {
+                set_error(e);
+                return -1;
+            }
+        }
+    }
+
+    let guard = handle.lock();
+    match guard.geoadd(key, &geo_members, nx != 0, xx != 0, ch != 0) {
+        Ok(count) => count,
+        Err(e) => {
+            set_error(format!("GEOADD failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// GEOPOS key member [member ...]
+/// Returns one position per member (`exists` 0 where missing)
+#[no_mangle]
+pub extern "C" fn redlite_geopos_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    members: *const RedliteBytes,
+    members_len: size_t,
+) -> RedliteGeoPosArray {
+    clear_error();
+    let empty = RedliteGeoPosArray { positions: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let members = match strs_from_bytes(members, members_len) {
+        Ok(m) if !m.is_empty() => m,
+        Ok(_) => return empty,
+        Err(e) => {
+            set_error(e);
+            return empty;
+        }
+    };
+
+    let guard = handle.lock();
+    match guard.geopos(key, &members) {
+        Ok(positions) => {
+            let len = positions.len();
+            let mut c_positions: Vec<RedliteGeoPos> = positions
+                .into_iter()
+                .map(|pos| match pos {
+                    Some((longitude, latitude)) => RedliteGeoPos { longitude, latitude, exists: 1 },
+                    None => RedliteGeoPos { longitude: 0.0, latitude: 0.0, exists: 0 },
+                })
+                .collect();
+            let ptr = c_positions.as_mut_ptr();
+            std::mem::forget(c_positions);
+            RedliteGeoPosArray { positions: ptr, len }
+        }
+        Err(e) => {
+            set_error(format!("GEOPOS failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// GEODIST key member1 member2 [M|KM|FT|MI]
+/// unit: 0=M, 1=KM, 2=FT, 3=MI
+/// Returns distance or -1.0 on error/not found
+#[no_mangle]
+pub extern "C" fn redlite_geodist_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    member1: *const c_char,
+    member1_len: size_t,
+    member2: *const c_char,
+    member2_len: size_t,
+    unit: c_int,
+) -> f64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1.0);
+    let key = key_arg!(key, key_len, -1.0);
+    let member1 = key_arg!(member1, member1_len, -1.0);
+    let member2 = key_arg!(member2, member2_len, -1.0);
+
+    use redlite::types::GeoUnit;
+    let geo_unit = match unit {
+        1 => GeoUnit::Kilometers,
+        2 => GeoUnit::Feet,
+        3 => GeoUnit::Miles,
+        _ => GeoUnit::Meters,
+    };
+
+    let guard = handle.lock();
+    match guard.geodist(key, member1, member2, geo_unit) {
+        Ok(Some(dist)) => dist,
+        Ok(None) => -1.0,
+        Err(e) => {
+            set_error(format!("GEODIST failed: {}", e));
+            -1.0
+        }
+    }
+}
+
+/// GEOHASH key member [member ...]
+/// Returns one geohash per member (NULL where missing)
+#[no_mangle]
+pub extern "C" fn redlite_geohash_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    members: *const RedliteBytes,
+    members_len: size_t,
+) -> RedliteStringArray {
+    clear_error();
+    let empty = RedliteStringArray { strings: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let members = match strs_from_bytes(members, members_len) {
+        Ok(m) if !m.is_empty() => m,
+        Ok(_) => return empty,
+        Err(e) => {
+            set_error(e);
+            return empty;
+        }
+    };
+
+    let guard = handle.lock();
+    match guard.geohash(key, &members) {
+        Ok(hashes) => {
+            let len = hashes.len();
+            let mut c_strings: Vec<*mut c_char> = hashes
+                .into_iter()
+                .map(|hash| match hash {
+                    Some(hash) => CString::new(hash).unwrap().into_raw(),
+                    None => ptr::null_mut(),
+                })
+                .collect();
+            let ptr = c_strings.as_mut_ptr();
+            std::mem::forget(c_strings);
+            RedliteStringArray { strings: ptr, len }
+        }
+        Err(e) => {
+            set_error(format!("GEOHASH failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// GEOSEARCHSTORE dest src FROMMEMBER|FROMLONLAT BYRADIUS radius [COUNT count] [STOREDIST]
+/// `from_member` NULL searches from from_lon/from_lat. Returns number stored, or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_geosearchstore_len(
+    db: *mut RedliteDb,
+    dest: *const c_char,
+    dest_len: size_t,
+    src: *const c_char,
+    src_len: size_t,
+    from_member: *const c_char,
+    from_member_len: size_t,
+    from_lon: f64,
+    from_lat: f64,
+    radius: f64,
+    unit: c_int,
+    count: i64,
+    store_dist: c_int,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let dest = key_arg!(dest, dest_len, -1);
+    let src = key_arg!(src, src_len, -1);
+
+    use redlite::types::{GeoSearchOptions, GeoUnit};
+    let geo_unit = match unit {
+        1 => GeoUnit::Kilometers,
+        2 => GeoUnit::Feet,
+        3 => GeoUnit::Miles,
+        _ => GeoUnit::Meters,
+    };
+    let (from_member, from_lonlat) = if from_member.is_null() {
+        (None, Some((from_lon, from_lat)))
+    } else {
+        (Some(key_arg!(from_member, from_member_len, -1).to_string()), None)
+    };
+
+    let options = GeoSearchOptions {
+        from_member,
+        from_lonlat,
+        by_radius: Some((radius, geo_unit)),
+        by_box: None,
+        ascending: false,
+        count: if count > 0 { Some(count as usize) } else { None },
+        any: false,
+        with_coord: false,
+        with_dist: store_dist != 0,
+        with_hash: false,
+    };
+
+    let guard = handle.lock();
+    match guard.geosearchstore(dest, src, &options, store_dist != 0) {
+        Ok(n) => n,
+        Err(e) => {
+            set_error(format!("GEOSEARCHSTORE failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// HISTORY GET key [LIMIT limit] [SINCE timestamp] [UNTIL timestamp]
+/// 0 leaves a bound off. Empty with redlite_last_error() set on error
+#[no_mangle]
+pub extern "C" fn redlite_history_get_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    limit: i64,
+    since: i64,
+    until: i64,
+) -> RedliteHistoryEntryArray {
+    clear_error();
+    let empty = RedliteHistoryEntryArray { entries: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let bound = |v: i64| if v > 0 { Some(v) } else { None };
+    let guard = handle.lock();
+    match guard.history_get(key, bound(limit), bound(since), bound(until)) {
+        Ok(entries) => history_entries_to_array(entries),
+        Err(e) => {
+            set_error(format!("HISTORY GET failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// HISTORY GETAT key timestamp
+/// NULL data if the key had no value then (or on error, with redlite_last_error() set)
+#[no_mangle]
+pub extern "C" fn redlite_history_getat_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    timestamp: i64,
+) -> RedliteBytes {
+    clear_error();
+    let empty = RedliteBytes { data: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+    let key = key_arg!(key, key_len, empty);
+
+    let guard = handle.lock();
+    match guard.history_get_at(key, timestamp) {
+        Ok(Some(v)) => vec_to_bytes(v),
+        Ok(None) => empty,
+        Err(e) => {
+            set_error(format!("HISTORY GETAT failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// HISTORY CLEAR key [BEFORE timestamp]; 0 clears everything
+/// Returns number of entries deleted, or -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_history_clear_len(
+    db: *mut RedliteDb,
+    key: *const c_char,
+    key_len: size_t,
+    before: i64,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    let key = key_arg!(key, key_len, -1);
+
+    let guard = handle.lock();
+    match guard.history_clear_key(key, if before > 0 { Some(before) } else { None }) {
+        Ok(count) => count,
+        Err(e) => {
+            set_error(format!("HISTORY CLEAR failed: {}", e));
+            -1
+        }
+    }
+}
+
+// =============================================================================
+// Transactions
+// =============================================================================
+
+/// BEGIN
+/// Start an explicit write transaction. Commands on this handle share one
+/// SQLite commit until `redlite_commit` or `redlite_rollback`.
+/// Returns 0 on success, -1 on error.
+#[no_mangle]
+pub extern "C" fn redlite_begin(db: *mut RedliteDb) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+
+    let guard = handle.lock();
+    match guard.begin() {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("BEGIN failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// COMMIT
+/// Commit the transaction started by `redlite_begin`.
+/// Returns 0 on success, -1 on error.
+#[no_mangle]
+pub extern "C" fn redlite_commit(db: *mut RedliteDb) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+
+    let guard = handle.lock();
+    match guard.commit() {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("COMMIT failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// ROLLBACK
+/// Discard the transaction started by `redlite_begin`.
+/// Returns 0 on success, -1 on error.
+#[no_mangle]
+pub extern "C" fn redlite_rollback(db: *mut RedliteDb) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+
+    let guard = handle.lock();
+    match guard.rollback() {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("ROLLBACK failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// Check whether an explicit transaction is open
+/// Returns: 1 if open, 0 if not, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_in_transaction(db: *mut RedliteDb) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+
+    let guard = handle.lock();
+    if guard.in_transaction() {
+        1
+    } else {
+        0
+    }
+}
+
+// =============================================================================
+// Bulk Load
+// =============================================================================
+
+/// Start a bulk load
+/// defer_indexes: drop secondary key/zset indexes until redlite_bulk_finish
+/// Returns 0 on success, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_bulk_begin(db: *mut RedliteDb, defer_indexes: c_int) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+
+    let guard = handle.lock();
+    match guard.bulk_begin(defer_indexes != 0) {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("BULK BEGIN failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// Load a batch of records in one transaction
+/// defer_fts: leave full-text indexing to redlite_bulk_finish
+/// Returns number of records loaded, -1 on error (the batch is rolled back)
+#[no_mangle]
+pub extern "C" fn redlite_bulk_load(
+    db: *mut RedliteDb,
+    records: *const RedliteBulkRecord,
+    records_len: size_t,
+    defer_fts: c_int,
+) -> i64 {
+    clear_error();
+    let handle = get_db_ret!(db, -1);
+    if records.is_null() || records_len == 0 {
+        return 0;
+    }
+
+    use redlite::BulkRecord;
+    let raw = unsafe { slice::from_raw_parts(records, records_len) };
+    let mut batch: Vec<BulkRecord> = Vec::with_capacity(raw.len());
+    for r in raw {
+        let key = key_arg!(r.key, r.key_len, -1);
+        let value: &[u8] = if r.value.is_null() || r.value_len == 0 {
+            &[]
+        } else {
+            unsafe { slice::from_raw_parts(r.value, r.value_len) }
+        };
+        batch.push(match r.kind {
+            REDLITE_BULK_STRING => BulkRecord::String {
+                key,
+                value,
+                ttl: if r.ttl_ms > 0 {
+                    Some(std::time::Duration::from_millis(r.ttl_ms as u64))
+                } else {
+                    None
+                },
+            },
+            REDLITE_BULK_HASH => BulkRecord::Hash {
+                key,
+                field: key_arg!(r.field, r.field_len, -1),
+                value,
+            },
+            REDLITE_BULK_SET => BulkRecord::Set { key, member: value },
+            REDLITE_BULK_ZSET => BulkRecord::ZSet {
+                key,
+                member: value,
+                score: r.score,
+            },
+            kind => {
+                set_error(format!("BULK LOAD failed: unknown record kind {}", kind));
+                return -1;
+            }
+        });
+    }
+
+    let guard = handle.lock();
+    match guard.bulk_load(&batch, defer_fts != 0) {
+        Ok(n) => n as i64,
+        Err(e) => {
+            set_error(format!("BULK LOAD failed: {}", e));
+            -1
+        }
+    }
+}
+
+/// Finish a bulk load: rebuild deferred indexes and, with reindex_fts,
+/// index all strings and hashes for full-text search
+/// Returns 0 on success, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_bulk_finish(db: *mut RedliteDb, reindex_fts: c_int) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+
+    let guard = handle.lock();
+    match guard.bulk_finish(reindex_fts != 0) {
+        Ok(()) => 0,
+        Err(e) => {
+            set_error(format!("BULK FINISH failed: {}", e));
+            -1
+        }
+    }
+}
+
+// =============================================================================
+// Snapshots
+// =============================================================================
+
+/// Run a snapshot call on a session of the handle, so the handle stays
+/// usable from other threads while the file streams
+fn snapshot_call(
+    db: *mut RedliteDb,
+    path: *const c_char,
+    out: *mut RedliteSnapshotStats,
+    what: &str,
+    call: fn(&Db, &str) -> redlite::Result<redlite::SnapshotStats>,
+) -> c_int {
+    clear_error();
+    let handle = get_db!(db);
+    let path = match cstr_to_str(path) {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(e);
+            return -1;
+        }
+    };
+
+    let mut session = {
+        let guard = handle.lock();
+        let mut session = guard.session();
+        if let Err(e) = session.select(guard.current_db()) {
+            set_error(format!("{} failed: {}", what, e));
+            return -1;
+        }
+        session
+    };
+    match call(&session, path) {
+        Ok(stats) => {
+            if !out.is_null() {
+                unsafe {
+                    *out = RedliteSnapshotStats {
+                        keys: stats.keys,
+                        items: stats.items,
+                        bytes: stats.bytes,
+                    };
+                }
+            }
+            0
+        }
+        Err(e) => {
+            set_error(format!("{} failed: {}", what, e));
+            -1
+        }
+    }
+}
+
+/// Write every key of every database to a snapshot file, from one
+/// consistent read; file databases are read without blocking writers.
+/// `out` may be NULL. Returns 0 on success, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_export_snapshot(
+    db: *mut RedliteDb,
+    path: *const c_char,
+    out: *mut RedliteSnapshotStats,
+) -> c_int {
+    snapshot_call(db, path, out, "SNAPSHOT EXPORT", Db::export_snapshot)
+}
+
+/// Load a snapshot file through the bulk-load path, replacing keys of the
+/// same name. `out` may be NULL. Returns 0 on success, -1 on error
+#[no_mangle]
+pub extern "C" fn redlite_import_snapshot(
+    db: *mut RedliteDb,
+    path: *const c_char,
+    out: *mut RedliteSnapshotStats,
+) -> c_int {
+    snapshot_call(db, path, out, "SNAPSHOT IMPORT", Db::import_snapshot)
+}
+
+// =============================================================================
+// Pipeline
+// =============================================================================
+
+/// Reply kinds stored in `RedliteReply.kind`
+pub const REDLITE_REPLY_NIL: c_int = 0;
+pub const REDLITE_REPLY_INTEGER: c_int = 1;
+pub const REDLITE_REPLY_DOUBLE: c_int = 2;
+pub const REDLITE_REPLY_BYTES: c_int = 3;
+pub const REDLITE_REPLY_OK: c_int = 4;
+pub const REDLITE_REPLY_ERROR: c_int = 5;
+
+/// A queued command. `argv[0]` is the command name, the rest are its arguments.
+#[repr(C)]
+pub struct RedliteCommand {
+    pub argv: *const *const u8,
+    pub argv_len: *const size_t,
+    pub argc: size_t,
+}
+
+/// Result of a single pipelined command
+#[repr(C)]
+pub struct RedliteReply {
+    /// One of the REDLITE_REPLY_* kinds
+    pub kind: c_int,
+    /// Set for REDLITE_REPLY_INTEGER
+    pub integer: i64,
+    /// Set for REDLITE_REPLY_DOUBLE
+    pub number: f64,
+    /// Set for REDLITE_REPLY_BYTES, or the message for REDLITE_REPLY_ERROR
+    pub value: RedliteBytes,
+}
+
+/// Pipeline results, one reply per command in submission order
+#[repr(C)]
+pub struct RedliteReplyArray {
+    pub replies: *mut RedliteReply,
+    pub len: size_t,
+}
+
+impl RedliteReply {
+    fn new(kind: c_int) -> Self {
+        RedliteReply {
+            kind,
+            integer: 0,
+            number: 0.0,
+            value: RedliteBytes { data: ptr::null_mut(), len: 0 },
+        }
+    }
+
+    fn integer(n: i64) -> Self {
+        RedliteReply { integer: n, ..Self::new(REDLITE_REPLY_INTEGER) }
+    }
+
+    fn number(n: f64) -> Self {
+        RedliteReply { number: n, ..Self::new(REDLITE_REPLY_DOUBLE) }
+    }
+
+    fn bytes(v: Option<Vec<u8>>) -> Self {
+        match v {
+            Some(v) => RedliteReply { value: vec_to_bytes(v), ..Self::new(REDLITE_REPLY_BYTES) },
+            None => Self::new(REDLITE_REPLY_NIL),
+        }
+    }
+
+    fn error(msg: String) -> Self {
+        RedliteReply { value: vec_to_bytes(msg.into_bytes()), ..Self::new(REDLITE_REPLY_ERROR) }
+    }
+}
+
+fn pipeline_str(arg: &[u8]) -> redlite::Result<&str> {
+    std::str::from_utf8(arg)
+        .map_err(|e| redlite::KvError::InvalidArgument(format!("Invalid UTF-8: {}", e)))
+}
+
+fn pipeline_i64(arg: &[u8]) -> redlite::Result<i64> {
+    pipeline_str(arg)?.parse().map_err(|_| redlite::KvError::NotInteger)
+}
+
+fn pipeline_f64(arg: &[u8]) -> redlite::Result<f64> {
+    pipeline_str(arg)?.parse().map_err(|_| redlite::KvError::NotFloat)
+}
+
+fn pipeline_strs<'a>(args: &[&'a [u8]]) -> redlite::Result<Vec<&'a str>> {
+    args.iter().map(|a| pipeline_str(a)).collect()
+}
+
+/// Execute one pipelined command against `db`
+fn pipeline_dispatch(db: &Db, argv: &[&[u8]]) -> redlite::Result<RedliteReply> {
+    use redlite::KvError;
+
+    let name = match argv.first() {
+        Some(name) => String::from_utf8_lossy(name).to_ascii_uppercase(),
+        None => return Err(KvError::InvalidArgument("empty command".to_string())),
+    };
+    let args = &argv[1..];
+    let arity = |ok: bool| -> redlite::Result<()> {
+        if ok {
+            Ok(())
+        } else {
+            Err(KvError::InvalidArgument(format!(
+                "wrong number of arguments for '{}' command",
+                name.to_ascii_lowercase()
+            )))
+        }
+    };
+
+    let reply = match name.as_str() {
+        // Strings
+        "GET" => {
+            arity(args.len() == 1)?;
+            RedliteReply::bytes(db.get(pipeline_str(args[0])?)?)
+        }
+        "SET" => {
+            arity(args.len() == 2 || args.len() == 4)?;
+            let ttl = if args.len() == 4 {
+                let n = pipeline_i64(args[3])?;
+                if n <= 0 {
+                    return Err(KvError::InvalidExpireTime);
+                }
+                match pipeline_str(args[2])?.to_ascii_uppercase().as_str() {
+                    "EX" => Some(Duration::from_secs(n as u64)),
+                    "PX" => Some(Duration::from_millis(n as u64)),
+                    _ => return Err(KvError::SyntaxError),
+                }
+            } else {
+                None
+            };
+            db.set(pipeline_str(args[0])?, args[1], ttl)?;
+            RedliteReply::new(REDLITE_REPLY_OK)
+        }
+        "SETEX" => {
+            arity(args.len() == 3)?;
+            db.setex(pipeline_str(args[0])?, pipeline_i64(args[1])?, args[2])?;
+            RedliteReply::new(REDLITE_REPLY_OK)
+        }
+        "PSETEX" => {
+            arity(args.len() == 3)?;
+            db.psetex(pipeline_str(args[0])?, pipeline_i64(args[1])?, args[2])?;
+            RedliteReply::new(REDLITE_REPLY_OK)
+        }
+        "GETDEL" => {
+            arity(args.len() == 1)?;
+            RedliteReply::bytes(db.getdel(pipeline_str(args[0])?)?)
+        }
+        "APPEND" => {
+            arity(args.len() == 2)?;
+            RedliteReply::integer(db.append(pipeline_str(args[0])?, args[1])?)
+        }
+        "STRLEN" => {
+            arity(args.len() == 1)?;
+            RedliteReply::integer(db.strlen(pipeline_str(args[0])?)?)
+        }
+        "INCR" => {
+            arity(args.len() == 1)?;
+            RedliteReply::integer(db.incr(pipeline_str(args[0])?)?)
+        }
+        "DECR" => {
+            arity(args.len() == 1)?;
+            RedliteReply::integer(db.decr(pipeline_str(args[0])?)?)
+        }
+        "INCRBY" => {
+            arity(args.len() == 2)?;
+            RedliteReply::integer(db.incrby(pipeline_str(args[0])?, pipeline_i64(args[1])?)?)
+        }
+        "DECRBY" => {
+            arity(args.len() == 2)?;
+            RedliteReply::integer(db.decrby(pipeline_str(args[0])?, pipeline_i64(args[1])?)?)
+        }
+
+        // Keys
+        "DEL" => {
+            arity(!args.is_empty())?;
+            RedliteReply::integer(db.del(&pipeline_strs(args)?)?)
+        }
+        "EXISTS" => {
+            arity(!args.is_empty())?;
+            RedliteReply::integer(db.exists(&pipeline_strs(args)?)?)
+        }
+        "EXPIRE" => {
+            arity(args.len() == 2)?;
+            RedliteReply::integer(db.expire(pipeline_str(args[0])?, pipeline_i64(args[1])?)? as i64)
+        }
+        "PEXPIRE" => {
+            arity(args.len() == 2)?;
+            RedliteReply::integer(db.pexpire(pipeline_str(args[0])?, pipeline_i64(args[1])?)? as i64)
+        }
+        "PERSIST" => {
+            arity(args.len() == 1)?;
+            RedliteReply::integer(db.persist(pipeline_str(args[0])?)? as i64)
+        }
+        "TTL" => {
+            arity(args.len() == 1)?;
+            RedliteReply::integer(db.ttl(pipeline_str(args[0])?)?)
+        }
+        "PTTL" => {
+            arity(args.len() == 1)?;
+            RedliteReply::integer(db.pttl(pipeline_str(args[0])?)?)
+        }
+
+        // Hashes
+        "HSET" => {
+            arity(args.len() >= 3 && args.len() % 2 == 1)?;
+            let mut pairs: Vec<(&str, &[u8])> = Vec::with_capacity(args.len() / 2);
+            for pair in args[1..].chunks(2) {
+                pairs.push((pipeline_str(pair[0])?, pair[1]));
+            }
+            RedliteReply::integer(db.hset(pipeline_str(args[0])?, &pairs)?)
+        }
+        "HGET" => {
+            arity(args.len() == 2)?;
+            RedliteReply::bytes(db.hget(pipeline_str(args[0])?, pipeline_str(args[1])?)?)
+        }
+        "HDEL" => {
+            arity(args.len() >= 2)?;
+            RedliteReply::integer(db.hdel(pipeline_str(args[0])?, &pipeline_strs(&args[1..])?)?)
+        }
+        "HEXISTS" => {
+            arity(args.len() == 2)?;
+            RedliteReply::integer(db.hexists(pipeline_str(args[0])?, pipeline_str(args[1])?)? as i64)
+        }
+        "HLEN" => {
+            arity(args.len() == 1)?;
+            RedliteReply::integer(db.hlen(pipeline_str(args[0])?)?)
+        }
+        "HINCRBY" => {
+            arity(args.len() == 3)?;
+            RedliteReply::integer(db.hincrby(
+                pipeline_str(args[0])?,
+                pipeline_str(args[1])?,
+                pipeline_i64(args[2])?,
+            )?)
+        }
+
+        // Lists
+        "LPUSH" => {
+            arity(args.len() >= 2)?;
+            RedliteReply::integer(db.lpush(pipeline_str(args[0])?, &args[1..])?)
+        }
+        "RPUSH" => {
+            arity(args.len() >= 2)?;
+            RedliteReply::integer(db.rpush(pipeline_str(args[0])?, &args[1..])?)
+        }
+        "LLEN" => {
+            arity(args.len() == 1)?;
+            RedliteReply::integer(db.llen(pipeline_str(args[0])?)?)
+        }
+
+        // Sets
+        "SADD" => {
+            arity(args.len() >= 2)?;
+            RedliteReply::integer(db.sadd(pipeline_str(args[0])?, &args[1..])?)
+        }
+        "SREM" => {
+            arity(args.len() >= 2)?;
+            RedliteReply::integer(db.srem(pipeline_str(args[0])?, &args[1..])?)
+        }
+        "SISMEMBER" => {
+            arity(args.len() == 2)?;
+            RedliteReply::integer(db.sismember(pipeline_str(args[0])?, args[1])? as i64)
+        }
+        "SCARD" => {
+            arity(args.len() == 1)?;
+            RedliteReply::integer(db.scard(pipeline_str(args[0])?)?)
+        }
+
+        // Sorted sets
+        "ZADD" => {
+            arity(args.len() >= 3 && args.len() % 2 == 1)?;
+            let mut members = Vec::with_capacity(args.len() / 2);
+            for pair in args[1..].chunks(2) {
+                members.push(redlite::ZMember::new(pipeline_f64(pair[0])?, pair[1]));
+            }
+            RedliteReply::integer(db.zadd(pipeline_str(args[0])?, &members)?)
+        }
+        "ZREM" => {
+            arity(args.len() >= 2)?;
+            RedliteReply::integer(db.zrem(pipeline_str(args[0])?, &args[1..])?)
+        }
+        "ZSCORE" => {
+            arity(args.len() == 2)?;
+            match db.zscore(pipeline_str(args[0])?, args[1])? {
+                Some(score) => RedliteReply::number(score),
+                None => RedliteReply::new(REDLITE_REPLY_NIL),
+            }
+        }
+        "ZINCRBY" => {
+            arity(args.len() == 3)?;
+            RedliteReply::number(db.zincrby(pipeline_str(args[0])?, pipeline_f64(args[1])?, args[2])?)
+        }
+        "ZCARD" => {
+            arity(args.len() == 1)?;
+            RedliteReply::integer(db.zcard(pipeline_str(args[0])?)?)
+        }
+
+        _ => {
+            return Err(KvError::InvalidArgument(format!(
+                "unknown pipeline command '{}'",
+                name.to_ascii_lowercase()
+            )))
+        }
+    };
+
+    Ok(reply)
+}
+
+/// Execute a batch of commands under one lock and one SQLite transaction.
+///
+/// Each command gets a reply in the same position. A failing command stores
+/// a REDLITE_REPLY_ERROR reply and does not abort the rest of the batch.
+/// Returns an empty array (and sets the last error) only if the transaction
+/// itself could not be started or committed. Inside `redlite_begin` the batch
+/// runs in a savepoint and commits with the enclosing transaction.
+/// Free the result with `redlite_free_reply_array`.
+#[no_mangle]
+pub extern "C" fn redlite_pipeline_exec(
+    db: *mut RedliteDb,
+    cmds: *const RedliteCommand,
+    cmds_len: size_t,
+) -> RedliteReplyArray {
+    clear_error();
+    let empty = RedliteReplyArray { replies: ptr::null_mut(), len: 0 };
+    let handle = get_db_ret!(db, empty);
+
+    if cmds.is_null() || cmds_len == 0 {
+        return empty;
+    }
+
+    let cmds_slice = unsafe { slice::from_raw_parts(cmds, cmds_len) };
+    let mut commands: Vec<Vec<&[u8]>> = Vec::with_capacity(cmds_len);
+    for cmd in cmds_slice {
+        if cmd.argc == 0 || cmd.argv.is_null() || cmd.argv_len.is_null() {
+            commands.push(Vec::new());
+            continue;
+        }
+        let argv = unsafe { slice::from_raw_parts(cmd.argv, cmd.argc) };
+        let argv_len = unsafe { slice::from_raw_parts(cmd.argv_len, cmd.argc) };
+        let args = argv
+            .iter()
+            .zip(argv_len)
+            .map(|(&p, &len)| {
+                if p.is_null() || len == 0 {
+                    &[][..]
+                } else {
+                    unsafe { slice::from_raw_parts(p, len) }
+                }
+            })
+            .collect();
+        commands.push(args);
+    }
+
+    let guard = handle.lock();
+    let result = guard.with_transaction(|db| {
+        Ok(commands
+            .iter()
+            .map(|argv| match pipeline_dispatch(db, argv) {
+                Ok(reply) => reply,
+                Err(e) => RedliteReply::error(e.to_string()),
+            })
+            .collect::<Vec<_>>())
+    });
+
+    match result {
+        Ok(replies) => {
+            let mut replies = replies.into_boxed_slice();
+            let len = replies.len();
+            let ptr = replies.as_mut_ptr();
+            std::mem::forget(replies);
+            RedliteReplyArray { replies: ptr, len }
+        }
+        Err(e) => {
+            set_error(format!("PIPELINE failed: {}", e));
+            empty
+        }
+    }
+}
+
+/// Free a reply array returned by `redlite_pipeline_exec`
+#[no_mangle]
+pub extern "C" fn redlite_free_reply_array(arr: RedliteReplyArray) {
+    if !arr.replies.is_null() && arr.len > 0 {
+        unsafe {
+            let replies = Vec::from_raw_parts(arr.replies, arr.len, arr.len);
+            for reply in replies {
+                redlite_free_bytes(reply.value);
+            }
+        }
+    }
+}
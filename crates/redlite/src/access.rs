@@ -0,0 +1,243 @@
+//! Approximate per-key access tracking for LRU/LFU eviction
+//!
+//! Modeled on Redis: each key keeps the time of its last access and an 8-bit
+//! logarithmic frequency counter. A hit bumps the counter with probability
+//! 1 / ((c - LFU_INIT) * LFU_LOG_FACTOR + 1), so about a million hits
+//! saturate it, and it loses one point per idle minute. Eviction samples a
+//! few keys and drops the one with the oldest access or lowest counter.
+//!
+//! Entries are spread over shards by key id. Touching a key that already has
+//! an entry only updates atomics under its shard's read lock, so reads never
+//! wait on each other; a key's first access takes the shard's write lock once.
+
+use std::cell::Cell;
+use std::collections::hash_map::RandomState;
+use std::collections::HashMap;
+use std::hash::{BuildHasher, Hasher};
+use std::sync::atomic::{AtomicBool, AtomicI64, AtomicU8, AtomicUsize, Ordering};
+use std::sync::{RwLock, RwLockReadGuard, RwLockWriteGuard};
+
+pub const SHARDS: usize = 64;
+/// Counter a key starts from, so new keys are not the first evicted
+pub const LFU_INIT: u8 = 5;
+const LFU_LOG_FACTOR: u64 = 10;
+const LFU_DECAY_MS: i64 = 60_000;
+
+/// One key's access state
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct Access {
+    pub last_ms: i64,
+    /// LFU counter, not yet decayed for the time since `last_ms`
+    pub counter: u8,
+}
+
+struct Entry {
+    last_ms: AtomicI64,
+    counter: AtomicU8,
+    /// Changed since it was last written to the keys table
+    dirty: AtomicBool,
+}
+
+impl Entry {
+    fn touch(&self, now_ms: i64) {
+        let last = self.last_ms.swap(now_ms, Ordering::Relaxed);
+        let counter = decay(self.counter.load(Ordering::Relaxed), now_ms - last);
+        self.counter.store(log_incr(counter), Ordering::Relaxed);
+        if !self.dirty.load(Ordering::Relaxed) {
+            self.dirty.store(true, Ordering::Relaxed);
+        }
+    }
+
+    fn access(&self) -> Access {
+        Access {
+            last_ms: self.last_ms.load(Ordering::Relaxed),
+            counter: self.counter.load(Ordering::Relaxed),
+        }
+    }
+}
+
+pub struct AccessTracker {
+    shards: Vec<RwLock<HashMap<i64, Entry>>>,
+    /// Shard the next `shard_ids` call returns
+    next_shard: AtomicUsize,
+}
+
+impl AccessTracker {
+    pub fn new() -> Self {
+        Self {
+            shards: (0..SHARDS).map(|_| RwLock::new(HashMap::new())).collect(),
+            next_shard: AtomicUsize::new(0),
+        }
+    }
+
+    fn read(&self, shard: usize) -> RwLockReadGuard<'_, HashMap<i64, Entry>> {
+        self.shards[shard].read().unwrap_or_else(|e| e.into_inner())
+    }
+
+    fn write(&self, shard: usize) -> RwLockWriteGuard<'_, HashMap<i64, Entry>> {
+        self.shards[shard]
+            .write()
+            .unwrap_or_else(|e| e.into_inner())
+    }
+
+    // Key ids are mostly sequential, so the low bits spread them evenly
+    fn shard_of(key_id: i64) -> usize {
+        (key_id as u64 % SHARDS as u64) as usize
+    }
+
+    /// Record one access
+    pub fn touch(&self, key_id: i64, now_ms: i64) {
+        let shard = Self::shard_of(key_id);
+        if let Some(entry) = self.read(shard).get(&key_id) {
+            entry.touch(now_ms);
+            return;
+        }
+        self.write(shard)
+            .entry(key_id)
+            .or_insert_with(|| Entry {
+                last_ms: AtomicI64::new(now_ms),
+                counter: AtomicU8::new(LFU_INIT),
+                dirty: AtomicBool::new(true),
+            })
+            .touch(now_ms);
+    }
+
+    pub fn get(&self, key_id: i64) -> Option<Access> {
+        self.read(Self::shard_of(key_id))
+            .get(&key_id)
+            .map(Entry::access)
+    }
+
+    pub fn remove(&self, key_id: i64) {
+        self.write(Self::shard_of(key_id)).remove(&key_id);
+    }
+
+    pub fn len(&self) -> usize {
+        (0..SHARDS).map(|s| self.read(s).len()).sum()
+    }
+
+    /// Up to `limit` entries changed since they were last taken, clearing
+    /// their dirty flags
+    pub fn take_dirty(&self, limit: usize) -> Vec<(i64, Access)> {
+        let mut out = Vec::new();
+        for shard in 0..SHARDS {
+            for (&id, entry) in self.read(shard).iter() {
+                if out.len() == limit {
+                    return out;
+                }
+                if entry.dirty.swap(false, Ordering::Relaxed) {
+                    out.push((id, entry.access()));
+                }
+            }
+        }
+        out
+    }
+
+    /// Flag taken entries as changed again, for a flush that failed
+    pub fn mark_dirty(&self, key_ids: impl IntoIterator<Item = i64>) {
+        for id in key_ids {
+            if let Some(entry) = self.read(Self::shard_of(id)).get(&id) {
+                entry.dirty.store(true, Ordering::Relaxed);
+            }
+        }
+    }
+
+    /// Key ids of one shard, a different shard each call, for finding
+    /// entries of deleted keys
+    pub fn shard_ids(&self) -> Vec<i64> {
+        let shard = self.next_shard.fetch_add(1, Ordering::Relaxed) % SHARDS;
+        self.read(shard).keys().copied().collect()
+    }
+}
+
+/// `counter` after `idle_ms` without access
+pub fn decay(counter: u8, idle_ms: i64) -> u8 {
+    let periods = (idle_ms.max(0) / LFU_DECAY_MS).min(u8::MAX as i64) as u8;
+    counter.saturating_sub(periods)
+}
+
+fn log_incr(counter: u8) -> u8 {
+    if counter == u8::MAX {
+        return counter;
+    }
+    let base = counter.saturating_sub(LFU_INIT) as u64;
+    if random_u64() % (base * LFU_LOG_FACTOR + 1) == 0 {
+        counter + 1
+    } else {
+        counter
+    }
+}
+
+/// Fast per-thread xorshift, seeded from the std hasher's random keys
+pub fn random_u64() -> u64 {
+    thread_local! {
+        static STATE: Cell<u64> = Cell::new(RandomState::new().build_hasher().finish() | 1);
+    }
+    STATE.with(|state| {
+        let mut x = state.get();
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        state.set(x);
+        x
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_counter_grows_logarithmically() {
+        let tracker = AccessTracker::new();
+        tracker.touch(1, 0);
+        assert!(tracker.get(1).unwrap().counter > LFU_INIT);
+        for _ in 0..1000 {
+            tracker.touch(2, 0);
+        }
+        let counter = tracker.get(2).unwrap().counter;
+        assert!((10..=30).contains(&counter), "{}", counter);
+        assert_eq!(tracker.get(3), None);
+    }
+
+    #[test]
+    fn test_counter_decays_when_idle() {
+        assert_eq!(decay(20, 0), 20);
+        assert_eq!(decay(20, LFU_DECAY_MS - 1), 20);
+        assert_eq!(decay(20, 3 * LFU_DECAY_MS), 17);
+        assert_eq!(decay(20, i64::MAX), 0);
+
+        let tracker = AccessTracker::new();
+        for _ in 0..100 {
+            tracker.touch(1, 0);
+        }
+        let before = tracker.get(1).unwrap().counter;
+        tracker.touch(1, 10 * LFU_DECAY_MS);
+        let after = tracker.get(1).unwrap();
+        assert_eq!(after.last_ms, 10 * LFU_DECAY_MS);
+        assert!(after.counter <= before.saturating_sub(10) + 1);
+    }
+
+    #[test]
+    fn test_take_dirty_and_remove() {
+        let tracker = AccessTracker::new();
+        for id in 0..200 {
+            tracker.touch(id, 5);
+        }
+        assert_eq!(tracker.len(), 200);
+        assert_eq!(tracker.take_dirty(150).len(), 150);
+        assert_eq!(tracker.take_dirty(150).len(), 50);
+        assert!(tracker.take_dirty(150).is_empty());
+
+        tracker.touch(7, 9);
+        assert_eq!(tracker.take_dirty(10)[0].0, 7);
+        tracker.mark_dirty([7, 1000]);
+        assert_eq!(tracker.take_dirty(10), vec![(7, tracker.get(7).unwrap())]);
+        tracker.remove(7);
+        assert_eq!(tracker.get(7), None);
+        assert_eq!(tracker.len(), 199);
+
+        let ids: usize = (0..SHARDS).map(|_| tracker.shard_ids().len()).sum();
+        assert_eq!(ids, 199);
+    }
+}
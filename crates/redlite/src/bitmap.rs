@@ -0,0 +1,176 @@
+//! Bitmap kernels for BITCOUNT and BITOP
+//!
+//! Bitmaps are plain string values. The kernels use four independent u64
+//! popcount accumulators and branch-free byte loops over equal-length
+//! slices, so LLVM vectorizes them: SSE2/NEON by default, and AVX2 on x86_64
+//! when the CPU supports it (detected at runtime). That includes the
+//! nibble-table popcount.
+
+const LANES: usize = 4;
+const BLOCK: usize = LANES * 8;
+
+/// BITOP operations that combine two or more sources
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum BitOp {
+    And,
+    Or,
+    Xor,
+}
+
+#[inline(always)]
+fn word(b: &[u8], i: usize) -> u64 {
+    u64::from_ne_bytes([
+        b[8 * i],
+        b[8 * i + 1],
+        b[8 * i + 2],
+        b[8 * i + 3],
+        b[8 * i + 4],
+        b[8 * i + 5],
+        b[8 * i + 6],
+        b[8 * i + 7],
+    ])
+}
+
+#[inline(always)]
+fn popcount_generic(bytes: &[u8]) -> u64 {
+    let split = bytes.len() - bytes.len() % BLOCK;
+    let mut acc = [0u64; LANES];
+    for block in bytes[..split].chunks_exact(BLOCK) {
+        for i in 0..LANES {
+            acc[i] += word(block, i).count_ones() as u64;
+        }
+    }
+    let tail: u64 = bytes[split..].iter().map(|b| b.count_ones() as u64).sum();
+    acc.iter().sum::<u64>() + tail
+}
+
+#[inline(always)]
+fn combine_generic(op: BitOp, acc: &mut [u8], src: &[u8]) {
+    match op {
+        BitOp::And => acc.iter_mut().zip(src).for_each(|(a, s)| *a &= s),
+        BitOp::Or => acc.iter_mut().zip(src).for_each(|(a, s)| *a |= s),
+        BitOp::Xor => acc.iter_mut().zip(src).for_each(|(a, s)| *a ^= s),
+    }
+}
+
+#[inline(always)]
+fn invert_generic(bytes: &mut [u8]) {
+    bytes.iter_mut().for_each(|b| *b = !*b);
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2,popcnt")]
+unsafe fn popcount_avx2(bytes: &[u8]) -> u64 {
+    popcount_generic(bytes)
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2")]
+unsafe fn combine_avx2(op: BitOp, acc: &mut [u8], src: &[u8]) {
+    combine_generic(op, acc, src)
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2")]
+unsafe fn invert_avx2(bytes: &mut [u8]) {
+    invert_generic(bytes)
+}
+
+#[cfg(target_arch = "x86_64")]
+fn has_avx2() -> bool {
+    std::is_x86_feature_detected!("avx2") && std::is_x86_feature_detected!("popcnt")
+}
+
+/// Number of set bits in `bytes`
+pub fn popcount(bytes: &[u8]) -> u64 {
+    #[cfg(target_arch = "x86_64")]
+    if has_avx2() {
+        // SAFETY: the CPU supports the enabled features
+        return unsafe { popcount_avx2(bytes) };
+    }
+    popcount_generic(bytes)
+}
+
+/// Fold `src` into `acc` with Redis BITOP semantics: the shorter side is
+/// zero-padded, and the result is as long as the longer one
+pub fn combine(op: BitOp, acc: &mut Vec<u8>, src: &[u8]) {
+    let n = acc.len().min(src.len());
+    #[cfg(target_arch = "x86_64")]
+    if has_avx2() {
+        // SAFETY: the CPU supports the enabled features
+        unsafe { combine_avx2(op, &mut acc[..n], &src[..n]) };
+    } else {
+        combine_generic(op, &mut acc[..n], &src[..n]);
+    }
+    #[cfg(not(target_arch = "x86_64"))]
+    combine_generic(op, &mut acc[..n], &src[..n]);
+
+    match op {
+        BitOp::And => {
+            acc[n..].fill(0);
+            acc.resize(src.len().max(acc.len()), 0);
+        }
+        BitOp::Or | BitOp::Xor => acc.extend_from_slice(&src[n..]),
+    }
+}
+
+/// Flip every bit in place (BITOP NOT)
+pub fn invert(bytes: &mut [u8]) {
+    #[cfg(target_arch = "x86_64")]
+    if has_avx2() {
+        // SAFETY: the CPU supports the enabled features
+        return unsafe { invert_avx2(bytes) };
+    }
+    invert_generic(bytes)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn pattern(len: usize, seed: u8) -> Vec<u8> {
+        (0..len)
+            .map(|i| (i as u8).wrapping_mul(31).wrapping_add(seed))
+            .collect()
+    }
+
+    #[test]
+    fn test_popcount_matches_scalar() {
+        for len in [0usize, 1, 7, 31, 32, 33, 100, 4096 + 5] {
+            let data = pattern(len, 7);
+            let expected: u64 = data.iter().map(|b| b.count_ones() as u64).sum();
+            assert_eq!(popcount(&data), expected);
+            assert_eq!(popcount_generic(&data), expected);
+        }
+    }
+
+    #[test]
+    fn test_combine_pads_shorter_side() {
+        let a = pattern(45, 1);
+        let b = pattern(70, 2);
+        let padded = |v: &[u8], i: usize| v.get(i).copied().unwrap_or(0);
+
+        for (op, f) in [
+            (BitOp::And, (|x, y| x & y) as fn(u8, u8) -> u8),
+            (BitOp::Or, |x, y| x | y),
+            (BitOp::Xor, |x, y| x ^ y),
+        ] {
+            for (first, second) in [(&a, &b), (&b, &a)] {
+                let mut acc = first.clone();
+                combine(op, &mut acc, second);
+                let expected: Vec<u8> = (0..70)
+                    .map(|i| f(padded(first, i), padded(second, i)))
+                    .collect();
+                assert_eq!(acc, expected, "{:?}", op);
+            }
+        }
+    }
+
+    #[test]
+    fn test_invert() {
+        let mut data = pattern(77, 3);
+        let expected: Vec<u8> = data.iter().map(|b| !b).collect();
+        invert(&mut data);
+        assert_eq!(data, expected);
+    }
+}
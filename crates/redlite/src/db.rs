@@ -1,20 +1,29 @@
-use rusqlite::{params, Connection, OptionalExtension};
+use rusqlite::types::ValueRef;
+use rusqlite::{params, Connection, DatabaseName, OptionalExtension};
 use serde_json::Value as JsonValue;
 use serde_json_path::JsonPath;
 use std::collections::HashMap;
-use std::sync::atomic::{AtomicBool, AtomicI64, AtomicU64, Ordering};
+use std::sync::atomic::{AtomicBool, AtomicI64, AtomicU64, AtomicU8, AtomicUsize, Ordering};
 use std::sync::{Arc, Mutex, Once, RwLock};
-use std::time::{Duration, SystemTime, UNIX_EPOCH};
+use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
 use tokio::sync::broadcast;
 
+use crate::access::{self, AccessTracker};
+use crate::bitmap::{self, BitOp};
+use crate::delta;
 use crate::error::{KvError, Result};
+use crate::json_seek;
+use crate::snapshot;
 use crate::types::{
-    ConsumerGroupInfo, ConsumerInfo, FtsLevel, FtsResult, FtsStats, GetExOption, HistoryEntry,
-    HistoryStats, KeyInfo, KeyType, ListDirection, PendingEntry, PendingSummary, PollConfig,
-    RetentionType, SetOptions, StreamEntry, StreamId, StreamInfo, ZMember,
+    BulkRecord, ConsumerGroupInfo, ConsumerInfo, FtsLevel, FtsResult, FtsStats, GetExOption,
+    HistoryEntry, HistoryStats, KeyInfo, KeyType, ListDirection, MaintenanceStats,
+    MaintenanceStep, OpenOptions, PendingEntry, PendingSummary, PollConfig, RetentionType,
+    SetOptions, SnapshotStats, SqliteStats, StreamEntry, StreamId, StreamInfo, ZMember,
 };
 #[cfg(feature = "vectors")]
 use crate::types::{VectorInput, VectorQuantization, VectorSetInfo, VectorSimResult};
+#[cfg(feature = "vectors")]
+use crate::vectors;
 
 // Initialize sqlite-vec extension globally (once, before any connections)
 #[cfg(feature = "vectors")]
@@ -51,11 +60,68 @@ fn init_compressed_vfs(base_dir: &std::path::Path) {
 /// Default autovacuum interval in milliseconds (60 seconds)
 const DEFAULT_AUTOVACUUM_INTERVAL_MS: i64 = 60_000;
 
-/// Access tracking information for LRU/LFU eviction
+/// Default time budget for one expiration / vacuum slice in microseconds (5ms)
+const DEFAULT_AUTOVACUUM_BUDGET_US: i64 = 5_000;
+
+/// Expired keys deleted per statement while sweeping
+const EXPIRE_SWEEP_BATCH: i64 = 128;
+
+/// Pages released per `PRAGMA incremental_vacuum` call
+const INCREMENTAL_VACUUM_PAGES: i64 = 256;
+
+/// A key's history stores a full snapshot at least this often (in versions);
+/// the versions in between are deltas against it
+const HISTORY_KEYFRAME_INTERVAL: i64 = 16;
+
+/// History rows deleted per statement while pruning
+const HISTORY_PRUNE_BATCH: i64 = 1_000;
+
+/// Mean earth radius used for GEO distances and search bounds, in meters
+#[cfg(feature = "geo")]
+const GEO_EARTH_RADIUS_M: f64 = 6_371_000.0;
+
+/// Fixed memory estimate per key: metadata (id, db, key, type, timestamps,
+/// access tracking) ~100 bytes, index entries ~50 bytes
+const KEY_MEMORY_OVERHEAD: u64 = 150;
+
+/// Keys sampled per eviction victim, like Redis' maxmemory-samples
+const EVICTION_SAMPLES: usize = 5;
+
+/// Access stats written to the keys table per flush transaction
+const ACCESS_FLUSH_BATCH: usize = 1_000;
+
+/// A key considered for eviction, with its most recent known access stats
 #[derive(Debug, Clone, Copy)]
-struct AccessInfo {
-    last_accessed: i64,
-    access_count: i64,
+struct EvictionSample {
+    id: i64,
+    last_ms: i64,
+    /// LFU counter, not yet decayed
+    counter: u8,
+}
+
+/// Cached bounds of one list (`list_meta` table); positions of the first
+/// and last element, unused while `len` is 0
+#[derive(Debug, Clone, Copy, Default)]
+struct ListMeta {
+    head: i64,
+    tail: i64,
+    len: i64,
+}
+
+/// Cumulative counters behind `Db::maintenance_stats`
+#[derive(Default)]
+struct MaintenanceCounters {
+    steps: AtomicU64,
+    keys_reclaimed: AtomicU64,
+    keys_evicted: AtomicU64,
+    pages_freed: AtomicU64,
+    checkpoints: AtomicU64,
+    pause_total_us: AtomicU64,
+    pause_max_us: AtomicU64,
+    /// sqlite3_total_changes at the end of the previous step, and at the
+    /// last idle checkpoint
+    changes_seen: AtomicU64,
+    changes_checkpointed: AtomicU64,
 }
 
 /// Eviction policy for memory-based eviction
@@ -106,6 +172,23 @@ impl EvictionPolicy {
             Self::VolatileRandom => "volatile-random",
         }
     }
+
+    fn as_u8(self) -> u8 {
+        self as u8
+    }
+
+    fn from_u8(v: u8) -> Self {
+        match v {
+            1 => Self::AllKeysLRU,
+            2 => Self::AllKeysLFU,
+            3 => Self::AllKeysRandom,
+            4 => Self::VolatileLRU,
+            5 => Self::VolatileLFU,
+            6 => Self::VolatileTTL,
+            7 => Self::VolatileRandom,
+            _ => Self::NoEviction,
+        }
+    }
 }
 
 /// Shared database backend (SQLite connection)
@@ -117,6 +200,10 @@ struct DbCore {
     last_cleanup: AtomicI64,
     /// Autovacuum interval in milliseconds (configurable, default: 60s)
     autovacuum_interval_ms: AtomicI64,
+    /// Time budget per autovacuum / maintenance slice in microseconds
+    autovacuum_budget_us: AtomicI64,
+    /// Background maintenance counters (`maintenance_step`)
+    maintenance: MaintenanceCounters,
     /// Optional notifier for server mode (None for embedded mode)
     /// Maps key name to broadcast sender for notifications
     /// Uses RwLock to allow updating after creation (for server mode attachment)
@@ -125,16 +212,17 @@ struct DbCore {
     poll_config: RwLock<PollConfig>,
     /// Maximum disk size in bytes (0 = unlimited, no eviction)
     max_disk_bytes: AtomicU64,
-    /// Last eviction check timestamp in milliseconds
+    /// Last eviction pass timestamp in milliseconds (0 = a pass ran out of time)
     last_eviction_check: AtomicI64,
     /// Maximum memory size in bytes (0 = unlimited, no eviction)
     max_memory_bytes: AtomicU64,
-    /// Last memory eviction check timestamp in milliseconds
-    last_memory_eviction_check: AtomicI64,
-    /// Eviction policy for memory-based eviction
-    eviction_policy: Mutex<EvictionPolicy>,
-    /// In-memory access tracking for LRU/LFU eviction (key_id -> access stats)
-    access_tracking: RwLock<HashMap<i64, AccessInfo>>,
+    /// Eviction policy for memory-based eviction (`EvictionPolicy::as_u8`)
+    eviction_policy: AtomicU8,
+    /// Sharded in-memory access stats for LRU/LFU eviction (key_id -> last access, LFU counter)
+    access_tracking: AccessTracker,
+    /// Set by the first `maintenance_step`; writes then leave eviction and
+    /// access stat flushes to it
+    background_maintenance: AtomicBool,
     /// Whether to persist access tracking to disk (default: true for :memory:, false for file)
     persist_access_tracking: AtomicBool,
     /// Access tracking flush interval in milliseconds
@@ -143,6 +231,12 @@ struct DbCore {
     last_access_flush: AtomicI64,
     /// Whether this is an in-memory database
     is_memory_db: bool,
+    /// Explicit WAL checkpoints run, and their total / longest duration in microseconds
+    checkpoints: AtomicU64,
+    checkpoint_us: AtomicU64,
+    checkpoint_max_us: AtomicU64,
+    /// Prepared-statement cache capacity of `conn`
+    statement_cache_capacity: AtomicUsize,
 }
 
 /// Database session with per-instance selected database.
@@ -247,59 +341,7 @@ fn glob_match(pattern: &str, text: &str) -> bool {
 impl Db {
     /// Open or create a database at the given path
     pub fn open(path: &str) -> Result<Self> {
-        // Initialize sqlite-vec extension before opening connection
-        init_sqlite_vec();
-
-        let conn = Connection::open(path)?;
-
-        // Enable WAL mode and optimize pragmas for performance
-        conn.execute_batch(
-            "PRAGMA journal_mode = WAL;
-             PRAGMA synchronous = NORMAL;
-             PRAGMA foreign_keys = ON;
-             PRAGMA busy_timeout = 5000;
-             PRAGMA cache_size = -64000;
-             PRAGMA mmap_size = 268435456;
-             PRAGMA temp_store = MEMORY;",
-        )?;
-
-        // Detect database type and set smart defaults
-        let is_memory_db = path == ":memory:";
-        let persist_access_tracking = is_memory_db; // true for :memory:, false for file
-        let access_flush_interval_ms = if is_memory_db {
-            5_000  // 5 seconds for :memory: (cheap)
-        } else {
-            300_000  // 5 minutes for file-based (expensive due to WAL)
-        };
-
-        // sqlite-vec is registered globally via auto_extension in lib.rs init
-
-        let core = Arc::new(DbCore {
-            conn: Mutex::new(conn),
-            autovacuum_enabled: AtomicBool::new(true),
-            last_cleanup: AtomicI64::new(0),
-            autovacuum_interval_ms: AtomicI64::new(DEFAULT_AUTOVACUUM_INTERVAL_MS),
-            notifier: RwLock::new(None),
-            poll_config: RwLock::new(PollConfig::default()),
-            max_disk_bytes: AtomicU64::new(0),
-            last_eviction_check: AtomicI64::new(0),
-            max_memory_bytes: AtomicU64::new(0),
-            last_memory_eviction_check: AtomicI64::new(0),
-            eviction_policy: Mutex::new(EvictionPolicy::NoEviction),
-            access_tracking: RwLock::new(HashMap::new()),
-            persist_access_tracking: AtomicBool::new(persist_access_tracking),
-            access_flush_interval_ms: AtomicI64::new(access_flush_interval_ms),
-            last_access_flush: AtomicI64::new(0),
-            is_memory_db,
-        });
-
-        let db = Self {
-            core,
-            selected_db: 0,
-        };
-
-        db.migrate()?;
-        Ok(db)
+        Self::open_with_options(path, &OpenOptions::default())
     }
 
     /// Open an in-memory database (useful for testing)
@@ -323,27 +365,69 @@ impl Db {
     /// let db = Db::open_with_cache("mydata.db", 256).unwrap();
     /// ```
     pub fn open_with_cache(path: &str, cache_mb: i64) -> Result<Self> {
+        // Set mmap to 4x cache size (reasonable default)
+        let options = OpenOptions::new()
+            .cache_mb(cache_mb)
+            .mmap_size(cache_mb * 4 * 1024 * 1024);
+        Self::open_with_options(path, &options)
+    }
+
+    /// Open a database with explicit SQLite connection settings.
+    ///
+    /// # Example
+    /// ```
+    /// use redlite::{Db, OpenOptions, Synchronous};
+    ///
+    /// let options = OpenOptions::new()
+    ///     .cache_mb(256)
+    ///     .mmap_size(1 << 30)
+    ///     .synchronous(Synchronous::Full)
+    ///     .statement_cache(512);
+    /// let db = Db::open_with_options(":memory:", &options).unwrap();
+    /// assert_eq!(db.statement_cache_capacity(), 512);
+    /// ```
+    pub fn open_with_options(path: &str, options: &OpenOptions) -> Result<Self> {
         // Initialize sqlite-vec extension before opening connection
         init_sqlite_vec();
 
         let conn = Connection::open(path)?;
 
-        // Base pragmas (WAL mode, etc.)
-        conn.execute_batch(
+        // Page size and auto_vacuum must be chosen before the first table is
+        // created (or before a VACUUM), and page size cannot change once the
+        // database is in WAL mode
+        if let Some(page_size) = options.page_size {
+            if !(512..=65536).contains(&page_size) || !page_size.is_power_of_two() {
+                return Err(KvError::Other(format!(
+                    "page_size must be a power of two between 512 and 65536, got {}",
+                    page_size
+                )));
+            }
+            conn.execute_batch(&format!("PRAGMA page_size = {};", page_size))?;
+        }
+        if options.incremental_vacuum {
+            conn.execute_batch("PRAGMA auto_vacuum = INCREMENTAL;")?;
+        }
+
+        // Enable WAL mode and optimize pragmas for performance
+        // (cache_size: negative = KB, so multiply by 1000)
+        conn.execute_batch(&format!(
             "PRAGMA journal_mode = WAL;
-             PRAGMA synchronous = NORMAL;
+             PRAGMA synchronous = {};
              PRAGMA foreign_keys = ON;
-             PRAGMA busy_timeout = 5000;
-             PRAGMA temp_store = MEMORY;",
-        )?;
-
-        // Apply cache size (negative = KB, so multiply by 1000)
-        let cache_kb = cache_mb * 1000;
-        conn.execute_batch(&format!("PRAGMA cache_size = -{};", cache_kb))?;
-
-        // Set mmap to 4x cache size (reasonable default)
-        let mmap_bytes = cache_mb * 4 * 1024 * 1024;
-        conn.execute_batch(&format!("PRAGMA mmap_size = {};", mmap_bytes))?;
+             PRAGMA busy_timeout = {};
+             PRAGMA cache_size = -{};
+             PRAGMA mmap_size = {};
+             PRAGMA temp_store = {};
+             PRAGMA wal_autocheckpoint = {};",
+            options.synchronous.as_str(),
+            options.busy_timeout_ms.max(0),
+            options.cache_mb.max(1) * 1000,
+            options.mmap_size.max(0),
+            if options.temp_store_memory { "MEMORY" } else { "DEFAULT" },
+            options.wal_autocheckpoint.max(0),
+        ))?;
+
+        conn.set_prepared_statement_cache_capacity(options.statement_cache);
 
         // Detect database type and set smart defaults
         let is_memory_db = path == ":memory:";
@@ -361,18 +445,24 @@ impl Db {
             autovacuum_enabled: AtomicBool::new(true),
             last_cleanup: AtomicI64::new(0),
             autovacuum_interval_ms: AtomicI64::new(DEFAULT_AUTOVACUUM_INTERVAL_MS),
+            autovacuum_budget_us: AtomicI64::new(DEFAULT_AUTOVACUUM_BUDGET_US),
+            maintenance: MaintenanceCounters::default(),
             notifier: RwLock::new(None),
             poll_config: RwLock::new(PollConfig::default()),
-            max_disk_bytes: AtomicU64::new(0),
+            max_disk_bytes: AtomicU64::new(options.max_disk),
             last_eviction_check: AtomicI64::new(0),
-            max_memory_bytes: AtomicU64::new(0),
-            last_memory_eviction_check: AtomicI64::new(0),
-            eviction_policy: Mutex::new(EvictionPolicy::NoEviction),
-            access_tracking: RwLock::new(HashMap::new()),
+            max_memory_bytes: AtomicU64::new(options.max_memory),
+            eviction_policy: AtomicU8::new(options.eviction_policy.as_u8()),
+            access_tracking: AccessTracker::new(),
+            background_maintenance: AtomicBool::new(false),
             persist_access_tracking: AtomicBool::new(persist_access_tracking),
             access_flush_interval_ms: AtomicI64::new(access_flush_interval_ms),
             last_access_flush: AtomicI64::new(0),
             is_memory_db,
+            checkpoints: AtomicU64::new(0),
+            checkpoint_us: AtomicU64::new(0),
+            checkpoint_max_us: AtomicU64::new(0),
+            statement_cache_capacity: AtomicUsize::new(options.statement_cache),
         });
 
         let db = Self {
@@ -430,23 +520,35 @@ impl Db {
         let persist_access_tracking = false;
         let access_flush_interval_ms = 300_000;
 
+        conn.set_prepared_statement_cache_capacity(
+            crate::types::DEFAULT_STATEMENT_CACHE_CAPACITY,
+        );
+
         let core = Arc::new(DbCore {
             conn: Mutex::new(conn),
             autovacuum_enabled: AtomicBool::new(true),
             last_cleanup: AtomicI64::new(0),
             autovacuum_interval_ms: AtomicI64::new(DEFAULT_AUTOVACUUM_INTERVAL_MS),
+            autovacuum_budget_us: AtomicI64::new(DEFAULT_AUTOVACUUM_BUDGET_US),
+            maintenance: MaintenanceCounters::default(),
             notifier: RwLock::new(None),
             poll_config: RwLock::new(PollConfig::default()),
             max_disk_bytes: AtomicU64::new(0),
             last_eviction_check: AtomicI64::new(0),
             max_memory_bytes: AtomicU64::new(0),
-            last_memory_eviction_check: AtomicI64::new(0),
-            eviction_policy: Mutex::new(EvictionPolicy::NoEviction),
-            access_tracking: RwLock::new(HashMap::new()),
+            eviction_policy: AtomicU8::new(EvictionPolicy::NoEviction.as_u8()),
+            access_tracking: AccessTracker::new(),
+            background_maintenance: AtomicBool::new(false),
             persist_access_tracking: AtomicBool::new(persist_access_tracking),
             access_flush_interval_ms: AtomicI64::new(access_flush_interval_ms),
             last_access_flush: AtomicI64::new(0),
             is_memory_db,
+            checkpoints: AtomicU64::new(0),
+            checkpoint_us: AtomicU64::new(0),
+            checkpoint_max_us: AtomicU64::new(0),
+            statement_cache_capacity: AtomicUsize::new(
+                crate::types::DEFAULT_STATEMENT_CACHE_CAPACITY,
+            ),
         });
 
         let db = Self {
@@ -498,23 +600,35 @@ impl Db {
         let persist_access_tracking = is_memory_db;
         let access_flush_interval_ms = if is_memory_db { 5_000 } else { 300_000 };
 
+        conn.set_prepared_statement_cache_capacity(
+            crate::types::DEFAULT_STATEMENT_CACHE_CAPACITY,
+        );
+
         let core = Arc::new(DbCore {
             conn: Mutex::new(conn),
             autovacuum_enabled: AtomicBool::new(true),
             last_cleanup: AtomicI64::new(0),
             autovacuum_interval_ms: AtomicI64::new(DEFAULT_AUTOVACUUM_INTERVAL_MS),
+            autovacuum_budget_us: AtomicI64::new(DEFAULT_AUTOVACUUM_BUDGET_US),
+            maintenance: MaintenanceCounters::default(),
             notifier: RwLock::new(None),
             poll_config: RwLock::new(PollConfig::default()),
             max_disk_bytes: AtomicU64::new(0),
             last_eviction_check: AtomicI64::new(0),
             max_memory_bytes: AtomicU64::new(0),
-            last_memory_eviction_check: AtomicI64::new(0),
-            eviction_policy: Mutex::new(EvictionPolicy::NoEviction),
-            access_tracking: RwLock::new(HashMap::new()),
+            eviction_policy: AtomicU8::new(EvictionPolicy::NoEviction.as_u8()),
+            access_tracking: AccessTracker::new(),
+            background_maintenance: AtomicBool::new(false),
             persist_access_tracking: AtomicBool::new(persist_access_tracking),
             access_flush_interval_ms: AtomicI64::new(access_flush_interval_ms),
             last_access_flush: AtomicI64::new(0),
             is_memory_db,
+            checkpoints: AtomicU64::new(0),
+            checkpoint_us: AtomicU64::new(0),
+            checkpoint_max_us: AtomicU64::new(0),
+            statement_cache_capacity: AtomicUsize::new(
+                crate::types::DEFAULT_STATEMENT_CACHE_CAPACITY,
+            ),
         });
 
         let db = Self {
@@ -572,10 +686,64 @@ impl Db {
     /// ```
     pub fn checkpoint(&self) -> Result<()> {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        let start = std::time::Instant::now();
         conn.execute_batch("PRAGMA wal_checkpoint(TRUNCATE);")?;
+        let us = start.elapsed().as_micros() as u64;
+        self.core.checkpoints.fetch_add(1, Ordering::Relaxed);
+        self.core.checkpoint_us.fetch_add(us, Ordering::Relaxed);
+        self.core.checkpoint_max_us.fetch_max(us, Ordering::Relaxed);
         Ok(())
     }
 
+    /// SQLite-level counters: page cache, prepared statements and checkpoints.
+    ///
+    /// # Example
+    /// ```
+    /// use redlite::Db;
+    ///
+    /// let db = Db::open_memory().unwrap();
+    /// db.set("key", b"value", None).unwrap();
+    /// let stats = db.sqlite_stats().unwrap();
+    /// assert!(stats.statements > 0);
+    /// ```
+    pub fn sqlite_stats(&self) -> Result<SqliteStats> {
+        use rusqlite::ffi;
+
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        let mut stats = SqliteStats {
+            checkpoints: self.core.checkpoints.load(Ordering::Relaxed),
+            checkpoint_total_us: self.core.checkpoint_us.load(Ordering::Relaxed),
+            checkpoint_max_us: self.core.checkpoint_max_us.load(Ordering::Relaxed),
+            ..Default::default()
+        };
+
+        // SAFETY: the handle stays valid while the connection lock is held, and
+        // sqlite3_next_stmt only walks statements owned by this connection
+        unsafe {
+            let handle = conn.handle();
+            let status = |op: i32| -> u64 {
+                let (mut current, mut highwater) = (0, 0);
+                ffi::sqlite3_db_status(handle, op, &mut current, &mut highwater, 0);
+                current.max(0) as u64
+            };
+            stats.cache_hits = status(ffi::SQLITE_DBSTATUS_CACHE_HIT);
+            stats.cache_misses = status(ffi::SQLITE_DBSTATUS_CACHE_MISS);
+            stats.cache_writes = status(ffi::SQLITE_DBSTATUS_CACHE_WRITE);
+            stats.cache_spills = status(ffi::SQLITE_DBSTATUS_CACHE_SPILL);
+            stats.cache_bytes = status(ffi::SQLITE_DBSTATUS_CACHE_USED);
+            stats.statement_bytes = status(ffi::SQLITE_DBSTATUS_STMT_USED);
+
+            let mut stmt = ffi::sqlite3_next_stmt(handle, std::ptr::null_mut());
+            while !stmt.is_null() {
+                stats.statements += 1;
+                stats.statement_runs +=
+                    ffi::sqlite3_stmt_status(stmt, ffi::SQLITE_STMTSTATUS_RUN, 0).max(0) as u64;
+                stmt = ffi::sqlite3_next_stmt(handle, stmt);
+            }
+        }
+        Ok(stats)
+    }
+
     /// Release as much memory as possible by shrinking internal caches.
     ///
     /// This is useful before stopping a database to free up memory resources.
@@ -593,6 +761,112 @@ impl Db {
         Ok(())
     }
 
+    /// BEGIN - start an explicit write transaction (`BEGIN IMMEDIATE`).
+    ///
+    /// All commands until `commit` or `rollback` share one SQLite commit.
+    /// Callers must keep other sessions on the same backend from writing
+    /// while the transaction is open (the FFI handle mutex does this per call).
+    pub fn begin(&self) -> Result<()> {
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        if !conn.is_autocommit() {
+            return Err(KvError::Other("transaction already in progress".to_string()));
+        }
+        conn.execute_batch("BEGIN IMMEDIATE")?;
+        Ok(())
+    }
+
+    /// COMMIT - commit the transaction started by `begin`.
+    pub fn commit(&self) -> Result<()> {
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        if conn.is_autocommit() {
+            return Err(KvError::Other("no transaction in progress".to_string()));
+        }
+        if let Err(e) = conn.execute_batch("COMMIT") {
+            let _ = conn.execute_batch("ROLLBACK");
+            return Err(e.into());
+        }
+        Ok(())
+    }
+
+    /// ROLLBACK - discard the transaction started by `begin`.
+    pub fn rollback(&self) -> Result<()> {
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        if conn.is_autocommit() {
+            return Err(KvError::Other("no transaction in progress".to_string()));
+        }
+        conn.execute_batch("ROLLBACK")?;
+        Ok(())
+    }
+
+    /// Whether an explicit transaction is currently open on this backend.
+    pub fn in_transaction(&self) -> bool {
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        !conn.is_autocommit()
+    }
+
+    /// Run `f` inside a single write transaction (`BEGIN IMMEDIATE ... COMMIT`).
+    ///
+    /// Every command executed by `f` shares one SQLite commit instead of
+    /// committing individually. The transaction is rolled back if `f` fails.
+    /// If a transaction is already open (see `begin`), `f` runs inside a
+    /// savepoint of it instead.
+    ///
+    /// The connection lock is released between statements, so callers are
+    /// responsible for keeping other sessions on the same backend from writing
+    /// while the transaction is open (the FFI handle mutex does this).
+    ///
+    /// # Example
+    /// ```
+    /// use redlite::Db;
+    ///
+    /// let db = Db::open_memory().unwrap();
+    /// db.with_transaction(|db| {
+    ///     db.set("a", b"1", None)?;
+    ///     db.set("b", b"2", None)
+    /// }).unwrap();
+    /// assert_eq!(db.get("b").unwrap(), Some(b"2".to_vec()));
+    /// ```
+    pub fn with_transaction<T, F>(&self, f: F) -> Result<T>
+    where
+        F: FnOnce(&Self) -> Result<T>,
+    {
+        let nested = {
+            let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+            let nested = !conn.is_autocommit();
+            if nested {
+                conn.execute_batch("SAVEPOINT with_transaction")?;
+            } else {
+                conn.execute_batch("BEGIN IMMEDIATE")?;
+            }
+            nested
+        };
+
+        let result = f(self);
+
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        let rollback = if nested {
+            "ROLLBACK TO with_transaction; RELEASE with_transaction"
+        } else {
+            "ROLLBACK"
+        };
+        match result {
+            Ok(value) => {
+                let finish = if nested { "RELEASE with_transaction" } else { "COMMIT" };
+                match conn.execute_batch(finish) {
+                    Ok(()) => Ok(value),
+                    Err(e) => {
+                        let _ = conn.execute_batch(rollback);
+                        Err(e.into())
+                    }
+                }
+            }
+            Err(e) => {
+                let _ = conn.execute_batch(rollback);
+                Err(e)
+            }
+        }
+    }
+
     /// Create a new session sharing the same database backend.
     /// The new session starts at database 0.
     pub fn session(&self) -> Self {
@@ -612,7 +886,24 @@ impl Db {
         #[cfg(feature = "vectors")]
         conn.execute_batch(include_str!("schema_vectors.sql"))?;
         #[cfg(feature = "geo")]
-        conn.execute_batch(include_str!("schema_geo.sql"))?;
+        {
+            // Migration: R*Tree entries of geo members deleted before the
+            // cleanup trigger existed are dropped once, when it is created
+            let has_rtree_trigger: bool = conn
+                .query_row(
+                    "SELECT COUNT(*) FROM sqlite_master WHERE type = 'trigger' AND name = 'geo_data_rtree_delete'",
+                    [],
+                    |row| row.get::<_, i32>(0).map(|c| c > 0),
+                )
+                .unwrap_or(false);
+            conn.execute_batch(include_str!("schema_geo.sql"))?;
+            if !has_rtree_trigger {
+                conn.execute(
+                    "DELETE FROM geo_rtree WHERE id NOT IN (SELECT id FROM geo_data)",
+                    [],
+                )?;
+            }
+        }
 
         // Migration: Add version column to keys table if it doesn't exist
         // SQLite doesn't support ADD COLUMN IF NOT EXISTS, so we check first
@@ -671,6 +962,44 @@ impl Db {
             )?;
         }
 
+        // Migration: Add delta_base column for delta-encoded history snapshots
+        let has_delta_base: bool = conn
+            .query_row(
+                "SELECT COUNT(*) FROM pragma_table_info('key_history') WHERE name = 'delta_base'",
+                [],
+                |row| row.get::<_, i32>(0).map(|c| c > 0),
+            )
+            .unwrap_or(false);
+
+        if !has_delta_base {
+            // Existing rows stay full snapshots
+            conn.execute("ALTER TABLE key_history ADD COLUMN delta_base INTEGER", [])?;
+        }
+        // Superseded by idx_history_db_key_time_version
+        conn.execute("DROP INDEX IF EXISTS idx_history_db_key_time", [])?;
+
+        // Migration: Add precomputed norms and IVF list assignment to vector sets
+        #[cfg(feature = "vectors")]
+        {
+            let has_norm: bool = conn
+                .query_row(
+                    "SELECT COUNT(*) FROM pragma_table_info('vector_sets') WHERE name = 'norm'",
+                    [],
+                    |row| row.get::<_, i32>(0).map(|c| c > 0),
+                )
+                .unwrap_or(false);
+
+            if !has_norm {
+                // Existing rows keep NULL norms; VSIM computes those on the fly
+                conn.execute("ALTER TABLE vector_sets ADD COLUMN norm REAL", [])?;
+                conn.execute("ALTER TABLE vector_sets ADD COLUMN list_id INTEGER", [])?;
+            }
+            conn.execute(
+                "CREATE INDEX IF NOT EXISTS idx_vector_sets_list ON vector_sets(key_id, list_id)",
+                [],
+            )?;
+        }
+
         Ok(())
     }
 
@@ -712,6 +1041,38 @@ impl Db {
         self.core.autovacuum_interval_ms.load(Ordering::Relaxed)
     }
 
+    /// Set the time budget of one expiration / vacuum slice in microseconds
+    /// (default: 5000 = 5ms). Bounds how long autovacuum and each
+    /// `maintenance_step` hold the connection.
+    pub fn set_autovacuum_budget(&self, budget_us: i64) {
+        self.core
+            .autovacuum_budget_us
+            .store(budget_us.max(100), Ordering::Relaxed); // Min 100us
+    }
+
+    /// Get current autovacuum slice budget in microseconds
+    pub fn autovacuum_budget(&self) -> i64 {
+        self.core.autovacuum_budget_us.load(Ordering::Relaxed)
+    }
+
+    /// Set the prepared-statement cache capacity (default: 256).
+    ///
+    /// Hot commands run through cached statements; a capacity smaller than the
+    /// number of distinct statements in the workload evicts them before they
+    /// are reused. Shrinking drops the least recently used statements.
+    pub fn set_statement_cache_capacity(&self, capacity: usize) {
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        conn.set_prepared_statement_cache_capacity(capacity);
+        self.core
+            .statement_cache_capacity
+            .store(capacity, Ordering::Relaxed);
+    }
+
+    /// Get the prepared-statement cache capacity
+    pub fn statement_cache_capacity(&self) -> usize {
+        self.core.statement_cache_capacity.load(Ordering::Relaxed)
+    }
+
     /// Set polling configuration for sync blocking operations
     /// (blpop_sync, brpop_sync, xread_block_sync, xreadgroup_block_sync)
     pub fn set_poll_config(&self, config: PollConfig) {
@@ -745,17 +1106,20 @@ impl Db {
 
     /// Set eviction policy for memory-based eviction
     pub fn set_eviction_policy(&self, policy: EvictionPolicy) {
-        *self.core.eviction_policy.lock().unwrap() = policy;
+        self.core
+            .eviction_policy
+            .store(policy.as_u8(), Ordering::Relaxed);
     }
 
     /// Get current eviction policy
     pub fn eviction_policy(&self) -> EvictionPolicy {
-        *self.core.eviction_policy.lock().unwrap()
+        EvictionPolicy::from_u8(self.core.eviction_policy.load(Ordering::Relaxed))
     }
 
     /// Set whether to persist access tracking to disk
     /// When enabled, access tracking data (last_accessed, access_count) is periodically
-    /// flushed from the in-memory HashMap to SQLite columns for LRU/LFU eviction.
+    /// flushed from the in-memory tracker to SQLite columns, in batches, so LRU/LFU
+    /// history survives a reopen. access_count holds the key's LFU counter.
     /// Default: true for :memory: databases, false for file-based databases.
     pub fn set_persist_access_tracking(&self, enabled: bool) {
         self.core.persist_access_tracking.store(enabled, Ordering::Relaxed);
@@ -801,157 +1165,192 @@ impl Db {
             .compare_exchange(last, now, Ordering::Relaxed, Ordering::Relaxed)
             .is_ok()
         {
-            // We won - delete all expired keys (across all dbs, no SQLite VACUUM)
+            // We won - delete expired keys (across all dbs, no SQLite VACUUM)
+            // for at most one slice; a background maintenance_step loop
+            // clears larger backlogs
             let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
-            let _ = conn.execute(
-                "DELETE FROM keys WHERE expire_at IS NOT NULL AND expire_at <= ?1",
-                params![now],
-            );
+            let budget = self.core.autovacuum_budget_us.load(Ordering::Relaxed);
+            let deadline = Instant::now() + Duration::from_micros(budget as u64);
+            if let Ok((reclaimed, _)) = Self::sweep_expired(&conn, now, deadline) {
+                self.core
+                    .maintenance
+                    .keys_reclaimed
+                    .fetch_add(reclaimed, Ordering::Relaxed);
+            }
         }
     }
 
-    /// Maybe evict oldest keys if disk size exceeds max_disk_bytes.
-    /// Called on write operations. Uses atomic compare-exchange to ensure
-    /// only one connection does eviction per check interval (1 second).
+    /// Evict keys on a write when a disk or memory budget is set and no
+    /// background maintenance runs. One connection at a time evicts, for at
+    /// most one autovacuum budget, once a second or on the next write while
+    /// the previous pass ran out of time.
     ///
-    /// Strategy: First try to reclaim space by deleting expired keys (vacuum),
-    /// then only evict valid keys if still over limit.
+    /// Expired keys are deleted first, so no live key is evicted for their space.
     fn maybe_evict(&self) {
-        let max_bytes = self.core.max_disk_bytes.load(Ordering::Relaxed);
-        if max_bytes == 0 {
-            return; // No limit set
+        if self.core.background_maintenance.load(Ordering::Relaxed) || !self.claim_eviction_pass() {
+            return;
         }
 
-        let now = Self::now_ms();
-        let last = self.core.last_eviction_check.load(Ordering::Relaxed);
-
-        // Check every 1 second
-        if now - last < 1000 {
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        // Don't evict inside a caller's open transaction
+        if !conn.is_autocommit() {
+            self.core.last_eviction_check.store(0, Ordering::Relaxed);
             return;
         }
+        let budget = self.core.autovacuum_budget_us.load(Ordering::Relaxed);
+        let deadline = Instant::now() + Duration::from_micros(budget as u64);
+        let m = &self.core.maintenance;
+        if let Ok((reclaimed, _)) = Self::sweep_expired(&conn, Self::now_ms(), deadline) {
+            m.keys_reclaimed.fetch_add(reclaimed, Ordering::Relaxed);
+        }
+        if let Ok(evicted) = self.evict_over_budget(&conn, deadline) {
+            m.keys_evicted.fetch_add(evicted, Ordering::Relaxed);
+        }
+    }
 
-        // Try to claim eviction duty (only one connection wins)
-        if self
-            .core
-            .last_eviction_check
-            .compare_exchange(last, now, Ordering::Relaxed, Ordering::Relaxed)
-            .is_ok()
+    /// Whether an eviction pass is due: a budget is set, and a second has
+    /// passed since the last pass or it ran out of time. Claims the pass, so
+    /// only one connection wins.
+    fn claim_eviction_pass(&self) -> bool {
+        if self.core.max_disk_bytes.load(Ordering::Relaxed) == 0
+            && self.core.max_memory_bytes.load(Ordering::Relaxed) == 0
         {
-            let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
-
-            // Phase 1: Try vacuum first - remove expired keys without losing valid data
-            let _ = conn.execute(
-                "DELETE FROM keys WHERE expire_at IS NOT NULL AND expire_at < ?1",
-                params![now],
-            );
-
-            // Check if vacuum was enough
-            let size: u64 = conn
-                .query_row(
-                    "SELECT page_count * page_size FROM pragma_page_count(), pragma_page_size()",
-                    [],
-                    |r| r.get(0),
-                )
-                .unwrap_or(0);
-
-            if size <= max_bytes {
-                return; // Vacuum was sufficient
-            }
-
-            // Phase 2: Evict oldest keys until under limit
-            loop {
-                let size: u64 = conn
-                    .query_row(
-                        "SELECT page_count * page_size FROM pragma_page_count(), pragma_page_size()",
-                        [],
-                        |r| r.get(0),
-                    )
-                    .unwrap_or(0);
+            return false;
+        }
+        let now = Self::now_ms();
+        let last = self.core.last_eviction_check.load(Ordering::Relaxed);
+        now - last >= 1000
+            && self
+                .core
+                .last_eviction_check
+                .compare_exchange(last, now, Ordering::Relaxed, Ordering::Relaxed)
+                .is_ok()
+    }
 
-                if size <= max_bytes {
+    /// Evict keys while the disk or memory budget is exceeded. Stops once
+    /// `deadline` passes (after at least one key) and marks the pass as cut
+    /// short so the next one runs without waiting. Returns the keys evicted.
+    ///
+    /// Disk use counts pages in use, not free pages waiting for vacuum. Under
+    /// `NoEviction` the disk budget drops the oldest keys and the memory
+    /// budget is not enforced; other policies pick victims for both.
+    fn evict_over_budget(&self, conn: &Connection, deadline: Instant) -> Result<u64> {
+        let max_disk = self.core.max_disk_bytes.load(Ordering::Relaxed);
+        let max_memory = self.core.max_memory_bytes.load(Ordering::Relaxed);
+        let policy = self.eviction_policy();
+        let mut evicted = 0u64;
+        let mut out_of_time = false;
+
+        if max_disk > 0 {
+            while Self::disk_used(conn)? > max_disk {
+                if evicted > 0 && Instant::now() >= deadline {
+                    out_of_time = true;
                     break;
                 }
-
-                // Delete oldest key (across all DBs) - history cascades automatically
-                let deleted = conn
-                    .execute(
-                        "DELETE FROM keys WHERE id = (SELECT id FROM keys ORDER BY created_at ASC LIMIT 1)",
-                        [],
-                    )
-                    .unwrap_or(0);
-
-                if deleted == 0 {
-                    break; // No more keys to delete
+                let victim = match policy {
+                    // Lowest id = oldest key (across all dbs)
+                    EvictionPolicy::NoEviction => conn
+                        .query_row("SELECT id FROM keys ORDER BY id LIMIT 1", [], |row| {
+                            row.get(0)
+                        })
+                        .optional()?,
+                    _ => self.find_eviction_victim(conn, policy)?,
+                };
+                match victim {
+                    Some(id) => self.evict_key(conn, id)?,
+                    None => break,
                 }
+                evicted += 1;
             }
         }
 
-        // Also check memory-based eviction
-        self.maybe_evict_memory();
-    }
+        if max_memory > 0 && policy != EvictionPolicy::NoEviction && !out_of_time {
+            // One aggregate pass, then subtract each victim's share
+            let mut used = Self::memory_usage(conn, self.selected_db)?;
+            while used > max_memory {
+                if evicted > 0 && Instant::now() >= deadline {
+                    out_of_time = true;
+                    break;
+                }
+                let id = match self.find_eviction_victim(conn, policy)? {
+                    Some(id) => id,
+                    None => break,
+                };
+                used = used.saturating_sub(Self::key_memory(conn, id)?);
+                self.evict_key(conn, id)?;
+                evicted += 1;
+            }
+        }
 
-    /// Find a victim key for eviction based on the current policy.
-    /// Uses Redis-style sampling to avoid full table scans for LRU/LFU.
-    fn find_eviction_victim(&self, conn: &Connection, policy: EvictionPolicy) -> Result<Option<i64>> {
-        let db = self.selected_db;
+        if out_of_time {
+            self.core.last_eviction_check.store(0, Ordering::Relaxed);
+        }
+        Ok(evicted)
+    }
 
-        // Redis default: sample 5 keys (configurable via maxmemory-samples)
-        const SAMPLE_SIZE: i64 = 5;
+    /// Bytes of database pages in use (free pages excluded)
+    fn disk_used(conn: &Connection) -> Result<u64> {
+        let used: i64 = conn.query_row(
+            "SELECT (page_count - freelist_count) * page_size
+             FROM pragma_page_count(), pragma_freelist_count(), pragma_page_size()",
+            [],
+            |row| row.get(0),
+        )?;
+        Ok(used.max(0) as u64)
+    }
 
-        match policy {
-            EvictionPolicy::NoEviction => Ok(None),
+    /// Delete one eviction victim (cascades to type-specific tables)
+    fn evict_key(&self, conn: &Connection, key_id: i64) -> Result<()> {
+        conn.prepare_cached("DELETE FROM keys WHERE id = ?1")?
+            .execute(params![key_id])?;
+        self.core.access_tracking.remove(key_id);
+        Ok(())
+    }
 
-            // LRU/LFU: Sample random keys, pick the worst among samples (avoid full table scan)
-            EvictionPolicy::AllKeysLRU => {
-                self.sample_and_pick_victim(conn, db, false, |id, last_acc, _count| (id, last_acc))
-                    .map(|opt| opt.map(|(id, _)| id))
-            }
+    /// Find a victim key for eviction based on the current policy.
+    /// LRU, LFU and random policies sample keys at random ids, Redis-style,
+    /// instead of scanning the keys table.
+    fn find_eviction_victim(
+        &self,
+        conn: &Connection,
+        policy: EvictionPolicy,
+    ) -> Result<Option<i64>> {
+        let volatile_only = matches!(
+            policy,
+            EvictionPolicy::VolatileLRU
+                | EvictionPolicy::VolatileLFU
+                | EvictionPolicy::VolatileRandom
+        );
 
-            EvictionPolicy::AllKeysLFU => {
-                self.sample_and_pick_victim(conn, db, false, |id, _last_acc, count| (id, count))
-                    .map(|opt| opt.map(|(id, _)| id))
-            }
+        match policy {
+            EvictionPolicy::NoEviction => Ok(None),
 
-            EvictionPolicy::AllKeysRandom => {
-                // Random is already a single query
-                match conn.query_row(
-                    "SELECT id FROM keys WHERE db = ?1 ORDER BY RANDOM() LIMIT 1",
-                    params![db],
-                    |row| row.get(0),
-                ) {
-                    Ok(id) => Ok(Some(id)),
-                    Err(rusqlite::Error::QueryReturnedNoRows) => Ok(None),
-                    Err(e) => Err(e.into()),
-                }
+            EvictionPolicy::AllKeysRandom | EvictionPolicy::VolatileRandom => {
+                Ok(self.sample_keys(conn, volatile_only, 1)?.first().map(|s| s.id))
             }
 
-            EvictionPolicy::VolatileLRU => {
-                self.sample_and_pick_victim(conn, db, true, |id, last_acc, _count| (id, last_acc))
-                    .map(|opt| opt.map(|(id, _)| id))
-            }
+            // LRU: the sampled key accessed longest ago
+            EvictionPolicy::AllKeysLRU | EvictionPolicy::VolatileLRU => Ok(self
+                .sample_keys(conn, volatile_only, EVICTION_SAMPLES)?
+                .into_iter()
+                .min_by_key(|s| s.last_ms)
+                .map(|s| s.id)),
 
-            EvictionPolicy::VolatileLFU => {
-                self.sample_and_pick_victim(conn, db, true, |id, _last_acc, count| (id, count))
-                    .map(|opt| opt.map(|(id, _)| id))
+            // LFU: the sampled key with the lowest decayed counter, then LRU
+            EvictionPolicy::AllKeysLFU | EvictionPolicy::VolatileLFU => {
+                let now = Self::now_ms();
+                Ok(self
+                    .sample_keys(conn, volatile_only, EVICTION_SAMPLES)?
+                    .into_iter()
+                    .min_by_key(|s| (access::decay(s.counter, now - s.last_ms), s.last_ms))
+                    .map(|s| s.id))
             }
 
             // TTL: Deterministic, use ORDER BY (optimal for this case)
             EvictionPolicy::VolatileTTL => {
                 match conn.query_row(
                     "SELECT id FROM keys WHERE db = ?1 AND expire_at IS NOT NULL ORDER BY expire_at ASC LIMIT 1",
-                    params![db],
-                    |row| row.get(0),
-                ) {
-                    Ok(id) => Ok(Some(id)),
-                    Err(rusqlite::Error::QueryReturnedNoRows) => Ok(None),
-                    Err(e) => Err(e.into()),
-                }
-            }
-
-            EvictionPolicy::VolatileRandom => {
-                match conn.query_row(
-                    "SELECT id FROM keys WHERE db = ?1 AND expire_at IS NOT NULL ORDER BY RANDOM() LIMIT 1",
-                    params![db],
+                    params![self.selected_db],
                     |row| row.get(0),
                 ) {
                     Ok(id) => Ok(Some(id)),
@@ -962,117 +1361,67 @@ impl Db {
         }
     }
 
-    /// Helper: Sample random keys and pick the victim using a comparison function.
-    /// Returns (key_id, metric_value) where metric_value is what we're minimizing.
-    fn sample_and_pick_victim<F, T>(
+    /// Up to `n` keys of the selected db, each the first at or after a random
+    /// id (wrapping to the lowest ids), with access stats from the tracker
+    /// or, for keys not read since opening, the keys table
+    fn sample_keys(
         &self,
         conn: &Connection,
-        db: i32,
         volatile_only: bool,
-        mut extract: F,
-    ) -> Result<Option<(i64, T)>>
-    where
-        F: FnMut(i64, i64, i64) -> (i64, T),
-        T: Ord + Copy,
-    {
-        const SAMPLE_SIZE: i64 = 5;
+        n: usize,
+    ) -> Result<Vec<EvictionSample>> {
+        let max_id: i64 = conn.query_row("SELECT COALESCE(MAX(id), 0) FROM keys", [], |row| {
+            row.get(0)
+        })?;
+        if max_id <= 0 {
+            return Ok(Vec::new());
+        }
 
-        // Sample random keys
         let sql = if volatile_only {
-            "SELECT id, last_accessed, access_count FROM keys WHERE db = ?1 AND expire_at IS NOT NULL ORDER BY RANDOM() LIMIT ?2"
+            "SELECT id, last_accessed, access_count, CAST(updated_at AS INTEGER) FROM keys
+             WHERE id >= ?1 AND db = ?2 AND expire_at IS NOT NULL ORDER BY id LIMIT 1"
         } else {
-            "SELECT id, last_accessed, access_count FROM keys WHERE db = ?1 ORDER BY RANDOM() LIMIT ?2"
+            "SELECT id, last_accessed, access_count, CAST(updated_at AS INTEGER) FROM keys
+             WHERE id >= ?1 AND db = ?2 ORDER BY id LIMIT 1"
+        };
+        let mut stmt = conn.prepare_cached(sql)?;
+        let mut first_at = |from: i64| -> Result<Option<(i64, i64, i64, i64)>> {
+            Ok(stmt
+                .query_row(params![from, self.selected_db], |row| {
+                    Ok((row.get(0)?, row.get(1)?, row.get(2)?, row.get(3)?))
+                })
+                .optional()?)
         };
 
-        let mut stmt = conn.prepare(sql)?;
-        let samples: Vec<(i64, i64, i64)> = stmt
-            .query_map(params![db, SAMPLE_SIZE], |row| {
-                Ok((row.get(0)?, row.get(1)?, row.get(2)?))
-            })?
-            .collect::<std::result::Result<Vec<_>, _>>()?;
-
-        // Pick the one with minimum metric (LRU = min last_accessed, LFU = min access_count)
-        Ok(samples
-            .into_iter()
-            .map(|(id, last_acc, count)| extract(id, last_acc, count))
-            .min_by_key(|(_, metric)| *metric))
-    }
-
-    /// Maybe evict keys if memory usage exceeds max_memory_bytes.
-    /// Called on write operations. Uses atomic compare-exchange to ensure
-    /// only one connection does eviction per check interval (1 second).
-    ///
-    /// Strategy: First try to reclaim memory by deleting expired keys (vacuum),
-    /// then only evict valid keys if still over limit.
-    fn maybe_evict_memory(&self) {
-        let max_bytes = self.core.max_memory_bytes.load(Ordering::Relaxed);
-        if max_bytes == 0 {
-            return; // No limit set
-        }
-
-        let now = Self::now_ms();
-        let last = self.core.last_memory_eviction_check.load(Ordering::Relaxed);
-
-        // Check every 1 second
-        if now - last < 1000 {
-            return;
-        }
-
-        // Try to claim eviction duty (only one connection wins)
-        if self
-            .core
-            .last_memory_eviction_check
-            .compare_exchange(last, now, Ordering::Relaxed, Ordering::Relaxed)
-            .is_ok()
-        {
-            let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
-            let policy = *self.core.eviction_policy.lock().unwrap();
-
-            // Phase 1: Try vacuum first - remove expired keys without losing valid data
-            let _ = conn.execute(
-                "DELETE FROM keys WHERE expire_at IS NOT NULL AND expire_at < ?1",
-                params![now],
-            );
-
-            // Check if vacuum was enough
-            let total_memory = match self.total_memory_usage() {
-                Ok(m) => m,
-                Err(_) => return,
+        let mut samples = Vec::with_capacity(n);
+        for _ in 0..n {
+            let start = (access::random_u64() % max_id as u64) as i64 + 1;
+            let row = match first_at(start)? {
+                Some(row) => Some(row),
+                None => first_at(0)?,
             };
-
-            if total_memory <= max_bytes {
-                return; // Vacuum was sufficient
-            }
-
-            // Phase 2: Evict keys using policy until under limit
-            loop {
-                // Calculate total memory usage
-                let total_memory = match self.total_memory_usage() {
-                    Ok(m) => m,
-                    Err(_) => break,
-                };
-
-                if total_memory <= max_bytes {
-                    break;
-                }
-
-                // Find victim key based on policy
-                let victim_id = match self.find_eviction_victim(&conn, policy) {
-                    Ok(Some(id)) => id,
-                    Ok(None) => break, // No keys to evict
-                    Err(_) => break,
-                };
-
-                // Delete the victim key (cascades to type-specific tables)
-                let deleted = conn
-                    .execute("DELETE FROM keys WHERE id = ?1", params![victim_id])
-                    .unwrap_or(0);
-
-                if deleted == 0 {
-                    break; // Failed to delete
-                }
-            }
+            let (id, last_accessed, access_count, updated_at) = match row {
+                Some(row) => row,
+                None => break,
+            };
+            // A write counts as an access; untracked keys start from LFU_INIT
+            let tracked = self.core.access_tracking.get(id);
+            let last_ms = tracked
+                .map_or(0, |a| a.last_ms)
+                .max(last_accessed)
+                .max(updated_at);
+            let counter = match tracked {
+                Some(a) => a.counter,
+                None if access_count > 0 => access_count.min(u8::MAX as i64) as u8,
+                None => access::LFU_INIT,
+            };
+            samples.push(EvictionSample {
+                id,
+                last_ms,
+                counter,
+            });
         }
+        Ok(samples)
     }
 
     /// Current time in milliseconds since epoch
@@ -1084,29 +1433,58 @@ impl Db {
     }
 
     /// Track access for LRU/LFU eviction policies
-    /// Updates in-memory HashMap (fast, no disk I/O)
-    /// Periodic flush to disk happens via maybe_flush_access_tracking()
+    /// Updates the key's sharded in-memory stats (no disk I/O, no global lock)
+    /// Batched flushes to disk happen via flush_access_stats()
     fn track_access(&self, key_id: i64) {
-        let now = Self::now_ms();
-        let mut tracking = self.core.access_tracking.write().unwrap();
-        tracking
-            .entry(key_id)
-            .and_modify(|info| {
-                info.last_accessed = now;
-                info.access_count += 1;
-            })
-            .or_insert(AccessInfo {
-                last_accessed: now,
-                access_count: 1,
-            });
+        self.core.access_tracking.touch(key_id, Self::now_ms());
+    }
+
+    /// Write up to `limit` changed access stats to keys.last_accessed and
+    /// keys.access_count (the LFU counter) in one transaction, dropping the
+    /// stats of keys that no longer exist. Returns how many were taken.
+    /// Call with no transaction open.
+    fn flush_access_stats(&self, conn: &Connection, limit: usize) -> Result<usize> {
+        let updates = self.core.access_tracking.take_dirty(limit);
+        if updates.is_empty() {
+            return Ok(0);
+        }
+
+        let ids = || updates.iter().map(|(key_id, _)| *key_id);
+        if let Err(e) = conn.execute_batch("BEGIN IMMEDIATE") {
+            // Not written (e.g. busy): leave them for the next flush
+            self.core.access_tracking.mark_dirty(ids());
+            return Err(e.into());
+        }
+        let written = (|| -> Result<()> {
+            let mut stmt = conn.prepare_cached(
+                "UPDATE keys SET last_accessed = ?1, access_count = ?2 WHERE id = ?3",
+            )?;
+            for (key_id, a) in &updates {
+                if stmt.execute(params![a.last_ms, a.counter, key_id])? == 0 {
+                    self.core.access_tracking.remove(*key_id);
+                }
+            }
+            conn.execute_batch("COMMIT")?;
+            Ok(())
+        })();
+        match written {
+            Ok(()) => Ok(updates.len()),
+            Err(e) => {
+                let _ = conn.execute_batch("ROLLBACK");
+                self.core.access_tracking.mark_dirty(ids());
+                Err(e)
+            }
+        }
     }
 
-    /// Flush access tracking HashMap to database columns (batched)
-    /// Called periodically during write operations
-    /// Only flushes if persist_access_tracking is enabled
+    /// Flush access stats on a write operation, once per flush interval.
+    /// Only flushes if persist_access_tracking is enabled, and not once
+    /// maintenance_step has taken over.
     fn maybe_flush_access_tracking(&self) {
-        if !self.core.persist_access_tracking.load(Ordering::Relaxed) {
-            return; // Persistence disabled
+        if !self.core.persist_access_tracking.load(Ordering::Relaxed)
+            || self.core.background_maintenance.load(Ordering::Relaxed)
+        {
+            return;
         }
 
         let now = Self::now_ms();
@@ -1125,27 +1503,14 @@ impl Db {
             .compare_exchange(last, now, Ordering::Relaxed, Ordering::Relaxed)
             .is_ok()
         {
-            // Drain the HashMap
-            let mut tracking = self.core.access_tracking.write().unwrap();
-            let updates = std::mem::take(&mut *tracking);
-            drop(tracking);
-
-            if updates.is_empty() {
-                return; // Nothing to flush
-            }
-
-            // Batch update to database
             let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
-            let _ = conn.execute("BEGIN IMMEDIATE", []);
 
-            for (key_id, info) in updates {
-                let _ = conn.execute(
-                    "UPDATE keys SET last_accessed = ?1, access_count = access_count + ?2 WHERE id = ?3",
-                    params![info.last_accessed, info.access_count, key_id],
-                );
+            // Don't commit a caller's open transaction; retry next interval
+            if !conn.is_autocommit() {
+                return;
             }
 
-            let _ = conn.execute("COMMIT", []);
+            while let Ok(ACCESS_FLUSH_BATCH) = self.flush_access_stats(&conn, ACCESS_FLUSH_BATCH) {}
         }
     }
 
@@ -1169,12 +1534,15 @@ impl Db {
     /// Includes key name, value(s), and metadata overhead
     pub fn calculate_key_memory(&self, key_id: i64) -> Result<u64> {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        Self::key_memory(&conn, key_id)
+    }
 
+    fn key_memory(conn: &Connection, key_id: i64) -> Result<u64> {
         // Get key metadata: key length and type
-        let (key_len, key_type): (usize, i32) = conn.query_row(
+        let (key_len, key_type): (i64, i32) = conn.query_row(
             "SELECT length(key), type FROM keys WHERE id = ?1",
             params![key_id],
-            |row| Ok((row.get::<_, String>(0)?.len(), row.get(1)?)),
+            |row| Ok((row.get(0)?, row.get(1)?)),
         )?;
 
         // Calculate value size based on type
@@ -1245,35 +1613,36 @@ impl Db {
             _ => 0,
         };
 
-        // Fixed overhead per key:
-        // - Metadata (id, db, key, type, timestamps, access tracking): ~100 bytes
-        // - Index entries: ~50 bytes
-        const FIXED_OVERHEAD: u64 = 150;
-
-        Ok(key_len as u64 + value_size + FIXED_OVERHEAD)
+        Ok(key_len as u64 + value_size + KEY_MEMORY_OVERHEAD)
     }
 
     /// Calculate total memory usage for all keys in current database
     pub fn total_memory_usage(&self) -> Result<u64> {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
-        let db = self.selected_db;
-
-        // Get all key IDs in current database
-        let mut stmt = conn.prepare("SELECT id FROM keys WHERE db = ?1")?;
-        let key_ids: Vec<i64> = stmt
-            .query_map(params![db], |row| row.get(0))?
-            .collect::<std::result::Result<Vec<_>, _>>()?;
-
-        drop(stmt);
-        drop(conn);
-
-        // Sum memory for all keys
-        let mut total: u64 = 0;
-        for key_id in key_ids {
-            total += self.calculate_key_memory(key_id)?;
-        }
+        Self::memory_usage(&conn, self.selected_db)
+    }
 
-        Ok(total)
+    /// Sum of `key_memory` over every key of `db`, in one query
+    fn memory_usage(conn: &Connection, db: i32) -> Result<u64> {
+        let total: i64 = conn.query_row(
+            "SELECT
+                 (SELECT COALESCE(SUM(length(key)), 0) + COUNT(*) * ?2 FROM keys WHERE db = ?1)
+               + (SELECT COALESCE(SUM(length(v.value)), 0)
+                    FROM strings v JOIN keys k ON k.id = v.key_id WHERE k.db = ?1)
+               + (SELECT COALESCE(SUM(length(v.field) + length(v.value)), 0)
+                    FROM hashes v JOIN keys k ON k.id = v.key_id WHERE k.db = ?1)
+               + (SELECT COALESCE(SUM(length(v.value)), 0)
+                    FROM lists v JOIN keys k ON k.id = v.key_id WHERE k.db = ?1)
+               + (SELECT COALESCE(SUM(length(v.member)), 0)
+                    FROM sets v JOIN keys k ON k.id = v.key_id WHERE k.db = ?1)
+               + (SELECT COALESCE(SUM(length(v.member) + 8), 0)
+                    FROM zsets v JOIN keys k ON k.id = v.key_id WHERE k.db = ?1)
+               + (SELECT COALESCE(SUM(length(v.data)), 0)
+                    FROM streams v JOIN keys k ON k.id = v.key_id WHERE k.db = ?1)",
+            params![db, KEY_MEMORY_OVERHEAD as i64],
+            |row| row.get(0),
+        )?;
+        Ok(total.max(0) as u64)
     }
 
     /// GET key
@@ -1284,11 +1653,11 @@ impl Db {
         let now = Self::now_ms();
 
         // First check if the key exists and get its type
-        let key_info: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
-            "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
-            params![db, key],
-            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
-        );
+        let key_info: std::result::Result<(i64, i32, Option<i64>), _> = conn
+            .prepare_cached("SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2")?
+            .query_row(params![db, key], |row| {
+                Ok((row.get(0)?, row.get(1)?, row.get(2)?))
+            });
 
         match key_info {
             Ok((key_id, key_type, expire_at)) => {
@@ -1311,11 +1680,9 @@ impl Db {
                 self.track_access(key_id);
 
                 // Get the string value
-                let result: std::result::Result<Vec<u8>, _> = conn.query_row(
-                    "SELECT value FROM strings WHERE key_id = ?1",
-                    params![key_id],
-                    |row| row.get(0),
-                );
+                let result: std::result::Result<Vec<u8>, _> = conn
+                    .prepare_cached("SELECT value FROM strings WHERE key_id = ?1")?
+                    .query_row(params![key_id], |row| row.get(0));
 
                 match result {
                     Ok(value) => Ok(Some(value)),
@@ -1351,12 +1718,11 @@ impl Db {
 
         // Check NX/XX conditions
         let exists: bool = conn
-            .query_row(
+            .prepare_cached(
                 "SELECT 1 FROM keys WHERE db = ?1 AND key = ?2
                  AND (expire_at IS NULL OR expire_at > ?3)",
-                params![db, key, now],
-                |_| Ok(true),
-            )
+            )?
+            .query_row(params![db, key, now], |_| Ok(true))
             .unwrap_or(false);
 
         if opts.nx && exists {
@@ -1367,7 +1733,7 @@ impl Db {
         }
 
         // Upsert key (increment version on every write for WATCH/UNWATCH support)
-        conn.execute(
+        conn.prepare_cached(
             "INSERT INTO keys (db, key, type, expire_at, updated_at, version)
              VALUES (?1, ?2, ?3, ?4, ?5, 1)
              ON CONFLICT(db, key) DO UPDATE SET
@@ -1375,22 +1741,20 @@ impl Db {
                  expire_at = excluded.expire_at,
                  updated_at = excluded.updated_at,
                  version = version + 1",
-            params![db, key, KeyType::String as i32, expire_at, now],
-        )?;
+        )?
+        .execute(params![db, key, KeyType::String as i32, expire_at, now])?;
 
         // Get key_id
-        let key_id: i64 = conn.query_row(
-            "SELECT id FROM keys WHERE db = ?1 AND key = ?2",
-            params![db, key],
-            |row| row.get(0),
-        )?;
+        let key_id: i64 = conn
+            .prepare_cached("SELECT id FROM keys WHERE db = ?1 AND key = ?2")?
+            .query_row(params![db, key], |row| row.get(0))?;
 
         // Upsert value
-        conn.execute(
+        conn.prepare_cached(
             "INSERT INTO strings (key_id, value) VALUES (?1, ?2)
              ON CONFLICT(key_id) DO UPDATE SET value = excluded.value",
-            params![key_id, value],
-        )?;
+        )?
+        .execute(params![key_id, value])?;
 
         // Release connection before recording history
         drop(conn);
@@ -1614,6 +1978,30 @@ impl Db {
         Ok(version)
     }
 
+    /// Get (version, created_at) of a live key for client-side cache validation.
+    /// Returns None if the key doesn't exist or is expired. Unlike `version`
+    /// alone, the pair also changes when a key is deleted and recreated.
+    pub fn key_version(&self, key: &str) -> Result<Option<(u64, i64)>> {
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        let db = self.selected_db;
+        let now = Self::now_ms();
+
+        let result = conn.query_row(
+            "SELECT version, created_at FROM keys
+             WHERE db = ?1 AND key = ?2
+             AND (expire_at IS NULL OR expire_at > ?3)",
+            params![db, key, now],
+            // created_at defaults to a subsecond REAL expression, so read it as f64
+            |row| Ok((row.get::<_, i64>(0)? as u64, row.get::<_, f64>(1)? as i64)),
+        );
+
+        match result {
+            Ok(v) => Ok(Some(v)),
+            Err(rusqlite::Error::QueryReturnedNoRows) => Ok(None),
+            Err(e) => Err(e.into()),
+        }
+    }
+
     /// EXPIRE key seconds - set TTL on key
     pub fn expire(&self, key: &str, seconds: i64) -> Result<bool> {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
@@ -1621,13 +2009,14 @@ impl Db {
         let now = Self::now_ms();
         let expire_at = now + (seconds * 1000);
 
-        let count = conn.execute(
-            "UPDATE keys
+        let count = conn
+            .prepare_cached(
+                "UPDATE keys
              SET expire_at = ?1, updated_at = ?2
              WHERE db = ?3 AND key = ?4
              AND (expire_at IS NULL OR expire_at > ?2)",
-            params![expire_at, now, db, key],
-        )?;
+            )?
+            .execute(params![expire_at, now, db, key])?;
 
         Ok(count > 0)
     }
@@ -2003,7 +2392,7 @@ impl Db {
             |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
         );
 
-        let (key_id, data) = match key_info {
+        let key_id = match key_info {
             Ok((key_id, key_type, expire_at)) => {
                 // Check expiration
                 if let Some(exp) = expire_at {
@@ -2013,32 +2402,23 @@ impl Db {
                         conn.execute("DELETE FROM keys WHERE id = ?1", params![key_id])?;
                         // Create fresh key while still holding lock
                         let new_key_id = self.create_string_key(&conn, key, now)?;
-                        return self.setbit_inner(&conn, new_key_id, byte_index, bit_index, value, vec![]);
+                        return self.setbit_inner(&conn, new_key_id, byte_index, bit_index, value);
                     }
                 }
                 // Check type
                 if key_type != KeyType::String as i32 {
                     return Err(KvError::WrongType);
                 }
-                // Get current value
-                let data: Vec<u8> = conn
-                    .query_row(
-                        "SELECT value FROM strings WHERE key_id = ?1",
-                        params![key_id],
-                        |row| row.get(0),
-                    )
-                    .unwrap_or_default();
-                (key_id, data)
+                key_id
             }
             Err(rusqlite::Error::QueryReturnedNoRows) => {
                 // Create new key
-                let key_id = self.create_string_key(&conn, key, now)?;
-                (key_id, vec![])
+                self.create_string_key(&conn, key, now)?
             }
             Err(e) => return Err(e.into()),
         };
 
-        self.setbit_inner(&conn, key_id, byte_index, bit_index, value, data)
+        self.setbit_inner(&conn, key_id, byte_index, bit_index, value)
     }
 
     fn create_string_key(&self, conn: &Connection, key: &str, now: i64) -> Result<i64> {
@@ -2066,28 +2446,44 @@ impl Db {
         byte_index: usize,
         bit_index: u8,
         value: bool,
-        mut data: Vec<u8>,
     ) -> Result<i64> {
-        // Expand if needed
-        if byte_index >= data.len() {
-            data.resize(byte_index + 1, 0);
-        }
-
-        // Get old bit value
-        let old_bit = (data[byte_index] >> bit_index) & 1;
-
-        // Set new bit value
-        if value {
-            data[byte_index] |= 1 << bit_index;
+        let mask = 1u8 << bit_index;
+        let mut blob = conn.blob_open(DatabaseName::Main, "strings", "value", key_id, false)?;
+
+        let old_bit = if byte_index < blob.len() {
+            // Patch the one byte in place instead of rewriting the whole value
+            let mut byte = [0u8; 1];
+            blob.read_at_exact(&mut byte, byte_index)?;
+            let old = byte[0];
+            if value {
+                byte[0] |= mask;
+            } else {
+                byte[0] &= !mask;
+            }
+            if byte[0] != old {
+                blob.write_at(&byte, byte_index)?;
+            }
+            (old >> bit_index) & 1
         } else {
-            data[byte_index] &= !(1 << bit_index);
-        }
-
-        // Save updated value
-        conn.execute(
-            "UPDATE strings SET value = ?1 WHERE key_id = ?2",
-            params![data, key_id],
-        )?;
+            // Growing changes the row size, so the value is rewritten once
+            drop(blob);
+            let mut data: Vec<u8> = conn
+                .query_row(
+                    "SELECT value FROM strings WHERE key_id = ?1",
+                    params![key_id],
+                    |row| row.get(0),
+                )
+                .unwrap_or_default();
+            data.resize(byte_index + 1, 0);
+            if value {
+                data[byte_index] |= mask;
+            }
+            conn.execute(
+                "UPDATE strings SET value = ?1 WHERE key_id = ?2",
+                params![data, key_id],
+            )?;
+            0
+        };
 
         // Update timestamp
         let now = Self::now_ms();
@@ -2126,20 +2522,15 @@ impl Db {
                 if key_type != KeyType::String as i32 {
                     return Err(KvError::WrongType);
                 }
-                // Get value
-                let data: Vec<u8> = conn
-                    .query_row(
-                        "SELECT value FROM strings WHERE key_id = ?1",
-                        params![key_id],
-                        |row| row.get(0),
-                    )
-                    .unwrap_or_default();
-
-                if byte_index >= data.len() {
+                // Read just the one byte; large bitmaps are never loaded whole
+                let blob = conn.blob_open(DatabaseName::Main, "strings", "value", key_id, true)?;
+                if byte_index >= blob.len() {
                     return Ok(0);
                 }
+                let mut byte = [0u8; 1];
+                blob.read_at_exact(&mut byte, byte_index)?;
 
-                Ok(((data[byte_index] >> bit_index) & 1) as i64)
+                Ok(((byte[0] >> bit_index) & 1) as i64)
             }
             Err(rusqlite::Error::QueryReturnedNoRows) => Ok(0),
             Err(e) => Err(e.into()),
@@ -2170,37 +2561,22 @@ impl Db {
                 if key_type != KeyType::String as i32 {
                     return Err(KvError::WrongType);
                 }
-                // Get value
-                let data: Vec<u8> = conn
+                // Count in SQLite's buffer instead of copying the value out
+                let count = conn
                     .query_row(
                         "SELECT value FROM strings WHERE key_id = ?1",
                         params![key_id],
-                        |row| row.get(0),
+                        |row| {
+                            Ok(match row.get_ref(0)? {
+                                ValueRef::Blob(data) | ValueRef::Text(data) => {
+                                    Self::bitcount_range(data, start, end)
+                                }
+                                _ => 0,
+                            })
+                        },
                     )
-                    .unwrap_or_default();
-
-                if data.is_empty() {
-                    return Ok(0);
-                }
-
-                let len = data.len() as i64;
-                let (start_idx, end_idx) = match (start, end) {
-                    (Some(s), Some(e)) => {
-                        let s = if s < 0 { (len + s).max(0) } else { s.min(len) };
-                        let e = if e < 0 { (len + e).max(-1) } else { e.min(len - 1) };
-                        (s as usize, (e + 1) as usize)
-                    }
-                    _ => (0, data.len()),
-                };
-
-                if start_idx >= end_idx || start_idx >= data.len() {
-                    return Ok(0);
-                }
-
-                let count: i64 = data[start_idx..end_idx.min(data.len())]
-                    .iter()
-                    .map(|b| b.count_ones() as i64)
-                    .sum();
+                    .optional()?
+                    .unwrap_or(0);
 
                 Ok(count)
             }
@@ -2209,105 +2585,109 @@ impl Db {
         }
     }
 
+    /// Set bits in the byte range `start..=end` (negative offsets count from the end)
+    fn bitcount_range(data: &[u8], start: Option<i64>, end: Option<i64>) -> i64 {
+        let len = data.len() as i64;
+        if len == 0 {
+            return 0;
+        }
+        let (start_idx, end_idx) = match (start, end) {
+            (Some(s), Some(e)) => {
+                let s = if s < 0 { (len + s).max(0) } else { s.min(len) };
+                let e = if e < 0 {
+                    (len + e).max(-1)
+                } else {
+                    e.min(len - 1)
+                };
+                (s as usize, (e + 1) as usize)
+            }
+            _ => (0, data.len()),
+        };
+        if start_idx >= end_idx || start_idx >= data.len() {
+            return 0;
+        }
+        bitmap::popcount(&data[start_idx..end_idx.min(data.len())]) as i64
+    }
+
     /// BITOP operation destkey key [key ...] - Perform bitwise operation
     pub fn bitop(&self, op: &str, destkey: &str, keys: &[&str]) -> Result<i64> {
         if keys.is_empty() {
             return Err(KvError::InvalidArgument("BITOP requires at least one source key".into()));
         }
 
+        let op = match op.to_uppercase().as_str() {
+            "AND" => Some(BitOp::And),
+            "OR" => Some(BitOp::Or),
+            "XOR" => Some(BitOp::Xor),
+            "NOT" if keys.len() == 1 => None,
+            "NOT" => {
+                return Err(KvError::InvalidArgument(
+                    "BITOP NOT requires exactly one source key".into(),
+                ))
+            }
+            _ => {
+                return Err(KvError::InvalidArgument(format!(
+                    "Unknown BITOP operation: {}",
+                    op
+                )))
+            }
+        };
+
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
         let db = self.selected_db;
         let now = Self::now_ms();
 
-        // Get all source values
-        let mut values: Vec<Vec<u8>> = Vec::with_capacity(keys.len());
-        let mut max_len = 0usize;
-
+        // Fold each source into the result as it is read, so only one copy of
+        // a bitmap is ever held (missing and expired keys count as empty)
+        let mut result: Option<Vec<u8>> = None;
         for key in keys {
-            let key_info: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
-                "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
-                params![db, key],
-                |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
-            );
-
-            let data = match key_info {
-                Ok((key_id, key_type, expire_at)) => {
-                    if let Some(exp) = expire_at {
-                        if exp <= now {
-                            vec![]
-                        } else if key_type != KeyType::String as i32 {
-                            return Err(KvError::WrongType);
-                        } else {
-                            conn.query_row(
-                                "SELECT value FROM strings WHERE key_id = ?1",
-                                params![key_id],
-                                |row| row.get(0),
-                            )
-                            .unwrap_or_default()
-                        }
-                    } else if key_type != KeyType::String as i32 {
-                        return Err(KvError::WrongType);
-                    } else {
-                        conn.query_row(
-                            "SELECT value FROM strings WHERE key_id = ?1",
-                            params![key_id],
-                            |row| row.get(0),
-                        )
-                        .unwrap_or_default()
-                    }
+            let key_info: Option<(i64, i32, Option<i64>)> = conn
+                .query_row(
+                    "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
+                    params![db, key],
+                    |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
+                )
+                .optional()?;
+
+            let key_id = match key_info {
+                Some((_, _, Some(exp))) if exp <= now => None,
+                Some((_, key_type, _)) if key_type != KeyType::String as i32 => {
+                    return Err(KvError::WrongType)
                 }
-                Err(rusqlite::Error::QueryReturnedNoRows) => vec![],
-                Err(e) => return Err(e.into()),
+                Some((key_id, _, _)) => Some(key_id),
+                None => None,
             };
-            max_len = max_len.max(data.len());
-            values.push(data);
-        }
 
-        // NOT operation only takes one key
-        let op_upper = op.to_uppercase();
-        if op_upper == "NOT" && keys.len() != 1 {
-            return Err(KvError::InvalidArgument(
-                "BITOP NOT requires exactly one source key".into(),
-            ));
+            let mut fold = |data: &[u8]| match (result.as_mut(), op) {
+                (Some(acc), Some(op)) => bitmap::combine(op, acc, data),
+                _ => result = Some(data.to_vec()),
+            };
+            let found = match key_id {
+                Some(key_id) => conn
+                    .query_row(
+                        "SELECT value FROM strings WHERE key_id = ?1",
+                        params![key_id],
+                        |row| {
+                            match row.get_ref(0)? {
+                                ValueRef::Blob(data) | ValueRef::Text(data) => fold(data),
+                                _ => fold(&[]),
+                            }
+                            Ok(())
+                        },
+                    )
+                    .optional()?
+                    .is_some(),
+                None => false,
+            };
+            if !found {
+                fold(&[]);
+            }
         }
 
-        // Perform operation
-        let result: Vec<u8> = match op_upper.as_str() {
-            "AND" => {
-                let mut result = vec![0xFFu8; max_len];
-                for val in &values {
-                    for (i, byte) in result.iter_mut().enumerate() {
-                        *byte &= val.get(i).copied().unwrap_or(0);
-                    }
-                }
-                result
-            }
-            "OR" => {
-                let mut result = vec![0u8; max_len];
-                for val in &values {
-                    for (i, byte) in result.iter_mut().enumerate() {
-                        *byte |= val.get(i).copied().unwrap_or(0);
-                    }
-                }
-                result
-            }
-            "XOR" => {
-                let mut result = vec![0u8; max_len];
-                for val in &values {
-                    for (i, byte) in result.iter_mut().enumerate() {
-                        *byte ^= val.get(i).copied().unwrap_or(0);
-                    }
-                }
-                result
-            }
-            "NOT" => values[0].iter().map(|b| !b).collect(),
-            _ => {
-                return Err(KvError::InvalidArgument(format!(
-                    "Unknown BITOP operation: {}",
-                    op
-                )))
-            }
-        };
+        let mut result = result.unwrap_or_default();
+        if op.is_none() {
+            bitmap::invert(&mut result);
+        }
 
         let result_len = result.len() as i64;
 
@@ -2533,8 +2913,13 @@ impl Db {
         let db = self.selected_db;
         let now = Self::now_ms();
 
-        // Use a transaction for atomicity
-        conn.execute("BEGIN IMMEDIATE", [])?;
+        // Use a transaction for atomicity (savepoint if the caller already opened one)
+        let nested = !conn.is_autocommit();
+        if nested {
+            conn.execute_batch("SAVEPOINT mset")?;
+        } else {
+            conn.execute("BEGIN IMMEDIATE", [])?;
+        }
 
         let result = (|| -> Result<()> {
             for (key, value) in pairs {
@@ -2569,11 +2954,19 @@ impl Db {
 
         match result {
             Ok(()) => {
-                conn.execute("COMMIT", [])?;
+                if nested {
+                    conn.execute_batch("RELEASE mset")?;
+                } else {
+                    conn.execute("COMMIT", [])?;
+                }
                 Ok(())
             }
             Err(e) => {
-                let _ = conn.execute("ROLLBACK", []);
+                if nested {
+                    let _ = conn.execute_batch("ROLLBACK TO mset; RELEASE mset");
+                } else {
+                    let _ = conn.execute("ROLLBACK", []);
+                }
                 Err(e)
             }
         }
@@ -3002,11 +3395,11 @@ impl Db {
         let now = Self::now_ms();
 
         // Check if key exists and is correct type
-        let existing: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
-            "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
-            params![db, key],
-            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
-        );
+        let existing: std::result::Result<(i64, i32, Option<i64>), _> = conn
+            .prepare_cached("SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2")?
+            .query_row(params![db, key], |row| {
+                Ok((row.get(0)?, row.get(1)?, row.get(2)?))
+            });
 
         match existing {
             Ok((key_id, key_type, expire_at)) => {
@@ -3014,7 +3407,8 @@ impl Db {
                 if let Some(exp) = expire_at {
                     if exp <= now {
                         // Expired - delete and create new
-                        conn.execute("DELETE FROM keys WHERE id = ?1", params![key_id])?;
+                        conn.prepare_cached("DELETE FROM keys WHERE id = ?1")?
+                            .execute(params![key_id])?;
                         return self.create_hash_key(conn, key);
                     }
                 }
@@ -3033,10 +3427,10 @@ impl Db {
         let db = self.selected_db;
         let now = Self::now_ms();
 
-        conn.execute(
+        conn.prepare_cached(
             "INSERT INTO keys (db, key, type, updated_at, version) VALUES (?1, ?2, ?3, ?4, 1)",
-            params![db, key, KeyType::Hash as i32, now],
-        )?;
+        )?
+        .execute(params![db, key, KeyType::Hash as i32, now])?;
 
         Ok(conn.last_insert_rowid())
     }
@@ -3046,11 +3440,11 @@ impl Db {
         let db = self.selected_db;
         let now = Self::now_ms();
 
-        let result: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
-            "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
-            params![db, key],
-            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
-        );
+        let result: std::result::Result<(i64, i32, Option<i64>), _> = conn
+            .prepare_cached("SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2")?
+            .query_row(params![db, key], |row| {
+                Ok((row.get(0)?, row.get(1)?, row.get(2)?))
+            });
 
         match result {
             Ok((key_id, key_type, expire_at)) => {
@@ -3072,149 +3466,881 @@ impl Db {
     }
 
     // ========================================================================
-    // JSON Helpers (Session 51)
+    // Bulk Load
     // ========================================================================
 
-    /// Normalize a path to JSONPath format.
-    /// Supports: "$", ".", "$.foo.bar", ".foo.bar"
-    fn normalize_json_path(path: &str) -> String {
-        let path = path.trim();
-        if path.is_empty() || path == "$" || path == "." {
-            return "$".to_string();
-        }
-        if path.starts_with("$.") {
-            return path.to_string();
+    /// Secondary indexes that are not needed while loading. They can be
+    /// dropped by `bulk_begin` and are rebuilt in one pass by `bulk_finish`.
+    /// `idx_keys_db_key` stays: every key lookup and upsert relies on it.
+    const BULK_DEFERRED_INDEXES: &'static [(&'static str, &'static str)] = &[
+        (
+            "idx_keys_type",
+            "CREATE INDEX IF NOT EXISTS idx_keys_type ON keys(db, type)",
+        ),
+        (
+            "idx_keys_last_accessed",
+            "CREATE INDEX IF NOT EXISTS idx_keys_last_accessed ON keys(last_accessed)",
+        ),
+        (
+            "idx_keys_access_count",
+            "CREATE INDEX IF NOT EXISTS idx_keys_access_count ON keys(access_count)",
+        ),
+        (
+            "idx_keys_expire",
+            "CREATE INDEX IF NOT EXISTS idx_keys_expire ON keys(expire_at) WHERE expire_at IS NOT NULL",
+        ),
+        (
+            "idx_zsets_score",
+            "CREATE INDEX IF NOT EXISTS idx_zsets_score ON zsets(key_id, score, member)",
+        ),
+    ];
+
+    /// Start a bulk load. With `defer_indexes`, drops the secondary indexes
+    /// in `BULK_DEFERRED_INDEXES`; queries stay correct but slower until
+    /// `bulk_finish` rebuilds them.
+    pub fn bulk_begin(&self, defer_indexes: bool) -> Result<()> {
+        if !defer_indexes {
+            return Ok(());
         }
-        if path.starts_with('.') {
-            return format!("${}", path);
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        for (name, _) in Self::BULK_DEFERRED_INDEXES {
+            conn.execute_batch(&format!("DROP INDEX IF EXISTS {}", name))?;
         }
-        // Assume it's a field name without prefix
-        format!("$.{}", path)
+        Ok(())
     }
 
-    /// Parse a JSONPath string, returning an error if invalid
-    fn parse_json_path(path: &str) -> Result<JsonPath> {
-        let normalized = Self::normalize_json_path(path);
-        JsonPath::parse(&normalized).map_err(|_| KvError::SyntaxError)
-    }
+    /// Load a batch of records in a single transaction with cached statements.
+    ///
+    /// Records upsert like SET/HSET/SADD/ZADD, but skip history recording and
+    /// per-command eviction checks, and each key is looked up once per batch.
+    /// A record for a key of another type fails the batch with WrongType,
+    /// except strings, which replace the key like SET. With `defer_fts`,
+    /// full-text indexing is left to `bulk_finish`.
+    /// Returns the number of records loaded.
+    pub fn bulk_load(&self, records: &[BulkRecord], defer_fts: bool) -> Result<usize> {
+        if records.is_empty() {
+            return Ok(0);
+        }
 
-    fn create_json_key(&self, conn: &Connection, key: &str) -> Result<i64> {
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
         let db = self.selected_db;
         let now = Self::now_ms();
 
-        conn.execute(
-            "INSERT INTO keys (db, key, type, updated_at, version) VALUES (?1, ?2, ?3, ?4, 1)",
-            params![db, key, KeyType::Json as i32, now],
-        )?;
-
-        Ok(conn.last_insert_rowid())
-    }
+        let key_ids = Self::in_savepoint(&conn, || {
+            let mut lookup =
+                conn.prepare_cached("SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2")?;
+            let mut create = conn.prepare_cached(
+                "INSERT INTO keys (db, key, type, expire_at, updated_at, version)
+                 VALUES (?1, ?2, ?3, ?4, ?5, 1)",
+            )?;
+            let mut touch = conn.prepare_cached(
+                "UPDATE keys SET updated_at = ?1, version = version + 1 WHERE id = ?2",
+            )?;
+            let mut set_expire = conn.prepare_cached("UPDATE keys SET expire_at = ?1 WHERE id = ?2")?;
+            let mut remove = conn.prepare_cached("DELETE FROM keys WHERE id = ?1")?;
+            let mut put_string = conn.prepare_cached(
+                "INSERT INTO strings (key_id, value) VALUES (?1, ?2)
+                 ON CONFLICT(key_id) DO UPDATE SET value = excluded.value",
+            )?;
+            let mut put_hash = conn.prepare_cached(
+                "INSERT INTO hashes (key_id, field, value) VALUES (?1, ?2, ?3)
+                 ON CONFLICT(key_id, field) DO UPDATE SET value = excluded.value",
+            )?;
+            let mut put_set =
+                conn.prepare_cached("INSERT OR IGNORE INTO sets (key_id, member) VALUES (?1, ?2)")?;
+            let mut put_zset = conn.prepare_cached(
+                "INSERT INTO zsets (key_id, member, score) VALUES (?1, ?2, ?3)
+                 ON CONFLICT(key_id, member) DO UPDATE SET score = excluded.score",
+            )?;
 
-    fn get_or_create_json_key(&self, conn: &Connection, key: &str) -> Result<i64> {
-        let db = self.selected_db;
-        let now = Self::now_ms();
+            // key -> (key_id, type) for keys already resolved in this batch
+            let mut key_ids: HashMap<&str, (i64, i32)> = HashMap::new();
+            for record in records {
+                let key = record.key();
+                let key_type = record.key_type() as i32;
+                let expire_at = match record {
+                    BulkRecord::String { ttl, .. } => ttl.map(|d| now + d.as_millis() as i64),
+                    _ => None,
+                };
 
-        // Check if key exists and is correct type
-        let existing: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
-            "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
-            params![db, key],
-            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
-        );
+                let cached = key_ids.get(key).copied();
+                let (key_id, created) = match cached {
+                    Some((id, t)) if t == key_type => (id, false),
+                    _ => {
+                        let existing: Option<(i64, i32, Option<i64>)> = match cached {
+                            Some((id, t)) => Some((id, t, None)),
+                            None => lookup
+                                .query_row(params![db, key], |row| {
+                                    Ok((row.get(0)?, row.get(1)?, row.get(2)?))
+                                })
+                                .optional()?,
+                        };
+                        let resolved = match existing {
+                            Some((id, t, exp)) if t == key_type && exp.map_or(true, |e| e > now) => {
+                                touch.execute(params![now, id])?;
+                                (id, false)
+                            }
+                            Some((id, _, exp))
+                                if key_type == KeyType::String as i32
+                                    || exp.map_or(false, |e| e <= now) =>
+                            {
+                                remove.execute(params![id])?;
+                                create.execute(params![db, key, key_type, expire_at, now])?;
+                                (conn.last_insert_rowid(), true)
+                            }
+                            Some(_) => return Err(KvError::WrongType),
+                            None => {
+                                create.execute(params![db, key, key_type, expire_at, now])?;
+                                (conn.last_insert_rowid(), true)
+                            }
+                        };
+                        key_ids.insert(key, (resolved.0, key_type));
+                        resolved
+                    }
+                };
 
-        match existing {
-            Ok((key_id, key_type, expire_at)) => {
-                // Check expiration
-                if let Some(exp) = expire_at {
-                    if exp <= now {
-                        // Expired - delete and create new
-                        conn.execute("DELETE FROM keys WHERE id = ?1", params![key_id])?;
-                        return self.create_json_key(conn, key);
+                match *record {
+                    BulkRecord::String { value, .. } => {
+                        // SET replaces any previous TTL
+                        if !created {
+                            set_expire.execute(params![expire_at, key_id])?;
+                        }
+                        put_string.execute(params![key_id, value])?;
+                    }
+                    BulkRecord::Hash { field, value, .. } => {
+                        put_hash.execute(params![key_id, field, value])?;
+                    }
+                    BulkRecord::Set { member, .. } => {
+                        put_set.execute(params![key_id, member])?;
+                    }
+                    BulkRecord::ZSet { member, score, .. } => {
+                        put_zset.execute(params![key_id, member, score])?;
                     }
                 }
-                // Check type
-                if key_type != KeyType::Json as i32 {
-                    return Err(KvError::WrongType);
+            }
+            Ok(key_ids
+                .into_iter()
+                .map(|(key, (id, t))| (key, id, t))
+                .collect::<Vec<_>>())
+        })?;
+
+        let (fts_settings, ft_indexes) = if defer_fts {
+            (false, false)
+        } else {
+            Self::bulk_fts_targets(&conn)?
+        };
+
+        // Release connection before auto-indexing
+        drop(conn);
+
+        for (key, key_id, key_type) in key_ids {
+            if key_type == KeyType::String as i32 && fts_settings {
+                if let Ok(Some(value)) = self.get(key) {
+                    let _ = self.fts_index(key, &value);
                 }
-                Ok(key_id)
+            } else if key_type == KeyType::Hash as i32 && ft_indexes {
+                let _ = self.ft_index_document(key, key_id);
             }
-            Err(rusqlite::Error::QueryReturnedNoRows) => self.create_json_key(conn, key),
-            Err(e) => Err(e.into()),
         }
+
+        self.maybe_evict();
+
+        Ok(records.len())
     }
 
-    /// Helper to get JSON key_id if it exists and is not expired
-    fn get_json_key_id(&self, conn: &Connection, key: &str) -> Result<Option<i64>> {
-        let db = self.selected_db;
-        let now = Self::now_ms();
+    /// Finish a bulk load: rebuild any secondary index dropped by
+    /// `bulk_begin` and, with `reindex_fts`, index every string and hash in
+    /// the current database for full-text search (for loads run with
+    /// `defer_fts`). Safe to call when nothing was deferred.
+    pub fn bulk_finish(&self, reindex_fts: bool) -> Result<()> {
+        {
+            let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+            for (_, create) in Self::BULK_DEFERRED_INDEXES {
+                conn.execute_batch(create)?;
+            }
+        }
 
-        let result: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
-            "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
-            params![db, key],
-            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
-        );
+        if !reindex_fts {
+            return Ok(());
+        }
 
-        match result {
-            Ok((key_id, key_type, expire_at)) => {
-                // Check expiration
-                if let Some(exp) = expire_at {
-                    if exp <= now {
-                        return Ok(None);
+        // Skip the scan entirely when no FTS setting or FT index exists
+        let (keys, fts_settings, ft_indexes) = {
+            let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+            let (fts_settings, ft_indexes) = Self::bulk_fts_targets(&conn)?;
+            if !fts_settings && !ft_indexes {
+                return Ok(());
+            }
+
+            let mut stmt =
+                conn.prepare("SELECT id, key, type FROM keys WHERE db = ?1 AND type IN (?2, ?3)")?;
+            let keys: Vec<(i64, String, i32)> = stmt
+                .query_map(
+                    params![self.selected_db, KeyType::String as i32, KeyType::Hash as i32],
+                    |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
+                )?
+                .collect::<std::result::Result<_, _>>()?;
+            (keys, fts_settings, ft_indexes)
+        };
+
+        for (key_id, key, key_type) in keys {
+            if key_type == KeyType::String as i32 {
+                if fts_settings {
+                    if let Some(value) = self.get(&key)? {
+                        self.fts_index(&key, &value)?;
                     }
                 }
-                // Check type
-                if key_type != KeyType::Json as i32 {
-                    return Err(KvError::WrongType);
-                }
-                Ok(Some(key_id))
+            } else if ft_indexes {
+                self.ft_index_document(&key, key_id)?;
             }
-            Err(rusqlite::Error::QueryReturnedNoRows) => Ok(None),
-            Err(e) => Err(e.into()),
         }
+        Ok(())
+    }
+
+    /// Helper: whether any FTS setting is enabled and any FT.CREATE index
+    /// exists, so bulk loads skip per-key FTS checks when neither is in use
+    fn bulk_fts_targets(conn: &Connection) -> Result<(bool, bool)> {
+        let fts_settings: bool = conn.query_row(
+            "SELECT EXISTS(SELECT 1 FROM fts_settings WHERE enabled = 1)",
+            [],
+            |row| row.get(0),
+        )?;
+        let ft_indexes: bool =
+            conn.query_row("SELECT EXISTS(SELECT 1 FROM ft_indexes)", [], |row| row.get(0))?;
+        Ok((fts_settings, ft_indexes))
     }
 
     // ========================================================================
-    // JSON Commands (Session 51)
+    // Snapshots
     // ========================================================================
 
-    /// JSON.SET key path value [NX|XX] - set JSON value at path
-    /// Returns Ok(true) if set, Ok(false) if NX/XX condition not met
-    pub fn json_set(&self, key: &str, path: &str, value: &str, nx: bool, xx: bool) -> Result<bool> {
-        // Parse the value as JSON
-        let new_value: JsonValue = serde_json::from_str(value)
-            .map_err(|_| KvError::SyntaxError)?;
-
-        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
-        let now = Self::now_ms();
-        let normalized_path = Self::normalize_json_path(path);
-
-        // Check if key exists
-        let existing_key_id = self.get_json_key_id(&conn, key)?;
-
-        // Handle NX/XX conditions
-        if nx && existing_key_id.is_some() && normalized_path == "$" {
-            // NX: only set if key doesn't exist (for root path)
-            // For root, check if doc exists
-            if let Some(kid) = existing_key_id {
-                let doc_exists: bool = conn
-                    .query_row(
-                        "SELECT 1 FROM json_docs WHERE key_id = ?1",
-                        params![kid],
-                        |_| Ok(true),
-                    )
-                    .unwrap_or(false);
-                if doc_exists {
-                    return Ok(false);
-                }
+    /// Write every live key of every database to a snapshot file (format in
+    /// `snapshot.rs`), all read from one transaction so the snapshot is
+    /// consistent.
+    ///
+    /// File databases are read through a second, read-only connection, so
+    /// writers are not blocked while it streams out. In-memory databases,
+    /// and files that connection can't read (encrypted or compressed ones),
+    /// hold this connection for the export instead. Memory use is one frame
+    /// (about 1 MB) plus the largest value. The file is written to
+    /// `<path>.tmp`, synced and renamed over `path` when complete.
+    ///
+    /// Strings, hashes, lists, sets, sorted sets (with geo coordinates),
+    /// streams and JSON documents are included with their TTLs. Stream
+    /// consumer groups, vector sets, history and FT index definitions are not.
+    pub fn export_snapshot(&self, path: &str) -> Result<SnapshotStats> {
+        let tmp = format!("{}.tmp", path);
+        let written = match self.snapshot_reader() {
+            Some(reader) => Self::write_snapshot(&reader, &tmp),
+            None => {
+                let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+                Self::write_snapshot(&conn, &tmp)
+            }
+        };
+        match written {
+            Ok(stats) => {
+                std::fs::rename(&tmp, path)?;
+                Ok(stats)
+            }
+            Err(e) => {
+                let _ = std::fs::remove_file(&tmp);
+                Err(e)
             }
         }
+    }
 
-        if xx && existing_key_id.is_none() {
-            // XX: only set if key exists
-            return Ok(false);
+    /// A separate read-only connection to this database's file, or None for
+    /// in-memory databases and files it cannot read
+    fn snapshot_reader(&self) -> Option<Connection> {
+        if self.core.is_memory_db {
+            return None;
         }
-
-        if normalized_path == "$" {
-            // Setting root - replace entire document
+        let path = {
+            let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+            conn.path().filter(|p| !p.is_empty())?.to_string()
+        };
+        let reader = Connection::open_with_flags(
+            &path,
+            rusqlite::OpenFlags::SQLITE_OPEN_READ_ONLY | rusqlite::OpenFlags::SQLITE_OPEN_NO_MUTEX,
+        )
+        .ok()?;
+        reader.busy_timeout(Duration::from_secs(5)).ok()?;
+        reader
+            .query_row("SELECT COUNT(*) FROM keys", [], |row| row.get::<_, i64>(0))
+            .ok()?;
+        Some(reader)
+    }
+
+    /// Count and item queries of one key type in a snapshot
+    fn snapshot_queries(key_type: KeyType) -> (&'static str, &'static str) {
+        match key_type {
+            KeyType::String => (
+                "SELECT COUNT(*) FROM strings WHERE key_id = ?1",
+                "SELECT value FROM strings WHERE key_id = ?1",
+            ),
+            KeyType::Hash => (
+                "SELECT COUNT(*) FROM hashes WHERE key_id = ?1",
+                "SELECT field, value FROM hashes WHERE key_id = ?1",
+            ),
+            KeyType::List => (
+                "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
+                "SELECT pos, value FROM lists WHERE key_id = ?1 ORDER BY pos",
+            ),
+            KeyType::Set => (
+                "SELECT COUNT(*) FROM sets WHERE key_id = ?1",
+                "SELECT member FROM sets WHERE key_id = ?1",
+            ),
+            KeyType::ZSet => (
+                "SELECT COUNT(*) FROM zsets WHERE key_id = ?1",
+                "SELECT score, member FROM zsets WHERE key_id = ?1",
+            ),
+            KeyType::Stream => (
+                "SELECT COUNT(*) FROM streams WHERE key_id = ?1",
+                "SELECT entry_ms, entry_seq, data FROM streams WHERE key_id = ?1
+                 ORDER BY entry_ms, entry_seq",
+            ),
+            KeyType::Json => (
+                "SELECT COUNT(*) FROM json_docs WHERE key_id = ?1",
+                "SELECT value FROM json_docs WHERE key_id = ?1",
+            ),
+        }
+    }
+
+    /// Raw bytes of a text or blob column, as stored
+    fn column_bytes<'r>(row: &'r rusqlite::Row, idx: usize) -> Result<&'r [u8]> {
+        match row.get_ref(idx)? {
+            ValueRef::Blob(b) | ValueRef::Text(b) => Ok(b),
+            ValueRef::Null => Ok(&[]),
+            _ => Err(KvError::InvalidData),
+        }
+    }
+
+    fn write_snapshot(conn: &Connection, path: &str) -> Result<SnapshotStats> {
+        let now = Self::now_ms();
+        let file = std::fs::File::create(path)?;
+        let mut out = snapshot::Writer::new(std::io::BufWriter::new(file), now)?;
+        let mut stats = SnapshotStats::default();
+
+        // Inside a caller's transaction, its view is already consistent
+        let own_tx = conn.is_autocommit();
+        if own_tx {
+            conn.execute_batch("BEGIN")?;
+        }
+        let streamed = (|| -> Result<()> {
+            let mut keys = conn.prepare(
+                "SELECT id, db, key, type, expire_at FROM keys
+                 WHERE expire_at IS NULL OR expire_at > ?1 ORDER BY id",
+            )?;
+            let mut rows = keys.query(params![now])?;
+            while let Some(row) = rows.next()? {
+                let key_id: i64 = row.get(0)?;
+                let db: i64 = row.get(1)?;
+                let raw_type: i32 = row.get(3)?;
+                let expire_at: Option<i64> = row.get(4)?;
+                let key_type = match KeyType::from_i32(raw_type) {
+                    Some(t) => t,
+                    None => continue,
+                };
+
+                let (count_sql, items_sql) = Self::snapshot_queries(key_type);
+                let count: i64 = conn
+                    .prepare_cached(count_sql)?
+                    .query_row(params![key_id], |r| r.get(0))?;
+                out.u8(snapshot::TAG_KEY)
+                    .u8(raw_type as u8)
+                    .u32(db as u32)
+                    .i64(expire_at.unwrap_or(0))
+                    .blob(Self::column_bytes(row, 2)?)
+                    .u64(count as u64);
+                out.end_item()?;
+
+                let mut items = conn.prepare_cached(items_sql)?;
+                let mut item_rows = items.query(params![key_id])?;
+                while let Some(item) = item_rows.next()? {
+                    match key_type {
+                        KeyType::String | KeyType::Set | KeyType::Json => {
+                            out.blob(Self::column_bytes(item, 0)?);
+                        }
+                        KeyType::Hash => {
+                            out.blob(Self::column_bytes(item, 0)?)
+                                .blob(Self::column_bytes(item, 1)?);
+                        }
+                        KeyType::List => {
+                            out.i64(item.get(0)?).blob(Self::column_bytes(item, 1)?);
+                        }
+                        KeyType::ZSet => {
+                            out.f64(item.get(0)?).blob(Self::column_bytes(item, 1)?);
+                        }
+                        KeyType::Stream => {
+                            out.i64(item.get(0)?)
+                                .i64(item.get(1)?)
+                                .blob(Self::column_bytes(item, 2)?);
+                        }
+                    }
+                    out.end_item()?;
+                    stats.items += 1;
+                }
+
+                #[cfg(feature = "geo")]
+                if key_type == KeyType::ZSet {
+                    let geo_count: i64 = conn
+                        .prepare_cached("SELECT COUNT(*) FROM geo_data WHERE key_id = ?1")?
+                        .query_row(params![key_id], |r| r.get(0))?;
+                    if geo_count > 0 {
+                        out.u8(snapshot::TAG_GEO).u64(geo_count as u64);
+                        out.end_item()?;
+                        let mut geo = conn.prepare_cached(
+                            "SELECT member, longitude, latitude, geohash FROM geo_data
+                             WHERE key_id = ?1",
+                        )?;
+                        let mut geo_rows = geo.query(params![key_id])?;
+                        while let Some(item) = geo_rows.next()? {
+                            out.blob(Self::column_bytes(item, 0)?)
+                                .f64(item.get(1)?)
+                                .f64(item.get(2)?)
+                                .blob(Self::column_bytes(item, 3)?);
+                            out.end_item()?;
+                            stats.items += 1;
+                        }
+                    }
+                }
+                stats.keys += 1;
+            }
+            Ok(())
+        })();
+        if own_tx {
+            let _ = conn.execute_batch("COMMIT");
+        }
+        streamed?;
+
+        let (buffered, bytes) = out.finish(stats.keys)?;
+        buffered
+            .into_inner()
+            .map_err(|e| e.into_error())?
+            .sync_all()?;
+        stats.bytes = bytes;
+        Ok(stats)
+    }
+
+    /// Load a snapshot written by `export_snapshot`. Each key goes back to
+    /// its database number with its TTL and replaces any key of the same
+    /// name; keys that expired since the export are skipped.
+    ///
+    /// Uses the bulk-load path: secondary indexes are dropped for the load
+    /// and rebuilt at the end (with full-text indexes of the selected
+    /// database), and no history is recorded. The file is read one frame at
+    /// a time and each frame's checksum is verified before it is applied.
+    /// The whole load is one write transaction that holds the connection, so
+    /// a corrupt or truncated file leaves the database as it was; SQLite
+    /// spills a large transaction to disk, not memory.
+    pub fn import_snapshot(&self, path: &str) -> Result<SnapshotStats> {
+        let file = std::fs::File::open(path)?;
+        let bytes = file.metadata()?.len();
+        let mut reader = snapshot::Reader::new(std::io::BufReader::new(file))?;
+
+        self.bulk_begin(true)?;
+        let loaded = self.load_snapshot(&mut reader);
+        let finished = self.bulk_finish(loaded.is_ok());
+        let mut stats = loaded?;
+        finished?;
+        stats.bytes = bytes;
+        Ok(stats)
+    }
+
+    /// All of a snapshot in one transaction, or a savepoint inside the
+    /// caller's; rolled back on any error
+    fn load_snapshot<R: std::io::Read>(
+        &self,
+        reader: &mut snapshot::Reader<R>,
+    ) -> Result<SnapshotStats> {
+        // Other sessions share this connection, so it stays locked until the
+        // load commits or rolls back
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        let nested = !conn.is_autocommit();
+        if nested {
+            conn.execute_batch("SAVEPOINT snapshot_import")?;
+        } else {
+            conn.execute_batch("BEGIN IMMEDIATE")?;
+        }
+
+        let rollback = if nested {
+            "ROLLBACK TO snapshot_import; RELEASE snapshot_import"
+        } else {
+            "ROLLBACK"
+        };
+        let finish = if nested {
+            "RELEASE snapshot_import"
+        } else {
+            "COMMIT"
+        };
+        let loaded = Self::load_snapshot_frames(&conn, reader).and_then(|stats| {
+            conn.execute_batch(finish)?;
+            Ok(stats)
+        });
+        if loaded.is_err() {
+            let _ = conn.execute_batch(rollback);
+        }
+        loaded
+    }
+
+    /// Apply each frame in a savepoint; keys may span frames
+    fn load_snapshot_frames<R: std::io::Read>(
+        conn: &Connection,
+        reader: &mut snapshot::Reader<R>,
+    ) -> Result<SnapshotStats> {
+        let now = Self::now_ms();
+        let mut stats = SnapshotStats::default();
+        // Key whose items are being read: its new id (None while skipping an
+        // expired key), its type, and how many items are left
+        let mut key_id: Option<i64> = None;
+        let mut key_type = KeyType::String;
+        let mut geo = false;
+        let mut remaining = 0u64;
+        let mut ended = false;
+
+        while let Some(frame) = reader.next_frame()? {
+            if ended {
+                return Err(snapshot::corrupt("data after the end record"));
+            }
+            Self::in_savepoint(conn, || {
+                let mut cur = snapshot::Cursor::new(frame);
+                while !cur.is_empty() {
+                    if remaining > 0 {
+                        Self::load_snapshot_item(conn, &mut cur, key_id, key_type, geo)?;
+                        remaining -= 1;
+                        if key_id.is_some() {
+                            stats.items += 1;
+                        }
+                        continue;
+                    }
+                    match cur.u8()? {
+                        snapshot::TAG_KEY => {
+                            key_type = KeyType::from_i32(cur.u8()? as i32)
+                                .ok_or_else(|| snapshot::corrupt("unknown key type"))?;
+                            let db = cur.u32()? as i64;
+                            let expire_at = cur.i64()?;
+                            let key = cur.text()?;
+                            remaining = cur.u64()?;
+                            geo = false;
+                            key_id = if expire_at != 0 && expire_at <= now {
+                                None
+                            } else {
+                                conn.prepare_cached("DELETE FROM keys WHERE db = ?1 AND key = ?2")?
+                                    .execute(params![db, key])?;
+                                conn.prepare_cached(
+                                    "INSERT INTO keys (db, key, type, expire_at, updated_at, version)
+                                     VALUES (?1, ?2, ?3, ?4, ?5, 1)",
+                                )?
+                                .execute(params![
+                                    db,
+                                    key,
+                                    key_type as i32,
+                                    (expire_at != 0).then_some(expire_at),
+                                    now
+                                ])?;
+                                stats.keys += 1;
+                                Some(conn.last_insert_rowid())
+                            };
+                        }
+                        snapshot::TAG_GEO if key_type == KeyType::ZSet => {
+                            remaining = cur.u64()?;
+                            geo = true;
+                        }
+                        snapshot::TAG_END => {
+                            cur.u64()?;
+                            ended = true;
+                        }
+                        _ => return Err(snapshot::corrupt("unknown record")),
+                    }
+                }
+                Ok(())
+            })?;
+        }
+
+        if !ended || remaining > 0 {
+            return Err(snapshot::corrupt("truncated, no end record"));
+        }
+        Ok(stats)
+    }
+
+    /// Decode one item and, unless its key is skipped, insert it
+    fn load_snapshot_item(
+        conn: &Connection,
+        cur: &mut snapshot::Cursor,
+        key_id: Option<i64>,
+        key_type: KeyType,
+        geo: bool,
+    ) -> Result<()> {
+        if geo {
+            let member = cur.text()?;
+            let lon = cur.f64()?;
+            let lat = cur.f64()?;
+            let geohash = cur.text()?;
+            #[cfg(feature = "geo")]
+            if let Some(id) = key_id {
+                conn.prepare_cached(
+                    "INSERT INTO geo_data (key_id, member, longitude, latitude, geohash)
+                     VALUES (?1, ?2, ?3, ?4, ?5)",
+                )?
+                .execute(params![
+                    id,
+                    member,
+                    lon,
+                    lat,
+                    (!geohash.is_empty()).then_some(geohash)
+                ])?;
+                conn.prepare_cached(
+                    "INSERT INTO geo_rtree (id, min_lon, max_lon, min_lat, max_lat)
+                     VALUES (?1, ?2, ?2, ?3, ?3)",
+                )?
+                .execute(params![conn.last_insert_rowid(), lon, lat])?;
+            }
+            #[cfg(not(feature = "geo"))]
+            let _ = (member, lon, lat, geohash);
+            return Ok(());
+        }
+
+        match key_type {
+            KeyType::String => {
+                let value = cur.blob()?;
+                if let Some(id) = key_id {
+                    conn.prepare_cached("INSERT INTO strings (key_id, value) VALUES (?1, ?2)")?
+                        .execute(params![id, value])?;
+                }
+            }
+            KeyType::Hash => {
+                let field = cur.text()?;
+                let value = cur.blob()?;
+                if let Some(id) = key_id {
+                    conn.prepare_cached(
+                        "INSERT INTO hashes (key_id, field, value) VALUES (?1, ?2, ?3)",
+                    )?
+                    .execute(params![id, field, value])?;
+                }
+            }
+            KeyType::List => {
+                let pos = cur.i64()?;
+                let value = cur.blob()?;
+                if let Some(id) = key_id {
+                    conn.prepare_cached(
+                        "INSERT INTO lists (key_id, pos, value) VALUES (?1, ?2, ?3)",
+                    )?
+                    .execute(params![id, pos, value])?;
+                }
+            }
+            KeyType::Set => {
+                let member = cur.blob()?;
+                if let Some(id) = key_id {
+                    conn.prepare_cached("INSERT INTO sets (key_id, member) VALUES (?1, ?2)")?
+                        .execute(params![id, member])?;
+                }
+            }
+            KeyType::ZSet => {
+                let score = cur.f64()?;
+                let member = cur.blob()?;
+                if let Some(id) = key_id {
+                    conn.prepare_cached(
+                        "INSERT INTO zsets (key_id, member, score) VALUES (?1, ?2, ?3)",
+                    )?
+                    .execute(params![id, member, score])?;
+                }
+            }
+            KeyType::Stream => {
+                let ms = cur.i64()?;
+                let seq = cur.i64()?;
+                let data = cur.blob()?;
+                if let Some(id) = key_id {
+                    conn.prepare_cached(
+                        "INSERT INTO streams (key_id, entry_ms, entry_seq, data) VALUES (?1, ?2, ?3, ?4)",
+                    )?
+                    .execute(params![id, ms, seq, data])?;
+                }
+            }
+            KeyType::Json => {
+                let value = cur.blob()?;
+                if let Some(id) = key_id {
+                    conn.prepare_cached("INSERT INTO json_docs (key_id, value) VALUES (?1, ?2)")?
+                        .execute(params![id, value])?;
+                }
+            }
+        }
+        Ok(())
+    }
+
+    // ========================================================================
+    // JSON Helpers (Session 51)
+    // ========================================================================
+
+    /// Normalize a path to JSONPath format.
+    /// Supports: "$", ".", "$.foo.bar", ".foo.bar"
+    fn normalize_json_path(path: &str) -> String {
+        let path = path.trim();
+        if path.is_empty() || path == "$" || path == "." {
+            return "$".to_string();
+        }
+        if path.starts_with("$.") {
+            return path.to_string();
+        }
+        if path.starts_with('.') {
+            return format!("${}", path);
+        }
+        // Assume it's a field name without prefix
+        format!("$.{}", path)
+    }
+
+    /// Parse a JSONPath string, returning an error if invalid
+    fn parse_json_path(path: &str) -> Result<JsonPath> {
+        let normalized = Self::normalize_json_path(path);
+        JsonPath::parse(&normalized).map_err(|_| KvError::SyntaxError)
+    }
+
+    /// Byte range of the value at a plain path inside a stored document,
+    /// found without parsing it. None means "use the full JSONPath query".
+    fn json_seek_path(doc: &[u8], path: &str) -> Option<std::ops::Range<usize>> {
+        let normalized = Self::normalize_json_path(path);
+        let steps = json_seek::parse_path(&normalized)?;
+        json_seek::find(doc, &steps)
+    }
+
+    /// Value at `path` the way JSON.GET/JSON.MGET return a single path:
+    /// one match as-is, several as an array
+    fn json_query_one(doc: &JsonValue, path: &str) -> Option<String> {
+        let normalized = Self::normalize_json_path(path);
+        if normalized == "$" {
+            return Some(serde_json::to_string(doc).unwrap_or_else(|_| "null".to_string()));
+        }
+        let json_path = Self::parse_json_path(&normalized).ok()?;
+        let matches = json_path.query(doc);
+        match matches.len() {
+            0 => None,
+            1 => matches
+                .iter()
+                .next()
+                .map(|v| serde_json::to_string(v).unwrap_or_else(|_| "null".to_string())),
+            _ => {
+                let arr: Vec<JsonValue> = matches.iter().map(|v| (*v).clone()).collect();
+                Some(serde_json::to_string(&arr).unwrap_or_else(|_| "null".to_string()))
+            }
+        }
+    }
+
+    fn create_json_key(&self, conn: &Connection, key: &str) -> Result<i64> {
+        let db = self.selected_db;
+        let now = Self::now_ms();
+
+        conn.execute(
+            "INSERT INTO keys (db, key, type, updated_at, version) VALUES (?1, ?2, ?3, ?4, 1)",
+            params![db, key, KeyType::Json as i32, now],
+        )?;
+
+        Ok(conn.last_insert_rowid())
+    }
+
+    fn get_or_create_json_key(&self, conn: &Connection, key: &str) -> Result<i64> {
+        let db = self.selected_db;
+        let now = Self::now_ms();
+
+        // Check if key exists and is correct type
+        let existing: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
+            "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
+            params![db, key],
+            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
+        );
+
+        match existing {
+            Ok((key_id, key_type, expire_at)) => {
+                // Check expiration
+                if let Some(exp) = expire_at {
+                    if exp <= now {
+                        // Expired - delete and create new
+                        conn.execute("DELETE FROM keys WHERE id = ?1", params![key_id])?;
+                        return self.create_json_key(conn, key);
+                    }
+                }
+                // Check type
+                if key_type != KeyType::Json as i32 {
+                    return Err(KvError::WrongType);
+                }
+                Ok(key_id)
+            }
+            Err(rusqlite::Error::QueryReturnedNoRows) => self.create_json_key(conn, key),
+            Err(e) => Err(e.into()),
+        }
+    }
+
+    /// Helper to get JSON key_id if it exists and is not expired
+    fn get_json_key_id(&self, conn: &Connection, key: &str) -> Result<Option<i64>> {
+        let db = self.selected_db;
+        let now = Self::now_ms();
+
+        let result: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
+            "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
+            params![db, key],
+            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
+        );
+
+        match result {
+            Ok((key_id, key_type, expire_at)) => {
+                // Check expiration
+                if let Some(exp) = expire_at {
+                    if exp <= now {
+                        return Ok(None);
+                    }
+                }
+                // Check type
+                if key_type != KeyType::Json as i32 {
+                    return Err(KvError::WrongType);
+                }
+                Ok(Some(key_id))
+            }
+            Err(rusqlite::Error::QueryReturnedNoRows) => Ok(None),
+            Err(e) => Err(e.into()),
+        }
+    }
+
+    // ========================================================================
+    // JSON Commands (Session 51)
+    // ========================================================================
+
+    /// JSON.SET key path value [NX|XX] - set JSON value at path
+    /// Returns Ok(true) if set, Ok(false) if NX/XX condition not met
+    pub fn json_set(&self, key: &str, path: &str, value: &str, nx: bool, xx: bool) -> Result<bool> {
+        // Parse the value as JSON
+        let new_value: JsonValue = serde_json::from_str(value)
+            .map_err(|_| KvError::SyntaxError)?;
+
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        let now = Self::now_ms();
+        let normalized_path = Self::normalize_json_path(path);
+
+        // Check if key exists
+        let existing_key_id = self.get_json_key_id(&conn, key)?;
+
+        // Handle NX/XX conditions
+        if nx && existing_key_id.is_some() && normalized_path == "$" {
+            // NX: only set if key doesn't exist (for root path)
+            // For root, check if doc exists
+            if let Some(kid) = existing_key_id {
+                let doc_exists: bool = conn
+                    .query_row(
+                        "SELECT 1 FROM json_docs WHERE key_id = ?1",
+                        params![kid],
+                        |_| Ok(true),
+                    )
+                    .unwrap_or(false);
+                if doc_exists {
+                    return Ok(false);
+                }
+            }
+        }
+
+        if xx && existing_key_id.is_none() {
+            // XX: only set if key exists
+            return Ok(false);
+        }
+
+        if normalized_path == "$" {
+            // Setting root - replace entire document
             let key_id = self.get_or_create_json_key(&conn, key)?;
             let json_bytes = serde_json::to_vec(&new_value).map_err(|_| KvError::SyntaxError)?;
 
@@ -3383,24 +4509,26 @@ impl Db {
             .optional()?
             .ok_or(KvError::NotFound)?;
 
+        // The whole document or a plain single path is read straight out of
+        // the stored bytes
+        let span = match paths {
+            [] => Some(0..doc_bytes.len()),
+            [path] => Self::json_seek_path(&doc_bytes, path),
+            _ => None,
+        };
+        if let Some(span) = span {
+            self.track_access(key_id);
+            return Ok(Some(String::from_utf8_lossy(&doc_bytes[span]).into_owned()));
+        }
+
         let doc: JsonValue = serde_json::from_slice(&doc_bytes)
             .map_err(|_| KvError::SyntaxError)?;
 
         // Track access for LRU/LFU
         self.track_access(key_id);
 
-        // If no paths specified, return entire document
-        if paths.is_empty() {
-            return Ok(Some(serde_json::to_string(&doc).map_err(|_| KvError::SyntaxError)?));
-        }
-
         // Single path - return value directly
         if paths.len() == 1 {
-            let normalized = Self::normalize_json_path(paths[0]);
-            if normalized == "$" {
-                return Ok(Some(serde_json::to_string(&doc).map_err(|_| KvError::SyntaxError)?));
-            }
-
             let json_path = Self::parse_json_path(paths[0])?;
             let results = json_path.query(&doc);
 
@@ -3659,44 +4787,18 @@ impl Db {
                 }
             };
 
-            let doc: JsonValue = match serde_json::from_slice(&doc_bytes) {
-                Ok(v) => v,
-                Err(_) => {
-                    results.push(None);
-                    continue;
-                }
-            };
-
             // Track access for LRU/LFU
             self.track_access(key_id);
 
-            // Get value at path
-            if normalized == "$" {
-                results.push(Some(serde_json::to_string(&doc).unwrap_or_else(|_| "null".to_string())));
-            } else {
-                let json_path = match Self::parse_json_path(&normalized) {
-                    Ok(jp) => jp,
-                    Err(_) => {
-                        results.push(None);
-                        continue;
-                    }
-                };
-                let matches = json_path.query(&doc);
-
-                if matches.is_empty() {
-                    results.push(None);
-                } else if matches.len() == 1 {
-                    if let Some(first) = matches.iter().next() {
-                        results.push(Some(serde_json::to_string(first).unwrap_or_else(|_| "null".to_string())));
-                    } else {
-                        results.push(None);
-                    }
-                } else {
-                    // Multiple matches - return as array
-                    let arr: Vec<JsonValue> = matches.iter().map(|v| (*v).clone()).collect();
-                    results.push(Some(serde_json::to_string(&arr).unwrap_or_else(|_| "null".to_string())));
-                }
+            if let Some(span) = Self::json_seek_path(&doc_bytes, &normalized) {
+                results.push(Some(String::from_utf8_lossy(&doc_bytes[span]).into_owned()));
+                continue;
             }
+            results.push(
+                serde_json::from_slice::<JsonValue>(&doc_bytes)
+                    .ok()
+                    .and_then(|doc| Self::json_query_one(&doc, &normalized)),
+            );
         }
 
         Ok(results)
@@ -3709,14 +4811,123 @@ impl Db {
             return Ok(());
         }
 
-        // Use json_set for each triplet - it handles all the logic
-        for (key, path, value) in triplets {
-            self.json_set(key, path, value, false, false)?;
+        // One parse/write per document, keeping each key's updates in order
+        let mut groups: Vec<(&str, Vec<(&str, &str)>)> = Vec::new();
+        let mut group_of: HashMap<&str, usize> = HashMap::new();
+        for &(key, path, value) in triplets {
+            let i = *group_of.entry(key).or_insert_with(|| {
+                groups.push((key, Vec::new()));
+                groups.len() - 1
+            });
+            groups[i].1.push((path, value));
+        }
+        for (key, updates) in &groups {
+            self.json_set_many(key, updates)?;
         }
 
         Ok(())
     }
 
+    /// Apply several JSON.SET path/value updates to one document, in order,
+    /// with a single parse and a single write. Values are validated before
+    /// anything is written. Returns Ok(false), writing nothing, if a path
+    /// can't be set, like json_set.
+    pub fn json_set_many(&self, key: &str, updates: &[(&str, &str)]) -> Result<bool> {
+        if updates.is_empty() {
+            return Ok(true);
+        }
+        let mut parsed = Vec::with_capacity(updates.len());
+        for (path, value) in updates {
+            let value: JsonValue = serde_json::from_str(value).map_err(|_| KvError::SyntaxError)?;
+            parsed.push((Self::normalize_json_path(path), value));
+        }
+
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        let now = Self::now_ms();
+
+        let existing_key_id = self.get_json_key_id(&conn, key)?;
+        let mut doc = match existing_key_id {
+            Some(kid) => conn
+                .query_row(
+                    "SELECT value FROM json_docs WHERE key_id = ?1",
+                    params![kid],
+                    |row| row.get::<_, Vec<u8>>(0),
+                )
+                .optional()?
+                .map(|bytes| serde_json::from_slice(&bytes).map_err(|_| KvError::SyntaxError))
+                .transpose()?
+                .unwrap_or_else(|| serde_json::json!({})),
+            None => serde_json::json!({}),
+        };
+        for (path, value) in parsed {
+            if !Self::set_value_at_path(&mut doc, &path, value, false)? {
+                return Ok(false);
+            }
+        }
+
+        let key_id = match existing_key_id {
+            Some(kid) => kid,
+            None => self.get_or_create_json_key(&conn, key)?,
+        };
+        let json_bytes = serde_json::to_vec(&doc).map_err(|_| KvError::SyntaxError)?;
+        conn.execute(
+            "INSERT INTO json_docs (key_id, value) VALUES (?1, ?2)
+             ON CONFLICT(key_id) DO UPDATE SET value = excluded.value",
+            params![key_id, json_bytes],
+        )?;
+        conn.execute(
+            "UPDATE keys SET updated_at = ?1, version = version + 1 WHERE id = ?2",
+            params![now, key_id],
+        )?;
+
+        // Release connection and auto-index for FTS
+        drop(conn);
+        let _ = self.ft_index_document(key, key_id);
+
+        Ok(true)
+    }
+
+    /// Read several paths from one document, one result per path (None
+    /// where nothing matches). Plain paths are read straight out of the
+    /// stored bytes; the document is parsed at most once for the rest.
+    pub fn json_get_many(&self, key: &str, paths: &[&str]) -> Result<Vec<Option<String>>> {
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+
+        let key_id = match self.get_json_key_id(&conn, key)? {
+            Some(kid) => kid,
+            None => return Ok(vec![None; paths.len()]),
+        };
+        let doc_bytes: Vec<u8> = match conn
+            .query_row(
+                "SELECT value FROM json_docs WHERE key_id = ?1",
+                params![key_id],
+                |row| row.get(0),
+            )
+            .optional()?
+        {
+            Some(bytes) => bytes,
+            None => return Ok(vec![None; paths.len()]),
+        };
+
+        // Track access for LRU/LFU
+        self.track_access(key_id);
+
+        let mut doc: Option<JsonValue> = None;
+        let mut results = Vec::with_capacity(paths.len());
+        for path in paths {
+            if let Some(span) = Self::json_seek_path(&doc_bytes, path) {
+                results.push(Some(String::from_utf8_lossy(&doc_bytes[span]).into_owned()));
+                continue;
+            }
+            if doc.is_none() {
+                doc = Some(serde_json::from_slice(&doc_bytes).map_err(|_| KvError::SyntaxError)?);
+            }
+            results.push(doc.as_ref().and_then(|d| Self::json_query_one(d, path)));
+        }
+
+        Ok(results)
+    }
+
     /// JSON.MERGE key path value - RFC 7386 JSON Merge Patch
     /// Merges a JSON value into the document at the specified path
     /// Returns Ok(true) on success
@@ -4044,10 +5255,46 @@ impl Db {
             .optional()?
             .ok_or(KvError::NotFound)?;
 
+        let normalized = Self::normalize_json_path(path);
+
+        // A plain path only needs the number itself parsed and rewritten. If
+        // the new number is as wide as the old one it is overwritten in place.
+        if let Some(span) = Self::json_seek_path(&doc_bytes, &normalized) {
+            let mut target: JsonValue = serde_json::from_slice(&doc_bytes[span.clone()])
+                .map_err(|_| KvError::SyntaxError)?;
+            let new_value = Self::numincrby_at_path(&mut target, "$", increment)?;
+            let new_bytes = serde_json::to_vec(&target).map_err(|_| KvError::SyntaxError)?;
+
+            if new_bytes.len() == span.len() {
+                let mut blob =
+                    conn.blob_open(DatabaseName::Main, "json_docs", "value", key_id, false)?;
+                blob.write_at(&new_bytes, span.start)?;
+            } else {
+                let mut updated =
+                    Vec::with_capacity(doc_bytes.len() + new_bytes.len() - span.len());
+                updated.extend_from_slice(&doc_bytes[..span.start]);
+                updated.extend_from_slice(&new_bytes);
+                updated.extend_from_slice(&doc_bytes[span.end..]);
+                conn.execute(
+                    "UPDATE json_docs SET value = ?1 WHERE key_id = ?2",
+                    params![updated, key_id],
+                )?;
+            }
+
+            conn.execute(
+                "UPDATE keys SET updated_at = ?1, version = version + 1 WHERE id = ?2",
+                params![now, key_id],
+            )?;
+
+            drop(conn);
+            let _ = self.ft_index_document(key, key_id);
+
+            return Ok(new_value);
+        }
+
         let mut doc: JsonValue = serde_json::from_slice(&doc_bytes)
             .map_err(|_| KvError::SyntaxError)?;
 
-        let normalized = Self::normalize_json_path(path);
         let new_value = Self::numincrby_at_path(&mut doc, &normalized, increment)?;
 
         let updated_bytes = serde_json::to_vec(&doc).map_err(|_| KvError::SyntaxError)?;
@@ -4994,30 +6241,27 @@ impl Db {
         let mut new_fields = 0i64;
         for (field, value) in pairs {
             let exists: bool = conn
-                .query_row(
-                    "SELECT 1 FROM hashes WHERE key_id = ?1 AND field = ?2",
-                    params![key_id, field],
-                    |_| Ok(true),
-                )
+                .prepare_cached("SELECT 1 FROM hashes WHERE key_id = ?1 AND field = ?2")?
+                .query_row(params![key_id, field], |_| Ok(true))
                 .unwrap_or(false);
 
             if !exists {
                 new_fields += 1;
             }
 
-            conn.execute(
+            conn.prepare_cached(
                 "INSERT INTO hashes (key_id, field, value) VALUES (?1, ?2, ?3)
                  ON CONFLICT(key_id, field) DO UPDATE SET value = excluded.value",
-                params![key_id, field, value],
-            )?;
+            )?
+            .execute(params![key_id, field, value])?;
         }
 
         // Update key timestamp and version
         let now = Self::now_ms();
-        conn.execute(
+        conn.prepare_cached(
             "UPDATE keys SET updated_at = ?1, version = version + 1 WHERE id = ?2",
-            params![now, key_id],
-        )?;
+        )?
+        .execute(params![now, key_id])?;
 
         // Release connection before auto-indexing and history recording
         drop(conn);
@@ -5048,11 +6292,9 @@ impl Db {
         // Track access for LRU/LFU eviction
         self.track_access(key_id);
 
-        let result: std::result::Result<Vec<u8>, _> = conn.query_row(
-            "SELECT value FROM hashes WHERE key_id = ?1 AND field = ?2",
-            params![key_id, field],
-            |row| row.get(0),
-        );
+        let result: std::result::Result<Vec<u8>, _> = conn
+            .prepare_cached("SELECT value FROM hashes WHERE key_id = ?1 AND field = ?2")?
+            .query_row(params![key_id, field], |row| row.get(0));
 
         match result {
             Ok(value) => Ok(Some(value)),
@@ -5400,6 +6642,7 @@ impl Db {
                 params![key_id, new_pos, value],
             )?;
         }
+        Self::refresh_list_meta(conn, key_id)?;
 
         Ok(())
     }
@@ -5409,11 +6652,11 @@ impl Db {
         let db = self.selected_db;
         let now = Self::now_ms();
 
-        let existing: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
-            "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
-            params![db, key],
-            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
-        );
+        let existing: std::result::Result<(i64, i32, Option<i64>), _> = conn
+            .prepare_cached("SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2")?
+            .query_row(params![db, key], |row| {
+                Ok((row.get(0)?, row.get(1)?, row.get(2)?))
+            });
 
         match existing {
             Ok((key_id, key_type, expire_at)) => {
@@ -5421,7 +6664,8 @@ impl Db {
                 if let Some(exp) = expire_at {
                     if exp <= now {
                         // Expired - delete and create new
-                        conn.execute("DELETE FROM keys WHERE id = ?1", params![key_id])?;
+                        conn.prepare_cached("DELETE FROM keys WHERE id = ?1")?
+                            .execute(params![key_id])?;
                         return self.create_list_key(conn, key);
                     }
                 }
@@ -5440,10 +6684,10 @@ impl Db {
         let db = self.selected_db;
         let now = Self::now_ms();
 
-        conn.execute(
+        conn.prepare_cached(
             "INSERT INTO keys (db, key, type, updated_at, version) VALUES (?1, ?2, ?3, ?4, 1)",
-            params![db, key, KeyType::List as i32, now],
-        )?;
+        )?
+        .execute(params![db, key, KeyType::List as i32, now])?;
 
         Ok(conn.last_insert_rowid())
     }
@@ -5453,11 +6697,11 @@ impl Db {
         let db = self.selected_db;
         let now = Self::now_ms();
 
-        let result: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
-            "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
-            params![db, key],
-            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
-        );
+        let result: std::result::Result<(i64, i32, Option<i64>), _> = conn
+            .prepare_cached("SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2")?
+            .query_row(params![db, key], |row| {
+                Ok((row.get(0)?, row.get(1)?, row.get(2)?))
+            });
 
         match result {
             Ok((key_id, key_type, expire_at)) => {
@@ -5478,6 +6722,220 @@ impl Db {
         }
     }
 
+    /// Head/tail/length of a list from `list_meta`, rebuilt from the rows if
+    /// missing (lists written before the table existed)
+    fn list_meta(conn: &Connection, key_id: i64) -> Result<ListMeta> {
+        let cached = conn
+            .prepare_cached("SELECT head, tail, len FROM list_meta WHERE key_id = ?1")?
+            .query_row(params![key_id], |row| {
+                Ok(ListMeta {
+                    head: row.get(0)?,
+                    tail: row.get(1)?,
+                    len: row.get(2)?,
+                })
+            })
+            .optional()?;
+        match cached {
+            Some(meta) => Ok(meta),
+            None => Self::refresh_list_meta(conn, key_id),
+        }
+    }
+
+    /// Recompute a list's metadata from its rows (one COUNT over the list)
+    fn refresh_list_meta(conn: &Connection, key_id: i64) -> Result<ListMeta> {
+        let meta = conn
+            .prepare_cached(
+                "SELECT (SELECT MIN(pos) FROM lists WHERE key_id = ?1),
+                        (SELECT MAX(pos) FROM lists WHERE key_id = ?1),
+                        (SELECT COUNT(*) FROM lists WHERE key_id = ?1)",
+            )?
+            .query_row(params![key_id], |row| {
+                Ok(ListMeta {
+                    head: row.get::<_, Option<i64>>(0)?.unwrap_or(0),
+                    tail: row.get::<_, Option<i64>>(1)?.unwrap_or(0),
+                    len: row.get(2)?,
+                })
+            })?;
+        Self::save_list_meta(conn, key_id, &meta)?;
+        Ok(meta)
+    }
+
+    fn save_list_meta(conn: &Connection, key_id: i64, meta: &ListMeta) -> Result<()> {
+        conn.prepare_cached(
+            "INSERT OR REPLACE INTO list_meta (key_id, head, tail, len) VALUES (?1, ?2, ?3, ?4)",
+        )?
+        .execute(params![key_id, meta.head, meta.tail, meta.len])?;
+        Ok(())
+    }
+
+    /// Re-read head and tail after removing elements from the middle or ends.
+    /// Both lookups are single index seeks.
+    fn refresh_list_bounds(conn: &Connection, key_id: i64, meta: &mut ListMeta) -> Result<()> {
+        let (head, tail): (Option<i64>, Option<i64>) = conn
+            .prepare_cached(
+                "SELECT (SELECT MIN(pos) FROM lists WHERE key_id = ?1),
+                        (SELECT MAX(pos) FROM lists WHERE key_id = ?1)",
+            )?
+            .query_row(params![key_id], |row| Ok((row.get(0)?, row.get(1)?)))?;
+        match (head, tail) {
+            (Some(head), Some(tail)) => {
+                meta.head = head;
+                meta.tail = tail;
+            }
+            _ => *meta = ListMeta::default(),
+        }
+        Ok(())
+    }
+
+    /// Insert `values` one by one at the head (so the last value ends up
+    /// first, as LPUSH) or tail of a list. Returns the new length.
+    fn list_push(
+        &self,
+        conn: &Connection,
+        key_id: i64,
+        values: &[&[u8]],
+        left: bool,
+    ) -> Result<i64> {
+        let mut meta = Self::list_meta(conn, key_id)?;
+
+        // Check if we would overflow - rebalance if needed
+        let span = (values.len() as i64).saturating_mul(Self::LIST_GAP);
+        let overflow = if left {
+            meta.head.saturating_sub(span) < Self::LIST_POS_MIN_THRESHOLD
+        } else {
+            meta.tail.saturating_add(span) > Self::LIST_POS_MAX_THRESHOLD
+        };
+        if overflow {
+            self.rebalance_list(conn, key_id)?;
+            meta = Self::list_meta(conn, key_id)?;
+        }
+
+        let mut insert =
+            conn.prepare_cached("INSERT INTO lists (key_id, pos, value) VALUES (?1, ?2, ?3)")?;
+        for value in values {
+            let pos = if meta.len == 0 {
+                0
+            } else if left {
+                meta.head - Self::LIST_GAP
+            } else {
+                meta.tail + Self::LIST_GAP
+            };
+            insert.execute(params![key_id, pos, value])?;
+            if meta.len == 0 || left {
+                meta.head = pos;
+            }
+            if meta.len == 0 || !left {
+                meta.tail = pos;
+            }
+            meta.len += 1;
+        }
+
+        Self::save_list_meta(conn, key_id, &meta)?;
+        Ok(meta.len)
+    }
+
+    /// Remove up to `count` elements from the head or tail of a list.
+    /// Returns them with the remaining length; the caller deletes the key at 0.
+    fn list_pop(
+        &self,
+        conn: &Connection,
+        key_id: i64,
+        count: usize,
+        left: bool,
+    ) -> Result<(Vec<Vec<u8>>, i64)> {
+        let mut meta = Self::list_meta(conn, key_id)?;
+
+        let sql = if left {
+            "SELECT pos, value FROM lists WHERE key_id = ?1 ORDER BY pos ASC LIMIT ?2"
+        } else {
+            "SELECT pos, value FROM lists WHERE key_id = ?1 ORDER BY pos DESC LIMIT ?2"
+        };
+        let mut results = Vec::new();
+        let mut positions = Vec::new();
+        {
+            let mut stmt = conn.prepare_cached(sql)?;
+            let rows = stmt.query_map(params![key_id, count as i64], |row| {
+                Ok((row.get::<_, i64>(0)?, row.get::<_, Vec<u8>>(1)?))
+            })?;
+            for row in rows {
+                let (pos, value) = row?;
+                positions.push(pos);
+                results.push(value);
+            }
+        }
+        let last_pos = match positions.last() {
+            Some(&pos) => pos,
+            None => return Ok((results, meta.len)),
+        };
+
+        let mut delete = conn.prepare_cached("DELETE FROM lists WHERE key_id = ?1 AND pos = ?2")?;
+        for pos in &positions {
+            delete.execute(params![key_id, pos])?;
+        }
+
+        // The next element is one index seek past the last popped position
+        let next: Option<i64> = if left {
+            conn.prepare_cached(
+                "SELECT pos FROM lists WHERE key_id = ?1 AND pos > ?2 ORDER BY pos ASC LIMIT 1",
+            )?
+            .query_row(params![key_id, last_pos], |row| row.get(0))
+            .optional()?
+        } else {
+            conn.prepare_cached(
+                "SELECT pos FROM lists WHERE key_id = ?1 AND pos < ?2 ORDER BY pos DESC LIMIT 1",
+            )?
+            .query_row(params![key_id, last_pos], |row| row.get(0))
+            .optional()?
+        };
+
+        match next {
+            Some(pos) => {
+                if left {
+                    meta.head = pos;
+                } else {
+                    meta.tail = pos;
+                }
+                meta.len = (meta.len - results.len() as i64).max(1);
+                Self::save_list_meta(conn, key_id, &meta)?;
+                Ok((results, meta.len))
+            }
+            None => {
+                Self::save_list_meta(conn, key_id, &ListMeta::default())?;
+                Ok((results, 0))
+            }
+        }
+    }
+
+    /// Read `count` elements starting at logical `index`, scanning from
+    /// whichever end of the list is closer
+    fn list_slice<T: rusqlite::types::FromSql>(
+        conn: &Connection,
+        key_id: i64,
+        len: i64,
+        index: i64,
+        count: i64,
+        column: &str,
+    ) -> Result<Vec<T>> {
+        let from_start = index;
+        let from_end = len - (index + count);
+        let (order, offset) = if from_end < from_start {
+            ("DESC", from_end.max(0))
+        } else {
+            ("ASC", from_start)
+        };
+        let sql = format!(
+            "SELECT {} FROM lists WHERE key_id = ?1 ORDER BY pos {} LIMIT ?2 OFFSET ?3",
+            column, order
+        );
+        let mut stmt = conn.prepare_cached(&sql)?;
+        let rows = stmt.query_map(params![key_id, count, offset], |row| row.get::<_, T>(0))?;
+        let mut values = rows.collect::<std::result::Result<Vec<T>, _>>()?;
+        if order == "DESC" {
+            values.reverse();
+        }
+        Ok(values)
+    }
+
     /// LPUSH key element [element ...] - prepend elements to list, returns length
     pub fn lpush(&self, key: &str, values: &[&[u8]]) -> Result<i64> {
         if values.is_empty() {
@@ -5487,53 +6945,14 @@ impl Db {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
         let key_id = self.get_or_create_list_key(&conn, key)?;
 
-        // Get current min position (or start at LIST_GAP if empty)
-        let mut min_pos: i64 = conn
-            .query_row(
-                "SELECT MIN(pos) FROM lists WHERE key_id = ?1",
-                params![key_id],
-                |row| row.get::<_, Option<i64>>(0),
-            )
-            .unwrap_or(None)
-            .unwrap_or(Self::LIST_GAP);
-
-        // Check if we would overflow - rebalance if needed
-        let new_min = min_pos.saturating_sub((values.len() as i64) * Self::LIST_GAP);
-        if new_min < Self::LIST_POS_MIN_THRESHOLD {
-            self.rebalance_list(&conn, key_id)?;
-            // Get fresh min position after rebalance
-            min_pos = conn
-                .query_row(
-                    "SELECT MIN(pos) FROM lists WHERE key_id = ?1",
-                    params![key_id],
-                    |row| row.get::<_, Option<i64>>(0),
-                )
-                .unwrap_or(None)
-                .unwrap_or(Self::LIST_GAP);
-        }
-
-        // Insert values in reverse order (so first value ends up at head)
-        for (i, value) in values.iter().enumerate() {
-            let pos = min_pos - ((i as i64 + 1) * Self::LIST_GAP);
-            conn.execute(
-                "INSERT INTO lists (key_id, pos, value) VALUES (?1, ?2, ?3)",
-                params![key_id, pos, value],
-            )?;
-        }
-
-        // Get and return new length
-        let length: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        let length = self.list_push(&conn, key_id, values, true)?;
 
         // Update key timestamp
         let now = Self::now_ms();
-        conn.execute(
+        conn.prepare_cached(
             "UPDATE keys SET updated_at = ?1, version = version + 1 WHERE id = ?2",
-            params![now, key_id],
-        )?;
+        )?
+        .execute(params![now, key_id])?;
 
         // Release lock before async notification
         drop(conn);
@@ -5566,53 +6985,14 @@ impl Db {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
         let key_id = self.get_or_create_list_key(&conn, key)?;
 
-        // Get current max position (or start at 0 if empty)
-        let mut max_pos: i64 = conn
-            .query_row(
-                "SELECT MAX(pos) FROM lists WHERE key_id = ?1",
-                params![key_id],
-                |row| row.get::<_, Option<i64>>(0),
-            )
-            .unwrap_or(None)
-            .unwrap_or(0);
-
-        // Check if we would overflow - rebalance if needed
-        let new_max = max_pos.saturating_add((values.len() as i64) * Self::LIST_GAP);
-        if new_max > Self::LIST_POS_MAX_THRESHOLD {
-            self.rebalance_list(&conn, key_id)?;
-            // Get fresh max position after rebalance
-            max_pos = conn
-                .query_row(
-                    "SELECT MAX(pos) FROM lists WHERE key_id = ?1",
-                    params![key_id],
-                    |row| row.get::<_, Option<i64>>(0),
-                )
-                .unwrap_or(None)
-                .unwrap_or(0);
-        }
-
-        // Insert values in order
-        for (i, value) in values.iter().enumerate() {
-            let pos = max_pos + ((i as i64 + 1) * Self::LIST_GAP);
-            conn.execute(
-                "INSERT INTO lists (key_id, pos, value) VALUES (?1, ?2, ?3)",
-                params![key_id, pos, value],
-            )?;
-        }
-
-        // Get and return new length
-        let length: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        let length = self.list_push(&conn, key_id, values, false)?;
 
         // Update key timestamp
         let now = Self::now_ms();
-        conn.execute(
+        conn.prepare_cached(
             "UPDATE keys SET updated_at = ?1, version = version + 1 WHERE id = ?2",
-            params![now, key_id],
-        )?;
+        )?
+        .execute(params![now, key_id])?;
 
         // Release lock before async notification
         drop(conn);
@@ -5650,45 +7030,7 @@ impl Db {
             None => return Ok(0),
         };
 
-        // Get current min position (or start at LIST_GAP if empty)
-        let mut min_pos: i64 = conn
-            .query_row(
-                "SELECT MIN(pos) FROM lists WHERE key_id = ?1",
-                params![key_id],
-                |row| row.get::<_, Option<i64>>(0),
-            )
-            .unwrap_or(None)
-            .unwrap_or(Self::LIST_GAP);
-
-        // Check if we would overflow - rebalance if needed
-        let new_min = min_pos.saturating_sub((values.len() as i64) * Self::LIST_GAP);
-        if new_min < Self::LIST_POS_MIN_THRESHOLD {
-            self.rebalance_list(&conn, key_id)?;
-            min_pos = conn
-                .query_row(
-                    "SELECT MIN(pos) FROM lists WHERE key_id = ?1",
-                    params![key_id],
-                    |row| row.get::<_, Option<i64>>(0),
-                )
-                .unwrap_or(None)
-                .unwrap_or(Self::LIST_GAP);
-        }
-
-        // Insert values in reverse order
-        for (i, value) in values.iter().enumerate() {
-            let pos = min_pos - ((i as i64 + 1) * Self::LIST_GAP);
-            conn.execute(
-                "INSERT INTO lists (key_id, pos, value) VALUES (?1, ?2, ?3)",
-                params![key_id, pos, value],
-            )?;
-        }
-
-        // Get and return new length
-        let length: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        let length = self.list_push(&conn, key_id, values, true)?;
 
         // Update key timestamp
         let now = Self::now_ms();
@@ -5725,45 +7067,7 @@ impl Db {
             None => return Ok(0),
         };
 
-        // Get current max position (or start at 0 if empty)
-        let mut max_pos: i64 = conn
-            .query_row(
-                "SELECT MAX(pos) FROM lists WHERE key_id = ?1",
-                params![key_id],
-                |row| row.get::<_, Option<i64>>(0),
-            )
-            .unwrap_or(None)
-            .unwrap_or(0);
-
-        // Check if we would overflow - rebalance if needed
-        let new_max = max_pos.saturating_add((values.len() as i64) * Self::LIST_GAP);
-        if new_max > Self::LIST_POS_MAX_THRESHOLD {
-            self.rebalance_list(&conn, key_id)?;
-            max_pos = conn
-                .query_row(
-                    "SELECT MAX(pos) FROM lists WHERE key_id = ?1",
-                    params![key_id],
-                    |row| row.get::<_, Option<i64>>(0),
-                )
-                .unwrap_or(None)
-                .unwrap_or(0);
-        }
-
-        // Insert values in order
-        for (i, value) in values.iter().enumerate() {
-            let pos = max_pos + ((i as i64 + 1) * Self::LIST_GAP);
-            conn.execute(
-                "INSERT INTO lists (key_id, pos, value) VALUES (?1, ?2, ?3)",
-                params![key_id, pos, value],
-            )?;
-        }
-
-        // Get and return new length
-        let length: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        let length = self.list_push(&conn, key_id, values, false)?;
 
         // Update key timestamp
         let now = Self::now_ms();
@@ -5872,11 +7176,7 @@ impl Db {
 
         // If we scanned from end (negative rank), we need to convert indices
         if rank < 0 && !indices.is_empty() {
-            let total: i64 = conn.query_row(
-                "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-                params![key_id],
-                |row| row.get(0),
-            )?;
+            let total = Self::list_meta(&conn, key_id)?.len;
             return Ok(indices.into_iter().map(|i| total - 1 - i).collect());
         }
 
@@ -5901,58 +7201,18 @@ impl Db {
         };
 
         // Pop element from source
-        let element = match wherefrom {
-            ListDirection::Left => {
-                // Get leftmost element
-                let result: std::result::Result<(i64, Vec<u8>), _> = conn.query_row(
-                    "SELECT pos, value FROM lists WHERE key_id = ?1 ORDER BY pos ASC LIMIT 1",
-                    params![src_key_id],
-                    |row| Ok((row.get(0)?, row.get(1)?)),
-                );
-                match result {
-                    Ok((pos, value)) => {
-                        conn.execute(
-                            "DELETE FROM lists WHERE key_id = ?1 AND pos = ?2",
-                            params![src_key_id, pos],
-                        )?;
-                        Some(value)
-                    }
-                    Err(rusqlite::Error::QueryReturnedNoRows) => None,
-                    Err(e) => return Err(e.into()),
-                }
-            }
-            ListDirection::Right => {
-                // Get rightmost element
-                let result: std::result::Result<(i64, Vec<u8>), _> = conn.query_row(
-                    "SELECT pos, value FROM lists WHERE key_id = ?1 ORDER BY pos DESC LIMIT 1",
-                    params![src_key_id],
-                    |row| Ok((row.get(0)?, row.get(1)?)),
-                );
-                match result {
-                    Ok((pos, value)) => {
-                        conn.execute(
-                            "DELETE FROM lists WHERE key_id = ?1 AND pos = ?2",
-                            params![src_key_id, pos],
-                        )?;
-                        Some(value)
-                    }
-                    Err(rusqlite::Error::QueryReturnedNoRows) => None,
-                    Err(e) => return Err(e.into()),
-                }
-            }
-        };
-
-        let element = match element {
+        let (mut popped, src_count) = self.list_pop(
+            &conn,
+            src_key_id,
+            1,
+            matches!(wherefrom, ListDirection::Left),
+        )?;
+        let element = match popped.pop() {
             Some(e) => e,
             None => return Ok(None),
         };
 
-        // Check if source is now empty and delete key if so
-        let src_count: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![src_key_id],
-            |row| row.get(0),
-        )?;
+        // Delete the source key if it is now empty
         if src_count == 0 {
             conn.execute("DELETE FROM keys WHERE id = ?1", params![src_key_id])?;
         } else {
@@ -5978,38 +7238,12 @@ impl Db {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
 
         // Push to destination
-        match whereto {
-            ListDirection::Left => {
-                let min_pos: i64 = conn
-                    .query_row(
-                        "SELECT MIN(pos) FROM lists WHERE key_id = ?1",
-                        params![dest_key_id],
-                        |row| row.get::<_, Option<i64>>(0),
-                    )
-                    .unwrap_or(None)
-                    .unwrap_or(Self::LIST_GAP);
-                let pos = min_pos - Self::LIST_GAP;
-                conn.execute(
-                    "INSERT INTO lists (key_id, pos, value) VALUES (?1, ?2, ?3)",
-                    params![dest_key_id, pos, element],
-                )?;
-            }
-            ListDirection::Right => {
-                let max_pos: i64 = conn
-                    .query_row(
-                        "SELECT MAX(pos) FROM lists WHERE key_id = ?1",
-                        params![dest_key_id],
-                        |row| row.get::<_, Option<i64>>(0),
-                    )
-                    .unwrap_or(None)
-                    .unwrap_or(0);
-                let pos = max_pos + Self::LIST_GAP;
-                conn.execute(
-                    "INSERT INTO lists (key_id, pos, value) VALUES (?1, ?2, ?3)",
-                    params![dest_key_id, pos, element],
-                )?;
-            }
-        }
+        self.list_push(
+            &conn,
+            dest_key_id,
+            &[&element],
+            matches!(whereto, ListDirection::Left),
+        )?;
 
         // Update destination timestamp
         let now = Self::now_ms();
@@ -6037,37 +7271,7 @@ impl Db {
         // Track access for LRU/LFU eviction
         self.track_access(key_id);
 
-        let count = count.unwrap_or(1);
-
-        // Get elements from head (lowest positions)
-        let mut stmt = conn
-            .prepare("SELECT pos, value FROM lists WHERE key_id = ?1 ORDER BY pos ASC LIMIT ?2")?;
-        let rows = stmt.query_map(params![key_id, count as i64], |row| {
-            Ok((row.get::<_, i64>(0)?, row.get::<_, Vec<u8>>(1)?))
-        })?;
-
-        let mut results = Vec::new();
-        let mut positions = Vec::new();
-        for row in rows {
-            let (pos, value) = row?;
-            positions.push(pos);
-            results.push(value);
-        }
-
-        // Delete popped elements
-        for pos in &positions {
-            conn.execute(
-                "DELETE FROM lists WHERE key_id = ?1 AND pos = ?2",
-                params![key_id, pos],
-            )?;
-        }
-
-        // Clean up empty list
-        let remaining: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        let (results, remaining) = self.list_pop(&conn, key_id, count.unwrap_or(1), true)?;
 
         if remaining == 0 {
             conn.execute("DELETE FROM keys WHERE id = ?1", params![key_id])?;
@@ -6095,37 +7299,7 @@ impl Db {
         // Track access for LRU/LFU eviction
         self.track_access(key_id);
 
-        let count = count.unwrap_or(1);
-
-        // Get elements from tail (highest positions)
-        let mut stmt = conn
-            .prepare("SELECT pos, value FROM lists WHERE key_id = ?1 ORDER BY pos DESC LIMIT ?2")?;
-        let rows = stmt.query_map(params![key_id, count as i64], |row| {
-            Ok((row.get::<_, i64>(0)?, row.get::<_, Vec<u8>>(1)?))
-        })?;
-
-        let mut results = Vec::new();
-        let mut positions = Vec::new();
-        for row in rows {
-            let (pos, value) = row?;
-            positions.push(pos);
-            results.push(value);
-        }
-
-        // Delete popped elements
-        for pos in &positions {
-            conn.execute(
-                "DELETE FROM lists WHERE key_id = ?1 AND pos = ?2",
-                params![key_id, pos],
-            )?;
-        }
-
-        // Clean up empty list
-        let remaining: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        let (results, remaining) = self.list_pop(&conn, key_id, count.unwrap_or(1), false)?;
 
         if remaining == 0 {
             conn.execute("DELETE FROM keys WHERE id = ?1", params![key_id])?;
@@ -6150,13 +7324,7 @@ impl Db {
             None => return Ok(0),
         };
 
-        let count: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
-
-        Ok(count)
+        Ok(Self::list_meta(&conn, key_id)?.len)
     }
 
     /// LRANGE key start stop - get range of elements
@@ -6172,63 +7340,22 @@ impl Db {
         // Track access for LRU/LFU eviction
         self.track_access(key_id);
 
-        // Only query COUNT if we have negative indices (optimization)
-        let len: i64 = if start < 0 || stop < 0 {
-            conn.query_row(
-                "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-                params![key_id],
-                |row| row.get(0),
-            )?
+        let len = Self::list_meta(&conn, key_id)?.len;
+        let start = if start < 0 {
+            (len + start).max(0)
         } else {
-            // For positive indices, we can skip the COUNT and rely on LIMIT/OFFSET
-            -1i64 // sentinel value indicating COUNT was not needed
+            start
         };
-
-        // Convert negative indices to positive (only if len was queried)
-        let (start, stop, needs_bounds) = if len >= 0 {
-            if len == 0 {
-                return Ok(vec![]);
-            }
-
-            let start = if start < 0 {
-                (len + start).max(0)
-            } else {
-                start.min(len - 1)
-            };
-
-            let stop = if stop < 0 {
-                (len + stop).max(0)
-            } else {
-                stop.min(len - 1)
-            };
-
-            (start, stop, true)
+        let stop = if stop < 0 {
+            len + stop
         } else {
-            // For positive indices, don't apply bounds yet
-            (start, stop, false)
+            stop.min(len - 1)
         };
-
-        // For positive indices, start > stop means empty range
-        if start > stop {
+        if start > stop || start >= len {
             return Ok(vec![]);
         }
 
-        let count = stop - start + 1;
-
-        // Get elements by logical index (ordered by position)
-        let mut stmt = conn.prepare(
-            "SELECT value FROM lists WHERE key_id = ?1 ORDER BY pos ASC LIMIT ?2 OFFSET ?3",
-        )?;
-        let rows = stmt.query_map(params![key_id, count, start], |row| {
-            row.get::<_, Vec<u8>>(0)
-        })?;
-
-        let mut results = Vec::new();
-        for row in rows {
-            results.push(row?);
-        }
-
-        Ok(results)
+        Self::list_slice(&conn, key_id, len, start, stop - start + 1, "value")
     }
 
     /// LINDEX key index - get element by index
@@ -6243,41 +7370,13 @@ impl Db {
         // Track access for LRU/LFU eviction
         self.track_access(key_id);
 
-        // Only query list length if we have negative index (optimization)
-        let index = if index < 0 {
-            // Need to query length for negative index conversion
-            let len: i64 = conn.query_row(
-                "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-                params![key_id],
-                |row| row.get(0),
-            )?;
-
-            if len == 0 {
-                return Ok(None);
-            }
-
-            len + index
-        } else {
-            // For non-negative indices, use as-is
-            index
-        };
-
-        if index < 0 {
+        let len = Self::list_meta(&conn, key_id)?.len;
+        let index = if index < 0 { len + index } else { index };
+        if index < 0 || index >= len {
             return Ok(None);
         }
 
-        // Get element at logical index
-        let result: std::result::Result<Vec<u8>, _> = conn.query_row(
-            "SELECT value FROM lists WHERE key_id = ?1 ORDER BY pos ASC LIMIT 1 OFFSET ?2",
-            params![key_id, index],
-            |row| row.get(0),
-        );
-
-        match result {
-            Ok(value) => Ok(Some(value)),
-            Err(rusqlite::Error::QueryReturnedNoRows) => Ok(None),
-            Err(e) => Err(e.into()),
-        }
+        Ok(Self::list_slice(&conn, key_id, len, index, 1, "value")?.pop())
     }
 
     /// LSET key index element - set element at index
@@ -6290,11 +7389,7 @@ impl Db {
         };
 
         // Get list length
-        let len: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        let len = Self::list_meta(&conn, key_id)?.len;
 
         if len == 0 {
             return Err(KvError::OutOfRange);
@@ -6308,11 +7403,9 @@ impl Db {
         }
 
         // Get position at logical index
-        let pos: i64 = conn.query_row(
-            "SELECT pos FROM lists WHERE key_id = ?1 ORDER BY pos ASC LIMIT 1 OFFSET ?2",
-            params![key_id, index],
-            |row| row.get(0),
-        )?;
+        let pos: i64 = Self::list_slice(&conn, key_id, len, index, 1, "pos")?
+            .pop()
+            .ok_or(KvError::OutOfRange)?;
 
         // Update value
         conn.execute(
@@ -6340,11 +7433,8 @@ impl Db {
         };
 
         // Get list length
-        let len: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        let mut meta = Self::list_meta(&conn, key_id)?;
+        let len = meta.len;
 
         if len == 0 {
             return Ok(());
@@ -6394,15 +7484,14 @@ impl Db {
         }
 
         // Check if list is now empty
-        let remaining: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        meta.len = stop - start + 1;
+        Self::refresh_list_bounds(&conn, key_id, &mut meta)?;
+        let remaining = meta.len;
 
         if remaining == 0 {
             conn.execute("DELETE FROM keys WHERE id = ?1", params![key_id])?;
         } else {
+            Self::save_list_meta(&conn, key_id, &meta)?;
             // Update timestamp
             let now = Self::now_ms();
             conn.execute(
@@ -6488,15 +7577,17 @@ impl Db {
         }
 
         // Check if list is now empty
-        let remaining: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        let mut meta = ListMeta {
+            len: all_positions.len() as i64 - removed_count,
+            ..ListMeta::default()
+        };
+        Self::refresh_list_bounds(&conn, key_id, &mut meta)?;
+        let remaining = meta.len;
 
         if remaining == 0 {
             conn.execute("DELETE FROM keys WHERE id = ?1", params![key_id])?;
         } else {
+            Self::save_list_meta(&conn, key_id, &meta)?;
             // Update timestamp
             let now = Self::now_ms();
             conn.execute(
@@ -6642,17 +7733,18 @@ impl Db {
         };
 
         // Insert the element
+        let mut meta = Self::list_meta(&conn, key_id)?;
         conn.execute(
             "INSERT INTO lists (key_id, pos, value) VALUES (?1, ?2, ?3)",
             params![key_id, target_pos, element],
         )?;
 
         // Get new list length
-        let length: i64 = conn.query_row(
-            "SELECT COUNT(*) FROM lists WHERE key_id = ?1",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        meta.head = meta.head.min(target_pos);
+        meta.tail = meta.tail.max(target_pos);
+        meta.len += 1;
+        Self::save_list_meta(&conn, key_id, &meta)?;
+        let length = meta.len;
 
         // Update key timestamp
         let now = Self::now_ms();
@@ -7279,17 +8371,15 @@ impl Db {
         let db = self.selected_db;
         let now = Self::now_ms();
 
-        conn.execute(
+        conn.prepare_cached(
             "INSERT INTO keys (db, key, type, created_at, updated_at, version)
              VALUES (?1, ?2, ?3, ?4, ?4, 1)",
-            params![db, key, KeyType::ZSet as i32, now],
-        )?;
+        )?
+        .execute(params![db, key, KeyType::ZSet as i32, now])?;
 
-        let key_id: i64 = conn.query_row(
-            "SELECT id FROM keys WHERE db = ?1 AND key = ?2",
-            params![db, key],
-            |row| row.get(0),
-        )?;
+        let key_id: i64 = conn
+            .prepare_cached("SELECT id FROM keys WHERE db = ?1 AND key = ?2")?
+            .query_row(params![db, key], |row| row.get(0))?;
 
         Ok(key_id)
     }
@@ -7299,11 +8389,11 @@ impl Db {
         let db = self.selected_db;
         let now = Self::now_ms();
 
-        let existing: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
-            "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
-            params![db, key],
-            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
-        );
+        let existing: std::result::Result<(i64, i32, Option<i64>), _> = conn
+            .prepare_cached("SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2")?
+            .query_row(params![db, key], |row| {
+                Ok((row.get(0)?, row.get(1)?, row.get(2)?))
+            });
 
         match existing {
             Ok((key_id, key_type, expire_at)) => {
@@ -7311,7 +8401,8 @@ impl Db {
                 if let Some(exp) = expire_at {
                     if exp <= now {
                         // Expired - delete and create new
-                        conn.execute("DELETE FROM keys WHERE id = ?1", params![key_id])?;
+                        conn.prepare_cached("DELETE FROM keys WHERE id = ?1")?
+                            .execute(params![key_id])?;
                         return self.create_zset_key(conn, key);
                     }
                 }
@@ -7331,11 +8422,11 @@ impl Db {
         let db = self.selected_db;
         let now = Self::now_ms();
 
-        let result: std::result::Result<(i64, i32, Option<i64>), _> = conn.query_row(
-            "SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2",
-            params![db, key],
-            |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
-        );
+        let result: std::result::Result<(i64, i32, Option<i64>), _> = conn
+            .prepare_cached("SELECT id, type, expire_at FROM keys WHERE db = ?1 AND key = ?2")?
+            .query_row(params![db, key], |row| {
+                Ok((row.get(0)?, row.get(1)?, row.get(2)?))
+            });
 
         match result {
             Ok((key_id, key_type, expire_at)) => {
@@ -7369,30 +8460,27 @@ impl Db {
         let mut added = 0i64;
         for m in members {
             let exists: bool = conn
-                .query_row(
-                    "SELECT 1 FROM zsets WHERE key_id = ?1 AND member = ?2",
-                    params![key_id, m.member],
-                    |_| Ok(true),
-                )
+                .prepare_cached("SELECT 1 FROM zsets WHERE key_id = ?1 AND member = ?2")?
+                .query_row(params![key_id, m.member], |_| Ok(true))
                 .unwrap_or(false);
 
             if !exists {
                 added += 1;
             }
 
-            conn.execute(
+            conn.prepare_cached(
                 "INSERT INTO zsets (key_id, member, score) VALUES (?1, ?2, ?3)
                  ON CONFLICT(key_id, member) DO UPDATE SET score = excluded.score",
-                params![key_id, m.member, m.score],
-            )?;
+            )?
+            .execute(params![key_id, m.member, m.score])?;
         }
 
         // Update timestamp
         let now = Self::now_ms();
-        conn.execute(
+        conn.prepare_cached(
             "UPDATE keys SET updated_at = ?1, version = version + 1 WHERE id = ?2",
-            params![now, key_id],
-        )?;
+        )?
+        .execute(params![now, key_id])?;
 
         // Check if disk eviction needed
         self.maybe_evict();
@@ -7575,11 +8663,8 @@ impl Db {
 
         // Only query total count if we have negative indices (optimization)
         let total: i64 = if start < 0 || stop < 0 {
-            conn.query_row(
-                "SELECT COUNT(*) FROM zsets WHERE key_id = ?1",
-                params![key_id],
-                |row| row.get(0),
-            )?
+            conn.prepare_cached("SELECT COUNT(*) FROM zsets WHERE key_id = ?1")?
+                .query_row(params![key_id], |row| row.get(0))?
         } else {
             // For positive indices, use sentinel value
             -1i64
@@ -7620,7 +8705,7 @@ impl Db {
 
         let limit = stop - start + 1;
 
-        let mut stmt = conn.prepare(
+        let mut stmt = conn.prepare_cached(
             "SELECT member, score FROM zsets WHERE key_id = ?1 ORDER BY score ASC, member ASC LIMIT ?2 OFFSET ?3",
         )?;
 
@@ -8189,6 +9274,186 @@ impl Db {
         Ok(deleted)
     }
 
+    /// Delete expired keys (across all dbs) in batches until none are left or
+    /// `deadline` passes. Returns the number deleted and whether more remain.
+    fn sweep_expired(conn: &Connection, now: i64, deadline: Instant) -> Result<(u64, bool)> {
+        let mut stmt = conn.prepare_cached(
+            "DELETE FROM keys WHERE id IN (
+                 SELECT id FROM keys WHERE expire_at IS NOT NULL AND expire_at <= ?1 LIMIT ?2
+             )",
+        )?;
+        let mut deleted = 0u64;
+        loop {
+            let n = stmt.execute(params![now, EXPIRE_SWEEP_BATCH])? as u64;
+            deleted += n;
+            if n < EXPIRE_SWEEP_BATCH as u64 {
+                return Ok((deleted, false));
+            }
+            if Instant::now() >= deadline {
+                return Ok((deleted, true));
+            }
+        }
+    }
+
+    /// Rows changed on this connection since it was opened
+    fn total_changes(conn: &Connection) -> u64 {
+        // SAFETY: the handle stays valid while the connection lock is held
+        unsafe { rusqlite::ffi::sqlite3_total_changes(conn.handle()).max(0) as u64 }
+    }
+
+    /// Run one bounded slice of background maintenance.
+    ///
+    /// Holds the connection for roughly `budget` (one batch may overrun it):
+    /// 1. deletes expired keys, oldest index entries first;
+    /// 2. with `max_disk` / `max_memory` set, evicts keys until the database
+    ///    is back under budget (checked at most once a second);
+    /// 3. on `auto_vacuum = INCREMENTAL` databases (`OpenOptions::incremental_vacuum`),
+    ///    returns free pages to the filesystem in small chunks;
+    /// 4. flushes one batch of access stats once per access flush interval;
+    /// 5. once no backlog is left, and if nothing but maintenance wrote since
+    ///    the previous step, runs a passive WAL checkpoint.
+    ///
+    /// Once it has run, writes no longer evict or flush access stats inline.
+    /// Does nothing while an explicit transaction is open. Call it in a loop
+    /// from a background thread, sleeping the autovacuum interval whenever
+    /// the returned step has `more == false`.
+    ///
+    /// # Example
+    /// ```
+    /// use redlite::Db;
+    /// use std::time::Duration;
+    ///
+    /// let db = Db::open_memory().unwrap();
+    /// db.set("k", b"v", Some(Duration::from_millis(1))).unwrap();
+    /// std::thread::sleep(Duration::from_millis(5));
+    /// let step = db.maintenance_step(Duration::from_millis(5)).unwrap();
+    /// assert_eq!(step.keys_reclaimed, 1);
+    /// ```
+    pub fn maintenance_step(&self, budget: Duration) -> Result<MaintenanceStep> {
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        let start = Instant::now();
+        let deadline = start + budget;
+        let mut step = MaintenanceStep::default();
+
+        // Never interleave with an explicit transaction on this connection
+        if !conn.is_autocommit() {
+            return Ok(step);
+        }
+
+        self.core
+            .background_maintenance
+            .store(true, Ordering::Relaxed);
+        let m = &self.core.maintenance;
+        let changes_before = Self::total_changes(&conn);
+
+        let (reclaimed, more) = Self::sweep_expired(&conn, Self::now_ms(), deadline)?;
+        step.keys_reclaimed = reclaimed;
+        step.more = more;
+
+        if !step.more && self.claim_eviction_pass() {
+            step.keys_evicted = self.evict_over_budget(&conn, deadline)?;
+            step.more = self.core.last_eviction_check.load(Ordering::Relaxed) == 0;
+        }
+
+        if !step.more && Instant::now() < deadline {
+            let auto_vacuum: i64 = conn.query_row("PRAGMA auto_vacuum", [], |row| row.get(0))?;
+            if auto_vacuum == 2 {
+                let free_pages = || -> Result<i64> {
+                    Ok(conn.query_row("PRAGMA freelist_count", [], |row| row.get(0))?)
+                };
+                let before = free_pages()?;
+                let mut remaining = before;
+                while remaining > 0 && Instant::now() < deadline {
+                    conn.execute_batch(&format!(
+                        "PRAGMA incremental_vacuum({});",
+                        INCREMENTAL_VACUUM_PAGES
+                    ))?;
+                    remaining = free_pages()?;
+                }
+                step.pages_freed = (before - remaining).max(0) as u64;
+                step.more = remaining > 0;
+            }
+        }
+
+        if Instant::now() < deadline {
+            self.maintain_access_stats(&conn)?;
+        }
+
+        let changes_after = Self::total_changes(&conn);
+        let idle = changes_before == m.changes_seen.load(Ordering::Relaxed);
+        if idle
+            && !step.more
+            && !self.core.is_memory_db
+            && changes_after != m.changes_checkpointed.load(Ordering::Relaxed)
+            && Instant::now() < deadline
+        {
+            // PASSIVE never waits on readers or writers; busy = 1 means it
+            // could not finish and will be retried next step
+            let busy: i64 =
+                conn.query_row("PRAGMA wal_checkpoint(PASSIVE)", [], |row| row.get(0))?;
+            if busy == 0 {
+                step.checkpointed = true;
+                m.changes_checkpointed
+                    .store(changes_after, Ordering::Relaxed);
+            }
+        }
+        m.changes_seen.store(changes_after, Ordering::Relaxed);
+        drop(conn);
+
+        step.pause_us = start.elapsed().as_micros() as u64;
+        m.steps.fetch_add(1, Ordering::Relaxed);
+        m.keys_reclaimed
+            .fetch_add(step.keys_reclaimed, Ordering::Relaxed);
+        m.keys_evicted
+            .fetch_add(step.keys_evicted, Ordering::Relaxed);
+        m.pages_freed.fetch_add(step.pages_freed, Ordering::Relaxed);
+        m.checkpoints
+            .fetch_add(step.checkpointed as u64, Ordering::Relaxed);
+        m.pause_total_us.fetch_add(step.pause_us, Ordering::Relaxed);
+        m.pause_max_us.fetch_max(step.pause_us, Ordering::Relaxed);
+        Ok(step)
+    }
+
+    /// Maintenance's share of access tracking: drop the stats of deleted
+    /// keys, one tracker shard per step, and with persistence on, flush a
+    /// batch of stats once per flush interval (each step while a backlog is left)
+    fn maintain_access_stats(&self, conn: &Connection) -> Result<()> {
+        let mut exists = conn.prepare_cached("SELECT 1 FROM keys WHERE id = ?1")?;
+        for id in self.core.access_tracking.shard_ids() {
+            if !exists.exists(params![id])? {
+                self.core.access_tracking.remove(id);
+            }
+        }
+        if !self.core.persist_access_tracking.load(Ordering::Relaxed) {
+            return Ok(());
+        }
+
+        let now = Self::now_ms();
+        let last = self.core.last_access_flush.load(Ordering::Relaxed);
+        if now - last < self.core.access_flush_interval_ms.load(Ordering::Relaxed) {
+            return Ok(());
+        }
+        let written = self.flush_access_stats(conn, ACCESS_FLUSH_BATCH)?;
+        if written < ACCESS_FLUSH_BATCH {
+            self.core.last_access_flush.store(now, Ordering::Relaxed);
+        }
+        Ok(())
+    }
+
+    /// Cumulative counters of `maintenance_step` (and keys reclaimed by autovacuum)
+    pub fn maintenance_stats(&self) -> MaintenanceStats {
+        let m = &self.core.maintenance;
+        MaintenanceStats {
+            steps: m.steps.load(Ordering::Relaxed),
+            keys_reclaimed: m.keys_reclaimed.load(Ordering::Relaxed),
+            keys_evicted: m.keys_evicted.load(Ordering::Relaxed),
+            pages_freed: m.pages_freed.load(Ordering::Relaxed),
+            checkpoints: m.checkpoints.load(Ordering::Relaxed),
+            pause_total_us: m.pause_total_us.load(Ordering::Relaxed),
+            pause_max_us: m.pause_max_us.load(Ordering::Relaxed),
+        }
+    }
+
     /// KEYINFO key - Get metadata about a key.
     /// Returns None if the key doesn't exist.
     pub fn keyinfo(&self, key: &str) -> Result<Option<KeyInfo>> {
@@ -8979,21 +10244,6 @@ impl Db {
         }
     }
 
-    /// Helper: Get stream entry by stream_id (ms, seq)
-    fn get_stream_entry_id(
-        &self,
-        conn: &Connection,
-        key_id: i64,
-        stream_id: &StreamId,
-    ) -> Option<i64> {
-        conn.query_row(
-            "SELECT id FROM streams WHERE key_id = ?1 AND entry_ms = ?2 AND entry_seq = ?3",
-            params![key_id, stream_id.ms, stream_id.seq],
-            |row| row.get(0),
-        )
-        .ok()
-    }
-
     /// XREADGROUP GROUP group consumer [COUNT count] [NOACK] STREAMS key [key ...] id [id ...]
     /// Reads from streams as part of a consumer group
     pub fn xreadgroup(
@@ -9059,24 +10309,28 @@ impl Db {
                     .filter_map(|r| r.ok())
                     .collect();
 
-                // Update last_delivered_id and add to pending (unless NOACK)
+                // Update last_delivered_id and add to pending (unless NOACK),
+                // committing the whole batch once
                 if !entries.is_empty() {
-                    let last_entry = entries.last().unwrap();
-                    conn.execute(
-                        "UPDATE stream_groups SET last_ms = ?1, last_seq = ?2 WHERE id = ?3",
-                        params![last_entry.1.id.ms, last_entry.1.id.seq, group_id],
-                    )?;
+                    Self::in_savepoint(&conn, || {
+                        let last_entry = entries.last().unwrap();
+                        conn.execute(
+                            "UPDATE stream_groups SET last_ms = ?1, last_seq = ?2 WHERE id = ?3",
+                            params![last_entry.1.id.ms, last_entry.1.id.seq, group_id],
+                        )?;
 
-                    if !noack {
-                        for (db_id, _entry) in &entries {
-                            conn.execute(
+                        if !noack {
+                            let mut insert = conn.prepare_cached(
                                 "INSERT OR REPLACE INTO stream_pending
                                  (key_id, group_id, entry_id, consumer, delivered_at, delivery_count)
                                  VALUES (?1, ?2, ?3, ?4, ?5, 1)",
-                                params![key_id, group_id, db_id, consumer, now],
                             )?;
+                            for (db_id, _entry) in &entries {
+                                insert.execute(params![key_id, group_id, db_id, consumer, now])?;
+                            }
                         }
-                    }
+                        Ok(())
+                    })?;
                 }
 
                 entries.into_iter().map(|(_, e)| e).collect()
@@ -9127,11 +10381,16 @@ impl Db {
                     .collect();
 
                 // Update delivery count and time
-                for (_, _, pending_id) in &entries {
-                    conn.execute(
-                        "UPDATE stream_pending SET delivered_at = ?1, delivery_count = delivery_count + 1 WHERE id = ?2",
-                        params![now, pending_id],
-                    )?;
+                if !entries.is_empty() {
+                    Self::in_savepoint(&conn, || {
+                        let mut update = conn.prepare_cached(
+                            "UPDATE stream_pending SET delivered_at = ?1, delivery_count = delivery_count + 1 WHERE id = ?2",
+                        )?;
+                        for (_, _, pending_id) in &entries {
+                            update.execute(params![now, pending_id])?;
+                        }
+                        Ok(())
+                    })?;
                 }
 
                 entries.into_iter().map(|(_, e, _)| e).collect()
@@ -9168,19 +10427,38 @@ impl Db {
             Err(_) => return Ok(0), // Group doesn't exist
         };
 
-        let mut acked = 0i64;
-        for id in ids {
-            // Find the stream entry id
-            if let Some(entry_id) = self.get_stream_entry_id(&conn, key_id, id) {
-                let deleted = conn.execute(
-                    "DELETE FROM stream_pending WHERE group_id = ?1 AND entry_id = ?2",
-                    params![group_id, entry_id],
-                )?;
-                acked += deleted as i64;
+        // One statement per ID, but a single commit for the whole batch
+        Self::in_savepoint(&conn, || {
+            let mut delete = conn.prepare_cached(
+                "DELETE FROM stream_pending WHERE group_id = ?1 AND entry_id =
+                 (SELECT id FROM streams WHERE key_id = ?2 AND entry_ms = ?3 AND entry_seq = ?4)",
+            )?;
+            let mut acked = 0i64;
+            for id in ids {
+                acked += delete.execute(params![group_id, key_id, id.ms, id.seq])? as i64;
             }
-        }
+            Ok(acked)
+        })
+    }
 
-        Ok(acked)
+    /// Run `f` inside a savepoint so a multi-statement write commits once.
+    /// Outside a transaction the savepoint starts one; inside `begin` or
+    /// `with_transaction` it nests in the caller's transaction.
+    fn in_savepoint<T>(conn: &Connection, f: impl FnOnce() -> Result<T>) -> Result<T> {
+        conn.execute_batch("SAVEPOINT batch_write")?;
+        match f() {
+            Ok(value) => match conn.execute_batch("RELEASE batch_write") {
+                Ok(()) => Ok(value),
+                Err(e) => {
+                    let _ = conn.execute_batch("ROLLBACK TO batch_write; RELEASE batch_write");
+                    Err(e.into())
+                }
+            },
+            Err(e) => {
+                let _ = conn.execute_batch("ROLLBACK TO batch_write; RELEASE batch_write");
+                Err(e)
+            }
+        }
     }
 
     /// XPENDING key group [[IDLE min-idle-time] start end count [consumer]]
@@ -10364,11 +11642,10 @@ impl Db {
         // First check key-level config
         let key_target = format!("{}:{}", self.selected_db, key);
         let key_enabled: Option<bool> = conn
-            .query_row(
+            .prepare_cached(
                 "SELECT enabled FROM history_config WHERE level = 'key' AND target = ? LIMIT 1",
-                params![key_target],
-                |row| row.get(0),
-            )
+            )?
+            .query_row(params![key_target], |row| row.get(0))
             .optional()?;
 
         if let Some(enabled) = key_enabled {
@@ -10377,11 +11654,10 @@ impl Db {
 
         // Fall back to database-level config
         let db_enabled: Option<bool> = conn
-            .query_row(
+            .prepare_cached(
                 "SELECT enabled FROM history_config WHERE level = 'database' AND target = ? LIMIT 1",
-                params![self.selected_db.to_string()],
-                |row| row.get(0),
-            )
+            )?
+            .query_row(params![self.selected_db.to_string()], |row| row.get(0))
             .optional()?;
 
         if let Some(enabled) = db_enabled {
@@ -10390,11 +11666,10 @@ impl Db {
 
         // Fall back to global config
         let global_enabled: Option<bool> = conn
-            .query_row(
+            .prepare_cached(
                 "SELECT enabled FROM history_config WHERE level = 'global' AND target = '*' LIMIT 1",
-                params![],
-                |row| row.get(0),
-            )
+            )?
+            .query_row(params![], |row| row.get(0))
             .optional()?;
 
         Ok(global_enabled.unwrap_or(false))
@@ -10407,19 +11682,18 @@ impl Db {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
 
         // Try to get existing key
-        if let Ok(key_id) = conn.query_row(
-            "SELECT id FROM keys WHERE db = ? AND key = ? LIMIT 1",
-            params![db, key],
-            |row| row.get(0),
-        ) {
+        if let Ok(key_id) = conn
+            .prepare_cached("SELECT id FROM keys WHERE db = ? AND key = ? LIMIT 1")?
+            .query_row(params![db, key], |row| row.get(0))
+        {
             return Ok(key_id);
         }
 
         // Create new key entry if it doesn't exist
-        conn.execute(
+        conn.prepare_cached(
             "INSERT INTO keys (db, key, type, created_at, version) VALUES (?, ?, ?, ?, 1)",
-            params![db, key, 0, Self::now_ms()],
-        )?;
+        )?
+        .execute(params![db, key, 0, Self::now_ms()])?;
 
         let key_id = conn.last_insert_rowid();
         Ok(key_id)
@@ -10429,11 +11703,11 @@ impl Db {
     fn increment_version(&self, key_id: i64) -> Result<i64> {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
         // Use COALESCE to handle NULL when there are no history entries
-        let version: i64 = conn.query_row(
-            "SELECT COALESCE(MAX(version_num), 0) FROM key_history WHERE key_id = ?",
-            params![key_id],
-            |row| row.get(0),
-        )?;
+        let version: i64 = conn
+            .prepare_cached(
+                "SELECT COALESCE(MAX(version_num), 0) FROM key_history WHERE key_id = ?",
+            )?
+            .query_row(params![key_id], |row| row.get(0))?;
 
         Ok(version + 1)
     }
@@ -10461,18 +11735,31 @@ impl Db {
 
             // Get current key type from the keys table
             let key_type: i32 = conn
-                .query_row(
-                    "SELECT type FROM keys WHERE id = ?",
-                    params![key_id],
-                    |row| row.get(0),
-                )
+                .prepare_cached("SELECT type FROM keys WHERE id = ?")?
+                .query_row(params![key_id], |row| row.get(0))
                 .unwrap_or(0);
 
-            conn.execute(
-                "INSERT INTO key_history (key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot)
-                 VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
-                params![key_id, db, key, key_type, version, operation, timestamp_ms, data_snapshot],
-            )?;
+            let (data_snapshot, delta_base) = match data_snapshot {
+                Some(value) => Self::history_encode(&conn, key_id, version, value)?,
+                None => (None, None),
+            };
+
+            conn
+                .prepare_cached(
+                    "INSERT INTO key_history (key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, delta_base)
+                 VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)",
+                )?
+                .execute(params![
+                    key_id,
+                    db,
+                    key,
+                    key_type,
+                    version,
+                    operation,
+                    timestamp_ms,
+                    data_snapshot,
+                    delta_base
+                ])?;
         }
 
         // Apply retention policy (needs its own lock scope)
@@ -10487,11 +11774,8 @@ impl Db {
 
         // Get the key's ID
         let key_id: Option<i64> = conn
-            .query_row(
-                "SELECT id FROM keys WHERE db = ? AND key = ? LIMIT 1",
-                params![db, key],
-                |row| row.get(0),
-            )
+            .prepare_cached("SELECT id FROM keys WHERE db = ? AND key = ? LIMIT 1")?
+            .query_row(params![db, key], |row| row.get(0))
             .optional()?;
 
         let key_id = match key_id {
@@ -10502,100 +11786,189 @@ impl Db {
         // Check key-level retention first
         let key_target = format!("{}:{}", db, key);
         let key_retention: Option<(String, Option<i64>)> = conn
-            .query_row(
+            .prepare_cached(
                 "SELECT retention_type, retention_value FROM history_config WHERE level = 'key' AND target = ?",
-                params![key_target],
-                |row| Ok((row.get(0)?, row.get(1)?)),
-            )
+            )?
+            .query_row(params![key_target], |row| Ok((row.get(0)?, row.get(1)?)))
             .optional()?;
 
         if let Some((retention_type, retention_value)) = key_retention {
-            match retention_type.as_str() {
-                "time" => {
-                    let cutoff = Self::now_ms() - retention_value.unwrap_or(0);
-                    conn.execute(
-                        "DELETE FROM key_history WHERE key_id = ? AND timestamp_ms < ?",
-                        params![key_id, cutoff],
-                    )?;
-                }
-                "count" => {
-                    let count = retention_value.unwrap_or(100);
-                    conn.execute(
-                        "DELETE FROM key_history WHERE key_id = ? AND version_num <= (
-                            SELECT COALESCE(MAX(version_num) - ?, 0) FROM key_history WHERE key_id = ?
-                        )",
-                        params![key_id, count - 1, key_id],
-                    )?;
-                }
-                _ => {} // unlimited
-            }
+            Self::history_retain(&conn, key_id, &retention_type, retention_value)?;
             return Ok(());
         }
 
         // Fall back to database-level retention
         let db_retention: Option<(String, Option<i64>)> = conn
-            .query_row(
+            .prepare_cached(
                 "SELECT retention_type, retention_value FROM history_config WHERE level = 'database' AND target = ?",
-                params![db.to_string()],
-                |row| Ok((row.get(0)?, row.get(1)?)),
-            )
+            )?
+            .query_row(params![db.to_string()], |row| Ok((row.get(0)?, row.get(1)?)))
             .optional()?;
 
         if let Some((retention_type, retention_value)) = db_retention {
-            match retention_type.as_str() {
-                "time" => {
-                    let cutoff = Self::now_ms() - retention_value.unwrap_or(0);
-                    conn.execute(
-                        "DELETE FROM key_history WHERE key_id = ? AND timestamp_ms < ?",
-                        params![key_id, cutoff],
-                    )?;
-                }
-                "count" => {
-                    let count = retention_value.unwrap_or(100);
-                    conn.execute(
-                        "DELETE FROM key_history WHERE key_id = ? AND version_num <= (
-                            SELECT COALESCE(MAX(version_num) - ?, 0) FROM key_history WHERE key_id = ?
-                        )",
-                        params![key_id, count - 1, key_id],
-                    )?;
-                }
-                _ => {} // unlimited
-            }
+            Self::history_retain(&conn, key_id, &retention_type, retention_value)?;
             return Ok(());
         }
 
         // Fall back to global retention
         let global_retention: Option<(String, Option<i64>)> = conn
-            .query_row(
+            .prepare_cached(
                 "SELECT retention_type, retention_value FROM history_config WHERE level = 'global' AND target = '*'",
-                params![],
-                |row| Ok((row.get(0)?, row.get(1)?)),
-            )
+            )?
+            .query_row(params![], |row| Ok((row.get(0)?, row.get(1)?)))
             .optional()?;
 
         if let Some((retention_type, retention_value)) = global_retention {
-            match retention_type.as_str() {
-                "time" => {
-                    let cutoff = Self::now_ms() - retention_value.unwrap_or(0);
-                    conn.execute(
-                        "DELETE FROM key_history WHERE key_id = ? AND timestamp_ms < ?",
-                        params![key_id, cutoff],
-                    )?;
+            Self::history_retain(&conn, key_id, &retention_type, retention_value)?;
+        }
+
+        Ok(())
+    }
+
+    /// Delete a key's history rows that fall outside a retention policy
+    fn history_retain(
+        conn: &Connection,
+        key_id: i64,
+        retention_type: &str,
+        retention_value: Option<i64>,
+    ) -> Result<()> {
+        let ids: Vec<i64> = match retention_type {
+            "time" => {
+                let cutoff = Self::now_ms() - retention_value.unwrap_or(0);
+                conn.prepare_cached(
+                    "SELECT id FROM key_history WHERE key_id = ? AND timestamp_ms < ?",
+                )?
+                .query_map(params![key_id, cutoff], |row| row.get(0))?
+                .collect::<rusqlite::Result<_>>()?
+            }
+            "count" => {
+                let count = retention_value.unwrap_or(100);
+                conn.prepare_cached(
+                    "SELECT id FROM key_history WHERE key_id = ? AND version_num <= (
+                        SELECT COALESCE(MAX(version_num) - ?, 0) FROM key_history WHERE key_id = ?
+                    )",
+                )?
+                .query_map(params![key_id, count - 1, key_id], |row| row.get(0))?
+                .collect::<rusqlite::Result<_>>()?
+            }
+            _ => return Ok(()), // unlimited
+        };
+        Self::history_delete_rows(conn, &ids)?;
+        Ok(())
+    }
+
+    /// Encode a SET snapshot. It becomes a delta against the key's latest
+    /// keyframe when that keyframe is fewer than HISTORY_KEYFRAME_INTERVAL
+    /// versions back and the delta is under half the value's size;
+    /// otherwise it is stored in full as a new keyframe.
+    fn history_encode(
+        conn: &Connection,
+        key_id: i64,
+        version: i64,
+        value: Vec<u8>,
+    ) -> Result<(Option<Vec<u8>>, Option<i64>)> {
+        let keyframe: Option<(i64, Option<Vec<u8>>)> = conn
+            .prepare_cached(
+                "SELECT version_num, data_snapshot FROM key_history
+                 WHERE key_id = ? AND delta_base IS NULL
+                 ORDER BY version_num DESC LIMIT 1",
+            )?
+            .query_row(params![key_id], |row| Ok((row.get(0)?, row.get(1)?)))
+            .optional()?;
+
+        if let Some((base_version, Some(base))) = keyframe {
+            if version - base_version < HISTORY_KEYFRAME_INTERVAL {
+                let diff = delta::encode(&base, &value);
+                if diff.len() * 2 < value.len() {
+                    return Ok((Some(diff), Some(base_version)));
                 }
-                "count" => {
-                    let count = retention_value.unwrap_or(100);
-                    conn.execute(
-                        "DELETE FROM key_history WHERE key_id = ? AND version_num <= (
-                            SELECT COALESCE(MAX(version_num) - ?, 0) FROM key_history WHERE key_id = ?
-                        )",
-                        params![key_id, count - 1, key_id],
-                    )?;
+            }
+        }
+        Ok((Some(value), None))
+    }
+
+    /// Full snapshot of a history row, applying its delta to the keyframe
+    fn history_decode(
+        conn: &Connection,
+        key_id: i64,
+        snapshot: Option<Vec<u8>>,
+        delta_base: Option<i64>,
+    ) -> Result<Option<Vec<u8>>> {
+        let (diff, base_version) = match (snapshot, delta_base) {
+            (Some(diff), Some(base_version)) => (diff, base_version),
+            (snapshot, _) => return Ok(snapshot),
+        };
+        let base: Option<Vec<u8>> = conn
+            .prepare_cached(
+                "SELECT data_snapshot FROM key_history WHERE key_id = ? AND version_num = ?",
+            )?
+            .query_row(params![key_id, base_version], |row| {
+                row.get::<_, Option<Vec<u8>>>(0)
+            })
+            .optional()?
+            .flatten();
+        base.and_then(|base| delta::apply(&base, &diff))
+            .map(Some)
+            .ok_or_else(|| KvError::Other(format!("history keyframe {} is missing", base_version)))
+    }
+
+    /// Delete history rows by id. Surviving deltas whose keyframe is among
+    /// them are rewritten as full snapshots first.
+    fn history_delete_rows(conn: &Connection, ids: &[i64]) -> Result<i64> {
+        let doomed: std::collections::HashSet<i64> = ids.iter().copied().collect();
+        for &id in ids {
+            let keyframe: Option<(i64, i64, Option<Vec<u8>>)> = conn
+                .prepare_cached(
+                    "SELECT key_id, version_num, data_snapshot FROM key_history
+                     WHERE id = ? AND delta_base IS NULL",
+                )?
+                .query_row(params![id], |row| {
+                    Ok((row.get(0)?, row.get(1)?, row.get(2)?))
+                })
+                .optional()?;
+            let (key_id, version, base) = match keyframe {
+                Some((key_id, version, Some(base))) => (key_id, version, base),
+                _ => continue,
+            };
+
+            // A keyframe's deltas all sit within HISTORY_KEYFRAME_INTERVAL versions of it
+            let dependents: Vec<(i64, Option<Vec<u8>>)> = conn
+                .prepare_cached(
+                    "SELECT id, data_snapshot FROM key_history
+                     WHERE key_id = ? AND version_num > ? AND version_num < ? AND delta_base = ?",
+                )?
+                .query_map(
+                    params![
+                        key_id,
+                        version,
+                        version + HISTORY_KEYFRAME_INTERVAL,
+                        version
+                    ],
+                    |row| Ok((row.get(0)?, row.get(1)?)),
+                )?
+                .collect::<rusqlite::Result<_>>()?;
+            for (dependent, diff) in dependents {
+                if doomed.contains(&dependent) {
+                    continue;
                 }
-                _ => {} // unlimited
+                let full = diff
+                    .and_then(|diff| delta::apply(&base, &diff))
+                    .ok_or_else(|| {
+                        KvError::Other(format!("history delta {} is corrupt", dependent))
+                    })?;
+                conn.prepare_cached(
+                    "UPDATE key_history SET data_snapshot = ?, delta_base = NULL WHERE id = ?",
+                )?
+                .execute(params![full, dependent])?;
             }
         }
 
-        Ok(())
+        let mut stmt = conn.prepare_cached("DELETE FROM key_history WHERE id = ?")?;
+        let mut deleted = 0;
+        for &id in ids {
+            deleted += stmt.execute(params![id])? as i64;
+        }
+        Ok(deleted)
     }
 
     // ===== Session 17.4: Query Methods =====
@@ -10613,107 +11986,137 @@ impl Db {
         match (since, until, limit) {
             (Some(s), Some(u), Some(l)) => {
                 let mut stmt = conn.prepare(
-                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at
+                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at, delta_base
                      FROM key_history WHERE db = ? AND key = ? AND timestamp_ms >= ? AND timestamp_ms <= ?
                      ORDER BY timestamp_ms ASC LIMIT ?")?;
-                Self::query_to_history_entries(&mut stmt, params![self.selected_db, key, s, u, l])
+                Self::query_to_history_entries(
+                    &conn,
+                    &mut stmt,
+                    params![self.selected_db, key, s, u, l],
+                )
             }
             (Some(s), Some(u), None) => {
                 let mut stmt = conn.prepare(
-                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at
+                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at, delta_base
                      FROM key_history WHERE db = ? AND key = ? AND timestamp_ms >= ? AND timestamp_ms <= ?
                      ORDER BY timestamp_ms ASC")?;
-                Self::query_to_history_entries(&mut stmt, params![self.selected_db, key, s, u])
+                Self::query_to_history_entries(
+                    &conn,
+                    &mut stmt,
+                    params![self.selected_db, key, s, u],
+                )
             }
             (Some(s), None, Some(l)) => {
                 let mut stmt = conn.prepare(
-                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at
+                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at, delta_base
                      FROM key_history WHERE db = ? AND key = ? AND timestamp_ms >= ?
                      ORDER BY timestamp_ms ASC LIMIT ?")?;
-                Self::query_to_history_entries(&mut stmt, params![self.selected_db, key, s, l])
+                Self::query_to_history_entries(
+                    &conn,
+                    &mut stmt,
+                    params![self.selected_db, key, s, l],
+                )
             }
             (Some(s), None, None) => {
                 let mut stmt = conn.prepare(
-                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at
+                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at, delta_base
                      FROM key_history WHERE db = ? AND key = ? AND timestamp_ms >= ?
                      ORDER BY timestamp_ms ASC")?;
-                Self::query_to_history_entries(&mut stmt, params![self.selected_db, key, s])
+                Self::query_to_history_entries(&conn, &mut stmt, params![self.selected_db, key, s])
             }
             (None, Some(u), Some(l)) => {
                 let mut stmt = conn.prepare(
-                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at
+                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at, delta_base
                      FROM key_history WHERE db = ? AND key = ? AND timestamp_ms <= ?
                      ORDER BY timestamp_ms ASC LIMIT ?")?;
-                Self::query_to_history_entries(&mut stmt, params![self.selected_db, key, u, l])
+                Self::query_to_history_entries(
+                    &conn,
+                    &mut stmt,
+                    params![self.selected_db, key, u, l],
+                )
             }
             (None, Some(u), None) => {
                 let mut stmt = conn.prepare(
-                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at
+                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at, delta_base
                      FROM key_history WHERE db = ? AND key = ? AND timestamp_ms <= ?
                      ORDER BY timestamp_ms ASC")?;
-                Self::query_to_history_entries(&mut stmt, params![self.selected_db, key, u])
+                Self::query_to_history_entries(&conn, &mut stmt, params![self.selected_db, key, u])
             }
             (None, None, Some(l)) => {
                 let mut stmt = conn.prepare(
-                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at
+                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at, delta_base
                      FROM key_history WHERE db = ? AND key = ?
                      ORDER BY timestamp_ms ASC LIMIT ?")?;
-                Self::query_to_history_entries(&mut stmt, params![self.selected_db, key, l])
+                Self::query_to_history_entries(&conn, &mut stmt, params![self.selected_db, key, l])
             }
             (None, None, None) => {
                 let mut stmt = conn.prepare(
-                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at
+                    "SELECT id, key_id, db, key, key_type, version_num, operation, timestamp_ms, data_snapshot, expire_at, delta_base
                      FROM key_history WHERE db = ? AND key = ?
                      ORDER BY timestamp_ms ASC")?;
-                Self::query_to_history_entries(&mut stmt, params![self.selected_db, key])
+                Self::query_to_history_entries(&conn, &mut stmt, params![self.selected_db, key])
             }
         }
     }
 
-    /// Helper to convert query results to HistoryEntry vec
+    /// Helper to convert query results to HistoryEntry vec, expanding deltas
     fn query_to_history_entries(
+        conn: &Connection,
         stmt: &mut rusqlite::Statement,
         params: impl rusqlite::Params,
     ) -> Result<Vec<HistoryEntry>> {
         let entries = stmt.query_map(params, |row| {
-            Ok(HistoryEntry {
-                id: row.get(0)?,
-                key_id: row.get(1)?,
-                db: row.get(2)?,
-                key: row.get(3)?,
-                key_type: KeyType::from_i32(row.get(4)?).unwrap_or(KeyType::String),
-                version_num: row.get(5)?,
-                operation: row.get(6)?,
-                timestamp_ms: row.get(7)?,
-                data_snapshot: row.get::<_, Option<Vec<u8>>>(8)?,
-                expire_at: row.get::<_, Option<i64>>(9)?,
-            })
+            Ok((
+                HistoryEntry {
+                    id: row.get(0)?,
+                    key_id: row.get(1)?,
+                    db: row.get(2)?,
+                    key: row.get(3)?,
+                    key_type: KeyType::from_i32(row.get(4)?).unwrap_or(KeyType::String),
+                    version_num: row.get(5)?,
+                    operation: row.get(6)?,
+                    timestamp_ms: row.get(7)?,
+                    data_snapshot: row.get::<_, Option<Vec<u8>>>(8)?,
+                    expire_at: row.get::<_, Option<i64>>(9)?,
+                },
+                row.get::<_, Option<i64>>(10)?,
+            ))
         })?;
 
         let mut results = Vec::new();
         for entry in entries {
-            results.push(entry?);
+            let (mut entry, delta_base) = entry?;
+            entry.data_snapshot =
+                Self::history_decode(conn, entry.key_id, entry.data_snapshot.take(), delta_base)?;
+            results.push(entry);
         }
         Ok(results)
     }
 
-    /// Get the value of a key at a specific point in time (time-travel query)
+    /// Get the value of a key at a specific point in time (time-travel query).
+    /// One seek on idx_history_db_key_time_version, plus one primary key
+    /// lookup for the keyframe when the row is a delta.
     pub fn history_get_at(&self, key: &str, timestamp: i64) -> Result<Option<Vec<u8>>> {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
 
-        // Use nested Option to handle: outer = row exists, inner = data_snapshot value
-        let snapshot: Option<Option<Vec<u8>>> = conn
-            .query_row(
-                "SELECT data_snapshot FROM key_history
+        let row: Option<(i64, Option<Vec<u8>>, Option<i64>)> = conn
+            .prepare_cached(
+                "SELECT key_id, data_snapshot, delta_base FROM key_history
                  WHERE db = ? AND key = ? AND timestamp_ms <= ?
-                 ORDER BY timestamp_ms DESC LIMIT 1",
-                params![self.selected_db, key, timestamp],
-                |row| row.get::<_, Option<Vec<u8>>>(0),
-            )
+                 ORDER BY timestamp_ms DESC, version_num DESC LIMIT 1",
+            )?
+            .query_row(params![self.selected_db, key, timestamp], |row| {
+                Ok((row.get(0)?, row.get(1)?, row.get(2)?))
+            })
             .optional()?;
 
-        // Flatten: None (no row) or Some(None) (row with NULL) both become None
-        Ok(snapshot.flatten())
+        // No row, or a row without a snapshot (DEL, HSET, ...), both become None
+        match row {
+            Some((key_id, snapshot, delta_base)) => {
+                Self::history_decode(&conn, key_id, snapshot, delta_base)
+            }
+            None => Ok(None),
+        }
     }
 
     /// List keys that have history tracking enabled
@@ -10774,31 +12177,46 @@ impl Db {
     pub fn history_clear_key(&self, key: &str, before: Option<i64>) -> Result<i64> {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
 
-        if let Some(timestamp) = before {
-            conn.execute(
-                "DELETE FROM key_history WHERE db = ? AND key = ? AND timestamp_ms < ?",
-                params![self.selected_db, key, timestamp],
-            )?;
-        } else {
-            conn.execute(
-                "DELETE FROM key_history WHERE db = ? AND key = ?",
-                params![self.selected_db, key],
-            )?;
-        }
+        let ids: Vec<i64> = conn
+            .prepare_cached(
+                "SELECT id FROM key_history WHERE db = ? AND key = ? AND timestamp_ms < ?",
+            )?
+            .query_map(
+                params![self.selected_db, key, before.unwrap_or(i64::MAX)],
+                |row| row.get(0),
+            )?
+            .collect::<rusqlite::Result<_>>()?;
 
-        Ok(conn.changes() as i64)
+        Self::history_delete_rows(&conn, &ids)
     }
 
-    /// Prune all history entries before a given timestamp
+    /// Prune all history entries before a given timestamp.
+    /// Runs as batches of HISTORY_PRUNE_BATCH rows, releasing the
+    /// connection between them so other commands are not held up.
     pub fn history_prune(&self, before_timestamp: i64) -> Result<i64> {
+        let mut total = 0;
+        loop {
+            let deleted = self.history_prune_batch(before_timestamp, HISTORY_PRUNE_BATCH)?;
+            total += deleted;
+            if deleted < HISTORY_PRUNE_BATCH {
+                return Ok(total);
+            }
+        }
+    }
+
+    /// Prune up to `limit` of the oldest history entries before a timestamp.
+    /// Returns the number deleted; fewer than `limit` means none are left.
+    pub fn history_prune_batch(&self, before_timestamp: i64, limit: i64) -> Result<i64> {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
 
-        conn.execute(
-            "DELETE FROM key_history WHERE timestamp_ms < ?",
-            params![before_timestamp],
-        )?;
+        let ids: Vec<i64> = conn
+            .prepare_cached(
+                "SELECT id FROM key_history WHERE timestamp_ms < ? ORDER BY timestamp_ms LIMIT ?",
+            )?
+            .query_map(params![before_timestamp, limit.max(1)], |row| row.get(0))?
+            .collect::<rusqlite::Result<_>>()?;
 
-        Ok(conn.changes() as i64)
+        Self::history_delete_rows(&conn, &ids)
     }
 
     // ===== Session 24.1: Full-Text Search =====
@@ -10900,11 +12318,10 @@ impl Db {
         // 1. Check key-level config
         let key_target = format!("{}:{}", self.selected_db, key);
         let key_enabled: Option<bool> = conn
-            .query_row(
+            .prepare_cached(
                 "SELECT enabled FROM fts_settings WHERE level = 'key' AND target = ? LIMIT 1",
-                params![key_target],
-                |row| row.get(0),
-            )
+            )?
+            .query_row(params![key_target], |row| row.get(0))
             .optional()?;
 
         if let Some(enabled) = key_enabled {
@@ -10912,7 +12329,7 @@ impl Db {
         }
 
         // 2. Check pattern-level configs (match glob patterns)
-        let mut stmt = conn.prepare(
+        let mut stmt = conn.prepare_cached(
             "SELECT target, enabled FROM fts_settings WHERE level = 'pattern' AND target LIKE ?",
         )?;
         let db_prefix = format!("{}:%", self.selected_db);
@@ -10934,11 +12351,10 @@ impl Db {
 
         // 3. Check database-level config
         let db_enabled: Option<bool> = conn
-            .query_row(
+            .prepare_cached(
                 "SELECT enabled FROM fts_settings WHERE level = 'database' AND target = ? LIMIT 1",
-                params![self.selected_db.to_string()],
-                |row| row.get(0),
-            )
+            )?
+            .query_row(params![self.selected_db.to_string()], |row| row.get(0))
             .optional()?;
 
         if let Some(enabled) = db_enabled {
@@ -10947,11 +12363,10 @@ impl Db {
 
         // 4. Fall back to global config
         let global_enabled: Option<bool> = conn
-            .query_row(
+            .prepare_cached(
                 "SELECT enabled FROM fts_settings WHERE level = 'global' AND target = '*' LIMIT 1",
-                params![],
-                |row| row.get(0),
-            )
+            )?
+            .query_row(params![], |row| row.get(0))
             .optional()?;
 
         Ok(global_enabled.unwrap_or(false))
@@ -10968,11 +12383,8 @@ impl Db {
 
         // Get or create key_id
         let key_id: Option<i64> = conn
-            .query_row(
-                "SELECT id FROM keys WHERE db = ? AND key = ? LIMIT 1",
-                params![self.selected_db, key],
-                |row| row.get(0),
-            )
+            .prepare_cached("SELECT id FROM keys WHERE db = ? AND key = ? LIMIT 1")?
+            .query_row(params![self.selected_db, key], |row| row.get(0))
             .optional()?;
 
         let key_id = match key_id {
@@ -10985,31 +12397,24 @@ impl Db {
 
         // Check if already indexed
         let existing_rowid: Option<i64> = conn
-            .query_row(
-                "SELECT rowid FROM fts_keys WHERE db = ? AND key = ? LIMIT 1",
-                params![self.selected_db, key],
-                |row| row.get(0),
-            )
+            .prepare_cached("SELECT rowid FROM fts_keys WHERE db = ? AND key = ? LIMIT 1")?
+            .query_row(params![self.selected_db, key], |row| row.get(0))
             .optional()?;
 
         if let Some(rowid) = existing_rowid {
             // Update existing index
-            conn.execute(
-                "UPDATE fts SET key_text = ?, content = ? WHERE rowid = ?",
-                params![key, content_str.as_ref(), rowid],
-            )?;
+            conn.prepare_cached("UPDATE fts SET key_text = ?, content = ? WHERE rowid = ?")?
+                .execute(params![key, content_str.as_ref(), rowid])?;
         } else {
             // Insert new FTS entry
-            conn.execute(
-                "INSERT INTO fts (key_text, content) VALUES (?, ?)",
-                params![key, content_str.as_ref()],
-            )?;
+            conn.prepare_cached("INSERT INTO fts (key_text, content) VALUES (?, ?)")?
+                .execute(params![key, content_str.as_ref()])?;
             let rowid = conn.last_insert_rowid();
             // Map rowid to key_id
-            conn.execute(
+            conn.prepare_cached(
                 "INSERT INTO fts_keys (rowid, key_id, db, key) VALUES (?, ?, ?, ?)",
-                params![rowid, key_id, self.selected_db, key],
-            )?;
+            )?
+            .execute(params![rowid, key_id, self.selected_db, key])?;
         }
 
         Ok(())
@@ -11290,11 +12695,8 @@ impl Db {
 
         // Get the key type to determine how to extract fields
         let key_type: Option<i32> = conn
-            .query_row(
-                "SELECT type FROM keys WHERE id = ?1",
-                params![key_id],
-                |row| row.get(0),
-            )
+            .prepare_cached("SELECT type FROM keys WHERE id = ?1")?
+            .query_row(params![key_id], |row| row.get(0))
             .optional()?;
 
         let key_type = match key_type {
@@ -11316,9 +12718,8 @@ impl Db {
     /// Index a HASH document into matching FTS5 indexes
     fn ft_index_hash_document(&self, conn: &Connection, key: &str, key_id: i64) -> Result<()> {
         // Find all HASH indexes that match this key's prefix
-        let mut stmt = conn.prepare(
-            "SELECT id, prefixes, schema FROM ft_indexes WHERE on_type = 'HASH'"
-        )?;
+        let mut stmt = conn
+            .prepare_cached("SELECT id, prefixes, schema FROM ft_indexes WHERE on_type = 'HASH'")?;
 
         let matching_indexes: Vec<(i64, Vec<String>, Vec<serde_json::Value>)> = stmt
             .query_map([], |row| {
@@ -11345,7 +12746,8 @@ impl Db {
         }
 
         // Get all hash fields for this key
-        let mut fields_stmt = conn.prepare("SELECT field, value FROM hashes WHERE key_id = ?")?;
+        let mut fields_stmt =
+            conn.prepare_cached("SELECT field, value FROM hashes WHERE key_id = ?")?;
         let fields: HashMap<String, Vec<u8>> = fields_stmt
             .query_map(params![key_id], |row| {
                 Ok((row.get::<_, String>(0)?, row.get::<_, Vec<u8>>(1)?))
@@ -12089,6 +13491,54 @@ impl Db {
         let parsed = parse_query(query, options.verbatim)
             .map_err(|e| KvError::Other(format!("Query parse error: {}", e)))?;
 
+        let db = self.selected_db;
+        let now = Self::now_ms();
+
+        // Determine the key type to search for based on the index type
+        let key_type_code = match on_type {
+            FtOnType::Hash => KeyType::Hash as i32,
+            FtOnType::Json => KeyType::Json as i32,
+        };
+
+        // Pure text queries are ranked and paged by FTS5, so only the
+        // returned page of documents is read. With several prefixes the
+        // scan below returns documents grouped by prefix, so without
+        // WITHSCORES keep using it.
+        let ranked = match &parsed.fts_query {
+            Some(fts_query)
+                if !text_fields.is_empty()
+                    && !prefixes.is_empty()
+                    && parsed.numeric_filters.is_empty()
+                    && parsed.tag_filters.is_empty()
+                    && options.sortby.is_none()
+                    && (prefixes.len() == 1 || options.withscores) =>
+            {
+                Self::ft_search_ranked(
+                    &conn,
+                    index_id,
+                    db,
+                    key_type_code,
+                    now,
+                    &prefixes,
+                    fts_query,
+                    options,
+                )?
+            }
+            _ => None,
+        };
+        if let Some((total_count, page)) = ranked {
+            let mut results = Vec::with_capacity(page.len());
+            for (key_id, key_name, score) in page {
+                let fields = if options.nocontent {
+                    HashMap::new()
+                } else {
+                    Self::ft_doc_fields(&conn, &on_type, &schema, key_id)?
+                };
+                results.push(self.ft_hit(key_name, score, &fields, options, &parsed));
+            }
+            return Ok((total_count, results));
+        }
+
         // If there's an FTS query, execute it on the FTS5 table to get matching documents and BM25 scores
         let fts_results: Option<HashMap<i64, f64>> = if let Some(fts_query) = &parsed.fts_query {
             if !text_fields.is_empty() {
@@ -12131,14 +13581,6 @@ impl Db {
         // Find matching keys with the index prefixes
         // Scan keys matching the prefixes with the appropriate type (HASH or JSON)
         let mut all_matching_keys: Vec<(i64, String)> = Vec::new();
-        let db = self.selected_db;
-        let now = Self::now_ms();
-
-        // Determine the key type to search for based on the index type
-        let key_type_code = match on_type {
-            FtOnType::Hash => KeyType::Hash as i32,
-            FtOnType::Json => KeyType::Json as i32,
-        };
 
         for prefix in &prefixes {
             let like_pattern = format!("{}%", prefix.replace('%', "\\%").replace('_', "\\_"));
@@ -12166,50 +13608,7 @@ impl Db {
 
         for (key_id, key_name) in &all_matching_keys {
             // Get all fields for this document (hash or JSON)
-            let fields: HashMap<String, Vec<u8>> = match on_type {
-                FtOnType::Hash => {
-                    let mut stmt = conn.prepare("SELECT field, value FROM hashes WHERE key_id = ?")?;
-                    let field_rows = stmt.query_map(params![key_id], |row| {
-                        Ok((row.get::<_, String>(0)?, row.get::<_, Vec<u8>>(1)?))
-                    })?;
-
-                    let mut fields_map: HashMap<String, Vec<u8>> = HashMap::new();
-                    for row in field_rows {
-                        if let Ok((field, value)) = row {
-                            fields_map.insert(field, value);
-                        }
-                    }
-                    fields_map
-                }
-                FtOnType::Json => {
-                    // For JSON documents, read the document and extract field values using JSONPath
-                    let doc_bytes: Option<Vec<u8>> = conn
-                        .query_row(
-                            "SELECT value FROM json_docs WHERE key_id = ?",
-                            params![key_id],
-                            |row| row.get(0),
-                        )
-                        .optional()?;
-
-                    if let Some(doc_bytes) = doc_bytes {
-                        if let Ok(doc) = serde_json::from_slice::<JsonValue>(&doc_bytes) {
-                            // Extract all schema fields from JSON using JSONPath
-                            let mut fields_map: HashMap<String, Vec<u8>> = HashMap::new();
-                            for field in &schema {
-                                let value = Self::extract_json_field_value(&doc, &field.name);
-                                if !value.is_empty() {
-                                    fields_map.insert(field.name.clone(), value.into_bytes());
-                                }
-                            }
-                            fields_map
-                        } else {
-                            HashMap::new()
-                        }
-                    } else {
-                        HashMap::new()
-                    }
-                }
-            };
+            let fields = Self::ft_doc_fields(&conn, &on_type, &schema, *key_id)?;
 
             // Check numeric filters
             let mut passes_numeric = true;
@@ -12315,78 +13714,7 @@ impl Db {
                 continue;
             }
 
-            // Build result
-            let mut result = FtSearchResult::new(key_name.clone(), score);
-
-            if !options.nocontent {
-                // Determine which fields to return
-                let fields_to_return: Vec<&String> = if options.return_fields.is_empty() {
-                    fields.keys().collect()
-                } else {
-                    options
-                        .return_fields
-                        .iter()
-                        .filter(|f| fields.contains_key(*f))
-                        .collect()
-                };
-
-                // Extract search terms for highlighting/summarization
-                let search_terms: Vec<String> = if options.highlight_tags.is_some()
-                    || options.summarize_len.is_some()
-                {
-                    parsed
-                        .fts_query
-                        .as_ref()
-                        .map(|q| self.extract_search_terms(q))
-                        .unwrap_or_default()
-                } else {
-                    Vec::new()
-                };
-
-                for field_name in fields_to_return {
-                    if let Some(value) = fields.get(field_name) {
-                        let mut processed_value = value.clone();
-
-                        // Try to convert to string for text processing
-                        if let Ok(text) = std::str::from_utf8(value) {
-                            let mut processed_text = text.to_string();
-
-                            // Apply summarization if requested for this field
-                            let should_summarize = options.summarize_len.is_some()
-                                && (options.summarize_fields.is_empty()
-                                    || options.summarize_fields.contains(field_name));
-
-                            if should_summarize {
-                                processed_text = self.apply_summarize(
-                                    &processed_text,
-                                    &search_terms,
-                                    options.summarize_len.unwrap_or(20),
-                                    options.summarize_frags.unwrap_or(3),
-                                    options.summarize_separator.as_deref().unwrap_or("..."),
-                                );
-                            }
-
-                            // Apply highlighting if requested for this field
-                            let should_highlight = options.highlight_tags.is_some()
-                                && (options.highlight_fields.is_empty()
-                                    || options.highlight_fields.contains(field_name));
-
-                            if should_highlight {
-                                if let Some((open, close)) = &options.highlight_tags {
-                                    processed_text =
-                                        self.apply_highlight(&processed_text, &search_terms, open, close);
-                                }
-                            }
-
-                            processed_value = processed_text.into_bytes();
-                        }
-
-                        result.fields.push((field_name.clone(), processed_value));
-                    }
-                }
-            }
-
-            results.push(result);
+            results.push(self.ft_hit(key_name.clone(), score, &fields, options, &parsed));
         }
 
         // Sort results
@@ -12449,6 +13777,232 @@ impl Db {
         Ok((total_count, paginated))
     }
 
+    /// Page of a full-text FT.SEARCH straight from the index's FTS5 table,
+    /// as (key_id, key, score) plus the total number of matches. Documents
+    /// are in key_id order, or best score first with WITHSCORES; LIMIT and
+    /// OFFSET run in SQLite, so a top-10 query never reads the other
+    /// matches. None if FTS5 rejects the query syntax (the caller then
+    /// falls back to matching documents itself); other errors are returned.
+    #[allow(clippy::too_many_arguments)]
+    fn ft_search_ranked(
+        conn: &Connection,
+        index_id: i64,
+        db: i32,
+        key_type: i32,
+        now: i64,
+        prefixes: &[String],
+        fts_query: &str,
+        options: &crate::types::FtSearchOptions,
+    ) -> Result<Option<(i64, Vec<(i64, String, f64)>)>> {
+        let table = format!("fts_idx_{}", index_id);
+        let prefix_filter = vec!["k.key LIKE ? ESCAPE '\\'"; prefixes.len()].join(" OR ");
+        let from = format!(
+            "FROM {t} JOIN keys k ON k.id = {t}.rowid
+             WHERE {t} MATCH ? AND k.db = ? AND k.type = ?
+             AND (k.expire_at IS NULL OR k.expire_at > ?) AND ({p})",
+            t = table,
+            p = prefix_filter
+        );
+        let order = if options.withscores {
+            format!("bm25({}), k.id", table)
+        } else {
+            "k.id".to_string()
+        };
+
+        let mut params_vec: Vec<Box<dyn rusqlite::ToSql>> = vec![
+            Box::new(fts_query.to_string()),
+            Box::new(db),
+            Box::new(key_type),
+            Box::new(now),
+        ];
+        for prefix in prefixes {
+            params_vec.push(Box::new(format!(
+                "{}%",
+                prefix.replace('%', "\\%").replace('_', "\\_")
+            )));
+        }
+        let filter_len = params_vec.len();
+        params_vec.push(Box::new(options.limit_num.max(0)));
+        params_vec.push(Box::new(options.limit_offset.max(0)));
+        let params_refs: Vec<&dyn rusqlite::ToSql> =
+            params_vec.iter().map(|b| b.as_ref()).collect();
+
+        let run = || -> rusqlite::Result<(i64, Vec<(i64, String, f64)>)> {
+            let total: i64 = conn
+                .prepare_cached(&format!("SELECT COUNT(*) {}", from))?
+                .query_row(&params_refs[..filter_len], |row| row.get(0))?;
+            if total == 0 || options.limit_num <= 0 {
+                return Ok((total, Vec::new()));
+            }
+            let mut stmt = conn.prepare_cached(&format!(
+                "SELECT k.id, k.key, -bm25({}) {} ORDER BY {} LIMIT ? OFFSET ?",
+                table, from, order
+            ))?;
+            let page = stmt
+                .query_map(params_refs.as_slice(), |row| {
+                    Ok((row.get(0)?, row.get(1)?, row.get(2)?))
+                })?
+                .collect::<rusqlite::Result<Vec<_>>>()?;
+            Ok((total, page))
+        };
+        match run() {
+            Ok(ranked) => Ok(Some(ranked)),
+            // The MATCH expression failed to parse: "fts5: syntax error near
+            // ...", or "no such column: x" for a field that has no column
+            Err(rusqlite::Error::SqliteFailure(_, Some(msg)))
+                if msg.starts_with("fts5: ") || msg.starts_with("no such column: ") =>
+            {
+                Ok(None)
+            }
+            Err(e) => Err(e.into()),
+        }
+    }
+
+    /// Fields of one indexed document: hash fields, or the schema fields
+    /// extracted from a JSON document
+    fn ft_doc_fields(
+        conn: &Connection,
+        on_type: &crate::types::FtOnType,
+        schema: &[crate::types::FtField],
+        key_id: i64,
+    ) -> Result<HashMap<String, Vec<u8>>> {
+        use crate::types::FtOnType;
+
+        let fields = match on_type {
+            FtOnType::Hash => {
+                let mut stmt = conn.prepare("SELECT field, value FROM hashes WHERE key_id = ?")?;
+                let field_rows = stmt.query_map(params![key_id], |row| {
+                    Ok((row.get::<_, String>(0)?, row.get::<_, Vec<u8>>(1)?))
+                })?;
+
+                let mut fields_map: HashMap<String, Vec<u8>> = HashMap::new();
+                for row in field_rows {
+                    if let Ok((field, value)) = row {
+                        fields_map.insert(field, value);
+                    }
+                }
+                fields_map
+            }
+            FtOnType::Json => {
+                // For JSON documents, read the document and extract field values using JSONPath
+                let doc_bytes: Option<Vec<u8>> = conn
+                    .query_row(
+                        "SELECT value FROM json_docs WHERE key_id = ?",
+                        params![key_id],
+                        |row| row.get(0),
+                    )
+                    .optional()?;
+
+                if let Some(doc_bytes) = doc_bytes {
+                    if let Ok(doc) = serde_json::from_slice::<JsonValue>(&doc_bytes) {
+                        // Extract all schema fields from JSON using JSONPath
+                        let mut fields_map: HashMap<String, Vec<u8>> = HashMap::new();
+                        for field in schema {
+                            let value = Self::extract_json_field_value(&doc, &field.name);
+                            if !value.is_empty() {
+                                fields_map.insert(field.name.clone(), value.into_bytes());
+                            }
+                        }
+                        fields_map
+                    } else {
+                        HashMap::new()
+                    }
+                } else {
+                    HashMap::new()
+                }
+            }
+        };
+        Ok(fields)
+    }
+
+    /// One FT.SEARCH hit with its returned fields, highlighted and
+    /// summarized as the options ask
+    fn ft_hit(
+        &self,
+        key_name: String,
+        score: f64,
+        fields: &HashMap<String, Vec<u8>>,
+        options: &crate::types::FtSearchOptions,
+        parsed: &crate::search::ParsedQuery,
+    ) -> crate::types::FtSearchResult {
+        use crate::types::FtSearchResult;
+
+        let mut result = FtSearchResult::new(key_name, score);
+
+        if !options.nocontent {
+            // Determine which fields to return
+            let fields_to_return: Vec<&String> = if options.return_fields.is_empty() {
+                fields.keys().collect()
+            } else {
+                options
+                    .return_fields
+                    .iter()
+                    .filter(|f| fields.contains_key(*f))
+                    .collect()
+            };
+
+            // Extract search terms for highlighting/summarization
+            let search_terms: Vec<String> =
+                if options.highlight_tags.is_some() || options.summarize_len.is_some() {
+                    parsed
+                        .fts_query
+                        .as_ref()
+                        .map(|q| self.extract_search_terms(q))
+                        .unwrap_or_default()
+                } else {
+                    Vec::new()
+                };
+
+            for field_name in fields_to_return {
+                if let Some(value) = fields.get(field_name) {
+                    let mut processed_value = value.clone();
+
+                    // Try to convert to string for text processing
+                    if let Ok(text) = std::str::from_utf8(value) {
+                        let mut processed_text = text.to_string();
+
+                        // Apply summarization if requested for this field
+                        let should_summarize = options.summarize_len.is_some()
+                            && (options.summarize_fields.is_empty()
+                                || options.summarize_fields.contains(field_name));
+
+                        if should_summarize {
+                            processed_text = self.apply_summarize(
+                                &processed_text,
+                                &search_terms,
+                                options.summarize_len.unwrap_or(20),
+                                options.summarize_frags.unwrap_or(3),
+                                options.summarize_separator.as_deref().unwrap_or("..."),
+                            );
+                        }
+
+                        // Apply highlighting if requested for this field
+                        let should_highlight = options.highlight_tags.is_some()
+                            && (options.highlight_fields.is_empty()
+                                || options.highlight_fields.contains(field_name));
+
+                        if should_highlight {
+                            if let Some((open, close)) = &options.highlight_tags {
+                                processed_text = self.apply_highlight(
+                                    &processed_text,
+                                    &search_terms,
+                                    open,
+                                    close,
+                                );
+                            }
+                        }
+
+                        processed_value = processed_text.into_bytes();
+                    }
+
+                    result.fields.push((field_name.clone(), processed_value));
+                }
+            }
+        }
+
+        result
+    }
+
     /// Aggregate search results with GROUPBY, REDUCE, SORTBY, APPLY, FILTER
     /// FT.AGGREGATE index query [options]
     pub fn ft_aggregate(
@@ -13190,6 +14744,7 @@ impl Db {
 
         let embedding_bytes = Self::embedding_to_bytes(embedding);
         let dimensions = embedding.len() as i32;
+        let norm = vectors::norm(embedding) as f64;
 
         // Check if element already exists
         let exists: bool = conn
@@ -13202,15 +14757,17 @@ impl Db {
             .unwrap_or(false);
 
         if exists {
-            // Update existing element
+            // Update existing element; it leaves its IVF list until the next VINDEX
             conn.execute(
-                "UPDATE vector_sets SET embedding = ?, dimensions = ?, quantization = ?, attributes = ?
+                "UPDATE vector_sets SET embedding = ?, dimensions = ?, quantization = ?, attributes = ?,
+                 norm = ?, list_id = NULL
                  WHERE key_id = ? AND element = ?",
                 params![
                     embedding_bytes,
                     dimensions,
                     quantization.as_str(),
                     attributes,
+                    norm,
                     key_id,
                     element
                 ],
@@ -13219,8 +14776,8 @@ impl Db {
         } else {
             // Insert new element
             conn.execute(
-                "INSERT INTO vector_sets (key_id, element, embedding, dimensions, quantization, attributes, created_at)
-                 VALUES (?, ?, ?, ?, ?, ?, ?)",
+                "INSERT INTO vector_sets (key_id, element, embedding, dimensions, quantization, attributes, created_at, norm)
+                 VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
                 params![
                     key_id,
                     element,
@@ -13228,7 +14785,8 @@ impl Db {
                     dimensions,
                     quantization.as_str(),
                     attributes,
-                    Self::now_ms()
+                    Self::now_ms(),
+                    norm
                 ],
             )?;
             Ok(true) // Added new
@@ -13419,9 +14977,30 @@ impl Db {
         count: Option<i64>,
         with_scores: bool,
         filter: Option<&str>,
+    ) -> Result<Vec<VectorSimResult>> {
+        self.vsim_nprobe(key, query, count, with_scores, filter, None)
+    }
+
+    /// VSIM with an explicit number of IVF lists to probe.
+    ///
+    /// When the set has an index (see `vindex`), only elements in the `nprobe`
+    /// lists whose centroids are closest to the query are scored, plus any
+    /// element added or updated since the index was built. `None` probes a
+    /// tenth of the lists; `Some(0)`, or a set without an index, scans every
+    /// element (exact results).
+    #[cfg(feature = "vectors")]
+    pub fn vsim_nprobe(
+        &self,
+        key: &str,
+        query: VectorInput,
+        count: Option<i64>,
+        with_scores: bool,
+        filter: Option<&str>,
+        nprobe: Option<usize>,
     ) -> Result<Vec<VectorSimResult>> {
         let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
-        let count = count.unwrap_or(10);
+        // Negative counts mean no limit
+        let count = usize::try_from(count.unwrap_or(10)).unwrap_or(usize::MAX);
 
         // Resolve query vector
         let query_embedding = match query {
@@ -13447,68 +15026,221 @@ impl Db {
             return Err(KvError::Other("query vector cannot be empty".to_string()));
         }
 
-        // Get all vectors for the key
-        let mut stmt = conn.prepare(
-            "SELECT v.element, v.embedding, v.attributes
-             FROM vector_sets v
-             JOIN keys k ON v.key_id = k.id
-             WHERE k.db = ? AND k.key = ?",
+        let key_id: i64 = match conn
+            .query_row(
+                "SELECT id FROM keys WHERE db = ? AND key = ? LIMIT 1",
+                params![self.selected_db, key],
+                |row| row.get(0),
+            )
+            .optional()?
+        {
+            Some(id) => id,
+            None => return Ok(vec![]),
+        };
+        let query_norm = vectors::norm(&query_embedding);
+
+        // Restrict the scan to the closest IVF lists when an index exists
+        let mut sql = String::from(
+            "SELECT element, embedding, norm, attributes FROM vector_sets WHERE key_id = ?1",
+        );
+        if nprobe != Some(0) {
+            let (list_ids, centroids) = Self::load_ivf_centroids(&conn, key_id)?;
+            let probe = nprobe
+                .unwrap_or((centroids.len() / 10).max(1))
+                .min(centroids.len());
+            if probe > 0 && probe < centroids.len() {
+                let probed: Vec<String> = vectors::nearest_n(&centroids, &query_embedding, probe)
+                    .into_iter()
+                    .map(|i| list_ids[i].to_string())
+                    .collect();
+                sql.push_str(&format!(
+                    " AND (list_id IS NULL OR list_id IN ({}))",
+                    probed.join(",")
+                ));
+            }
+        }
+
+        // Score blobs in place and keep only the best `count`; element names
+        // and attributes are only read for rows that make the cut
+        let mut stmt = conn.prepare(&sql)?;
+        let mut rows = stmt.query(params![key_id])?;
+        let mut top = vectors::TopK::new(count);
+        while let Some(row) = rows.next()? {
+            // Apply filter if provided (simple JSON attribute matching)
+            if let Some(filter_expr) = filter {
+                let matches = match row.get_ref(3)? {
+                    rusqlite::types::ValueRef::Text(attrs) => std::str::from_utf8(attrs)
+                        .map_or(false, |attrs| attrs.contains(filter_expr)),
+                    _ => false,
+                };
+                if !matches {
+                    continue;
+                }
+            }
+
+            let blob = Self::blob_column(row, 1)?;
+            // Rows from before norms were stored have NULL here
+            let norm = match row.get::<_, Option<f64>>(2)? {
+                Some(n) => n as f32,
+                None => vectors::norm_blob(blob),
+            };
+            // Cosine similarity (default metric for Redis 8)
+            let score = vectors::cosine(vectors::dot_blob(&query_embedding, blob), query_norm, norm);
+            if !top.accepts(score) {
+                continue;
+            }
+
+            top.push(
+                score,
+                VectorSimResult {
+                    element: row.get(0)?,
+                    score,
+                    attributes: if with_scores { row.get(3)? } else { None },
+                },
+            );
+        }
+
+        Ok(top.into_sorted().into_iter().map(|(_, r)| r).collect())
+    }
+
+    /// VINDEX - Build (or rebuild) the IVF index of a vector set
+    ///
+    /// Trains `nlist` centroids (default: sqrt of the cardinality) with
+    /// spherical k-means on a sample of the set, stores them in `vector_ivf`,
+    /// and assigns every element to its nearest centroid. Elements added
+    /// later are searched exhaustively until the next VINDEX.
+    /// Returns the number of lists built (0 for an empty set).
+    #[cfg(feature = "vectors")]
+    pub fn vindex(&self, key: &str, nlist: Option<usize>) -> Result<usize> {
+        const SAMPLE_PER_LIST: usize = 256;
+        const ITERATIONS: usize = 10;
+
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        let key_id: i64 = match conn
+            .query_row(
+                "SELECT id FROM keys WHERE db = ? AND key = ? LIMIT 1",
+                params![self.selected_db, key],
+                |row| row.get(0),
+            )
+            .optional()?
+        {
+            Some(id) => id,
+            None => return Ok(0),
+        };
+
+        let cardinality: i64 = conn.query_row(
+            "SELECT COUNT(*) FROM vector_sets WHERE key_id = ?",
+            params![key_id],
+            |row| row.get(0),
         )?;
+        if cardinality == 0 {
+            return Ok(0);
+        }
+        let cardinality = cardinality as usize;
+        let nlist = nlist
+            .unwrap_or_else(|| (cardinality as f64).sqrt().round() as usize)
+            .clamp(1, cardinality);
 
-        let mut results: Vec<VectorSimResult> = stmt
-            .query_map(params![self.selected_db, key], |row| {
-                let element: String = row.get(0)?;
-                let embedding_bytes: Vec<u8> = row.get(1)?;
-                let attributes: Option<String> = row.get(2)?;
-                Ok((element, embedding_bytes, attributes))
-            })?
-            .filter_map(|r| r.ok())
-            .filter_map(|(element, embedding_bytes, attributes)| {
-                let embedding = Self::bytes_to_embedding(&embedding_bytes);
-
-                // Apply filter if provided (simple JSON attribute matching)
-                if let Some(filter_expr) = filter {
-                    if let Some(ref attrs) = attributes {
-                        if !attrs.contains(filter_expr) {
-                            return None;
-                        }
-                    } else {
-                        return None;
-                    }
+        // Evenly spaced training sample
+        let stride = (cardinality / (nlist * SAMPLE_PER_LIST)).max(1);
+        let sample: Vec<Vec<f32>> = {
+            let mut stmt = conn.prepare(
+                "SELECT embedding FROM vector_sets WHERE key_id = ? ORDER BY id",
+            )?;
+            let mut rows = stmt.query(params![key_id])?;
+            let mut sample = Vec::with_capacity(cardinality / stride + 1);
+            let mut i = 0usize;
+            while let Some(row) = rows.next()? {
+                if i % stride == 0 {
+                    sample.push(vectors::decode(Self::blob_column(row, 0)?));
                 }
+                i += 1;
+            }
+            sample
+        };
+        let centroids = vectors::train_centroids(&sample, nlist, ITERATIONS);
 
-                // Calculate cosine similarity (default metric for Redis 8)
-                let dot: f32 = query_embedding
-                    .iter()
-                    .zip(embedding.iter())
-                    .map(|(a, b)| a * b)
-                    .sum();
-                let norm_a: f32 = query_embedding.iter().map(|x| x.powi(2)).sum::<f32>().sqrt();
-                let norm_b: f32 = embedding.iter().map(|x| x.powi(2)).sum::<f32>().sqrt();
-
-                let score = if norm_a == 0.0 || norm_b == 0.0 {
-                    0.0
-                } else {
-                    (dot / (norm_a * norm_b)) as f64
-                };
+        Self::in_savepoint(&conn, || {
+            conn.execute("DELETE FROM vector_ivf WHERE key_id = ?", params![key_id])?;
+            let mut insert = conn.prepare_cached(
+                "INSERT INTO vector_ivf (key_id, list_id, centroid) VALUES (?, ?, ?)",
+            )?;
+            for (list_id, centroid) in centroids.iter().enumerate() {
+                insert.execute(params![
+                    key_id,
+                    list_id as i64,
+                    Self::embedding_to_bytes(centroid)
+                ])?;
+            }
+
+            // Assign every element, back-filling norms from older rows
+            let assignments: Vec<(i64, i64, f64)> = {
+                let mut stmt = conn.prepare("SELECT id, embedding FROM vector_sets WHERE key_id = ?")?;
+                let mut rows = stmt.query(params![key_id])?;
+                let mut out = Vec::with_capacity(cardinality);
+                while let Some(row) = rows.next()? {
+                    let v = vectors::decode(Self::blob_column(row, 1)?);
+                    out.push((
+                        row.get(0)?,
+                        vectors::nearest(&centroids, &v) as i64,
+                        vectors::norm(&v) as f64,
+                    ));
+                }
+                out
+            };
+            let mut update =
+                conn.prepare_cached("UPDATE vector_sets SET list_id = ?, norm = ? WHERE id = ?")?;
+            for (id, list_id, norm) in assignments {
+                update.execute(params![list_id, norm, id])?;
+            }
+            Ok(centroids.len())
+        })
+    }
 
-                Some(VectorSimResult {
-                    element,
-                    score,
-                    attributes: if with_scores { attributes } else { None },
-                })
-            })
-            .collect();
+    /// Drop the IVF index of a vector set; VSIM goes back to exact scans
+    #[cfg(feature = "vectors")]
+    pub fn vindex_drop(&self, key: &str) -> Result<bool> {
+        let conn = self.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+        Self::in_savepoint(&conn, || {
+            let dropped = conn.execute(
+                "DELETE FROM vector_ivf WHERE key_id IN (
+                    SELECT id FROM keys WHERE db = ? AND key = ?
+                 )",
+                params![self.selected_db, key],
+            )?;
+            conn.execute(
+                "UPDATE vector_sets SET list_id = NULL WHERE key_id IN (
+                    SELECT id FROM keys WHERE db = ? AND key = ?
+                 )",
+                params![self.selected_db, key],
+            )?;
+            Ok(dropped > 0)
+        })
+    }
 
-        // Sort by score (descending - higher similarity first)
-        results.sort_by(|a, b| {
-            b.score
-                .partial_cmp(&a.score)
-                .unwrap_or(std::cmp::Ordering::Equal)
-        });
-        results.truncate(count as usize);
+    /// Helper: borrow a BLOB column without copying it (other types read as empty)
+    #[cfg(feature = "vectors")]
+    fn blob_column<'a>(row: &'a rusqlite::Row<'_>, idx: usize) -> Result<&'a [u8]> {
+        match row.get_ref(idx)? {
+            rusqlite::types::ValueRef::Blob(bytes) => Ok(bytes),
+            _ => Ok(&[]),
+        }
+    }
 
-        Ok(results)
+    /// Helper: IVF list ids and centroids of a vector set (empty if unindexed)
+    #[cfg(feature = "vectors")]
+    fn load_ivf_centroids(conn: &Connection, key_id: i64) -> Result<(Vec<i64>, Vec<Vec<f32>>)> {
+        let mut stmt = conn.prepare_cached(
+            "SELECT list_id, centroid FROM vector_ivf WHERE key_id = ? ORDER BY list_id",
+        )?;
+        let mut rows = stmt.query(params![key_id])?;
+        let mut ids = Vec::new();
+        let mut centroids = Vec::new();
+        while let Some(row) = rows.next()? {
+            ids.push(row.get(0)?);
+            centroids.push(vectors::decode(Self::blob_column(row, 1)?));
+        }
+        Ok((ids, centroids))
     }
 
     // ========================================================================
@@ -13558,7 +15290,6 @@ impl Db {
     /// Haversine formula to calculate distance between two points in meters
     #[cfg(feature = "geo")]
     fn haversine(lon1: f64, lat1: f64, lon2: f64, lat2: f64) -> f64 {
-        const EARTH_RADIUS_M: f64 = 6371000.0;
         let lat1_rad = lat1.to_radians();
         let lat2_rad = lat2.to_radians();
         let delta_lat = (lat2 - lat1).to_radians();
@@ -13568,7 +15299,7 @@ impl Db {
             + lat1_rad.cos() * lat2_rad.cos() * (delta_lon / 2.0).sin().powi(2);
         let c = 2.0 * a.sqrt().atan2((1.0 - a).sqrt());
 
-        EARTH_RADIUS_M * c
+        GEO_EARTH_RADIUS_M * c
     }
 
     /// Encode longitude/latitude as an 11-character geohash
@@ -13617,20 +15348,52 @@ impl Db {
         hash
     }
 
-    /// Compute bounding box for radius query (returns min_lon, max_lon, min_lat, max_lat)
+    /// Latitude and longitude half-extents, in degrees, of the smallest box
+    /// holding every point within `radius_m` of a center at `lat`
     #[cfg(feature = "geo")]
-    fn bounding_box(lon: f64, lat: f64, radius_m: f64) -> (f64, f64, f64, f64) {
-        // Approximate: 111320 meters per degree latitude
-        let lat_delta = radius_m / 111320.0;
-        // Longitude degrees shrink toward poles
-        let lon_delta = radius_m / (111320.0 * lat.to_radians().cos().abs().max(0.0001));
+    fn radius_extent(lat: f64, radius_m: f64) -> (f64, f64) {
+        let angle = radius_m / GEO_EARTH_RADIUS_M;
+        let lat_delta = angle.to_degrees();
+        // Widest longitude spread of a spherical cap; the whole circle of
+        // longitude once the cap reaches a pole
+        let s = angle.sin() / lat.to_radians().cos();
+        let lon_delta = if angle >= std::f64::consts::FRAC_PI_2 || s >= 1.0 {
+            180.0
+        } else {
+            s.asin().to_degrees()
+        };
+        (lat_delta, lon_delta)
+    }
 
-        (
-            (lon - lon_delta).max(-180.0),
-            (lon + lon_delta).min(180.0),
-            (lat - lat_delta).max(-85.05112878),
-            (lat + lat_delta).min(85.05112878),
-        )
+    /// Half-extents, in degrees, of a BYBOX search. Widths are measured
+    /// along the great circle through the center at its latitude, the same
+    /// way GEOSEARCH tests each point.
+    #[cfg(feature = "geo")]
+    fn box_extent(lat: f64, width_m: f64, height_m: f64) -> (f64, f64) {
+        let lat_delta = (height_m / 2.0 / GEO_EARTH_RADIUS_M).to_degrees();
+        let s = (width_m / 4.0 / GEO_EARTH_RADIUS_M).sin() / lat.to_radians().cos();
+        let lon_delta = if s >= 1.0 {
+            180.0
+        } else {
+            (2.0 * s.asin()).to_degrees()
+        };
+        (lat_delta, lon_delta)
+    }
+
+    /// Longitude ranges covering `center ± delta`, split in two where the
+    /// span crosses the antimeridian
+    #[cfg(feature = "geo")]
+    fn lon_ranges(center: f64, delta: f64) -> Vec<(f64, f64)> {
+        let (lo, hi) = (center - delta, center + delta);
+        if delta >= 180.0 {
+            vec![(-180.0, 180.0)]
+        } else if lo < -180.0 {
+            vec![(lo + 360.0, 180.0), (-180.0, hi)]
+        } else if hi > 180.0 {
+            vec![(lo, 180.0), (-180.0, hi - 360.0)]
+        } else {
+            vec![(lo, hi)]
+        }
     }
 
     /// Validate geo coordinates (Redis limits)
@@ -13854,106 +15617,104 @@ impl Db {
             ));
         };
 
-        // Get search area
-        let (radius_m, is_box, box_dims) = if let Some((radius, unit)) = options.by_radius {
-            (unit.to_meters(radius), false, (0.0, 0.0))
-        } else if let Some((width, height, unit)) = options.by_box {
-            // For box, use diagonal/2 as radius for R*Tree pre-filter
-            let w_m = unit.to_meters(width);
-            let h_m = unit.to_meters(height);
-            let radius = (w_m * w_m + h_m * h_m).sqrt() / 2.0;
-            (radius, true, (w_m, h_m))
-        } else {
-            return Err(KvError::Other(
-                "ERR BYRADIUS or BYBOX required".to_string(),
-            ));
-        };
-
-        // Compute bounding box for R*Tree query
-        let (min_lon, max_lon, min_lat, max_lat) =
-            Self::bounding_box(center_lon, center_lat, radius_m);
-
-        // Query R*Tree for candidates, then join with geo_data
-        let mut stmt = conn.prepare(
+        // Get search area, plus its half-extents in degrees around the center
+        let (radius_m, half_box, (lat_delta, lon_delta)) =
+            if let Some((radius, unit)) = options.by_radius {
+                let radius_m = unit.to_meters(radius);
+                (radius_m, None, Self::radius_extent(center_lat, radius_m))
+            } else if let Some((width, height, unit)) = options.by_box {
+                let (w_m, h_m) = (unit.to_meters(width), unit.to_meters(height));
+                (
+                    0.0,
+                    Some((w_m / 2.0, h_m / 2.0)),
+                    Self::box_extent(center_lat, w_m, h_m),
+                )
+            } else {
+                return Err(KvError::Other("ERR BYRADIUS or BYBOX required".to_string()));
+            };
+        let unit = options
+            .by_radius
+            .map(|(_, u)| u)
+            .or(options.by_box.map(|(_, _, u)| u))
+            .unwrap_or(crate::types::GeoUnit::Meters);
+        let min_lat = center_lat - lat_delta;
+        let max_lat = center_lat + lat_delta;
+
+        // The R*Tree drives the query (CROSS JOIN pins the join order) so only
+        // points inside the bounding box are visited, however many the key
+        // holds. Overlap tests tolerate the R*Tree's outward float32 rounding.
+        let mut stmt = conn.prepare_cached(
             "SELECT g.member, g.longitude, g.latitude, g.geohash
-             FROM geo_data g
-             INNER JOIN geo_rtree r ON g.id = r.id
-             WHERE g.key_id = ?1
-               AND r.min_lon >= ?2 AND r.max_lon <= ?3
-               AND r.min_lat >= ?4 AND r.max_lat <= ?5",
-        )?;
-
-        let candidates = stmt.query_map(
-            params![key_id, min_lon, max_lon, min_lat, max_lat],
-            |row| {
-                Ok((
-                    row.get::<_, String>(0)?,
-                    row.get::<_, f64>(1)?,
-                    row.get::<_, f64>(2)?,
-                    row.get::<_, String>(3)?,
-                ))
-            },
+             FROM geo_rtree r
+             CROSS JOIN geo_data g ON g.id = r.id
+             WHERE r.max_lon >= ?1 AND r.min_lon <= ?2
+               AND r.max_lat >= ?3 AND r.min_lat <= ?4
+               AND g.key_id = ?5",
         )?;
 
-        let mut results: Vec<crate::types::GeoMember> = Vec::new();
-
-        for candidate in candidates {
-            let (member, lon, lat, geohash) = candidate?;
-            let dist_m = Self::haversine(center_lon, center_lat, lon, lat);
+        // With COUNT ANY the first `count` matches are enough
+        let stop_at = if options.any { options.count } else { None };
+        let mut matches: Vec<(f64, crate::types::GeoMember)> = Vec::new();
 
-            // Apply precise filter
-            let in_range = if is_box {
-                // Box filter: check if within box dimensions
-                let (box_w_m, box_h_m) = box_dims;
-                let dx = Self::haversine(center_lon, center_lat, lon, center_lat);
-                let dy = Self::haversine(center_lon, center_lat, center_lon, lat);
-                dx <= box_w_m / 2.0 && dy <= box_h_m / 2.0
-            } else {
-                dist_m <= radius_m
-            };
+        'ranges: for (min_lon, max_lon) in Self::lon_ranges(center_lon, lon_delta) {
+            let mut rows = stmt.query(params![min_lon, max_lon, min_lat, max_lat, key_id])?;
+            while let Some(row) = rows.next()? {
+                let lon: f64 = row.get(1)?;
+                let lat: f64 = row.get(2)?;
+                let dist_m = Self::haversine(center_lon, center_lat, lon, lat);
+
+                // Apply precise filter
+                let in_range = match half_box {
+                    Some((half_w, half_h)) => {
+                        Self::haversine(center_lon, center_lat, lon, center_lat) <= half_w
+                            && Self::haversine(center_lon, center_lat, center_lon, lat) <= half_h
+                    }
+                    None => dist_m <= radius_m,
+                };
+                if !in_range {
+                    continue;
+                }
 
-            if in_range {
-                results.push(crate::types::GeoMember {
-                    member,
-                    longitude: lon,
-                    latitude: lat,
-                    geohash: if options.with_hash {
-                        Some(geohash)
-                    } else {
-                        None
-                    },
-                    distance: if options.with_dist {
-                        // Convert to requested unit (default meters)
-                        let unit = options
-                            .by_radius
-                            .map(|(_, u)| u)
-                            .or(options.by_box.map(|(_, _, u)| u))
-                            .unwrap_or(crate::types::GeoUnit::Meters);
-                        Some(unit.from_meters(dist_m))
-                    } else {
-                        None
+                matches.push((
+                    dist_m,
+                    crate::types::GeoMember {
+                        member: row.get(0)?,
+                        longitude: lon,
+                        latitude: lat,
+                        geohash: if options.with_hash {
+                            Some(row.get(3)?)
+                        } else {
+                            None
+                        },
+                        distance: if options.with_dist {
+                            Some(unit.from_meters(dist_m))
+                        } else {
+                            None
+                        },
                     },
-                });
+                ));
+                if stop_at.map_or(false, |n| matches.len() >= n) {
+                    break 'ranges;
+                }
             }
         }
 
-        // Sort by distance
-        results.sort_by(|a, b| {
-            let dist_a = Self::haversine(center_lon, center_lat, a.longitude, a.latitude);
-            let dist_b = Self::haversine(center_lon, center_lat, b.longitude, b.latitude);
+        // Sort by distance, computed once per match
+        matches.sort_by(|a, b| {
+            let ord = a.0.partial_cmp(&b.0).unwrap_or(std::cmp::Ordering::Equal);
             if options.ascending {
-                dist_a.partial_cmp(&dist_b).unwrap_or(std::cmp::Ordering::Equal)
+                ord
             } else {
-                dist_b.partial_cmp(&dist_a).unwrap_or(std::cmp::Ordering::Equal)
+                ord.reverse()
             }
         });
 
         // Apply COUNT limit
         if let Some(count) = options.count {
-            results.truncate(count);
+            matches.truncate(count);
         }
 
-        Ok(results)
+        Ok(matches.into_iter().map(|(_, m)| m).collect())
     }
 
     /// GEOSEARCHSTORE dest src [options] [STOREDIST]
@@ -14447,108 +16208,532 @@ mod tests {
     }
 
     #[test]
-    fn test_scan_empty() {
+    fn test_scan_empty() {
+        let db = Db::open_memory().unwrap();
+
+        let (cursor, keys) = db.scan("0", None, 10).unwrap();
+        assert_eq!(cursor, "0");
+        assert!(keys.is_empty());
+    }
+
+    // --- Session 3: String operations tests ---
+
+    #[test]
+    fn test_incr() {
+        let db = Db::open_memory().unwrap();
+
+        // Increment non-existent key (starts at 0)
+        assert_eq!(db.incr("counter").unwrap(), 1);
+        assert_eq!(db.incr("counter").unwrap(), 2);
+        assert_eq!(db.incr("counter").unwrap(), 3);
+
+        // Increment existing integer
+        db.set("num", b"10", None).unwrap();
+        assert_eq!(db.incr("num").unwrap(), 11);
+    }
+
+    #[test]
+    fn test_incr_not_integer() {
+        let db = Db::open_memory().unwrap();
+
+        db.set("str", b"hello", None).unwrap();
+        assert!(db.incr("str").is_err());
+    }
+
+    #[test]
+    fn test_decr() {
+        let db = Db::open_memory().unwrap();
+
+        // Decrement non-existent key (starts at 0)
+        assert_eq!(db.decr("counter").unwrap(), -1);
+        assert_eq!(db.decr("counter").unwrap(), -2);
+
+        // Decrement existing integer
+        db.set("num", b"10", None).unwrap();
+        assert_eq!(db.decr("num").unwrap(), 9);
+    }
+
+    #[test]
+    fn test_incrby() {
+        let db = Db::open_memory().unwrap();
+
+        assert_eq!(db.incrby("counter", 5).unwrap(), 5);
+        assert_eq!(db.incrby("counter", 10).unwrap(), 15);
+        assert_eq!(db.incrby("counter", -3).unwrap(), 12);
+    }
+
+    #[test]
+    fn test_decrby() {
+        let db = Db::open_memory().unwrap();
+
+        db.set("num", b"100", None).unwrap();
+        assert_eq!(db.decrby("num", 30).unwrap(), 70);
+        assert_eq!(db.decrby("num", 80).unwrap(), -10);
+    }
+
+    #[test]
+    fn test_incrbyfloat() {
+        let db = Db::open_memory().unwrap();
+
+        // Start from 0
+        let result = db.incrbyfloat("float", 0.1).unwrap();
+        assert!(result.starts_with("0.1"));
+
+        // Increment existing float
+        db.set("pi", b"3.14", None).unwrap();
+        let result = db.incrbyfloat("pi", 0.01).unwrap();
+        assert!(result.starts_with("3.15"));
+    }
+
+    #[test]
+    fn test_mget() {
+        let db = Db::open_memory().unwrap();
+
+        db.set("a", b"1", None).unwrap();
+        db.set("b", b"2", None).unwrap();
+        db.set("c", b"3", None).unwrap();
+
+        let values = db.mget(&["a", "b", "c", "d"]);
+        assert_eq!(values.len(), 4);
+        assert_eq!(values[0], Some(b"1".to_vec()));
+        assert_eq!(values[1], Some(b"2".to_vec()));
+        assert_eq!(values[2], Some(b"3".to_vec()));
+        assert_eq!(values[3], None);
+    }
+
+    #[test]
+    fn test_mset() {
+        let db = Db::open_memory().unwrap();
+
+        db.mset(&[("a", b"1"), ("b", b"2"), ("c", b"3")]).unwrap();
+
+        assert_eq!(db.get("a").unwrap(), Some(b"1".to_vec()));
+        assert_eq!(db.get("b").unwrap(), Some(b"2".to_vec()));
+        assert_eq!(db.get("c").unwrap(), Some(b"3".to_vec()));
+    }
+
+    #[test]
+    fn test_sqlite_stats() {
+        let db = Db::open_memory().unwrap();
+        for i in 0..10 {
+            db.set(&format!("k{}", i), b"v", None).unwrap();
+            db.get(&format!("k{}", i)).unwrap();
+        }
+        db.checkpoint().unwrap();
+
+        let stats = db.sqlite_stats().unwrap();
+        assert!(stats.statements > 0);
+        assert!(stats.statement_bytes > 0);
+        assert!(stats.statement_reuses() > 0);
+        assert!(stats.cache_hits > 0);
+        assert_eq!(stats.checkpoints, 1);
+        assert!(stats.checkpoint_max_us <= stats.checkpoint_total_us);
+    }
+
+    #[test]
+    fn test_statement_cache_reuse() {
+        let db = Db::open_memory().unwrap();
+        assert_eq!(db.statement_cache_capacity(), 256);
+
+        let round = |i: i64| {
+            let v = i.to_string();
+            db.set("s", v.as_bytes(), None).unwrap();
+            db.get("s").unwrap();
+            db.hset("h", &[("f", v.as_bytes())]).unwrap();
+            db.hget("h", "f").unwrap();
+            db.lpush("l", &[v.as_bytes()]).unwrap();
+            db.lrange("l", 0, 9).unwrap();
+            db.zadd("z", &[ZMember { score: i as f64, member: v.clone().into_bytes() }]).unwrap();
+            db.zrange("z", 0, 9, true).unwrap();
+            db.expire("s", 100).unwrap();
+        };
+
+        round(0);
+        let warm = db.sqlite_stats().unwrap();
+        for i in 1..=50 {
+            round(i);
+        }
+        let stats = db.sqlite_stats().unwrap();
+        // Every statement the hot commands run was prepared in the first round
+        assert_eq!(stats.statements, warm.statements);
+        assert!(stats.statement_runs - warm.statement_runs >= 50 * 9);
+
+        db.set_statement_cache_capacity(0);
+        assert_eq!(db.statement_cache_capacity(), 0);
+        assert!(db.sqlite_stats().unwrap().statements < warm.statements);
+    }
+
+    #[test]
+    fn test_open_with_options() {
+        use crate::types::Synchronous;
+
+        let db_path = std::env::temp_dir().join(format!(
+            "redlite_open_options_test_{}.db",
+            std::process::id()
+        ));
+        let db_path_str = db_path.to_str().unwrap();
+        let _ = std::fs::remove_file(&db_path);
+
+        let options = OpenOptions::new()
+            .cache_mb(8)
+            .mmap_size(0)
+            .synchronous(Synchronous::Full)
+            .page_size(16384)
+            .wal_autocheckpoint(0)
+            .statement_cache(32);
+        let db = Db::open_with_options(db_path_str, &options).unwrap();
+        db.set("k", b"v", None).unwrap();
+        assert_eq!(db.statement_cache_capacity(), 32);
+
+        {
+            let conn = db.core.conn.lock().unwrap();
+            let pragma = |name: &str| -> i64 {
+                conn.query_row(&format!("PRAGMA {}", name), [], |row| row.get(0))
+                    .unwrap()
+            };
+            assert_eq!(pragma("page_size"), 16384);
+            assert_eq!(pragma("synchronous"), 2);
+            assert_eq!(pragma("cache_size"), -8000);
+            assert_eq!(pragma("mmap_size"), 0);
+            assert_eq!(pragma("wal_autocheckpoint"), 0);
+            assert_eq!(pragma("temp_store"), 2);
+        }
+        drop(db);
+
+        assert!(Db::open_with_options(":memory:", &OpenOptions::new().page_size(1000)).is_err());
+
+        let _ = std::fs::remove_file(&db_path);
+        let _ = std::fs::remove_file(format!("{}-shm", db_path_str));
+        let _ = std::fs::remove_file(format!("{}-wal", db_path_str));
+    }
+
+    #[test]
+    fn test_bulk_load_types() {
         let db = Db::open_memory().unwrap();
+        db.set("old", b"x", None).unwrap();
 
-        let (cursor, keys) = db.scan("0", None, 10).unwrap();
-        assert_eq!(cursor, "0");
-        assert!(keys.is_empty());
-    }
+        let records = [
+            BulkRecord::String { key: "s", value: b"v", ttl: None },
+            BulkRecord::String { key: "old", value: b"y", ttl: Some(Duration::from_secs(100)) },
+            BulkRecord::Hash { key: "h", field: "a", value: b"1" },
+            BulkRecord::Hash { key: "h", field: "b", value: b"2" },
+            BulkRecord::Set { key: "st", member: b"m" },
+            BulkRecord::Set { key: "st", member: b"m" },
+            BulkRecord::ZSet { key: "z", member: b"a", score: 1.5 },
+            BulkRecord::ZSet { key: "z", member: b"a", score: 2.5 },
+        ];
+        assert_eq!(db.bulk_load(&records, false).unwrap(), 8);
 
-    // --- Session 3: String operations tests ---
+        assert_eq!(db.get("s").unwrap(), Some(b"v".to_vec()));
+        assert_eq!(db.get("old").unwrap(), Some(b"y".to_vec()));
+        assert!(db.ttl("old").unwrap() > 0);
+        assert_eq!(db.hget("h", "b").unwrap(), Some(b"2".to_vec()));
+        assert_eq!(db.smembers("st").unwrap(), vec![b"m".to_vec()]);
+        assert_eq!(db.zscore("z", b"a").unwrap(), Some(2.5));
+
+        // A second batch updates existing keys
+        db.bulk_load(&[BulkRecord::Hash { key: "h", field: "c", value: b"3" }], false).unwrap();
+        assert_eq!(db.hgetall("h").unwrap().len(), 3);
+        db.bulk_load(&[BulkRecord::String { key: "old", value: b"z", ttl: None }], false).unwrap();
+        assert_eq!(db.ttl("old").unwrap(), -1);
+    }
 
     #[test]
-    fn test_incr() {
+    fn test_bulk_load_wrong_type_rolls_back() {
         let db = Db::open_memory().unwrap();
+        db.hset("h", &[("f", b"v".as_slice())]).unwrap();
 
-        // Increment non-existent key (starts at 0)
-        assert_eq!(db.incr("counter").unwrap(), 1);
-        assert_eq!(db.incr("counter").unwrap(), 2);
-        assert_eq!(db.incr("counter").unwrap(), 3);
+        let result = db.bulk_load(
+            &[
+                BulkRecord::String { key: "new", value: b"v", ttl: None },
+                BulkRecord::ZSet { key: "h", member: b"m", score: 1.0 },
+            ],
+            false,
+        );
+        assert!(matches!(result, Err(KvError::WrongType)));
+        assert_eq!(db.get("new").unwrap(), None);
 
-        // Increment existing integer
-        db.set("num", b"10", None).unwrap();
-        assert_eq!(db.incr("num").unwrap(), 11);
+        // Strings replace other types, like SET
+        db.bulk_load(&[BulkRecord::String { key: "h", value: b"s", ttl: None }], false).unwrap();
+        assert_eq!(db.get("h").unwrap(), Some(b"s".to_vec()));
     }
 
     #[test]
-    fn test_incr_not_integer() {
+    fn test_bulk_deferred_indexes_and_fts() {
         let db = Db::open_memory().unwrap();
+        db.fts_enable_global().unwrap();
 
-        db.set("str", b"hello", None).unwrap();
-        assert!(db.incr("str").is_err());
+        db.bulk_begin(true).unwrap();
+        let values: Vec<String> = (0..100).map(|i| format!("document number {}", i)).collect();
+        let keys: Vec<String> = (0..100).map(|i| format!("doc:{}", i)).collect();
+        let records: Vec<BulkRecord> = keys
+            .iter()
+            .zip(&values)
+            .map(|(k, v)| BulkRecord::String { key: k, value: v.as_bytes(), ttl: None })
+            .collect();
+        db.bulk_load(&records, true).unwrap();
+        assert!(db.fts_search("document", Some(1000), false).unwrap().is_empty());
+
+        db.bulk_finish(true).unwrap();
+        assert_eq!(db.fts_search("document", Some(1000), false).unwrap().len(), 100);
+        let conn = db.core.conn.lock().unwrap();
+        let rebuilt: i64 = conn
+            .query_row(
+                "SELECT COUNT(*) FROM sqlite_master WHERE type = 'index'
+                 AND name IN ('idx_keys_type', 'idx_keys_last_accessed', 'idx_zsets_score')",
+                [],
+                |row| row.get(0),
+            )
+            .unwrap();
+        assert_eq!(rebuilt, 3);
     }
 
     #[test]
-    fn test_decr() {
-        let db = Db::open_memory().unwrap();
-
-        // Decrement non-existent key (starts at 0)
-        assert_eq!(db.decr("counter").unwrap(), -1);
-        assert_eq!(db.decr("counter").unwrap(), -2);
+    fn test_snapshot_round_trip() {
+        let dir = tempfile::tempdir().unwrap();
+        let path = dir.path().join("snap.rls");
+        let path = path.to_str().unwrap();
 
-        // Decrement existing integer
-        db.set("num", b"10", None).unwrap();
-        assert_eq!(db.decr("num").unwrap(), 9);
+        let mut src = Db::open_memory().unwrap();
+        src.set("s", b"value", None).unwrap();
+        src.set("ttl", b"v", Some(Duration::from_secs(100)))
+            .unwrap();
+        src.set("gone", b"v", Some(Duration::from_millis(1)))
+            .unwrap();
+        src.hset("h", &[("f1", b"v1".as_slice()), ("f2", b"v2".as_slice())])
+            .unwrap();
+        src.rpush("l", &[b"a".as_slice(), b"b".as_slice()]).unwrap();
+        src.lpush("l", &[b"z".as_slice()]).unwrap();
+        src.sadd("st", &[b"m1".as_slice(), b"m2".as_slice()])
+            .unwrap();
+        src.zadd("z", &[ZMember::new(1.5, "one"), ZMember::new(-2.0, "two")])
+            .unwrap();
+        let fields = [(b"k".as_slice(), b"v".as_slice())];
+        src.xadd(
+            "x",
+            Some(StreamId::new(5, 1)),
+            &fields,
+            false,
+            None,
+            None,
+            false,
+        )
+        .unwrap();
+        src.json_set("j", "$", r#"{"a":[1,2]}"#, false, false)
+            .unwrap();
+        #[cfg(feature = "geo")]
+        src.geoadd(
+            "g",
+            &[(13.361389, 38.115556, "Palermo")],
+            false,
+            false,
+            false,
+        )
+        .unwrap();
+        src.select(1).unwrap();
+        src.set("other", b"db1", None).unwrap();
+        src.select(0).unwrap();
+        std::thread::sleep(Duration::from_millis(5));
+
+        let exported = src.export_snapshot(path).unwrap();
+        assert_eq!(exported.keys, if cfg!(feature = "geo") { 10 } else { 9 });
+        assert_eq!(exported.bytes, std::fs::metadata(path).unwrap().len());
+
+        // Snapshot keys replace existing ones
+        let mut dst = Db::open_memory().unwrap();
+        dst.set("s", b"old", None).unwrap();
+        dst.hset("h", &[("stale", b"x".as_slice())]).unwrap();
+        assert_eq!(dst.import_snapshot(path).unwrap(), exported);
+
+        assert_eq!(dst.get("s").unwrap(), Some(b"value".to_vec()));
+        let ttl = dst.pttl("ttl").unwrap();
+        assert!(ttl > 0 && ttl <= 100_000);
+        assert_eq!(dst.get("gone").unwrap(), None);
+        let mut fields = dst.hgetall("h").unwrap();
+        fields.sort();
+        assert_eq!(
+            fields,
+            vec![
+                ("f1".to_string(), b"v1".to_vec()),
+                ("f2".to_string(), b"v2".to_vec())
+            ]
+        );
+        dst.rpush("l", &[b"c".as_slice()]).unwrap();
+        assert_eq!(
+            dst.lrange("l", 0, -1).unwrap(),
+            vec![b"z".to_vec(), b"a".to_vec(), b"b".to_vec(), b"c".to_vec()]
+        );
+        assert_eq!(dst.scard("st").unwrap(), 2);
+        assert_eq!(dst.zscore("z", b"two").unwrap(), Some(-2.0));
+        let entries = dst
+            .xrange("x", StreamId::min(), StreamId::max(), None)
+            .unwrap();
+        assert_eq!(entries.len(), 1);
+        assert_eq!(entries[0].id, StreamId::new(5, 1));
+        assert_eq!(
+            dst.json_get("j", &[]).unwrap(),
+            src.json_get("j", &[]).unwrap()
+        );
+        #[cfg(feature = "geo")]
+        assert_eq!(
+            dst.geopos("g", &["Palermo"]).unwrap(),
+            src.geopos("g", &["Palermo"]).unwrap()
+        );
+        dst.select(1).unwrap();
+        assert_eq!(dst.get("other").unwrap(), Some(b"db1".to_vec()));
     }
 
     #[test]
-    fn test_incrby() {
-        let db = Db::open_memory().unwrap();
+    fn test_snapshot_from_file_db_and_corruption() {
+        let dir = tempfile::tempdir().unwrap();
+        let db_path = dir.path().join("src.db");
+        let snap = dir.path().join("snap.rls");
+        let snap = snap.to_str().unwrap();
 
-        assert_eq!(db.incrby("counter", 5).unwrap(), 5);
-        assert_eq!(db.incrby("counter", 10).unwrap(), 15);
-        assert_eq!(db.incrby("counter", -3).unwrap(), 12);
+        let db = Db::open(db_path.to_str().unwrap()).unwrap();
+        let value = vec![b'v'; 512];
+        db.with_transaction(|db| {
+            for i in 0..5000 {
+                db.set(&format!("k{}", i), &value, None)?;
+            }
+            Ok(())
+        })
+        .unwrap();
+
+        // Read through its own connection, so writers aren't blocked
+        assert!(db.snapshot_reader().is_some());
+        assert!(Db::open_memory().unwrap().snapshot_reader().is_none());
+        assert_eq!(db.export_snapshot(snap).unwrap().keys, 5000);
+        assert!(!std::path::Path::new(&format!("{}.tmp", snap)).exists());
+
+        let dst = Db::open_memory().unwrap();
+        assert_eq!(dst.import_snapshot(snap).unwrap().keys, 5000);
+        assert_eq!(dst.get("k4999").unwrap(), Some(value));
+
+        // 2.5 MB of values span several frames; the last one is damaged
+        let mut bytes = std::fs::read(snap).unwrap();
+        let n = bytes.len();
+        bytes[n - 20] ^= 0xff;
+        std::fs::write(snap, &bytes).unwrap();
+        let dst = Db::open_memory().unwrap();
+        let err = dst.import_snapshot(snap).unwrap_err().to_string();
+        assert!(err.contains("checksum"), "{}", err);
+        assert_eq!(dst.dbsize().unwrap(), 0, "a failed import loads nothing");
+        let indexes: i64 = dst
+            .core
+            .conn
+            .lock()
+            .unwrap()
+            .query_row(
+                "SELECT COUNT(*) FROM sqlite_master WHERE name = 'idx_keys_expire'",
+                [],
+                |row| row.get(0),
+            )
+            .unwrap();
+        assert_eq!(indexes, 1, "deferred indexes rebuilt after a failed import");
+
+        std::fs::write(snap, &bytes[..n / 2]).unwrap();
+        let dst = Db::open_memory().unwrap();
+        dst.set("kept", b"1", None).unwrap();
+        assert!(dst.import_snapshot(snap).is_err());
+        assert_eq!(dst.dbsize().unwrap(), 1);
+        assert_eq!(dst.get("kept").unwrap(), Some(b"1".to_vec()));
+        std::fs::write(snap, b"not a snapshot").unwrap();
+        assert!(Db::open_memory().unwrap().import_snapshot(snap).is_err());
     }
 
     #[test]
-    fn test_decrby() {
+    fn test_with_transaction() {
         let db = Db::open_memory().unwrap();
 
-        db.set("num", b"100", None).unwrap();
-        assert_eq!(db.decrby("num", 30).unwrap(), 70);
-        assert_eq!(db.decrby("num", 80).unwrap(), -10);
+        // Commit on success, including nested mset
+        db.with_transaction(|db| {
+            db.set("a", b"1", None)?;
+            db.mset(&[("b", b"2"), ("c", b"3")])?;
+            db.incr("n")
+        })
+        .unwrap();
+        assert_eq!(db.get("a").unwrap(), Some(b"1".to_vec()));
+        assert_eq!(db.get("c").unwrap(), Some(b"3".to_vec()));
+        assert_eq!(db.get("n").unwrap(), Some(b"1".to_vec()));
+
+        // Rollback on error
+        let result = db.with_transaction(|db| {
+            db.set("x", b"1", None)?;
+            db.incr("a")?;
+            db.hset("a", &[("f", b"v".as_slice())])
+        });
+        assert!(matches!(result, Err(KvError::WrongType)));
+        assert_eq!(db.get("x").unwrap(), None);
+        assert_eq!(db.get("a").unwrap(), Some(b"1".to_vec()));
+
+        // Connection is usable afterwards
+        db.set("after", b"ok", None).unwrap();
+        assert_eq!(db.get("after").unwrap(), Some(b"ok".to_vec()));
     }
 
     #[test]
-    fn test_incrbyfloat() {
+    fn test_begin_commit_rollback() {
         let db = Db::open_memory().unwrap();
+        assert!(!db.in_transaction());
 
-        // Start from 0
-        let result = db.incrbyfloat("float", 0.1).unwrap();
-        assert!(result.starts_with("0.1"));
+        db.begin().unwrap();
+        assert!(db.in_transaction());
+        assert!(db.begin().is_err());
+        db.set("a", b"1", None).unwrap();
+        db.commit().unwrap();
+        assert!(!db.in_transaction());
+        assert_eq!(db.get("a").unwrap(), Some(b"1".to_vec()));
 
-        // Increment existing float
-        db.set("pi", b"3.14", None).unwrap();
-        let result = db.incrbyfloat("pi", 0.01).unwrap();
-        assert!(result.starts_with("3.15"));
+        db.begin().unwrap();
+        db.set("b", b"2", None).unwrap();
+        db.mset(&[("c", b"3")]).unwrap();
+        db.rollback().unwrap();
+        assert_eq!(db.get("b").unwrap(), None);
+        assert_eq!(db.get("c").unwrap(), None);
+
+        assert!(db.commit().is_err());
+        assert!(db.rollback().is_err());
     }
 
     #[test]
-    fn test_mget() {
+    fn test_with_transaction_nested_in_begin() {
         let db = Db::open_memory().unwrap();
+        db.begin().unwrap();
 
-        db.set("a", b"1", None).unwrap();
-        db.set("b", b"2", None).unwrap();
-        db.set("c", b"3", None).unwrap();
+        // A failing inner block only rolls back to its savepoint
+        let result = db.with_transaction(|db| {
+            db.set("inner", b"1", None)?;
+            Err::<(), _>(KvError::SyntaxError)
+        });
+        assert!(result.is_err());
+        assert!(db.in_transaction());
 
-        let values = db.mget(&["a", "b", "c", "d"]);
-        assert_eq!(values.len(), 4);
-        assert_eq!(values[0], Some(b"1".to_vec()));
-        assert_eq!(values[1], Some(b"2".to_vec()));
-        assert_eq!(values[2], Some(b"3".to_vec()));
-        assert_eq!(values[3], None);
+        db.with_transaction(|db| db.set("kept", b"1", None)).unwrap();
+        db.commit().unwrap();
+
+        assert_eq!(db.get("inner").unwrap(), None);
+        assert_eq!(db.get("kept").unwrap(), Some(b"1".to_vec()));
     }
 
     #[test]
-    fn test_mset() {
+    fn test_key_version() {
         let db = Db::open_memory().unwrap();
+        assert_eq!(db.key_version("k").unwrap(), None);
 
-        db.mset(&[("a", b"1"), ("b", b"2"), ("c", b"3")]).unwrap();
+        db.set("k", b"1", None).unwrap();
+        let (v1, created) = db.key_version("k").unwrap().unwrap();
+        db.set("k", b"2", None).unwrap();
+        let (v2, created2) = db.key_version("k").unwrap().unwrap();
+        assert!(v2 > v1);
+        assert_eq!(created, created2);
 
-        assert_eq!(db.get("a").unwrap(), Some(b"1".to_vec()));
-        assert_eq!(db.get("b").unwrap(), Some(b"2".to_vec()));
-        assert_eq!(db.get("c").unwrap(), Some(b"3".to_vec()));
+        db.del(&["k"]).unwrap();
+        assert_eq!(db.key_version("k").unwrap(), None);
+
+        db.set("e", b"1", Some(Duration::from_millis(1))).unwrap();
+        std::thread::sleep(Duration::from_millis(5));
+        assert_eq!(db.key_version("e").unwrap(), None);
     }
 
     #[test]
@@ -15482,6 +17667,66 @@ mod tests {
         assert_eq!(items[0], binary);
     }
 
+    #[test]
+    fn test_list_meta_tracks_bounds() {
+        let db = Db::open_memory().unwrap();
+        let all = |db: &Db| db.lrange("q", 0, -1).unwrap();
+
+        // Queue usage: push one end, pop the other
+        for i in 0..200 {
+            db.rpush("q", &[i.to_string().as_bytes()]).unwrap();
+            if i % 2 == 1 {
+                db.lpop("q", None).unwrap();
+            }
+        }
+        assert_eq!(db.llen("q").unwrap(), 100);
+        assert_eq!(db.lindex("q", 0).unwrap(), Some(b"100".to_vec()));
+        assert_eq!(db.lindex("q", -1).unwrap(), Some(b"199".to_vec()));
+        assert_eq!(
+            db.lrange("q", -2, -1).unwrap(),
+            vec![b"198".to_vec(), b"199".to_vec()]
+        );
+        assert_eq!(db.lrange("q", 95, 200).unwrap().len(), 5);
+
+        db.lpush("q", &[b"a"]).unwrap();
+        db.linsert("q", true, b"100", b"b").unwrap();
+        assert_eq!(db.lrem("q", 0, b"150").unwrap(), 1);
+        db.ltrim("q", 0, 9).unwrap();
+        assert_eq!(db.llen("q").unwrap(), 10);
+        assert_eq!(
+            all(&db)[..3],
+            [b"a".to_vec(), b"b".to_vec(), b"100".to_vec()]
+        );
+        assert_eq!(db.rpop("q", Some(3)).unwrap().len(), 3);
+        assert_eq!(db.llen("q").unwrap(), 7);
+
+        // Moving the last element within one list keeps it
+        db.rpush("one", &[b"x"]).unwrap();
+        let moved = db
+            .lmove("one", "one", ListDirection::Left, ListDirection::Right)
+            .unwrap();
+        assert_eq!(moved, Some(b"x".to_vec()));
+        assert_eq!(db.llen("one").unwrap(), 1);
+        assert_eq!(db.lrange("one", 0, -1).unwrap(), vec![b"x".to_vec()]);
+
+        // Lists written without metadata are rebuilt on first use
+        let before = all(&db);
+        {
+            let conn = db.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+            conn.execute("DELETE FROM list_meta", []).unwrap();
+        }
+        assert_eq!(db.llen("q").unwrap(), 7);
+        db.rpush("q", &[b"z"]).unwrap();
+        db.lpush("q", &[b"y"]).unwrap();
+        assert_eq!(all(&db).len(), 9);
+        assert_eq!(all(&db)[1..8], before[..]);
+
+        // Popping everything deletes the key
+        db.lpop("q", Some(100)).unwrap();
+        assert_eq!(db.llen("q").unwrap(), 0);
+        assert_eq!(db.exists(&["q"]).unwrap(), 0);
+    }
+
     // --- Session 7: Disk tests for list operations ---
 
     #[test]
@@ -16695,6 +18940,66 @@ mod tests {
         assert_eq!(db.get("permanent").unwrap(), Some(b"v3".to_vec()));
     }
 
+    #[test]
+    fn test_maintenance_step() {
+        let db_path = std::env::temp_dir().join(format!(
+            "redlite_maintenance_test_{}.db",
+            std::process::id()
+        ));
+        let db_path_str = db_path.to_str().unwrap();
+        let _ = std::fs::remove_file(&db_path);
+
+        let db =
+            Db::open_with_options(db_path_str, &OpenOptions::new().incremental_vacuum(true))
+                .unwrap();
+        db.set_autovacuum(false);
+        let value = vec![b'v'; 2048];
+        for i in 0..1000 {
+            db.set(&format!("k{}", i), &value, Some(Duration::from_millis(1)))
+                .unwrap();
+        }
+        db.set("keep", b"v", None).unwrap();
+        std::thread::sleep(Duration::from_millis(5));
+
+        // A tiny budget still makes progress, one batch at a time
+        let first = db.maintenance_step(Duration::from_micros(1)).unwrap();
+        assert_eq!(first.keys_reclaimed, EXPIRE_SWEEP_BATCH as u64);
+        assert!(first.more);
+        assert!(!first.checkpointed);
+
+        let mut steps = 1;
+        let last = loop {
+            let step = db.maintenance_step(Duration::from_millis(50)).unwrap();
+            steps += 1;
+            if !step.more {
+                break step;
+            }
+        };
+        assert_eq!(db.dbsize().unwrap(), 1);
+        // Idle once the backlog is gone: the WAL is checkpointed once
+        assert!(last.checkpointed);
+        assert!(!db.maintenance_step(Duration::from_millis(50)).unwrap().checkpointed);
+
+        let stats = db.maintenance_stats();
+        assert_eq!(stats.steps, steps + 1);
+        assert_eq!(stats.keys_reclaimed, 1000);
+        assert!(stats.pages_freed > 0);
+        assert!(stats.pause_max_us <= stats.pause_total_us);
+        assert_eq!(stats.checkpoints, 1);
+
+        // Skipped inside an explicit transaction
+        db.set("gone", b"v", Some(Duration::from_millis(1))).unwrap();
+        std::thread::sleep(Duration::from_millis(5));
+        db.begin().unwrap();
+        assert_eq!(db.maintenance_step(Duration::from_millis(50)).unwrap().keys_reclaimed, 0);
+        db.rollback().unwrap();
+
+        drop(db);
+        let _ = std::fs::remove_file(&db_path);
+        let _ = std::fs::remove_file(format!("{}-shm", db_path_str));
+        let _ = std::fs::remove_file(format!("{}-wal", db_path_str));
+    }
+
     #[test]
     fn test_vacuum_across_databases() {
         let mut db = Db::open_memory().unwrap();
@@ -17504,6 +19809,47 @@ mod tests {
         assert_eq!(acked, 0);
     }
 
+    #[test]
+    fn test_xreadgroup_xack_batch_in_transaction() {
+        let db = Db::open_memory().unwrap();
+
+        let fields: Vec<(&[u8], &[u8])> = vec![(b"f", b"v")];
+        for ms in 1..=100 {
+            db.xadd(
+                "mystream",
+                Some(StreamId::new(ms, 0)),
+                &fields,
+                false,
+                None,
+                None,
+                false,
+            )
+            .unwrap();
+        }
+        db.xgroup_create("mystream", "mygroup", StreamId::new(0, 0), false)
+            .unwrap();
+
+        // Batched pending writes nest inside an explicit transaction
+        db.begin().unwrap();
+        let read = db
+            .xreadgroup("mygroup", "c1", &["mystream"], &[">"], Some(60), false)
+            .unwrap();
+        assert_eq!(read[0].1.len(), 60);
+        let ids: Vec<StreamId> = read[0].1.iter().map(|e| e.id).collect();
+        assert_eq!(db.xack("mystream", "mygroup", &ids[..50]).unwrap(), 50);
+        db.commit().unwrap();
+
+        let summary = db.xpending_summary("mystream", "mygroup").unwrap();
+        assert_eq!(summary.count, 10);
+
+        // Unknown IDs are skipped, the rest are acknowledged
+        let mut rest = ids[50..].to_vec();
+        rest.push(StreamId::new(9999, 0));
+        assert_eq!(db.xack("mystream", "mygroup", &rest).unwrap(), 10);
+        assert_eq!(db.xpending_summary("mystream", "mygroup").unwrap().count, 0);
+        assert!(!db.in_transaction());
+    }
+
     #[test]
     fn test_xpending_summary() {
         let db = Db::open_memory().unwrap();
@@ -18294,7 +20640,7 @@ mod tests {
         );
 
         let result: rusqlite::Result<i32> = conn.query_row(
-            "SELECT COUNT(*) FROM sqlite_master WHERE type='index' AND name='idx_history_db_key_time'",
+            "SELECT COUNT(*) FROM sqlite_master WHERE type='index' AND name='idx_history_db_key_time_version'",
             [],
             |row| row.get(0),
         );
@@ -18355,6 +20701,74 @@ mod tests {
         assert!(columns.contains(&"timestamp_ms".to_string()));
         assert!(columns.contains(&"data_snapshot".to_string()));
         assert!(columns.contains(&"expire_at".to_string()));
+        assert!(columns.contains(&"delta_base".to_string()));
+    }
+
+    #[test]
+    fn test_history_delta_snapshots() {
+        let db = Db::open_memory().unwrap();
+        db.history_enable_key("doc", RetentionType::Unlimited)
+            .unwrap();
+
+        let value = |i: usize| format!("{:0>1000}", i).into_bytes();
+        for i in 0..40 {
+            db.set("doc", &value(i), None).unwrap();
+        }
+
+        // Every version reads back in full
+        let entries = db.history_get("doc", None, None, None).unwrap();
+        assert_eq!(entries.len(), 40);
+        for (i, entry) in entries.iter().enumerate() {
+            assert_eq!(entry.data_snapshot.as_deref(), Some(value(i).as_slice()));
+        }
+        assert_eq!(db.history_get_at("doc", i64::MAX).unwrap(), Some(value(39)));
+
+        // 3 keyframes (versions 1, 17, 33); the rest are a few bytes each
+        let stats = db.history_stats(Some("doc")).unwrap();
+        assert!(stats.storage_bytes < 3 * 1000 + 37 * 16);
+
+        // Deleting a keyframe rewrites the deltas that survive it
+        {
+            let conn = db.core.conn.lock().unwrap_or_else(|e| e.into_inner());
+            let id: i64 = conn
+                .query_row(
+                    "SELECT id FROM key_history WHERE key = 'doc' AND version_num = 17",
+                    [],
+                    |row| row.get(0),
+                )
+                .unwrap();
+            assert_eq!(Db::history_delete_rows(&conn, &[id]).unwrap(), 1);
+        }
+        let entries = db.history_get("doc", None, None, None).unwrap();
+        assert_eq!(entries.len(), 39);
+        for entry in &entries {
+            let i = entry.version_num as usize - 1;
+            assert_eq!(entry.data_snapshot.as_deref(), Some(value(i).as_slice()));
+        }
+
+        let db = Db::open_memory().unwrap();
+        db.history_enable_key("doc", RetentionType::Count(5))
+            .unwrap();
+        for i in 0..40 {
+            db.set("doc", &value(i), None).unwrap();
+        }
+        let entries = db.history_get("doc", None, None, None).unwrap();
+        assert!(!entries.is_empty() && entries.len() <= 5);
+        let first = 40 - entries.len();
+        for (i, entry) in entries.iter().enumerate() {
+            assert_eq!(
+                entry.data_snapshot.as_deref(),
+                Some(value(first + i).as_slice())
+            );
+        }
+
+        // Incremental prune removes everything across batches
+        assert_eq!(
+            db.history_prune_batch(i64::MAX, 2).unwrap(),
+            2.min(entries.len() as i64)
+        );
+        db.history_prune(i64::MAX).unwrap();
+        assert!(db.history_get("doc", None, None, None).unwrap().is_empty());
     }
 
     // =========================================================================
@@ -20134,9 +22548,86 @@ mod tests {
         db.hset("doc:3", &[("content", b"Hello everyone")])
             .unwrap();
 
-        let options = FtSearchOptions::new();
-        let (total, _) = db.ft_search("idx", "Hello", &options).unwrap();
-        assert_eq!(total, 3, "Should find all matching documents");
+        let options = FtSearchOptions::new();
+        let (total, _) = db.ft_search("idx", "Hello", &options).unwrap();
+        assert_eq!(total, 3, "Should find all matching documents");
+    }
+
+    #[test]
+    fn test_ft_search_pages_in_fts5() {
+        use crate::types::{FtField, FtOnType, FtSearchOptions};
+
+        let db = Db::open_memory().unwrap();
+        let schema = vec![FtField::text("body"), FtField::text("title")];
+        db.ft_create("idx", FtOnType::Hash, &["doc:"], &schema)
+            .unwrap();
+
+        for i in 0..50 {
+            let body = if i % 10 == 0 {
+                "rust rust rust and more rust".to_string()
+            } else {
+                format!("rust notes number {}", i)
+            };
+            let title = format!("title {}", i);
+            db.hset(
+                &format!("doc:{}", i),
+                &[("body", body.as_bytes()), ("title", title.as_bytes())],
+            )
+            .unwrap();
+        }
+        // Outside the index prefix
+        db.hset("other:1", &[("body", b"rust")]).unwrap();
+
+        let mut options = FtSearchOptions::new();
+        options.limit_offset = 5;
+        options.limit_num = 3;
+        let (total, page) = db.ft_search("idx", "rust", &options).unwrap();
+        assert_eq!(total, 50);
+        let keys: Vec<&str> = page.iter().map(|r| r.key.as_str()).collect();
+        assert_eq!(keys, vec!["doc:5", "doc:6", "doc:7"]);
+        assert_eq!(page[0].fields.len(), 2);
+
+        // Best matches first with WITHSCORES
+        options.withscores = true;
+        options.limit_offset = 0;
+        options.limit_num = 5;
+        options.return_fields = vec!["title".to_string()];
+        let (total, page) = db.ft_search("idx", "rust", &options).unwrap();
+        assert_eq!(total, 50);
+        assert_eq!(page.len(), 5);
+        assert!(page.windows(2).all(|w| w[0].score >= w[1].score));
+        assert!(page.iter().all(|r| r.key.ends_with('0')));
+        assert_eq!(page[0].fields.len(), 1);
+        assert_eq!(page[0].fields[0].0, "title");
+
+        // Counting only
+        options.limit_num = 0;
+        options.nocontent = true;
+        let (total, page) = db.ft_search("idx", "number", &options).unwrap();
+        assert_eq!(total, 45);
+        assert!(page.is_empty());
+
+        // Deleted documents drop out of the index
+        db.del(&["doc:5"]).unwrap();
+        let (total, _) = db.ft_search("idx", "number", &options).unwrap();
+        assert_eq!(total, 44);
+
+        // A query FTS5 can't parse falls back to the scan; other errors are returned
+        assert!(db.ft_search("idx", "@missing:rust", &options).is_ok());
+        {
+            let conn = db.core.conn.lock().unwrap();
+            let table: String = conn
+                .query_row(
+                    "SELECT name FROM sqlite_master
+                     WHERE type = 'table' AND sql LIKE 'CREATE VIRTUAL TABLE% fts\\_idx\\_%' ESCAPE '\\'",
+                    [],
+                    |row| row.get(0),
+                )
+                .unwrap();
+            conn.execute_batch(&format!("DROP TABLE {}", table))
+                .unwrap();
+        }
+        assert!(db.ft_search("idx", "rust", &options).is_err());
     }
 
     // ========================================================================
@@ -24239,6 +26730,96 @@ mod tests {
         assert_eq!(db.vcard("vectors").unwrap(), 1);
     }
 
+    #[cfg(feature = "vectors")]
+    fn clustered_vector_set(db: &Db, key: &str) {
+        use crate::types::VectorQuantization;
+
+        // 8 well separated clusters of 50 points in 16 dimensions
+        for c in 0..8 {
+            for i in 0..50 {
+                let mut v = vec![0.0f32; 16];
+                v[c * 2] = 1.0;
+                v[c * 2 + 1] = (i as f32) * 0.01;
+                db.vadd(key, &v, &format!("c{}-{}", c, i), None, VectorQuantization::NoQuant).unwrap();
+            }
+        }
+    }
+
+    #[test]
+    #[cfg(feature = "vectors")]
+    fn test_vindex_probe_matches_exact() {
+        use crate::types::VectorInput;
+
+        let db = Db::open_memory().unwrap();
+        clustered_vector_set(&db, "vecs");
+        assert_eq!(db.vindex("vecs", Some(8)).unwrap(), 8);
+
+        let mut q = vec![0.0f32; 16];
+        q[6] = 1.0;
+        q[7] = 0.2;
+        let probed = db
+            .vsim_nprobe("vecs", VectorInput::Values(q.clone()), Some(5), true, None, Some(1))
+            .unwrap();
+        let exact = db
+            .vsim_nprobe("vecs", VectorInput::Values(q.clone()), Some(5), true, None, Some(0))
+            .unwrap();
+        assert_eq!(probed.len(), 5);
+        assert_eq!(probed[0].element, "c3-20");
+        fn names(r: &[VectorSimResult]) -> Vec<String> {
+            r.iter().map(|x| x.element.clone()).collect()
+        }
+        assert_eq!(names(&probed), names(&exact));
+        assert_eq!(names(&db.vsim("vecs", VectorInput::Values(q), Some(5), true, None).unwrap()), names(&exact));
+    }
+
+    #[test]
+    #[cfg(feature = "vectors")]
+    fn test_vindex_unindexed_elements_are_searched() {
+        use crate::types::{VectorInput, VectorQuantization};
+
+        let db = Db::open_memory().unwrap();
+        clustered_vector_set(&db, "vecs");
+        db.vindex("vecs", None).unwrap();
+
+        // Added after the index was built: not assigned to any list
+        let mut v = vec![0.0f32; 16];
+        v[15] = 1.0;
+        db.vadd("vecs", &v, "late", None, VectorQuantization::NoQuant).unwrap();
+        // Updated after the index was built: leaves its list
+        db.vadd("vecs", &v, "c0-0", None, VectorQuantization::NoQuant).unwrap();
+
+        let results = db
+            .vsim_nprobe("vecs", VectorInput::Values(v), Some(2), false, None, Some(1))
+            .unwrap();
+        let mut names: Vec<_> = results.iter().map(|r| r.element.as_str()).collect();
+        names.sort();
+        assert_eq!(names, vec!["c0-0", "late"]);
+        assert!((results[0].score - 1.0).abs() < 1e-6);
+    }
+
+    #[test]
+    #[cfg(feature = "vectors")]
+    fn test_vindex_drop_and_missing_key() {
+        use crate::types::VectorInput;
+
+        let db = Db::open_memory().unwrap();
+        assert_eq!(db.vindex("missing", None).unwrap(), 0);
+        assert!(!db.vindex_drop("missing").unwrap());
+
+        clustered_vector_set(&db, "vecs");
+        assert_eq!(db.vindex("vecs", None).unwrap(), 20); // sqrt(400)
+        assert!(db.vindex_drop("vecs").unwrap());
+        let q = VectorInput::Values(vec![1.0; 16]);
+        assert_eq!(db.vsim("vecs", q, Some(-1), false, None).unwrap().len(), 400);
+
+        // Index rows go away with the key
+        db.vindex("vecs", Some(4)).unwrap();
+        db.del(&["vecs"]).unwrap();
+        let conn = db.core.conn.lock().unwrap();
+        let left: i64 = conn.query_row("SELECT COUNT(*) FROM vector_ivf", [], |r| r.get(0)).unwrap();
+        assert_eq!(left, 0);
+    }
+
     // ========================================================================
     // Geo Tests
     // ========================================================================
@@ -24599,6 +27180,94 @@ mod tests {
         assert_eq!(zcard, 2);
     }
 
+    #[test]
+    #[cfg(feature = "geo")]
+    fn test_geosearch_bounds_edges_and_antimeridian() {
+        use crate::types::{GeoSearchOptions, GeoUnit};
+        let db = Db::open_memory().unwrap();
+
+        db.geoadd(
+            "pts",
+            &[
+                (0.0, 0.899, "north_edge"), // ~99.96 km due north
+                (0.0, 0.91, "north_out"),   // ~101.2 km
+                (179.9, 10.0, "east"),
+                (-179.9, 10.0, "west"), // ~21.9 km from "east" across 180
+                (0.0, 84.9, "polar"),
+                (180.0 - 0.01, 84.95, "polar_far_side"),
+            ],
+            false,
+            false,
+            false,
+        )
+        .unwrap();
+
+        let search = |lon: f64, lat: f64, radius_km: f64| {
+            let mut options = GeoSearchOptions::default();
+            options.from_lonlat = Some((lon, lat));
+            options.by_radius = Some((radius_km, GeoUnit::Kilometers));
+            options.ascending = true;
+            db.geosearch("pts", &options)
+                .unwrap()
+                .into_iter()
+                .map(|m| m.member)
+                .collect::<Vec<_>>()
+        };
+
+        assert_eq!(search(0.0, 0.0, 100.0), vec!["north_edge"]);
+        assert_eq!(search(179.9, 10.0, 30.0), vec!["east", "west"]);
+        assert_eq!(search(-179.95, 10.0, 30.0), vec!["west", "east"]);
+        // The cap around (0, 84.9) reaches over the pole to the far side
+        assert_eq!(search(0.0, 84.9, 1200.0), vec!["polar", "polar_far_side"]);
+
+        let mut options = GeoSearchOptions::default();
+        options.from_lonlat = Some((180.0, 10.0));
+        options.by_box = Some((50.0, 10.0, GeoUnit::Kilometers));
+        options.ascending = true;
+        let found: Vec<String> = db
+            .geosearch("pts", &options)
+            .unwrap()
+            .into_iter()
+            .map(|m| m.member)
+            .collect();
+        assert_eq!(found.len(), 2);
+
+        options.count = Some(1);
+        options.any = true;
+        assert_eq!(db.geosearch("pts", &options).unwrap().len(), 1);
+    }
+
+    #[test]
+    #[cfg(feature = "geo")]
+    fn test_geo_delete_drops_rtree_entries() {
+        let db = Db::open_memory().unwrap();
+        let rtree_rows = |db: &Db| -> i64 {
+            let conn = db.core.conn.lock().unwrap();
+            conn.query_row("SELECT COUNT(*) FROM geo_rtree", [], |row| row.get(0))
+                .unwrap()
+        };
+
+        db.geoadd(
+            "a",
+            &[(1.0, 1.0, "x"), (2.0, 2.0, "y")],
+            false,
+            false,
+            false,
+        )
+        .unwrap();
+        assert_eq!(rtree_rows(&db), 2);
+        db.del(&["a"]).unwrap();
+        assert_eq!(rtree_rows(&db), 0);
+
+        // Reused geo_data ids don't collide with stale R*Tree rows
+        assert_eq!(
+            db.geoadd("a", &[(1.0, 1.0, "x")], false, false, false)
+                .unwrap(),
+            1
+        );
+        assert_eq!(rtree_rows(&db), 1);
+    }
+
     // --- Session 26: Additional Command Tests ---
 
     #[test]
@@ -25418,6 +28087,64 @@ mod tests {
         assert_eq!(result, vec![0x00]); // AND with zeros = zeros
     }
 
+    #[test]
+    fn test_bitmap_large_in_place() {
+        let db = Db::open_memory().unwrap();
+        let bits = 1u64 << 20;
+
+        // Growing once, then flipping bits inside the existing value
+        db.setbit("day:0", bits - 1, true).unwrap();
+        for offset in (0..bits).step_by(97) {
+            assert_eq!(db.setbit("day:0", offset, true).unwrap(), 0);
+        }
+        assert_eq!(db.setbit("day:0", 97, false).unwrap(), 1);
+        assert_eq!(db.getbit("day:0", 97).unwrap(), 0);
+        assert_eq!(db.getbit("day:0", 194).unwrap(), 1);
+        assert_eq!(db.get("day:0").unwrap().unwrap().len(), (bits / 8) as usize);
+
+        // Every 97th bit, plus the last one, minus the cleared offset 97
+        let expected = (0..bits).step_by(97).count() as i64;
+        assert_eq!(db.bitcount("day:0", None, None).unwrap(), expected);
+
+        // BITOP over many sources of different lengths matches a byte loop
+        let days: Vec<Vec<u8>> = (0..30usize)
+            .map(|d| {
+                (0..1000 + d * 37)
+                    .map(|i| ((i * 7 + d * 13) % 256) as u8)
+                    .collect()
+            })
+            .collect();
+        let keys: Vec<String> = (0..days.len()).map(|d| format!("d:{}", d)).collect();
+        for (key, day) in keys.iter().zip(&days) {
+            db.set(key, day, None).unwrap();
+        }
+        let key_refs: Vec<&str> = keys.iter().map(|k| k.as_str()).collect();
+        let max_len = days.iter().map(|d| d.len()).max().unwrap();
+        let byte = |d: &Vec<u8>, i: usize| d.get(i).copied().unwrap_or(0);
+
+        db.bitop("OR", "any", &key_refs).unwrap();
+        let or: Vec<u8> = (0..max_len)
+            .map(|i| days.iter().fold(0, |acc, d| acc | byte(d, i)))
+            .collect();
+        assert_eq!(db.get("any").unwrap().unwrap(), or);
+
+        db.bitop("AND", "all", &key_refs).unwrap();
+        let and: Vec<u8> = (0..max_len)
+            .map(|i| days.iter().fold(0xFF, |acc, d| acc & byte(d, i)))
+            .collect();
+        assert_eq!(db.get("all").unwrap().unwrap(), and);
+
+        assert!(matches!(
+            db.bitop("NOT", "x", &["d:0", "d:1"]),
+            Err(KvError::InvalidArgument(_))
+        ));
+        db.hset("h", &[("f", b"v".as_slice())]).unwrap();
+        assert!(matches!(
+            db.bitop("OR", "x", &["d:0", "h"]),
+            Err(KvError::WrongType)
+        ));
+    }
+
     // --- ZINTERSTORE and ZUNIONSTORE tests ---
 
     #[test]
@@ -25988,8 +28715,10 @@ mod tests {
         let _ = db.get("tracked_key").unwrap();
 
         // Check that access tracking has an entry
-        let tracking = db.core.access_tracking.read().unwrap();
-        assert!(tracking.len() >= 1, "Access tracking should have at least one entry after GET");
+        assert!(
+            db.core.access_tracking.len() >= 1,
+            "Access tracking should have at least one entry after GET"
+        );
     }
 
     #[test]
@@ -26004,16 +28733,11 @@ mod tests {
             let _ = db.get("key1").unwrap();
         }
 
-        // Check access tracking has been updated
-        let tracking = db.core.access_tracking.read().unwrap();
-        let mut found = false;
-        for info in tracking.values() {
-            if info.access_count >= 5 {
-                found = true;
-                break;
-            }
-        }
-        assert!(found, "At least one key should have access_count >= 5");
+        // Check access tracking has been updated: the LFU counter starts at
+        // LFU_INIT and the first hits always count
+        let key_id = db.get_key_id("key1").unwrap().unwrap();
+        let info = db.core.access_tracking.get(key_id).unwrap();
+        assert!(info.counter >= 5, "key1 should have an LFU counter >= 5");
     }
 
     #[test]
@@ -26087,8 +28811,10 @@ mod tests {
         db.maybe_flush_access_tracking();
 
         // The in-memory tracking should still have entries (not drained)
-        let tracking = db.core.access_tracking.read().unwrap();
-        assert!(tracking.len() >= 1, "Tracking should still have entries when persist is disabled");
+        assert!(
+            db.core.access_tracking.len() >= 1,
+            "Tracking should still have entries when persist is disabled"
+        );
     }
 
     #[test]
@@ -26124,6 +28850,193 @@ mod tests {
         assert_eq!(EvictionPolicy::VolatileRandom.to_str(), "volatile-random");
     }
 
+    #[test]
+    fn test_total_memory_usage_matches_per_key() {
+        let db = Db::open_memory().unwrap();
+        db.set("s", b"hello", None).unwrap();
+        db.hset(
+            "h",
+            &[("f1", b"v1".as_slice()), ("f2", b"value2".as_slice())],
+        )
+        .unwrap();
+        db.rpush("l", &[b"a".as_slice(), b"bcd".as_slice()])
+            .unwrap();
+        db.sadd("st", &[b"m1".as_slice(), b"m22".as_slice()])
+            .unwrap();
+        db.zadd("z", &[ZMember::new(1.0, "one"), ZMember::new(2.0, "two")])
+            .unwrap();
+
+        let mut per_key = 0;
+        for key in ["s", "h", "l", "st", "z"] {
+            let id = db.get_key_id(key).unwrap().unwrap();
+            per_key += db.calculate_key_memory(id).unwrap();
+        }
+        assert_eq!(db.total_memory_usage().unwrap(), per_key);
+        assert_eq!(
+            db.calculate_key_memory(db.get_key_id("s").unwrap().unwrap())
+                .unwrap(),
+            1 + 5 + KEY_MEMORY_OVERHEAD
+        );
+    }
+
+    #[test]
+    fn test_memory_eviction_inline_lfu_keeps_hot_key() {
+        let db = Db::open_memory().unwrap();
+        db.set_eviction_policy(EvictionPolicy::AllKeysLFU);
+        let value = vec![b'v'; 1000];
+        for i in 0..50 {
+            db.set(&format!("k{}", i), &value, None).unwrap();
+        }
+        for _ in 0..200 {
+            db.get("k7").unwrap();
+        }
+
+        // Over budget: writes evict in slices until it is met
+        let budget = db.total_memory_usage().unwrap() / 2;
+        db.set_max_memory(budget);
+        for _ in 0..100 {
+            db.set("trigger", b"v", None).unwrap();
+            if db.total_memory_usage().unwrap() <= budget {
+                break;
+            }
+        }
+        assert!(db.total_memory_usage().unwrap() <= budget);
+        assert!(db.dbsize().unwrap() < 40);
+        assert!(db.get("k7").unwrap().is_some(), "hot key was evicted");
+        assert!(db.maintenance_stats().keys_evicted > 0);
+    }
+
+    #[test]
+    fn test_background_eviction_lru() {
+        let db = Db::open_memory().unwrap();
+        db.set_eviction_policy(EvictionPolicy::AllKeysLRU);
+        // A first step hands eviction to maintenance
+        db.maintenance_step(Duration::from_millis(5)).unwrap();
+
+        let value = vec![b'v'; 1000];
+        for i in 0..50 {
+            db.set(&format!("k{}", i), &value, None).unwrap();
+        }
+        std::thread::sleep(Duration::from_millis(5));
+        db.get("k3").unwrap();
+
+        let budget = db.total_memory_usage().unwrap() / 2;
+        db.set_max_memory(budget);
+        db.set("k50", &value, None).unwrap();
+        assert_eq!(
+            db.dbsize().unwrap(),
+            51,
+            "writes leave eviction to maintenance"
+        );
+
+        let step = db.maintenance_step(Duration::from_secs(5)).unwrap();
+        assert!(step.keys_evicted > 0);
+        assert!(!step.more);
+        assert!(db.total_memory_usage().unwrap() <= budget);
+        assert!(
+            db.get("k3").unwrap().is_some(),
+            "recently read key was evicted"
+        );
+        assert_eq!(db.maintenance_stats().keys_evicted, step.keys_evicted);
+
+        // Checked at most once a second
+        db.set_max_memory(1);
+        assert_eq!(
+            db.maintenance_step(Duration::from_secs(5))
+                .unwrap()
+                .keys_evicted,
+            0
+        );
+    }
+
+    #[test]
+    fn test_disk_eviction_counts_pages_in_use() {
+        let db_path = std::env::temp_dir().join(format!(
+            "redlite_disk_eviction_test_{}.db",
+            std::process::id()
+        ));
+        let db_path_str = db_path.to_str().unwrap();
+        let _ = std::fs::remove_file(&db_path);
+
+        let db = Db::open(db_path_str).unwrap();
+        db.maintenance_step(Duration::from_millis(5)).unwrap();
+        let value = vec![b'v'; 1024];
+        for i in 0..2000 {
+            db.set(&format!("k{}", i), &value, None).unwrap();
+        }
+        let used = Db::disk_used(&db.core.conn.lock().unwrap()).unwrap();
+        db.set_max_disk(used / 2);
+
+        // Deleted rows only move pages to the free list, which no longer
+        // counts, so eviction stops near the budget instead of emptying the db
+        let step = db.maintenance_step(Duration::from_secs(5)).unwrap();
+        assert!(!step.more);
+        assert!(Db::disk_used(&db.core.conn.lock().unwrap()).unwrap() <= used / 2);
+        let left = db.dbsize().unwrap();
+        assert!(left > 500 && left < 1500, "{} keys left", left);
+        // NoEviction drops the oldest keys first
+        assert!(db.get("k0").unwrap().is_none());
+        assert!(db.get("k1999").unwrap().is_some());
+
+        drop(db);
+        for suffix in ["", "-wal", "-shm"] {
+            let _ = std::fs::remove_file(format!("{}{}", db_path_str, suffix));
+        }
+    }
+
+    #[test]
+    fn test_access_stats_flushed_in_batches() {
+        let db = Db::open_memory().unwrap();
+        db.set_eviction_policy(EvictionPolicy::AllKeysLFU);
+        db.set_access_flush_interval(0);
+        db.maintenance_step(Duration::from_millis(5)).unwrap();
+        for i in 0..(ACCESS_FLUSH_BATCH + 10) {
+            let key = format!("k{}", i);
+            db.set(&key, b"v", None).unwrap();
+            db.get(&key).unwrap();
+        }
+
+        let persisted = |db: &Db| -> i64 {
+            db.core
+                .conn
+                .lock()
+                .unwrap()
+                .query_row(
+                    "SELECT COUNT(*) FROM keys WHERE last_accessed > 0",
+                    [],
+                    |r| r.get(0),
+                )
+                .unwrap()
+        };
+        assert_eq!(persisted(&db), 0, "writes leave flushes to maintenance");
+        db.maintenance_step(Duration::from_secs(5)).unwrap();
+        assert_eq!(persisted(&db), ACCESS_FLUSH_BATCH as i64);
+        db.maintenance_step(Duration::from_secs(5)).unwrap();
+        assert_eq!(persisted(&db), ACCESS_FLUSH_BATCH as i64 + 10);
+
+        let id = db.get_key_id("k0").unwrap().unwrap();
+        let counter: i64 = db
+            .core
+            .conn
+            .lock()
+            .unwrap()
+            .query_row("SELECT access_count FROM keys WHERE id = ?1", [id], |r| {
+                r.get(0)
+            })
+            .unwrap();
+        assert_eq!(
+            counter,
+            db.core.access_tracking.get(id).unwrap().counter as i64
+        );
+
+        // Stats of deleted keys are dropped as maintenance visits their shard
+        db.del(&["k0"]).unwrap();
+        for _ in 0..access::SHARDS {
+            db.maintenance_step(Duration::from_millis(50)).unwrap();
+        }
+        assert!(db.core.access_tracking.get(id).is_none());
+    }
+
     // ========================================================================
     // JSON Command Tests (Session 51)
     // ========================================================================
@@ -26808,6 +29721,85 @@ mod tests {
         assert_eq!(db.json_get("brand_new", &["$.val"]).unwrap().unwrap(), "200");
     }
 
+    #[test]
+    fn test_json_mset_same_key_applies_in_order() {
+        let db = Db::open_memory().unwrap();
+
+        let triplets = vec![
+            ("doc", "$", r#"{"a":1}"#),
+            ("other", "$.x", "true"),
+            ("doc", "$.b", r#"{"c":2}"#),
+            ("doc", "$.a", "3"),
+        ];
+        db.json_mset(&triplets).unwrap();
+
+        assert_eq!(
+            db.json_get("doc", &[]).unwrap().unwrap(),
+            r#"{"a":3,"b":{"c":2}}"#
+        );
+        assert_eq!(db.json_get("other", &["$.x"]).unwrap().unwrap(), "true");
+    }
+
+    #[test]
+    fn test_json_set_many_and_get_many() {
+        let db = Db::open_memory().unwrap();
+
+        assert!(db
+            .json_set_many(
+                "doc",
+                &[
+                    ("$.name", r#""alice""#),
+                    ("$.visits", "41"),
+                    ("$.tags", r#"["a","b"]"#),
+                ],
+            )
+            .unwrap());
+        let got = db
+            .json_get_many(
+                "doc",
+                &["$.name", "$.tags[1]", "$.missing", "$.tags[*]", "$"],
+            )
+            .unwrap();
+        assert_eq!(got[0].as_deref(), Some(r#""alice""#));
+        assert_eq!(got[1].as_deref(), Some(r#""b""#));
+        assert_eq!(got[2], None);
+        assert_eq!(got[3].as_deref(), Some(r#"["a","b"]"#));
+        let root: JsonValue = serde_json::from_str(got[4].as_deref().unwrap()).unwrap();
+        assert_eq!(
+            root,
+            serde_json::json!({"name": "alice", "visits": 41, "tags": ["a", "b"]})
+        );
+
+        // A bad value rejects the whole batch
+        assert!(db
+            .json_set_many("doc", &[("$.visits", "42"), ("$.bad", "{")])
+            .is_err());
+        assert_eq!(db.json_get("doc", &["$.visits"]).unwrap().unwrap(), "41");
+
+        // So does a path that can't be set, as it fails json_set
+        assert!(db
+            .json_set("doc", "$.name.first", r#""a""#, false, false)
+            .is_err());
+        assert!(db
+            .json_set_many("doc", &[("$.visits", "42"), ("$.name.first", r#""a""#)])
+            .is_err());
+        assert_eq!(db.json_get("doc", &["$.visits"]).unwrap().unwrap(), "41");
+        assert_eq!(
+            db.json_get("doc", &["$.name"]).unwrap().unwrap(),
+            r#""alice""#
+        );
+
+        assert_eq!(
+            db.json_get_many("nope", &["$.a", "$.b"]).unwrap(),
+            vec![None, None]
+        );
+        db.set("plain", b"x", None).unwrap();
+        assert!(matches!(
+            db.json_get_many("plain", &["$"]),
+            Err(KvError::WrongType)
+        ));
+    }
+
     // ========================================================================
     // JSON Phase 3: Manipulation Command Tests
     // ========================================================================
@@ -27050,6 +30042,45 @@ mod tests {
         assert_eq!(result, "150");
     }
 
+    #[test]
+    fn test_json_numincrby_splices_plain_paths() {
+        let db = Db::open_memory().unwrap();
+
+        let doc = r#"{"a":{"list":[1,[5,{"n":7}]],"s":"n\"7"},"tail":"x"}"#;
+        assert!(db.json_set("obj", "$", doc, false, false).unwrap());
+
+        // Same width (overwritten in place), wider, narrower, then float
+        assert_eq!(
+            db.json_numincrby("obj", "$.a.list[1][1].n", 1.0).unwrap(),
+            "8"
+        );
+        assert_eq!(
+            db.json_numincrby("obj", "$.a.list[1][1].n", 100.0).unwrap(),
+            "108"
+        );
+        assert_eq!(
+            db.json_numincrby("obj", "$.a.list[1][1].n", -105.0)
+                .unwrap(),
+            "3"
+        );
+        assert_eq!(db.json_numincrby("obj", "$.a.list[0]", 0.5).unwrap(), "1.5");
+
+        let expected = r#"{"a":{"list":[1.5,[5,{"n":3}]],"s":"n\"7"},"tail":"x"}"#;
+        let stored: JsonValue =
+            serde_json::from_str(&db.json_get("obj", &[]).unwrap().unwrap()).unwrap();
+        assert_eq!(stored, serde_json::from_str::<JsonValue>(expected).unwrap());
+        assert_eq!(
+            db.json_get("obj", &["$.a.list[1]"]).unwrap().unwrap(),
+            r#"[5,{"n":3}]"#
+        );
+
+        assert!(matches!(
+            db.json_numincrby("obj", "$.a.s", 1.0),
+            Err(KvError::WrongType)
+        ));
+        assert!(db.json_numincrby("obj", "$.a.missing", 1.0).is_err());
+    }
+
     // ========================================================================
     // JSON Phase 4: String Command Tests
     // ========================================================================
@@ -0,0 +1,103 @@
+//! Snapshot deltas for key history
+//!
+//! A delta rebuilds a value from a base snapshot (the key's last keyframe)
+//! by keeping the base's first `prefix` and last `suffix` bytes and
+//! replacing what lies between them. It is encoded as
+//! varint(prefix) varint(suffix) middle. That covers appends, truncations
+//! and in-place edits, which is how most overwritten values change.
+
+fn put_varint(out: &mut Vec<u8>, mut v: u64) {
+    while v >= 0x80 {
+        out.push((v as u8) | 0x80);
+        v >>= 7;
+    }
+    out.push(v as u8);
+}
+
+fn get_varint(bytes: &[u8], pos: &mut usize) -> Option<u64> {
+    let mut v = 0u64;
+    for shift in (0..64).step_by(7) {
+        let b = *bytes.get(*pos)?;
+        *pos += 1;
+        v |= ((b & 0x7f) as u64) << shift;
+        if b & 0x80 == 0 {
+            return Some(v);
+        }
+    }
+    None
+}
+
+/// Delta that turns `base` into `target`
+pub fn encode(base: &[u8], target: &[u8]) -> Vec<u8> {
+    let prefix = base.iter().zip(target).take_while(|(a, b)| a == b).count();
+    let suffix = base[prefix..]
+        .iter()
+        .rev()
+        .zip(target[prefix..].iter().rev())
+        .take_while(|(a, b)| a == b)
+        .count();
+    let middle = &target[prefix..target.len() - suffix];
+
+    let mut out = Vec::with_capacity(middle.len() + 20);
+    put_varint(&mut out, prefix as u64);
+    put_varint(&mut out, suffix as u64);
+    out.extend_from_slice(middle);
+    out
+}
+
+/// Rebuild the target from `base` and a delta made by `encode`, or None if
+/// the delta doesn't fit the base
+pub fn apply(base: &[u8], delta: &[u8]) -> Option<Vec<u8>> {
+    let mut pos = 0;
+    let prefix = usize::try_from(get_varint(delta, &mut pos)?).ok()?;
+    let suffix = usize::try_from(get_varint(delta, &mut pos)?).ok()?;
+    if prefix.checked_add(suffix)? > base.len() {
+        return None;
+    }
+    let middle = &delta[pos..];
+
+    let mut out = Vec::with_capacity(prefix + middle.len() + suffix);
+    out.extend_from_slice(&base[..prefix]);
+    out.extend_from_slice(middle);
+    out.extend_from_slice(&base[base.len() - suffix..]);
+    Some(out)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_roundtrip() {
+        let base = b"{\"name\":\"alice\",\"visits\":41,\"tags\":[\"a\",\"b\"]}".to_vec();
+        let cases: Vec<Vec<u8>> = vec![
+            base.clone(),
+            b"{\"name\":\"alice\",\"visits\":42,\"tags\":[\"a\",\"b\"]}".to_vec(),
+            [base.as_slice(), b" appended"].concat(),
+            base[..10].to_vec(),
+            base[5..].to_vec(),
+            b"entirely different".to_vec(),
+            Vec::new(),
+        ];
+        for target in cases {
+            let delta = encode(&base, &target);
+            assert_eq!(apply(&base, &delta), Some(target.clone()));
+        }
+        assert_eq!(apply(b"", &encode(b"", b"new")), Some(b"new".to_vec()));
+    }
+
+    #[test]
+    fn test_small_edit_is_small() {
+        let base = vec![b'x'; 4096];
+        let mut target = base.clone();
+        target[2000] = b'y';
+        assert!(encode(&base, &target).len() < 8);
+    }
+
+    #[test]
+    fn test_apply_rejects_mismatched_base() {
+        let delta = encode(b"0123456789", b"0123-456789");
+        assert_eq!(apply(b"0123", &delta), None);
+        assert_eq!(apply(b"0123456789", &[0xff]), None);
+    }
+}
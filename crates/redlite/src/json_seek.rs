@@ -0,0 +1,209 @@
+//! Locating values inside stored JSON documents without parsing them
+//!
+//! json_docs holds compact JSON written by serde_json. For a plain path of
+//! field names and array indexes, `find` walks the document bytes, skipping
+//! everything off the path, and returns the byte range of the target value.
+//! Because the bytes came from serde_json, that range is exactly what
+//! serializing the value would produce, so reads can return it as-is and
+//! numeric updates can splice it. Anything else (wildcards, filters, slices,
+//! escaped keys) returns None and callers fall back to a full parse.
+
+use std::ops::Range;
+
+pub enum Step<'a> {
+    Field(&'a str),
+    Index(usize),
+}
+
+/// Split a normalized path like `$.a.b[2].c` into steps, or None if it
+/// uses anything beyond field names and array indexes
+pub fn parse_path(path: &str) -> Option<Vec<Step<'_>>> {
+    let mut rest = path.strip_prefix('$')?;
+    let mut steps = Vec::new();
+    while !rest.is_empty() {
+        if let Some(r) = rest.strip_prefix('.') {
+            let end = r
+                .find(|c: char| !(c.is_ascii_alphanumeric() || c == '_'))
+                .unwrap_or(r.len());
+            if end == 0 || r.as_bytes()[0].is_ascii_digit() {
+                return None;
+            }
+            steps.push(Step::Field(&r[..end]));
+            rest = &r[end..];
+        } else if let Some(r) = rest.strip_prefix('[') {
+            let end = r.find(']')?;
+            let digits = &r[..end];
+            if digits.is_empty() || !digits.bytes().all(|b| b.is_ascii_digit()) {
+                return None;
+            }
+            steps.push(Step::Index(digits.parse().ok()?));
+            rest = &r[end + 1..];
+        } else {
+            return None;
+        }
+    }
+    Some(steps)
+}
+
+/// Byte range of the value at `steps`, or None if it isn't there
+pub fn find(doc: &[u8], steps: &[Step]) -> Option<Range<usize>> {
+    let mut pos = skip_ws(doc, 0);
+    for step in steps {
+        match step {
+            Step::Field(name) => {
+                if doc.get(pos) != Some(&b'{') {
+                    return None;
+                }
+                pos = skip_ws(doc, pos + 1);
+                loop {
+                    if doc.get(pos) != Some(&b'"') {
+                        return None;
+                    }
+                    let key_end = skip_string(doc, pos)?;
+                    let key = &doc[pos + 1..key_end - 1];
+                    if key.contains(&b'\\') {
+                        return None;
+                    }
+                    pos = skip_ws(doc, key_end);
+                    if doc.get(pos) != Some(&b':') {
+                        return None;
+                    }
+                    pos = skip_ws(doc, pos + 1);
+                    if key == name.as_bytes() {
+                        break;
+                    }
+                    pos = next_item(doc, pos)?;
+                }
+            }
+            Step::Index(index) => {
+                if doc.get(pos) != Some(&b'[') {
+                    return None;
+                }
+                pos = skip_ws(doc, pos + 1);
+                if doc.get(pos) == Some(&b']') {
+                    return None;
+                }
+                for _ in 0..*index {
+                    pos = next_item(doc, pos)?;
+                }
+            }
+        }
+    }
+    let end = skip_value(doc, pos)?;
+    Some(pos..end)
+}
+
+/// Skip the value at `pos` and the comma after it; None at the container's end
+fn next_item(doc: &[u8], pos: usize) -> Option<usize> {
+    let pos = skip_ws(doc, skip_value(doc, pos)?);
+    match doc.get(pos) {
+        Some(b',') => Some(skip_ws(doc, pos + 1)),
+        _ => None,
+    }
+}
+
+fn skip_ws(doc: &[u8], mut pos: usize) -> usize {
+    while matches!(doc.get(pos), Some(b' ' | b'\t' | b'\n' | b'\r')) {
+        pos += 1;
+    }
+    pos
+}
+
+/// `pos` is at an opening quote; returns the index just past the closing one
+fn skip_string(doc: &[u8], pos: usize) -> Option<usize> {
+    let mut i = pos + 1;
+    loop {
+        match doc.get(i)? {
+            b'\\' => i += 2,
+            b'"' => return Some(i + 1),
+            _ => i += 1,
+        }
+    }
+}
+
+fn skip_value(doc: &[u8], pos: usize) -> Option<usize> {
+    match doc.get(pos)? {
+        b'"' => skip_string(doc, pos),
+        b'{' | b'[' => {
+            let mut depth = 0usize;
+            let mut i = pos;
+            loop {
+                match doc.get(i)? {
+                    b'"' => {
+                        i = skip_string(doc, i)?;
+                        continue;
+                    }
+                    b'{' | b'[' => depth += 1,
+                    b'}' | b']' => {
+                        depth -= 1;
+                        if depth == 0 {
+                            return Some(i + 1);
+                        }
+                    }
+                    _ => {}
+                }
+                i += 1;
+            }
+        }
+        _ => {
+            let mut i = pos;
+            while let Some(b) = doc.get(i) {
+                if matches!(b, b',' | b']' | b'}' | b' ' | b'\t' | b'\n' | b'\r') {
+                    break;
+                }
+                i += 1;
+            }
+            (i > pos).then_some(i)
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn get<'a>(doc: &'a str, path: &str) -> Option<&'a str> {
+        let steps = parse_path(path)?;
+        find(doc.as_bytes(), &steps).map(|r| &doc[r])
+    }
+
+    #[test]
+    fn test_find_paths() {
+        let doc = r#"{"a":{"b":[1,{"c":"x,]}"},[2,3]],"d":true},"e":-1.5e3,"f":null}"#;
+        assert_eq!(get(doc, "$"), Some(doc));
+        assert_eq!(get(doc, "$.a.b[0]"), Some("1"));
+        assert_eq!(get(doc, "$.a.b[1].c"), Some(r#""x,]}""#));
+        assert_eq!(get(doc, "$.a.b[2]"), Some("[2,3]"));
+        assert_eq!(get(doc, "$.a.b[2][1]"), Some("3"));
+        assert_eq!(get(doc, "$.a.d"), Some("true"));
+        assert_eq!(get(doc, "$.e"), Some("-1.5e3"));
+        assert_eq!(get(doc, "$.f"), Some("null"));
+    }
+
+    #[test]
+    fn test_find_missing() {
+        let doc = r#"{"a":[1,2],"s":"q\"uote","o":{}}"#;
+        assert_eq!(get(doc, "$.a[2]"), None);
+        assert_eq!(get(doc, "$.zz"), None);
+        assert_eq!(get(doc, "$.a.b"), None);
+        assert_eq!(get(doc, "$.o.x"), None);
+        assert_eq!(get(doc, "$.s"), Some(r#""q\"uote""#));
+    }
+
+    #[test]
+    fn test_parse_path_rejects_queries() {
+        for path in [
+            "$.*",
+            "$..a",
+            "$.a[-1]",
+            "$.a[0:2]",
+            "$['a']",
+            "$.a[?@.b]",
+            "a",
+            "$.1a",
+        ] {
+            assert!(parse_path(path).is_none(), "{}", path);
+        }
+        assert_eq!(parse_path("$.a_1[10].b").map(|s| s.len()), Some(3));
+    }
+}
@@ -13,15 +13,22 @@
 //! assert_eq!(value, Some(b"value".to_vec()));
 //! ```
 
+mod access;
 pub mod backend;
+mod bitmap;
 pub mod db;
+mod delta;
 pub mod error;
+mod json_seek;
 pub mod resp;
 pub mod search;
 pub mod server;
+mod snapshot;
 #[cfg(feature = "turso")]
 pub mod turso_db;
 pub mod types;
+#[cfg(feature = "vectors")]
+mod vectors;
 
 pub use backend::Backend;
 pub use db::{Db, EvictionPolicy};
@@ -31,7 +38,8 @@ pub use server::{ConnectionHandler, Server};
 #[cfg(feature = "turso")]
 pub use turso_db::TursoDb;
 pub use types::{
-    FtField, FtFieldType, FtIndex, FtIndexInfo, FtOnType, FtSearchOptions, FtSearchResult,
-    FtSuggestion, GetExOption, HistoryConfig, HistoryEntry, HistoryLevel, KeyType, ListDirection,
-    PollConfig, RetentionType, SetOptions, StreamEntry, StreamId, ZMember,
+    BulkRecord, FtField, FtFieldType, FtIndex, FtIndexInfo, FtOnType, FtSearchOptions,
+    FtSearchResult, FtSuggestion, GetExOption, HistoryConfig, HistoryEntry, HistoryLevel, KeyType,
+    ListDirection, MaintenanceStats, MaintenanceStep, OpenOptions, PollConfig, RetentionType,
+    SetOptions, SnapshotStats, SqliteStats, StreamEntry, StreamId, Synchronous, ZMember,
 };
@@ -42,6 +42,14 @@ CREATE TABLE IF NOT EXISTS lists (
 
 CREATE INDEX IF NOT EXISTS idx_lists_key_pos ON lists(key_id, pos);
 
+-- List bounds, so pushes, pops and LLEN don't scan the list
+CREATE TABLE IF NOT EXISTS list_meta (
+    key_id INTEGER PRIMARY KEY REFERENCES keys(id) ON DELETE CASCADE,
+    head INTEGER NOT NULL,
+    tail INTEGER NOT NULL,
+    len INTEGER NOT NULL
+);
+
 -- Sets
 CREATE TABLE IF NOT EXISTS sets (
     key_id INTEGER NOT NULL REFERENCES keys(id) ON DELETE CASCADE,
@@ -17,3 +17,10 @@ CREATE VIRTUAL TABLE IF NOT EXISTS geo_rtree USING rtree(
     min_lon, max_lon,
     min_lat, max_lat
 );
+
+-- Virtual tables don't take part in ON DELETE CASCADE; drop a member's
+-- R*Tree entry with it so the index never outgrows geo_data
+CREATE TRIGGER IF NOT EXISTS geo_data_rtree_delete AFTER DELETE ON geo_data
+BEGIN
+    DELETE FROM geo_rtree WHERE id = old.id;
+END;
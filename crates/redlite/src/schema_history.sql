@@ -24,8 +24,12 @@ CREATE TABLE IF NOT EXISTS key_history (
     timestamp_ms INTEGER NOT NULL,
     data_snapshot BLOB,                  -- MessagePack encoded current state
     expire_at INTEGER,                   -- Optional TTL at time of operation
+    delta_base INTEGER,                  -- NULL for a full snapshot, else the version_num
+                                         -- of the keyframe data_snapshot is a delta against
     UNIQUE(key_id, version_num)
 );
 
 CREATE INDEX IF NOT EXISTS idx_history_key_time ON key_history(key_id, timestamp_ms DESC);
-CREATE INDEX IF NOT EXISTS idx_history_db_key_time ON key_history(db, key, timestamp_ms DESC);
+-- Point-in-time reads are one seek; version_num breaks same-millisecond ties
+CREATE INDEX IF NOT EXISTS idx_history_db_key_time_version ON key_history(db, key, timestamp_ms DESC, version_num DESC);
+CREATE INDEX IF NOT EXISTS idx_history_time ON key_history(timestamp_ms);
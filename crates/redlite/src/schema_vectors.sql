@@ -16,8 +16,20 @@ CREATE TABLE IF NOT EXISTS vector_sets (
     quantization TEXT DEFAULT 'NOQUANT', -- Quantization type: NOQUANT, Q8, BF16
     attributes TEXT,                    -- Optional JSON attributes
     created_at INTEGER NOT NULL DEFAULT (unixepoch('now', 'subsec') * 1000),
+    norm REAL,                          -- Precomputed L2 norm of the embedding
+    list_id INTEGER,                    -- IVF list (NULL = not indexed, always scanned)
     UNIQUE(key_id, element)
 );
 
 CREATE INDEX IF NOT EXISTS idx_vector_sets_key_id ON vector_sets(key_id);
 CREATE INDEX IF NOT EXISTS idx_vector_sets_element ON vector_sets(key_id, element);
+
+-- IVF index (built by VINDEX): unit-length FP32 centroids per vector set.
+-- VSIM scans only the elements whose list_id is among the closest centroids.
+-- idx_vector_sets_list is created by the migration, after list_id exists.
+CREATE TABLE IF NOT EXISTS vector_ivf (
+    key_id INTEGER NOT NULL REFERENCES keys(id) ON DELETE CASCADE,
+    list_id INTEGER NOT NULL,
+    centroid BLOB NOT NULL,
+    PRIMARY KEY (key_id, list_id)
+);
@@ -0,0 +1,375 @@
+//! Snapshot file format (`Db::export_snapshot` / `Db::import_snapshot`)
+//!
+//! A 32-byte header followed by checksummed frames:
+//!
+//! ```text
+//! header := "RLSNAP01" u32 version u32 flags (0) i64 created_ms u64 reserved (0)
+//! frame  := u32 len u32 crc32(payload) payload[len]
+//! ```
+//!
+//! Frame payloads carry one stream of records, cut into frames of about
+//! `FRAME_TARGET` bytes between items, so a key with many items spans frames:
+//!
+//! ```text
+//! KEY := 0x01 u8 type u32 db i64 expire_at (0 = none) blob key u64 count, then `count` items
+//! GEO := 0x02 u64 count, then `count` coordinates of the preceding sorted set
+//! END := 0x00 u64 keys (last record; without it the file is truncated)
+//! ```
+//!
+//! Items by key type: string and JSON `blob value`, hash `blob field blob value`,
+//! list `i64 pos blob value`, set `blob member`, sorted set `f64 score blob member`,
+//! stream `i64 ms i64 seq blob data`, coordinates `blob member f64 lon f64 lat blob geohash`.
+//!
+//! `blob := u32 len bytes`. All numbers are fixed-width little-endian and
+//! nothing is compressed, so a reader can walk an mmap of the file and use
+//! values as slices of it.
+
+use std::io::{ErrorKind, Read, Write};
+
+use crate::error::{KvError, Result};
+
+pub const MAGIC: &[u8; 8] = b"RLSNAP01";
+pub const VERSION: u32 = 1;
+const HEADER_LEN: usize = 32;
+/// Payload size at which the writer closes a frame
+const FRAME_TARGET: usize = 1 << 20;
+
+pub const TAG_END: u8 = 0;
+pub const TAG_KEY: u8 = 1;
+pub const TAG_GEO: u8 = 2;
+
+pub fn corrupt(what: &str) -> KvError {
+    KvError::Other(format!("corrupt snapshot: {}", what))
+}
+
+/// Streams records into frames; holds at most one frame in memory
+pub struct Writer<W: Write> {
+    out: W,
+    frame: Vec<u8>,
+    written: u64,
+}
+
+impl<W: Write> Writer<W> {
+    pub fn new(mut out: W, created_ms: i64) -> Result<Self> {
+        let mut header = Vec::with_capacity(HEADER_LEN);
+        header.extend_from_slice(MAGIC);
+        header.extend_from_slice(&VERSION.to_le_bytes());
+        header.extend_from_slice(&0u32.to_le_bytes());
+        header.extend_from_slice(&created_ms.to_le_bytes());
+        header.extend_from_slice(&0u64.to_le_bytes());
+        out.write_all(&header)?;
+        Ok(Self {
+            out,
+            frame: Vec::with_capacity(FRAME_TARGET + 64 * 1024),
+            written: HEADER_LEN as u64,
+        })
+    }
+
+    pub fn u8(&mut self, v: u8) -> &mut Self {
+        self.frame.push(v);
+        self
+    }
+
+    pub fn u32(&mut self, v: u32) -> &mut Self {
+        self.frame.extend_from_slice(&v.to_le_bytes());
+        self
+    }
+
+    pub fn u64(&mut self, v: u64) -> &mut Self {
+        self.frame.extend_from_slice(&v.to_le_bytes());
+        self
+    }
+
+    pub fn i64(&mut self, v: i64) -> &mut Self {
+        self.frame.extend_from_slice(&v.to_le_bytes());
+        self
+    }
+
+    pub fn f64(&mut self, v: f64) -> &mut Self {
+        self.frame.extend_from_slice(&v.to_le_bytes());
+        self
+    }
+
+    /// Length-prefixed bytes (SQLite values are far below 4 GB)
+    pub fn blob(&mut self, v: &[u8]) -> &mut Self {
+        self.u32(v.len() as u32);
+        self.frame.extend_from_slice(v);
+        self
+    }
+
+    /// Call after each record header and item: closes the frame once it is full
+    pub fn end_item(&mut self) -> Result<()> {
+        if self.frame.len() >= FRAME_TARGET {
+            self.flush_frame()?;
+        }
+        Ok(())
+    }
+
+    fn flush_frame(&mut self) -> Result<()> {
+        if self.frame.is_empty() {
+            return Ok(());
+        }
+        let len = u32::try_from(self.frame.len())
+            .map_err(|_| KvError::Other("snapshot frame over 4 GB".to_string()))?;
+        self.out.write_all(&len.to_le_bytes())?;
+        self.out.write_all(&crc32(&self.frame).to_le_bytes())?;
+        self.out.write_all(&self.frame)?;
+        self.written += 8 + self.frame.len() as u64;
+        self.frame.clear();
+        Ok(())
+    }
+
+    /// Write the END record and the last frame. Returns the output and the
+    /// bytes written in total.
+    pub fn finish(mut self, keys: u64) -> Result<(W, u64)> {
+        self.u8(TAG_END).u64(keys);
+        self.flush_frame()?;
+        self.out.flush()?;
+        Ok((self.out, self.written))
+    }
+}
+
+/// Reads frames one at a time, verifying each checksum
+pub struct Reader<R: Read> {
+    input: R,
+    frame: Vec<u8>,
+    frames: u64,
+}
+
+impl<R: Read> Reader<R> {
+    pub fn new(mut input: R) -> Result<Self> {
+        let mut header = [0u8; HEADER_LEN];
+        input.read_exact(&mut header).map_err(eof_as_corrupt)?;
+        if &header[..8] != MAGIC {
+            return Err(corrupt("not a redlite snapshot"));
+        }
+        let version = u32::from_le_bytes(header[8..12].try_into().unwrap());
+        if version != VERSION {
+            return Err(KvError::Other(format!(
+                "unsupported snapshot version {}",
+                version
+            )));
+        }
+        Ok(Self {
+            input,
+            frame: Vec::new(),
+            frames: 0,
+        })
+    }
+
+    /// Payload of the next frame, or None at the end of the file
+    pub fn next_frame(&mut self) -> Result<Option<&[u8]>> {
+        let mut head = [0u8; 8];
+        let mut filled = 0;
+        while filled < head.len() {
+            match self.input.read(&mut head[filled..]) {
+                Ok(0) => break,
+                Ok(n) => filled += n,
+                Err(e) if e.kind() == ErrorKind::Interrupted => {}
+                Err(e) => return Err(e.into()),
+            }
+        }
+        match filled {
+            0 => return Ok(None),
+            8 => {}
+            _ => return Err(corrupt("truncated frame header")),
+        }
+        let len = u32::from_le_bytes(head[..4].try_into().unwrap()) as u64;
+        let crc = u32::from_le_bytes(head[4..].try_into().unwrap());
+
+        // Grows with the data actually read, so a corrupt length can't
+        // allocate more than the file holds
+        self.frame.clear();
+        (&mut self.input).take(len).read_to_end(&mut self.frame)?;
+        if self.frame.len() as u64 != len {
+            return Err(corrupt("truncated frame"));
+        }
+        if crc32(&self.frame) != crc {
+            return Err(corrupt(&format!(
+                "checksum mismatch in frame {}",
+                self.frames
+            )));
+        }
+        self.frames += 1;
+        Ok(Some(&self.frame))
+    }
+}
+
+fn eof_as_corrupt(e: std::io::Error) -> KvError {
+    if e.kind() == ErrorKind::UnexpectedEof {
+        corrupt("missing header")
+    } else {
+        e.into()
+    }
+}
+
+/// Decodes records from one frame payload
+pub struct Cursor<'a> {
+    buf: &'a [u8],
+}
+
+impl<'a> Cursor<'a> {
+    pub fn new(buf: &'a [u8]) -> Self {
+        Self { buf }
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.buf.is_empty()
+    }
+
+    fn take(&mut self, n: usize) -> Result<&'a [u8]> {
+        if self.buf.len() < n {
+            return Err(corrupt("item runs past the end of its frame"));
+        }
+        let (head, rest) = self.buf.split_at(n);
+        self.buf = rest;
+        Ok(head)
+    }
+
+    fn array<const N: usize>(&mut self) -> Result<[u8; N]> {
+        Ok(self.take(N)?.try_into().unwrap())
+    }
+
+    pub fn u8(&mut self) -> Result<u8> {
+        Ok(self.take(1)?[0])
+    }
+
+    pub fn u32(&mut self) -> Result<u32> {
+        Ok(u32::from_le_bytes(self.array()?))
+    }
+
+    pub fn u64(&mut self) -> Result<u64> {
+        Ok(u64::from_le_bytes(self.array()?))
+    }
+
+    pub fn i64(&mut self) -> Result<i64> {
+        Ok(i64::from_le_bytes(self.array()?))
+    }
+
+    pub fn f64(&mut self) -> Result<f64> {
+        Ok(f64::from_le_bytes(self.array()?))
+    }
+
+    pub fn blob(&mut self) -> Result<&'a [u8]> {
+        let len = self.u32()? as usize;
+        self.take(len)
+    }
+
+    /// A blob that must be UTF-8 (key names, hash fields, geo members)
+    pub fn text(&mut self) -> Result<&'a str> {
+        std::str::from_utf8(self.blob()?).map_err(|_| corrupt("text is not UTF-8"))
+    }
+}
+
+const CRC_TABLE: [u32; 256] = {
+    let mut table = [0u32; 256];
+    let mut i = 0;
+    while i < 256 {
+        let mut c = i as u32;
+        let mut k = 0;
+        while k < 8 {
+            c = if c & 1 != 0 {
+                0xEDB8_8320 ^ (c >> 1)
+            } else {
+                c >> 1
+            };
+            k += 1;
+        }
+        table[i] = c;
+        i += 1;
+    }
+    table
+};
+
+/// CRC-32 (IEEE, as in zlib and gzip)
+pub fn crc32(bytes: &[u8]) -> u32 {
+    let mut c = !0u32;
+    for &b in bytes {
+        c = CRC_TABLE[((c ^ b as u32) & 0xff) as usize] ^ (c >> 8);
+    }
+    !c
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn sample(items: usize) -> Vec<u8> {
+        let mut w = Writer::new(Vec::new(), 1234).unwrap();
+        w.u8(TAG_KEY)
+            .u8(2)
+            .u32(0)
+            .i64(0)
+            .blob(b"h")
+            .u64(items as u64);
+        w.end_item().unwrap();
+        for i in 0..items {
+            w.blob(format!("f{}", i).as_bytes()).blob(&[7u8; 100]);
+            w.end_item().unwrap();
+        }
+        let (out, written) = w.finish(1).unwrap();
+        assert_eq!(written, out.len() as u64);
+        out
+    }
+
+    #[test]
+    fn test_crc32() {
+        assert_eq!(crc32(b""), 0);
+        assert_eq!(crc32(b"123456789"), 0xCBF4_3926);
+    }
+
+    #[test]
+    fn test_round_trip_across_frames() {
+        let items = 20_000;
+        let bytes = sample(items);
+        let mut reader = Reader::new(bytes.as_slice()).unwrap();
+        let mut frames = 0;
+        let mut fields = 0;
+        let mut keys = None;
+        let mut header = true;
+        while let Some(frame) = reader.next_frame().unwrap() {
+            assert!(frame.len() < FRAME_TARGET + 200);
+            frames += 1;
+            let mut cur = Cursor::new(frame);
+            while !cur.is_empty() {
+                if header {
+                    assert_eq!(cur.u8().unwrap(), TAG_KEY);
+                    assert_eq!(cur.u8().unwrap(), 2);
+                    assert_eq!(cur.u32().unwrap(), 0);
+                    assert_eq!(cur.i64().unwrap(), 0);
+                    assert_eq!(cur.text().unwrap(), "h");
+                    assert_eq!(cur.u64().unwrap(), items as u64);
+                    header = false;
+                } else if fields < items {
+                    assert_eq!(cur.text().unwrap(), format!("f{}", fields));
+                    assert_eq!(cur.blob().unwrap(), &[7u8; 100]);
+                    fields += 1;
+                } else {
+                    assert_eq!(cur.u8().unwrap(), TAG_END);
+                    keys = Some(cur.u64().unwrap());
+                }
+            }
+        }
+        assert!(frames > 1);
+        assert_eq!(fields, items);
+        assert_eq!(keys, Some(1));
+    }
+
+    #[test]
+    fn test_detects_corruption() {
+        let mut bytes = sample(10);
+        assert!(Reader::new(&bytes[..10]).is_err());
+        assert!(
+            Reader::new(&b"NOTASNAP\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0"[..]).is_err()
+        );
+
+        let mut truncated = Reader::new(&bytes[..bytes.len() - 3]).unwrap();
+        assert!(truncated.next_frame().is_err());
+
+        let last = bytes.len() - 1;
+        bytes[last] ^= 0xff;
+        let mut flipped = Reader::new(bytes.as_slice()).unwrap();
+        let err = flipped.next_frame().unwrap_err().to_string();
+        assert!(err.contains("checksum"), "{}", err);
+    }
+}
@@ -1,5 +1,7 @@
 use std::time::Duration;
 
+use crate::db::EvictionPolicy;
+
 /// Configuration for adaptive polling in sync blocking operations.
 /// Used by blpop_sync, brpop_sync, xread_block_sync, xreadgroup_block_sync.
 #[derive(Debug, Clone, Copy)]
@@ -105,6 +107,52 @@ impl ZMember {
     }
 }
 
+/// One record for `Db::bulk_load`. Records borrow their data so a batch
+/// can point straight into a caller's buffer.
+#[derive(Debug, Clone, Copy)]
+pub enum BulkRecord<'a> {
+    /// SET key value [PX ttl]
+    String {
+        key: &'a str,
+        value: &'a [u8],
+        ttl: Option<Duration>,
+    },
+    /// HSET key field value
+    Hash {
+        key: &'a str,
+        field: &'a str,
+        value: &'a [u8],
+    },
+    /// SADD key member
+    Set { key: &'a str, member: &'a [u8] },
+    /// ZADD key score member
+    ZSet {
+        key: &'a str,
+        member: &'a [u8],
+        score: f64,
+    },
+}
+
+impl<'a> BulkRecord<'a> {
+    pub fn key(&self) -> &'a str {
+        match *self {
+            BulkRecord::String { key, .. }
+            | BulkRecord::Hash { key, .. }
+            | BulkRecord::Set { key, .. }
+            | BulkRecord::ZSet { key, .. } => key,
+        }
+    }
+
+    pub fn key_type(&self) -> KeyType {
+        match self {
+            BulkRecord::String { .. } => KeyType::String,
+            BulkRecord::Hash { .. } => KeyType::Hash,
+            BulkRecord::Set { .. } => KeyType::Set,
+            BulkRecord::ZSet { .. } => KeyType::ZSet,
+        }
+    }
+}
+
 #[derive(Debug, Clone, Default)]
 pub struct SetOptions {
     pub ttl: Option<Duration>,
@@ -128,6 +176,194 @@ impl SetOptions {
     }
 }
 
+/// Default prepared-statement cache capacity. rusqlite's own default (16) is
+/// smaller than the set of statements a mixed workload cycles through, which
+/// turns every command into a fresh prepare.
+pub(crate) const DEFAULT_STATEMENT_CACHE_CAPACITY: usize = 256;
+
+/// SQLite `PRAGMA synchronous` level
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum Synchronous {
+    /// No fsync; a power loss can corrupt the database
+    Off,
+    /// fsync at checkpoints only; a power loss can lose the last commits (WAL default)
+    Normal,
+    /// fsync on every commit
+    Full,
+    /// Full, plus an fsync of the directory after WAL resets
+    Extra,
+}
+
+impl Synchronous {
+    pub fn as_str(&self) -> &'static str {
+        match self {
+            Self::Off => "OFF",
+            Self::Normal => "NORMAL",
+            Self::Full => "FULL",
+            Self::Extra => "EXTRA",
+        }
+    }
+}
+
+/// SQLite connection settings for `Db::open_with_options`
+#[derive(Debug, Clone)]
+pub struct OpenOptions {
+    /// Page cache size in MB (default: 64)
+    pub cache_mb: i64,
+    /// Bytes of the file read through memory-mapped I/O; 0 disables (default: 256 MB)
+    pub mmap_size: i64,
+    /// Commit durability (default: Normal)
+    pub synchronous: Synchronous,
+    /// Page size in bytes, a power of two from 512 to 65536. Only applies to a
+    /// new database; None keeps SQLite's default (4096)
+    pub page_size: Option<u32>,
+    /// WAL size in pages that triggers an automatic checkpoint; 0 disables (default: 1000)
+    pub wal_autocheckpoint: i64,
+    /// Keep temporary tables and indexes in memory (default: true)
+    pub temp_store_memory: bool,
+    /// Create the database with `auto_vacuum = INCREMENTAL` so that
+    /// `Db::maintenance_step` can return free pages in small chunks. Existing
+    /// files are converted by one `Db::vacuum` (default: false)
+    pub incremental_vacuum: bool,
+    /// How long a write waits for another connection's lock (default: 5000)
+    pub busy_timeout_ms: i64,
+    /// Prepared-statement cache capacity (default: 256)
+    pub statement_cache: usize,
+    /// Memory budget in bytes, enforced by `eviction_policy`; 0 = unlimited (default: 0)
+    pub max_memory: u64,
+    /// Budget for database pages in use, in bytes; 0 = unlimited (default: 0)
+    pub max_disk: u64,
+    /// Which keys to evict over `max_memory` / `max_disk` (default: NoEviction)
+    pub eviction_policy: EvictionPolicy,
+}
+
+impl Default for OpenOptions {
+    fn default() -> Self {
+        Self {
+            cache_mb: 64,
+            mmap_size: 256 * 1024 * 1024,
+            synchronous: Synchronous::Normal,
+            page_size: None,
+            wal_autocheckpoint: 1000,
+            temp_store_memory: true,
+            incremental_vacuum: false,
+            busy_timeout_ms: 5000,
+            statement_cache: DEFAULT_STATEMENT_CACHE_CAPACITY,
+            max_memory: 0,
+            max_disk: 0,
+            eviction_policy: EvictionPolicy::NoEviction,
+        }
+    }
+}
+
+impl OpenOptions {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    pub fn cache_mb(mut self, cache_mb: i64) -> Self {
+        self.cache_mb = cache_mb;
+        self
+    }
+
+    pub fn mmap_size(mut self, bytes: i64) -> Self {
+        self.mmap_size = bytes;
+        self
+    }
+
+    pub fn synchronous(mut self, level: Synchronous) -> Self {
+        self.synchronous = level;
+        self
+    }
+
+    pub fn page_size(mut self, bytes: u32) -> Self {
+        self.page_size = Some(bytes);
+        self
+    }
+
+    pub fn wal_autocheckpoint(mut self, pages: i64) -> Self {
+        self.wal_autocheckpoint = pages;
+        self
+    }
+
+    pub fn temp_store_memory(mut self, enabled: bool) -> Self {
+        self.temp_store_memory = enabled;
+        self
+    }
+
+    pub fn incremental_vacuum(mut self, enabled: bool) -> Self {
+        self.incremental_vacuum = enabled;
+        self
+    }
+
+    pub fn busy_timeout_ms(mut self, ms: i64) -> Self {
+        self.busy_timeout_ms = ms;
+        self
+    }
+
+    pub fn statement_cache(mut self, capacity: usize) -> Self {
+        self.statement_cache = capacity;
+        self
+    }
+
+    pub fn max_memory(mut self, bytes: u64) -> Self {
+        self.max_memory = bytes;
+        self
+    }
+
+    pub fn max_disk(mut self, bytes: u64) -> Self {
+        self.max_disk = bytes;
+        self
+    }
+
+    pub fn eviction_policy(mut self, policy: EvictionPolicy) -> Self {
+        self.eviction_policy = policy;
+        self
+    }
+}
+
+/// Result of one `Db::maintenance_step` slice
+#[derive(Debug, Clone, Copy, Default)]
+pub struct MaintenanceStep {
+    /// Expired keys deleted
+    pub keys_reclaimed: u64,
+    /// Live keys evicted to meet `max_disk` / `max_memory`
+    pub keys_evicted: u64,
+    /// Free pages released by incremental vacuum
+    pub pages_freed: u64,
+    /// Whether an idle WAL checkpoint ran
+    pub checkpointed: bool,
+    /// How long the connection was held, in microseconds
+    pub pause_us: u64,
+    /// The budget ran out with expired keys, keys to evict or free pages left
+    pub more: bool,
+}
+
+/// Cumulative maintenance counters (`Db::maintenance_stats`)
+#[derive(Debug, Clone, Copy, Default)]
+pub struct MaintenanceStats {
+    pub steps: u64,
+    /// Includes keys deleted by inline autovacuum
+    pub keys_reclaimed: u64,
+    /// Includes keys evicted inline by writes
+    pub keys_evicted: u64,
+    pub pages_freed: u64,
+    pub checkpoints: u64,
+    pub pause_total_us: u64,
+    pub pause_max_us: u64,
+}
+
+/// Result of `Db::export_snapshot` / `Db::import_snapshot`
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct SnapshotStats {
+    /// Keys written or loaded (expired keys are skipped)
+    pub keys: u64,
+    /// Values, fields, members, entries and coordinates of those keys
+    pub items: u64,
+    /// Size of the snapshot file
+    pub bytes: u64,
+}
+
 /// Direction for list operations (LMOVE, BLMOVE)
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub enum ListDirection {
@@ -413,6 +649,40 @@ impl HistoryStats {
     }
 }
 
+/// SQLite-level counters for a database connection (see `Db::sqlite_stats`)
+///
+/// Page cache and statement counters are cumulative since the connection was
+/// opened. A cache miss reads a page from the file (or the OS page cache), so
+/// misses track I/O; time that is neither I/O nor query work is usually spent
+/// waiting for the connection lock.
+#[derive(Debug, Clone, Default)]
+pub struct SqliteStats {
+    pub cache_hits: u64,
+    pub cache_misses: u64,
+    pub cache_writes: u64,
+    pub cache_spills: u64,
+    /// Bytes held by the page cache
+    pub cache_bytes: u64,
+    /// Prepared statements currently alive (almost all of them cached)
+    pub statements: u64,
+    /// Bytes held by prepared statements
+    pub statement_bytes: u64,
+    /// Executions of the live statements; each run after a statement's first
+    /// one reused a cached statement instead of preparing it again
+    pub statement_runs: u64,
+    /// Explicit WAL checkpoints (`Db::checkpoint`) and their durations
+    pub checkpoints: u64,
+    pub checkpoint_total_us: u64,
+    pub checkpoint_max_us: u64,
+}
+
+impl SqliteStats {
+    /// Statement executions that reused a cached statement
+    pub fn statement_reuses(&self) -> u64 {
+        self.statement_runs.saturating_sub(self.statements)
+    }
+}
+
 // ============================================================================
 // Full-Text Search Types (Session 24.1)
 // ============================================================================
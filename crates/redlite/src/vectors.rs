@@ -0,0 +1,366 @@
+//! Similarity kernels and IVF index helpers for vector sets (VSIM)
+//!
+//! Embeddings are stored as little-endian FP32 blobs. The kernels read those
+//! blobs in place instead of decoding them into a `Vec<f32>` first. The
+//! portable kernels keep eight independent accumulators so LLVM vectorizes
+//! the loop (SSE2/NEON). On x86_64 CPUs with AVX2 and FMA (detected at
+//! runtime) 256-bit fused multiply-add kernels are used instead.
+
+use std::cmp::Ordering;
+use std::collections::BinaryHeap;
+
+const LANES: usize = 8;
+
+#[inline(always)]
+fn load(b: &[u8], i: usize) -> f32 {
+    f32::from_le_bytes([b[4 * i], b[4 * i + 1], b[4 * i + 2], b[4 * i + 3]])
+}
+
+#[inline(always)]
+fn dot_blob_generic(query: &[f32], blob: &[u8]) -> f32 {
+    let n = query.len().min(blob.len() / 4);
+    let split = n - n % LANES;
+    let mut acc = [0.0f32; LANES];
+    for (q, b) in query[..split]
+        .chunks_exact(LANES)
+        .zip(blob[..split * 4].chunks_exact(LANES * 4))
+    {
+        for i in 0..LANES {
+            acc[i] += q[i] * load(b, i);
+        }
+    }
+    let mut sum: f32 = acc.iter().sum();
+    for i in split..n {
+        sum += query[i] * load(blob, i);
+    }
+    sum
+}
+
+#[inline(always)]
+fn dot_generic(a: &[f32], b: &[f32]) -> f32 {
+    let n = a.len().min(b.len());
+    let split = n - n % LANES;
+    let mut acc = [0.0f32; LANES];
+    for (x, y) in a[..split]
+        .chunks_exact(LANES)
+        .zip(b[..split].chunks_exact(LANES))
+    {
+        for i in 0..LANES {
+            acc[i] += x[i] * y[i];
+        }
+    }
+    let mut sum: f32 = acc.iter().sum();
+    for i in split..n {
+        sum += a[i] * b[i];
+    }
+    sum
+}
+
+/// Sum of the eight lanes, in the same order as the generic kernels
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2,fma")]
+unsafe fn sum_lanes(acc: std::arch::x86_64::__m256) -> f32 {
+    let mut lanes = [0.0f32; LANES];
+    std::arch::x86_64::_mm256_storeu_ps(lanes.as_mut_ptr(), acc);
+    lanes.iter().sum()
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2,fma")]
+unsafe fn dot_blob_avx2(query: &[f32], blob: &[u8]) -> f32 {
+    use std::arch::x86_64::*;
+    let n = query.len().min(blob.len() / 4);
+    let split = n - n % LANES;
+    let mut acc = _mm256_setzero_ps();
+    // x86_64 is little-endian, so the blob bytes load as FP32 directly
+    for i in (0..split).step_by(LANES) {
+        let q = _mm256_loadu_ps(query.as_ptr().add(i));
+        let b = _mm256_loadu_ps(blob.as_ptr().add(4 * i) as *const f32);
+        acc = _mm256_fmadd_ps(q, b, acc);
+    }
+    let mut sum = sum_lanes(acc);
+    for i in split..n {
+        sum += query[i] * load(blob, i);
+    }
+    sum
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2,fma")]
+unsafe fn dot_avx2(a: &[f32], b: &[f32]) -> f32 {
+    use std::arch::x86_64::*;
+    let n = a.len().min(b.len());
+    let split = n - n % LANES;
+    let mut acc = _mm256_setzero_ps();
+    for i in (0..split).step_by(LANES) {
+        let x = _mm256_loadu_ps(a.as_ptr().add(i));
+        let y = _mm256_loadu_ps(b.as_ptr().add(i));
+        acc = _mm256_fmadd_ps(x, y, acc);
+    }
+    let mut sum = sum_lanes(acc);
+    for i in split..n {
+        sum += a[i] * b[i];
+    }
+    sum
+}
+
+#[cfg(target_arch = "x86_64")]
+fn has_avx2() -> bool {
+    std::is_x86_feature_detected!("avx2") && std::is_x86_feature_detected!("fma")
+}
+
+/// Dot product of `query` with an FP32 blob (extra elements on either side are ignored)
+pub fn dot_blob(query: &[f32], blob: &[u8]) -> f32 {
+    #[cfg(target_arch = "x86_64")]
+    if has_avx2() {
+        // SAFETY: the CPU supports the enabled features
+        return unsafe { dot_blob_avx2(query, blob) };
+    }
+    dot_blob_generic(query, blob)
+}
+
+/// Dot product of two vectors (extra elements on either side are ignored)
+pub fn dot(a: &[f32], b: &[f32]) -> f32 {
+    #[cfg(target_arch = "x86_64")]
+    if has_avx2() {
+        // SAFETY: the CPU supports the enabled features
+        return unsafe { dot_avx2(a, b) };
+    }
+    dot_generic(a, b)
+}
+
+/// Euclidean norm of a vector
+pub fn norm(v: &[f32]) -> f32 {
+    dot(v, v).sqrt()
+}
+
+/// Euclidean norm of an FP32 blob
+pub fn norm_blob(blob: &[u8]) -> f32 {
+    let v = decode(blob);
+    norm(&v)
+}
+
+/// Decode an FP32 blob
+pub fn decode(blob: &[u8]) -> Vec<f32> {
+    (0..blob.len() / 4).map(|i| load(blob, i)).collect()
+}
+
+/// Cosine similarity from a dot product and both norms (0 for zero vectors)
+pub fn cosine(dot: f32, norm_a: f32, norm_b: f32) -> f64 {
+    if norm_a == 0.0 || norm_b == 0.0 {
+        0.0
+    } else {
+        (dot / (norm_a * norm_b)) as f64
+    }
+}
+
+/// Train `nlist` unit-length centroids with spherical k-means
+///
+/// `sample` should already be a bounded subset of the set (a few hundred
+/// vectors per list is plenty). Initial centroids are evenly spaced samples,
+/// so training is deterministic. Empty lists keep their previous centroid.
+pub fn train_centroids(sample: &[Vec<f32>], nlist: usize, iterations: usize) -> Vec<Vec<f32>> {
+    let nlist = nlist.min(sample.len()).max(1);
+    if sample.is_empty() {
+        return Vec::new();
+    }
+    let unit: Vec<Vec<f32>> = sample.iter().map(|v| normalized(v)).collect();
+    let dims = unit[0].len();
+    let mut centroids: Vec<Vec<f32>> = (0..nlist)
+        .map(|i| unit[i * unit.len() / nlist].clone())
+        .collect();
+
+    for _ in 0..iterations {
+        let mut sums = vec![vec![0.0f32; dims]; nlist];
+        let mut counts = vec![0usize; nlist];
+        for v in &unit {
+            let list = nearest(&centroids, v);
+            counts[list] += 1;
+            for (s, x) in sums[list].iter_mut().zip(v) {
+                *s += x;
+            }
+        }
+        let mut moved = false;
+        for (list, sum) in sums.into_iter().enumerate() {
+            if counts[list] == 0 {
+                continue;
+            }
+            let next = normalized(&sum);
+            if next != centroids[list] {
+                moved = true;
+                centroids[list] = next;
+            }
+        }
+        if !moved {
+            break;
+        }
+    }
+    centroids
+}
+
+/// Index of the centroid with the highest dot product with `v`
+pub fn nearest(centroids: &[Vec<f32>], v: &[f32]) -> usize {
+    let mut best = 0;
+    let mut best_score = f32::NEG_INFINITY;
+    for (i, c) in centroids.iter().enumerate() {
+        let score = dot(c, v);
+        if score > best_score {
+            best = i;
+            best_score = score;
+        }
+    }
+    best
+}
+
+/// Indices of the `nprobe` centroids closest to `query`, best first
+pub fn nearest_n(centroids: &[Vec<f32>], query: &[f32], nprobe: usize) -> Vec<usize> {
+    let mut top = TopK::new(nprobe);
+    for (i, c) in centroids.iter().enumerate() {
+        top.push(dot(c, query) as f64, i);
+    }
+    top.into_sorted().into_iter().map(|(_, i)| i).collect()
+}
+
+fn normalized(v: &[f32]) -> Vec<f32> {
+    let n = norm(v);
+    if n == 0.0 {
+        v.to_vec()
+    } else {
+        v.iter().map(|x| x / n).collect()
+    }
+}
+
+struct Scored<T> {
+    score: f64,
+    item: T,
+}
+
+impl<T> PartialEq for Scored<T> {
+    fn eq(&self, other: &Self) -> bool {
+        self.score.total_cmp(&other.score) == Ordering::Equal
+    }
+}
+
+impl<T> Eq for Scored<T> {}
+
+impl<T> PartialOrd for Scored<T> {
+    fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
+        Some(self.cmp(other))
+    }
+}
+
+impl<T> Ord for Scored<T> {
+    // Reversed so the BinaryHeap keeps the lowest score on top
+    fn cmp(&self, other: &Self) -> Ordering {
+        other.score.total_cmp(&self.score)
+    }
+}
+
+/// Bounded collection of the `k` highest-scoring items
+pub struct TopK<T> {
+    k: usize,
+    heap: BinaryHeap<Scored<T>>,
+}
+
+impl<T> TopK<T> {
+    pub fn new(k: usize) -> Self {
+        Self {
+            k,
+            heap: BinaryHeap::with_capacity(k.saturating_add(1).min(4096)),
+        }
+    }
+
+    /// Whether an item with `score` would be kept (check before building it)
+    pub fn accepts(&self, score: f64) -> bool {
+        if self.k == 0 {
+            return false;
+        }
+        self.heap.len() < self.k || self.heap.peek().map_or(true, |min| score > min.score)
+    }
+
+    pub fn push(&mut self, score: f64, item: T) {
+        if !self.accepts(score) {
+            return;
+        }
+        if self.heap.len() == self.k {
+            self.heap.pop();
+        }
+        self.heap.push(Scored { score, item });
+    }
+
+    /// Items ordered by descending score
+    pub fn into_sorted(self) -> Vec<(f64, T)> {
+        // Ascending in heap order = descending by score
+        self.heap
+            .into_sorted_vec()
+            .into_iter()
+            .map(|s| (s.score, s.item))
+            .collect()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn blob(v: &[f32]) -> Vec<u8> {
+        v.iter().flat_map(|f| f.to_le_bytes()).collect()
+    }
+
+    #[test]
+    fn test_dot_matches_scalar() {
+        for n in [1usize, 7, 8, 9, 31, 768] {
+            let a: Vec<f32> = (0..n).map(|i| (i as f32 * 0.37).sin()).collect();
+            let b: Vec<f32> = (0..n).map(|i| (i as f32 * 0.11).cos()).collect();
+            let expected: f32 = a.iter().zip(&b).map(|(x, y)| x * y).sum();
+            assert!((dot(&a, &b) - expected).abs() < 1e-3);
+            assert!((dot_blob(&a, &blob(&b)) - expected).abs() < 1e-3);
+        }
+    }
+
+    #[test]
+    fn test_dot_blob_length_mismatch() {
+        assert_eq!(dot_blob(&[1.0, 2.0, 3.0], &blob(&[1.0, 1.0])), 3.0);
+        assert_eq!(dot_blob(&[2.0], &blob(&[3.0, 5.0])), 6.0);
+    }
+
+    #[test]
+    fn test_norm_and_cosine() {
+        assert_eq!(norm(&[3.0, 4.0]), 5.0);
+        assert_eq!(norm_blob(&blob(&[3.0, 4.0])), 5.0);
+        assert_eq!(cosine(1.0, 0.0, 1.0), 0.0);
+        assert!((cosine(25.0, 5.0, 5.0) - 1.0).abs() < 1e-9);
+    }
+
+    #[test]
+    fn test_topk_keeps_highest() {
+        let mut top = TopK::new(3);
+        for (i, s) in [0.1, 0.9, 0.5, 0.7, 0.2].iter().enumerate() {
+            top.push(*s, i);
+        }
+        assert!(!top.accepts(0.3));
+        assert!(top.accepts(0.8));
+        let sorted = top.into_sorted();
+        assert_eq!(sorted.iter().map(|(_, i)| *i).collect::<Vec<_>>(), vec![1, 3, 2]);
+        assert!(TopK::<usize>::new(0).into_sorted().is_empty());
+    }
+
+    #[test]
+    fn test_train_centroids_separates_clusters() {
+        let mut sample = Vec::new();
+        for i in 0..50 {
+            let jitter = i as f32 * 0.001;
+            sample.push(vec![1.0, jitter, 0.0]);
+            sample.push(vec![0.0, jitter, 1.0]);
+        }
+        let centroids = train_centroids(&sample, 2, 10);
+        assert_eq!(centroids.len(), 2);
+        let a = nearest(&centroids, &[1.0, 0.0, 0.0]);
+        let b = nearest(&centroids, &[0.0, 0.0, 1.0]);
+        assert_ne!(a, b);
+        assert_eq!(nearest_n(&centroids, &[1.0, 0.0, 0.1], 2), vec![a, b]);
+        for c in &centroids {
+            assert!((norm(c) - 1.0).abs() < 1e-4);
+        }
+    }
+}
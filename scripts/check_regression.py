@@ -5,11 +5,16 @@ Benchmark Regression Detection Script
 Parses Criterion benchmark output and checks for performance regressions
 exceeding a specified threshold.
 
+Google Benchmark JSON (--benchmark_out_format=json, e.g. from the C++ SDK's
+redlite_cpp_bench) is also accepted. It carries no change estimate of its own,
+so pass the JSON of a previous run with --baseline to compute one.
+
 Usage:
-    python3 check_regression.py <benchmark_output_file> <threshold_percent>
+    python3 check_regression.py <benchmark_output_file> <threshold_percent> [--baseline <json>]
 
 Example:
     python3 check_regression.py benchmark_output.txt 15
+    python3 check_regression.py cpp_bench.json 15 --baseline cpp_bench_main.json
 
 Exit codes:
     0 - No regressions detected
@@ -17,6 +22,7 @@ Exit codes:
     2 - Error parsing benchmark output
 """
 
+import json
 import re
 import sys
 from dataclasses import dataclass
@@ -119,6 +125,67 @@ def parse_benchmark_output(filepath: str) -> list[BenchmarkResult]:
     return results
 
 
+GBENCH_UNITS = {
+    'ns': 1,
+    'us': 1000,
+    'ms': 1_000_000,
+    's': 1_000_000_000,
+}
+
+
+def load_gbench_times(filepath: str) -> Optional[dict[str, float]]:
+    """Load Google Benchmark JSON as {name: real_time_ns}, or None if not JSON.
+
+    When the run used repetitions, the "mean" aggregate is used instead of the
+    individual iterations.
+    """
+    try:
+        with open(filepath, 'r') as f:
+            data = json.load(f)
+    except FileNotFoundError:
+        print(f"Error: File not found: {filepath}", file=sys.stderr)
+        sys.exit(2)
+    except (json.JSONDecodeError, UnicodeDecodeError):
+        return None
+
+    if not isinstance(data, dict) or 'benchmarks' not in data:
+        return None
+
+    times = {}
+    means = {}
+    for bench in data['benchmarks']:
+        if bench.get('error_occurred'):
+            continue
+        time_ns = bench['real_time'] * GBENCH_UNITS.get(bench.get('time_unit', 'ns'), 1)
+        if bench.get('run_type') == 'aggregate':
+            if bench.get('aggregate_name') == 'mean':
+                means[bench['run_name']] = time_ns
+        else:
+            times.setdefault(bench.get('run_name', bench['name']), time_ns)
+
+    times.update(means)
+    return times
+
+
+def parse_gbench_output(times: dict[str, float], baseline_path: Optional[str]) -> list[BenchmarkResult]:
+    """Build results from Google Benchmark times, with change vs. an optional baseline."""
+    baseline = {}
+    if baseline_path:
+        baseline = load_gbench_times(baseline_path)
+        if baseline is None:
+            print(f"Error: Baseline is not Google Benchmark JSON: {baseline_path}", file=sys.stderr)
+            sys.exit(2)
+
+    results = []
+    for name, time_ns in times.items():
+        result = BenchmarkResult(name=name, time_ns=time_ns)
+        base_ns = baseline.get(name)
+        if base_ns:
+            result.change_percent = (time_ns - base_ns) / base_ns * 100
+        results.append(result)
+    return results
+
+
 def check_regressions(results: list[BenchmarkResult], threshold: float) -> list[BenchmarkResult]:
     """Check for regressions exceeding threshold."""
     regressions = []
@@ -153,10 +220,21 @@ def main():
     filepath = sys.argv[1]
     threshold = float(sys.argv[2])
 
+    baseline_path = None
+    if len(sys.argv) > 3:
+        if sys.argv[3] != '--baseline' or len(sys.argv) != 5:
+            print(__doc__)
+            sys.exit(2)
+        baseline_path = sys.argv[4]
+
     print(f"Checking for regressions > {threshold}% in {filepath}")
     print("-" * 60)
 
-    results = parse_benchmark_output(filepath)
+    gbench_times = load_gbench_times(filepath)
+    if gbench_times is not None:
+        results = parse_gbench_output(gbench_times, baseline_path)
+    else:
+        results = parse_benchmark_output(filepath)
 
     if not results:
         print("Warning: No benchmark results found in output file")
@@ -6,13 +6,17 @@ Compares current benchmark runs against the saved baseline.json file.
 Run benchmarks first with: cargo bench --bench redlite_benchmarks
 
 Usage:
-    python3 scripts/compare_baseline.py [threshold_percent]
+    python3 scripts/compare_baseline.py [threshold_percent] [--gbench <json> [--backend memory|file]]
 
 Example:
     python3 scripts/compare_baseline.py 15
     python3 scripts/compare_baseline.py  # Uses default 10% threshold
+
+    # C++ SDK results (redlite_cpp_bench --benchmark_out_format=json)
+    python3 scripts/compare_baseline.py 15 --gbench cpp_bench.json
 """
 
+import argparse
 import json
 import os
 import re
@@ -90,6 +94,49 @@ def parse_criterion_estimates(criterion_dir: str) -> dict:
     return results
 
 
+GBENCH_UNITS = {
+    'ns': 1,
+    'us': 1000,
+    'ms': 1_000_000,
+    's': 1_000_000_000,
+}
+
+
+def parse_gbench_results(gbench_path: str, backend: str) -> dict:
+    """Parse Google Benchmark JSON from redlite_cpp_bench.
+
+    Benchmarks are named "<backend>/<workload>"; only the requested backend is
+    kept, keyed by workload so the names line up with the Criterion mappings.
+    """
+    try:
+        with open(gbench_path, 'r') as f:
+            data = json.load(f)
+    except FileNotFoundError:
+        print(f"Error: Benchmark file not found: {gbench_path}")
+        sys.exit(2)
+    except json.JSONDecodeError as e:
+        print(f"Error parsing benchmark JSON: {e}")
+        sys.exit(2)
+
+    results = {}
+    means = {}
+    prefix = f"{backend}/"
+    for bench in data.get('benchmarks', []):
+        name = bench.get('run_name', bench['name'])
+        if not name.startswith(prefix) or bench.get('error_occurred'):
+            continue
+        workload = name[len(prefix):]
+        mean_ns = bench['real_time'] * GBENCH_UNITS.get(bench.get('time_unit', 'ns'), 1)
+        if bench.get('run_type') == 'aggregate':
+            if bench.get('aggregate_name') == 'mean':
+                means[workload] = mean_ns
+        else:
+            results.setdefault(workload, mean_ns)
+
+    results.update(means)
+    return results
+
+
 def ns_to_us(ns: float) -> float:
     """Convert nanoseconds to microseconds."""
     return ns / 1000.0
@@ -227,14 +274,15 @@ def print_comparison_table(comparisons: list[dict], threshold: float):
 
 
 def main():
-    # Parse threshold argument
-    threshold = DEFAULT_THRESHOLD
-    if len(sys.argv) > 1:
-        try:
-            threshold = float(sys.argv[1])
-        except ValueError:
-            print(f"Invalid threshold: {sys.argv[1]}")
-            sys.exit(2)
+    parser = argparse.ArgumentParser(description='Compare benchmark results against benches/baseline.json')
+    parser.add_argument('threshold', nargs='?', type=float, default=DEFAULT_THRESHOLD,
+                        help=f'regression threshold in percent (default {DEFAULT_THRESHOLD})')
+    parser.add_argument('--gbench', metavar='JSON',
+                        help='read Google Benchmark JSON instead of target/criterion')
+    parser.add_argument('--backend', choices=['memory', 'file'], default='memory',
+                        help='which redlite_cpp_bench backend to compare (default memory)')
+    args = parser.parse_args()
+    threshold = args.threshold
 
     # Determine paths
     script_dir = Path(__file__).parent
@@ -244,17 +292,23 @@ def main():
 
     print(f"{Colors.BOLD}Redlite Benchmark Comparison{Colors.RESET}")
     print(f"Baseline: {baseline_path}")
-    print(f"Criterion: {criterion_dir}")
+    if args.gbench:
+        print(f"Google Benchmark: {args.gbench} ({args.backend})")
+    else:
+        print(f"Criterion: {criterion_dir}")
 
     # Load baseline
     baseline = load_baseline(str(baseline_path))
     print(f"Baseline date: {baseline.get('baseline_date', 'unknown')}")
 
     # Parse current results
-    current = parse_criterion_estimates(str(criterion_dir))
+    if args.gbench:
+        current = parse_gbench_results(args.gbench, args.backend)
+    else:
+        current = parse_criterion_estimates(str(criterion_dir))
 
     if not current:
-        print(f"\n{Colors.YELLOW}Warning: No Criterion results found.{Colors.RESET}")
+        print(f"\n{Colors.YELLOW}Warning: No benchmark results found.{Colors.RESET}")
         print("Run benchmarks first: cargo bench --bench redlite_benchmarks")
         sys.exit(0)
 
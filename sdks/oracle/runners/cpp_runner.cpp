@@ -2,10 +2,18 @@
  * C++ Oracle Test Runner
  * Validates C++ SDK against oracle test specifications
  *
- * Build: g++ -std=c++17 -o cpp_runner cpp_runner.cpp -lyaml-cpp -L/path/to/lib -lredlite_ffi
- * Usage: ./cpp_runner [-v] ../spec/strings.yaml
+ * Build: g++ -std=c++17 -pthread -o cpp_runner cpp_runner.cpp -lyaml-cpp -L/path/to/lib -lredlite_ffi
+ * Usage: ./cpp_runner [-v] [-j N] ../spec/strings.yaml
+ *
+ * With -j N, tests run on N worker threads. Every test already gets its own
+ * in-memory database, so tests are independent; specs are parsed once up
+ * front and only read (through the const YAML::Node API) by the workers.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -17,6 +25,7 @@
 #include <variant>
 #include <cmath>
 #include <filesystem>
+#include <thread>
 #include <yaml-cpp/yaml.h>
 
 // Include the Redlite C++ SDK
@@ -41,22 +50,66 @@ struct TestResult {
     bool passed;
     std::string test_name;
     std::string error;
+    double duration_ms = 0.0;
+};
+
+// A test from a parsed spec; `test` shares the spec's node memory
+struct TestCase {
+    std::string spec_name;
+    YAML::Node test;
 };
 
 class OracleRunner {
 public:
-    OracleRunner(bool verbose = false) : verbose_(verbose) {}
+    using Clock = std::chrono::steady_clock;
 
-    void runSpecFile(const std::string& path) {
+    OracleRunner(bool verbose = false, unsigned jobs = 1)
+        : verbose_(verbose), jobs_(std::max(1u, jobs)) {}
+
+    // Parse a spec file and queue its tests
+    void addSpecFile(const std::string& path) {
         YAML::Node spec = YAML::LoadFile(path);
         std::string spec_name = spec["name"].as<std::string>();
+        for (const auto& test : spec["tests"]) {
+            tests_.push_back({spec_name, test});
+        }
+    }
+
+    // Run every queued test, spreading them over the worker threads
+    void run() {
+        results_.assign(tests_.size(), TestResult{});
+        auto start = Clock::now();
 
-        if (verbose_) {
-            std::cout << "Running spec: " << spec_name << "\n";
+        // Workers claim tests by index and each writes only its own result
+        // slot, so no locking is needed
+        std::atomic<size_t> next{0};
+        auto worker = [&] {
+            for (size_t i = next.fetch_add(1); i < tests_.size(); i = next.fetch_add(1)) {
+                results_[i] = runTest(tests_[i].test, tests_[i].spec_name);
+            }
+        };
+
+        unsigned workers = static_cast<unsigned>(std::min<size_t>(jobs_, tests_.size()));
+        if (workers <= 1) {
+            worker();
+        } else {
+            std::vector<std::thread> threads;
+            for (unsigned t = 0; t < workers; ++t) threads.emplace_back(worker);
+            for (auto& t : threads) t.join();
         }
+        wall_ms_ = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
 
-        for (const auto& test : spec["tests"]) {
-            runTest(test, spec_name);
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const auto& r = results_[i];
+            if (r.passed) passed_++; else failed_++;
+            if (!verbose_) continue;
+            if (i == 0 || tests_[i].spec_name != tests_[i - 1].spec_name) {
+                std::cout << "Running spec: " << tests_[i].spec_name << "\n";
+            }
+            std::string name = tests_[i].test["name"].as<std::string>();
+            std::cout << (r.passed ? "  ✓ " : "  ✗ ") << name;
+            if (!r.passed) std::cout << ": " << r.error;
+            std::cout << " (" << formatMs(r.duration_ms) << ")\n";
         }
     }
 
@@ -64,12 +117,33 @@ public:
         std::cout << "\n=== Results ===\n";
         std::cout << "Passed: " << passed_ << "\n";
         std::cout << "Failed: " << failed_ << "\n";
-
-        if (!errors_.empty()) {
-            std::cout << "\nErrors:\n";
-            for (const auto& err : errors_) {
-                std::cout << "  - " << err.test_name << ": " << err.error << "\n";
-            }
+        std::cout << "Time:   " << formatMs(wall_ms_) << " (" << jobs_ << " job"
+                  << (jobs_ == 1 ? "" : "s") << ")\n";
+
+        // Slowest tests first, to spot specs worth splitting or trimming
+        std::vector<const TestResult*> sorted;
+        for (const auto& r : results_) sorted.push_back(&r);
+        size_t shown = std::min<size_t>(kSlowest, sorted.size());
+        std::partial_sort(sorted.begin(), sorted.begin() + shown, sorted.end(),
+                          [](const TestResult* a, const TestResult* b) {
+                              return a->duration_ms > b->duration_ms;
+                          });
+        if (shown > 0) {
+            std::cout << "\nSlowest:\n";
+            for (size_t i = 0; i < shown; ++i) {
+                std::cout << "  " << std::setw(10) << formatMs(sorted[i]->duration_ms)
+                          << "  " << sorted[i]->test_name << "\n";
+            }
+        }
+
+        bool header = false;
+        for (const auto& err : results_) {
+            if (err.passed) continue;
+            if (!header) {
+                std::cout << "\nErrors:\n";
+                header = true;
+            }
+            std::cout << "  - " << err.test_name << ": " << err.error << "\n";
         }
     }
 
@@ -78,14 +152,30 @@ public:
     }
 
 private:
+    static constexpr size_t kSlowest = 10;
+
     bool verbose_;
+    unsigned jobs_;
     int passed_ = 0;
     int failed_ = 0;
-    std::vector<TestResult> errors_;
+    double wall_ms_ = 0.0;
+    std::vector<TestCase> tests_;
+    std::vector<TestResult> results_;   // Parallel to tests_
+
+    static std::string formatMs(double ms) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(ms < 10 ? 2 : 1) << ms << " ms";
+        return oss.str();
+    }
 
-    void runTest(const YAML::Node& test, const std::string& spec_name) {
+    // Runs on worker threads: touches no runner state
+    TestResult runTest(const YAML::Node& test, const std::string& spec_name) {
         std::string test_name = test["name"].as<std::string>();
         std::string full_name = spec_name + " :: " + test_name;
+        auto start = Clock::now();
+        auto elapsed = [&] {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        };
 
         try {
             auto db = Database::open_memory();
@@ -110,23 +200,16 @@ private:
                 }
             }
 
-            passed_++;
-            if (verbose_) {
-                std::cout << "  ✓ " << test_name << "\n";
-            }
+            return {true, full_name, "", elapsed()};
 
         } catch (const std::exception& e) {
-            failed_++;
-            errors_.push_back({false, full_name, e.what()});
-            if (verbose_) {
-                std::cout << "  ✗ " << test_name << ": " << e.what() << "\n";
-            }
+            return {false, full_name, e.what(), elapsed()};
         }
     }
 
     Value executeCmd(Database& db, const YAML::Node& op) {
         std::string cmd = op["cmd"].as<std::string>();
-        auto args = op["args"];
+        const YAML::Node args = op["args"];
 
         // String commands
         if (cmd == "GET") {
@@ -635,37 +718,50 @@ private:
 
 int main(int argc, char* argv[]) {
     bool verbose = false;
+    unsigned jobs = 1;
     std::vector<std::string> spec_files;
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
         if (arg == "-v" || arg == "--verbose") {
             verbose = true;
+        } else if (arg == "-j" || arg == "--jobs" || arg.rfind("-j", 0) == 0) {
+            // -j N, -jN; 0 means one job per hardware thread
+            std::string n = arg.size() > 2 && arg[1] == 'j' ? arg.substr(2)
+                          : i + 1 < argc ? argv[++i] : "";
+            try {
+                jobs = static_cast<unsigned>(std::stoul(n));
+            } catch (...) {
+                std::cerr << "Invalid job count: " << n << "\n";
+                return 1;
+            }
+            if (jobs == 0) jobs = std::max(1u, std::thread::hardware_concurrency());
         } else {
             spec_files.push_back(arg);
         }
     }
 
     if (spec_files.empty()) {
-        std::cerr << "Usage: " << argv[0] << " [-v] <spec.yaml> [spec2.yaml ...]\n";
-        std::cerr << "       " << argv[0] << " [-v] ../spec/    (run all specs in directory)\n";
+        std::cerr << "Usage: " << argv[0] << " [-v] [-j N] <spec.yaml> [spec2.yaml ...]\n";
+        std::cerr << "       " << argv[0] << " [-v] [-j N] ../spec/    (run all specs in directory)\n";
         return 1;
     }
 
-    OracleRunner runner(verbose);
+    OracleRunner runner(verbose, jobs);
 
     for (const auto& path : spec_files) {
         if (fs::is_directory(path)) {
             for (const auto& entry : fs::directory_iterator(path)) {
                 if (entry.path().extension() == ".yaml") {
-                    runner.runSpecFile(entry.path().string());
+                    runner.addSpecFile(entry.path().string());
                 }
             }
         } else {
-            runner.runSpecFile(path);
+            runner.addSpecFile(path);
         }
     }
 
+    runner.run();
     runner.printSummary();
     return runner.getExitCode();
 }
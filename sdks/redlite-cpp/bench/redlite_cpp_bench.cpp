@@ -0,0 +1,282 @@
+/**
+ * Redlite C++ SDK benchmarks
+ *
+ * Workloads from redlite-bench/spec/benchmark-spec.yaml run through the C++
+ * wrapper, once against open_memory() and once against a file-backed
+ * database. Benchmark names are "<backend>/<workload>", where the workload
+ * part matches the Criterion names used by scripts/compare_baseline.py.
+ *
+ *   ./build/redlite_cpp_bench --benchmark_out=cpp_bench.json --benchmark_out_format=json
+ *   python3 scripts/check_regression.py cpp_bench.json 15 --baseline previous.json
+ *   python3 scripts/compare_baseline.py 15 --gbench cpp_bench.json
+ */
+
+#include <benchmark/benchmark.h>
+#include <redlite/redlite.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace redlite;
+
+namespace {
+
+constexpr int kDatasetSize = 1000;
+
+enum class Backend { Memory, File };
+
+const char* backend_name(Backend backend) {
+    return backend == Backend::Memory ? "memory" : "file";
+}
+
+/**
+ * Fresh database per benchmark run; file databases are removed afterwards
+ */
+class BenchDb {
+public:
+    explicit BenchDb(Backend backend, const OpenOptions& options = {})
+        : path_(backend == Backend::File
+                    ? (std::filesystem::temp_directory_path() / "redlite_cpp_bench.db").string()
+                    : std::string()),
+          db_(open(path_, options)) {}
+
+    ~BenchDb() {
+        if (path_.empty()) return;
+        { Database closed = std::move(db_); }
+        std::filesystem::remove(path_);
+        std::filesystem::remove(path_ + "-wal");
+        std::filesystem::remove(path_ + "-shm");
+    }
+
+    Database& operator*() { return db_; }
+    Database* operator->() { return &db_; }
+
+private:
+    static Database open(const std::string& path, const OpenOptions& options) {
+        if (path.empty()) return Database::open(":memory:", options);
+        std::filesystem::remove(path);
+        std::filesystem::remove(path + "-wal");
+        std::filesystem::remove(path + "-shm");
+        return Database::open(path, options);
+    }
+
+    std::string path_;
+    Database db_;
+};
+
+std::string key(const char* prefix, int64_t n) {
+    return std::string(prefix) + std::to_string(n % kDatasetSize);
+}
+
+void populate_strings(Database& db, size_t value_size) {
+    const std::string value(value_size, 'v');
+    auto tx = db.transaction();
+    for (int i = 0; i < kDatasetSize; ++i) db.set(key("str:", i), value);
+    tx.commit();
+}
+
+// ==================== Strings ====================
+
+void string_set(benchmark::State& state, Backend backend, size_t value_size) {
+    BenchDb db(backend);
+    const std::string value(value_size, 'v');
+    int64_t n = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->set(key("str:", n++), value));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(value_size));
+}
+
+void string_get(benchmark::State& state, Backend backend, size_t value_size) {
+    BenchDb db(backend);
+    populate_strings(*db, value_size);
+    int64_t n = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->get(key("str:", n++)));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(value_size));
+}
+
+void string_incr(benchmark::State& state, Backend backend) {
+    BenchDb db(backend);
+    int64_t n = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->incr(key("counter:", n++)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void string_mget(benchmark::State& state, Backend backend, int fanout) {
+    BenchDb db(backend);
+    populate_strings(*db, 100);
+    std::vector<std::string> keys;
+    keys.reserve(fanout);
+    for (int i = 0; i < fanout; ++i) keys.push_back(key("str:", i * 7));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->mget(keys));
+    }
+    state.SetItemsProcessed(state.iterations() * fanout);
+}
+
+// ==================== Hashes ====================
+
+std::unordered_map<std::string, std::string> make_fields(int count) {
+    std::unordered_map<std::string, std::string> fields;
+    fields.reserve(count);
+    for (int i = 0; i < count; ++i) fields.emplace("field:" + std::to_string(i), std::string(100, 'v'));
+    return fields;
+}
+
+void hash_hset(benchmark::State& state, Backend backend, int field_count) {
+    BenchDb db(backend);
+    const auto fields = make_fields(field_count);
+    int64_t n = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->hset(key("hash:", n++), fields));
+    }
+    state.SetItemsProcessed(state.iterations() * field_count);
+}
+
+void hash_hget(benchmark::State& state, Backend backend) {
+    BenchDb db(backend);
+    db->hset("hash:bench", make_fields(100));
+    int64_t n = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->hget("hash:bench", "field:" + std::to_string(n++ % 100)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void hash_hgetall(benchmark::State& state, Backend backend, int field_count) {
+    BenchDb db(backend);
+    db->hset("hash:bench", make_fields(field_count));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->hgetall("hash:bench"));
+    }
+    state.SetItemsProcessed(state.iterations() * field_count);
+}
+
+// ==================== Lists ====================
+
+void list_lpush(benchmark::State& state, Backend backend) {
+    BenchDb db(backend);
+    const std::vector<std::string> value{std::string(100, 'v')};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->lpush("list:bench", value));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void list_lrange(benchmark::State& state, Backend backend, int length) {
+    BenchDb db(backend);
+    db->rpush("list:bench", std::vector<std::string>(length, std::string(100, 'v')));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->lrange("list:bench", 0, -1));
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+}
+
+// ==================== Sorted Sets ====================
+
+void sorted_set_zadd(benchmark::State& state, Backend backend) {
+    BenchDb db(backend);
+    int64_t n = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->zadd("zset:bench", static_cast<double>(n), key("member:", n)));
+        ++n;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void sorted_set_zrange(benchmark::State& state, Backend backend, int count) {
+    BenchDb db(backend);
+    std::vector<ZMember> members;
+    members.reserve(kDatasetSize);
+    for (int i = 0; i < kDatasetSize; ++i) members.push_back({static_cast<double>(i), key("member:", i)});
+    db->zadd("zset:bench", members);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db->zrange("zset:bench", 0, count - 1));
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// ==================== Statement Cache ====================
+
+// One GET/SET/HGET/HSET/LPUSH/LRANGE/ZADD/ZRANGE/EXPIRE round per iteration,
+// with rusqlite's default statement cache (16) or the redlite default (256)
+void mixed_hot_commands(benchmark::State& state, Backend backend, size_t statement_cache) {
+    BenchDb db(backend, OpenOptionsBuilder().statement_cache(statement_cache).build());
+    int64_t n = 0;
+    for (auto _ : state) {
+        std::string v = std::to_string(n++ % 100);
+        db->set("s", v);
+        benchmark::DoNotOptimize(db->get("s"));
+        db->hset("h", "f", v);
+        benchmark::DoNotOptimize(db->hget("h", "f"));
+        db->lpush("l", v);
+        benchmark::DoNotOptimize(db->lrange("l", 0, 9));
+        db->zadd("z", static_cast<double>(n % 100), v);
+        benchmark::DoNotOptimize(db->zrange("z", 0, 9));
+        db->expire("s", 100);
+    }
+    state.SetItemsProcessed(state.iterations() * 9);
+    state.counters["statements"] = static_cast<double>(db->stats().statements);
+}
+
+// ==================== Registration ====================
+
+template <typename F, typename... Args>
+void add(Backend backend, const std::string& name, F f, Args... args) {
+    benchmark::RegisterBenchmark((std::string(backend_name(backend)) + "/" + name).c_str(),
+                                 [=](benchmark::State& state) { f(state, backend, args...); });
+}
+
+void register_all(Backend backend) {
+    add(backend, "string_set_64b", string_set, size_t{64});
+    add(backend, "string_set_1024b", string_set, size_t{1024});
+    add(backend, "string_set_10240b", string_set, size_t{10240});
+    add(backend, "string_get", string_get, size_t{64});
+    add(backend, "string_get_1024b", string_get, size_t{1024});
+    add(backend, "string_get_10240b", string_get, size_t{10240});
+    add(backend, "string_incr", string_incr);
+    for (int fanout : {1, 10, 100}) {
+        add(backend, "string_mget_" + std::to_string(fanout), string_mget, fanout);
+    }
+
+    for (int fields : {10, 100, 1000}) {
+        add(backend, "hash_hset_" + std::to_string(fields) + "_fields", hash_hset, fields);
+    }
+    add(backend, "hash_hget", hash_hget);
+    for (int fields : {10, 100}) {
+        add(backend, "hash_hgetall_" + std::to_string(fields), hash_hgetall, fields);
+    }
+
+    add(backend, "list_lpush", list_lpush);
+    for (int length : {10, 100, 1000}) {
+        add(backend, "list_lrange_" + std::to_string(length), list_lrange, length);
+    }
+
+    add(backend, "sorted_set_zadd", sorted_set_zadd);
+    add(backend, "sorted_set_zrange", sorted_set_zrange, 100);
+
+    add(backend, "mixed_statement_cache_16", mixed_hot_commands, size_t{16});
+    add(backend, "mixed_statement_cache_256", mixed_hot_commands, size_t{256});
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    register_all(Backend::Memory);
+    register_all(Backend::File);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
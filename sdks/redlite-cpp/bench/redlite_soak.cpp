@@ -0,0 +1,553 @@
+/**
+ * Redlite C++ SDK soak test
+ *
+ * Runs a mixed GET/HGET/SET/HSET/DEL workload from many threads for as long
+ * as asked, against one shared Database handle on a file, a Pool on the same
+ * kind of file, and open_memory(). Every thread issues commands on a fixed
+ * schedule (--rate per thread) and latency is measured from the time a
+ * command was due, not from when it was sent, so a stall is charged to every
+ * command queued behind it (coordinated-omission correction).
+ *
+ * A maintenance thread runs checkpoint() and vacuum() on a cadence; file
+ * backends open with wal_autocheckpoint(0) so those are the only checkpoints.
+ * Samples that overlap one of them or the --event-window after it, and the
+ * backlog a worker is still draining after one, are kept apart from
+ * steady-state samples; when their p99 exceeds --regression-factor times the
+ * steady p99 the run reports a regression and exits with 1.
+ *
+ *   ./build/redlite_soak --duration 2h --threads 16 --rate 2000 --dist zipf
+ *   ./build/redlite_soak --backend pool --read-ratio 0.95 --value-size 1024
+ */
+
+#include <redlite/metrics.hpp>
+#include <redlite/pool.hpp>
+#include <redlite/redlite.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace redlite;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Histogram = metrics::detail::Histogram;
+
+enum class Backend { Shared, Pool, Memory };
+
+const char* backend_name(Backend backend) {
+    switch (backend) {
+        case Backend::Shared: return "shared";
+        case Backend::Pool: return "pool";
+        case Backend::Memory: return "memory";
+    }
+    return "?";
+}
+
+struct Config {
+    std::vector<Backend> backends{Backend::Shared, Backend::Pool, Backend::Memory};
+    size_t threads = 8;
+    size_t readers = 0;                       // Pool readers; 0 = threads
+    std::chrono::seconds duration{60};        // Per backend
+    std::chrono::seconds report_every{10};
+    double read_ratio = 0.8;
+    size_t keys = 100000;
+    bool zipf = true;
+    double zipf_s = 0.99;
+    size_t value_size = 128;
+    double ttl_fraction = 0.1;                // SETs that carry a TTL
+    int64_t ttl_seconds = 30;
+    double rate = 1000;                       // Commands per second per thread; 0 = closed loop
+    std::chrono::seconds checkpoint_every{30};
+    std::chrono::seconds vacuum_every{300};
+    std::chrono::milliseconds event_window{100};
+    int64_t wal_autocheckpoint = 0;           // 0 leaves every checkpoint to the maintenance thread
+    double regression_factor = 3.0;
+    uint64_t min_event_samples = 1000;
+    std::string path = (std::filesystem::temp_directory_path() / "redlite_soak.db").string();
+};
+
+void usage() {
+    std::printf(
+        "usage: redlite_soak [options]\n"
+        "  --backend shared|pool|memory|all   (all)\n"
+        "  --threads N                        worker threads (8)\n"
+        "  --readers N                        Pool reader handles (threads)\n"
+        "  --duration D                       per backend, e.g. 90s, 30m, 4h (60s)\n"
+        "  --report-every D                   progress interval (10s)\n"
+        "  --read-ratio R                     share of GET/HGET (0.8)\n"
+        "  --keys N                           key space (100000)\n"
+        "  --dist zipf|uniform                key distribution (zipf)\n"
+        "  --zipf-s S                         Zipf exponent (0.99)\n"
+        "  --value-size N                     bytes per value (128)\n"
+        "  --ttl-fraction R                   SETs with a TTL (0.1)\n"
+        "  --ttl N                            TTL in seconds (30)\n"
+        "  --rate N                           commands/s per thread, 0 = closed loop (1000)\n"
+        "  --checkpoint-every D               0 disables (30s)\n"
+        "  --vacuum-every D                   0 disables (300s)\n"
+        "  --event-window MS                  samples this long after an event count as near it (100)\n"
+        "  --wal-autocheckpoint N             WAL pages per automatic checkpoint, 0 disables (0)\n"
+        "  --regression-factor F              near-event p99 / steady p99 that fails the run (3)\n"
+        "  --min-event-samples N              fewer near-event samples are not judged (1000)\n"
+        "  --path FILE                        database file for shared and pool\n");
+}
+
+std::chrono::seconds parse_duration(const std::string& text) {
+    size_t end = 0;
+    double value = std::stod(text, &end);
+    std::string unit = text.substr(end);
+    double scale = unit.empty() || unit == "s" ? 1 : unit == "m" ? 60 : unit == "h" ? 3600 : -1;
+    if (scale < 0) throw std::invalid_argument("bad duration: " + text);
+    return std::chrono::seconds(static_cast<int64_t>(value * scale));
+}
+
+Config parse_args(int argc, char** argv) {
+    Config c;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            usage();
+            std::exit(0);
+        }
+        if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+        std::string v = argv[++i];
+        if (arg == "--backend") {
+            if (v == "all") c.backends = {Backend::Shared, Backend::Pool, Backend::Memory};
+            else if (v == "shared") c.backends = {Backend::Shared};
+            else if (v == "pool") c.backends = {Backend::Pool};
+            else if (v == "memory") c.backends = {Backend::Memory};
+            else throw std::invalid_argument("bad backend: " + v);
+        } else if (arg == "--threads") c.threads = std::max<size_t>(1, std::stoul(v));
+        else if (arg == "--readers") c.readers = std::stoul(v);
+        else if (arg == "--duration") c.duration = parse_duration(v);
+        else if (arg == "--report-every") c.report_every = std::max(std::chrono::seconds(1), parse_duration(v));
+        else if (arg == "--read-ratio") c.read_ratio = std::clamp(std::stod(v), 0.0, 1.0);
+        else if (arg == "--keys") c.keys = std::max<size_t>(1, std::stoul(v));
+        else if (arg == "--dist") {
+            if (v != "zipf" && v != "uniform") throw std::invalid_argument("bad distribution: " + v);
+            c.zipf = v == "zipf";
+        } else if (arg == "--zipf-s") c.zipf_s = std::stod(v);
+        else if (arg == "--value-size") c.value_size = std::stoul(v);
+        else if (arg == "--ttl-fraction") c.ttl_fraction = std::clamp(std::stod(v), 0.0, 1.0);
+        else if (arg == "--ttl") c.ttl_seconds = std::max<int64_t>(1, std::stoll(v));
+        else if (arg == "--rate") c.rate = std::max(0.0, std::stod(v));
+        else if (arg == "--checkpoint-every") c.checkpoint_every = parse_duration(v);
+        else if (arg == "--vacuum-every") c.vacuum_every = parse_duration(v);
+        else if (arg == "--event-window") c.event_window = std::chrono::milliseconds(std::stoll(v));
+        else if (arg == "--wal-autocheckpoint") c.wal_autocheckpoint = std::max<int64_t>(0, std::stoll(v));
+        else if (arg == "--regression-factor") c.regression_factor = std::stod(v);
+        else if (arg == "--min-event-samples") c.min_event_samples = std::stoull(v);
+        else if (arg == "--path") c.path = v;
+        else throw std::invalid_argument("unknown option: " + arg);
+    }
+    return c;
+}
+
+// ==================== Workload ====================
+
+enum Command { Get, HGet, Set, HSet, Del, kCommands };
+constexpr const char* kCommandNames[kCommands] = {"get", "hget", "set", "hset", "del"};
+
+/**
+ * Key picker: a shared CDF for Zipf (binary search per draw), or uniform
+ */
+class KeyChooser {
+public:
+    explicit KeyChooser(const Config& c) : keys_(c.keys) {
+        if (!c.zipf) return;
+        cdf_.resize(c.keys);
+        double sum = 0;
+        for (size_t i = 0; i < c.keys; ++i) cdf_[i] = sum += 1.0 / std::pow(static_cast<double>(i + 1), c.zipf_s);
+        for (auto& p : cdf_) p /= sum;
+    }
+
+    size_t next(std::mt19937_64& rng) const {
+        if (cdf_.empty()) return std::uniform_int_distribution<size_t>(0, keys_ - 1)(rng);
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        size_t i = static_cast<size_t>(std::lower_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin());
+        return std::min(i, keys_ - 1);
+    }
+
+private:
+    size_t keys_;
+    std::vector<double> cdf_;
+};
+
+/**
+ * One backend: a shared Database or a Pool, behind read()/write()
+ */
+class Target {
+public:
+    Target(Backend backend, const Config& c) : backend_(backend), path_(c.path) {
+        if (backend == Backend::Memory) {
+            db_ = std::make_unique<Database>(Database::open_memory());
+            return;
+        }
+        remove_files();
+        auto options = OpenOptionsBuilder().wal_autocheckpoint(c.wal_autocheckpoint).build();
+        if (backend == Backend::Pool) pool_ = std::make_unique<Pool>(path_, c.readers ? c.readers : c.threads, options);
+        else db_ = std::make_unique<Database>(Database::open(path_, options));
+    }
+
+    ~Target() {
+        bool file = backend_ != Backend::Memory;
+        pool_.reset();
+        db_.reset();
+        if (file) remove_files();
+    }
+
+    template <typename F>
+    auto read(F&& f) {
+        return pool_ ? pool_->read(std::forward<F>(f)) : f(*db_);
+    }
+
+    template <typename F>
+    auto write(F&& f) {
+        return pool_ ? pool_->write(std::forward<F>(f)) : f(*db_);
+    }
+
+private:
+    void remove_files() {
+        for (const char* suffix : {"", "-wal", "-shm"}) std::filesystem::remove(path_ + suffix);
+    }
+
+    Backend backend_;
+    std::string path_;
+    std::unique_ptr<Database> db_;
+    std::unique_ptr<Pool> pool_;
+};
+
+std::string string_key(size_t n) { return "soak:" + std::to_string(n); }
+std::string hash_key(size_t n) { return "soak:h:" + std::to_string(n / 16); }
+std::string hash_field(size_t n) { return "f" + std::to_string(n % 16); }
+
+// ==================== Recording ====================
+
+enum Phase { Steady, NearCheckpoint, NearVacuum, kPhases };
+constexpr const char* kPhaseNames[kPhases] = {"steady", "checkpoint", "vacuum"};
+
+struct CommandHistograms {
+    Histogram total;
+    Histogram window;                 // Reset at every progress line
+    Histogram phase[kPhases];
+    std::atomic<uint64_t> errors{0};
+};
+
+/**
+ * Most recent checkpoint or vacuum, readable from worker threads
+ */
+struct EventClock {
+    static constexpr int64_t kNever = INT64_MAX;
+    static constexpr int64_t kRunning = -1;
+
+    void begin(int64_t now_ns) {
+        end_ns.store(kRunning, std::memory_order_release);
+        start_ns.store(now_ns, std::memory_order_release);
+    }
+
+    void finish(int64_t now_ns) { end_ns.store(now_ns, std::memory_order_release); }
+
+    // Whether [from, to] overlaps the event or the window after it
+    bool overlaps(int64_t from, int64_t to, int64_t window_ns) const {
+        int64_t start = start_ns.load(std::memory_order_acquire);
+        if (start == kNever || start > to) return false;
+        int64_t end = end_ns.load(std::memory_order_acquire);
+        return end == kRunning || end + window_ns >= from;
+    }
+
+    std::atomic<int64_t> start_ns{kNever};
+    std::atomic<int64_t> end_ns{kNever};
+};
+
+struct EventStats {
+    uint64_t count = 0;
+    uint64_t errors = 0;
+    uint64_t max_us = 0;
+    double total_us = 0;
+};
+
+struct Run {
+    Run(const Config& c, Target& t, const KeyChooser& k) : config(c), target(t), keys(k) {}
+
+    const Config& config;
+    Target& target;
+    const KeyChooser& keys;
+    Clock::time_point start = Clock::now();
+    std::atomic<bool> stop{false};
+    CommandHistograms commands[kCommands];
+    EventClock checkpoint;
+    EventClock vacuum;
+    std::atomic<uint64_t> behind_schedule{0};   // Commands issued after their due time
+
+    int64_t now_ns() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+
+    // `backlog` is the phase of the event the worker is still catching up on,
+    // or Steady once it issues a command on time again; returns the sample's phase
+    Phase record(Command cmd, int64_t due_ns, int64_t end_ns, Phase backlog) {
+        auto ns = static_cast<uint64_t>(std::max<int64_t>(0, end_ns - due_ns));
+        auto& h = commands[cmd];
+        h.total.record(ns);
+        h.window.record(ns);
+        int64_t window = std::chrono::duration_cast<std::chrono::nanoseconds>(config.event_window).count();
+        // A vacuum stalls far longer than a checkpoint, so it takes samples near both
+        Phase phase = vacuum.overlaps(due_ns, end_ns, window)       ? NearVacuum
+                      : checkpoint.overlaps(due_ns, end_ns, window) ? NearCheckpoint
+                                                                    : backlog;
+        h.phase[phase].record(ns);
+        return phase;
+    }
+};
+
+Command pick_command(const Config& c, std::mt19937_64& rng) {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    if (u < c.read_ratio) return u < c.read_ratio / 2 ? Get : HGet;
+    u = (u - c.read_ratio) / (1.0 - c.read_ratio);
+    return u < 0.6 ? Set : u < 0.9 ? HSet : Del;
+}
+
+void execute(Run& run, Command cmd, size_t n, const std::string& value, bool with_ttl) {
+    Target& t = run.target;
+    switch (cmd) {
+        case Get: t.read([&](Database& db) { return db.get(string_key(n)); }); break;
+        case HGet: t.read([&](Database& db) { return db.hget(hash_key(n), hash_field(n)); }); break;
+        case Set:
+            t.write([&](Database& db) { return db.set(string_key(n), value, with_ttl ? run.config.ttl_seconds : 0); });
+            break;
+        case HSet: t.write([&](Database& db) { return db.hset(hash_key(n), hash_field(n), value); }); break;
+        case Del: t.write([&](Database& db) { return db.del(string_key(n)); }); break;
+        case kCommands: break;
+    }
+}
+
+void worker(Run& run, size_t index) {
+    const Config& c = run.config;
+    std::mt19937_64 rng(std::random_device{}() ^ (index * 0x9E3779B97F4A7C15ull));
+    const std::string value(c.value_size, static_cast<char>('a' + index % 26));
+    const int64_t interval_ns = c.rate > 0 ? static_cast<int64_t>(1e9 / c.rate) : 0;
+
+    // Spread the threads' schedules over one interval
+    int64_t due = run.now_ns() + (interval_ns ? static_cast<int64_t>(rng() % interval_ns) : 0);
+    // Commands queued behind an event keep its phase until the schedule is caught up
+    Phase backlog = Steady;
+    while (!run.stop.load(std::memory_order_relaxed)) {
+        int64_t now = run.now_ns();
+        bool late = false;
+        if (interval_ns) {
+            if (now < due) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(due - now));
+            } else if (now - due > 1000000) {
+                run.behind_schedule.fetch_add(1, std::memory_order_relaxed);
+                late = true;
+            }
+        } else {
+            due = now;
+        }
+
+        Command cmd = pick_command(c, rng);
+        size_t n = run.keys.next(rng);
+        bool with_ttl = std::uniform_real_distribution<double>(0.0, 1.0)(rng) < c.ttl_fraction;
+        Phase phase;
+        try {
+            execute(run, cmd, n, value, with_ttl);
+            phase = run.record(cmd, due, run.now_ns(), late ? backlog : Steady);
+        } catch (const Error&) {
+            // A failed command still held its slot in the schedule
+            phase = run.record(cmd, due, run.now_ns(), late ? backlog : Steady);
+            run.commands[cmd].errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        backlog = phase;
+        due += interval_ns;
+    }
+}
+
+/**
+ * Runs checkpoint() and vacuum() on their cadence until the run stops
+ */
+void maintenance(Run& run, EventStats& checkpoints, EventStats& vacuums) {
+    const Config& c = run.config;
+    auto next_checkpoint = run.start + c.checkpoint_every;
+    auto next_vacuum = run.start + c.vacuum_every;
+    auto trigger = [&](EventClock& clock, EventStats& stats, auto&& f) {
+        int64_t begin = run.now_ns();
+        clock.begin(begin);
+        try {
+            run.target.write(f);
+        } catch (const Error& e) {
+            ++stats.errors;
+            std::fprintf(stderr, "maintenance failed: %s\n", e.what());
+        }
+        int64_t end = run.now_ns();
+        clock.finish(end);
+        double us = (end - begin) / 1e3;
+        ++stats.count;
+        stats.total_us += us;
+        stats.max_us = std::max(stats.max_us, static_cast<uint64_t>(us));
+    };
+    while (!run.stop.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        auto now = Clock::now();
+        if (c.checkpoint_every.count() && now >= next_checkpoint) {
+            trigger(run.checkpoint, checkpoints, [](Database& db) { db.checkpoint(); });
+            next_checkpoint = now + c.checkpoint_every;
+        }
+        if (c.vacuum_every.count() && now >= next_vacuum) {
+            trigger(run.vacuum, vacuums, [](Database& db) { db.vacuum(); });
+            next_vacuum = now + c.vacuum_every;
+        }
+    }
+}
+
+void populate(Target& target, const Config& c) {
+    const std::string value(c.value_size, 'p');
+    constexpr size_t kBatch = 10000;
+    for (size_t from = 0; from < c.keys; from += kBatch) {
+        target.write([&](Database& db) {
+            auto tx = db.transaction();
+            for (size_t n = from; n < std::min(c.keys, from + kBatch); ++n) {
+                db.set(string_key(n), value);
+                db.hset(hash_key(n), hash_field(n), value);
+            }
+            tx.commit();
+        });
+    }
+}
+
+// ==================== Reporting ====================
+
+double us(uint64_t ns) { return ns / 1e3; }
+
+void print_progress(Run& run) {
+    double elapsed = run.now_ns() / 1e9;
+    for (int cmd = 0; cmd < kCommands; ++cmd) {
+        auto& h = run.commands[cmd];
+        auto s = h.window.snapshot();
+        h.window.reset();
+        if (s.count == 0) continue;
+        std::printf("[%7.0fs] %-4s %9.0f ops/s  p50 %8.1fus  p99 %8.1fus  p99.9 %9.1fus  max %10.1fus\n", elapsed,
+                    kCommandNames[cmd], s.count / std::chrono::duration<double>(run.config.report_every).count(),
+                    us(s.percentile(0.5)), us(s.percentile(0.99)), us(s.percentile(0.999)), us(s.max_ns));
+    }
+    std::fflush(stdout);
+}
+
+/**
+ * Summary table; returns the number of regressions found
+ */
+int print_summary(Run& run, Backend backend, const EventStats& checkpoints, const EventStats& vacuums) {
+    const Config& c = run.config;
+    double seconds = run.now_ns() / 1e9;
+    std::printf("\n== %s: %zu threads, %.0fs ==\n", backend_name(backend), c.threads, seconds);
+    std::printf("%-5s %12s %8s %10s %10s %10s %11s %12s\n", "cmd", "count", "errors", "ops/s", "p50 us", "p99 us",
+                "p99.9 us", "max us");
+    for (int cmd = 0; cmd < kCommands; ++cmd) {
+        auto s = run.commands[cmd].total.snapshot();
+        std::printf("%-5s %12llu %8llu %10.0f %10.1f %10.1f %11.1f %12.1f\n", kCommandNames[cmd],
+                    (unsigned long long)s.count, (unsigned long long)run.commands[cmd].errors.load(),
+                    s.count / seconds, us(s.percentile(0.5)), us(s.percentile(0.99)), us(s.percentile(0.999)),
+                    us(s.max_ns));
+    }
+
+    auto event_line = [](const char* name, const EventStats& e) {
+        if (e.count == 0) return;
+        std::printf("%-10s %llu runs, mean %.1f ms, max %.1f ms, %llu failed\n", name, (unsigned long long)e.count,
+                    e.total_us / e.count / 1e3, e.max_us / 1e3, (unsigned long long)e.errors);
+    };
+    event_line("checkpoint", checkpoints);
+    event_line("vacuum", vacuums);
+    if (c.rate > 0) {
+        std::printf("%llu commands issued more than 1 ms late\n", (unsigned long long)run.behind_schedule.load());
+    } else {
+        std::printf("closed loop (--rate 0): latencies are service times, not corrected for coordinated omission\n");
+    }
+
+    int regressions = 0;
+    for (int cmd = 0; cmd < kCommands; ++cmd) {
+        auto steady = run.commands[cmd].phase[Steady].snapshot();
+        for (int phase = NearCheckpoint; phase < kPhases; ++phase) {
+            auto near = run.commands[cmd].phase[phase].snapshot();
+            if (near.count == 0 || steady.count == 0) continue;
+            double ratio = static_cast<double>(near.percentile(0.99)) / std::max<uint64_t>(1, steady.percentile(0.99));
+            bool judged = near.count >= c.min_event_samples;
+            bool regressed = judged && ratio > c.regression_factor;
+            regressions += regressed;
+            std::printf("%-5s near %-10s n=%-9llu p99 %9.1fus vs steady %8.1fus (x%.1f)%s\n", kCommandNames[cmd],
+                        kPhaseNames[phase], (unsigned long long)near.count, us(near.percentile(0.99)),
+                        us(steady.percentile(0.99)), ratio,
+                        regressed ? "  REGRESSION" : judged ? "" : "  (too few samples)");
+        }
+    }
+    std::fflush(stdout);
+    return regressions;
+}
+
+int soak(Backend backend, const Config& c, const KeyChooser& keys) {
+    Target target(backend, c);
+    std::printf("%s: loading %zu keys...\n", backend_name(backend), c.keys);
+    std::fflush(stdout);
+    populate(target, c);
+
+    Run run(c, target, keys);
+    EventStats checkpoints, vacuums;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < c.threads; ++i) threads.emplace_back(worker, std::ref(run), i);
+    std::thread maintainer(maintenance, std::ref(run), std::ref(checkpoints), std::ref(vacuums));
+
+    auto deadline = run.start + c.duration;
+    auto next_report = run.start + c.report_every;
+    while (Clock::now() < deadline) {
+        std::this_thread::sleep_until(std::min(deadline, next_report));
+        if (Clock::now() >= next_report) {
+            print_progress(run);
+            next_report += c.report_every;
+        }
+    }
+    run.stop = true;
+    for (auto& t : threads) t.join();
+    maintainer.join();
+    return print_summary(run, backend, checkpoints, vacuums);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config config;
+    try {
+        config = parse_args(argc, argv);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n\n", e.what());
+        usage();
+        return 2;
+    }
+
+    std::printf("redlite_soak: %zu threads, %.0f%% reads, %s keys (%zu), %zu-byte values, ", config.threads,
+                config.read_ratio * 100, config.zipf ? "zipf" : "uniform", config.keys, config.value_size);
+    if (config.rate > 0) std::printf("%.0f ops/s per thread\n", config.rate);
+    else std::printf("closed loop\n");
+
+    KeyChooser keys(config);
+    int regressions = 0;
+    try {
+        for (Backend backend : config.backends) regressions += soak(backend, config, keys);
+    } catch (const Error& e) {
+        std::fprintf(stderr, "soak failed: %s\n", e.what());
+        return 2;
+    }
+    if (regressions) std::printf("\n%d latency regression(s) near checkpoints or vacuums\n", regressions);
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,526 @@
+/**
+ * Redlite C++ SDK - asynchronous API
+ *
+ * AsyncDatabase runs every command on a dedicated worker thread that owns the
+ * Database, so event-loop threads never block on SQLite or fsync. Commands
+ * are handed over through a lock-free MPSC queue and complete through a
+ * std::future, a pair of callbacks, or (C++20) co_await.
+ */
+
+#ifndef REDLITE_ASYNC_HPP
+#define REDLITE_ASYNC_HPP
+
+#include "redlite.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#if !defined(REDLITE_NO_COROUTINES) && defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define REDLITE_HAS_COROUTINES 1
+#endif
+
+namespace redlite {
+
+namespace detail {
+
+/**
+ * Intrusive multi-producer single-consumer queue (Vyukov)
+ *
+ * push() is wait-free for producers; pop() is only called by the worker.
+ */
+class MpscQueue {
+public:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+    };
+
+    MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+    void push(Node* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Returns nullptr when empty (or while a producer is mid-push)
+    Node* pop() {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &stub_) {
+            if (!next) return nullptr;
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        if (tail != head_.load(std::memory_order_acquire)) return nullptr;
+        push(&stub_);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+private:
+    Node stub_;
+    std::atomic<Node*> head_;   // Producers push here
+    Node* tail_;                // Consumer pops here
+};
+
+/**
+ * Queued command: run() executes it on the worker and stores the outcome,
+ * complete() delivers it. They are separate so coalesced writes are only
+ * delivered once their shared transaction has committed.
+ */
+struct AsyncTask : MpscQueue::Node {
+    explicit AsyncTask(bool write) : write(write) {}
+    virtual ~AsyncTask() = default;
+
+    virtual void run(Database& db) noexcept = 0;
+    virtual void complete() noexcept = 0;
+    virtual void fail(std::exception_ptr error) noexcept = 0;
+
+    const bool write;
+};
+
+template <typename R>
+struct PromiseSink {
+    std::promise<R> promise;
+
+    void ok(R&& value) { promise.set_value(std::move(value)); }
+    void err(std::exception_ptr error) { promise.set_exception(error); }
+};
+
+template <>
+struct PromiseSink<void> {
+    std::promise<void> promise;
+
+    void ok() { promise.set_value(); }
+    void err(std::exception_ptr error) { promise.set_exception(error); }
+};
+
+template <typename OnOk, typename OnErr>
+struct CallbackSink {
+    OnOk on_ok;
+    OnErr on_err;
+
+    template <typename... V>
+    void ok(V&&... value) { on_ok(std::forward<V>(value)...); }
+    void err(std::exception_ptr error) { on_err(error); }
+};
+
+template <typename R, typename F, typename Sink>
+class FnTask final : public AsyncTask {
+public:
+    FnTask(bool write, F fn, Sink sink) : AsyncTask(write), fn_(std::move(fn)), sink_(std::move(sink)) {}
+
+    void run(Database& db) noexcept override {
+        try {
+            if constexpr (std::is_void_v<R>) {
+                fn_(db);
+            } else {
+                value_.emplace(fn_(db));
+            }
+        } catch (...) {
+            error_ = std::current_exception();
+        }
+    }
+
+    void complete() noexcept override {
+        if (error_) {
+            sink_.err(error_);
+        } else if constexpr (std::is_void_v<R>) {
+            sink_.ok();
+        } else {
+            sink_.ok(std::move(*value_));
+        }
+    }
+
+    void fail(std::exception_ptr error) noexcept override { sink_.err(error); }
+
+    Sink& sink() { return sink_; }
+
+private:
+    F fn_;
+    Sink sink_;
+    std::optional<std::conditional_t<std::is_void_v<R>, bool, R>> value_;
+    std::exception_ptr error_;
+};
+
+} // namespace detail
+
+class AsyncDatabase;
+
+/**
+ * std::future returned by AsyncDatabase; awaitable with co_await in C++20
+ *
+ * A coroutine awaiting it resumes on the AsyncDatabase worker thread, so it
+ * must not block on another Future from there.
+ */
+template <typename T>
+class Future : public std::future<T> {
+public:
+    Future() = default;
+    Future(std::future<T>&& f, AsyncDatabase* owner) : std::future<T>(std::move(f)), owner_(owner) {}
+
+    bool ready() const {
+        return this->wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+#ifdef REDLITE_HAS_COROUTINES
+    struct Awaiter {
+        Future& future;
+        bool await_ready() const { return future.ready(); }
+        void await_suspend(std::coroutine_handle<> h) { future.resume_on_worker(h); }
+        T await_resume() { return future.get(); }
+    };
+
+    Awaiter operator co_await() & { return Awaiter{*this}; }
+    Awaiter operator co_await() && { return Awaiter{*this}; }
+#endif
+
+private:
+#ifdef REDLITE_HAS_COROUTINES
+    void resume_on_worker(std::coroutine_handle<> h);
+#endif
+
+    AsyncDatabase* owner_ = nullptr;
+};
+
+/**
+ * Database driven by a dedicated worker thread
+ *
+ *   AsyncDatabase db("app.db");
+ *   auto f = db.set("k", "v");               // Future<bool>
+ *   db.get("k").get();                        // block only when you choose to
+ *
+ *   db.submit([](Database& d) { return d.hlen("h"); },
+ *             [](int64_t n) { ... },          // runs on the worker thread
+ *             [](std::exception_ptr e) { ... });
+ *
+ *   auto v = co_await db.get("k");           // C++20 coroutines
+ *
+ * Consecutive queued writes are coalesced into a single transaction (up to
+ * max_batch), and their futures complete after that transaction commits.
+ * Write callables therefore must not open their own Transaction.
+ */
+class AsyncDatabase {
+public:
+    static constexpr size_t kDefaultMaxBatch = 256;
+
+    explicit AsyncDatabase(const std::string& path, size_t max_batch = kDefaultMaxBatch)
+        : AsyncDatabase(Database(path), max_batch) {}
+
+    explicit AsyncDatabase(Database db, size_t max_batch = kDefaultMaxBatch)
+        : db_(std::move(db)), max_batch_(max_batch ? max_batch : 1) {
+        worker_ = std::thread([this] { run(); });
+    }
+
+    /**
+     * Run all queued commands, then stop the worker
+     */
+    ~AsyncDatabase() {
+        stopping_.store(true, std::memory_order_seq_cst);
+        wake();
+        worker_.join();
+    }
+
+    AsyncDatabase(const AsyncDatabase&) = delete;
+    AsyncDatabase& operator=(const AsyncDatabase&) = delete;
+
+    // ==================== Generic submission ====================
+
+    /**
+     * Run a read-only f(Database&) on the worker
+     */
+    template <typename F>
+    auto submit(F&& f) -> Future<std::invoke_result_t<F&, Database&>> {
+        return enqueue_future(false, std::forward<F>(f));
+    }
+
+    /**
+     * Run a mutating f(Database&) on the worker; may share a transaction
+     * with neighbouring writes
+     */
+    template <typename F>
+    auto submit_write(F&& f) -> Future<std::invoke_result_t<F&, Database&>> {
+        return enqueue_future(true, std::forward<F>(f));
+    }
+
+    /**
+     * Run f on the worker and call on_ok(result) or on_err(std::exception_ptr)
+     * there. Callbacks must not throw or block on this AsyncDatabase.
+     */
+    template <typename F, typename OnOk, typename OnErr>
+    void submit(F&& f, OnOk&& on_ok, OnErr&& on_err) {
+        enqueue_callback(false, std::forward<F>(f), std::forward<OnOk>(on_ok), std::forward<OnErr>(on_err));
+    }
+
+    template <typename F, typename OnOk, typename OnErr>
+    void submit_write(F&& f, OnOk&& on_ok, OnErr&& on_err) {
+        enqueue_callback(true, std::forward<F>(f), std::forward<OnOk>(on_ok), std::forward<OnErr>(on_err));
+    }
+
+    // ==================== String Commands ====================
+
+    Future<std::optional<std::string>> get(std::string_view key) {
+        return submit([k = std::string(key)](Database& db) { return db.get(k); });
+    }
+
+    Future<std::vector<std::optional<std::string>>> mget(std::vector<std::string> keys) {
+        return submit([keys = std::move(keys)](Database& db) { return db.mget(keys); });
+    }
+
+    Future<bool> set(std::string_view key, std::string_view value, int64_t ttl_seconds = 0) {
+        return submit_write([k = std::string(key), v = std::string(value), ttl_seconds](Database& db) {
+            return db.set(k, v, ttl_seconds);
+        });
+    }
+
+    Future<int64_t> incr(std::string_view key) {
+        return submit_write([k = std::string(key)](Database& db) { return db.incr(k); });
+    }
+
+    Future<int64_t> incrby(std::string_view key, int64_t increment) {
+        return submit_write([k = std::string(key), increment](Database& db) { return db.incrby(k, increment); });
+    }
+
+    // ==================== Key Commands ====================
+
+    Future<int64_t> del(std::string_view key) {
+        return submit_write([k = std::string(key)](Database& db) { return db.del(k); });
+    }
+
+    Future<bool> exists(std::string_view key) {
+        return submit([k = std::string(key)](Database& db) { return db.exists(k); });
+    }
+
+    Future<bool> expire(std::string_view key, int64_t seconds) {
+        return submit_write([k = std::string(key), seconds](Database& db) { return db.expire(k, seconds); });
+    }
+
+    Future<int64_t> ttl(std::string_view key) {
+        return submit([k = std::string(key)](Database& db) { return db.ttl(k); });
+    }
+
+    // ==================== Hash Commands ====================
+
+    Future<std::optional<std::string>> hget(std::string_view key, std::string_view field) {
+        return submit([k = std::string(key), f = std::string(field)](Database& db) { return db.hget(k, f); });
+    }
+
+    Future<int64_t> hset(std::string_view key, std::string_view field, std::string_view value) {
+        return submit_write([k = std::string(key), f = std::string(field), v = std::string(value)](Database& db) {
+            return db.hset(k, f, v);
+        });
+    }
+
+    Future<int64_t> hset(std::string_view key, std::unordered_map<std::string, std::string> fields) {
+        return submit_write([k = std::string(key), fields = std::move(fields)](Database& db) {
+            return db.hset(k, fields);
+        });
+    }
+
+    Future<std::unordered_map<std::string, std::string>> hgetall(std::string_view key) {
+        return submit([k = std::string(key)](Database& db) { return db.hgetall(k); });
+    }
+
+    Future<int64_t> hdel(std::string_view key, std::vector<std::string> fields) {
+        return submit_write([k = std::string(key), fields = std::move(fields)](Database& db) {
+            return db.hdel(k, fields);
+        });
+    }
+
+    // ==================== List Commands ====================
+
+    Future<int64_t> lpush(std::string_view key, std::vector<std::string> values) {
+        return submit_write([k = std::string(key), values = std::move(values)](Database& db) {
+            return db.lpush(k, values);
+        });
+    }
+
+    Future<int64_t> rpush(std::string_view key, std::vector<std::string> values) {
+        return submit_write([k = std::string(key), values = std::move(values)](Database& db) {
+            return db.rpush(k, values);
+        });
+    }
+
+    Future<std::vector<std::string>> lrange(std::string_view key, int64_t start, int64_t stop) {
+        return submit([k = std::string(key), start, stop](Database& db) { return db.lrange(k, start, stop); });
+    }
+
+    // ==================== Set Commands ====================
+
+    Future<int64_t> sadd(std::string_view key, std::vector<std::string> members) {
+        return submit_write([k = std::string(key), members = std::move(members)](Database& db) {
+            return db.sadd(k, members);
+        });
+    }
+
+    Future<std::vector<std::string>> smembers(std::string_view key) {
+        return submit([k = std::string(key)](Database& db) { return db.smembers(k); });
+    }
+
+    // ==================== Sorted Set Commands ====================
+
+    Future<int64_t> zadd(std::string_view key, double score, std::string_view member) {
+        return submit_write([k = std::string(key), score, m = std::string(member)](Database& db) {
+            return db.zadd(k, score, m);
+        });
+    }
+
+    Future<std::vector<std::string>> zrange(std::string_view key, int64_t start, int64_t stop) {
+        return submit([k = std::string(key), start, stop](Database& db) { return db.zrange(k, start, stop); });
+    }
+
+private:
+    template <typename T>
+    friend class Future;
+
+    // Resumes a coroutine on the worker once everything queued before it ran
+    struct ResumeTask final : detail::AsyncTask {
+        explicit ResumeTask(std::function<void()> resume) : AsyncTask(false), resume(std::move(resume)) {}
+        void run(Database&) noexcept override {}
+        void complete() noexcept override { resume(); }
+        void fail(std::exception_ptr) noexcept override { resume(); }
+        std::function<void()> resume;
+    };
+
+    template <typename F>
+    auto enqueue_future(bool write, F&& f) -> Future<std::invoke_result_t<F&, Database&>> {
+        using R = std::invoke_result_t<F&, Database&>;
+        using Task = detail::FnTask<R, std::decay_t<F>, detail::PromiseSink<R>>;
+        auto* task = new Task(write, std::forward<F>(f), detail::PromiseSink<R>{});
+        Future<R> future(task->sink().promise.get_future(), this);
+        push(task);
+        return future;
+    }
+
+    template <typename F, typename OnOk, typename OnErr>
+    void enqueue_callback(bool write, F&& f, OnOk&& on_ok, OnErr&& on_err) {
+        using R = std::invoke_result_t<F&, Database&>;
+        using Sink = detail::CallbackSink<std::decay_t<OnOk>, std::decay_t<OnErr>>;
+        push(new detail::FnTask<R, std::decay_t<F>, Sink>(
+            write, std::forward<F>(f), Sink{std::forward<OnOk>(on_ok), std::forward<OnErr>(on_err)}));
+    }
+
+    void push(detail::AsyncTask* task) {
+        queue_.push(task);
+        if (sleeping_.exchange(false, std::memory_order_seq_cst)) wake();
+    }
+
+    void wake() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sleeping_.store(false, std::memory_order_seq_cst);
+        cv_.notify_one();
+    }
+
+    detail::AsyncTask* try_pop() { return static_cast<detail::AsyncTask*>(queue_.pop()); }
+
+    // Block until a task is available; nullptr once stopping and drained
+    detail::AsyncTask* wait_pop() {
+        for (;;) {
+            if (auto* task = try_pop()) return task;
+            if (stopping_.load(std::memory_order_seq_cst)) return try_pop();
+
+            sleeping_.store(true, std::memory_order_seq_cst);
+            if (auto* task = try_pop()) {
+                sleeping_.store(false, std::memory_order_relaxed);
+                return task;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] {
+                return !sleeping_.load(std::memory_order_seq_cst) || stopping_.load(std::memory_order_seq_cst);
+            });
+        }
+    }
+
+    static void execute(detail::AsyncTask* task, Database& db) {
+        task->run(db);
+        task->complete();
+        delete task;
+    }
+
+    void run() {
+        std::vector<detail::AsyncTask*> batch;
+        detail::AsyncTask* carry = nullptr;
+
+        for (;;) {
+            detail::AsyncTask* task = carry ? carry : wait_pop();
+            carry = nullptr;
+            if (!task) return;
+
+            if (!task->write) {
+                execute(task, db_);
+                continue;
+            }
+
+            batch.clear();
+            batch.push_back(task);
+            while (batch.size() < max_batch_) {
+                detail::AsyncTask* next = try_pop();
+                if (!next) break;
+                if (!next->write) {
+                    carry = next;
+                    break;
+                }
+                batch.push_back(next);
+            }
+
+            if (batch.size() == 1 || db_.in_transaction()) {
+                for (auto* t : batch) execute(t, db_);
+                continue;
+            }
+            run_batch(batch);
+        }
+    }
+
+    // One transaction for the whole batch; outcomes are delivered after commit
+    void run_batch(const std::vector<detail::AsyncTask*>& batch) {
+        std::exception_ptr error;
+        try {
+            auto tx = db_.transaction();
+            for (auto* t : batch) t->run(db_);
+            tx.commit();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        for (auto* t : batch) {
+            if (error) t->fail(error);
+            else t->complete();
+            delete t;
+        }
+    }
+
+    Database db_;
+    size_t max_batch_;
+    detail::MpscQueue queue_;
+    std::atomic<bool> sleeping_{false};
+    std::atomic<bool> stopping_{false};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread worker_;
+};
+
+#ifdef REDLITE_HAS_COROUTINES
+template <typename T>
+void Future<T>::resume_on_worker(std::coroutine_handle<> h) {
+    owner_->push(new AsyncDatabase::ResumeTask([h] { h.resume(); }));
+}
+#endif
+
+} // namespace redlite
+
+#endif // REDLITE_ASYNC_HPP
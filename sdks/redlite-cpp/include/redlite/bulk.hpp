@@ -0,0 +1,254 @@
+/**
+ * Redlite C++ SDK - bulk loader
+ *
+ * BulkLoader buffers typed records and writes them in large batches through
+ * redlite_bulk_load: one savepoint and one set of prepared statements per
+ * batch instead of one transaction per command. Secondary indexes and
+ * full-text indexing can be deferred until the load is finished.
+ */
+
+#ifndef REDLITE_BULK_HPP
+#define REDLITE_BULK_HPP
+
+#include "redlite.hpp"
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace redlite {
+
+/**
+ * Record kinds accepted by redlite_bulk_load (REDLITE_BULK_*)
+ */
+enum class BulkKind : int { String = 0, Hash = 1, Set = 2, ZSet = 3 };
+
+/**
+ * Running totals for a bulk load
+ */
+struct BulkProgress {
+    uint64_t records = 0;     // Records written so far
+    uint64_t bytes = 0;       // Key, field and value bytes written so far
+    uint64_t batches = 0;     // Batches sent
+    std::chrono::duration<double> elapsed{0};
+
+    double records_per_second() const {
+        return elapsed.count() > 0 ? records / elapsed.count() : 0.0;
+    }
+};
+
+/**
+ * BulkLoader configuration
+ */
+struct BulkLoadOptions {
+    size_t batch_records = 50000;                // Flush at this many buffered records
+    size_t batch_bytes = 64 * 1024 * 1024;       // ... or this many buffered bytes
+    // Drop key-metadata and score indexes and skip full-text indexing while
+    // loading; both are rebuilt by finish(). Faster for large loads, but
+    // queries that rely on those indexes are slow until then.
+    bool defer_indexes = true;
+    std::function<void(const BulkProgress&)> on_progress;  // Called after each batch
+};
+
+/**
+ * Batched writer for strings, hashes, sets and sorted sets
+ *
+ *   BulkLoader loader(db);
+ *   for (const auto& row : rows) {
+ *       loader.hset("user:" + row.id, "name", row.name);
+ *       loader.zadd("users:by_age", row.age, row.id);
+ *   }
+ *   auto progress = loader.finish();
+ *
+ * Records keep the semantics of the matching command (SET replaces, HSET
+ * and ZADD upsert, SADD ignores duplicates), but no history is recorded.
+ * A batch is atomic: if a record fails (e.g. WRONGTYPE) the whole batch is
+ * rolled back, dropped from the buffer and the error is thrown; batches
+ * already written stay. The Database must outlive the loader, and the same
+ * database should not be written concurrently while indexes are deferred.
+ * finish() runs on destruction if it was not called. Not thread-safe.
+ */
+class BulkLoader {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit BulkLoader(Database& db, BulkLoadOptions options = {})
+        : db_(db), options_(std::move(options)), start_(Clock::now()) {
+        db_.bulk_begin(options_.defer_indexes);
+        pending_.reserve(options_.batch_records);
+    }
+
+    ~BulkLoader() {
+        try {
+            finish();
+        } catch (...) {
+            // Call finish() explicitly to see errors
+        }
+    }
+
+    BulkLoader(const BulkLoader&) = delete;
+    BulkLoader& operator=(const BulkLoader&) = delete;
+
+    // ==================== Records ====================
+
+    /**
+     * SET key value [EX ttl_seconds]
+     */
+    void set(std::string_view key, std::string_view value, int64_t ttl_seconds = 0) {
+        add(BulkKind::String, key, {}, value, 0.0, ttl_seconds > 0 ? ttl_seconds * 1000 : 0);
+    }
+
+    /**
+     * HSET key field value
+     */
+    void hset(std::string_view key, std::string_view field, std::string_view value) {
+        add(BulkKind::Hash, key, field, value, 0.0, 0);
+    }
+
+    /**
+     * HSET key field value [field value ...]
+     */
+    void hset(std::string_view key, const std::unordered_map<std::string, std::string>& fields) {
+        for (const auto& [field, value] : fields) hset(key, field, value);
+    }
+
+    /**
+     * SADD key member
+     */
+    void sadd(std::string_view key, std::string_view member) {
+        add(BulkKind::Set, key, {}, member, 0.0, 0);
+    }
+
+    /**
+     * SADD key member [member ...]
+     */
+    void sadd(std::string_view key, const std::vector<std::string>& members) {
+        for (const auto& member : members) sadd(key, member);
+    }
+
+    /**
+     * ZADD key score member
+     */
+    void zadd(std::string_view key, double score, std::string_view member) {
+        add(BulkKind::ZSet, key, {}, member, score, 0);
+    }
+
+    /**
+     * ZADD key score member [score member ...]
+     */
+    void zadd(std::string_view key, const std::vector<ZMember>& members) {
+        for (const auto& m : members) zadd(key, m.score, m.member);
+    }
+
+    // ==================== Control ====================
+
+    /**
+     * Write all buffered records as one batch
+     * @return Number of records written
+     */
+    size_t flush() {
+        if (pending_.empty()) return 0;
+        std::vector<RedliteBulkRecord> records;
+        records.reserve(pending_.size());
+        const char* base = arena_.data();
+        for (const auto& p : pending_) {
+            records.push_back(RedliteBulkRecord{
+                static_cast<int>(p.kind),
+                base + p.key, p.key_len,
+                base + p.field, p.field_len,
+                reinterpret_cast<const uint8_t*>(base + p.value), p.value_len,
+                p.score, p.ttl_ms});
+        }
+
+        uint64_t bytes = arena_.size();
+        int64_t written;
+        try {
+            written = db_.bulk_load(records.data(), records.size(), options_.defer_indexes);
+        } catch (...) {
+            clear();
+            throw;
+        }
+        clear();
+
+        progress_.records += static_cast<uint64_t>(written);
+        progress_.bytes += bytes;
+        ++progress_.batches;
+        progress_.elapsed = Clock::now() - start_;
+        if (options_.on_progress) options_.on_progress(progress_);
+        return static_cast<size_t>(written);
+    }
+
+    /**
+     * Flush, then rebuild deferred indexes (and full-text indexes). Later
+     * calls are no-ops.
+     */
+    BulkProgress finish() {
+        if (finished_) return progress_;
+        flush();
+        db_.bulk_finish(options_.defer_indexes);
+        finished_ = true;
+        progress_.elapsed = Clock::now() - start_;
+        return progress_;
+    }
+
+    const BulkProgress& progress() const { return progress_; }
+    size_t buffered() const { return pending_.size(); }
+
+private:
+    // Offsets into arena_, resolved to pointers at flush time
+    struct Pending {
+        BulkKind kind;
+        size_t key, key_len;
+        size_t field, field_len;
+        size_t value, value_len;
+        double score;
+        int64_t ttl_ms;
+    };
+
+    void add(BulkKind kind, std::string_view key, std::string_view field,
+             std::string_view value, double score, int64_t ttl_ms) {
+        if (finished_) throw Error("BulkLoader already finished");
+        // Consecutive records for the same key (a hash or set being loaded)
+        // share one copy of it
+        size_t key_off;
+        if (!pending_.empty() && std::string_view(arena_).substr(last_key_, pending_.back().key_len) == key) {
+            key_off = last_key_;
+        } else {
+            key_off = append(key);
+            last_key_ = key_off;
+        }
+        size_t field_off = append(field);
+        size_t value_off = append(value);
+        pending_.push_back(Pending{kind, key_off, key.size(), field_off, field.size(),
+                                   value_off, value.size(), score, ttl_ms});
+        if (pending_.size() >= options_.batch_records || arena_.size() >= options_.batch_bytes) {
+            flush();
+        }
+    }
+
+    size_t append(std::string_view s) {
+        size_t off = arena_.size();
+        arena_.append(s.data(), s.size());
+        return off;
+    }
+
+    void clear() {
+        pending_.clear();
+        arena_.clear();
+        last_key_ = 0;
+    }
+
+    Database& db_;
+    BulkLoadOptions options_;
+    Clock::time_point start_;
+    std::string arena_;
+    std::vector<Pending> pending_;
+    size_t last_key_ = 0;
+    BulkProgress progress_;
+    bool finished_ = false;
+};
+
+} // namespace redlite
+
+#endif // REDLITE_BULK_HPP
@@ -0,0 +1,363 @@
+/**
+ * Redlite C++ SDK - client-side read-through cache
+ *
+ * CachedDatabase keeps hot string and hash values in process memory and
+ * validates them against the key's version stamp (`keys.version`, bumped on
+ * every write), so a hit costs one indexed metadata lookup instead of
+ * decoding and copying the value.
+ */
+
+#ifndef REDLITE_CACHE_HPP
+#define REDLITE_CACHE_HPP
+
+#include "redlite.hpp"
+
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <type_traits>
+
+namespace redlite {
+
+/**
+ * Cache configuration
+ */
+struct CacheOptions {
+    size_t max_bytes = 64 * 1024 * 1024;  // Approximate memory budget
+    // Trust an entry for this long after it was last validated without
+    // re-checking its version. 0 = validate on every hit (always coherent).
+    std::chrono::milliseconds revalidate_after{0};
+};
+
+/**
+ * Runtime cache counters
+ */
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;       // Entries dropped to stay within max_bytes
+    uint64_t invalidations = 0;   // Entries dropped because the key changed
+    size_t entries = 0;
+    size_t bytes = 0;             // Approximate memory footprint
+
+    double hit_rate() const {
+        uint64_t total = hits + misses;
+        return total ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+/**
+ * Database wrapper with an LRU cache for GET, HGET and HGETALL
+ *
+ *   CachedDatabase db("app.db", CacheOptions{16 << 20});
+ *   db.get("config:flags");              // miss: reads and caches
+ *   db.get("config:flags");              // hit: only checks the key version
+ *   db.set("config:flags", "...");       // writes through and invalidates
+ *
+ * Writes made through this object invalidate immediately. Writes from other
+ * handles or processes are detected by the version check; with a non-zero
+ * revalidate_after they can be served stale for up to that long. Expiry is
+ * detected the same way. The stamp is (version, created_at in ms), so a key
+ * deleted and recreated elsewhere within the same millisecond and with the
+ * same number of writes is not told apart. Thread-safe.
+ */
+class CachedDatabase {
+public:
+    explicit CachedDatabase(Database db, CacheOptions options = {})
+        : db_(std::move(db)), options_(options) {}
+
+    explicit CachedDatabase(const std::string& path, CacheOptions options = {})
+        : CachedDatabase(Database(path), options) {}
+
+    CachedDatabase(const CachedDatabase&) = delete;
+    CachedDatabase& operator=(const CachedDatabase&) = delete;
+
+    // ==================== Cached Reads ====================
+
+    std::optional<std::string> get(std::string_view key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry* entry = lookup(key, Kind::String);
+        if (entry && trusted(*entry)) return hit(*entry).value;
+
+        auto version = db_.key_version(key);
+        if (entry && version && *version == entry->version) {
+            entry->validated = Clock::now();
+            return hit(*entry).value;
+        }
+
+        ++stats_.misses;
+        if (!version) {
+            drop(key, true);
+            return std::nullopt;
+        }
+        auto value = db_.get(key);
+        if (!value) {
+            drop(key, true);
+            return std::nullopt;
+        }
+        Entry& fresh = store(key, Kind::String, *version);
+        fresh.value = *value;
+        charge(fresh, value->size());
+        shrink();
+        return value;
+    }
+
+    std::optional<std::string> hget(std::string_view key, std::string_view field) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry* entry = lookup(key, Kind::Hash);
+        std::optional<KeyVersion> version;
+        bool valid = entry && trusted(*entry);
+        if (entry && !valid) {
+            version = db_.key_version(key);
+            valid = version && *version == entry->version;
+            if (valid) entry->validated = Clock::now();
+        }
+
+        if (valid) {
+            auto it = entry->fields.find(std::string(field));
+            if (it != entry->fields.end()) {
+                hit(*entry);
+                return it->second;
+            }
+            if (entry->complete) {
+                hit(*entry);
+                return std::nullopt;
+            }
+        } else {
+            if (!entry) version = db_.key_version(key);
+            if (!version) {
+                ++stats_.misses;
+                drop(key, true);
+                return std::nullopt;
+            }
+            entry = &store(key, Kind::Hash, *version);
+        }
+
+        ++stats_.misses;
+        auto value = db_.hget(key, field);
+        if (value) {
+            touch(*entry);
+            entry->fields.emplace(std::string(field), *value);
+            charge(*entry, field.size() + value->size() + kFieldOverhead);
+            shrink();
+        }
+        return value;
+    }
+
+    std::unordered_map<std::string, std::string> hgetall(std::string_view key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry* entry = lookup(key, Kind::Hash);
+        if (entry && entry->complete && trusted(*entry)) return hit(*entry).fields;
+
+        auto version = db_.key_version(key);
+        if (entry && entry->complete && version && *version == entry->version) {
+            entry->validated = Clock::now();
+            return hit(*entry).fields;
+        }
+
+        ++stats_.misses;
+        if (!version) {
+            drop(key, true);
+            return {};
+        }
+        auto fields = db_.hgetall(key);
+        Entry& fresh = store(key, Kind::Hash, *version);
+        size_t bytes = 0;
+        for (const auto& [f, v] : fields) bytes += f.size() + v.size() + kFieldOverhead;
+        fresh.fields = fields;
+        fresh.complete = true;
+        charge(fresh, bytes);
+        shrink();
+        return fields;
+    }
+
+    // ==================== Writes (invalidate) ====================
+
+    bool set(std::string_view key, std::string_view value, int64_t ttl_seconds = 0) {
+        return write(key, [&] { return db_.set(key, value, ttl_seconds); });
+    }
+
+    int64_t append(std::string_view key, std::string_view value) {
+        return write(key, [&] { return db_.append(key, value); });
+    }
+
+    int64_t incr(std::string_view key) {
+        return write(key, [&] { return db_.incr(key); });
+    }
+
+    int64_t incrby(std::string_view key, int64_t increment) {
+        return write(key, [&] { return db_.incrby(key, increment); });
+    }
+
+    int64_t del(std::string_view key) {
+        return write(key, [&] { return db_.del(key); });
+    }
+
+    bool expire(std::string_view key, int64_t seconds) {
+        return write(key, [&] { return db_.expire(key, seconds); });
+    }
+
+    bool persist(std::string_view key) {
+        return write(key, [&] { return db_.persist(key); });
+    }
+
+    int64_t hset(std::string_view key, std::string_view field, std::string_view value) {
+        return write(key, [&] { return db_.hset(key, field, value); });
+    }
+
+    int64_t hset(std::string_view key, const std::unordered_map<std::string, std::string>& fields) {
+        return write(key, [&] { return db_.hset(key, fields); });
+    }
+
+    int64_t hdel(std::string_view key, const std::vector<std::string>& fields) {
+        return write(key, [&] { return db_.hdel(key, fields); });
+    }
+
+    int64_t hincrby(std::string_view key, std::string_view field, int64_t increment) {
+        return write(key, [&] { return db_.hincrby(key, field, increment); });
+    }
+
+    // ==================== Cache Control ====================
+
+    /**
+     * Drop the cached entry for key, if any
+     */
+    void invalidate(std::string_view key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        drop(key, true);
+    }
+
+    /**
+     * Drop every cached entry (counters are kept)
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index_.clear();
+        lru_.clear();
+        bytes_ = 0;
+    }
+
+    CacheStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CacheStats s = stats_;
+        s.entries = lru_.size();
+        s.bytes = bytes_;
+        return s;
+    }
+
+    void reset_stats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_ = CacheStats{};
+    }
+
+    /**
+     * Underlying database for uncached commands. Writes made through it are
+     * only noticed by the version check.
+     */
+    Database& database() { return db_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    enum class Kind { String, Hash };
+
+    // Rough per-allocation overheads used for the memory estimate
+    static constexpr size_t kEntryOverhead = 128;
+    static constexpr size_t kFieldOverhead = 64;
+
+    struct Entry {
+        std::string key;
+        Kind kind;
+        KeyVersion version;
+        Clock::time_point validated;
+        std::string value;                                      // Kind::String
+        std::unordered_map<std::string, std::string> fields;    // Kind::Hash
+        bool complete = false;                                  // fields holds the whole hash
+        size_t bytes = 0;
+    };
+
+    using List = std::list<Entry>;
+
+    template <typename F>
+    std::invoke_result_t<F&> write(std::string_view key, F&& f) {
+        auto result = f();
+        std::lock_guard<std::mutex> lock(mutex_);
+        drop(key, true);
+        return result;
+    }
+
+    // Entry for key if it holds `kind`; entries of another kind are dropped
+    Entry* lookup(std::string_view key, Kind kind) {
+        auto it = index_.find(key);
+        if (it == index_.end()) return nullptr;
+        if (it->second->kind != kind) {
+            drop(key, true);
+            return nullptr;
+        }
+        return &*it->second;
+    }
+
+    bool trusted(const Entry& entry) const {
+        return options_.revalidate_after.count() > 0 &&
+               Clock::now() - entry.validated < options_.revalidate_after;
+    }
+
+    Entry& hit(Entry& entry) {
+        ++stats_.hits;
+        touch(entry);
+        return entry;
+    }
+
+    void touch(Entry& entry) {
+        auto it = index_.find(entry.key);
+        lru_.splice(lru_.begin(), lru_, it->second);
+    }
+
+    // Replace any entry for key with an empty one at the front of the LRU
+    Entry& store(std::string_view key, Kind kind, KeyVersion version) {
+        drop(key, false);
+        lru_.push_front(Entry{std::string(key), kind, version, Clock::now(), {}, {}, false, 0});
+        Entry& entry = lru_.front();
+        index_.emplace(entry.key, lru_.begin());
+        charge(entry, kEntryOverhead + entry.key.size());
+        return entry;
+    }
+
+    void charge(Entry& entry, size_t bytes) {
+        entry.bytes += bytes;
+        bytes_ += bytes;
+    }
+
+    void drop(std::string_view key, bool invalidated) {
+        auto it = index_.find(key);
+        if (it == index_.end()) return;
+        auto node = it->second;
+        bytes_ -= node->bytes;
+        index_.erase(it);
+        lru_.erase(node);
+        if (invalidated) ++stats_.invalidations;
+    }
+
+    // Evict least recently used entries, always keeping the newest one
+    void shrink() {
+        while (bytes_ > options_.max_bytes && lru_.size() > 1) {
+            Entry& victim = lru_.back();
+            bytes_ -= victim.bytes;
+            index_.erase(victim.key);
+            lru_.pop_back();
+            ++stats_.evictions;
+        }
+    }
+
+    Database db_;
+    CacheOptions options_;
+
+    mutable std::mutex mutex_;
+    List lru_;                                                // Front = most recent
+    std::unordered_map<std::string_view, List::iterator> index_;  // Views into Entry::key
+    size_t bytes_ = 0;
+    CacheStats stats_;
+};
+
+} // namespace redlite
+
+#endif // REDLITE_CACHE_HPP
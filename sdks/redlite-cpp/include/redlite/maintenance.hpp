@@ -0,0 +1,206 @@
+/**
+ * Redlite C++ SDK - background maintenance
+ *
+ * MaintenanceScheduler runs Database::maintenance_step on its own thread.
+ * Expired keys are deleted and free pages released in slices that hold the
+ * database for about the autovacuum budget, back to back while a backlog
+ * remains and once per autovacuum interval after that. The WAL is
+ * checkpointed whenever a pass finds the database idle. Unlike vacuum(),
+ * foreground commands never wait longer than one slice.
+ */
+
+#ifndef REDLITE_MAINTENANCE_HPP
+#define REDLITE_MAINTENANCE_HPP
+
+#include "redlite.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace redlite {
+
+/**
+ * MaintenanceScheduler configuration
+ */
+struct MaintenanceOptions {
+    // Sleep between passes once caught up; 0 = db.autovacuum_interval()
+    std::chrono::milliseconds interval{0};
+    // Lock budget per slice; 0 = db.autovacuum_budget()
+    std::chrono::microseconds budget{0};
+    // Gap between slices while catching up, so foreground calls get the lock
+    std::chrono::microseconds slice_gap{500};
+};
+
+/**
+ * What a scheduler has done since it started
+ */
+struct MaintenanceReport {
+    MaintenanceStats totals{};                 // Database-wide, since open
+    std::chrono::duration<double> uptime{0};   // Scheduler running time
+    uint64_t passes = 0;
+    uint64_t slices = 0;
+    uint64_t keys_reclaimed = 0;
+    uint64_t keys_evicted = 0;                 // Live keys dropped for max_memory / max_disk
+    uint64_t pages_freed = 0;
+    uint64_t checkpoints = 0;
+    uint64_t worst_pause_us = 0;               // Longest single slice
+    double last_pass_keys_per_second = 0.0;    // Over the most recent pass that reclaimed keys
+    std::string last_error;                    // Empty unless a slice failed
+
+    double keys_per_second() const {
+        return uptime.count() > 0 ? keys_reclaimed / uptime.count() : 0.0;
+    }
+
+    /**
+     * Prometheus text exposition format (version 0.0.4)
+     */
+    std::string to_prometheus() const {
+        std::string out;
+        auto metric = [&](const char* name, const char* type, const char* help, std::string value) {
+            out += std::string("# HELP ") + name + ' ' + help + '\n';
+            out += std::string("# TYPE ") + name + ' ' + type + '\n';
+            out += std::string(name) + ' ' + value + '\n';
+        };
+        auto number = [](double v) {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.9g", v);
+            return std::string(buf);
+        };
+        metric("redlite_maintenance_slices_total", "counter", "Maintenance slices run", std::to_string(slices));
+        metric("redlite_maintenance_keys_reclaimed_total", "counter", "Expired keys deleted", std::to_string(keys_reclaimed));
+        metric("redlite_maintenance_keys_evicted_total", "counter", "Keys evicted to meet max_memory / max_disk", std::to_string(keys_evicted));
+        metric("redlite_maintenance_pages_freed_total", "counter", "Free pages released by incremental vacuum", std::to_string(pages_freed));
+        metric("redlite_maintenance_checkpoints_total", "counter", "Idle WAL checkpoints", std::to_string(checkpoints));
+        metric("redlite_maintenance_keys_reclaimed_per_second", "gauge", "Expired keys deleted per second in the last pass",
+               number(last_pass_keys_per_second));
+        metric("redlite_maintenance_pause_max_seconds", "gauge", "Longest time one slice held the database",
+               number(worst_pause_us * 1e-6));
+        return out;
+    }
+};
+
+/**
+ * Background expiration, incremental vacuum and idle checkpoints
+ *
+ *   auto db = Database::open("app.db", OpenOptionsBuilder().incremental_vacuum(true).build());
+ *   db.set_autovacuum_budget(2000);       // 2ms slices
+ *   MaintenanceScheduler maintenance(db);
+ *   ...
+ *   auto report = maintenance.report();   // keys/s, worst pause
+ *
+ * The Database must outlive the scheduler. Slices are skipped while a
+ * Transaction is open on the same database. Failed slices are recorded in
+ * report().last_error and retried on the next pass.
+ */
+class MaintenanceScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit MaintenanceScheduler(Database& db, MaintenanceOptions options = {})
+        : db_(db), options_(options), start_(Clock::now()) {
+        worker_ = std::thread([this] { run(); });
+    }
+
+    /**
+     * Finish the current slice, then stop
+     */
+    ~MaintenanceScheduler() { stop(); }
+
+    MaintenanceScheduler(const MaintenanceScheduler&) = delete;
+    MaintenanceScheduler& operator=(const MaintenanceScheduler&) = delete;
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) return;
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        worker_.join();
+    }
+
+    /**
+     * Start a pass now instead of at the end of the interval
+     */
+    void wake() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            woken_ = true;
+        }
+        cv_.notify_one();
+    }
+
+    MaintenanceReport report() const {
+        MaintenanceReport r;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            r = report_;
+        }
+        r.uptime = Clock::now() - start_;
+        r.totals = db_.maintenance_stats();
+        return r;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            lock.unlock();
+            auto interval = options_.interval;
+            try {
+                if (interval.count() == 0) interval = std::chrono::milliseconds(db_.autovacuum_interval());
+                run_pass();
+            } catch (const std::exception& e) {
+                std::lock_guard<std::mutex> guard(mutex_);
+                report_.last_error = e.what();
+            }
+            lock.lock();
+            cv_.wait_for(lock, interval, [this] { return stopping_ || woken_; });
+            woken_ = false;
+        }
+    }
+
+    // Slices back to back (with a short gap) until no backlog is left
+    void run_pass() {
+        auto pass_start = Clock::now();
+        uint64_t pass_keys = 0;
+        for (;;) {
+            MaintenanceStep step = db_.maintenance_step(options_.budget.count());
+            pass_keys += step.keys_reclaimed;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++report_.slices;
+                report_.keys_reclaimed += step.keys_reclaimed;
+                report_.keys_evicted += step.keys_evicted;
+                report_.pages_freed += step.pages_freed;
+                report_.checkpoints += step.checkpointed ? 1 : 0;
+                if (step.pause_us > report_.worst_pause_us) report_.worst_pause_us = step.pause_us;
+                if (!step.more || stopping_) break;
+            }
+            std::this_thread::sleep_for(options_.slice_gap);
+        }
+
+        std::chrono::duration<double> elapsed = Clock::now() - pass_start;
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++report_.passes;
+        if (pass_keys > 0 && elapsed.count() > 0) report_.last_pass_keys_per_second = pass_keys / elapsed.count();
+    }
+
+    Database& db_;
+    MaintenanceOptions options_;
+    Clock::time_point start_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    bool woken_ = false;
+    MaintenanceReport report_;
+    std::thread worker_;
+};
+
+} // namespace redlite
+
+#endif // REDLITE_MAINTENANCE_HPP
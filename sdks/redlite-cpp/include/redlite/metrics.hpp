@@ -0,0 +1,460 @@
+/**
+ * Redlite C++ SDK - per-command instrumentation
+ *
+ * Opt-in: define REDLITE_ENABLE_METRICS before including redlite.hpp (or
+ * configure CMake with -DREDLITE_METRICS=ON). Every Database method then
+ * records its call count, errors, payload bytes in and out, and latency
+ * histograms split into time spent inside the FFI and time spent in the
+ * wrapper converting arguments and copying results. Without the define the
+ * hooks expand to nothing and snapshot() is always empty.
+ *
+ *   auto snap = redlite::metrics::snapshot();
+ *   if (auto* get = snap.find("get")) std::printf("p99 %llu ns\n", get->latency.percentile(0.99));
+ *   std::string text = snap.to_prometheus();
+ *
+ * Counters are process-wide (shared by every Database) and thread-safe.
+ * When one method calls another, only the outermost call is recorded.
+ */
+
+#ifndef REDLITE_METRICS_HPP
+#define REDLITE_METRICS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace redlite {
+
+/**
+ * Latency distribution at snapshot time (nanoseconds)
+ */
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sum_ns = 0;
+    uint64_t min_ns = 0;
+    uint64_t max_ns = 0;
+    // Non-empty buckets in ascending order: (inclusive upper bound, count)
+    std::vector<std::pair<uint64_t, uint64_t>> buckets;
+
+    double mean_ns() const { return count ? static_cast<double>(sum_ns) / count : 0.0; }
+
+    /**
+     * Upper bound of the bucket holding quantile q (0..1); within 6.25% of
+     * the true value
+     */
+    uint64_t percentile(double q) const {
+        if (count == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(std::clamp(q, 0.0, 1.0) * (count - 1)) + 1;
+        uint64_t seen = 0;
+        for (const auto& [upper, n] : buckets) {
+            seen += n;
+            if (seen >= rank) return std::min(upper, max_ns);
+        }
+        return max_ns;
+    }
+};
+
+/**
+ * Counters for one Database method (overloads share a name)
+ */
+struct CommandMetrics {
+    std::string command;
+    uint64_t calls = 0;
+    uint64_t errors = 0;          // Calls that threw
+    uint64_t bytes_in = 0;        // Keys, values and other string arguments
+    uint64_t bytes_out = 0;       // Bytes returned by the FFI
+    HistogramSnapshot latency;    // Whole call
+    HistogramSnapshot ffi;        // Inside redlite_* calls
+    HistogramSnapshot cpp;        // Wrapper overhead: argument conversion, decode, copies
+};
+
+/**
+ * Point-in-time copy of all command counters
+ */
+struct MetricsSnapshot {
+    std::vector<CommandMetrics> commands;   // Sorted by name
+
+    const CommandMetrics* find(std::string_view command) const {
+        for (const auto& c : commands) {
+            if (c.command == command) return &c;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Prometheus text exposition format (version 0.0.4)
+     */
+    std::string to_prometheus() const {
+        std::string out;
+        auto counter = [&](const char* name, const char* help, uint64_t CommandMetrics::*field) {
+            out += "# HELP "; out += name; out += ' '; out += help; out += '\n';
+            out += "# TYPE "; out += name; out += " counter\n";
+            for (const auto& c : commands) {
+                out += name;
+                out += "{command=\"" + c.command + "\"} " + std::to_string(c.*field) + '\n';
+            }
+        };
+        counter("redlite_command_calls_total", "Database method calls", &CommandMetrics::calls);
+        counter("redlite_command_errors_total", "Database method calls that threw", &CommandMetrics::errors);
+        counter("redlite_command_bytes_in_total", "Argument bytes passed to the FFI", &CommandMetrics::bytes_in);
+        counter("redlite_command_bytes_out_total", "Result bytes returned by the FFI", &CommandMetrics::bytes_out);
+
+        static constexpr double kBounds[] = {1e-6, 2.5e-6, 5e-6, 1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4,
+                                             1e-3, 2.5e-3, 5e-3, 1e-2, 2.5e-2, 5e-2, 0.1, 0.25, 0.5, 1.0};
+        const char* name = "redlite_command_duration_seconds";
+        out += "# HELP redlite_command_duration_seconds Database method latency by phase\n";
+        out += "# TYPE redlite_command_duration_seconds histogram\n";
+        char num[32];
+        for (const auto& c : commands) {
+            std::pair<const char*, const HistogramSnapshot*> phases[] = {
+                {"total", &c.latency}, {"ffi", &c.ffi}, {"cpp", &c.cpp}};
+            for (const auto& [phase, h] : phases) {
+                std::string labels = "command=\"" + c.command + "\",phase=\"" + phase + "\"";
+                size_t b = 0;
+                uint64_t cumulative = 0;
+                for (double bound : kBounds) {
+                    auto limit = static_cast<uint64_t>(bound * 1e9);
+                    for (; b < h->buckets.size() && h->buckets[b].first <= limit; ++b) {
+                        cumulative += h->buckets[b].second;
+                    }
+                    std::snprintf(num, sizeof(num), "%g", bound);
+                    out += std::string(name) + "_bucket{" + labels + ",le=\"" + num + "\"} " +
+                           std::to_string(cumulative) + '\n';
+                }
+                out += std::string(name) + "_bucket{" + labels + ",le=\"+Inf\"} " + std::to_string(h->count) + '\n';
+                std::snprintf(num, sizeof(num), "%.9f", h->sum_ns / 1e9);
+                out += std::string(name) + "_sum{" + labels + "} " + num + '\n';
+                out += std::string(name) + "_count{" + labels + "} " + std::to_string(h->count) + '\n';
+            }
+        }
+        return out;
+    }
+};
+
+namespace metrics {
+
+#ifdef REDLITE_ENABLE_METRICS
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+namespace detail {
+
+using Clock = std::chrono::steady_clock;
+
+inline uint64_t elapsed_ns(Clock::time_point start) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+/**
+ * Log-linear (HDR-style) histogram: 16 linear sub-buckets per power of two,
+ * so each bucket is at most 6.25% wide. Records 0 ns to ~18 minutes; larger
+ * values land in the last bucket. Lock-free.
+ */
+class Histogram {
+public:
+    static constexpr int kSubBits = 4;
+    static constexpr uint64_t kSub = uint64_t(1) << kSubBits;
+    static constexpr int kMaxBits = 40;
+    static constexpr size_t kBuckets = (kMaxBits - kSubBits + 1) * kSub;
+
+    void record(uint64_t ns) {
+        buckets_[index(ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t seen = max_.load(std::memory_order_relaxed);
+        while (ns > seen && !max_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {}
+        seen = min_.load(std::memory_order_relaxed);
+        while (ns < seen && !min_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {}
+    }
+
+    HistogramSnapshot snapshot() const {
+        HistogramSnapshot s;
+        s.count = count_.load(std::memory_order_relaxed);
+        s.sum_ns = sum_.load(std::memory_order_relaxed);
+        s.max_ns = max_.load(std::memory_order_relaxed);
+        s.min_ns = s.count ? min_.load(std::memory_order_relaxed) : 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            if (uint64_t n = buckets_[i].load(std::memory_order_relaxed)) s.buckets.emplace_back(upper(i), n);
+        }
+        return s;
+    }
+
+    void reset() {
+        for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+        min_.store(UINT64_MAX, std::memory_order_relaxed);
+    }
+
+    static size_t index(uint64_t v) {
+        v = std::min(v, (uint64_t(1) << kMaxBits) - 1);
+        if (v < kSub) return static_cast<size_t>(v);
+        int msb = top_bit(v);
+        int shift = msb - kSubBits;
+        return static_cast<size_t>((shift + 1) * kSub + ((v >> shift) - kSub));
+    }
+
+    // Largest value that maps to bucket i
+    static uint64_t upper(size_t i) {
+        if (i < kSub) return i;
+        uint64_t group = i / kSub;
+        uint64_t sub = i % kSub;
+        int shift = static_cast<int>(group) - 1;
+        return ((kSub + sub + 1) << shift) - 1;
+    }
+
+private:
+    static int top_bit(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(v);
+#else
+        int n = 0;
+        while (v >>= 1) ++n;
+        return n;
+#endif
+    }
+
+    std::array<std::atomic<uint64_t>, kBuckets> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+    std::atomic<uint64_t> min_{UINT64_MAX};
+};
+
+struct CommandStats {
+    explicit CommandStats(std::string n) : name(std::move(n)) {}
+
+    void record(uint64_t total_ns, uint64_t ffi_ns, uint64_t in, uint64_t out, bool failed) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        if (failed) errors.fetch_add(1, std::memory_order_relaxed);
+        bytes_in.fetch_add(in, std::memory_order_relaxed);
+        bytes_out.fetch_add(out, std::memory_order_relaxed);
+        latency.record(total_ns);
+        ffi.record(ffi_ns);
+        cpp.record(total_ns > ffi_ns ? total_ns - ffi_ns : 0);
+    }
+
+    std::string name;
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> bytes_in{0};
+    std::atomic<uint64_t> bytes_out{0};
+    Histogram latency;
+    Histogram ffi;
+    Histogram cpp;
+};
+
+/**
+ * Process-wide table of command counters. Entries are created on first use
+ * and never removed, so call sites can cache the reference.
+ */
+class Registry {
+public:
+    static Registry& instance() {
+        static Registry registry;
+        return registry;
+    }
+
+    CommandStats& command(const char* name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = commands_.find(name);
+        if (it == commands_.end()) {
+            it = commands_.emplace(name, std::make_unique<CommandStats>(name)).first;
+        }
+        return *it->second;
+    }
+
+    MetricsSnapshot snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        MetricsSnapshot s;
+        s.commands.reserve(commands_.size());
+        for (const auto& [name, c] : commands_) {
+            CommandMetrics m;
+            m.command = name;
+            m.calls = c->calls.load(std::memory_order_relaxed);
+            m.errors = c->errors.load(std::memory_order_relaxed);
+            m.bytes_in = c->bytes_in.load(std::memory_order_relaxed);
+            m.bytes_out = c->bytes_out.load(std::memory_order_relaxed);
+            m.latency = c->latency.snapshot();
+            m.ffi = c->ffi.snapshot();
+            m.cpp = c->cpp.snapshot();
+            s.commands.push_back(std::move(m));
+        }
+        return s;
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [name, c] : commands_) {
+            c->calls.store(0, std::memory_order_relaxed);
+            c->errors.store(0, std::memory_order_relaxed);
+            c->bytes_in.store(0, std::memory_order_relaxed);
+            c->bytes_out.store(0, std::memory_order_relaxed);
+            c->latency.reset();
+            c->ffi.reset();
+            c->cpp.reset();
+        }
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<CommandStats>, std::less<>> commands_;
+};
+
+/**
+ * Times one Database method call. Only the outermost scope on a thread is
+ * active; FFI time and result bytes are charged to it.
+ */
+class Scope {
+public:
+    Scope(CommandStats& stats, uint64_t bytes_in) {
+        if (current_) return;
+        current_ = this;
+        stats_ = &stats;
+        bytes_in_ = bytes_in;
+        exceptions_ = std::uncaught_exceptions();
+        start_ = Clock::now();
+    }
+
+    ~Scope() {
+        if (!stats_) return;
+        uint64_t total = elapsed_ns(start_);
+        current_ = nullptr;
+        stats_->record(total, ffi_ns_, bytes_in_, bytes_out_, std::uncaught_exceptions() > exceptions_);
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    static Scope* current() { return current_; }
+
+    uint64_t ffi_ns_ = 0;
+    uint64_t bytes_out_ = 0;
+
+private:
+    static inline thread_local Scope* current_ = nullptr;
+
+    CommandStats* stats_ = nullptr;
+    uint64_t bytes_in_ = 0;
+    int exceptions_ = 0;
+    Clock::time_point start_;
+};
+
+/**
+ * Run an FFI call, charging its duration to the active scope
+ */
+template <typename F>
+decltype(auto) ffi(F&& call) {
+    struct Charge {
+        Scope* scope;
+        Clock::time_point start;
+        ~Charge() {
+            if (scope) scope->ffi_ns_ += elapsed_ns(start);
+        }
+    } charge{Scope::current(), Clock::now()};
+    return call();
+}
+
+inline void add_bytes_out(uint64_t n) {
+    if (Scope* scope = Scope::current()) scope->bytes_out_ += n;
+}
+
+template <typename T, typename = void>
+struct is_range : std::false_type {};
+template <typename T>
+struct is_range<T, std::void_t<decltype(std::begin(std::declval<const T&>())),
+                               decltype(std::end(std::declval<const T&>()))>> : std::true_type {};
+
+template <typename T, typename = void>
+struct has_member_field : std::false_type {};
+template <typename T>
+struct has_member_field<T, std::void_t<decltype(std::declval<const T&>().member)>> : std::true_type {};
+
+template <typename T>
+struct is_pair : std::false_type {};
+template <typename A, typename B>
+struct is_pair<std::pair<A, B>> : std::true_type {};
+
+// Payload size of one argument: strings and containers of strings, pairs
+// and ZMembers count their bytes, arrays of numbers their raw size, scalars 0
+template <typename T>
+uint64_t arg_bytes(const T& v) {
+    if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        return std::string_view(v).size();
+    } else if constexpr (is_pair<T>::value) {
+        return arg_bytes(v.first) + arg_bytes(v.second);
+    } else if constexpr (has_member_field<T>::value) {
+        return arg_bytes(v.member);
+    } else if constexpr (is_range<T>::value) {
+        using Elem = std::decay_t<decltype(*std::begin(v))>;
+        if constexpr (std::is_arithmetic_v<Elem>) {
+            return static_cast<uint64_t>(std::distance(std::begin(v), std::end(v))) * sizeof(Elem);
+        } else {
+            uint64_t n = 0;
+            for (const auto& e : v) n += arg_bytes(e);
+            return n;
+        }
+    } else {
+        return 0;
+    }
+}
+
+template <typename... Args>
+uint64_t payload_bytes(const Args&... args) {
+    return (uint64_t(0) + ... + arg_bytes(args));
+}
+
+} // namespace detail
+
+/**
+ * Copy every command's counters (empty unless REDLITE_ENABLE_METRICS)
+ */
+inline MetricsSnapshot snapshot() {
+    if constexpr (enabled) return detail::Registry::instance().snapshot();
+    return {};
+}
+
+/**
+ * Zero every counter and histogram
+ */
+inline void reset() {
+    if constexpr (enabled) detail::Registry::instance().reset();
+}
+
+} // namespace metrics
+} // namespace redlite
+
+// Hooks used inside Database methods. REDLITE_METRIC(name, (args...)) opens
+// the timing scope for a method; REDLITE_FFI(call) wraps one FFI call.
+#ifdef REDLITE_ENABLE_METRICS
+#define REDLITE_METRIC(name, args)                                                        \
+    static ::redlite::metrics::detail::CommandStats& redlite_metric_stats_ =              \
+        ::redlite::metrics::detail::Registry::instance().command(name);                   \
+    ::redlite::metrics::detail::Scope redlite_metric_scope_(                              \
+        redlite_metric_stats_, ::redlite::metrics::detail::payload_bytes args)
+#define REDLITE_FFI(call) ::redlite::metrics::detail::ffi([&]() -> decltype(auto) { return call; })
+#define REDLITE_BYTES_OUT(n) ::redlite::metrics::detail::add_bytes_out(n)
+#else
+#define REDLITE_METRIC(name, args) ((void)0)
+#define REDLITE_FFI(call) (call)
+#define REDLITE_BYTES_OUT(n) ((void)0)
+#endif
+
+#endif // REDLITE_METRICS_HPP
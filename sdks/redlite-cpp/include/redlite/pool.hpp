@@ -0,0 +1,430 @@
+/**
+ * Redlite C++ SDK - connection pool
+ *
+ * One writer handle plus N reader handles against the same database file.
+ * In WAL mode SQLite serves readers concurrently while the writer commits,
+ * so read-heavy multi-threaded services stop serializing on a single handle.
+ */
+
+#ifndef REDLITE_POOL_HPP
+#define REDLITE_POOL_HPP
+
+#include "redlite.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace redlite {
+
+/**
+ * Thread-safe pool with read/write separation
+ *
+ * Read-only commands go to one of the reader handles, mutations go to the
+ * single writer. Readers see data once the writer has committed it. A read
+ * that hits an expired key deletes it, so readers take the write lock briefly.
+ *
+ *   Pool pool("app.db", 8);
+ *   pool.set("k", "v");                 // writer
+ *   auto v = pool.get("k");             // any free reader
+ *
+ *   {
+ *       auto db = pool.reader();        // RAII lease
+ *       db->hgetall("user:1");
+ *   }
+ *
+ *   pool.write([](Database& db) {       // several writes under one lease
+ *       auto tx = db.transaction();
+ *       db.set("a", "1");
+ *       db.set("b", "2");
+ *       tx.commit();
+ *   });
+ */
+class Pool {
+public:
+    /**
+     * RAII lease on a pooled handle - returned to the pool on destruction
+     */
+    class Lease {
+    public:
+        ~Lease() { release(); }
+
+        // Move only
+        Lease(Lease&& other) noexcept
+            : pool_(other.pool_), db_(other.db_), index_(other.index_) {
+            other.pool_ = nullptr;
+            other.db_ = nullptr;
+        }
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                release();
+                pool_ = other.pool_;
+                db_ = other.db_;
+                index_ = other.index_;
+                other.pool_ = nullptr;
+                other.db_ = nullptr;
+            }
+            return *this;
+        }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Database& operator*() const { return *db_; }
+        Database* operator->() const { return db_; }
+        Database& get() const { return *db_; }
+
+        bool is_writer() const { return index_ == kWriter; }
+
+    private:
+        friend class Pool;
+        Lease(Pool* pool, Database* db, size_t index) : pool_(pool), db_(db), index_(index) {}
+
+        void release() {
+            if (pool_) pool_->release(index_);
+            pool_ = nullptr;
+            db_ = nullptr;
+        }
+
+        Pool* pool_;
+        Database* db_;
+        size_t index_;
+    };
+
+    /**
+     * Open one writer and `readers` reader handles on the database file
+     * @throws Error if any handle fails to open or path is ":memory:"
+     */
+    explicit Pool(const std::string& path, size_t readers = default_readers())
+        : Pool(path, readers, OpenOptions{}) {}
+
+    /**
+     * Open every handle with the same connection settings, e.g.
+     * wal_autocheckpoint(0) to leave checkpoints to the writer's checkpoint()
+     */
+    Pool(const std::string& path, size_t readers, const OpenOptions& options)
+        : writer_(Database::open(file_path(path), options)) {
+        if (readers == 0) readers = 1;
+
+        readers_.reserve(readers);
+        free_.reserve(readers);
+        for (size_t i = 0; i < readers; ++i) {
+            readers_.emplace_back(Database::open(path, options));
+            // Leave the periodic expiry sweep to the writer. A read that finds
+            // an expired key still deletes it, waiting out busy_timeout if the
+            // writer is mid-commit.
+            readers_.back().set_autovacuum(false);
+            free_.push_back(i);
+        }
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    /**
+     * Lease a reader handle, blocking until one is free
+     */
+    Lease reader() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        available_.wait(lock, [this] { return !free_.empty(); });
+        size_t index = free_.back();
+        free_.pop_back();
+        return Lease(this, &readers_[index], index);
+    }
+
+    /**
+     * Lease the writer handle, blocking until it is free
+     */
+    Lease writer() {
+        writer_mutex_.lock();
+        return Lease(this, &writer_, kWriter);
+    }
+
+    /**
+     * Run f(Database&) on a reader and return its result
+     */
+    template <typename F>
+    auto read(F&& f) -> std::invoke_result_t<F, Database&> {
+        auto lease = reader();
+        return std::forward<F>(f)(*lease);
+    }
+
+    /**
+     * Run f(Database&) on the writer and return its result
+     */
+    template <typename F>
+    auto write(F&& f) -> std::invoke_result_t<F, Database&> {
+        auto lease = writer();
+        return std::forward<F>(f)(*lease);
+    }
+
+    size_t reader_count() const { return readers_.size(); }
+
+    static size_t default_readers() {
+        size_t n = std::thread::hardware_concurrency();
+        return n > 0 ? n : 4;
+    }
+
+    // ==================== Reads (routed to readers) ====================
+
+    std::optional<std::string> get(std::string_view key) {
+        return read([&](Database& db) { return db.get(key); });
+    }
+
+    std::vector<std::optional<std::string>> mget(const std::vector<std::string>& keys) {
+        return read([&](Database& db) { return db.mget(keys); });
+    }
+
+    int64_t strlen(std::string_view key) {
+        return read([&](Database& db) { return db.strlen(key); });
+    }
+
+    std::string getrange(std::string_view key, int64_t start, int64_t end) {
+        return read([&](Database& db) { return db.getrange(key, start, end); });
+    }
+
+    bool exists(std::string_view key) {
+        return read([&](Database& db) { return db.exists(key); });
+    }
+
+    int64_t exists(const std::vector<std::string>& keys) {
+        return read([&](Database& db) { return db.exists(keys); });
+    }
+
+    std::optional<std::string> type(std::string_view key) {
+        return read([&](Database& db) { return db.type(key); });
+    }
+
+    int64_t ttl(std::string_view key) {
+        return read([&](Database& db) { return db.ttl(key); });
+    }
+
+    int64_t pttl(std::string_view key) {
+        return read([&](Database& db) { return db.pttl(key); });
+    }
+
+    std::vector<std::string> keys(std::string_view pattern = "*") {
+        return read([&](Database& db) { return db.keys(pattern); });
+    }
+
+    int64_t dbsize() {
+        return read([&](Database& db) { return db.dbsize(); });
+    }
+
+    std::optional<std::string> hget(std::string_view key, std::string_view field) {
+        return read([&](Database& db) { return db.hget(key, field); });
+    }
+
+    std::vector<std::optional<std::string>> hmget(std::string_view key,
+                                                   const std::vector<std::string>& fields) {
+        return read([&](Database& db) { return db.hmget(key, fields); });
+    }
+
+    std::unordered_map<std::string, std::string> hgetall(std::string_view key) {
+        return read([&](Database& db) { return db.hgetall(key); });
+    }
+
+    std::vector<std::string> hkeys(std::string_view key) {
+        return read([&](Database& db) { return db.hkeys(key); });
+    }
+
+    std::vector<std::string> hvals(std::string_view key) {
+        return read([&](Database& db) { return db.hvals(key); });
+    }
+
+    int64_t hlen(std::string_view key) {
+        return read([&](Database& db) { return db.hlen(key); });
+    }
+
+    bool hexists(std::string_view key, std::string_view field) {
+        return read([&](Database& db) { return db.hexists(key, field); });
+    }
+
+    std::vector<std::string> lrange(std::string_view key, int64_t start, int64_t stop) {
+        return read([&](Database& db) { return db.lrange(key, start, stop); });
+    }
+
+    std::optional<std::string> lindex(std::string_view key, int64_t index) {
+        return read([&](Database& db) { return db.lindex(key, index); });
+    }
+
+    int64_t llen(std::string_view key) {
+        return read([&](Database& db) { return db.llen(key); });
+    }
+
+    std::vector<std::string> smembers(std::string_view key) {
+        return read([&](Database& db) { return db.smembers(key); });
+    }
+
+    bool sismember(std::string_view key, std::string_view member) {
+        return read([&](Database& db) { return db.sismember(key, member); });
+    }
+
+    int64_t scard(std::string_view key) {
+        return read([&](Database& db) { return db.scard(key); });
+    }
+
+    std::optional<double> zscore(std::string_view key, std::string_view member) {
+        return read([&](Database& db) { return db.zscore(key, member); });
+    }
+
+    int64_t zcard(std::string_view key) {
+        return read([&](Database& db) { return db.zcard(key); });
+    }
+
+    int64_t zcount(std::string_view key, double min, double max) {
+        return read([&](Database& db) { return db.zcount(key, min, max); });
+    }
+
+    std::vector<std::string> zrange(std::string_view key, int64_t start, int64_t stop) {
+        return read([&](Database& db) { return db.zrange(key, start, stop); });
+    }
+
+    std::vector<ZMember> zrange_with_scores(std::string_view key, int64_t start, int64_t stop) {
+        return read([&](Database& db) { return db.zrange_with_scores(key, start, stop); });
+    }
+
+    std::vector<std::string> zrevrange(std::string_view key, int64_t start, int64_t stop) {
+        return read([&](Database& db) { return db.zrevrange(key, start, stop); });
+    }
+
+    // ==================== Writes (routed to the writer) ====================
+
+    bool set(std::string_view key, std::string_view value, int64_t ttl_seconds = 0) {
+        return write([&](Database& db) { return db.set(key, value, ttl_seconds); });
+    }
+
+    bool set(std::string_view key, std::string_view value, const SetOptions& opts) {
+        return write([&](Database& db) { return db.set(key, value, opts); });
+    }
+
+    bool mset(const std::unordered_map<std::string, std::string>& pairs) {
+        return write([&](Database& db) { return db.mset(pairs); });
+    }
+
+    std::optional<std::string> getdel(std::string_view key) {
+        return write([&](Database& db) { return db.getdel(key); });
+    }
+
+    int64_t append(std::string_view key, std::string_view value) {
+        return write([&](Database& db) { return db.append(key, value); });
+    }
+
+    int64_t incr(std::string_view key) {
+        return write([&](Database& db) { return db.incr(key); });
+    }
+
+    int64_t incrby(std::string_view key, int64_t increment) {
+        return write([&](Database& db) { return db.incrby(key, increment); });
+    }
+
+    int64_t decr(std::string_view key) {
+        return write([&](Database& db) { return db.decr(key); });
+    }
+
+    int64_t del(std::string_view key) {
+        return write([&](Database& db) { return db.del(key); });
+    }
+
+    int64_t del(const std::vector<std::string>& keys) {
+        return write([&](Database& db) { return db.del(keys); });
+    }
+
+    bool expire(std::string_view key, int64_t seconds) {
+        return write([&](Database& db) { return db.expire(key, seconds); });
+    }
+
+    bool persist(std::string_view key) {
+        return write([&](Database& db) { return db.persist(key); });
+    }
+
+    int64_t hset(std::string_view key, std::string_view field, std::string_view value) {
+        return write([&](Database& db) { return db.hset(key, field, value); });
+    }
+
+    int64_t hset(std::string_view key, const std::unordered_map<std::string, std::string>& fields) {
+        return write([&](Database& db) { return db.hset(key, fields); });
+    }
+
+    int64_t hdel(std::string_view key, const std::vector<std::string>& fields) {
+        return write([&](Database& db) { return db.hdel(key, fields); });
+    }
+
+    int64_t hincrby(std::string_view key, std::string_view field, int64_t increment) {
+        return write([&](Database& db) { return db.hincrby(key, field, increment); });
+    }
+
+    int64_t lpush(std::string_view key, const std::vector<std::string>& values) {
+        return write([&](Database& db) { return db.lpush(key, values); });
+    }
+
+    int64_t rpush(std::string_view key, const std::vector<std::string>& values) {
+        return write([&](Database& db) { return db.rpush(key, values); });
+    }
+
+    std::vector<std::string> lpop(std::string_view key, size_t count = 1) {
+        return write([&](Database& db) { return db.lpop(key, count); });
+    }
+
+    std::vector<std::string> rpop(std::string_view key, size_t count = 1) {
+        return write([&](Database& db) { return db.rpop(key, count); });
+    }
+
+    int64_t sadd(std::string_view key, const std::vector<std::string>& members) {
+        return write([&](Database& db) { return db.sadd(key, members); });
+    }
+
+    int64_t srem(std::string_view key, const std::vector<std::string>& members) {
+        return write([&](Database& db) { return db.srem(key, members); });
+    }
+
+    int64_t zadd(std::string_view key, const std::vector<ZMember>& members) {
+        return write([&](Database& db) { return db.zadd(key, members); });
+    }
+
+    int64_t zadd(std::string_view key, double score, std::string_view member) {
+        return write([&](Database& db) { return db.zadd(key, score, member); });
+    }
+
+    int64_t zrem(std::string_view key, const std::vector<std::string>& members) {
+        return write([&](Database& db) { return db.zrem(key, members); });
+    }
+
+    double zincrby(std::string_view key, double increment, std::string_view member) {
+        return write([&](Database& db) { return db.zincrby(key, increment, member); });
+    }
+
+private:
+    static constexpr size_t kWriter = static_cast<size_t>(-1);
+
+    // Checked before any handle is opened
+    static const std::string& file_path(const std::string& path) {
+        if (path == ":memory:") throw Error("Pool requires a file-backed database");
+        return path;
+    }
+
+    void release(size_t index) {
+        if (index == kWriter) {
+            writer_mutex_.unlock();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(index);
+        }
+        available_.notify_one();
+    }
+
+    Database writer_;
+    std::mutex writer_mutex_;
+
+    std::vector<Database> readers_;
+    std::vector<size_t> free_;       // Indices of idle readers
+    std::mutex mutex_;
+    std::condition_variable available_;
+};
+
+} // namespace redlite
+
+#endif // REDLITE_POOL_HPP
@@ -18,6 +18,36 @@
 #include <memory>
 #include <unordered_map>
 #include <cmath>
+#include <iterator>
+#include <cstdio>
+#include <initializer_list>
+#include <utility>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <functional>
+#include <array>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define REDLITE_HAS_PMR 1
+#endif
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#define REDLITE_HAS_SPAN 1
+#endif
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define REDLITE_HAS_FLOAT_CHARCONV 1
+#endif
+
+#include "metrics.hpp"
 
 // Forward declare the C types
 extern "C" {
@@ -44,11 +74,76 @@ extern "C" {
         const uint8_t* member;
         size_t member_len;
     };
+    struct RedliteZMemberArray {
+        RedliteZMember* members;
+        size_t len;
+        uint8_t* data;
+        size_t data_len;
+    };
+    struct RedliteBulkRecord {
+        int kind;
+        const char* key;
+        size_t key_len;
+        const char* field;
+        size_t field_len;
+        const uint8_t* value;
+        size_t value_len;
+        double score;
+        int64_t ttl_ms;
+    };
+    struct RedliteStats {
+        uint64_t cache_hits;
+        uint64_t cache_misses;
+        uint64_t cache_writes;
+        uint64_t cache_spills;
+        uint64_t cache_bytes;
+        uint64_t statements;
+        uint64_t statement_bytes;
+        uint64_t statement_runs;
+        uint64_t checkpoints;
+        uint64_t checkpoint_total_us;
+        uint64_t checkpoint_max_us;
+        uint64_t lock_waits;
+        uint64_t lock_wait_ns;
+    };
+    struct RedliteOpenOptions {
+        int64_t cache_mb;
+        int64_t mmap_size;
+        int synchronous;
+        uint32_t page_size;
+        int64_t wal_autocheckpoint;
+        int temp_store_memory;
+        int64_t busy_timeout_ms;
+        size_t statement_cache;
+        int incremental_vacuum;
+        uint64_t max_memory;
+        uint64_t max_disk;
+        int eviction_policy;
+    };
+    struct RedliteMaintenanceStep {
+        uint64_t keys_reclaimed;
+        uint64_t pages_freed;
+        int checkpointed;
+        int more;
+        uint64_t pause_us;
+        uint64_t keys_evicted;
+    };
+    struct RedliteMaintenanceStats {
+        uint64_t steps;
+        uint64_t keys_reclaimed;
+        uint64_t pages_freed;
+        uint64_t checkpoints;
+        uint64_t pause_total_us;
+        uint64_t pause_max_us;
+        uint64_t keys_evicted;
+    };
 
     // FFI function declarations
     RedliteDb* redlite_open(const char* path);
     RedliteDb* redlite_open_memory();
     RedliteDb* redlite_open_with_cache(const char* path, int64_t cache_mb);
+    RedliteOpenOptions redlite_open_options_default();
+    RedliteDb* redlite_open_with_options(const char* path, const RedliteOpenOptions* options);
     void redlite_close(RedliteDb* db);
     char* redlite_last_error();
     void redlite_free_string(char* s);
@@ -132,6 +227,15 @@ extern "C" {
 
     // Server commands
     int64_t redlite_vacuum(RedliteDb* db);
+    int redlite_set_autovacuum(RedliteDb* db, int enabled);
+    int redlite_set_autovacuum_interval(RedliteDb* db, int64_t interval_ms);
+    int64_t redlite_autovacuum_interval(RedliteDb* db);
+    int redlite_set_autovacuum_budget(RedliteDb* db, int64_t budget_us);
+    int64_t redlite_autovacuum_budget(RedliteDb* db);
+    int redlite_maintenance_step(RedliteDb* db, int64_t budget_us, RedliteMaintenanceStep* out);
+    int redlite_maintenance_stats(RedliteDb* db, RedliteMaintenanceStats* out);
+    int redlite_checkpoint(RedliteDb* db);
+    int redlite_stats(RedliteDb* db, RedliteStats* out);
     char* redlite_version();
 
     // JSON commands (ReJSON-compatible)
@@ -146,15 +250,37 @@ extern "C" {
     int64_t redlite_json_arrlen(RedliteDb* db, const char* key, const char* path);
     char* redlite_json_arrpop(RedliteDb* db, const char* key, const char* path, int64_t index);
     int64_t redlite_json_clear(RedliteDb* db, const char* key, const char* path);
+    int redlite_json_set_many(RedliteDb* db, const char* key, size_t key_len, const RedliteBytes* paths,
+                              const RedliteBytes* values, size_t len);
+    RedliteBytesArray redlite_json_get_many(RedliteDb* db, const char* key, size_t key_len,
+                                            const RedliteBytes* paths, size_t paths_len);
 
     // History enable/disable commands
-    int redlite_history_enable_global(RedliteDb* db, const char* retention_type, int64_t retention_value);
-    int redlite_history_enable_database(RedliteDb* db, int db_num, const char* retention_type, int64_t retention_value);
-    int redlite_history_enable_key(RedliteDb* db, const char* key, const char* retention_type, int64_t retention_value);
+    int redlite_history_enable_global(RedliteDb* db, int retention_type, int64_t retention_value);
+    int redlite_history_enable_database(RedliteDb* db, int db_num, int retention_type, int64_t retention_value);
+    int redlite_history_enable_key(RedliteDb* db, const char* key, int retention_type, int64_t retention_value);
     int redlite_history_disable_global(RedliteDb* db);
     int redlite_history_disable_database(RedliteDb* db, int db_num);
     int redlite_history_disable_key(RedliteDb* db, const char* key);
     int redlite_is_history_enabled(RedliteDb* db, const char* key);
+    struct RedliteHistoryEntry {
+        int64_t timestamp;
+        RedliteBytes value;
+    };
+    struct RedliteHistoryEntryArray {
+        RedliteHistoryEntry* entries;
+        size_t len;
+    };
+    RedliteHistoryEntryArray redlite_history_get(RedliteDb* db, const char* key, int64_t limit, int64_t since, int64_t until);
+    RedliteBytes redlite_history_getat(RedliteDb* db, const char* key, int64_t timestamp);
+    int64_t redlite_history_clear(RedliteDb* db, const char* key, int64_t before);
+    int64_t redlite_history_prune(RedliteDb* db, int64_t before_timestamp);
+    int64_t redlite_history_prune_batch(RedliteDb* db, int64_t before_timestamp, int64_t limit);
+    void redlite_free_history_entry_array(RedliteHistoryEntryArray arr);
+    RedliteHistoryEntryArray redlite_history_get_len(RedliteDb* db, const char* key, size_t key_len, int64_t limit,
+                                                     int64_t since, int64_t until);
+    RedliteBytes redlite_history_getat_len(RedliteDb* db, const char* key, size_t key_len, int64_t timestamp);
+    int64_t redlite_history_clear_len(RedliteDb* db, const char* key, size_t key_len, int64_t before);
 
     // FTS enable/disable commands
     int redlite_fts_enable_global(RedliteDb* db);
@@ -177,6 +303,345 @@ extern "C" {
     };
     RedliteKeyInfo redlite_keyinfo(RedliteDb* db, const char* key);
     void redlite_free_keyinfo(RedliteKeyInfo info);
+    struct RedliteKeyVersion {
+        uint64_t version;
+        int64_t created_at;
+    };
+    int redlite_key_version_len(RedliteDb* db, const char* key, size_t key_len, RedliteKeyVersion* out);
+
+    // Scan commands
+    struct RedliteScanResult {
+        char* cursor;
+        RedliteStringArray keys;
+    };
+    struct RedliteHScanResult {
+        char* cursor;
+        RedliteBytesArray pairs;
+    };
+    struct RedliteSScanResult {
+        char* cursor;
+        RedliteBytesArray members;
+    };
+    struct RedliteZScanMember {
+        RedliteBytes member;
+        double score;
+    };
+    struct RedliteZScanResult {
+        char* cursor;
+        RedliteZScanMember* members;
+        size_t len;
+    };
+    RedliteScanResult redlite_scan(RedliteDb* db, const char* cursor, const char* pattern, size_t count);
+    RedliteHScanResult redlite_hscan(RedliteDb* db, const char* key, const char* cursor, const char* pattern, size_t count);
+    RedliteSScanResult redlite_sscan(RedliteDb* db, const char* key, const char* cursor, const char* pattern, size_t count);
+    RedliteZScanResult redlite_zscan(RedliteDb* db, const char* key, const char* cursor, const char* pattern, size_t count);
+    void redlite_free_scan_result(RedliteScanResult result);
+    void redlite_free_hscan_result(RedliteHScanResult result);
+    void redlite_free_sscan_result(RedliteSScanResult result);
+    void redlite_free_zscan_result(RedliteZScanResult result);
+
+    // Stream commands
+    struct RedliteStreamId {
+        int64_t ms;
+        int64_t seq;
+    };
+    struct RedliteStreamField {
+        const uint8_t* key;
+        size_t key_len;
+        const uint8_t* value;
+        size_t value_len;
+    };
+    struct RedliteStreamEntry {
+        RedliteStreamId id;
+        RedliteStreamField* fields;
+        size_t fields_len;
+    };
+    struct RedliteStreamEntryArray {
+        RedliteStreamEntry* entries;
+        size_t len;
+    };
+    RedliteStreamId redlite_xadd(RedliteDb* db, const char* key, int64_t id_ms, int64_t id_seq,
+                                 const RedliteStreamField* fields, size_t fields_len,
+                                 int nomkstream, int64_t maxlen, int use_maxlen);
+    int64_t redlite_xlen(RedliteDb* db, const char* key);
+    RedliteStreamEntryArray redlite_xrange(RedliteDb* db, const char* key, int64_t start_ms, int64_t start_seq,
+                                           int64_t end_ms, int64_t end_seq, int64_t count, int use_count);
+    RedliteStreamEntryArray redlite_xrevrange(RedliteDb* db, const char* key, int64_t end_ms, int64_t end_seq,
+                                              int64_t start_ms, int64_t start_seq, int64_t count, int use_count);
+    RedliteStreamEntryArray redlite_xread(RedliteDb* db, const char* key, int64_t id_ms, int64_t id_seq,
+                                          int64_t count, int use_count);
+    int64_t redlite_xtrim(RedliteDb* db, const char* key, int64_t maxlen);
+    int64_t redlite_xdel(RedliteDb* db, const char* key, const RedliteStreamId* ids, size_t ids_len);
+    int redlite_xgroup_create(RedliteDb* db, const char* key, const char* group,
+                              int64_t id_ms, int64_t id_seq, int mkstream);
+    int redlite_xgroup_destroy(RedliteDb* db, const char* key, const char* group);
+    int64_t redlite_xgroup_setid(RedliteDb* db, const char* key, const char* group, int64_t id_ms, int64_t id_seq);
+    int64_t redlite_xgroup_createconsumer(RedliteDb* db, const char* key, const char* group, const char* consumer);
+    int64_t redlite_xgroup_delconsumer(RedliteDb* db, const char* key, const char* group, const char* consumer);
+    RedliteStreamEntryArray redlite_xreadgroup(RedliteDb* db, const char* group, const char* consumer,
+                                               const char* key, const char* id, int64_t count,
+                                               int use_count, int noack);
+    int64_t redlite_xack(RedliteDb* db, const char* key, const char* group,
+                         const RedliteStreamId* ids, size_t ids_len);
+    void redlite_free_stream_entry_array(RedliteStreamEntryArray arr);
+
+    // Vector set commands
+    int redlite_vadd(RedliteDb* db, const char* key, const float* values, size_t dim,
+                     const char* element, const char* attributes);
+    int64_t redlite_vsim(RedliteDb* db, const char* key, const float* query, size_t dim,
+                         size_t count, int64_t nprobe, RedliteStringArray* elements_out,
+                         double* scores_out);
+    int64_t redlite_vindex(RedliteDb* db, const char* key, size_t nlist);
+    int redlite_vindex_drop(RedliteDb* db, const char* key);
+
+    // Length-delimited variants (key as data + length, no NUL terminator)
+    RedliteBytes redlite_get_len(RedliteDb* db, const char* key, size_t key_len);
+    int redlite_set_len(RedliteDb* db, const char* key, size_t key_len, const uint8_t* value, size_t value_len, int64_t ttl_seconds);
+    int redlite_setex_len(RedliteDb* db, const char* key, size_t key_len, int64_t seconds, const uint8_t* value, size_t value_len);
+    int redlite_psetex_len(RedliteDb* db, const char* key, size_t key_len, int64_t milliseconds, const uint8_t* value, size_t value_len);
+    RedliteBytes redlite_getdel_len(RedliteDb* db, const char* key, size_t key_len);
+    int64_t redlite_append_len(RedliteDb* db, const char* key, size_t key_len, const uint8_t* value, size_t value_len);
+    int64_t redlite_strlen_len(RedliteDb* db, const char* key, size_t key_len);
+    RedliteBytes redlite_getrange_len(RedliteDb* db, const char* key, size_t key_len, int64_t start, int64_t end);
+    int64_t redlite_setrange_len(RedliteDb* db, const char* key, size_t key_len, int64_t offset, const uint8_t* value, size_t value_len);
+    int64_t redlite_incr_len(RedliteDb* db, const char* key, size_t key_len);
+    int64_t redlite_decr_len(RedliteDb* db, const char* key, size_t key_len);
+    int64_t redlite_incrby_len(RedliteDb* db, const char* key, size_t key_len, int64_t increment);
+    int64_t redlite_decrby_len(RedliteDb* db, const char* key, size_t key_len, int64_t decrement);
+    char* redlite_incrbyfloat_len(RedliteDb* db, const char* key, size_t key_len, double increment);
+    RedliteBytesArray redlite_mget_len(RedliteDb* db, const RedliteBytes* keys, size_t keys_len);
+    int redlite_mset_len(RedliteDb* db, const RedliteBytes* keys, const RedliteBytes* values, size_t count);
+    int64_t redlite_del_len(RedliteDb* db, const RedliteBytes* keys, size_t keys_len);
+    int64_t redlite_exists_len(RedliteDb* db, const RedliteBytes* keys, size_t keys_len);
+    char* redlite_type_len(RedliteDb* db, const char* key, size_t key_len);
+    int64_t redlite_ttl_len(RedliteDb* db, const char* key, size_t key_len);
+    int64_t redlite_pttl_len(RedliteDb* db, const char* key, size_t key_len);
+    int redlite_expire_len(RedliteDb* db, const char* key, size_t key_len, int64_t seconds);
+    int redlite_pexpire_len(RedliteDb* db, const char* key, size_t key_len, int64_t milliseconds);
+    int redlite_expireat_len(RedliteDb* db, const char* key, size_t key_len, int64_t unix_seconds);
+    int redlite_pexpireat_len(RedliteDb* db, const char* key, size_t key_len, int64_t unix_ms);
+    int redlite_persist_len(RedliteDb* db, const char* key, size_t key_len);
+    int redlite_rename_len(RedliteDb* db, const char* key, size_t key_len, const char* newkey, size_t newkey_len);
+    int redlite_renamenx_len(RedliteDb* db, const char* key, size_t key_len, const char* newkey, size_t newkey_len);
+    int64_t redlite_hset_len(RedliteDb* db, const char* key, size_t key_len, const RedliteBytes* fields, const RedliteBytes* values, size_t count);
+    RedliteBytes redlite_hget_len(RedliteDb* db, const char* key, size_t key_len, const char* field, size_t field_len);
+    int64_t redlite_hdel_len(RedliteDb* db, const char* key, size_t key_len, const RedliteBytes* fields, size_t fields_len);
+    int redlite_hexists_len(RedliteDb* db, const char* key, size_t key_len, const char* field, size_t field_len);
+    int64_t redlite_hlen_len(RedliteDb* db, const char* key, size_t key_len);
+    RedliteStringArray redlite_hkeys_len(RedliteDb* db, const char* key, size_t key_len);
+    RedliteBytesArray redlite_hvals_len(RedliteDb* db, const char* key, size_t key_len);
+    int64_t redlite_hincrby_len(RedliteDb* db, const char* key, size_t key_len, const char* field, size_t field_len, int64_t increment);
+    RedliteBytesArray redlite_hgetall_len(RedliteDb* db, const char* key, size_t key_len);
+    RedliteBytesArray redlite_hmget_len(RedliteDb* db, const char* key, size_t key_len, const RedliteBytes* fields, size_t fields_len);
+    int64_t redlite_lpush_len(RedliteDb* db, const char* key, size_t key_len, const RedliteBytes* values, size_t values_len);
+    int64_t redlite_rpush_len(RedliteDb* db, const char* key, size_t key_len, const RedliteBytes* values, size_t values_len);
+    RedliteBytesArray redlite_lpop_len(RedliteDb* db, const char* key, size_t key_len, size_t count);
+    RedliteBytesArray redlite_rpop_len(RedliteDb* db, const char* key, size_t key_len, size_t count);
+    int64_t redlite_llen_len(RedliteDb* db, const char* key, size_t key_len);
+    RedliteBytesArray redlite_lrange_len(RedliteDb* db, const char* key, size_t key_len, int64_t start, int64_t stop);
+    RedliteBytes redlite_lindex_len(RedliteDb* db, const char* key, size_t key_len, int64_t index);
+    int64_t redlite_sadd_len(RedliteDb* db, const char* key, size_t key_len, const RedliteBytes* members, size_t members_len);
+    int64_t redlite_srem_len(RedliteDb* db, const char* key, size_t key_len, const RedliteBytes* members, size_t members_len);
+    RedliteBytesArray redlite_smembers_len(RedliteDb* db, const char* key, size_t key_len);
+    int redlite_sismember_len(RedliteDb* db, const char* key, size_t key_len, const uint8_t* member, size_t member_len);
+    int64_t redlite_scard_len(RedliteDb* db, const char* key, size_t key_len);
+    int64_t redlite_zadd_len(RedliteDb* db, const char* key, size_t key_len, const RedliteZMember* members, size_t members_len);
+    int64_t redlite_zrem_len(RedliteDb* db, const char* key, size_t key_len, const RedliteBytes* members, size_t members_len);
+    double redlite_zscore_len(RedliteDb* db, const char* key, size_t key_len, const uint8_t* member, size_t member_len);
+    int64_t redlite_zcard_len(RedliteDb* db, const char* key, size_t key_len);
+    int64_t redlite_zcount_len(RedliteDb* db, const char* key, size_t key_len, double min, double max);
+    double redlite_zincrby_len(RedliteDb* db, const char* key, size_t key_len, double increment, const uint8_t* member, size_t member_len);
+    RedliteBytesArray redlite_zrange_len(RedliteDb* db, const char* key, size_t key_len, int64_t start, int64_t stop, int with_scores);
+    RedliteBytesArray redlite_zrevrange_len(RedliteDb* db, const char* key, size_t key_len, int64_t start, int64_t stop, int with_scores);
+    RedliteZMemberArray redlite_zrange_scored_len(RedliteDb* db, const char* key, size_t key_len, int64_t start, int64_t stop);
+    RedliteZMemberArray redlite_zrevrange_scored_len(RedliteDb* db, const char* key, size_t key_len, int64_t start, int64_t stop);
+    RedliteZMemberArray redlite_zrangebyscore_scored_len(RedliteDb* db, const char* key, size_t key_len, double min, double max, int64_t offset, int64_t count);
+    int64_t redlite_zrank_len(RedliteDb* db, const char* key, size_t key_len, const uint8_t* member, size_t member_len);
+    int64_t redlite_zrevrank_len(RedliteDb* db, const char* key, size_t key_len, const uint8_t* member, size_t member_len);
+    int64_t redlite_getbit_len(RedliteDb* db, const char* key, size_t key_len, uint64_t offset);
+    int64_t redlite_setbit_len(RedliteDb* db, const char* key, size_t key_len, uint64_t offset, int value);
+    int64_t redlite_bitcount_len(RedliteDb* db, const char* key, size_t key_len, int64_t start, int64_t end, int use_range);
+    int64_t redlite_bitop_len(RedliteDb* db, const char* operation, const char* destkey, size_t destkey_len, const RedliteBytes* keys, size_t keys_len);
+    RedliteStreamId redlite_xadd_len(RedliteDb* db, const char* key, size_t key_len, int64_t id_ms, int64_t id_seq, const RedliteStreamField* fields, size_t fields_len, int nomkstream, int64_t maxlen, int use_maxlen);
+    int64_t redlite_xlen_len(RedliteDb* db, const char* key, size_t key_len);
+    RedliteStreamEntryArray redlite_xrange_len(RedliteDb* db, const char* key, size_t key_len, int64_t start_ms, int64_t start_seq, int64_t end_ms, int64_t end_seq, int64_t count, int use_count);
+    RedliteStreamEntryArray redlite_xrevrange_len(RedliteDb* db, const char* key, size_t key_len, int64_t end_ms, int64_t end_seq, int64_t start_ms, int64_t start_seq, int64_t count, int use_count);
+    RedliteStreamEntryArray redlite_xread_len(RedliteDb* db, const char* key, size_t key_len, int64_t id_ms, int64_t id_seq, int64_t count, int use_count);
+    int64_t redlite_xtrim_len(RedliteDb* db, const char* key, size_t key_len, int64_t maxlen);
+    int64_t redlite_xdel_len(RedliteDb* db, const char* key, size_t key_len, const RedliteStreamId* ids, size_t ids_len);
+    int redlite_xgroup_create_len(RedliteDb* db, const char* key, size_t key_len, const char* group, size_t group_len, int64_t id_ms, int64_t id_seq, int mkstream);
+    int redlite_xgroup_destroy_len(RedliteDb* db, const char* key, size_t key_len, const char* group, size_t group_len);
+    int64_t redlite_xgroup_setid_len(RedliteDb* db, const char* key, size_t key_len, const char* group, size_t group_len, int64_t id_ms, int64_t id_seq);
+    int64_t redlite_xgroup_createconsumer_len(RedliteDb* db, const char* key, size_t key_len, const char* group, size_t group_len, const char* consumer, size_t consumer_len);
+    int64_t redlite_xgroup_delconsumer_len(RedliteDb* db, const char* key, size_t key_len, const char* group, size_t group_len, const char* consumer, size_t consumer_len);
+    RedliteStreamEntryArray redlite_xreadgroup_len(RedliteDb* db, const char* group, size_t group_len, const char* consumer, size_t consumer_len, const char* key, size_t key_len, const char* id, size_t id_len, int64_t count, int use_count, int noack);
+    int64_t redlite_xack_len(RedliteDb* db, const char* key, size_t key_len, const char* group, size_t group_len, const RedliteStreamId* ids, size_t ids_len);
+    int redlite_vadd_len(RedliteDb* db, const char* key, size_t key_len, const float* values, size_t dim, const char* element, size_t element_len, const char* attributes, size_t attributes_len);
+    int64_t redlite_vsim_len(RedliteDb* db, const char* key, size_t key_len, const float* query, size_t dim, size_t count, int64_t nprobe, RedliteStringArray* elements_out, double* scores_out);
+    int64_t redlite_vindex_len(RedliteDb* db, const char* key, size_t key_len, size_t nlist);
+    int redlite_vindex_drop_len(RedliteDb* db, const char* key, size_t key_len);
+    int64_t redlite_zinterstore(RedliteDb* db, const char* destination, const char* const* keys, size_t keys_len,
+                                const double* weights, size_t weights_len, const char* aggregate);
+    int64_t redlite_zunionstore(RedliteDb* db, const char* destination, const char* const* keys, size_t keys_len,
+                                const double* weights, size_t weights_len, const char* aggregate);
+    void redlite_free_zmember_array(RedliteZMemberArray arr);
+
+    // Search
+    struct RedliteFtSchemaField {
+        const char* name;
+        size_t name_len;
+        int field_type;
+        int sortable;
+        double weight;
+    };
+    struct RedliteFtField {
+        const uint8_t* name;
+        size_t name_len;
+        const uint8_t* value;
+        size_t value_len;
+    };
+    struct RedliteFtHit {
+        const uint8_t* key;
+        size_t key_len;
+        double score;
+        const RedliteFtField* fields;
+        size_t fields_len;
+    };
+    struct RedliteFtHitArray {
+        int64_t total;
+        RedliteFtHit* hits;
+        size_t len;
+        RedliteFtField* fields;
+        size_t fields_len;
+        uint8_t* data;
+        size_t data_len;
+    };
+    struct RedliteFtSearchOptions {
+        int64_t offset;
+        int64_t num;
+        int nocontent;
+        int verbatim;
+        int withscores;
+        const RedliteBytes* return_fields;
+        size_t return_fields_len;
+        const char* sortby;
+        size_t sortby_len;
+        int sortby_desc;
+    };
+    int redlite_ft_create_schema(RedliteDb* db, const char* index, size_t index_len, int on_json,
+                                 const RedliteBytes* prefixes, size_t prefixes_len,
+                                 const RedliteFtSchemaField* fields, size_t fields_len);
+    int64_t redlite_ft_dropindex(RedliteDb* db, const char* index_name, int delete_docs);
+    int64_t redlite_ft_search(RedliteDb* db, const char* index, const char* query);
+    RedliteFtHitArray redlite_ft_search_hits(RedliteDb* db, const char* index, size_t index_len,
+                                             const char* query, size_t query_len,
+                                             const RedliteFtSearchOptions* options);
+    void redlite_free_ft_hit_array(RedliteFtHitArray arr);
+
+    // Geo
+    struct RedliteGeoMember {
+        char* member;
+        double longitude;
+        double latitude;
+        double dist;
+    };
+    struct RedliteGeoPos {
+        double longitude;
+        double latitude;
+        int exists;
+    };
+    struct RedliteGeoPosArray {
+        RedliteGeoPos* positions;
+        size_t len;
+    };
+    struct RedliteGeoSearchOptions {
+        const char* from_member;
+        size_t from_member_len;
+        double from_lon;
+        double from_lat;
+        double radius;
+        double width;
+        double height;
+        int unit;
+        int64_t count;
+        int any;
+        int desc;
+    };
+    struct RedliteGeoHit {
+        const uint8_t* member;
+        size_t member_len;
+        double longitude;
+        double latitude;
+        double dist;
+    };
+    struct RedliteGeoHitArray {
+        RedliteGeoHit* hits;
+        size_t len;
+        uint8_t* data;
+        size_t data_len;
+    };
+    int64_t redlite_geoadd(RedliteDb* db, const char* key, const RedliteGeoMember* members, size_t members_len,
+                           int nx, int xx, int ch);
+    RedliteGeoPosArray redlite_geopos(RedliteDb* db, const char* key, const char* const* members, size_t members_len);
+    double redlite_geodist(RedliteDb* db, const char* key, const char* member1, const char* member2, int unit);
+    RedliteStringArray redlite_geohash(RedliteDb* db, const char* key, const char* const* members, size_t members_len);
+    RedliteGeoHitArray redlite_geosearch_hits(RedliteDb* db, const char* key, size_t key_len,
+                                              const RedliteGeoSearchOptions* options);
+    int64_t redlite_geosearchstore(RedliteDb* db, const char* dest, const char* src, const char* from_member,
+                                   double from_lon, double from_lat, double radius, int unit, int64_t count,
+                                   int store_dist);
+    int64_t redlite_geoadd_len(RedliteDb* db, const char* key, size_t key_len, const RedliteGeoMember* members,
+                               size_t members_len, int nx, int xx, int ch);
+    RedliteGeoPosArray redlite_geopos_len(RedliteDb* db, const char* key, size_t key_len, const RedliteBytes* members,
+                                          size_t members_len);
+    double redlite_geodist_len(RedliteDb* db, const char* key, size_t key_len, const char* member1, size_t member1_len,
+                               const char* member2, size_t member2_len, int unit);
+    RedliteStringArray redlite_geohash_len(RedliteDb* db, const char* key, size_t key_len, const RedliteBytes* members,
+                                           size_t members_len);
+    int64_t redlite_geosearchstore_len(RedliteDb* db, const char* dest, size_t dest_len, const char* src, size_t src_len,
+                                       const char* from_member, size_t from_member_len, double from_lon,
+                                       double from_lat, double radius, int unit, int64_t count, int store_dist);
+    void redlite_free_geo_pos_array(RedliteGeoPosArray arr);
+    void redlite_free_geo_hit_array(RedliteGeoHitArray arr);
+
+    // Transactions
+    int redlite_begin(RedliteDb* db);
+    int redlite_commit(RedliteDb* db);
+    int redlite_rollback(RedliteDb* db);
+    int redlite_in_transaction(RedliteDb* db);
+
+    // Bulk load
+    int redlite_bulk_begin(RedliteDb* db, int defer_indexes);
+    int64_t redlite_bulk_load(RedliteDb* db, const RedliteBulkRecord* records, size_t records_len, int defer_fts);
+    int redlite_bulk_finish(RedliteDb* db, int reindex_fts);
+
+    // Snapshots
+    struct RedliteSnapshotStats {
+        uint64_t keys;
+        uint64_t items;
+        uint64_t bytes;
+    };
+    int redlite_export_snapshot(RedliteDb* db, const char* path, RedliteSnapshotStats* out);
+    int redlite_import_snapshot(RedliteDb* db, const char* path, RedliteSnapshotStats* out);
+
+    // Pipeline
+    struct RedliteCommand {
+        const uint8_t* const* argv;
+        const size_t* argv_len;
+        size_t argc;
+    };
+    struct RedliteReply {
+        int kind;
+        int64_t integer;
+        double number;
+        RedliteBytes value;
+    };
+    struct RedliteReplyArray {
+        RedliteReply* replies;
+        size_t len;
+    };
+    RedliteReplyArray redlite_pipeline_exec(RedliteDb* db, const RedliteCommand* cmds, size_t cmds_len);
+    void redlite_free_reply_array(RedliteReplyArray arr);
 }
 
 namespace redlite {
@@ -199,6 +664,76 @@ public:
     }
 };
 
+/**
+ * SQLite PRAGMA synchronous level
+ */
+enum class Synchronous : int { Off = 0, Normal = 1, Full = 2, Extra = 3 };
+
+/**
+ * Which keys to evict once max_memory / max_disk is exceeded (Redis maxmemory-policy).
+ * LRU and LFU pick the worst of a few sampled keys; Volatile* only consider keys with a TTL.
+ */
+enum class EvictionPolicy : int {
+    NoEviction = 0,  // max_disk drops the oldest keys; max_memory is not enforced
+    AllKeysLRU = 1,
+    AllKeysLFU = 2,
+    AllKeysRandom = 3,
+    VolatileLRU = 4,
+    VolatileLFU = 5,
+    VolatileTTL = 6,
+    VolatileRandom = 7,
+};
+
+/**
+ * Database open options; unset fields keep the default shown in parentheses
+ */
+struct OpenOptions {
+    std::optional<int64_t> cache_mb;            // Page cache size in MB (64)
+    std::optional<int64_t> mmap_size;           // Memory-mapped I/O bytes, 0 disables (256 MB)
+    std::optional<Synchronous> synchronous;     // Commit durability (Normal)
+    std::optional<uint32_t> page_size;          // New databases only (4096)
+    std::optional<int64_t> wal_autocheckpoint;  // WAL pages per automatic checkpoint, 0 disables (1000)
+    std::optional<bool> temp_store_memory;      // Temp tables in memory (true)
+    std::optional<int64_t> busy_timeout_ms;     // Lock wait for other connections (5000)
+    std::optional<size_t> statement_cache;      // Prepared statements kept per connection (256)
+    std::optional<bool> incremental_vacuum;     // New files use auto_vacuum = INCREMENTAL (false)
+    std::optional<uint64_t> max_memory;         // Memory budget in bytes, 0 = unlimited (0)
+    std::optional<uint64_t> max_disk;           // Budget for pages in use in bytes, 0 = unlimited (0)
+    std::optional<EvictionPolicy> eviction_policy;  // What to evict over budget (NoEviction)
+};
+
+/**
+ * Builder for database open options
+ *
+ *   auto db = Database::open("big.db", OpenOptionsBuilder()
+ *       .mmap_size(32LL << 30)
+ *       .synchronous(Synchronous::Full)
+ *       .build());
+ */
+class OpenOptionsBuilder {
+public:
+    OpenOptionsBuilder& cache_mb(int64_t mb) { opts_.cache_mb = mb; return *this; }
+    OpenOptionsBuilder& mmap_size(int64_t bytes) { opts_.mmap_size = bytes; return *this; }
+    OpenOptionsBuilder& synchronous(Synchronous level) { opts_.synchronous = level; return *this; }
+    OpenOptionsBuilder& page_size(uint32_t bytes) { opts_.page_size = bytes; return *this; }
+    OpenOptionsBuilder& wal_autocheckpoint(int64_t pages) { opts_.wal_autocheckpoint = pages; return *this; }
+    OpenOptionsBuilder& temp_store_memory(bool enabled) { opts_.temp_store_memory = enabled; return *this; }
+    OpenOptionsBuilder& busy_timeout_ms(int64_t ms) { opts_.busy_timeout_ms = ms; return *this; }
+    OpenOptionsBuilder& statement_cache(size_t capacity) { opts_.statement_cache = capacity; return *this; }
+    OpenOptionsBuilder& incremental_vacuum(bool enabled) { opts_.incremental_vacuum = enabled; return *this; }
+    OpenOptionsBuilder& max_memory(uint64_t bytes) { opts_.max_memory = bytes; return *this; }
+    OpenOptionsBuilder& max_disk(uint64_t bytes) { opts_.max_disk = bytes; return *this; }
+    OpenOptionsBuilder& eviction_policy(EvictionPolicy policy) { opts_.eviction_policy = policy; return *this; }
+    OpenOptions build() const { return opts_; }
+private:
+    OpenOptions opts_;
+};
+
+/**
+ * BITOP operation
+ */
+enum class BitOp { And, Or, Xor, Not };
+
 /**
  * SET command options
  */
@@ -243,6 +778,82 @@ struct KeyInfo {
     int64_t updated_at;
 };
 
+/**
+ * Key version stamp returned by key_version(); changes on every write
+ */
+struct KeyVersion {
+    uint64_t version;
+    int64_t created_at;
+
+    bool operator==(const KeyVersion& o) const { return version == o.version && created_at == o.created_at; }
+    bool operator!=(const KeyVersion& o) const { return !(*this == o); }
+};
+
+/**
+ * Connection counters returned by stats()
+ *
+ * Page cache and statement counters are cumulative since open. Cache misses
+ * are pages read from the file, so compare them with lock_wait_ns to tell
+ * I/O apart from threads of this process waiting on each other.
+ */
+struct DatabaseStats : RedliteStats {
+    double cache_hit_rate() const {
+        uint64_t total = cache_hits + cache_misses;
+        return total ? static_cast<double>(cache_hits) / total : 0.0;
+    }
+
+    // Statement executions that reused a cached statement
+    uint64_t statement_reuses() const {
+        return statement_runs > statements ? statement_runs - statements : 0;
+    }
+
+    /**
+     * Prometheus text exposition format (version 0.0.4)
+     */
+    std::string to_prometheus() const {
+        std::string out;
+        auto metric = [&](const char* name, const char* type, const char* help, std::string value) {
+            out += std::string("# HELP ") + name + ' ' + help + '\n';
+            out += std::string("# TYPE ") + name + ' ' + type + '\n';
+            out += std::string(name) + ' ' + value + '\n';
+        };
+        auto seconds = [](uint64_t n, double scale) {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.9f", n * scale);
+            return std::string(buf);
+        };
+        metric("redlite_sqlite_cache_hits_total", "counter", "Page cache hits", std::to_string(cache_hits));
+        metric("redlite_sqlite_cache_misses_total", "counter", "Pages read from the database file", std::to_string(cache_misses));
+        metric("redlite_sqlite_cache_writes_total", "counter", "Pages written", std::to_string(cache_writes));
+        metric("redlite_sqlite_cache_spills_total", "counter", "Dirty pages spilled before commit", std::to_string(cache_spills));
+        metric("redlite_sqlite_cache_bytes", "gauge", "Page cache memory", std::to_string(cache_bytes));
+        metric("redlite_sqlite_statements", "gauge", "Live prepared statements", std::to_string(statements));
+        metric("redlite_sqlite_statement_bytes", "gauge", "Prepared statement memory", std::to_string(statement_bytes));
+        metric("redlite_sqlite_statement_reuses_total", "counter", "Executions of cached statements", std::to_string(statement_reuses()));
+        metric("redlite_sqlite_checkpoints_total", "counter", "Explicit WAL checkpoints", std::to_string(checkpoints));
+        metric("redlite_sqlite_checkpoint_seconds_total", "counter", "Time spent in WAL checkpoints", seconds(checkpoint_total_us, 1e-6));
+        metric("redlite_sqlite_checkpoint_max_seconds", "gauge", "Longest WAL checkpoint", seconds(checkpoint_max_us, 1e-6));
+        metric("redlite_lock_waits_total", "counter", "Calls that waited for the handle lock", std::to_string(lock_waits));
+        metric("redlite_lock_wait_seconds_total", "counter", "Time spent waiting for the handle lock", seconds(lock_wait_ns, 1e-9));
+        return out;
+    }
+};
+
+/**
+ * Result of one maintenance slice (Database::maintenance_step)
+ */
+struct MaintenanceStep : RedliteMaintenanceStep {};
+
+/**
+ * Cumulative maintenance counters (Database::maintenance_stats)
+ */
+struct MaintenanceStats : RedliteMaintenanceStats {};
+
+/**
+ * Result of Database::export_snapshot / Database::import_snapshot
+ */
+struct SnapshotStats : RedliteSnapshotStats {};
+
 /**
  * JSON SET options
  */
@@ -257,7 +868,7 @@ struct JsonSetOptions {
 class Bytes {
 public:
     Bytes() : data_{nullptr, 0} {}
-    explicit Bytes(RedliteBytes b) : data_(b) {}
+    explicit Bytes(RedliteBytes b) : data_(b) { REDLITE_BYTES_OUT(b.len); }
     ~Bytes() { if (data_.data) redlite_free_bytes(data_); }
 
     // Move only
@@ -289,832 +900,3524 @@ public:
         return std::vector<uint8_t>(data_.data, data_.data + data_.len);
     }
 
+    /**
+     * Borrowed view over the FFI-owned buffer (valid while this Bytes lives)
+     */
+    std::string_view view() const {
+        if (empty()) return {};
+        return std::string_view(reinterpret_cast<const char*>(data_.data), data_.len);
+    }
+
 private:
     RedliteBytes data_;
 };
 
 /**
- * Main database class - RAII managed
+ * Value encoding for the typed get<T>/set<T>/hget<T>/hset<T>
+ *
+ * encode(value, write) calls write(std::string_view) once with the encoded
+ * bytes and returns its result; write passes them straight to the FFI call.
+ * decode(bytes) builds a T from a view of the FFI-owned result buffer.
+ * Built in:
+ *  - integers and floating point as decimal text, so INCR/INCRBYFLOAT work
+ *    on the same keys; encoded into a stack buffer;
+ *  - other trivially copyable types as their raw bytes, written with no copy
+ *    (the layout must match between writer and reader);
+ *  - std::string and std::vector<uint8_t> as-is.
+ * Specialize Codec<YourType> for anything else:
+ *
+ *     template <> struct redlite::Codec<Point> {
+ *         template <typename Write>
+ *         static auto encode(const Point& p, Write&& write) { return write(to_wire(p)); }
+ *         static Point decode(std::string_view bytes) { return from_wire(bytes); }
+ *     };
  */
-class Database {
-public:
-    /**
-     * Open a database at the given path
-     * @throws Error if open fails
-     */
-    explicit Database(const std::string& path) {
-        db_ = redlite_open(path.c_str());
-        if (!db_) throw Error::from_last_error();
-    }
+template <typename T, typename = void>
+struct Codec;
 
-    /**
-     * Open an in-memory database
-     */
-    static Database open_memory() {
-        RedliteDb* db = redlite_open_memory();
-        if (!db) throw Error::from_last_error();
-        return Database(db);
-    }
+namespace detail {
 
-    /**
-     * Open a database with custom cache size
-     */
-    static Database open_with_cache(const std::string& path, int64_t cache_mb) {
-        RedliteDb* db = redlite_open_with_cache(path.c_str(), cache_mb);
-        if (!db) throw Error::from_last_error();
-        return Database(db);
-    }
+template <typename T>
+using enable_if_not_string = std::enable_if_t<!std::is_convertible_v<const T&, std::string_view>, int>;
 
-    ~Database() {
-        if (db_) redlite_close(db_);
-    }
+[[noreturn]] inline void codec_error(const char* what, std::string_view bytes) {
+    throw Error(std::string("Codec: cannot decode ") + what + " from " + std::to_string(bytes.size()) + " bytes");
+}
 
-    // Move only
-    Database(Database&& other) noexcept : db_(other.db_) { other.db_ = nullptr; }
-    Database& operator=(Database&& other) noexcept {
-        if (this != &other) {
-            if (db_) redlite_close(db_);
-            db_ = other.db_;
-            other.db_ = nullptr;
+} // namespace detail
+
+template <typename T>
+struct Codec<T, std::enable_if_t<std::is_integral_v<T>>> {
+    template <typename Write>
+    static auto encode(T value, Write&& write) {
+        char buf[24];
+        if constexpr (std::is_same_v<T, bool>) {
+            buf[0] = value ? '1' : '0';
+            return write(std::string_view(buf, 1));
+        } else {
+            auto res = std::to_chars(buf, buf + sizeof(buf), value);
+            return write(std::string_view(buf, static_cast<size_t>(res.ptr - buf)));
         }
-        return *this;
     }
-    Database(const Database&) = delete;
-    Database& operator=(const Database&) = delete;
 
-    // ==================== String Commands ====================
-
-    /**
-     * GET key
-     * @return Value or empty optional if key doesn't exist
-     */
-    std::optional<std::string> get(std::string_view key) {
-        RedliteBytes result = redlite_get(db_, std::string(key).c_str());
-        if (!result.data) return std::nullopt;
-        Bytes b(result);
-        return b.to_string();
+    static T decode(std::string_view bytes) {
+        if constexpr (std::is_same_v<T, bool>) {
+            if (bytes == "1") return true;
+            if (bytes == "0") return false;
+            detail::codec_error("bool", bytes);
+        } else {
+            T value{};
+            auto res = std::from_chars(bytes.data(), bytes.data() + bytes.size(), value);
+            if (res.ec != std::errc() || res.ptr != bytes.data() + bytes.size()) {
+                detail::codec_error("integer", bytes);
+            }
+            return value;
+        }
     }
+};
 
-    /**
-     * GET key (raw bytes)
-     */
-    std::optional<std::vector<uint8_t>> get_bytes(std::string_view key) {
-        RedliteBytes result = redlite_get(db_, std::string(key).c_str());
-        if (!result.data) return std::nullopt;
-        Bytes b(result);
-        return b.to_vector();
+template <typename T>
+struct Codec<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    template <typename Write>
+    static auto encode(T value, Write&& write) {
+        char buf[64];
+#ifdef REDLITE_HAS_FLOAT_CHARCONV
+        auto res = std::to_chars(buf, buf + sizeof(buf), value);
+        return write(std::string_view(buf, static_cast<size_t>(res.ptr - buf)));
+#else
+        double v = static_cast<double>(value);
+        int n = std::snprintf(buf, sizeof(buf), "%.15g", v);
+        if (std::strtod(buf, nullptr) != v) n = std::snprintf(buf, sizeof(buf), "%.17g", v);
+        return write(std::string_view(buf, static_cast<size_t>(n)));
+#endif
     }
 
-    /**
-     * SET key value [TTL seconds]
-     * @return true on success
-     */
-    bool set(std::string_view key, std::string_view value, int64_t ttl_seconds = 0) {
-        return redlite_set(db_, std::string(key).c_str(),
-                          reinterpret_cast<const uint8_t*>(value.data()),
-                          value.size(), ttl_seconds) == 0;
+    static T decode(std::string_view bytes) {
+        T value{};
+#ifdef REDLITE_HAS_FLOAT_CHARCONV
+        auto res = std::from_chars(bytes.data(), bytes.data() + bytes.size(), value);
+        if (res.ec != std::errc() || res.ptr != bytes.data() + bytes.size()) {
+            detail::codec_error("number", bytes);
+        }
+#else
+        // strtod needs a terminated string
+        char buf[64];
+        if (bytes.empty() || bytes.size() >= sizeof(buf)) detail::codec_error("number", bytes);
+        std::memcpy(buf, bytes.data(), bytes.size());
+        buf[bytes.size()] = '\0';
+        char* end = nullptr;
+        value = static_cast<T>(std::strtod(buf, &end));
+        if (end != buf + bytes.size()) detail::codec_error("number", bytes);
+#endif
+        return value;
     }
+};
 
-    /**
-     * SET key value with options
-     */
-    bool set(std::string_view key, std::string_view value, const SetOptions& opts) {
-        // Handle NX/XX options via the simpler set
-        // Note: Full NX/XX support would need FFI extension
-        int64_t ttl = 0;
-        if (opts.ex) ttl = *opts.ex;
-        else if (opts.px) ttl = *opts.px / 1000; // Convert ms to seconds
-        return set(key, value, ttl);
+template <typename T>
+struct Codec<T, std::enable_if_t<std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> &&
+                                 !std::is_arithmetic_v<T> && !std::is_pointer_v<T>>> {
+    template <typename Write>
+    static auto encode(const T& value, Write&& write) {
+        return write(std::string_view(reinterpret_cast<const char*>(&value), sizeof(T)));
     }
 
-    /**
-     * SETEX key seconds value
-     */
-    bool setex(std::string_view key, int64_t seconds, std::string_view value) {
-        return redlite_setex(db_, std::string(key).c_str(), seconds,
-                            reinterpret_cast<const uint8_t*>(value.data()),
-                            value.size()) == 0;
+    static T decode(std::string_view bytes) {
+        if (bytes.size() != sizeof(T)) detail::codec_error("fixed-size value", bytes);
+        T value;
+        std::memcpy(&value, bytes.data(), sizeof(T));
+        return value;
     }
+};
 
-    /**
-     * PSETEX key milliseconds value
-     */
-    bool psetex(std::string_view key, int64_t milliseconds, std::string_view value) {
-        return redlite_psetex(db_, std::string(key).c_str(), milliseconds,
-                             reinterpret_cast<const uint8_t*>(value.data()),
-                             value.size()) == 0;
-    }
+template <>
+struct Codec<std::string> {
+    template <typename Write>
+    static auto encode(const std::string& value, Write&& write) { return write(std::string_view(value)); }
+    static std::string decode(std::string_view bytes) { return std::string(bytes); }
+};
 
-    /**
-     * GETDEL key - Get and delete
-     */
-    std::optional<std::string> getdel(std::string_view key) {
-        RedliteBytes result = redlite_getdel(db_, std::string(key).c_str());
-        if (!result.data) return std::nullopt;
-        Bytes b(result);
-        return b.to_string();
+template <>
+struct Codec<std::vector<uint8_t>> {
+    template <typename Write>
+    static auto encode(const std::vector<uint8_t>& value, Write&& write) {
+        return write(std::string_view(reinterpret_cast<const char*>(value.data()), value.size()));
     }
-
-    /**
-     * APPEND key value
-     * @return New length of string
-     */
-    int64_t append(std::string_view key, std::string_view value) {
-        return redlite_append(db_, std::string(key).c_str(),
-                             reinterpret_cast<const uint8_t*>(value.data()),
-                             value.size());
+    static std::vector<uint8_t> decode(std::string_view bytes) {
+        auto first = reinterpret_cast<const uint8_t*>(bytes.data());
+        return std::vector<uint8_t>(first, first + bytes.size());
     }
+};
 
-    /**
-     * STRLEN key
-     */
-    int64_t strlen(std::string_view key) {
-        return redlite_strlen(db_, std::string(key).c_str());
-    }
+/**
+ * RAII wrapper for bytes array result - auto-frees on destruction
+ *
+ * Elements are exposed as std::string_view over the FFI-owned buffers.
+ * Views are valid for the lifetime of the BytesArray.
+ */
+class BytesArray {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        iterator() : item_(nullptr) {}
+        explicit iterator(const RedliteBytes* item) : item_(item) {}
+
+        std::string_view operator*() const { return BytesArray::to_view(*item_); }
+        std::string_view operator[](difference_type n) const { return BytesArray::to_view(item_[n]); }
+
+        iterator& operator++() { ++item_; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++item_; return tmp; }
+        iterator& operator--() { --item_; return *this; }
+        iterator operator--(int) { iterator tmp = *this; --item_; return tmp; }
+        iterator& operator+=(difference_type n) { item_ += n; return *this; }
+        iterator& operator-=(difference_type n) { item_ -= n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(item_ + n); }
+        iterator operator-(difference_type n) const { return iterator(item_ - n); }
+        difference_type operator-(const iterator& other) const { return item_ - other.item_; }
+
+        bool operator==(const iterator& other) const { return item_ == other.item_; }
+        bool operator!=(const iterator& other) const { return item_ != other.item_; }
+        bool operator<(const iterator& other) const { return item_ < other.item_; }
+
+    private:
+        const RedliteBytes* item_;
+    };
 
-    /**
-     * GETRANGE key start end
-     */
-    std::string getrange(std::string_view key, int64_t start, int64_t end) {
-        RedliteBytes result = redlite_getrange(db_, std::string(key).c_str(), start, end);
-        if (!result.data) return {};
-        Bytes b(result);
-        return b.to_string();
+    BytesArray() : arr_{nullptr, 0} {}
+    explicit BytesArray(RedliteBytesArray arr) : arr_(arr) {
+#ifdef REDLITE_ENABLE_METRICS
+        uint64_t bytes = 0;
+        for (size_t i = 0; i < size(); ++i) bytes += arr_.items[i].len;
+        REDLITE_BYTES_OUT(bytes);
+#endif
     }
+    ~BytesArray() { if (arr_.items) redlite_free_bytes_array(arr_); }
 
-    /**
-     * SETRANGE key offset value
-     * @return New length of string
-     */
-    int64_t setrange(std::string_view key, int64_t offset, std::string_view value) {
-        return redlite_setrange(db_, std::string(key).c_str(), offset,
-                               reinterpret_cast<const uint8_t*>(value.data()),
-                               value.size());
+    // Move only
+    BytesArray(BytesArray&& other) noexcept : arr_(other.arr_) { other.arr_ = {nullptr, 0}; }
+    BytesArray& operator=(BytesArray&& other) noexcept {
+        if (this != &other) {
+            if (arr_.items) redlite_free_bytes_array(arr_);
+            arr_ = other.arr_;
+            other.arr_ = {nullptr, 0};
+        }
+        return *this;
     }
+    BytesArray(const BytesArray&) = delete;
+    BytesArray& operator=(const BytesArray&) = delete;
 
-    /**
-     * INCR key
-     */
-    int64_t incr(std::string_view key) {
-        return redlite_incr(db_, std::string(key).c_str());
-    }
+    size_t size() const { return arr_.items ? arr_.len : 0; }
+    bool empty() const { return size() == 0; }
 
-    /**
-     * DECR key
-     */
-    int64_t decr(std::string_view key) {
-        return redlite_decr(db_, std::string(key).c_str());
+    std::string_view operator[](size_t i) const { return to_view(arr_.items[i]); }
+
+    std::string_view at(size_t i) const {
+        if (i >= size()) throw std::out_of_range("BytesArray index out of range");
+        return to_view(arr_.items[i]);
     }
 
     /**
-     * INCRBY key increment
+     * Whether element i is a nil reply (e.g. missing key in MGET)
      */
-    int64_t incrby(std::string_view key, int64_t increment) {
-        return redlite_incrby(db_, std::string(key).c_str(), increment);
+    bool is_nil(size_t i) const { return arr_.items[i].data == nullptr; }
+
+    iterator begin() const { return iterator(arr_.items); }
+    iterator end() const { return iterator(arr_.items + size()); }
+
+    std::vector<std::string> to_vector() const {
+        std::vector<std::string> result;
+        result.reserve(size());
+        for (auto v : *this) result.emplace_back(v);
+        return result;
+    }
+
+private:
+    static std::string_view to_view(const RedliteBytes& b) {
+        if (!b.data) return {};
+        return std::string_view(reinterpret_cast<const char*>(b.data), b.len);
+    }
+
+    RedliteBytesArray arr_;
+};
+
+#ifdef REDLITE_HAS_PMR
+/**
+ * Result list decoded into a caller-supplied memory resource
+ */
+using StringList = std::pmr::vector<std::pmr::string>;
+
+/**
+ * Reusable arena for decoding array results without per-element mallocs
+ *
+ * Pass it wherever a std::pmr::memory_resource* is accepted. Everything
+ * decoded into the arena is released at once by reset(), which keeps the
+ * initial buffer for the next request. Results must not outlive reset().
+ *
+ *   ResultArena arena;
+ *   auto items = db.lrange("list", 0, -1, arena);
+ *   ...
+ *   arena.reset();
+ */
+class ResultArena {
+public:
+    explicit ResultArena(size_t initial_bytes = 64 * 1024)
+        : buffer_(initial_bytes ? initial_bytes : 1), resource_(buffer_.data(), buffer_.size()) {}
+
+    ResultArena(const ResultArena&) = delete;
+    ResultArena& operator=(const ResultArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &resource_; }
+    operator std::pmr::memory_resource*() { return &resource_; }
+
+    /**
+     * Release everything allocated since the last reset
+     */
+    void reset() { resource_.release(); }
+
+private:
+    std::vector<std::byte> buffer_;
+    std::pmr::monotonic_buffer_resource resource_;
+};
+#endif
+
+/**
+ * Sorted set member borrowed from a ZSCAN page or a ZRangeResult
+ */
+struct ZMemberView {
+    std::string_view member;
+    double score;
+};
+
+/**
+ * RAII wrapper for scored range results - auto-frees on destruction
+ *
+ * Scores arrive as doubles and members as views into one packed FFI buffer,
+ * so nothing is formatted, parsed or copied per member. Views are valid for
+ * the lifetime of the ZRangeResult.
+ */
+class ZRangeResult {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = ZMemberView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const ZMemberView*;
+        using reference = ZMemberView;
+
+        iterator() : item_(nullptr) {}
+        explicit iterator(const RedliteZMember* item) : item_(item) {}
+
+        ZMemberView operator*() const { return ZRangeResult::to_view(*item_); }
+        ZMemberView operator[](difference_type n) const { return ZRangeResult::to_view(item_[n]); }
+
+        iterator& operator++() { ++item_; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++item_; return tmp; }
+        iterator& operator--() { --item_; return *this; }
+        iterator operator--(int) { iterator tmp = *this; --item_; return tmp; }
+        iterator& operator+=(difference_type n) { item_ += n; return *this; }
+        iterator& operator-=(difference_type n) { item_ -= n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(item_ + n); }
+        iterator operator-(difference_type n) const { return iterator(item_ - n); }
+        difference_type operator-(const iterator& other) const { return item_ - other.item_; }
+
+        bool operator==(const iterator& other) const { return item_ == other.item_; }
+        bool operator!=(const iterator& other) const { return item_ != other.item_; }
+        bool operator<(const iterator& other) const { return item_ < other.item_; }
+
+    private:
+        const RedliteZMember* item_;
+    };
+
+    ZRangeResult() : arr_{nullptr, 0, nullptr, 0} {}
+    explicit ZRangeResult(RedliteZMemberArray arr) : arr_(arr) {
+        REDLITE_BYTES_OUT(arr.data_len + arr.len * sizeof(double));
+    }
+    ~ZRangeResult() { redlite_free_zmember_array(arr_); }
+
+    // Move only
+    ZRangeResult(ZRangeResult&& other) noexcept : arr_(other.arr_) {
+        other.arr_ = {nullptr, 0, nullptr, 0};
+    }
+    ZRangeResult& operator=(ZRangeResult&& other) noexcept {
+        if (this != &other) {
+            redlite_free_zmember_array(arr_);
+            arr_ = other.arr_;
+            other.arr_ = {nullptr, 0, nullptr, 0};
+        }
+        return *this;
+    }
+    ZRangeResult(const ZRangeResult&) = delete;
+    ZRangeResult& operator=(const ZRangeResult&) = delete;
+
+    size_t size() const { return arr_.members ? arr_.len : 0; }
+    bool empty() const { return size() == 0; }
+
+    ZMemberView operator[](size_t i) const { return to_view(arr_.members[i]); }
+
+    ZMemberView at(size_t i) const {
+        if (i >= size()) throw std::out_of_range("ZRangeResult index out of range");
+        return to_view(arr_.members[i]);
+    }
+
+    iterator begin() const { return iterator(arr_.members); }
+    iterator end() const { return iterator(arr_.members + size()); }
+
+    std::vector<ZMember> to_vector() const {
+        std::vector<ZMember> result;
+        result.reserve(size());
+        for (auto m : *this) result.emplace_back(m.score, m.member);
+        return result;
+    }
+
+    std::vector<std::string> members() const {
+        std::vector<std::string> result;
+        result.reserve(size());
+        for (auto m : *this) result.emplace_back(m.member);
+        return result;
+    }
+
+private:
+    static ZMemberView to_view(const RedliteZMember& m) {
+        if (!m.member) return {std::string_view(), m.score};
+        return {std::string_view(reinterpret_cast<const char*>(m.member), m.member_len), m.score};
+    }
+
+    RedliteZMemberArray arr_;
+};
+
+/**
+ * Distance units for GEO commands
+ */
+enum class GeoUnit : int { Meters = 0, Kilometers = 1, Feet = 2, Miles = 3 };
+
+/**
+ * Point for GEOADD
+ */
+struct GeoMember {
+    double longitude;
+    double latitude;
+    std::string member;
+};
+
+/**
+ * GEOADD options
+ */
+struct GeoAddOptions {
+    bool nx = false;  // Only add new members
+    bool xx = false;  // Only update existing members
+    bool ch = false;  // Count changed members too
+};
+
+/**
+ * Longitude/latitude pair from GEOPOS
+ */
+struct GeoPos {
+    double longitude;
+    double latitude;
+};
+
+/**
+ * GEOSEARCH options
+ *
+ * Searches around `from_member` if set, else around from_lon/from_lat;
+ * BYRADIUS when radius > 0, else BYBOX width x height. Results are nearest
+ * first unless `desc`.
+ */
+struct GeoSearchOptions {
+    std::optional<std::string> from_member;
+    double from_lon = 0.0;
+    double from_lat = 0.0;
+    double radius = 0.0;
+    double width = 0.0;
+    double height = 0.0;
+    GeoUnit unit = GeoUnit::Meters;
+    int64_t count = 0;     // 0 = no limit
+    bool any = false;      // With count: stop at the first `count` matches
+    bool desc = false;
+};
+
+/**
+ * GEOSEARCH match borrowed from GeoHits; distance is in the search's unit
+ */
+struct GeoHitView {
+    std::string_view member;
+    double longitude;
+    double latitude;
+    double distance;
+};
+
+/**
+ * RAII wrapper for GEOSEARCH results - auto-frees on destruction
+ *
+ * Coordinates and distances arrive as doubles and members as views into one
+ * packed FFI buffer, so nothing is allocated per match. Views are valid for
+ * the lifetime of the GeoHits.
+ */
+class GeoHits {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = GeoHitView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const GeoHitView*;
+        using reference = GeoHitView;
+
+        iterator() : item_(nullptr) {}
+        explicit iterator(const RedliteGeoHit* item) : item_(item) {}
+
+        GeoHitView operator*() const { return GeoHits::to_view(*item_); }
+        GeoHitView operator[](difference_type n) const { return GeoHits::to_view(item_[n]); }
+
+        iterator& operator++() { ++item_; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++item_; return tmp; }
+        iterator& operator--() { --item_; return *this; }
+        iterator operator--(int) { iterator tmp = *this; --item_; return tmp; }
+        iterator& operator+=(difference_type n) { item_ += n; return *this; }
+        iterator& operator-=(difference_type n) { item_ -= n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(item_ + n); }
+        iterator operator-(difference_type n) const { return iterator(item_ - n); }
+        difference_type operator-(const iterator& other) const { return item_ - other.item_; }
+
+        bool operator==(const iterator& other) const { return item_ == other.item_; }
+        bool operator!=(const iterator& other) const { return item_ != other.item_; }
+        bool operator<(const iterator& other) const { return item_ < other.item_; }
+
+    private:
+        const RedliteGeoHit* item_;
+    };
+
+    GeoHits() : arr_{nullptr, 0, nullptr, 0} {}
+    explicit GeoHits(RedliteGeoHitArray arr) : arr_(arr) {
+        REDLITE_BYTES_OUT(arr.data_len + arr.len * 3 * sizeof(double));
+    }
+    ~GeoHits() { redlite_free_geo_hit_array(arr_); }
+
+    // Move only
+    GeoHits(GeoHits&& other) noexcept : arr_(other.arr_) { other.arr_ = {nullptr, 0, nullptr, 0}; }
+    GeoHits& operator=(GeoHits&& other) noexcept {
+        if (this != &other) {
+            redlite_free_geo_hit_array(arr_);
+            arr_ = other.arr_;
+            other.arr_ = {nullptr, 0, nullptr, 0};
+        }
+        return *this;
+    }
+    GeoHits(const GeoHits&) = delete;
+    GeoHits& operator=(const GeoHits&) = delete;
+
+    size_t size() const { return arr_.hits ? arr_.len : 0; }
+    bool empty() const { return size() == 0; }
+
+    GeoHitView operator[](size_t i) const { return to_view(arr_.hits[i]); }
+
+    GeoHitView at(size_t i) const {
+        if (i >= size()) throw std::out_of_range("GeoHits index out of range");
+        return to_view(arr_.hits[i]);
+    }
+
+    iterator begin() const { return iterator(arr_.hits); }
+    iterator end() const { return iterator(arr_.hits + size()); }
+
+    std::vector<std::string> members() const {
+        std::vector<std::string> result;
+        result.reserve(size());
+        for (auto h : *this) result.emplace_back(h.member);
+        return result;
+    }
+
+private:
+    static GeoHitView to_view(const RedliteGeoHit& h) {
+        std::string_view member = h.member ? std::string_view(reinterpret_cast<const char*>(h.member), h.member_len)
+                                           : std::string_view();
+        return {member, h.longitude, h.latitude, h.dist};
+    }
+
+    RedliteGeoHitArray arr_;
+};
+
+/**
+ * How much history to keep for a key, database or globally
+ */
+enum class RetentionType : int {
+    Unlimited = 0,
+    Time = 1,   // Entries newer than retention_value ms
+    Count = 2,  // The last retention_value entries
+};
+
+/**
+ * Snapshot of a key at one point in its history
+ */
+struct HistoryEntryView {
+    int64_t timestamp_ms;
+    std::string_view value;      // Empty for writes without a snapshot (DEL, HSET, ...)
+};
+
+/**
+ * RAII wrapper for history entries - auto-frees on destruction
+ *
+ * Values are views into FFI-owned buffers, valid for the lifetime of the
+ * HistoryEntries. Entries are in ascending time order.
+ */
+class HistoryEntries {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = HistoryEntryView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const HistoryEntryView*;
+        using reference = HistoryEntryView;
+
+        iterator() : item_(nullptr) {}
+        explicit iterator(const RedliteHistoryEntry* item) : item_(item) {}
+
+        HistoryEntryView operator*() const { return HistoryEntries::to_view(*item_); }
+        HistoryEntryView operator[](difference_type n) const { return HistoryEntries::to_view(item_[n]); }
+
+        iterator& operator++() { ++item_; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++item_; return tmp; }
+        iterator& operator--() { --item_; return *this; }
+        iterator operator--(int) { iterator tmp = *this; --item_; return tmp; }
+        iterator& operator+=(difference_type n) { item_ += n; return *this; }
+        iterator& operator-=(difference_type n) { item_ -= n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(item_ + n); }
+        iterator operator-(difference_type n) const { return iterator(item_ - n); }
+        difference_type operator-(const iterator& other) const { return item_ - other.item_; }
+
+        bool operator==(const iterator& other) const { return item_ == other.item_; }
+        bool operator!=(const iterator& other) const { return item_ != other.item_; }
+        bool operator<(const iterator& other) const { return item_ < other.item_; }
+
+    private:
+        const RedliteHistoryEntry* item_;
+    };
+
+    HistoryEntries() : arr_{nullptr, 0} {}
+    explicit HistoryEntries(RedliteHistoryEntryArray arr) : arr_(arr) {
+#ifdef REDLITE_ENABLE_METRICS
+        uint64_t bytes = 0;
+        for (size_t i = 0; i < size(); ++i) bytes += arr_.entries[i].value.len;
+        REDLITE_BYTES_OUT(bytes);
+#endif
+    }
+    ~HistoryEntries() { redlite_free_history_entry_array(arr_); }
+
+    // Move only
+    HistoryEntries(HistoryEntries&& other) noexcept : arr_(other.arr_) { other.arr_ = {nullptr, 0}; }
+    HistoryEntries& operator=(HistoryEntries&& other) noexcept {
+        if (this != &other) {
+            redlite_free_history_entry_array(arr_);
+            arr_ = other.arr_;
+            other.arr_ = {nullptr, 0};
+        }
+        return *this;
+    }
+    HistoryEntries(const HistoryEntries&) = delete;
+    HistoryEntries& operator=(const HistoryEntries&) = delete;
+
+    size_t size() const { return arr_.entries ? arr_.len : 0; }
+    bool empty() const { return size() == 0; }
+
+    HistoryEntryView operator[](size_t i) const { return to_view(arr_.entries[i]); }
+
+    HistoryEntryView at(size_t i) const {
+        if (i >= size()) throw std::out_of_range("HistoryEntries index out of range");
+        return to_view(arr_.entries[i]);
+    }
+
+    iterator begin() const { return iterator(arr_.entries); }
+    iterator end() const { return iterator(arr_.entries + size()); }
+
+private:
+    static HistoryEntryView to_view(const RedliteHistoryEntry& e) {
+        if (!e.value.data) return {e.timestamp, std::string_view()};
+        return {e.timestamp, std::string_view(reinterpret_cast<const char*>(e.value.data), e.value.len)};
+    }
+
+    RedliteHistoryEntryArray arr_;
+};
+
+namespace detail {
+
+inline std::string_view bytes_view(const RedliteBytes& b) {
+    if (!b.data) return {};
+    return std::string_view(reinterpret_cast<const char*>(b.data), b.len);
+}
+
+struct KeyScanTraits {
+    using Result = RedliteScanResult;
+    using value_type = std::string_view;
+
+    static Result fetch(RedliteDb* db, const std::string&, const char* cursor, const char* pattern, size_t count) {
+        return redlite_scan(db, cursor, pattern, count);
+    }
+    static size_t size(const Result& r) { return r.keys.strings ? r.keys.len : 0; }
+    static value_type at(const Result& r, size_t i) { return r.keys.strings[i]; }
+    static void free(Result r) { redlite_free_scan_result(r); }
+};
+
+struct HashScanTraits {
+    using Result = RedliteHScanResult;
+    using value_type = std::pair<std::string_view, std::string_view>;
+
+    static Result fetch(RedliteDb* db, const std::string& key, const char* cursor, const char* pattern, size_t count) {
+        return redlite_hscan(db, key.c_str(), cursor, pattern, count);
+    }
+    static size_t size(const Result& r) { return r.pairs.items ? r.pairs.len / 2 : 0; }
+    static value_type at(const Result& r, size_t i) {
+        return {bytes_view(r.pairs.items[2 * i]), bytes_view(r.pairs.items[2 * i + 1])};
+    }
+    static void free(Result r) { redlite_free_hscan_result(r); }
+};
+
+struct SetScanTraits {
+    using Result = RedliteSScanResult;
+    using value_type = std::string_view;
+
+    static Result fetch(RedliteDb* db, const std::string& key, const char* cursor, const char* pattern, size_t count) {
+        return redlite_sscan(db, key.c_str(), cursor, pattern, count);
+    }
+    static size_t size(const Result& r) { return r.members.items ? r.members.len : 0; }
+    static value_type at(const Result& r, size_t i) { return bytes_view(r.members.items[i]); }
+    static void free(Result r) { redlite_free_sscan_result(r); }
+};
+
+struct ZSetScanTraits {
+    using Result = RedliteZScanResult;
+    using value_type = ZMemberView;
+
+    static Result fetch(RedliteDb* db, const std::string& key, const char* cursor, const char* pattern, size_t count) {
+        return redlite_zscan(db, key.c_str(), cursor, pattern, count);
+    }
+    static size_t size(const Result& r) { return r.members ? r.len : 0; }
+    static value_type at(const Result& r, size_t i) {
+        return {bytes_view(r.members[i].member), r.members[i].score};
+    }
+    static void free(Result r) { redlite_free_zscan_result(r); }
+};
+
+} // namespace detail
+
+/**
+ * Lazy cursor-based iteration over SCAN/HSCAN/SSCAN/ZSCAN
+ *
+ * Pages of at most `count` elements are fetched on demand, so memory stays
+ * bounded by the page size instead of the keyspace. Elements are views into
+ * the current page and are invalidated when the iterator moves past it.
+ * The Database must outlive the range.
+ *
+ *   for (auto key : db.scan("user:*", 1000)) { ... }
+ */
+template <typename Traits>
+class ScanRange {
+public:
+    using value_type = typename Traits::value_type;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = typename Traits::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = value_type;
+
+        iterator() : range_(nullptr) {}
+        explicit iterator(ScanRange* range) : range_(range) {}
+
+        value_type operator*() const { return range_->current(); }
+
+        iterator& operator++() { range_->next(); return *this; }
+        void operator++(int) { range_->next(); }
+
+        bool operator==(const iterator& other) const { return at_end() == other.at_end(); }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        bool at_end() const { return !range_ || range_->done_; }
+
+        ScanRange* range_;
+    };
+
+    ScanRange(RedliteDb* db, std::string key, std::string_view pattern, size_t count)
+        : db_(db), key_(std::move(key)), pattern_(pattern), count_(count ? count : 1) {}
+
+    ~ScanRange() { release(); }
+
+    // Move only
+    ScanRange(ScanRange&& other) noexcept
+        : db_(other.db_), key_(std::move(other.key_)), pattern_(std::move(other.pattern_)),
+          count_(other.count_), cursor_(std::move(other.cursor_)), page_(other.page_),
+          has_page_(other.has_page_), pos_(other.pos_), started_(other.started_), done_(other.done_) {
+        other.has_page_ = false;
+    }
+    ScanRange& operator=(ScanRange&&) = delete;
+    ScanRange(const ScanRange&) = delete;
+    ScanRange& operator=(const ScanRange&) = delete;
+
+    /**
+     * Fetch the first page; a range can only be iterated once
+     * @throws Error if the scan fails (e.g. WRONGTYPE)
+     */
+    iterator begin() {
+        if (!started_) {
+            started_ = true;
+            fetch();
+            skip_empty();
+        }
+        return iterator(this);
+    }
+
+    iterator end() { return iterator(); }
+
+private:
+    value_type current() const { return Traits::at(page_, pos_); }
+
+    void next() {
+        ++pos_;
+        skip_empty();
+    }
+
+    // Advance to the next non-empty page, or mark the range done
+    void skip_empty() {
+        while (!done_ && pos_ >= Traits::size(page_)) {
+            if (cursor_ == "0") {
+                done_ = true;
+                release();
+            } else {
+                fetch();
+            }
+        }
+    }
+
+    void fetch() {
+        const char* pattern = (pattern_.empty() || pattern_ == "*") ? nullptr : pattern_.c_str();
+        typename Traits::Result result = Traits::fetch(db_, key_, cursor_.c_str(), pattern, count_);
+        if (!result.cursor) {
+            done_ = true;
+            release();
+            throw Error::from_last_error();
+        }
+        release();
+        page_ = result;
+        has_page_ = true;
+        cursor_ = result.cursor;
+        pos_ = 0;
+    }
+
+    void release() {
+        if (has_page_) Traits::free(page_);
+        has_page_ = false;
+        page_ = typename Traits::Result{};
+    }
+
+    RedliteDb* db_;
+    std::string key_;
+    std::string pattern_;
+    size_t count_;
+    std::string cursor_ = "0";
+    typename Traits::Result page_{};
+    bool has_page_ = false;
+    size_t pos_ = 0;
+    bool started_ = false;
+    bool done_ = false;
+};
+
+using KeyScan = ScanRange<detail::KeyScanTraits>;
+using HashScan = ScanRange<detail::HashScanTraits>;
+using SetScan = ScanRange<detail::SetScanTraits>;
+using ZSetScan = ScanRange<detail::ZSetScanTraits>;
+
+/**
+ * One SCAN page; keys are in ascending order
+ */
+struct ScanPage {
+    std::string cursor;              // "0" once the keyspace is exhausted
+    std::vector<std::string> keys;
+};
+
+/**
+ * FT.CREATE field types
+ */
+enum class FtFieldType { Text = 0, Numeric = 1, Tag = 2 };
+
+/**
+ * One FT.CREATE SCHEMA entry
+ */
+struct FtSchemaField {
+    std::string name;
+    FtFieldType type = FtFieldType::Text;
+    bool sortable = false;
+    double weight = 1.0;              // TEXT only
+};
+
+/**
+ * FT.SEARCH options
+ */
+struct FtSearchOptions {
+    int64_t offset = 0;               // LIMIT offset num
+    int64_t num = 10;
+    bool nocontent = false;
+    bool verbatim = false;
+    bool withscores = false;          // BM25 scores; hits are then ordered by score
+    std::vector<std::string> return_fields;  // Empty = every field
+    std::optional<std::string> sortby;
+    bool sortby_desc = false;
+};
+
+/**
+ * Returned field of a search hit
+ */
+struct FtFieldView {
+    std::string_view name;
+    std::string_view value;
+};
+
+/**
+ * Search hit borrowed from an FtHits page
+ */
+class FtHitView {
+public:
+    explicit FtHitView(const RedliteFtHit& hit) : hit_(&hit) {}
+
+    std::string_view key() const { return view(hit_->key, hit_->key_len); }
+    double score() const { return hit_->score; }
+
+    size_t field_count() const { return hit_->fields ? hit_->fields_len : 0; }
+
+    FtFieldView field(size_t i) const {
+        const RedliteFtField& f = hit_->fields[i];
+        return {view(f.name, f.name_len), view(f.value, f.value_len)};
+    }
+
+    /**
+     * Value of a returned field, or nullopt if the hit doesn't carry it
+     */
+    std::optional<std::string_view> get(std::string_view name) const {
+        for (size_t i = 0; i < field_count(); ++i) {
+            FtFieldView f = field(i);
+            if (f.name == name) return f.value;
+        }
+        return std::nullopt;
+    }
+
+private:
+    static std::string_view view(const uint8_t* data, size_t len) {
+        if (!data) return {};
+        return std::string_view(reinterpret_cast<const char*>(data), len);
+    }
+
+    const RedliteFtHit* hit_;
+};
+
+/**
+ * RAII wrapper for one page of FT.SEARCH hits - auto-frees on destruction
+ *
+ * Keys, field names and values are views into one packed FFI buffer and
+ * are valid for the lifetime of the FtHits.
+ */
+class FtHits {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = FtHitView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const FtHitView*;
+        using reference = FtHitView;
+
+        iterator() : item_(nullptr) {}
+        explicit iterator(const RedliteFtHit* item) : item_(item) {}
+
+        FtHitView operator*() const { return FtHitView(*item_); }
+        FtHitView operator[](difference_type n) const { return FtHitView(item_[n]); }
+
+        iterator& operator++() { ++item_; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++item_; return tmp; }
+        iterator& operator--() { --item_; return *this; }
+        iterator operator--(int) { iterator tmp = *this; --item_; return tmp; }
+        iterator& operator+=(difference_type n) { item_ += n; return *this; }
+        iterator& operator-=(difference_type n) { item_ -= n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(item_ + n); }
+        iterator operator-(difference_type n) const { return iterator(item_ - n); }
+        difference_type operator-(const iterator& other) const { return item_ - other.item_; }
+
+        bool operator==(const iterator& other) const { return item_ == other.item_; }
+        bool operator!=(const iterator& other) const { return item_ != other.item_; }
+        bool operator<(const iterator& other) const { return item_ < other.item_; }
+
+    private:
+        const RedliteFtHit* item_;
+    };
+
+    FtHits() : arr_(no_hits()) {}
+    explicit FtHits(RedliteFtHitArray arr) : arr_(arr) {
+        REDLITE_BYTES_OUT(arr.data_len + arr.len * sizeof(double));
+    }
+    ~FtHits() { redlite_free_ft_hit_array(arr_); }
+
+    // Move only
+    FtHits(FtHits&& other) noexcept : arr_(other.arr_) { other.arr_ = no_hits(); }
+    FtHits& operator=(FtHits&& other) noexcept {
+        if (this != &other) {
+            redlite_free_ft_hit_array(arr_);
+            arr_ = other.arr_;
+            other.arr_ = no_hits();
+        }
+        return *this;
+    }
+    FtHits(const FtHits&) = delete;
+    FtHits& operator=(const FtHits&) = delete;
+
+    /**
+     * Number of matching documents, not just the ones on this page
+     */
+    int64_t total() const { return arr_.total; }
+
+    size_t size() const { return arr_.hits ? arr_.len : 0; }
+    bool empty() const { return size() == 0; }
+
+    FtHitView operator[](size_t i) const { return FtHitView(arr_.hits[i]); }
+
+    FtHitView at(size_t i) const {
+        if (i >= size()) throw std::out_of_range("FtHits index out of range");
+        return FtHitView(arr_.hits[i]);
+    }
+
+    iterator begin() const { return iterator(arr_.hits); }
+    iterator end() const { return iterator(arr_.hits + size()); }
+
+    std::vector<std::string> keys() const {
+        std::vector<std::string> result;
+        result.reserve(size());
+        for (auto hit : *this) result.emplace_back(hit.key());
+        return result;
+    }
+
+private:
+    static RedliteFtHitArray no_hits() { return {0, nullptr, 0, nullptr, 0, nullptr, 0}; }
+
+    RedliteFtHitArray arr_;
+};
+
+namespace detail {
+
+inline FtHits ft_search_page(RedliteDb* db, std::string_view index, std::string_view query,
+                             const FtSearchOptions& opts) {
+    std::vector<RedliteBytes> fields;
+    fields.reserve(opts.return_fields.size());
+    for (const auto& f : opts.return_fields) {
+        fields.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(f.data())), f.size()});
+    }
+    RedliteFtSearchOptions raw{opts.offset, opts.num, opts.nocontent ? 1 : 0, opts.verbatim ? 1 : 0,
+                               opts.withscores ? 1 : 0, fields.data(), fields.size(),
+                               opts.sortby ? opts.sortby->data() : nullptr, opts.sortby ? opts.sortby->size() : 0,
+                               opts.sortby_desc ? 1 : 0};
+    RedliteFtHitArray arr = REDLITE_FFI(redlite_ft_search_hits(db, index.data(), index.size(),
+                                                               query.data(), query.size(), &raw));
+    if (arr.total < 0) throw Error::from_last_error();
+    return FtHits(arr);
+}
+
+} // namespace detail
+
+/**
+ * Lazy FT.SEARCH over every match, fetched `page_size` hits at a time
+ *
+ * Each page is one LIMIT offset num query, so memory stays bounded by the
+ * page size. Hits are views into the current page and are invalidated when
+ * the iterator moves past it. Writes between pages can shift later pages.
+ * The Database must outlive the range.
+ *
+ *   for (auto hit : db.ft_search_iter("idx", "hello", {}, 500)) { ... }
+ */
+class FtSearch {
+public:
+    using value_type = FtHitView;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = FtHitView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const FtHitView*;
+        using reference = FtHitView;
+
+        iterator() : range_(nullptr) {}
+        explicit iterator(FtSearch* range) : range_(range) {}
+
+        FtHitView operator*() const { return range_->page_[range_->pos_]; }
+
+        iterator& operator++() { range_->next(); return *this; }
+        void operator++(int) { range_->next(); }
+
+        bool operator==(const iterator& other) const { return at_end() == other.at_end(); }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        bool at_end() const { return !range_ || range_->done_; }
+
+        FtSearch* range_;
+    };
+
+    FtSearch(RedliteDb* db, std::string_view index, std::string_view query, FtSearchOptions opts, size_t page_size)
+        : db_(db), index_(index), query_(query), opts_(std::move(opts)) {
+        opts_.num = page_size ? static_cast<int64_t>(page_size) : 1;
+    }
+
+    // Move only
+    FtSearch(FtSearch&&) noexcept = default;
+    FtSearch& operator=(FtSearch&&) = delete;
+    FtSearch(const FtSearch&) = delete;
+    FtSearch& operator=(const FtSearch&) = delete;
+
+    /**
+     * Fetch the first page; a range can only be iterated once
+     * @throws Error if the search fails (e.g. unknown index)
+     */
+    iterator begin() {
+        if (!started_) {
+            started_ = true;
+            fetch();
+        }
+        return iterator(this);
+    }
+
+    iterator end() { return iterator(); }
+
+    /**
+     * Number of matching documents as of the most recent page; 0 before begin()
+     */
+    int64_t total() const { return page_.total(); }
+
+private:
+    // A short page is the last one
+    void next() {
+        if (++pos_ < page_.size()) return;
+        if (page_.size() < static_cast<size_t>(opts_.num)) {
+            done_ = true;
+            return;
+        }
+        fetch();
+    }
+
+    void fetch() {
+        try {
+            page_ = detail::ft_search_page(db_, index_, query_, opts_);
+        } catch (...) {
+            done_ = true;
+            throw;
+        }
+        opts_.offset += static_cast<int64_t>(page_.size());
+        pos_ = 0;
+        if (page_.empty()) done_ = true;
+    }
+
+    RedliteDb* db_;
+    std::string index_;
+    std::string query_;
+    FtSearchOptions opts_;
+    FtHits page_;
+    size_t pos_ = 0;
+    bool started_ = false;
+    bool done_ = false;
+};
+
+/**
+ * Stream entry ID (ms-seq)
+ */
+struct StreamId {
+    int64_t ms = 0;
+    int64_t seq = 0;
+
+    static StreamId min() { return {0, 0}; }
+    static StreamId max() { return {INT64_MAX, INT64_MAX}; }
+
+    std::string to_string() const { return std::to_string(ms) + "-" + std::to_string(seq); }
+
+    bool operator==(const StreamId& o) const { return ms == o.ms && seq == o.seq; }
+    bool operator!=(const StreamId& o) const { return !(*this == o); }
+    bool operator<(const StreamId& o) const { return ms < o.ms || (ms == o.ms && seq < o.seq); }
+};
+
+/**
+ * XADD options
+ */
+struct XAddOptions {
+    StreamId id;                     // {0, 0} = auto-generate (*)
+    bool nomkstream = false;         // Fail instead of creating the stream
+    std::optional<int64_t> maxlen;   // Trim to this length after adding
+};
+
+/**
+ * Stream field borrowed from a StreamBatch
+ */
+struct StreamFieldView {
+    std::string_view name;
+    std::string_view value;
+};
+
+/**
+ * Stream entry borrowed from a StreamBatch; valid while the batch lives
+ */
+class StreamEntryView {
+public:
+    explicit StreamEntryView(const RedliteStreamEntry* entry) : entry_(entry) {}
+
+    StreamId id() const { return {entry_->id.ms, entry_->id.seq}; }
+    size_t size() const { return entry_->fields ? entry_->fields_len : 0; }
+
+    StreamFieldView operator[](size_t i) const {
+        const RedliteStreamField& f = entry_->fields[i];
+        return {view(f.key, f.key_len), view(f.value, f.value_len)};
+    }
+
+    /**
+     * Value of the first field called `name` (linear scan over the fields)
+     */
+    std::optional<std::string_view> get(std::string_view name) const {
+        for (size_t i = 0; i < size(); ++i) {
+            auto field = (*this)[i];
+            if (field.name == name) return field.value;
+        }
+        return std::nullopt;
+    }
+
+private:
+    static std::string_view view(const uint8_t* data, size_t len) {
+        if (!data) return {};
+        return std::string_view(reinterpret_cast<const char*>(data), len);
+    }
+
+    const RedliteStreamEntry* entry_;
+};
+
+/**
+ * RAII wrapper for stream entries returned by XRANGE/XREAD/XREADGROUP
+ *
+ * Entries and fields are views into the FFI allocation, so iterating a
+ * batch copies nothing. Move only.
+ */
+class StreamBatch {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = StreamEntryView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = StreamEntryView;
+
+        iterator() : entry_(nullptr) {}
+        explicit iterator(const RedliteStreamEntry* entry) : entry_(entry) {}
+
+        StreamEntryView operator*() const { return StreamEntryView(entry_); }
+        iterator& operator++() { ++entry_; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++entry_; return tmp; }
+
+        bool operator==(const iterator& other) const { return entry_ == other.entry_; }
+        bool operator!=(const iterator& other) const { return entry_ != other.entry_; }
+
+    private:
+        const RedliteStreamEntry* entry_;
+    };
+
+    StreamBatch() : arr_{nullptr, 0} {}
+    explicit StreamBatch(RedliteStreamEntryArray arr) : arr_(arr) {}
+    ~StreamBatch() { if (arr_.entries) redlite_free_stream_entry_array(arr_); }
+
+    // Move only
+    StreamBatch(StreamBatch&& other) noexcept : arr_(other.arr_) { other.arr_ = {nullptr, 0}; }
+    StreamBatch& operator=(StreamBatch&& other) noexcept {
+        if (this != &other) {
+            if (arr_.entries) redlite_free_stream_entry_array(arr_);
+            arr_ = other.arr_;
+            other.arr_ = {nullptr, 0};
+        }
+        return *this;
+    }
+    StreamBatch(const StreamBatch&) = delete;
+    StreamBatch& operator=(const StreamBatch&) = delete;
+
+    size_t size() const { return arr_.entries ? arr_.len : 0; }
+    bool empty() const { return size() == 0; }
+    StreamEntryView operator[](size_t i) const { return StreamEntryView(&arr_.entries[i]); }
+
+    iterator begin() const { return iterator(arr_.entries); }
+    iterator end() const { return iterator(arr_.entries + size()); }
+
+    /**
+     * IDs of all entries, e.g. for XACK or XDEL
+     */
+    std::vector<StreamId> ids() const {
+        std::vector<StreamId> result;
+        result.reserve(size());
+        for (size_t i = 0; i < size(); ++i) result.push_back({arr_.entries[i].id.ms, arr_.entries[i].id.seq});
+        return result;
+    }
+
+private:
+    RedliteStreamEntryArray arr_;
+};
+
+namespace detail {
+
+/**
+ * In-process wakeup for stream readers
+ *
+ * Database::xadd bumps the signal for the stream key; StreamConsumer waits
+ * on it instead of sleep-polling. Keys hash into a fixed set of slots, so
+ * unrelated keys can cause a spurious (harmless) wakeup. Writers in other
+ * processes are not seen; waiters re-check after their timeout.
+ */
+class StreamSignal {
+public:
+    static StreamSignal& for_key(std::string_view key) {
+        return slots()[std::hash<std::string_view>{}(key) % kSlots];
+    }
+
+    // Entries added inside a transaction only become visible on commit
+    static void notify_all_keys() {
+        for (size_t i = 0; i < kSlots; ++i) slots()[i].notify();
+    }
+
+    uint64_t epoch() const { return epoch_.load(); }
+
+    void notify() {
+        epoch_.fetch_add(1);
+        if (waiters_.load() > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_all();
+        }
+    }
+
+    /**
+     * Wait until notify() is called after `seen` was read, or `timeout` passes
+     * @return true if woken by a notify
+     */
+    bool wait(uint64_t seen, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        waiters_.fetch_add(1);
+        bool woke = cv_.wait_for(lock, timeout, [&] { return epoch_.load() != seen; });
+        waiters_.fetch_sub(1);
+        return woke;
+    }
+
+private:
+    static constexpr size_t kSlots = 64;
+
+    static StreamSignal* slots() {
+        static StreamSignal instances[kSlots];
+        return instances;
+    }
+
+    std::atomic<uint64_t> epoch_{0};
+    std::atomic<int> waiters_{0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+} // namespace detail
+
+/**
+ * Result of one pipelined command
+ */
+struct Reply {
+    enum class Type { Nil, Integer, Double, Bytes, Ok, Error };
+
+    Type type = Type::Nil;
+    int64_t integer = 0;
+    double number = 0.0;
+    std::string str;  // Bytes payload, or the message for Type::Error
+
+    bool is_nil() const { return type == Type::Nil; }
+    bool is_error() const { return type == Type::Error; }
+    explicit operator bool() const { return type != Type::Nil && type != Type::Error; }
+};
+
+/**
+ * Command pipeline - queue commands, then run them with exec()
+ *
+ * The whole batch crosses the FFI once and runs under a single lock and a
+ * single SQLite transaction. A failing command yields a Reply of
+ * Type::Error without aborting the rest of the batch.
+ *
+ * Obtained from Database::pipeline(); must not outlive the Database.
+ *
+ * Supported commands: GET SET SETEX PSETEX GETDEL APPEND STRLEN INCR DECR
+ * INCRBY DECRBY DEL EXISTS EXPIRE PEXPIRE PERSIST TTL PTTL HSET HGET HDEL
+ * HEXISTS HLEN HINCRBY LPUSH RPUSH LLEN SADD SREM SISMEMBER SCARD ZADD ZREM
+ * ZSCORE ZINCRBY ZCARD
+ */
+class Pipeline {
+public:
+    // Move only
+    Pipeline(Pipeline&&) noexcept = default;
+    Pipeline& operator=(Pipeline&&) noexcept = default;
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * Queue a raw command (args[0] is the command name)
+     */
+    Pipeline& command(std::initializer_list<std::string_view> args) {
+        for (auto a : args) push_arg(a);
+        return end_command();
+    }
+
+    Pipeline& command(const std::vector<std::string_view>& args) {
+        for (auto a : args) push_arg(a);
+        return end_command();
+    }
+
+    // ==================== String Commands ====================
+
+    Pipeline& get(std::string_view key) { return command({"GET", key}); }
+
+    Pipeline& set(std::string_view key, std::string_view value) {
+        return command({"SET", key, value});
+    }
+
+    /**
+     * SET key value EX ttl_seconds
+     */
+    Pipeline& set(std::string_view key, std::string_view value, int64_t ttl_seconds) {
+        if (ttl_seconds <= 0) return set(key, value);
+        push_args({"SET", key, value, "EX"});
+        push_arg(std::to_string(ttl_seconds));
+        return end_command();
+    }
+
+    Pipeline& getdel(std::string_view key) { return command({"GETDEL", key}); }
+    Pipeline& append(std::string_view key, std::string_view value) { return command({"APPEND", key, value}); }
+    Pipeline& strlen(std::string_view key) { return command({"STRLEN", key}); }
+    Pipeline& incr(std::string_view key) { return command({"INCR", key}); }
+    Pipeline& decr(std::string_view key) { return command({"DECR", key}); }
+
+    Pipeline& incrby(std::string_view key, int64_t increment) {
+        push_args({"INCRBY", key});
+        push_arg(std::to_string(increment));
+        return end_command();
+    }
+
+    Pipeline& decrby(std::string_view key, int64_t decrement) {
+        push_args({"DECRBY", key});
+        push_arg(std::to_string(decrement));
+        return end_command();
+    }
+
+    // ==================== Key Commands ====================
+
+    Pipeline& del(std::string_view key) { return command({"DEL", key}); }
+
+    Pipeline& del(const std::vector<std::string>& keys) {
+        push_arg("DEL");
+        for (const auto& k : keys) push_arg(k);
+        return end_command();
+    }
+
+    Pipeline& exists(std::string_view key) { return command({"EXISTS", key}); }
+
+    Pipeline& expire(std::string_view key, int64_t seconds) {
+        push_args({"EXPIRE", key});
+        push_arg(std::to_string(seconds));
+        return end_command();
+    }
+
+    Pipeline& pexpire(std::string_view key, int64_t milliseconds) {
+        push_args({"PEXPIRE", key});
+        push_arg(std::to_string(milliseconds));
+        return end_command();
+    }
+
+    Pipeline& persist(std::string_view key) { return command({"PERSIST", key}); }
+    Pipeline& ttl(std::string_view key) { return command({"TTL", key}); }
+    Pipeline& pttl(std::string_view key) { return command({"PTTL", key}); }
+
+    // ==================== Hash Commands ====================
+
+    Pipeline& hset(std::string_view key, std::string_view field, std::string_view value) {
+        return command({"HSET", key, field, value});
+    }
+
+    Pipeline& hset(std::string_view key, const std::unordered_map<std::string, std::string>& fields) {
+        push_args({"HSET", key});
+        for (const auto& [f, v] : fields) {
+            push_arg(f);
+            push_arg(v);
+        }
+        return end_command();
+    }
+
+    Pipeline& hget(std::string_view key, std::string_view field) { return command({"HGET", key, field}); }
+    Pipeline& hdel(std::string_view key, std::string_view field) { return command({"HDEL", key, field}); }
+    Pipeline& hexists(std::string_view key, std::string_view field) { return command({"HEXISTS", key, field}); }
+    Pipeline& hlen(std::string_view key) { return command({"HLEN", key}); }
+
+    Pipeline& hincrby(std::string_view key, std::string_view field, int64_t increment) {
+        push_args({"HINCRBY", key, field});
+        push_arg(std::to_string(increment));
+        return end_command();
+    }
+
+    // ==================== List Commands ====================
+
+    Pipeline& lpush(std::string_view key, const std::vector<std::string>& values) {
+        push_args({"LPUSH", key});
+        for (const auto& v : values) push_arg(v);
+        return end_command();
+    }
+
+    Pipeline& rpush(std::string_view key, const std::vector<std::string>& values) {
+        push_args({"RPUSH", key});
+        for (const auto& v : values) push_arg(v);
+        return end_command();
+    }
+
+    Pipeline& llen(std::string_view key) { return command({"LLEN", key}); }
+
+    // ==================== Set Commands ====================
+
+    Pipeline& sadd(std::string_view key, const std::vector<std::string>& members) {
+        push_args({"SADD", key});
+        for (const auto& m : members) push_arg(m);
+        return end_command();
+    }
+
+    Pipeline& srem(std::string_view key, const std::vector<std::string>& members) {
+        push_args({"SREM", key});
+        for (const auto& m : members) push_arg(m);
+        return end_command();
+    }
+
+    Pipeline& sismember(std::string_view key, std::string_view member) { return command({"SISMEMBER", key, member}); }
+    Pipeline& scard(std::string_view key) { return command({"SCARD", key}); }
+
+    // ==================== Sorted Set Commands ====================
+
+    Pipeline& zadd(std::string_view key, double score, std::string_view member) {
+        push_args({"ZADD", key});
+        push_arg(format_double(score));
+        push_arg(member);
+        return end_command();
+    }
+
+    Pipeline& zadd(std::string_view key, const std::vector<ZMember>& members) {
+        push_args({"ZADD", key});
+        for (const auto& m : members) {
+            push_arg(format_double(m.score));
+            push_arg(m.member);
+        }
+        return end_command();
+    }
+
+    Pipeline& zrem(std::string_view key, std::string_view member) { return command({"ZREM", key, member}); }
+    Pipeline& zscore(std::string_view key, std::string_view member) { return command({"ZSCORE", key, member}); }
+
+    Pipeline& zincrby(std::string_view key, double increment, std::string_view member) {
+        push_args({"ZINCRBY", key});
+        push_arg(format_double(increment));
+        push_arg(member);
+        return end_command();
+    }
+
+    Pipeline& zcard(std::string_view key) { return command({"ZCARD", key}); }
+
+    // ==================== Execution ====================
+
+    size_t size() const { return cmd_argc_.size(); }
+    bool empty() const { return cmd_argc_.empty(); }
+
+    void clear() {
+        buf_.clear();
+        arg_offsets_.clear();
+        arg_lens_.clear();
+        cmd_argc_.clear();
+        cmd_first_ = 0;
+    }
+
+    /**
+     * Run all queued commands and clear the queue
+     * @return One reply per command, in queue order
+     * @throws Error if the batch transaction could not be started or committed
+     */
+    std::vector<Reply> exec() {
+        if (empty()) return {};
+
+        std::vector<const uint8_t*> argv(arg_offsets_.size());
+        const auto* base = reinterpret_cast<const uint8_t*>(buf_.data());
+        for (size_t i = 0; i < argv.size(); ++i) argv[i] = base + arg_offsets_[i];
+
+        std::vector<RedliteCommand> cmds(cmd_argc_.size());
+        size_t first = 0;
+        for (size_t i = 0; i < cmds.size(); ++i) {
+            cmds[i] = {argv.data() + first, arg_lens_.data() + first, cmd_argc_[i]};
+            first += cmd_argc_[i];
+        }
+
+        RedliteReplyArray arr = redlite_pipeline_exec(db_, cmds.data(), cmds.size());
+        clear();
+        if (!arr.replies) throw Error::from_last_error();
+
+        std::vector<Reply> replies(arr.len);
+        for (size_t i = 0; i < arr.len; ++i) {
+            const RedliteReply& r = arr.replies[i];
+            Reply& out = replies[i];
+            out.type = static_cast<Reply::Type>(r.kind);
+            out.integer = r.integer;
+            out.number = r.number;
+            if (r.value.data) out.str.assign(reinterpret_cast<const char*>(r.value.data), r.value.len);
+        }
+        redlite_free_reply_array(arr);
+        return replies;
+    }
+
+private:
+    friend class Database;
+    explicit Pipeline(RedliteDb* db) : db_(db) {}
+
+    void push_arg(std::string_view arg) {
+        arg_offsets_.push_back(buf_.size());
+        arg_lens_.push_back(arg.size());
+        buf_.append(arg.data(), arg.size());
+    }
+
+    void push_args(std::initializer_list<std::string_view> args) {
+        for (auto a : args) push_arg(a);
+    }
+
+    Pipeline& end_command() {
+        cmd_argc_.push_back(arg_offsets_.size() - cmd_first_);
+        cmd_first_ = arg_offsets_.size();
+        return *this;
+    }
+
+    static std::string format_double(double v) {
+        char buf[32];
+        int n = std::snprintf(buf, sizeof(buf), "%.17g", v);
+        return std::string(buf, n > 0 ? static_cast<size_t>(n) : 0);
+    }
+
+    RedliteDb* db_;
+    std::string buf_;                  // All argument bytes, back to back
+    std::vector<size_t> arg_offsets_;  // Offset of each argument in buf_
+    std::vector<size_t> arg_lens_;     // Length of each argument
+    std::vector<size_t> cmd_argc_;     // Argument count per queued command
+    size_t cmd_first_ = 0;             // Index of the current command's first argument
+};
+
+/**
+ * RAII transaction guard - rolls back on destruction unless committed
+ *
+ * Maps onto one SQLite BEGIN IMMEDIATE ... COMMIT, so every command issued
+ * on the Database while the guard is active shares a single commit.
+ * Only one transaction can be open per database at a time.
+ *
+ *   auto tx = db.transaction();
+ *   db.set("a", "1");
+ *   db.set("b", "2");
+ *   tx.commit();
+ */
+class Transaction {
+public:
+    ~Transaction() {
+        if (db_) redlite_rollback(db_);
+    }
+
+    // Move only
+    Transaction(Transaction&& other) noexcept : db_(other.db_) { other.db_ = nullptr; }
+    Transaction& operator=(Transaction&& other) noexcept {
+        if (this != &other) {
+            if (db_) redlite_rollback(db_);
+            db_ = other.db_;
+            other.db_ = nullptr;
+        }
+        return *this;
+    }
+    Transaction(const Transaction&) = delete;
+    Transaction& operator=(const Transaction&) = delete;
+
+    /**
+     * Commit all commands since the transaction started
+     * @throws Error if the commit fails (the transaction is rolled back)
+     */
+    void commit() {
+        if (!db_) throw Error("Transaction is not active");
+        RedliteDb* db = db_;
+        db_ = nullptr;
+        if (redlite_commit(db) < 0) throw Error::from_last_error();
+        detail::StreamSignal::notify_all_keys();
+    }
+
+    /**
+     * Discard all commands since the transaction started
+     */
+    void rollback() {
+        if (!db_) throw Error("Transaction is not active");
+        RedliteDb* db = db_;
+        db_ = nullptr;
+        if (redlite_rollback(db) < 0) throw Error::from_last_error();
+    }
+
+    bool active() const { return db_ != nullptr; }
+
+private:
+    friend class Database;
+    explicit Transaction(RedliteDb* db) : db_(db) {
+        if (redlite_begin(db_) < 0) throw Error::from_last_error();
+    }
+
+    RedliteDb* db_;
+};
+
+/**
+ * Main database class - RAII managed
+ */
+class Database {
+public:
+    /**
+     * Open a database at the given path
+     * @throws Error if open fails
+     */
+    explicit Database(const std::string& path) {
+        db_ = redlite_open(path.c_str());
+        if (!db_) throw Error::from_last_error();
+    }
+
+    /**
+     * Open an in-memory database
+     */
+    static Database open_memory() {
+        RedliteDb* db = redlite_open_memory();
+        if (!db) throw Error::from_last_error();
+        return Database(db);
+    }
+
+    /**
+     * Open a database with custom cache size
+     */
+    static Database open_with_cache(const std::string& path, int64_t cache_mb) {
+        RedliteDb* db = redlite_open_with_cache(path.c_str(), cache_mb);
+        if (!db) throw Error::from_last_error();
+        return Database(db);
+    }
+
+    /**
+     * Open a database with explicit SQLite connection settings
+     */
+    static Database open(const std::string& path, const OpenOptions& options) {
+        RedliteOpenOptions o = redlite_open_options_default();
+        if (options.cache_mb) o.cache_mb = *options.cache_mb;
+        if (options.mmap_size) o.mmap_size = *options.mmap_size;
+        if (options.synchronous) o.synchronous = static_cast<int>(*options.synchronous);
+        if (options.page_size) o.page_size = *options.page_size;
+        if (options.wal_autocheckpoint) o.wal_autocheckpoint = *options.wal_autocheckpoint;
+        if (options.temp_store_memory) o.temp_store_memory = *options.temp_store_memory ? 1 : 0;
+        if (options.busy_timeout_ms) o.busy_timeout_ms = *options.busy_timeout_ms;
+        if (options.statement_cache) o.statement_cache = *options.statement_cache;
+        if (options.incremental_vacuum) o.incremental_vacuum = *options.incremental_vacuum ? 1 : 0;
+        if (options.max_memory) o.max_memory = *options.max_memory;
+        if (options.max_disk) o.max_disk = *options.max_disk;
+        if (options.eviction_policy) o.eviction_policy = static_cast<int>(*options.eviction_policy);
+        RedliteDb* db = redlite_open_with_options(path.c_str(), &o);
+        if (!db) throw Error::from_last_error();
+        return Database(db);
+    }
+
+    ~Database() {
+        if (db_) REDLITE_FFI(redlite_close(db_));
+    }
+
+    // Move only
+    Database(Database&& other) noexcept : db_(other.db_) { other.db_ = nullptr; }
+    Database& operator=(Database&& other) noexcept {
+        if (this != &other) {
+            if (db_) REDLITE_FFI(redlite_close(db_));
+            db_ = other.db_;
+            other.db_ = nullptr;
+        }
+        return *this;
+    }
+    Database(const Database&) = delete;
+    Database& operator=(const Database&) = delete;
+
+    // ==================== String Commands ====================
+
+    /**
+     * GET key
+     * @return Value or empty optional if key doesn't exist
+     */
+    std::optional<std::string> get(std::string_view key) {
+        REDLITE_METRIC("get", (key));
+        RedliteBytes result = REDLITE_FFI(redlite_get_len(db_, key.data(), key.size()));
+        if (!result.data) return std::nullopt;
+        Bytes b(result);
+        return b.to_string();
+    }
+
+    /**
+     * GET key (raw bytes)
+     */
+    std::optional<std::vector<uint8_t>> get_bytes(std::string_view key) {
+        REDLITE_METRIC("get_bytes", (key));
+        RedliteBytes result = REDLITE_FFI(redlite_get_len(db_, key.data(), key.size()));
+        if (!result.data) return std::nullopt;
+        Bytes b(result);
+        return b.to_vector();
+    }
+
+    /**
+     * GET key (zero-copy)
+     * @return Bytes handle owning the FFI buffer; empty if key doesn't exist
+     */
+    Bytes get_view(std::string_view key) {
+        REDLITE_METRIC("get_view", (key));
+        return Bytes(REDLITE_FFI(redlite_get_len(db_, key.data(), key.size())));
+    }
+
+    /**
+     * GET key decoded by Codec<T>, straight from the result buffer
+     * @return Value or empty optional if key doesn't exist
+     */
+    template <typename T>
+    std::optional<T> get(std::string_view key) {
+        Bytes b = get_view(key);
+        if (!b.data()) return std::nullopt;
+        return Codec<T>::decode(b.view());
+    }
+
+    /**
+     * SET key value [TTL seconds]
+     * @return true on success
+     */
+    bool set(std::string_view key, std::string_view value, int64_t ttl_seconds = 0) {
+        REDLITE_METRIC("set", (key, value, ttl_seconds));
+        return REDLITE_FFI(redlite_set_len(db_, key.data(), key.size(),
+                                           reinterpret_cast<const uint8_t*>(value.data()),
+                                           value.size(), ttl_seconds)) == 0;
+    }
+
+    /**
+     * SET key value [TTL seconds], value encoded by Codec<T>
+     * (strings use the overload above)
+     */
+    template <typename T, detail::enable_if_not_string<T> = 0>
+    bool set(std::string_view key, const T& value, int64_t ttl_seconds = 0) {
+        return Codec<T>::encode(value, [&](std::string_view bytes) { return set(key, bytes, ttl_seconds); });
+    }
+
+    /**
+     * SET key value with options
+     */
+    bool set(std::string_view key, std::string_view value, const SetOptions& opts) {
+        REDLITE_METRIC("set", (key, value, opts));
+        // Handle NX/XX options via the simpler set
+        // Note: Full NX/XX support would need FFI extension
+        int64_t ttl = 0;
+        if (opts.ex) ttl = *opts.ex;
+        else if (opts.px) ttl = *opts.px / 1000; // Convert ms to seconds
+        return set(key, value, ttl);
+    }
+
+    /**
+     * SETEX key seconds value
+     */
+    bool setex(std::string_view key, int64_t seconds, std::string_view value) {
+        REDLITE_METRIC("setex", (key, seconds, value));
+        return REDLITE_FFI(redlite_setex_len(db_, key.data(), key.size(), seconds,
+                                             reinterpret_cast<const uint8_t*>(value.data()),
+                                             value.size())) == 0;
+    }
+
+    /**
+     * PSETEX key milliseconds value
+     */
+    bool psetex(std::string_view key, int64_t milliseconds, std::string_view value) {
+        REDLITE_METRIC("psetex", (key, milliseconds, value));
+        return REDLITE_FFI(redlite_psetex_len(db_, key.data(), key.size(), milliseconds,
+                                              reinterpret_cast<const uint8_t*>(value.data()),
+                                              value.size())) == 0;
+    }
+
+    /**
+     * GETDEL key - Get and delete
+     */
+    std::optional<std::string> getdel(std::string_view key) {
+        REDLITE_METRIC("getdel", (key));
+        RedliteBytes result = REDLITE_FFI(redlite_getdel_len(db_, key.data(), key.size()));
+        if (!result.data) return std::nullopt;
+        Bytes b(result);
+        return b.to_string();
+    }
+
+    /**
+     * APPEND key value
+     * @return New length of string
+     */
+    int64_t append(std::string_view key, std::string_view value) {
+        REDLITE_METRIC("append", (key, value));
+        return REDLITE_FFI(redlite_append_len(db_, key.data(), key.size(),
+                                              reinterpret_cast<const uint8_t*>(value.data()),
+                                              value.size()));
+    }
+
+    /**
+     * STRLEN key
+     */
+    int64_t strlen(std::string_view key) {
+        REDLITE_METRIC("strlen", (key));
+        return REDLITE_FFI(redlite_strlen_len(db_, key.data(), key.size()));
+    }
+
+    /**
+     * GETRANGE key start end
+     */
+    std::string getrange(std::string_view key, int64_t start, int64_t end) {
+        REDLITE_METRIC("getrange", (key, start, end));
+        RedliteBytes result = REDLITE_FFI(redlite_getrange_len(db_, key.data(), key.size(), start, end));
+        if (!result.data) return {};
+        Bytes b(result);
+        return b.to_string();
+    }
+
+    /**
+     * GETRANGE key start end (zero-copy)
+     */
+    Bytes getrange_view(std::string_view key, int64_t start, int64_t end) {
+        REDLITE_METRIC("getrange_view", (key, start, end));
+        return Bytes(REDLITE_FFI(redlite_getrange_len(db_, key.data(), key.size(), start, end)));
+    }
+
+    /**
+     * SETRANGE key offset value
+     * @return New length of string
+     */
+    int64_t setrange(std::string_view key, int64_t offset, std::string_view value) {
+        REDLITE_METRIC("setrange", (key, offset, value));
+        return REDLITE_FFI(redlite_setrange_len(db_, key.data(), key.size(), offset,
+                                                reinterpret_cast<const uint8_t*>(value.data()),
+                                                value.size()));
+    }
+
+    /**
+     * INCR key
+     */
+    int64_t incr(std::string_view key) {
+        REDLITE_METRIC("incr", (key));
+        return REDLITE_FFI(redlite_incr_len(db_, key.data(), key.size()));
+    }
+
+    /**
+     * DECR key
+     */
+    int64_t decr(std::string_view key) {
+        REDLITE_METRIC("decr", (key));
+        return REDLITE_FFI(redlite_decr_len(db_, key.data(), key.size()));
+    }
+
+    /**
+     * INCRBY key increment
+     */
+    int64_t incrby(std::string_view key, int64_t increment) {
+        REDLITE_METRIC("incrby", (key, increment));
+        return REDLITE_FFI(redlite_incrby_len(db_, key.data(), key.size(), increment));
+    }
+
+    /**
+     * DECRBY key decrement
+     */
+    int64_t decrby(std::string_view key, int64_t decrement) {
+        REDLITE_METRIC("decrby", (key, decrement));
+        return REDLITE_FFI(redlite_decrby_len(db_, key.data(), key.size(), decrement));
+    }
+
+    /**
+     * INCRBYFLOAT key increment
+     */
+    double incrbyfloat(std::string_view key, double increment) {
+        REDLITE_METRIC("incrbyfloat", (key, increment));
+        char* result = REDLITE_FFI(redlite_incrbyfloat_len(db_, key.data(), key.size(), increment));
+        if (!result) throw Error::from_last_error();
+        std::unique_ptr<char, void (*)(char*)> owned(result, redlite_free_string);
+        return Codec<double>::decode(std::string_view(result));
+    }
+
+    /**
+     * MGET key [key ...]
+     */
+    std::vector<std::optional<std::string>> mget(const std::vector<std::string>& keys) {
+        REDLITE_METRIC("mget", (keys));
+        std::vector<RedliteBytes> key_bytes;
+        key_bytes.reserve(keys.size());
+        for (const auto& k : keys) {
+            key_bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(k.data())), k.size()});
+        }
+
+        RedliteBytesArray arr = REDLITE_FFI(redlite_mget_len(db_, key_bytes.data(), key_bytes.size()));
+        std::vector<std::optional<std::string>> result;
+        result.reserve(arr.len);
+
+        for (size_t i = 0; i < arr.len; ++i) {
+            if (arr.items[i].data) {
+                result.emplace_back(std::string(
+                    reinterpret_cast<const char*>(arr.items[i].data),
+                    arr.items[i].len));
+            } else {
+                result.emplace_back(std::nullopt);
+            }
+        }
+
+        redlite_free_bytes_array(arr);
+        return result;
+    }
+
+    /**
+     * MGET key [key ...] (zero-copy)
+     * Missing keys are reported by BytesArray::is_nil()
+     */
+    BytesArray mget_view(const std::vector<std::string>& keys) {
+        REDLITE_METRIC("mget_view", (keys));
+        std::vector<RedliteBytes> key_bytes;
+        key_bytes.reserve(keys.size());
+        for (const auto& k : keys) {
+            key_bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(k.data())), k.size()});
+        }
+        return BytesArray(REDLITE_FFI(redlite_mget_len(db_, key_bytes.data(), key_bytes.size())));
+    }
+
+    /**
+     * MSET key value [key value ...]
+     */
+    bool mset(const std::unordered_map<std::string, std::string>& pairs) {
+        REDLITE_METRIC("mset", (pairs));
+        std::vector<RedliteBytes> keys;
+        std::vector<RedliteBytes> values;
+        keys.reserve(pairs.size());
+        values.reserve(pairs.size());
+        for (const auto& [k, v] : pairs) {
+            keys.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(k.data())), k.size()});
+            values.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(v.data())), v.size()});
+        }
+        return REDLITE_FFI(redlite_mset_len(db_, keys.data(), values.data(), pairs.size())) == 0;
+    }
+
+    // ==================== Bitmap Commands ====================
+
+    /**
+     * SETBIT key offset value
+     * Bits inside the current value are patched in place; offsets past the
+     * end grow the value once.
+     * @return Previous bit value
+     */
+    bool setbit(std::string_view key, uint64_t offset, bool value) {
+        REDLITE_METRIC("setbit", (key, offset, value));
+        int64_t result = REDLITE_FFI(redlite_setbit_len(db_, key.data(), key.size(), offset, value ? 1 : 0));
+        if (result < 0) throw Error::from_last_error();
+        return result == 1;
+    }
+
+    /**
+     * GETBIT key offset (reads one byte, not the whole value)
+     */
+    bool getbit(std::string_view key, uint64_t offset) {
+        REDLITE_METRIC("getbit", (key, offset));
+        int64_t result = REDLITE_FFI(redlite_getbit_len(db_, key.data(), key.size(), offset));
+        if (result < 0) throw Error::from_last_error();
+        return result == 1;
+    }
+
+    /**
+     * BITCOUNT key
+     */
+    int64_t bitcount(std::string_view key) {
+        REDLITE_METRIC("bitcount", (key));
+        int64_t result = REDLITE_FFI(redlite_bitcount_len(db_, key.data(), key.size(), 0, 0, 0));
+        if (result < 0) throw Error::from_last_error();
+        return result;
+    }
+
+    /**
+     * BITCOUNT key start end (byte offsets, inclusive; negative counts from the end)
+     */
+    int64_t bitcount(std::string_view key, int64_t start, int64_t end) {
+        REDLITE_METRIC("bitcount", (key, start, end));
+        int64_t result = REDLITE_FFI(redlite_bitcount_len(db_, key.data(), key.size(), start, end, 1));
+        if (result < 0) throw Error::from_last_error();
+        return result;
+    }
+
+    /**
+     * BITOP operation destkey key [key ...]
+     * Missing keys count as all zeros; NOT takes exactly one key.
+     * @return Length of the stored result in bytes
+     */
+    int64_t bitop(BitOp op, std::string_view destkey, const std::vector<std::string>& keys) {
+        REDLITE_METRIC("bitop", (op, destkey, keys));
+        static constexpr const char* kOps[] = {"AND", "OR", "XOR", "NOT"};
+        std::vector<RedliteBytes> key_bytes;
+        key_bytes.reserve(keys.size());
+        for (const auto& k : keys) {
+            key_bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(k.data())), k.size()});
+        }
+        int64_t result = REDLITE_FFI(redlite_bitop_len(db_, kOps[static_cast<int>(op)], destkey.data(), destkey.size(),
+                                                       key_bytes.data(), key_bytes.size()));
+        if (result < 0) throw Error::from_last_error();
+        return result;
+    }
+
+    /**
+     * Raw bitmap bytes (zero-copy), bit 0 = MSB of byte 0 as in GETBIT
+     * Run your own popcount/AND kernels over data()/size(); empty if the key
+     * doesn't exist.
+     */
+    Bytes bitfield_read(std::string_view key) {
+        REDLITE_METRIC("bitfield_read", (key));
+        return Bytes(REDLITE_FFI(redlite_get_len(db_, key.data(), key.size())));
+    }
+
+    /**
+     * Bytes start..end of a bitmap (zero-copy, inclusive; negative counts from the end)
+     */
+    Bytes bitfield_read(std::string_view key, int64_t start, int64_t end) {
+        REDLITE_METRIC("bitfield_read", (key, start, end));
+        return Bytes(REDLITE_FFI(redlite_getrange_len(db_, key.data(), key.size(), start, end)));
+    }
+
+    // ==================== Key Commands ====================
+
+    /**
+     * DEL key [key ...]
+     * @return Number of keys deleted
+     */
+    int64_t del(const std::vector<std::string>& keys) {
+        REDLITE_METRIC("del", (keys));
+        std::vector<RedliteBytes> key_bytes;
+        key_bytes.reserve(keys.size());
+        for (const auto& k : keys) {
+            key_bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(k.data())), k.size()});
+        }
+        return REDLITE_FFI(redlite_del_len(db_, key_bytes.data(), key_bytes.size()));
+    }
+
+    int64_t del(std::string_view key) {
+        REDLITE_METRIC("del", (key));
+        RedliteBytes k = {reinterpret_cast<uint8_t*>(const_cast<char*>(key.data())), key.size()};
+        return REDLITE_FFI(redlite_del_len(db_, &k, 1));
+    }
+
+    /**
+     * EXISTS key [key ...]
+     * @return Number of keys that exist
+     */
+    int64_t exists(const std::vector<std::string>& keys) {
+        REDLITE_METRIC("exists", (keys));
+        std::vector<RedliteBytes> key_bytes;
+        key_bytes.reserve(keys.size());
+        for (const auto& k : keys) {
+            key_bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(k.data())), k.size()});
+        }
+        return REDLITE_FFI(redlite_exists_len(db_, key_bytes.data(), key_bytes.size()));
+    }
+
+    bool exists(std::string_view key) {
+        REDLITE_METRIC("exists", (key));
+        RedliteBytes k = {reinterpret_cast<uint8_t*>(const_cast<char*>(key.data())), key.size()};
+        return REDLITE_FFI(redlite_exists_len(db_, &k, 1)) > 0;
+    }
+
+    /**
+     * TYPE key
+     */
+    std::optional<std::string> type(std::string_view key) {
+        REDLITE_METRIC("type", (key));
+        char* result = REDLITE_FFI(redlite_type_len(db_, key.data(), key.size()));
+        if (!result) return std::nullopt;
+        std::string t(result);
+        redlite_free_string(result);
+        return t;
+    }
+
+    /**
+     * TTL key
+     * @return -2 if key doesn't exist, -1 if no TTL, else seconds
+     */
+    int64_t ttl(std::string_view key) {
+        REDLITE_METRIC("ttl", (key));
+        return REDLITE_FFI(redlite_ttl_len(db_, key.data(), key.size()));
+    }
+
+    /**
+     * PTTL key (milliseconds)
+     */
+    int64_t pttl(std::string_view key) {
+        REDLITE_METRIC("pttl", (key));
+        return REDLITE_FFI(redlite_pttl_len(db_, key.data(), key.size()));
+    }
+
+    /**
+     * EXPIRE key seconds
+     */
+    bool expire(std::string_view key, int64_t seconds) {
+        REDLITE_METRIC("expire", (key, seconds));
+        return REDLITE_FFI(redlite_expire_len(db_, key.data(), key.size(), seconds)) == 1;
+    }
+
+    /**
+     * PEXPIRE key milliseconds
+     */
+    bool pexpire(std::string_view key, int64_t milliseconds) {
+        REDLITE_METRIC("pexpire", (key, milliseconds));
+        return REDLITE_FFI(redlite_pexpire_len(db_, key.data(), key.size(), milliseconds)) == 1;
+    }
+
+    /**
+     * EXPIREAT key unix_timestamp
+     */
+    bool expireat(std::string_view key, int64_t unix_seconds) {
+        REDLITE_METRIC("expireat", (key, unix_seconds));
+        return REDLITE_FFI(redlite_expireat_len(db_, key.data(), key.size(), unix_seconds)) == 1;
+    }
+
+    /**
+     * PEXPIREAT key unix_timestamp_ms
+     */
+    bool pexpireat(std::string_view key, int64_t unix_ms) {
+        REDLITE_METRIC("pexpireat", (key, unix_ms));
+        return REDLITE_FFI(redlite_pexpireat_len(db_, key.data(), key.size(), unix_ms)) == 1;
+    }
+
+    /**
+     * PERSIST key - Remove TTL
+     */
+    bool persist(std::string_view key) {
+        REDLITE_METRIC("persist", (key));
+        return REDLITE_FFI(redlite_persist_len(db_, key.data(), key.size())) == 1;
+    }
+
+    /**
+     * RENAME key newkey
+     */
+    bool rename(std::string_view key, std::string_view newkey) {
+        REDLITE_METRIC("rename", (key, newkey));
+        return REDLITE_FFI(redlite_rename_len(db_, key.data(), key.size(),
+                                              newkey.data(), newkey.size())) == 0;
+    }
+
+    /**
+     * RENAMENX key newkey
+     */
+    bool renamenx(std::string_view key, std::string_view newkey) {
+        REDLITE_METRIC("renamenx", (key, newkey));
+        return REDLITE_FFI(redlite_renamenx_len(db_, key.data(), key.size(),
+                                                newkey.data(), newkey.size())) == 1;
+    }
+
+    /**
+     * KEYS pattern
+     */
+    std::vector<std::string> keys(std::string_view pattern = "*") {
+        REDLITE_METRIC("keys", (pattern));
+        RedliteStringArray arr = REDLITE_FFI(redlite_keys(db_, std::string(pattern).c_str()));
+        std::vector<std::string> result;
+        result.reserve(arr.len);
+        for (size_t i = 0; i < arr.len; ++i) {
+            result.emplace_back(arr.strings[i]);
+        }
+        redlite_free_string_array(arr);
+        return result;
+    }
+
+    /**
+     * DBSIZE
+     */
+    int64_t dbsize() {
+        REDLITE_METRIC("dbsize", ());
+        return REDLITE_FFI(redlite_dbsize(db_));
+    }
+
+    /**
+     * FLUSHDB
+     */
+    bool flushdb() {
+        REDLITE_METRIC("flushdb", ());
+        return REDLITE_FFI(redlite_flushdb(db_)) == 0;
+    }
+
+    /**
+     * SELECT db
+     */
+    bool select(int db_num) {
+        REDLITE_METRIC("select", (db_num));
+        return REDLITE_FFI(redlite_select(db_, db_num)) == 0;
+    }
+
+    // ==================== Hash Commands ====================
+
+    /**
+     * HSET key field value
+     */
+    int64_t hset(std::string_view key, std::string_view field, std::string_view value) {
+        REDLITE_METRIC("hset", (key, field, value));
+        RedliteBytes f = {reinterpret_cast<uint8_t*>(const_cast<char*>(field.data())), field.size()};
+        RedliteBytes v = {reinterpret_cast<uint8_t*>(const_cast<char*>(value.data())), value.size()};
+        return REDLITE_FFI(redlite_hset_len(db_, key.data(), key.size(), &f, &v, 1));
+    }
+
+    /**
+     * HSET key field value, value encoded by Codec<T>
+     */
+    template <typename T, detail::enable_if_not_string<T> = 0>
+    int64_t hset(std::string_view key, std::string_view field, const T& value) {
+        return Codec<T>::encode(value, [&](std::string_view bytes) { return hset(key, field, bytes); });
+    }
+
+    /**
+     * HSET key field value [field value ...]
+     */
+    int64_t hset(std::string_view key, const std::unordered_map<std::string, std::string>& fields) {
+        REDLITE_METRIC("hset", (key, fields));
+        std::vector<RedliteBytes> field_bytes;
+        std::vector<RedliteBytes> values;
+        field_bytes.reserve(fields.size());
+        values.reserve(fields.size());
+
+        for (const auto& [f, v] : fields) {
+            field_bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(f.data())), f.size()});
+            values.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(v.data())), v.size()});
+        }
+
+        return REDLITE_FFI(redlite_hset_len(db_, key.data(), key.size(),
+                                            field_bytes.data(), values.data(), fields.size()));
+    }
+
+    /**
+     * HGET key field
+     */
+    std::optional<std::string> hget(std::string_view key, std::string_view field) {
+        REDLITE_METRIC("hget", (key, field));
+        RedliteBytes result = REDLITE_FFI(redlite_hget_len(db_, key.data(), key.size(),
+                                                           field.data(), field.size()));
+        if (!result.data) return std::nullopt;
+        Bytes b(result);
+        return b.to_string();
+    }
+
+    /**
+     * HGET key field (zero-copy)
+     */
+    Bytes hget_view(std::string_view key, std::string_view field) {
+        REDLITE_METRIC("hget_view", (key, field));
+        return Bytes(REDLITE_FFI(redlite_hget_len(db_, key.data(), key.size(),
+                                                  field.data(), field.size())));
+    }
+
+    /**
+     * HGET key field decoded by Codec<T>, straight from the result buffer
+     */
+    template <typename T>
+    std::optional<T> hget(std::string_view key, std::string_view field) {
+        Bytes b = hget_view(key, field);
+        if (!b.data()) return std::nullopt;
+        return Codec<T>::decode(b.view());
+    }
+
+    /**
+     * HDEL key field [field ...]
+     */
+    int64_t hdel(std::string_view key, const std::vector<std::string>& fields) {
+        REDLITE_METRIC("hdel", (key, fields));
+        std::vector<RedliteBytes> field_bytes;
+        field_bytes.reserve(fields.size());
+        for (const auto& f : fields) {
+            field_bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(f.data())), f.size()});
+        }
+        return REDLITE_FFI(redlite_hdel_len(db_, key.data(), key.size(),
+                                            field_bytes.data(), field_bytes.size()));
+    }
+
+    /**
+     * HEXISTS key field
+     */
+    bool hexists(std::string_view key, std::string_view field) {
+        REDLITE_METRIC("hexists", (key, field));
+        return REDLITE_FFI(redlite_hexists_len(db_, key.data(), key.size(),
+                                               field.data(), field.size())) == 1;
+    }
+
+    /**
+     * HLEN key
+     */
+    int64_t hlen(std::string_view key) {
+        REDLITE_METRIC("hlen", (key));
+        return REDLITE_FFI(redlite_hlen_len(db_, key.data(), key.size()));
+    }
+
+    /**
+     * HKEYS key
+     */
+    std::vector<std::string> hkeys(std::string_view key) {
+        REDLITE_METRIC("hkeys", (key));
+        RedliteStringArray arr = REDLITE_FFI(redlite_hkeys_len(db_, key.data(), key.size()));
+        std::vector<std::string> result;
+        result.reserve(arr.len);
+        for (size_t i = 0; i < arr.len; ++i) {
+            result.emplace_back(arr.strings[i]);
+        }
+        redlite_free_string_array(arr);
+        return result;
+    }
+
+    /**
+     * HVALS key
+     */
+    std::vector<std::string> hvals(std::string_view key) {
+        REDLITE_METRIC("hvals", (key));
+        RedliteBytesArray arr = REDLITE_FFI(redlite_hvals_len(db_, key.data(), key.size()));
+        std::vector<std::string> result;
+        result.reserve(arr.len);
+        for (size_t i = 0; i < arr.len; ++i) {
+            result.emplace_back(
+                reinterpret_cast<const char*>(arr.items[i].data),
+                arr.items[i].len);
+        }
+        redlite_free_bytes_array(arr);
+        return result;
+    }
+
+    /**
+     * HVALS key (zero-copy)
+     */
+    BytesArray hvals_view(std::string_view key) {
+        REDLITE_METRIC("hvals_view", (key));
+        return BytesArray(REDLITE_FFI(redlite_hvals_len(db_, key.data(), key.size())));
+    }
+
+    /**
+     * HINCRBY key field increment
+     */
+    int64_t hincrby(std::string_view key, std::string_view field, int64_t increment) {
+        REDLITE_METRIC("hincrby", (key, field, increment));
+        return REDLITE_FFI(redlite_hincrby_len(db_, key.data(), key.size(),
+                                               field.data(), field.size(), increment));
+    }
+
+    /**
+     * HGETALL key
+     */
+    std::unordered_map<std::string, std::string> hgetall(std::string_view key) {
+        REDLITE_METRIC("hgetall", (key));
+        RedliteBytesArray arr = REDLITE_FFI(redlite_hgetall_len(db_, key.data(), key.size()));
+        std::unordered_map<std::string, std::string> result;
+        for (size_t i = 0; i + 1 < arr.len; i += 2) {
+            std::string field(reinterpret_cast<const char*>(arr.items[i].data), arr.items[i].len);
+            std::string value(reinterpret_cast<const char*>(arr.items[i+1].data), arr.items[i+1].len);
+            result[field] = value;
+        }
+        redlite_free_bytes_array(arr);
+        return result;
+    }
+
+    /**
+     * HGETALL key (zero-copy)
+     * @return Flattened [field1, value1, field2, value2, ...]
+     */
+    BytesArray hgetall_view(std::string_view key) {
+        REDLITE_METRIC("hgetall_view", (key));
+        return BytesArray(REDLITE_FFI(redlite_hgetall_len(db_, key.data(), key.size())));
+    }
+
+    /**
+     * HMGET key field [field ...]
+     */
+    std::vector<std::optional<std::string>> hmget(std::string_view key,
+                                                   const std::vector<std::string>& fields) {
+        REDLITE_METRIC("hmget", (key, fields));
+        std::vector<RedliteBytes> field_bytes;
+        field_bytes.reserve(fields.size());
+        for (const auto& f : fields) {
+            field_bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(f.data())), f.size()});
+        }
+
+        RedliteBytesArray arr = REDLITE_FFI(redlite_hmget_len(db_, key.data(), key.size(),
+                                                              field_bytes.data(), field_bytes.size()));
+        std::vector<std::optional<std::string>> result;
+        result.reserve(arr.len);
+
+        for (size_t i = 0; i < arr.len; ++i) {
+            if (arr.items[i].data) {
+                result.emplace_back(std::string(
+                    reinterpret_cast<const char*>(arr.items[i].data),
+                    arr.items[i].len));
+            } else {
+                result.emplace_back(std::nullopt);
+            }
+        }
+
+        redlite_free_bytes_array(arr);
+        return result;
+    }
+
+    // ==================== List Commands ====================
+
+    /**
+     * LPUSH key value [value ...]
+     */
+    int64_t lpush(std::string_view key, const std::vector<std::string>& values) {
+        REDLITE_METRIC("lpush", (key, values));
+        std::vector<RedliteBytes> bytes;
+        bytes.reserve(values.size());
+        for (const auto& v : values) {
+            bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(v.data())), v.size()});
+        }
+        return REDLITE_FFI(redlite_lpush_len(db_, key.data(), key.size(), bytes.data(), bytes.size()));
+    }
+
+    int64_t lpush(std::string_view key, std::string_view value) {
+        REDLITE_METRIC("lpush", (key, value));
+        RedliteBytes v = {reinterpret_cast<uint8_t*>(const_cast<char*>(value.data())), value.size()};
+        return REDLITE_FFI(redlite_lpush_len(db_, key.data(), key.size(), &v, 1));
+    }
+
+    /**
+     * LPUSH from string views, without copying them. Up to
+     * kInlinePushValues values are handed to the FFI from a stack array.
+     */
+    int64_t lpush(std::string_view key, std::initializer_list<std::string_view> values) {
+        REDLITE_METRIC("lpush", (key, values));
+        return push_views(redlite_lpush_len, key, values.begin(), values.size());
+    }
+
+    int64_t lpush(std::string_view key, const std::vector<std::string_view>& values) {
+        REDLITE_METRIC("lpush", (key, values));
+        return push_views(redlite_lpush_len, key, values.data(), values.size());
+    }
+
+#ifdef REDLITE_HAS_SPAN
+    int64_t lpush(std::string_view key, std::span<const std::string_view> values) {
+        REDLITE_METRIC("lpush", (key, values));
+        return push_views(redlite_lpush_len, key, values.data(), values.size());
+    }
+#endif
+
+    /**
+     * RPUSH key value [value ...]
+     */
+    int64_t rpush(std::string_view key, const std::vector<std::string>& values) {
+        REDLITE_METRIC("rpush", (key, values));
+        std::vector<RedliteBytes> bytes;
+        bytes.reserve(values.size());
+        for (const auto& v : values) {
+            bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(v.data())), v.size()});
+        }
+        return REDLITE_FFI(redlite_rpush_len(db_, key.data(), key.size(), bytes.data(), bytes.size()));
+    }
+
+    int64_t rpush(std::string_view key, std::string_view value) {
+        REDLITE_METRIC("rpush", (key, value));
+        RedliteBytes v = {reinterpret_cast<uint8_t*>(const_cast<char*>(value.data())), value.size()};
+        return REDLITE_FFI(redlite_rpush_len(db_, key.data(), key.size(), &v, 1));
+    }
+
+    /**
+     * RPUSH from string views, without copying them. Up to
+     * kInlinePushValues values are handed to the FFI from a stack array.
+     */
+    int64_t rpush(std::string_view key, std::initializer_list<std::string_view> values) {
+        REDLITE_METRIC("rpush", (key, values));
+        return push_views(redlite_rpush_len, key, values.begin(), values.size());
+    }
+
+    int64_t rpush(std::string_view key, const std::vector<std::string_view>& values) {
+        REDLITE_METRIC("rpush", (key, values));
+        return push_views(redlite_rpush_len, key, values.data(), values.size());
+    }
+
+#ifdef REDLITE_HAS_SPAN
+    int64_t rpush(std::string_view key, std::span<const std::string_view> values) {
+        REDLITE_METRIC("rpush", (key, values));
+        return push_views(redlite_rpush_len, key, values.data(), values.size());
+    }
+#endif
+
+    /**
+     * LPOP key [count]
+     */
+    std::vector<std::string> lpop(std::string_view key, size_t count = 1) {
+        REDLITE_METRIC("lpop", (key, count));
+        RedliteBytesArray arr = REDLITE_FFI(redlite_lpop_len(db_, key.data(), key.size(), count));
+        std::vector<std::string> result;
+        result.reserve(arr.len);
+        for (size_t i = 0; i < arr.len; ++i) {
+            result.emplace_back(
+                reinterpret_cast<const char*>(arr.items[i].data),
+                arr.items[i].len);
+        }
+        redlite_free_bytes_array(arr);
+        return result;
+    }
+
+    /**
+     * RPOP key [count]
+     */
+    std::vector<std::string> rpop(std::string_view key, size_t count = 1) {
+        REDLITE_METRIC("rpop", (key, count));
+        RedliteBytesArray arr = REDLITE_FFI(redlite_rpop_len(db_, key.data(), key.size(), count));
+        std::vector<std::string> result;
+        result.reserve(arr.len);
+        for (size_t i = 0; i < arr.len; ++i) {
+            result.emplace_back(
+                reinterpret_cast<const char*>(arr.items[i].data),
+                arr.items[i].len);
+        }
+        redlite_free_bytes_array(arr);
+        return result;
+    }
+
+    /**
+     * LLEN key
+     */
+    int64_t llen(std::string_view key) {
+        REDLITE_METRIC("llen", (key));
+        return REDLITE_FFI(redlite_llen_len(db_, key.data(), key.size()));
+    }
+
+    /**
+     * LRANGE key start stop
+     */
+    std::vector<std::string> lrange(std::string_view key, int64_t start, int64_t stop) {
+        REDLITE_METRIC("lrange", (key, start, stop));
+        RedliteBytesArray arr = REDLITE_FFI(redlite_lrange_len(db_, key.data(), key.size(), start, stop));
+        std::vector<std::string> result;
+        result.reserve(arr.len);
+        for (size_t i = 0; i < arr.len; ++i) {
+            result.emplace_back(
+                reinterpret_cast<const char*>(arr.items[i].data),
+                arr.items[i].len);
+        }
+        redlite_free_bytes_array(arr);
+        return result;
+    }
+
+    /**
+     * LRANGE key start stop (zero-copy)
+     */
+    BytesArray lrange_view(std::string_view key, int64_t start, int64_t stop) {
+        REDLITE_METRIC("lrange_view", (key, start, stop));
+        return BytesArray(REDLITE_FFI(redlite_lrange_len(db_, key.data(), key.size(), start, stop)));
+    }
+
+    /**
+     * LINDEX key index
+     */
+    std::optional<std::string> lindex(std::string_view key, int64_t index) {
+        REDLITE_METRIC("lindex", (key, index));
+        RedliteBytes result = REDLITE_FFI(redlite_lindex_len(db_, key.data(), key.size(), index));
+        if (!result.data) return std::nullopt;
+        Bytes b(result);
+        return b.to_string();
+    }
+
+    /**
+     * LINDEX key index (zero-copy)
+     */
+    Bytes lindex_view(std::string_view key, int64_t index) {
+        REDLITE_METRIC("lindex_view", (key, index));
+        return Bytes(REDLITE_FFI(redlite_lindex_len(db_, key.data(), key.size(), index)));
+    }
+
+    // ==================== Set Commands ====================
+
+    /**
+     * SADD key member [member ...]
+     */
+    int64_t sadd(std::string_view key, const std::vector<std::string>& members) {
+        REDLITE_METRIC("sadd", (key, members));
+        std::vector<RedliteBytes> bytes;
+        bytes.reserve(members.size());
+        for (const auto& m : members) {
+            bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(m.data())), m.size()});
+        }
+        return REDLITE_FFI(redlite_sadd_len(db_, key.data(), key.size(), bytes.data(), bytes.size()));
+    }
+
+    int64_t sadd(std::string_view key, std::string_view member) {
+        REDLITE_METRIC("sadd", (key, member));
+        RedliteBytes m = {reinterpret_cast<uint8_t*>(const_cast<char*>(member.data())), member.size()};
+        return REDLITE_FFI(redlite_sadd_len(db_, key.data(), key.size(), &m, 1));
+    }
+
+    /**
+     * SREM key member [member ...]
+     */
+    int64_t srem(std::string_view key, const std::vector<std::string>& members) {
+        REDLITE_METRIC("srem", (key, members));
+        std::vector<RedliteBytes> bytes;
+        bytes.reserve(members.size());
+        for (const auto& m : members) {
+            bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(m.data())), m.size()});
+        }
+        return REDLITE_FFI(redlite_srem_len(db_, key.data(), key.size(), bytes.data(), bytes.size()));
+    }
+
+    /**
+     * SMEMBERS key
+     */
+    std::vector<std::string> smembers(std::string_view key) {
+        REDLITE_METRIC("smembers", (key));
+        RedliteBytesArray arr = REDLITE_FFI(redlite_smembers_len(db_, key.data(), key.size()));
+        std::vector<std::string> result;
+        result.reserve(arr.len);
+        for (size_t i = 0; i < arr.len; ++i) {
+            result.emplace_back(
+                reinterpret_cast<const char*>(arr.items[i].data),
+                arr.items[i].len);
+        }
+        redlite_free_bytes_array(arr);
+        return result;
+    }
+
+    /**
+     * SMEMBERS key (zero-copy)
+     */
+    BytesArray smembers_view(std::string_view key) {
+        REDLITE_METRIC("smembers_view", (key));
+        return BytesArray(REDLITE_FFI(redlite_smembers_len(db_, key.data(), key.size())));
+    }
+
+    /**
+     * SISMEMBER key member
+     */
+    bool sismember(std::string_view key, std::string_view member) {
+        REDLITE_METRIC("sismember", (key, member));
+        return REDLITE_FFI(redlite_sismember_len(db_, key.data(), key.size(),
+                                                 reinterpret_cast<const uint8_t*>(member.data()),
+                                                 member.size())) == 1;
+    }
+
+    /**
+     * SCARD key
+     */
+    int64_t scard(std::string_view key) {
+        REDLITE_METRIC("scard", (key));
+        return REDLITE_FFI(redlite_scard_len(db_, key.data(), key.size()));
+    }
+
+    // ==================== Sorted Set Commands ====================
+
+    /**
+     * ZADD key score member [score member ...]
+     */
+    int64_t zadd(std::string_view key, const std::vector<ZMember>& members) {
+        REDLITE_METRIC("zadd", (key, members));
+        std::vector<RedliteZMember> zm;
+        zm.reserve(members.size());
+        for (const auto& m : members) {
+            zm.push_back({m.score,
+                         reinterpret_cast<const uint8_t*>(m.member.data()),
+                         m.member.size()});
+        }
+        return REDLITE_FFI(redlite_zadd_len(db_, key.data(), key.size(), zm.data(), zm.size()));
+    }
+
+    int64_t zadd(std::string_view key, double score, std::string_view member) {
+        REDLITE_METRIC("zadd", (key, score, member));
+        RedliteZMember zm = {score,
+                            reinterpret_cast<const uint8_t*>(member.data()),
+                            member.size()};
+        return REDLITE_FFI(redlite_zadd_len(db_, key.data(), key.size(), &zm, 1));
+    }
+
+    /**
+     * ZREM key member [member ...]
+     */
+    int64_t zrem(std::string_view key, const std::vector<std::string>& members) {
+        REDLITE_METRIC("zrem", (key, members));
+        std::vector<RedliteBytes> bytes;
+        bytes.reserve(members.size());
+        for (const auto& m : members) {
+            bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(m.data())), m.size()});
+        }
+        return REDLITE_FFI(redlite_zrem_len(db_, key.data(), key.size(), bytes.data(), bytes.size()));
+    }
+
+    /**
+     * ZSCORE key member
+     */
+    std::optional<double> zscore(std::string_view key, std::string_view member) {
+        REDLITE_METRIC("zscore", (key, member));
+        double score = REDLITE_FFI(redlite_zscore_len(db_, key.data(), key.size(),
+                                                      reinterpret_cast<const uint8_t*>(member.data()),
+                                                      member.size()));
+        if (std::isnan(score)) return std::nullopt;
+        return score;
+    }
+
+    /**
+     * ZCARD key
+     */
+    int64_t zcard(std::string_view key) {
+        REDLITE_METRIC("zcard", (key));
+        return REDLITE_FFI(redlite_zcard_len(db_, key.data(), key.size()));
+    }
+
+    /**
+     * ZCOUNT key min max
+     */
+    int64_t zcount(std::string_view key, double min, double max) {
+        REDLITE_METRIC("zcount", (key, min, max));
+        return REDLITE_FFI(redlite_zcount_len(db_, key.data(), key.size(), min, max));
+    }
+
+    /**
+     * ZINCRBY key increment member
+     */
+    double zincrby(std::string_view key, double increment, std::string_view member) {
+        REDLITE_METRIC("zincrby", (key, increment, member));
+        return REDLITE_FFI(redlite_zincrby_len(db_, key.data(), key.size(), increment,
+                                               reinterpret_cast<const uint8_t*>(member.data()),
+                                               member.size()));
     }
 
     /**
-     * DECRBY key decrement
+     * ZRANGE key start stop [WITHSCORES]
      */
-    int64_t decrby(std::string_view key, int64_t decrement) {
-        return redlite_decrby(db_, std::string(key).c_str(), decrement);
+    std::vector<std::string> zrange(std::string_view key, int64_t start, int64_t stop) {
+        REDLITE_METRIC("zrange", (key, start, stop));
+        RedliteBytesArray arr = REDLITE_FFI(redlite_zrange_len(db_, key.data(), key.size(),
+                                                               start, stop, 0));
+        std::vector<std::string> result;
+        result.reserve(arr.len);
+        for (size_t i = 0; i < arr.len; ++i) {
+            result.emplace_back(
+                reinterpret_cast<const char*>(arr.items[i].data),
+                arr.items[i].len);
+        }
+        redlite_free_bytes_array(arr);
+        return result;
     }
 
     /**
-     * INCRBYFLOAT key increment
+     * ZRANGE key start stop (zero-copy, members only)
      */
-    double incrbyfloat(std::string_view key, double increment) {
-        char* result = redlite_incrbyfloat(db_, std::string(key).c_str(), increment);
-        if (!result) throw Error::from_last_error();
-        double val = std::stod(result);
-        redlite_free_string(result);
-        return val;
+    BytesArray zrange_view(std::string_view key, int64_t start, int64_t stop) {
+        REDLITE_METRIC("zrange_view", (key, start, stop));
+        return BytesArray(REDLITE_FFI(redlite_zrange_len(db_, key.data(), key.size(), start, stop, 0)));
+    }
+
+    std::vector<ZMember> zrange_with_scores(std::string_view key, int64_t start, int64_t stop) {
+        REDLITE_METRIC("zrange_with_scores", (key, start, stop));
+        return zrange_with_scores_view(key, start, stop).to_vector();
     }
 
     /**
-     * MGET key [key ...]
+     * ZRANGE key start stop WITHSCORES (zero-copy, binary scores)
      */
-    std::vector<std::optional<std::string>> mget(const std::vector<std::string>& keys) {
-        std::vector<const char*> key_ptrs;
-        key_ptrs.reserve(keys.size());
-        for (const auto& k : keys) key_ptrs.push_back(k.c_str());
+    ZRangeResult zrange_with_scores_view(std::string_view key, int64_t start, int64_t stop) {
+        REDLITE_METRIC("zrange_with_scores_view", (key, start, stop));
+        return ZRangeResult(REDLITE_FFI(redlite_zrange_scored_len(db_, key.data(), key.size(), start, stop)));
+    }
 
-        RedliteBytesArray arr = redlite_mget(db_, key_ptrs.data(), key_ptrs.size());
-        std::vector<std::optional<std::string>> result;
+    /**
+     * ZREVRANGE key start stop [WITHSCORES]
+     */
+    std::vector<std::string> zrevrange(std::string_view key, int64_t start, int64_t stop) {
+        REDLITE_METRIC("zrevrange", (key, start, stop));
+        RedliteBytesArray arr = REDLITE_FFI(redlite_zrevrange_len(db_, key.data(), key.size(),
+                                                                  start, stop, 0));
+        std::vector<std::string> result;
         result.reserve(arr.len);
-
         for (size_t i = 0; i < arr.len; ++i) {
-            if (arr.items[i].data) {
-                result.emplace_back(std::string(
-                    reinterpret_cast<const char*>(arr.items[i].data),
-                    arr.items[i].len));
-            } else {
-                result.emplace_back(std::nullopt);
-            }
+            result.emplace_back(
+                reinterpret_cast<const char*>(arr.items[i].data),
+                arr.items[i].len);
         }
-
         redlite_free_bytes_array(arr);
         return result;
     }
 
     /**
-     * MSET key value [key value ...]
+     * ZREVRANGE key start stop (zero-copy, members only)
      */
-    bool mset(const std::unordered_map<std::string, std::string>& pairs) {
-        std::vector<RedliteKV> kvs;
-        kvs.reserve(pairs.size());
-        for (const auto& [k, v] : pairs) {
-            kvs.push_back({k.c_str(),
-                          reinterpret_cast<const uint8_t*>(v.data()),
-                          v.size()});
-        }
-        return redlite_mset(db_, kvs.data(), kvs.size()) == 0;
+    BytesArray zrevrange_view(std::string_view key, int64_t start, int64_t stop) {
+        REDLITE_METRIC("zrevrange_view", (key, start, stop));
+        return BytesArray(REDLITE_FFI(redlite_zrevrange_len(db_, key.data(), key.size(), start, stop, 0)));
     }
 
-    // ==================== Key Commands ====================
+    std::vector<ZMember> zrevrange_with_scores(std::string_view key, int64_t start, int64_t stop) {
+        REDLITE_METRIC("zrevrange_with_scores", (key, start, stop));
+        return zrevrange_with_scores_view(key, start, stop).to_vector();
+    }
 
     /**
-     * DEL key [key ...]
-     * @return Number of keys deleted
+     * ZREVRANGE key start stop WITHSCORES (zero-copy, binary scores)
      */
-    int64_t del(const std::vector<std::string>& keys) {
-        std::vector<const char*> key_ptrs;
-        key_ptrs.reserve(keys.size());
-        for (const auto& k : keys) key_ptrs.push_back(k.c_str());
-        return redlite_del(db_, key_ptrs.data(), key_ptrs.size());
-    }
-
-    int64_t del(std::string_view key) {
-        std::string key_str(key);
-        const char* k = key_str.c_str();
-        return redlite_del(db_, &k, 1);
+    ZRangeResult zrevrange_with_scores_view(std::string_view key, int64_t start, int64_t stop) {
+        REDLITE_METRIC("zrevrange_with_scores_view", (key, start, stop));
+        return ZRangeResult(REDLITE_FFI(redlite_zrevrange_scored_len(db_, key.data(), key.size(), start, stop)));
     }
 
     /**
-     * EXISTS key [key ...]
-     * @return Number of keys that exist
+     * ZRANGEBYSCORE key min max [LIMIT offset count]
+     * @param offset, count -1 for none
      */
-    int64_t exists(const std::vector<std::string>& keys) {
-        std::vector<const char*> key_ptrs;
-        key_ptrs.reserve(keys.size());
-        for (const auto& k : keys) key_ptrs.push_back(k.c_str());
-        return redlite_exists(db_, key_ptrs.data(), key_ptrs.size());
+    std::vector<std::string> zrangebyscore(std::string_view key, double min, double max,
+                                           int64_t offset = -1, int64_t count = -1) {
+        REDLITE_METRIC("zrangebyscore", (key, min, max, offset, count));
+        return zrangebyscore_with_scores_view(key, min, max, offset, count).members();
     }
 
-    bool exists(std::string_view key) {
-        std::string k(key);
-        const char* kp = k.c_str();
-        return redlite_exists(db_, &kp, 1) > 0;
+    std::vector<ZMember> zrangebyscore_with_scores(std::string_view key, double min, double max,
+                                                   int64_t offset = -1, int64_t count = -1) {
+        REDLITE_METRIC("zrangebyscore_with_scores", (key, min, max, offset, count));
+        return zrangebyscore_with_scores_view(key, min, max, offset, count).to_vector();
     }
 
     /**
-     * TYPE key
+     * ZRANGEBYSCORE key min max WITHSCORES [LIMIT offset count] (zero-copy, binary scores)
      */
-    std::optional<std::string> type(std::string_view key) {
-        char* result = redlite_type(db_, std::string(key).c_str());
-        if (!result) return std::nullopt;
-        std::string t(result);
-        redlite_free_string(result);
-        return t;
+    ZRangeResult zrangebyscore_with_scores_view(std::string_view key, double min, double max,
+                                                int64_t offset = -1, int64_t count = -1) {
+        REDLITE_METRIC("zrangebyscore_with_scores_view", (key, min, max, offset, count));
+        return ZRangeResult(REDLITE_FFI(redlite_zrangebyscore_scored_len(db_, key.data(), key.size(),
+                                                                         min, max, offset, count)));
     }
 
     /**
-     * TTL key
-     * @return -2 if key doesn't exist, -1 if no TTL, else seconds
+     * ZRANK key member
+     * @return 0-based rank, or nullopt if the member doesn't exist
      */
-    int64_t ttl(std::string_view key) {
-        return redlite_ttl(db_, std::string(key).c_str());
+    std::optional<int64_t> zrank(std::string_view key, std::string_view member) {
+        REDLITE_METRIC("zrank", (key, member));
+        return rank_result(REDLITE_FFI(redlite_zrank_len(db_, key.data(), key.size(),
+                                                         reinterpret_cast<const uint8_t*>(member.data()),
+                                                         member.size())));
     }
 
     /**
-     * PTTL key (milliseconds)
+     * ZREVRANK key member
+     * @return 0-based rank from the highest score, or nullopt if the member doesn't exist
      */
-    int64_t pttl(std::string_view key) {
-        return redlite_pttl(db_, std::string(key).c_str());
+    std::optional<int64_t> zrevrank(std::string_view key, std::string_view member) {
+        REDLITE_METRIC("zrevrank", (key, member));
+        return rank_result(REDLITE_FFI(redlite_zrevrank_len(db_, key.data(), key.size(),
+                                                            reinterpret_cast<const uint8_t*>(member.data()),
+                                                            member.size())));
     }
 
     /**
-     * EXPIRE key seconds
+     * ZINTERSTORE destination numkeys key [key ...] [WEIGHTS ...] [AGGREGATE SUM|MIN|MAX]
+     * @param weights Empty for 1.0 each, otherwise one per key
+     * @return Number of members in destination
      */
-    bool expire(std::string_view key, int64_t seconds) {
-        return redlite_expire(db_, std::string(key).c_str(), seconds) == 1;
+    int64_t zinterstore(std::string_view destination, const std::vector<std::string>& keys,
+                        const std::vector<double>& weights = {}, std::string_view aggregate = {}) {
+        REDLITE_METRIC("zinterstore", (destination, keys, weights, aggregate));
+        return zstore(redlite_zinterstore, destination, keys, weights, aggregate);
     }
 
     /**
-     * PEXPIRE key milliseconds
+     * ZUNIONSTORE destination numkeys key [key ...] [WEIGHTS ...] [AGGREGATE SUM|MIN|MAX]
+     * @param weights Empty for 1.0 each, otherwise one per key
+     * @return Number of members in destination
      */
-    bool pexpire(std::string_view key, int64_t milliseconds) {
-        return redlite_pexpire(db_, std::string(key).c_str(), milliseconds) == 1;
+    int64_t zunionstore(std::string_view destination, const std::vector<std::string>& keys,
+                        const std::vector<double>& weights = {}, std::string_view aggregate = {}) {
+        REDLITE_METRIC("zunionstore", (destination, keys, weights, aggregate));
+        return zstore(redlite_zunionstore, destination, keys, weights, aggregate);
     }
 
+    // ==================== Scan Commands ====================
+
     /**
-     * EXPIREAT key unix_timestamp
+     * SCAN cursor [MATCH pattern] [COUNT count], iterated lazily page by page
      */
-    bool expireat(std::string_view key, int64_t unix_seconds) {
-        return redlite_expireat(db_, std::string(key).c_str(), unix_seconds) == 1;
+    KeyScan scan(std::string_view pattern = "*", size_t count = 100) {
+        REDLITE_METRIC("scan", (pattern, count));
+        return KeyScan(db_, std::string(), pattern, count);
     }
 
     /**
-     * PEXPIREAT key unix_timestamp_ms
+     * SCAN cursor [MATCH pattern] [COUNT count], one page at a time
+     * @param cursor "0" to start, then the cursor of the previous page
+     * @throws Error if the scan fails
      */
-    bool pexpireat(std::string_view key, int64_t unix_ms) {
-        return redlite_pexpireat(db_, std::string(key).c_str(), unix_ms) == 1;
+    ScanPage scan_page(std::string_view cursor, std::string_view pattern = "*", size_t count = 100) {
+        REDLITE_METRIC("scan_page", (cursor, pattern, count));
+        std::string c(cursor), p(pattern);
+        RedliteScanResult result = REDLITE_FFI(redlite_scan(db_, c.c_str(), (p.empty() || p == "*") ? nullptr : p.c_str(),
+                                                            count ? count : 1));
+        if (!result.cursor) throw Error::from_last_error();
+        ScanPage page{result.cursor, {}};
+        if (result.keys.strings) page.keys.assign(result.keys.strings, result.keys.strings + result.keys.len);
+        redlite_free_scan_result(result);
+        return page;
     }
 
     /**
-     * PERSIST key - Remove TTL
+     * HSCAN key, yielding (field, value) views
      */
-    bool persist(std::string_view key) {
-        return redlite_persist(db_, std::string(key).c_str()) == 1;
+    HashScan hscan(std::string_view key, std::string_view pattern = "*", size_t count = 100) {
+        REDLITE_METRIC("hscan", (key, pattern, count));
+        return HashScan(db_, std::string(key), pattern, count);
     }
 
     /**
-     * RENAME key newkey
+     * SSCAN key, yielding member views
      */
-    bool rename(std::string_view key, std::string_view newkey) {
-        return redlite_rename(db_, std::string(key).c_str(),
-                             std::string(newkey).c_str()) == 0;
+    SetScan sscan(std::string_view key, std::string_view pattern = "*", size_t count = 100) {
+        REDLITE_METRIC("sscan", (key, pattern, count));
+        return SetScan(db_, std::string(key), pattern, count);
     }
 
     /**
-     * RENAMENX key newkey
+     * ZSCAN key, yielding ZMemberView in (score, member) order
      */
-    bool renamenx(std::string_view key, std::string_view newkey) {
-        return redlite_renamenx(db_, std::string(key).c_str(),
-                               std::string(newkey).c_str()) == 1;
+    ZSetScan zscan(std::string_view key, std::string_view pattern = "*", size_t count = 100) {
+        REDLITE_METRIC("zscan", (key, pattern, count));
+        return ZSetScan(db_, std::string(key), pattern, count);
     }
 
+    // ==================== Stream Commands ====================
+
     /**
-     * KEYS pattern
+     * XADD key [NOMKSTREAM] [MAXLEN n] *|ID field value [field value ...]
+     * @return ID of the added entry
+     * @throws Error on failure, including NOMKSTREAM on a missing stream
      */
-    std::vector<std::string> keys(std::string_view pattern = "*") {
-        RedliteStringArray arr = redlite_keys(db_, std::string(pattern).c_str());
-        std::vector<std::string> result;
-        result.reserve(arr.len);
-        for (size_t i = 0; i < arr.len; ++i) {
-            result.emplace_back(arr.strings[i]);
-        }
-        redlite_free_string_array(arr);
-        return result;
+    StreamId xadd(std::string_view key,
+                  std::initializer_list<std::pair<std::string_view, std::string_view>> fields,
+                  const XAddOptions& opts = {}) {
+        REDLITE_METRIC("xadd", (key, fields, opts));
+        return xadd_fields(key, fields, opts);
     }
 
     /**
-     * DBSIZE
+     * XADD with fields from any container of (name, value) pairs
      */
-    int64_t dbsize() {
-        return redlite_dbsize(db_);
+    template <typename Fields>
+    StreamId xadd(std::string_view key, const Fields& fields, const XAddOptions& opts = {}) {
+        REDLITE_METRIC("xadd", (key, fields, opts));
+        return xadd_fields(key, fields, opts);
     }
 
     /**
-     * FLUSHDB
+     * XLEN key
      */
-    bool flushdb() {
-        return redlite_flushdb(db_) == 0;
+    int64_t xlen(std::string_view key) {
+        REDLITE_METRIC("xlen", (key));
+        return REDLITE_FFI(redlite_xlen_len(db_, key.data(), key.size()));
     }
 
     /**
-     * SELECT db
+     * XRANGE key start end [COUNT count]
+     * @param count Maximum entries (0 = no limit)
      */
-    bool select(int db_num) {
-        return redlite_select(db_, db_num) == 0;
+    StreamBatch xrange(std::string_view key, StreamId start = StreamId::min(),
+                       StreamId end = StreamId::max(), int64_t count = 0) {
+        REDLITE_METRIC("xrange", (key, start, end, count));
+        return take_stream(REDLITE_FFI(redlite_xrange_len(db_, key.data(), key.size(), start.ms, start.seq,
+                                                          end.ms, end.seq, count, count > 0 ? 1 : 0)));
     }
 
-    // ==================== Hash Commands ====================
-
     /**
-     * HSET key field value
+     * XREVRANGE key end start [COUNT count]
      */
-    int64_t hset(std::string_view key, std::string_view field, std::string_view value) {
-        std::string key_str(key);
-        std::string field_str(field);
-        const char* f = field_str.c_str();
-        RedliteBytes v = {reinterpret_cast<uint8_t*>(const_cast<char*>(value.data())), value.size()};
-        return redlite_hset(db_, key_str.c_str(), &f, &v, 1);
+    StreamBatch xrevrange(std::string_view key, StreamId end = StreamId::max(),
+                          StreamId start = StreamId::min(), int64_t count = 0) {
+        REDLITE_METRIC("xrevrange", (key, end, start, count));
+        return take_stream(REDLITE_FFI(redlite_xrevrange_len(db_, key.data(), key.size(), end.ms, end.seq,
+                                                             start.ms, start.seq, count, count > 0 ? 1 : 0)));
     }
 
     /**
-     * HSET key field value [field value ...]
+     * XREAD [COUNT count] STREAMS key id - entries after `after`
      */
-    int64_t hset(std::string_view key, const std::unordered_map<std::string, std::string>& fields) {
-        std::vector<const char*> field_ptrs;
-        std::vector<RedliteBytes> values;
-        field_ptrs.reserve(fields.size());
-        values.reserve(fields.size());
-
-        for (const auto& [f, v] : fields) {
-            field_ptrs.push_back(f.c_str());
-            values.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(v.data())), v.size()});
-        }
+    StreamBatch xread(std::string_view key, StreamId after, int64_t count = 0) {
+        REDLITE_METRIC("xread", (key, after, count));
+        return take_stream(REDLITE_FFI(redlite_xread_len(db_, key.data(), key.size(), after.ms, after.seq,
+                                                         count, count > 0 ? 1 : 0)));
+    }
 
-        return redlite_hset(db_, std::string(key).c_str(),
-                           field_ptrs.data(), values.data(), fields.size());
+    /**
+     * XTRIM key MAXLEN maxlen
+     * @return Number of entries deleted
+     */
+    int64_t xtrim(std::string_view key, int64_t maxlen) {
+        REDLITE_METRIC("xtrim", (key, maxlen));
+        return REDLITE_FFI(redlite_xtrim_len(db_, key.data(), key.size(), maxlen));
     }
 
     /**
-     * HGET key field
+     * XDEL key id [id ...]
      */
-    std::optional<std::string> hget(std::string_view key, std::string_view field) {
-        RedliteBytes result = redlite_hget(db_, std::string(key).c_str(),
-                                           std::string(field).c_str());
-        if (!result.data) return std::nullopt;
-        Bytes b(result);
-        return b.to_string();
+    int64_t xdel(std::string_view key, const std::vector<StreamId>& ids) {
+        REDLITE_METRIC("xdel", (key, ids));
+        auto raw = to_stream_ids(ids);
+        return REDLITE_FFI(redlite_xdel_len(db_, key.data(), key.size(), raw.data(), raw.size()));
     }
 
     /**
-     * HDEL key field [field ...]
+     * XGROUP CREATE key group id [MKSTREAM]
+     * @param id Deliver entries after this ID ({0, 0} = from the start)
+     * @return true if the group was created
      */
-    int64_t hdel(std::string_view key, const std::vector<std::string>& fields) {
-        std::vector<const char*> field_ptrs;
-        field_ptrs.reserve(fields.size());
-        for (const auto& f : fields) field_ptrs.push_back(f.c_str());
-        return redlite_hdel(db_, std::string(key).c_str(),
-                           field_ptrs.data(), field_ptrs.size());
+    bool xgroup_create(std::string_view key, std::string_view group, StreamId id = {},
+                       bool mkstream = false) {
+        REDLITE_METRIC("xgroup_create", (key, group, id, mkstream));
+        return REDLITE_FFI(redlite_xgroup_create_len(db_, key.data(), key.size(), group.data(), group.size(),
+                                                     id.ms, id.seq, mkstream ? 1 : 0)) == 1;
     }
 
     /**
-     * HEXISTS key field
+     * XGROUP DESTROY key group
      */
-    bool hexists(std::string_view key, std::string_view field) {
-        return redlite_hexists(db_, std::string(key).c_str(),
-                              std::string(field).c_str()) == 1;
+    bool xgroup_destroy(std::string_view key, std::string_view group) {
+        REDLITE_METRIC("xgroup_destroy", (key, group));
+        return REDLITE_FFI(redlite_xgroup_destroy_len(db_, key.data(), key.size(), group.data(), group.size())) == 1;
     }
 
     /**
-     * HLEN key
+     * XGROUP SETID key group id
+     * @return false if the group doesn't exist
      */
-    int64_t hlen(std::string_view key) {
-        return redlite_hlen(db_, std::string(key).c_str());
+    bool xgroup_setid(std::string_view key, std::string_view group, StreamId id) {
+        REDLITE_METRIC("xgroup_setid", (key, group, id));
+        int64_t result = REDLITE_FFI(redlite_xgroup_setid_len(db_, key.data(), key.size(), group.data(),
+                                                              group.size(), id.ms, id.seq));
+        if (result < 0) throw Error::from_last_error();
+        return result == 1;
     }
 
     /**
-     * HKEYS key
+     * XGROUP CREATECONSUMER key group consumer
+     * @return true if the consumer was created
      */
-    std::vector<std::string> hkeys(std::string_view key) {
-        RedliteStringArray arr = redlite_hkeys(db_, std::string(key).c_str());
-        std::vector<std::string> result;
-        result.reserve(arr.len);
-        for (size_t i = 0; i < arr.len; ++i) {
-            result.emplace_back(arr.strings[i]);
-        }
-        redlite_free_string_array(arr);
-        return result;
+    bool xgroup_createconsumer(std::string_view key, std::string_view group, std::string_view consumer) {
+        REDLITE_METRIC("xgroup_createconsumer", (key, group, consumer));
+        int64_t result = REDLITE_FFI(redlite_xgroup_createconsumer_len(db_, key.data(), key.size(), group.data(),
+                                                                       group.size(), consumer.data(),
+                                                                       consumer.size()));
+        if (result < 0) throw Error::from_last_error();
+        return result == 1;
     }
 
     /**
-     * HVALS key
+     * XGROUP DELCONSUMER key group consumer
+     * @return Number of pending messages the consumer had
      */
-    std::vector<std::string> hvals(std::string_view key) {
-        RedliteBytesArray arr = redlite_hvals(db_, std::string(key).c_str());
-        std::vector<std::string> result;
-        result.reserve(arr.len);
-        for (size_t i = 0; i < arr.len; ++i) {
-            result.emplace_back(
-                reinterpret_cast<const char*>(arr.items[i].data),
-                arr.items[i].len);
-        }
-        redlite_free_bytes_array(arr);
+    int64_t xgroup_delconsumer(std::string_view key, std::string_view group, std::string_view consumer) {
+        REDLITE_METRIC("xgroup_delconsumer", (key, group, consumer));
+        int64_t result = REDLITE_FFI(redlite_xgroup_delconsumer_len(db_, key.data(), key.size(), group.data(),
+                                                                    group.size(), consumer.data(),
+                                                                    consumer.size()));
+        if (result < 0) throw Error::from_last_error();
         return result;
     }
 
     /**
-     * HINCRBY key field increment
+     * XREADGROUP GROUP group consumer [COUNT count] [NOACK] STREAMS key id
+     * @param id ">" for new entries, or an ID to re-read this consumer's pending entries
+     * @throws Error if the group doesn't exist
      */
-    int64_t hincrby(std::string_view key, std::string_view field, int64_t increment) {
-        return redlite_hincrby(db_, std::string(key).c_str(),
-                              std::string(field).c_str(), increment);
+    StreamBatch xreadgroup(std::string_view group, std::string_view consumer, std::string_view key,
+                           std::string_view id = ">", int64_t count = 0, bool noack = false) {
+        REDLITE_METRIC("xreadgroup", (group, consumer, key, id));
+        return take_stream(REDLITE_FFI(redlite_xreadgroup_len(db_, group.data(), group.size(), consumer.data(),
+                                                              consumer.size(), key.data(), key.size(), id.data(),
+                                                              id.size(), count, count > 0 ? 1 : 0, noack ? 1 : 0)));
     }
 
     /**
-     * HGETALL key
+     * XACK key group id [id ...] - acknowledges all IDs in one call
+     * @return Number of entries acknowledged
      */
-    std::unordered_map<std::string, std::string> hgetall(std::string_view key) {
-        RedliteBytesArray arr = redlite_hgetall(db_, std::string(key).c_str());
-        std::unordered_map<std::string, std::string> result;
-        for (size_t i = 0; i + 1 < arr.len; i += 2) {
-            std::string field(reinterpret_cast<const char*>(arr.items[i].data), arr.items[i].len);
-            std::string value(reinterpret_cast<const char*>(arr.items[i+1].data), arr.items[i+1].len);
-            result[field] = value;
-        }
-        redlite_free_bytes_array(arr);
+    int64_t xack(std::string_view key, std::string_view group, const std::vector<StreamId>& ids) {
+        REDLITE_METRIC("xack", (key, group, ids));
+        if (ids.empty()) return 0;
+        auto raw = to_stream_ids(ids);
+        int64_t result = REDLITE_FFI(redlite_xack_len(db_, key.data(), key.size(), group.data(), group.size(),
+                                                      raw.data(), raw.size()));
+        if (result < 0) throw Error::from_last_error();
         return result;
     }
 
+    // ==================== Vector Set Commands ====================
+
     /**
-     * HMGET key field [field ...]
+     * VADD key FP32 values element [SETATTR attributes]
+     * @return true if added, false if an existing element was updated
      */
-    std::vector<std::optional<std::string>> hmget(std::string_view key,
-                                                   const std::vector<std::string>& fields) {
-        std::vector<const char*> field_ptrs;
-        field_ptrs.reserve(fields.size());
-        for (const auto& f : fields) field_ptrs.push_back(f.c_str());
-
-        RedliteBytesArray arr = redlite_hmget(db_, std::string(key).c_str(),
-                                              field_ptrs.data(), field_ptrs.size());
-        std::vector<std::optional<std::string>> result;
-        result.reserve(arr.len);
-
-        for (size_t i = 0; i < arr.len; ++i) {
-            if (arr.items[i].data) {
-                result.emplace_back(std::string(
-                    reinterpret_cast<const char*>(arr.items[i].data),
-                    arr.items[i].len));
-            } else {
-                result.emplace_back(std::nullopt);
-            }
-        }
-
-        redlite_free_bytes_array(arr);
-        return result;
+    bool vadd(std::string_view key, const float* values, size_t dim, std::string_view element,
+              std::optional<std::string_view> attributes = std::nullopt) {
+        REDLITE_METRIC("vadd", (key, values, dim, element, attributes));
+        // A NULL attributes pointer means none; an empty view must not become one
+        const char* attrs = attributes ? (attributes->data() ? attributes->data() : "") : nullptr;
+        int result = REDLITE_FFI(redlite_vadd_len(db_, key.data(), key.size(), values, dim, element.data(),
+                                                  element.size(), attrs, attributes ? attributes->size() : 0));
+        if (result < 0) throw Error::from_last_error();
+        return result == 1;
     }
 
-    // ==================== List Commands ====================
+    bool vadd(std::string_view key, const std::vector<float>& values, std::string_view element,
+              std::optional<std::string_view> attributes = std::nullopt) {
+        REDLITE_METRIC("vadd", (key, values, element, attributes));
+        return vadd(key, values.data(), values.size(), element, attributes);
+    }
 
     /**
-     * LPUSH key value [value ...]
+     * VSIM key FP32 query COUNT capacity
+     *
+     * Writes up to `capacity` cosine scores, best first, into `scores`
+     * without allocating; pass `elements` to also receive the names.
+     * @param nprobe IVF lists to scan: -1 = default, 0 = exact scan
+     * @return Number of results written
      */
-    int64_t lpush(std::string_view key, const std::vector<std::string>& values) {
-        std::vector<RedliteBytes> bytes;
-        bytes.reserve(values.size());
-        for (const auto& v : values) {
-            bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(v.data())), v.size()});
+    size_t vsim(std::string_view key, const float* query, size_t dim, double* scores, size_t capacity,
+                std::vector<std::string>* elements = nullptr, int64_t nprobe = -1) {
+        REDLITE_METRIC("vsim", (key, query, dim, scores, capacity, elements, nprobe));
+        RedliteStringArray arr{nullptr, 0};
+        int64_t n = REDLITE_FFI(redlite_vsim_len(db_, key.data(), key.size(), query, dim, capacity, nprobe,
+                                                 elements ? &arr : nullptr, scores));
+        if (n < 0) throw Error::from_last_error();
+        if (elements) {
+            elements->clear();
+            elements->reserve(arr.len);
+            for (size_t i = 0; i < arr.len; ++i) elements->emplace_back(arr.strings[i]);
+            redlite_free_string_array(arr);
         }
-        return redlite_lpush(db_, std::string(key).c_str(), bytes.data(), bytes.size());
+        return static_cast<size_t>(n);
     }
 
-    int64_t lpush(std::string_view key, std::string_view value) {
-        RedliteBytes v = {reinterpret_cast<uint8_t*>(const_cast<char*>(value.data())), value.size()};
-        return redlite_lpush(db_, std::string(key).c_str(), &v, 1);
+    /**
+     * VSIM key FP32 query COUNT count into a vector; `scores` is resized to
+     * the number of results (reusing its capacity across calls)
+     */
+    size_t vsim(std::string_view key, const std::vector<float>& query, size_t count, std::vector<double>& scores,
+                std::vector<std::string>* elements = nullptr, int64_t nprobe = -1) {
+        REDLITE_METRIC("vsim", (key, query, count, scores, elements, nprobe));
+        scores.resize(count);
+        size_t n = vsim(key, query.data(), query.size(), scores.data(), count, elements, nprobe);
+        scores.resize(n);
+        return n;
     }
 
     /**
-     * RPUSH key value [value ...]
+     * VINDEX key [NLIST nlist] - build the IVF index used by vsim()
+     * @param nlist Number of lists (0 = sqrt of the cardinality)
+     * @return Number of lists built
      */
-    int64_t rpush(std::string_view key, const std::vector<std::string>& values) {
-        std::vector<RedliteBytes> bytes;
-        bytes.reserve(values.size());
-        for (const auto& v : values) {
-            bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(v.data())), v.size()});
-        }
-        return redlite_rpush(db_, std::string(key).c_str(), bytes.data(), bytes.size());
+    int64_t vindex(std::string_view key, size_t nlist = 0) {
+        REDLITE_METRIC("vindex", (key, nlist));
+        int64_t result = REDLITE_FFI(redlite_vindex_len(db_, key.data(), key.size(), nlist));
+        if (result < 0) throw Error::from_last_error();
+        return result;
     }
 
-    int64_t rpush(std::string_view key, std::string_view value) {
-        RedliteBytes v = {reinterpret_cast<uint8_t*>(const_cast<char*>(value.data())), value.size()};
-        return redlite_rpush(db_, std::string(key).c_str(), &v, 1);
+    /**
+     * Drop the IVF index; vsim() goes back to exact scans
+     * @return true if an index existed
+     */
+    bool vindex_drop(std::string_view key) {
+        REDLITE_METRIC("vindex_drop", (key));
+        int result = REDLITE_FFI(redlite_vindex_drop_len(db_, key.data(), key.size()));
+        if (result < 0) throw Error::from_last_error();
+        return result == 1;
     }
 
+#ifdef REDLITE_HAS_PMR
+    // ==================== Geo Commands ====================
+
     /**
-     * LPOP key [count]
+     * GEOADD key [NX|XX] [CH] longitude latitude member [...]
+     * @return Number of members added (or changed, with CH)
      */
-    std::vector<std::string> lpop(std::string_view key, size_t count = 1) {
-        RedliteBytesArray arr = redlite_lpop(db_, std::string(key).c_str(), count);
-        std::vector<std::string> result;
-        result.reserve(arr.len);
-        for (size_t i = 0; i < arr.len; ++i) {
-            result.emplace_back(
-                reinterpret_cast<const char*>(arr.items[i].data),
-                arr.items[i].len);
+    int64_t geoadd(std::string_view key, const std::vector<GeoMember>& members, const GeoAddOptions& opts = {}) {
+        REDLITE_METRIC("geoadd", (key, members.size()));
+        std::vector<RedliteGeoMember> raw;
+        raw.reserve(members.size());
+        for (const auto& m : members) {
+            raw.push_back({const_cast<char*>(m.member.c_str()), m.longitude, m.latitude, 0.0});
         }
-        redlite_free_bytes_array(arr);
+        int64_t result = REDLITE_FFI(redlite_geoadd_len(db_, key.data(), key.size(), raw.data(), raw.size(),
+                                                        opts.nx ? 1 : 0, opts.xx ? 1 : 0, opts.ch ? 1 : 0));
+        if (result < 0) throw Error::from_last_error();
         return result;
     }
 
     /**
-     * RPOP key [count]
+     * GEOPOS key member [member ...]
+     * @return One position per member, nullopt where the member is missing
      */
-    std::vector<std::string> rpop(std::string_view key, size_t count = 1) {
-        RedliteBytesArray arr = redlite_rpop(db_, std::string(key).c_str(), count);
-        std::vector<std::string> result;
-        result.reserve(arr.len);
-        for (size_t i = 0; i < arr.len; ++i) {
-            result.emplace_back(
-                reinterpret_cast<const char*>(arr.items[i].data),
-                arr.items[i].len);
+    std::vector<std::optional<GeoPos>> geopos(std::string_view key, const std::vector<std::string>& members) {
+        REDLITE_METRIC("geopos", (key, members));
+        auto bytes = member_bytes(members);
+        RedliteGeoPosArray arr = REDLITE_FFI(redlite_geopos_len(db_, key.data(), key.size(), bytes.data(), bytes.size()));
+        if (!arr.positions) throw_if_error();
+        std::vector<std::optional<GeoPos>> result(members.size());
+        for (size_t i = 0; i < arr.len && i < result.size(); ++i) {
+            if (arr.positions[i].exists) result[i] = GeoPos{arr.positions[i].longitude, arr.positions[i].latitude};
         }
-        redlite_free_bytes_array(arr);
+        redlite_free_geo_pos_array(arr);
         return result;
     }
 
     /**
-     * LLEN key
+     * GEODIST key member1 member2 [M|KM|FT|MI]
+     * @return nullopt if either member is missing
      */
-    int64_t llen(std::string_view key) {
-        return redlite_llen(db_, std::string(key).c_str());
+    std::optional<double> geodist(std::string_view key, std::string_view member1, std::string_view member2,
+                                  GeoUnit unit = GeoUnit::Meters) {
+        REDLITE_METRIC("geodist", (key, member1, member2));
+        double result = REDLITE_FFI(redlite_geodist_len(db_, key.data(), key.size(), member1.data(), member1.size(),
+                                                        member2.data(), member2.size(), static_cast<int>(unit)));
+        if (result < 0) {
+            throw_if_error();
+            return std::nullopt;
+        }
+        return result;
     }
 
     /**
-     * LRANGE key start stop
+     * GEOHASH key member [member ...]
+     * @return One 11-character geohash per member, nullopt where missing
      */
-    std::vector<std::string> lrange(std::string_view key, int64_t start, int64_t stop) {
-        RedliteBytesArray arr = redlite_lrange(db_, std::string(key).c_str(), start, stop);
-        std::vector<std::string> result;
-        result.reserve(arr.len);
-        for (size_t i = 0; i < arr.len; ++i) {
-            result.emplace_back(
-                reinterpret_cast<const char*>(arr.items[i].data),
-                arr.items[i].len);
+    std::vector<std::optional<std::string>> geohash(std::string_view key, const std::vector<std::string>& members) {
+        REDLITE_METRIC("geohash", (key, members));
+        auto bytes = member_bytes(members);
+        RedliteStringArray arr = REDLITE_FFI(redlite_geohash_len(db_, key.data(), key.size(), bytes.data(), bytes.size()));
+        if (!arr.strings) throw_if_error();
+        std::vector<std::optional<std::string>> result(members.size());
+        for (size_t i = 0; i < arr.len && i < result.size(); ++i) {
+            if (arr.strings[i]) result[i] = std::string(arr.strings[i]);
         }
-        redlite_free_bytes_array(arr);
+        redlite_free_string_array(arr);
         return result;
     }
 
     /**
-     * LINDEX key index
+     * GEOSEARCH key FROMMEMBER|FROMLONLAT BYRADIUS|BYBOX [ASC|DESC] [COUNT n [ANY]]
+     *   WITHCOORD WITHDIST, as zero-copy packed results
+     *
+     * Candidates come from the R*Tree over the search's bounding box, so the
+     * cost follows the number of nearby points, not the size of the key.
      */
-    std::optional<std::string> lindex(std::string_view key, int64_t index) {
-        RedliteBytes result = redlite_lindex(db_, std::string(key).c_str(), index);
-        if (!result.data) return std::nullopt;
-        Bytes b(result);
-        return b.to_string();
+    GeoHits geosearch(std::string_view key, const GeoSearchOptions& opts) {
+        REDLITE_METRIC("geosearch", (key, opts.radius, opts.width, opts.height, opts.count));
+        RedliteGeoSearchOptions raw{};
+        if (opts.from_member) {
+            raw.from_member = opts.from_member->data();
+            raw.from_member_len = opts.from_member->size();
+        }
+        raw.from_lon = opts.from_lon;
+        raw.from_lat = opts.from_lat;
+        raw.radius = opts.radius;
+        raw.width = opts.width;
+        raw.height = opts.height;
+        raw.unit = static_cast<int>(opts.unit);
+        raw.count = opts.count;
+        raw.any = opts.any ? 1 : 0;
+        raw.desc = opts.desc ? 1 : 0;
+        RedliteGeoHitArray arr = REDLITE_FFI(redlite_geosearch_hits(db_, key.data(), key.size(), &raw));
+        if (!arr.hits) throw_if_error();
+        return GeoHits(arr);
     }
 
-    // ==================== Set Commands ====================
-
     /**
-     * SADD key member [member ...]
+     * GEOSEARCHSTORE dest src ... BYRADIUS [COUNT n] [STOREDIST]
+     * Radius searches only; width/height, any and desc are ignored.
+     * @return Number of members stored
      */
-    int64_t sadd(std::string_view key, const std::vector<std::string>& members) {
-        std::vector<RedliteBytes> bytes;
-        bytes.reserve(members.size());
-        for (const auto& m : members) {
-            bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(m.data())), m.size()});
-        }
-        return redlite_sadd(db_, std::string(key).c_str(), bytes.data(), bytes.size());
+    int64_t geosearchstore(std::string_view dest, std::string_view src, const GeoSearchOptions& opts,
+                           bool store_dist = false) {
+        REDLITE_METRIC("geosearchstore", (dest, src, opts.radius, opts.count));
+        const char* from_member = opts.from_member ? opts.from_member->c_str() : nullptr;
+        size_t from_member_len = opts.from_member ? opts.from_member->size() : 0;
+        int64_t result = REDLITE_FFI(redlite_geosearchstore_len(db_, dest.data(), dest.size(), src.data(), src.size(),
+                                                                from_member, from_member_len, opts.from_lon,
+                                                                opts.from_lat, opts.radius, static_cast<int>(opts.unit),
+                                                                opts.count, store_dist ? 1 : 0));
+        if (result < 0) throw Error::from_last_error();
+        return result;
     }
 
-    int64_t sadd(std::string_view key, std::string_view member) {
-        RedliteBytes m = {reinterpret_cast<uint8_t*>(const_cast<char*>(member.data())), member.size()};
-        return redlite_sadd(db_, std::string(key).c_str(), &m, 1);
-    }
+    // ==================== Arena-backed Reads ====================
+    //
+    // Overloads that decode into `mr` (e.g. a ResultArena) instead of one
+    // heap-allocated std::string per element.
 
     /**
-     * SREM key member [member ...]
+     * MGET key [key ...] decoded into mr
      */
-    int64_t srem(std::string_view key, const std::vector<std::string>& members) {
-        std::vector<RedliteBytes> bytes;
-        bytes.reserve(members.size());
-        for (const auto& m : members) {
-            bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(m.data())), m.size()});
+    std::pmr::vector<std::optional<std::pmr::string>> mget(const std::vector<std::string>& keys,
+                                                           std::pmr::memory_resource* mr) {
+        REDLITE_METRIC("mget", (keys, mr));
+        std::vector<RedliteBytes> key_bytes;
+        key_bytes.reserve(keys.size());
+        for (const auto& k : keys) {
+            key_bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(k.data())), k.size()});
+        }
+
+        BytesArray arr(REDLITE_FFI(redlite_mget_len(db_, key_bytes.data(), key_bytes.size())));
+        std::pmr::vector<std::optional<std::pmr::string>> result(mr);
+        result.reserve(arr.size());
+        for (size_t i = 0; i < arr.size(); ++i) {
+            if (arr.is_nil(i)) result.emplace_back(std::nullopt);
+            else result.emplace_back(std::pmr::string(arr[i], mr));
         }
-        return redlite_srem(db_, std::string(key).c_str(), bytes.data(), bytes.size());
+        return result;
     }
 
     /**
-     * SMEMBERS key
+     * HKEYS key decoded into mr
      */
-    std::vector<std::string> smembers(std::string_view key) {
-        RedliteBytesArray arr = redlite_smembers(db_, std::string(key).c_str());
-        std::vector<std::string> result;
+    StringList hkeys(std::string_view key, std::pmr::memory_resource* mr) {
+        REDLITE_METRIC("hkeys", (key, mr));
+        RedliteStringArray arr = REDLITE_FFI(redlite_hkeys_len(db_, key.data(), key.size()));
+        StringList result(mr);
         result.reserve(arr.len);
         for (size_t i = 0; i < arr.len; ++i) {
-            result.emplace_back(
-                reinterpret_cast<const char*>(arr.items[i].data),
-                arr.items[i].len);
+            result.emplace_back(arr.strings[i]);
         }
-        redlite_free_bytes_array(arr);
+        redlite_free_string_array(arr);
         return result;
     }
 
     /**
-     * SISMEMBER key member
+     * HVALS key decoded into mr
      */
-    bool sismember(std::string_view key, std::string_view member) {
-        return redlite_sismember(db_, std::string(key).c_str(),
-                                reinterpret_cast<const uint8_t*>(member.data()),
-                                member.size()) == 1;
+    StringList hvals(std::string_view key, std::pmr::memory_resource* mr) {
+        REDLITE_METRIC("hvals", (key, mr));
+        return to_list(BytesArray(REDLITE_FFI(redlite_hvals_len(db_, key.data(), key.size()))), mr);
     }
 
     /**
-     * SCARD key
+     * LRANGE key start stop decoded into mr
      */
-    int64_t scard(std::string_view key) {
-        return redlite_scard(db_, std::string(key).c_str());
+    StringList lrange(std::string_view key, int64_t start, int64_t stop, std::pmr::memory_resource* mr) {
+        REDLITE_METRIC("lrange", (key, start, stop, mr));
+        return to_list(BytesArray(REDLITE_FFI(redlite_lrange_len(db_, key.data(), key.size(), start, stop))), mr);
     }
 
-    // ==================== Sorted Set Commands ====================
-
     /**
-     * ZADD key score member [score member ...]
+     * SMEMBERS key decoded into mr
      */
-    int64_t zadd(std::string_view key, const std::vector<ZMember>& members) {
-        std::vector<RedliteZMember> zm;
-        zm.reserve(members.size());
-        for (const auto& m : members) {
-            zm.push_back({m.score,
-                         reinterpret_cast<const uint8_t*>(m.member.data()),
-                         m.member.size()});
-        }
-        return redlite_zadd(db_, std::string(key).c_str(), zm.data(), zm.size());
+    StringList smembers(std::string_view key, std::pmr::memory_resource* mr) {
+        REDLITE_METRIC("smembers", (key, mr));
+        return to_list(BytesArray(REDLITE_FFI(redlite_smembers_len(db_, key.data(), key.size()))), mr);
     }
 
-    int64_t zadd(std::string_view key, double score, std::string_view member) {
-        RedliteZMember zm = {score,
-                            reinterpret_cast<const uint8_t*>(member.data()),
-                            member.size()};
-        return redlite_zadd(db_, std::string(key).c_str(), &zm, 1);
+    /**
+     * ZRANGE key start stop (members only) decoded into mr
+     */
+    StringList zrange(std::string_view key, int64_t start, int64_t stop, std::pmr::memory_resource* mr) {
+        REDLITE_METRIC("zrange", (key, start, stop, mr));
+        return to_list(BytesArray(REDLITE_FFI(redlite_zrange_len(db_, key.data(), key.size(), start, stop, 0))), mr);
     }
 
     /**
-     * ZREM key member [member ...]
+     * ZREVRANGE key start stop (members only) decoded into mr
      */
-    int64_t zrem(std::string_view key, const std::vector<std::string>& members) {
-        std::vector<RedliteBytes> bytes;
-        bytes.reserve(members.size());
-        for (const auto& m : members) {
-            bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(m.data())), m.size()});
-        }
-        return redlite_zrem(db_, std::string(key).c_str(), bytes.data(), bytes.size());
+    StringList zrevrange(std::string_view key, int64_t start, int64_t stop, std::pmr::memory_resource* mr) {
+        REDLITE_METRIC("zrevrange", (key, start, stop, mr));
+        return to_list(BytesArray(REDLITE_FFI(redlite_zrevrange_len(db_, key.data(), key.size(), start, stop, 0))), mr);
     }
+#endif
+
+    // ==================== Server Commands ====================
 
     /**
-     * ZSCORE key member
+     * VACUUM - Compact the database
      */
-    std::optional<double> zscore(std::string_view key, std::string_view member) {
-        double score = redlite_zscore(db_, std::string(key).c_str(),
-                                      reinterpret_cast<const uint8_t*>(member.data()),
-                                      member.size());
-        if (std::isnan(score)) return std::nullopt;
-        return score;
+    int64_t vacuum() {
+        REDLITE_METRIC("vacuum", ());
+        return REDLITE_FFI(redlite_vacuum(db_));
     }
 
     /**
-     * ZCARD key
+     * Enable or disable automatic cleanup of expired keys on this handle
      */
-    int64_t zcard(std::string_view key) {
-        return redlite_zcard(db_, std::string(key).c_str());
+    void set_autovacuum(bool enabled) {
+        REDLITE_METRIC("set_autovacuum", (enabled));
+        if (REDLITE_FFI(redlite_set_autovacuum(db_, enabled ? 1 : 0)) < 0) throw Error::from_last_error();
     }
 
     /**
-     * ZCOUNT key min max
+     * Set how often inline autovacuum runs, in milliseconds (minimum 1000)
      */
-    int64_t zcount(std::string_view key, double min, double max) {
-        return redlite_zcount(db_, std::string(key).c_str(), min, max);
+    void set_autovacuum_interval(int64_t interval_ms) {
+        REDLITE_METRIC("set_autovacuum_interval", (interval_ms));
+        if (REDLITE_FFI(redlite_set_autovacuum_interval(db_, interval_ms)) < 0) throw Error::from_last_error();
+    }
+
+    int64_t autovacuum_interval() {
+        REDLITE_METRIC("autovacuum_interval", ());
+        int64_t ms = REDLITE_FFI(redlite_autovacuum_interval(db_));
+        if (ms < 0) throw Error::from_last_error();
+        return ms;
     }
 
     /**
-     * ZINCRBY key increment member
+     * Set the time budget of one expiration / vacuum slice, in microseconds
+     * (minimum 100). Bounds both inline autovacuum and maintenance_step().
      */
-    double zincrby(std::string_view key, double increment, std::string_view member) {
-        return redlite_zincrby(db_, std::string(key).c_str(), increment,
-                              reinterpret_cast<const uint8_t*>(member.data()),
-                              member.size());
+    void set_autovacuum_budget(int64_t budget_us) {
+        REDLITE_METRIC("set_autovacuum_budget", (budget_us));
+        if (REDLITE_FFI(redlite_set_autovacuum_budget(db_, budget_us)) < 0) throw Error::from_last_error();
+    }
+
+    int64_t autovacuum_budget() {
+        REDLITE_METRIC("autovacuum_budget", ());
+        int64_t us = REDLITE_FFI(redlite_autovacuum_budget(db_));
+        if (us < 0) throw Error::from_last_error();
+        return us;
     }
 
     /**
-     * ZRANGE key start stop [WITHSCORES]
+     * Run one bounded maintenance slice: delete expired keys, evict keys
+     * over max_memory / max_disk, release free pages (incremental_vacuum
+     * databases), flush access stats and checkpoint the WAL when idle.
+     * Once it has run, writes no longer evict inline.
+     * @param budget_us Slice budget; 0 uses autovacuum_budget()
      */
-    std::vector<std::string> zrange(std::string_view key, int64_t start, int64_t stop) {
-        RedliteBytesArray arr = redlite_zrange(db_, std::string(key).c_str(),
-                                               start, stop, 0);
-        std::vector<std::string> result;
-        result.reserve(arr.len);
-        for (size_t i = 0; i < arr.len; ++i) {
-            result.emplace_back(
-                reinterpret_cast<const char*>(arr.items[i].data),
-                arr.items[i].len);
-        }
-        redlite_free_bytes_array(arr);
-        return result;
+    MaintenanceStep maintenance_step(int64_t budget_us = 0) {
+        REDLITE_METRIC("maintenance_step", (budget_us));
+        MaintenanceStep step{};
+        if (REDLITE_FFI(redlite_maintenance_step(db_, budget_us, &step)) < 0) throw Error::from_last_error();
+        return step;
     }
 
-    std::vector<ZMember> zrange_with_scores(std::string_view key, int64_t start, int64_t stop) {
-        RedliteBytesArray arr = redlite_zrange(db_, std::string(key).c_str(),
-                                               start, stop, 1);
-        std::vector<ZMember> result;
-        for (size_t i = 0; i + 1 < arr.len; i += 2) {
-            std::string member(reinterpret_cast<const char*>(arr.items[i].data), arr.items[i].len);
-            std::string score_str(reinterpret_cast<const char*>(arr.items[i+1].data), arr.items[i+1].len);
-            result.emplace_back(std::stod(score_str), member);
-        }
-        redlite_free_bytes_array(arr);
-        return result;
+    /**
+     * Slices run, keys reclaimed and evicted, pages freed and pause times so far
+     */
+    MaintenanceStats maintenance_stats() {
+        REDLITE_METRIC("maintenance_stats", ());
+        MaintenanceStats s{};
+        if (REDLITE_FFI(redlite_maintenance_stats(db_, &s)) < 0) throw Error::from_last_error();
+        return s;
     }
 
     /**
-     * ZREVRANGE key start stop [WITHSCORES]
+     * Checkpoint the WAL into the database file and truncate it
      */
-    std::vector<std::string> zrevrange(std::string_view key, int64_t start, int64_t stop) {
-        RedliteBytesArray arr = redlite_zrevrange(db_, std::string(key).c_str(),
-                                                  start, stop, 0);
-        std::vector<std::string> result;
-        result.reserve(arr.len);
-        for (size_t i = 0; i < arr.len; ++i) {
-            result.emplace_back(
-                reinterpret_cast<const char*>(arr.items[i].data),
-                arr.items[i].len);
-        }
-        redlite_free_bytes_array(arr);
-        return result;
+    void checkpoint() {
+        REDLITE_METRIC("checkpoint", ());
+        if (REDLITE_FFI(redlite_checkpoint(db_)) < 0) throw Error::from_last_error();
     }
 
-    // ==================== Server Commands ====================
-
     /**
-     * VACUUM - Compact the database
+     * Page cache, prepared statement, checkpoint and lock-wait counters
      */
-    int64_t vacuum() {
-        return redlite_vacuum(db_);
+    DatabaseStats stats() {
+        REDLITE_METRIC("stats", ());
+        DatabaseStats s{};
+        if (REDLITE_FFI(redlite_stats(db_, &s)) < 0) throw Error::from_last_error();
+        return s;
     }
 
     /**
@@ -1136,10 +4439,11 @@ public:
      */
     bool json_set(std::string_view key, std::string_view path, std::string_view value,
                   const JsonSetOptions& opts = {}) {
-        int result = redlite_json_set(db_, std::string(key).c_str(),
-                                      std::string(path).c_str(),
-                                      std::string(value).c_str(),
-                                      opts.nx ? 1 : 0, opts.xx ? 1 : 0);
+        REDLITE_METRIC("json_set", (key, path, value, opts));
+        int result = REDLITE_FFI(redlite_json_set(db_, std::string(key).c_str(),
+                                                  std::string(path).c_str(),
+                                                  std::string(value).c_str(),
+                                                  opts.nx ? 1 : 0, opts.xx ? 1 : 0));
         if (result < 0) throw Error::from_last_error();
         return result == 1;
     }
@@ -1150,25 +4454,66 @@ public:
      */
     std::optional<std::string> json_get(std::string_view key,
                                         const std::vector<std::string>& paths = {"$"}) {
+        REDLITE_METRIC("json_get", (key, paths));
         std::vector<const char*> path_ptrs;
         path_ptrs.reserve(paths.size());
         for (const auto& p : paths) path_ptrs.push_back(p.c_str());
 
-        char* result = redlite_json_get(db_, std::string(key).c_str(),
-                                        path_ptrs.data(), path_ptrs.size());
+        char* result = REDLITE_FFI(redlite_json_get(db_, std::string(key).c_str(),
+                                                    path_ptrs.data(), path_ptrs.size()));
         if (!result) return std::nullopt;
         std::string str(result);
         redlite_free_string(result);
         return str;
     }
 
+    /**
+     * Set several paths on one document, in order, with one parse and one
+     * write on the Rust side. Nothing is written if any value is invalid JSON.
+     * @return false (nothing written) if a path could not be set, like json_set
+     */
+    bool json_mset(std::string_view key,
+                   const std::vector<std::pair<std::string_view, std::string_view>>& updates) {
+        REDLITE_METRIC("json_mset", (key, updates));
+        std::vector<RedliteBytes> paths;
+        std::vector<RedliteBytes> values;
+        paths.reserve(updates.size());
+        values.reserve(updates.size());
+        for (const auto& [p, v] : updates) {
+            paths.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(p.data())), p.size()});
+            values.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(v.data())), v.size()});
+        }
+        int result = REDLITE_FFI(redlite_json_set_many(db_, key.data(), key.size(), paths.data(), values.data(),
+                                                       updates.size()));
+        if (result < 0) throw Error::from_last_error();
+        return result == 1;
+    }
+
+    /**
+     * Read several paths from one document, one JSON value per path (zero-copy).
+     * Plain paths ($.a.b[2]) are sliced out of the stored document without
+     * parsing it.
+     * @return is_nil(i) where nothing matched paths[i]
+     */
+    BytesArray json_mget(std::string_view key, const std::vector<std::string_view>& paths) {
+        REDLITE_METRIC("json_mget", (key, paths));
+        std::vector<RedliteBytes> path_bytes;
+        path_bytes.reserve(paths.size());
+        for (auto p : paths) path_bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(p.data())), p.size()});
+        RedliteBytesArray arr = REDLITE_FFI(redlite_json_get_many(db_, key.data(), key.size(), path_bytes.data(),
+                                                                  path_bytes.size()));
+        if (!arr.items) throw_if_error();
+        return BytesArray(arr);
+    }
+
     /**
      * JSON.DEL key [path]
      * @return Number of paths deleted
      */
     int64_t json_del(std::string_view key, std::string_view path = "$") {
-        return redlite_json_del(db_, std::string(key).c_str(),
-                               std::string(path).c_str());
+        REDLITE_METRIC("json_del", (key, path));
+        return REDLITE_FFI(redlite_json_del(db_, std::string(key).c_str(),
+                                           std::string(path).c_str()));
     }
 
     /**
@@ -1176,8 +4521,9 @@ public:
      * @return Type name or empty if not found
      */
     std::optional<std::string> json_type(std::string_view key, std::string_view path = "$") {
-        char* result = redlite_json_type(db_, std::string(key).c_str(),
-                                         std::string(path).c_str());
+        REDLITE_METRIC("json_type", (key, path));
+        char* result = REDLITE_FFI(redlite_json_type(db_, std::string(key).c_str(),
+                                                     std::string(path).c_str()));
         if (!result) return std::nullopt;
         std::string str(result);
         redlite_free_string(result);
@@ -1186,12 +4532,15 @@ public:
 
     /**
      * JSON.NUMINCRBY key path increment
+     * On a plain path only the number's bytes are rewritten, in place when
+     * the new number is as wide as the old one.
      * @return New value as JSON string
      */
     std::optional<std::string> json_numincrby(std::string_view key, std::string_view path,
                                                double increment) {
-        char* result = redlite_json_numincrby(db_, std::string(key).c_str(),
-                                              std::string(path).c_str(), increment);
+        REDLITE_METRIC("json_numincrby", (key, path, increment));
+        char* result = REDLITE_FFI(redlite_json_numincrby(db_, std::string(key).c_str(),
+                                                          std::string(path).c_str(), increment));
         if (!result) return std::nullopt;
         std::string str(result);
         redlite_free_string(result);
@@ -1203,9 +4552,10 @@ public:
      * @return New length of string
      */
     int64_t json_strappend(std::string_view key, std::string_view path, std::string_view value) {
-        int64_t result = redlite_json_strappend(db_, std::string(key).c_str(),
-                                                std::string(path).c_str(),
-                                                std::string(value).c_str());
+        REDLITE_METRIC("json_strappend", (key, path, value));
+        int64_t result = REDLITE_FFI(redlite_json_strappend(db_, std::string(key).c_str(),
+                                                            std::string(path).c_str(),
+                                                            std::string(value).c_str()));
         if (result < 0) throw Error::from_last_error();
         return result;
     }
@@ -1215,8 +4565,9 @@ public:
      * @return Length of string
      */
     int64_t json_strlen(std::string_view key, std::string_view path = "$") {
-        return redlite_json_strlen(db_, std::string(key).c_str(),
-                                   std::string(path).c_str());
+        REDLITE_METRIC("json_strlen", (key, path));
+        return REDLITE_FFI(redlite_json_strlen(db_, std::string(key).c_str(),
+                                               std::string(path).c_str()));
     }
 
     /**
@@ -1225,13 +4576,14 @@ public:
      */
     int64_t json_arrappend(std::string_view key, std::string_view path,
                            const std::vector<std::string>& values) {
+        REDLITE_METRIC("json_arrappend", (key, path, values));
         std::vector<const char*> value_ptrs;
         value_ptrs.reserve(values.size());
         for (const auto& v : values) value_ptrs.push_back(v.c_str());
 
-        int64_t result = redlite_json_arrappend(db_, std::string(key).c_str(),
-                                                std::string(path).c_str(),
-                                                value_ptrs.data(), value_ptrs.size());
+        int64_t result = REDLITE_FFI(redlite_json_arrappend(db_, std::string(key).c_str(),
+                                                            std::string(path).c_str(),
+                                                            value_ptrs.data(), value_ptrs.size()));
         if (result < 0) throw Error::from_last_error();
         return result;
     }
@@ -1241,8 +4593,9 @@ public:
      * @return Length of array
      */
     int64_t json_arrlen(std::string_view key, std::string_view path = "$") {
-        return redlite_json_arrlen(db_, std::string(key).c_str(),
-                                   std::string(path).c_str());
+        REDLITE_METRIC("json_arrlen", (key, path));
+        return REDLITE_FFI(redlite_json_arrlen(db_, std::string(key).c_str(),
+                                               std::string(path).c_str()));
     }
 
     /**
@@ -1251,8 +4604,9 @@ public:
      */
     std::optional<std::string> json_arrpop(std::string_view key, std::string_view path = "$",
                                             int64_t index = -1) {
-        char* result = redlite_json_arrpop(db_, std::string(key).c_str(),
-                                           std::string(path).c_str(), index);
+        REDLITE_METRIC("json_arrpop", (key, path, index));
+        char* result = REDLITE_FFI(redlite_json_arrpop(db_, std::string(key).c_str(),
+                                                       std::string(path).c_str(), index));
         if (!result) return std::nullopt;
         std::string str(result);
         redlite_free_string(result);
@@ -1264,43 +4618,45 @@ public:
      * @return Number of values cleared
      */
     int64_t json_clear(std::string_view key, std::string_view path = "$") {
-        return redlite_json_clear(db_, std::string(key).c_str(),
-                                  std::string(path).c_str());
+        REDLITE_METRIC("json_clear", (key, path));
+        return REDLITE_FFI(redlite_json_clear(db_, std::string(key).c_str(),
+                                              std::string(path).c_str()));
     }
 
     // ==================== History Commands ====================
 
     /**
      * Enable history tracking globally
-     * @param retention_type "unlimited", "time", or "count"
+     * @param retention_type Unlimited, Time or Count
      * @param retention_value Value for time (ms) or count retention
      */
-    void history_enable_global(std::string_view retention_type = "unlimited",
+    void history_enable_global(RetentionType retention_type = RetentionType::Unlimited,
                                int64_t retention_value = 0) {
-        int result = redlite_history_enable_global(db_, std::string(retention_type).c_str(),
-                                                   retention_value);
+        REDLITE_METRIC("history_enable_global", (retention_type, retention_value));
+        int result = REDLITE_FFI(redlite_history_enable_global(db_, static_cast<int>(retention_type),
+                                                               retention_value));
         if (result < 0) throw Error::from_last_error();
     }
 
     /**
      * Enable history tracking for a specific database
      */
-    void history_enable_database(int db_num, std::string_view retention_type = "unlimited",
+    void history_enable_database(int db_num, RetentionType retention_type = RetentionType::Unlimited,
                                  int64_t retention_value = 0) {
-        int result = redlite_history_enable_database(db_, db_num,
-                                                     std::string(retention_type).c_str(),
-                                                     retention_value);
+        REDLITE_METRIC("history_enable_database", (db_num, retention_type, retention_value));
+        int result = REDLITE_FFI(redlite_history_enable_database(db_, db_num, static_cast<int>(retention_type),
+                                                                 retention_value));
         if (result < 0) throw Error::from_last_error();
     }
 
     /**
      * Enable history tracking for a specific key
      */
-    void history_enable_key(std::string_view key, std::string_view retention_type = "unlimited",
+    void history_enable_key(std::string_view key, RetentionType retention_type = RetentionType::Unlimited,
                             int64_t retention_value = 0) {
-        int result = redlite_history_enable_key(db_, std::string(key).c_str(),
-                                                std::string(retention_type).c_str(),
-                                                retention_value);
+        REDLITE_METRIC("history_enable_key", (key, retention_type, retention_value));
+        int result = REDLITE_FFI(redlite_history_enable_key(db_, std::string(key).c_str(),
+                                                            static_cast<int>(retention_type), retention_value));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1308,7 +4664,8 @@ public:
      * Disable history tracking globally
      */
     void history_disable_global() {
-        int result = redlite_history_disable_global(db_);
+        REDLITE_METRIC("history_disable_global", ());
+        int result = REDLITE_FFI(redlite_history_disable_global(db_));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1316,7 +4673,8 @@ public:
      * Disable history tracking for a specific database
      */
     void history_disable_database(int db_num) {
-        int result = redlite_history_disable_database(db_, db_num);
+        REDLITE_METRIC("history_disable_database", (db_num));
+        int result = REDLITE_FFI(redlite_history_disable_database(db_, db_num));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1324,7 +4682,8 @@ public:
      * Disable history tracking for a specific key
      */
     void history_disable_key(std::string_view key) {
-        int result = redlite_history_disable_key(db_, std::string(key).c_str());
+        REDLITE_METRIC("history_disable_key", (key));
+        int result = REDLITE_FFI(redlite_history_disable_key(db_, std::string(key).c_str()));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1332,7 +4691,62 @@ public:
      * Check if history tracking is enabled for a key
      */
     bool is_history_enabled(std::string_view key) {
-        return redlite_is_history_enabled(db_, std::string(key).c_str()) == 1;
+        REDLITE_METRIC("is_history_enabled", (key));
+        return REDLITE_FFI(redlite_is_history_enabled(db_, std::string(key).c_str())) == 1;
+    }
+
+    /**
+     * HISTORY GET key [LIMIT limit] [SINCE ms] [UNTIL ms]; 0 leaves a bound off
+     */
+    HistoryEntries history_get(std::string_view key, int64_t limit = 0, int64_t since = 0, int64_t until = 0) {
+        REDLITE_METRIC("history_get", (key, limit, since, until));
+        RedliteHistoryEntryArray arr = REDLITE_FFI(redlite_history_get_len(db_, key.data(), key.size(), limit, since, until));
+        if (!arr.entries) throw_if_error();
+        return HistoryEntries(arr);
+    }
+
+    /**
+     * HISTORY GETAT key timestamp - the value as of `timestamp_ms` (zero-copy)
+     * @return nullopt if the key had no value then
+     */
+    std::optional<Bytes> history_getat(std::string_view key, int64_t timestamp_ms) {
+        REDLITE_METRIC("history_getat", (key, timestamp_ms));
+        RedliteBytes b = REDLITE_FFI(redlite_history_getat_len(db_, key.data(), key.size(), timestamp_ms));
+        if (!b.data) {
+            throw_if_error();
+            return std::nullopt;
+        }
+        return Bytes(b);
+    }
+
+    /**
+     * HISTORY CLEAR key [BEFORE ms]; 0 clears everything
+     * @return Number of entries deleted
+     */
+    int64_t history_clear(std::string_view key, int64_t before = 0) {
+        REDLITE_METRIC("history_clear", (key, before));
+        int64_t result = REDLITE_FFI(redlite_history_clear_len(db_, key.data(), key.size(), before));
+        if (result < 0) throw Error::from_last_error();
+        return result;
+    }
+
+    /**
+     * HISTORY PRUNE before - delete every entry older than `before_ms`
+     *
+     * Runs as separate calls of `batch` entries, so other threads using this
+     * Database get a turn between them.
+     * @return Number of entries deleted
+     */
+    int64_t history_prune(int64_t before_ms, int64_t batch = 1000) {
+        REDLITE_METRIC("history_prune", (before_ms, batch));
+        if (batch <= 0) batch = 1000;
+        int64_t total = 0;
+        for (;;) {
+            int64_t n = REDLITE_FFI(redlite_history_prune_batch(db_, before_ms, batch));
+            if (n < 0) throw Error::from_last_error();
+            total += n;
+            if (n < batch) return total;
+        }
     }
 
     // ==================== FTS Commands ====================
@@ -1341,7 +4755,8 @@ public:
      * Enable FTS indexing globally
      */
     void fts_enable_global() {
-        int result = redlite_fts_enable_global(db_);
+        REDLITE_METRIC("fts_enable_global", ());
+        int result = REDLITE_FFI(redlite_fts_enable_global(db_));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1349,7 +4764,8 @@ public:
      * Enable FTS indexing for a specific database
      */
     void fts_enable_database(int db_num) {
-        int result = redlite_fts_enable_database(db_, db_num);
+        REDLITE_METRIC("fts_enable_database", (db_num));
+        int result = REDLITE_FFI(redlite_fts_enable_database(db_, db_num));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1357,7 +4773,8 @@ public:
      * Enable FTS indexing for keys matching a pattern
      */
     void fts_enable_pattern(std::string_view pattern) {
-        int result = redlite_fts_enable_pattern(db_, std::string(pattern).c_str());
+        REDLITE_METRIC("fts_enable_pattern", (pattern));
+        int result = REDLITE_FFI(redlite_fts_enable_pattern(db_, std::string(pattern).c_str()));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1365,7 +4782,8 @@ public:
      * Enable FTS indexing for a specific key
      */
     void fts_enable_key(std::string_view key) {
-        int result = redlite_fts_enable_key(db_, std::string(key).c_str());
+        REDLITE_METRIC("fts_enable_key", (key));
+        int result = REDLITE_FFI(redlite_fts_enable_key(db_, std::string(key).c_str()));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1373,7 +4791,8 @@ public:
      * Disable FTS indexing globally
      */
     void fts_disable_global() {
-        int result = redlite_fts_disable_global(db_);
+        REDLITE_METRIC("fts_disable_global", ());
+        int result = REDLITE_FFI(redlite_fts_disable_global(db_));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1381,7 +4800,8 @@ public:
      * Disable FTS indexing for a specific database
      */
     void fts_disable_database(int db_num) {
-        int result = redlite_fts_disable_database(db_, db_num);
+        REDLITE_METRIC("fts_disable_database", (db_num));
+        int result = REDLITE_FFI(redlite_fts_disable_database(db_, db_num));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1389,7 +4809,8 @@ public:
      * Disable FTS indexing for keys matching a pattern
      */
     void fts_disable_pattern(std::string_view pattern) {
-        int result = redlite_fts_disable_pattern(db_, std::string(pattern).c_str());
+        REDLITE_METRIC("fts_disable_pattern", (pattern));
+        int result = REDLITE_FFI(redlite_fts_disable_pattern(db_, std::string(pattern).c_str()));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1397,7 +4818,8 @@ public:
      * Disable FTS indexing for a specific key
      */
     void fts_disable_key(std::string_view key) {
-        int result = redlite_fts_disable_key(db_, std::string(key).c_str());
+        REDLITE_METRIC("fts_disable_key", (key));
+        int result = REDLITE_FFI(redlite_fts_disable_key(db_, std::string(key).c_str()));
         if (result < 0) throw Error::from_last_error();
     }
 
@@ -1405,7 +4827,71 @@ public:
      * Check if FTS indexing is enabled for a key
      */
     bool is_fts_enabled(std::string_view key) {
-        return redlite_is_fts_enabled(db_, std::string(key).c_str()) == 1;
+        REDLITE_METRIC("is_fts_enabled", (key));
+        return REDLITE_FFI(redlite_is_fts_enabled(db_, std::string(key).c_str())) == 1;
+    }
+
+    // ==================== Search Commands ====================
+
+    /**
+     * FT.CREATE index ON HASH|JSON PREFIX n prefix... SCHEMA ...
+     */
+    void ft_create(std::string_view index, const std::vector<std::string>& prefixes,
+                   const std::vector<FtSchemaField>& schema, bool on_json = false) {
+        REDLITE_METRIC("ft_create", (index, prefixes));
+        std::vector<RedliteBytes> raw_prefixes;
+        raw_prefixes.reserve(prefixes.size());
+        for (const auto& p : prefixes) {
+            raw_prefixes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(p.data())), p.size()});
+        }
+        std::vector<RedliteFtSchemaField> fields;
+        fields.reserve(schema.size());
+        for (const auto& f : schema) {
+            fields.push_back({f.name.data(), f.name.size(), static_cast<int>(f.type), f.sortable ? 1 : 0, f.weight});
+        }
+        int result = REDLITE_FFI(redlite_ft_create_schema(db_, index.data(), index.size(), on_json ? 1 : 0,
+                                                          raw_prefixes.data(), raw_prefixes.size(),
+                                                          fields.data(), fields.size()));
+        if (result < 0) throw Error::from_last_error();
+    }
+
+    /**
+     * FT.DROPINDEX index [DD]
+     * @return false if the index didn't exist
+     */
+    bool ft_dropindex(std::string_view index, bool delete_docs = false) {
+        REDLITE_METRIC("ft_dropindex", (index));
+        int64_t result = REDLITE_FFI(redlite_ft_dropindex(db_, std::string(index).c_str(), delete_docs ? 1 : 0));
+        if (result < 0) throw Error::from_last_error();
+        return result == 1;
+    }
+
+    /**
+     * Number of documents matching `query` (FT.SEARCH ... LIMIT 0 0)
+     */
+    int64_t ft_count(std::string_view index, std::string_view query) {
+        REDLITE_METRIC("ft_count", (index, query));
+        int64_t result = REDLITE_FFI(redlite_ft_search(db_, std::string(index).c_str(), std::string(query).c_str()));
+        if (result < 0) throw Error::from_last_error();
+        return result;
+    }
+
+    /**
+     * FT.SEARCH index query, one page (opts.offset, opts.num) of zero-copy hits
+     */
+    FtHits ft_search(std::string_view index, std::string_view query, const FtSearchOptions& opts = {}) {
+        REDLITE_METRIC("ft_search", (index, query));
+        return detail::ft_search_page(db_, index, query, opts);
+    }
+
+    /**
+     * FT.SEARCH index query over every match from opts.offset, fetched
+     * `page_size` hits at a time; opts.num is ignored
+     */
+    FtSearch ft_search_iter(std::string_view index, std::string_view query, FtSearchOptions opts = {},
+                            size_t page_size = 100) {
+        REDLITE_METRIC("ft_search_iter", (index, query, page_size));
+        return FtSearch(db_, index, query, std::move(opts), page_size);
     }
 
     // ==================== KeyInfo Command ====================
@@ -1415,7 +4901,8 @@ public:
      * @return KeyInfo or empty if key doesn't exist
      */
     std::optional<KeyInfo> keyinfo(std::string_view key) {
-        RedliteKeyInfo info = redlite_keyinfo(db_, std::string(key).c_str());
+        REDLITE_METRIC("keyinfo", (key));
+        RedliteKeyInfo info = REDLITE_FFI(redlite_keyinfo(db_, std::string(key).c_str()));
 
         if (info.valid == 0) {
             redlite_free_keyinfo(info);
@@ -1432,8 +4919,207 @@ public:
         return result;
     }
 
+    /**
+     * Version stamp of a key, for validating client-side caches
+     * @return KeyVersion or empty if key doesn't exist
+     */
+    std::optional<KeyVersion> key_version(std::string_view key) {
+        REDLITE_METRIC("key_version", (key));
+        RedliteKeyVersion v{};
+        int rc = REDLITE_FFI(redlite_key_version_len(db_, key.data(), key.size(), &v));
+        if (rc < 0) throw Error::from_last_error();
+        if (rc == 0) return std::nullopt;
+        return KeyVersion{v.version, v.created_at};
+    }
+
+    // ==================== Transactions ====================
+
+    /**
+     * Start an explicit transaction (BEGIN IMMEDIATE)
+     * @throws Error if a transaction is already open
+     */
+    Transaction transaction() { return Transaction(db_); }
+
+    /**
+     * Whether an explicit transaction is currently open
+     */
+    bool in_transaction() {
+        REDLITE_METRIC("in_transaction", ());
+        return REDLITE_FFI(redlite_in_transaction(db_)) == 1;
+    }
+
+    // ==================== Bulk Load ====================
+    // Low-level entry points; BulkLoader (redlite/bulk.hpp) wraps them.
+
+    /**
+     * Prepare for a bulk load. With defer_indexes, secondary indexes on the
+     * key metadata and sorted-set scores are dropped until bulk_finish().
+     */
+    void bulk_begin(bool defer_indexes) {
+        REDLITE_METRIC("bulk_begin", (defer_indexes));
+        if (REDLITE_FFI(redlite_bulk_begin(db_, defer_indexes ? 1 : 0)) != 0) {
+            throw Error::from_last_error();
+        }
+    }
+
+    /**
+     * Write a batch of records in one savepoint using reused statements.
+     * A failing record (e.g. WRONGTYPE) rolls back the whole batch.
+     * @param defer_fts Skip full-text indexing (backfilled by bulk_finish(true))
+     * @return Number of records written
+     */
+    int64_t bulk_load(const RedliteBulkRecord* records, size_t len, bool defer_fts) {
+        REDLITE_METRIC("bulk_load", (records, len, defer_fts));
+        int64_t n = REDLITE_FFI(redlite_bulk_load(db_, records, len, defer_fts ? 1 : 0));
+        if (n < 0) throw Error::from_last_error();
+        return n;
+    }
+
+    /**
+     * Recreate deferred indexes and, with reindex_fts, index every string
+     * and hash key for full-text search. Safe to call without bulk_begin().
+     */
+    void bulk_finish(bool reindex_fts) {
+        REDLITE_METRIC("bulk_finish", (reindex_fts));
+        if (REDLITE_FFI(redlite_bulk_finish(db_, reindex_fts ? 1 : 0)) != 0) {
+            throw Error::from_last_error();
+        }
+    }
+
+    // ==================== Snapshots ====================
+
+    /**
+     * Write every key of every database to a checksummed snapshot file.
+     * The file is written from one read transaction; file databases are read
+     * on a separate connection, so writers are not blocked meanwhile.
+     * Expired keys, stream consumer groups, vector sets, history and
+     * FT.CREATE indexes are not included.
+     */
+    SnapshotStats export_snapshot(const std::string& path) {
+        REDLITE_METRIC("export_snapshot", (path));
+        SnapshotStats stats{};
+        if (REDLITE_FFI(redlite_export_snapshot(db_, path.c_str(), &stats)) != 0) {
+            throw Error::from_last_error();
+        }
+        return stats;
+    }
+
+    /**
+     * Load a snapshot file through the bulk-load path. Keys in the snapshot
+     * replace keys of the same name; other keys are left alone. The load is
+     * one transaction: a corrupt or truncated file throws and changes nothing.
+     */
+    SnapshotStats import_snapshot(const std::string& path) {
+        REDLITE_METRIC("import_snapshot", (path));
+        SnapshotStats stats{};
+        if (REDLITE_FFI(redlite_import_snapshot(db_, path.c_str(), &stats)) != 0) {
+            throw Error::from_last_error();
+        }
+        return stats;
+    }
+
+    // ==================== Pipeline ====================
+
+    /**
+     * Create a command pipeline bound to this database
+     */
+    Pipeline pipeline() { return Pipeline(db_); }
+
 private:
     explicit Database(RedliteDb* db) : db_(db) {}
+
+    template <typename Fields>
+    StreamId xadd_fields(std::string_view key, const Fields& fields, const XAddOptions& opts) {
+        std::vector<RedliteStreamField> raw;
+        for (const auto& [name, value] : fields) {
+            std::string_view n(name), v(value);
+            raw.push_back({reinterpret_cast<const uint8_t*>(n.data()), n.size(),
+                           reinterpret_cast<const uint8_t*>(v.data()), v.size()});
+        }
+        RedliteStreamId id = REDLITE_FFI(redlite_xadd_len(db_, key.data(), key.size(), opts.id.ms, opts.id.seq,
+                                                          raw.data(), raw.size(), opts.nomkstream ? 1 : 0,
+                                                          opts.maxlen.value_or(0), opts.maxlen ? 1 : 0));
+        if (id.ms < 0) throw Error::from_last_error();
+        detail::StreamSignal::for_key(key).notify();
+        return {id.ms, id.seq};
+    }
+
+    // Empty results are also how the FFI reports errors; tell them apart
+    static void throw_if_error() {
+        if (char* err = redlite_last_error()) {
+            std::string msg(err);
+            redlite_free_string(err);
+            throw Error(msg);
+        }
+    }
+
+    static StreamBatch take_stream(RedliteStreamEntryArray arr) {
+        if (!arr.entries) throw_if_error();
+        return StreamBatch(arr);
+    }
+
+    static std::vector<RedliteBytes> member_bytes(const std::vector<std::string>& members) {
+        std::vector<RedliteBytes> bytes;
+        bytes.reserve(members.size());
+        for (const auto& m : members) bytes.push_back({reinterpret_cast<uint8_t*>(const_cast<char*>(m.data())), m.size()});
+        return bytes;
+    }
+
+    static std::vector<RedliteStreamId> to_stream_ids(const std::vector<StreamId>& ids) {
+        std::vector<RedliteStreamId> raw;
+        raw.reserve(ids.size());
+        for (const auto& id : ids) raw.push_back({id.ms, id.seq});
+        return raw;
+    }
+
+    // ZRANK/ZREVRANK reply: -1 = no such member, -2 = error
+    static std::optional<int64_t> rank_result(int64_t rank) {
+        if (rank == -2) throw Error::from_last_error();
+        if (rank < 0) return std::nullopt;
+        return rank;
+    }
+
+    static constexpr size_t kInlinePushValues = 32;
+
+    template <typename Push>
+    int64_t push_views(Push push, std::string_view key, const std::string_view* values, size_t count) {
+        std::array<RedliteBytes, kInlinePushValues> inline_bytes;
+        std::vector<RedliteBytes> heap_bytes;
+        RedliteBytes* bytes = inline_bytes.data();
+        if (count > inline_bytes.size()) {
+            heap_bytes.resize(count);
+            bytes = heap_bytes.data();
+        }
+        for (size_t i = 0; i < count; ++i) {
+            bytes[i] = {reinterpret_cast<uint8_t*>(const_cast<char*>(values[i].data())), values[i].size()};
+        }
+        return REDLITE_FFI(push(db_, key.data(), key.size(), bytes, count));
+    }
+
+    template <typename Store>
+    int64_t zstore(Store store, std::string_view destination, const std::vector<std::string>& keys,
+                   const std::vector<double>& weights, std::string_view aggregate) {
+        std::vector<const char*> key_ptrs;
+        key_ptrs.reserve(keys.size());
+        for (const auto& k : keys) key_ptrs.push_back(k.c_str());
+        std::string agg(aggregate);
+        int64_t result = REDLITE_FFI(store(db_, std::string(destination).c_str(), key_ptrs.data(), key_ptrs.size(),
+                                           weights.empty() ? nullptr : weights.data(), weights.size(),
+                                           agg.empty() ? nullptr : agg.c_str()));
+        if (result < 0) throw Error::from_last_error();
+        return result;
+    }
+
+#ifdef REDLITE_HAS_PMR
+    // Elements are allocated from the list's resource via uses-allocator construction
+    static StringList to_list(const BytesArray& arr, std::pmr::memory_resource* mr) {
+        StringList result(mr);
+        result.reserve(arr.size());
+        for (auto v : arr) result.emplace_back(v);
+        return result;
+    }
+#endif
+
     RedliteDb* db_;
 };
 
@@ -0,0 +1,450 @@
+/**
+ * Redlite C++ SDK - sharded database
+ *
+ * ShardedDatabase hash-partitions keys across N database files, each driven
+ * by its own AsyncDatabase worker. Every file has its own SQLite writer, so
+ * write throughput scales with the number of shards instead of stopping at
+ * one core. Multi-key commands fan out to the shards involved in parallel.
+ */
+
+#ifndef REDLITE_SHARDED_HPP
+#define REDLITE_SHARDED_HPP
+
+#include "async.hpp"
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace redlite {
+
+class ShardedDatabase;
+
+/**
+ * SCAN over every shard as one keyspace, in ascending key order
+ *
+ * Each shard's cursor yields sorted keys and shards hold disjoint keys, so
+ * a k-way merge of the pages gives the same order as a single database.
+ * Every shard keeps at most its current page plus one page being fetched
+ * by its worker. Elements are views into those pages and are invalidated
+ * when the iterator moves past them. The ShardedDatabase must outlive the
+ * range.
+ */
+class ShardedScan {
+public:
+    using value_type = std::string_view;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = value_type;
+
+        iterator() : range_(nullptr) {}
+        explicit iterator(ShardedScan* range) : range_(range) {}
+
+        value_type operator*() const { return range_->current(); }
+
+        iterator& operator++() { range_->next(); return *this; }
+        void operator++(int) { range_->next(); }
+
+        bool operator==(const iterator& other) const { return at_end() == other.at_end(); }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        bool at_end() const { return !range_ || range_->heap_.empty(); }
+
+        ShardedScan* range_;
+    };
+
+    ShardedScan(ShardedScan&&) = default;
+    ShardedScan& operator=(ShardedScan&&) = delete;
+    ShardedScan(const ShardedScan&) = delete;
+    ShardedScan& operator=(const ShardedScan&) = delete;
+
+    /**
+     * Fetch the first page of every shard; a range can only be iterated once
+     * @throws Error if a shard's scan fails
+     */
+    iterator begin() {
+        if (!started_) {
+            started_ = true;
+            for (size_t i = 0; i < cursors_.size(); ++i) request(i);
+            for (size_t i = 0; i < cursors_.size(); ++i) advance_page(i);
+        }
+        return iterator(this);
+    }
+
+    iterator end() { return iterator(); }
+
+private:
+    friend class ShardedDatabase;
+
+    struct Cursor {
+        ScanPage page;
+        size_t pos = 0;
+        Future<ScanPage> pending;   // Next page, requested from the worker
+    };
+
+    // (key, shard) with the smallest key on top
+    using Head = std::pair<std::string_view, size_t>;
+
+    ShardedScan(std::vector<AsyncDatabase*> shards, std::string_view pattern, size_t count)
+        : shards_(std::move(shards)), pattern_(pattern), count_(count ? count : 1), cursors_(shards_.size()) {}
+
+    value_type current() const { return heap_.top().first; }
+
+    void next() {
+        size_t shard = heap_.top().second;
+        heap_.pop();
+        Cursor& c = cursors_[shard];
+        if (++c.pos < c.page.keys.size()) {
+            heap_.push({c.page.keys[c.pos], shard});
+        } else {
+            advance_page(shard);
+        }
+    }
+
+    void request(size_t shard) {
+        std::string cursor = cursors_[shard].page.cursor.empty() ? "0" : cursors_[shard].page.cursor;
+        cursors_[shard].pending = shards_[shard]->submit(
+            [cursor = std::move(cursor), pattern = pattern_, count = count_](Database& db) {
+                return db.scan_page(cursor, pattern, count);
+            });
+    }
+
+    // Swap in the requested page, skipping empty ones, and prefetch the next
+    void advance_page(size_t shard) {
+        Cursor& c = cursors_[shard];
+        for (;;) {
+            if (!c.pending.valid()) return;
+            c.page = c.pending.get();
+            c.pos = 0;
+            if (c.page.cursor != "0") request(shard);
+            if (!c.page.keys.empty()) break;
+        }
+        heap_.push({c.page.keys[0], shard});
+    }
+
+    std::vector<AsyncDatabase*> shards_;
+    std::string pattern_;
+    size_t count_;
+    std::vector<Cursor> cursors_;
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap_;
+    bool started_ = false;
+};
+
+/**
+ * Keys hash-partitioned across several database files
+ *
+ *   ShardedDatabase db("ingest.db", 8);   // ingest.0.db ... ingest.7.db
+ *   db.set("user:1", "alice");             // one shard's writer
+ *   db.hset("{user:1}:profile", "name", "alice");  // same shard as user:1
+ *   auto values = db.mget({"a", "b", "c"});        // shards queried in parallel
+ *   for (auto key : db.scan("user:*")) { ... }
+ *
+ * Keys are routed by the FNV-1a hash of their hash tag: the text between
+ * the first '{' and the next '}', when that is non-empty, as in Redis
+ * Cluster; otherwise the whole key. Commands on keys that share a tag
+ * always reach the same shard.
+ *
+ * Every shard is an AsyncDatabase, so calls from any number of threads are
+ * queued to the owning shard's worker, and concurrent writes to a shard
+ * share one transaction. The methods below block until their shards reply;
+ * use submit()/submit_write() for futures. Multi-key writes are atomic per
+ * shard, not across shards.
+ *
+ * Routing depends on the shard count: always reopen a set of files with the
+ * count it was created with.
+ */
+class ShardedDatabase {
+public:
+    /**
+     * Open `shards` files derived from `path` (see shard_path); ":memory:"
+     * gives each shard its own in-memory database
+     * @throws Error if a shard fails to open
+     */
+    explicit ShardedDatabase(const std::string& path, size_t shards = default_shards(),
+                             const OpenOptions& options = OpenOptions(),
+                             size_t max_batch = AsyncDatabase::kDefaultMaxBatch) {
+        if (shards == 0) shards = 1;
+        shards_.reserve(shards);
+        for (size_t i = 0; i < shards; ++i) {
+            shards_.push_back(std::make_unique<AsyncDatabase>(Database::open(shard_path(path, i), options), max_batch));
+        }
+    }
+
+    /**
+     * Use already opened databases as the shards, in routing order
+     */
+    explicit ShardedDatabase(std::vector<Database> shards, size_t max_batch = AsyncDatabase::kDefaultMaxBatch) {
+        if (shards.empty()) throw Error("ShardedDatabase requires at least one shard");
+        shards_.reserve(shards.size());
+        for (auto& db : shards) shards_.push_back(std::make_unique<AsyncDatabase>(std::move(db), max_batch));
+    }
+
+    ShardedDatabase(const ShardedDatabase&) = delete;
+    ShardedDatabase& operator=(const ShardedDatabase&) = delete;
+
+    static size_t default_shards() {
+        size_t n = std::thread::hardware_concurrency();
+        return n ? n : 4;
+    }
+
+    /**
+     * File of shard `index`: "data.db" -> "data.<index>.db", "data" -> "data.<index>"
+     */
+    static std::string shard_path(const std::string& path, size_t index) {
+        if (path == ":memory:") return path;
+        size_t slash = path.find_last_of("/\\");
+        size_t dot = path.rfind('.');
+        bool has_ext = dot != std::string::npos && dot > 0 && (slash == std::string::npos || dot > slash + 1);
+        std::string suffix = "." + std::to_string(index);
+        if (!has_ext) return path + suffix;
+        return path.substr(0, dot) + suffix + path.substr(dot);
+    }
+
+    /**
+     * The part of `key` that is hashed: its {tag} if it has a non-empty one
+     */
+    static std::string_view hash_tag(std::string_view key) {
+        size_t open = key.find('{');
+        if (open == std::string_view::npos) return key;
+        size_t close = key.find('}', open + 1);
+        if (close == std::string_view::npos || close == open + 1) return key;
+        return key.substr(open + 1, close - open - 1);
+    }
+
+    size_t shard_index(std::string_view key) const {
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : hash_tag(key)) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return static_cast<size_t>(hash % shards_.size());
+    }
+
+    size_t size() const { return shards_.size(); }
+
+    AsyncDatabase& shard(size_t index) { return *shards_[index]; }
+
+    AsyncDatabase& shard_for(std::string_view key) { return *shards_[shard_index(key)]; }
+
+    // ==================== Generic submission ====================
+
+    /**
+     * Run a read-only f(Database&) on the shard that owns `key`
+     */
+    template <typename F>
+    auto submit(std::string_view key, F&& f) {
+        return shard_for(key).submit(std::forward<F>(f));
+    }
+
+    /**
+     * Run a mutating f(Database&) on the shard that owns `key`
+     */
+    template <typename F>
+    auto submit_write(std::string_view key, F&& f) {
+        return shard_for(key).submit_write(std::forward<F>(f));
+    }
+
+    // ==================== String Commands ====================
+
+    std::optional<std::string> get(std::string_view key) { return shard_for(key).get(key).get(); }
+
+    bool set(std::string_view key, std::string_view value, int64_t ttl_seconds = 0) {
+        return shard_for(key).set(key, value, ttl_seconds).get();
+    }
+
+    int64_t incr(std::string_view key) { return shard_for(key).incr(key).get(); }
+
+    int64_t incrby(std::string_view key, int64_t increment) {
+        return shard_for(key).incrby(key, increment).get();
+    }
+
+    /**
+     * MGET across shards; values come back in the order of `keys`
+     */
+    std::vector<std::optional<std::string>> mget(const std::vector<std::string>& keys) {
+        std::vector<std::vector<std::string>> parts(shards_.size());
+        std::vector<std::vector<size_t>> positions(shards_.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            size_t s = shard_index(keys[i]);
+            parts[s].push_back(keys[i]);
+            positions[s].push_back(i);
+        }
+
+        auto replies = fan_out(false, std::move(parts), [](Database& db, const std::vector<std::string>& part) {
+            return db.mget(part);
+        });
+
+        std::vector<std::optional<std::string>> result(keys.size());
+        for (size_t s = 0; s < shards_.size(); ++s) {
+            if (!replies[s]) continue;
+            for (size_t j = 0; j < positions[s].size(); ++j) result[positions[s][j]] = std::move((*replies[s])[j]);
+        }
+        return result;
+    }
+
+    /**
+     * MSET across shards; each shard applies its share atomically
+     */
+    bool mset(const std::unordered_map<std::string, std::string>& pairs) {
+        std::vector<std::unordered_map<std::string, std::string>> parts(shards_.size());
+        for (const auto& [k, v] : pairs) parts[shard_index(k)].emplace(k, v);
+
+        auto replies = fan_out(true, std::move(parts),
+                               [](Database& db, const std::unordered_map<std::string, std::string>& part) {
+                                   return db.mset(part);
+                               });
+        bool ok = true;
+        for (const auto& r : replies) ok = ok && (!r || *r);
+        return ok;
+    }
+
+    // ==================== Key Commands ====================
+
+    int64_t del(std::string_view key) { return shard_for(key).del(key).get(); }
+
+    /**
+     * DEL across shards
+     * @return Number of keys removed
+     */
+    int64_t del(const std::vector<std::string>& keys) {
+        return count_keys(true, keys, [](Database& db, const std::vector<std::string>& part) {
+            return db.del(part);
+        });
+    }
+
+    bool exists(std::string_view key) { return shard_for(key).exists(key).get(); }
+
+    /**
+     * EXISTS across shards
+     * @return Number of the given keys that exist
+     */
+    int64_t exists(const std::vector<std::string>& keys) {
+        return count_keys(false, keys, [](Database& db, const std::vector<std::string>& part) {
+            return db.exists(part);
+        });
+    }
+
+    bool expire(std::string_view key, int64_t seconds) { return shard_for(key).expire(key, seconds).get(); }
+
+    int64_t ttl(std::string_view key) { return shard_for(key).ttl(key).get(); }
+
+    /**
+     * SCAN every shard, merged into ascending key order
+     */
+    ShardedScan scan(std::string_view pattern = "*", size_t count = 100) {
+        std::vector<AsyncDatabase*> shards;
+        shards.reserve(shards_.size());
+        for (auto& s : shards_) shards.push_back(s.get());
+        return ShardedScan(std::move(shards), pattern, count);
+    }
+
+    // ==================== Hash Commands ====================
+
+    std::optional<std::string> hget(std::string_view key, std::string_view field) {
+        return shard_for(key).hget(key, field).get();
+    }
+
+    int64_t hset(std::string_view key, std::string_view field, std::string_view value) {
+        return shard_for(key).hset(key, field, value).get();
+    }
+
+    int64_t hset(std::string_view key, std::unordered_map<std::string, std::string> fields) {
+        return shard_for(key).hset(key, std::move(fields)).get();
+    }
+
+    std::unordered_map<std::string, std::string> hgetall(std::string_view key) {
+        return shard_for(key).hgetall(key).get();
+    }
+
+    int64_t hdel(std::string_view key, std::vector<std::string> fields) {
+        return shard_for(key).hdel(key, std::move(fields)).get();
+    }
+
+    // ==================== List Commands ====================
+
+    int64_t lpush(std::string_view key, std::vector<std::string> values) {
+        return shard_for(key).lpush(key, std::move(values)).get();
+    }
+
+    int64_t rpush(std::string_view key, std::vector<std::string> values) {
+        return shard_for(key).rpush(key, std::move(values)).get();
+    }
+
+    std::vector<std::string> lrange(std::string_view key, int64_t start, int64_t stop) {
+        return shard_for(key).lrange(key, start, stop).get();
+    }
+
+    // ==================== Set Commands ====================
+
+    int64_t sadd(std::string_view key, std::vector<std::string> members) {
+        return shard_for(key).sadd(key, std::move(members)).get();
+    }
+
+    std::vector<std::string> smembers(std::string_view key) { return shard_for(key).smembers(key).get(); }
+
+    // ==================== Sorted Set Commands ====================
+
+    int64_t zadd(std::string_view key, double score, std::string_view member) {
+        return shard_for(key).zadd(key, score, member).get();
+    }
+
+    std::vector<std::string> zrange(std::string_view key, int64_t start, int64_t stop) {
+        return shard_for(key).zrange(key, start, stop).get();
+    }
+
+private:
+    /**
+     * Run f(db, parts[i]) on every shard with a non-empty part, all at once.
+     * Waits for every shard before rethrowing the first failure, so no task
+     * is still running when this returns.
+     */
+    template <typename Part, typename F>
+    auto fan_out(bool write, std::vector<Part> parts, F f)
+        -> std::vector<std::optional<std::invoke_result_t<F&, Database&, const Part&>>> {
+        using R = std::invoke_result_t<F&, Database&, const Part&>;
+        std::vector<std::optional<Future<R>>> pending(shards_.size());
+        for (size_t s = 0; s < shards_.size(); ++s) {
+            if (parts[s].empty()) continue;
+            auto task = [f, part = std::move(parts[s])](Database& db) { return f(db, part); };
+            pending[s] = write ? shards_[s]->submit_write(std::move(task)) : shards_[s]->submit(std::move(task));
+        }
+
+        std::vector<std::optional<R>> replies(shards_.size());
+        std::exception_ptr error;
+        for (size_t s = 0; s < shards_.size(); ++s) {
+            if (!pending[s]) continue;
+            try {
+                replies[s] = pending[s]->get();
+            } catch (...) {
+                if (!error) error = std::current_exception();
+            }
+        }
+        if (error) std::rethrow_exception(error);
+        return replies;
+    }
+
+    template <typename F>
+    int64_t count_keys(bool write, const std::vector<std::string>& keys, F f) {
+        std::vector<std::vector<std::string>> parts(shards_.size());
+        for (const auto& k : keys) parts[shard_index(k)].push_back(k);
+        int64_t total = 0;
+        for (const auto& r : fan_out(write, std::move(parts), f)) total += r.value_or(0);
+        return total;
+    }
+
+    std::vector<std::unique_ptr<AsyncDatabase>> shards_;
+};
+
+} // namespace redlite
+
+#endif // REDLITE_SHARDED_HPP
@@ -0,0 +1,166 @@
+/**
+ * Redlite C++ SDK - stream consumer
+ *
+ * StreamConsumer reads a stream through a consumer group in batches, hands
+ * out entries as zero-copy views, and acknowledges processed IDs with one
+ * XACK per batch instead of one per entry.
+ */
+
+#ifndef REDLITE_STREAM_HPP
+#define REDLITE_STREAM_HPP
+
+#include "redlite.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace redlite {
+
+/**
+ * StreamConsumer configuration
+ */
+struct ConsumerOptions {
+    int64_t batch_size = 512;                    // COUNT for each XREADGROUP
+    size_t ack_batch = 512;                      // Flush queued acks at this many
+    // Longest wait between re-checks while blocked. Writers in this process
+    // wake the consumer immediately; writers in other processes are only
+    // noticed on a re-check.
+    std::chrono::milliseconds recheck_interval{50};
+    bool create_group = true;                    // XGROUP CREATE ... MKSTREAM if missing
+    StreamId group_start;                        // Start position for a created group
+};
+
+/**
+ * Consumer-group reader for one stream
+ *
+ *   StreamConsumer consumer(db, "events", "workers", "worker-1");
+ *   while (running) {
+ *       consumer.consume([](StreamEntryView e) {
+ *           handle(e.get("type"), e.get("payload"));
+ *       }, std::chrono::seconds(1));
+ *   }
+ *
+ * The Database must outlive the consumer. Queued acks are flushed by
+ * flush(), when ack_batch is reached, before blocking, and on destruction.
+ * Not thread-safe; use one consumer per thread.
+ */
+class StreamConsumer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    StreamConsumer(Database& db, std::string key, std::string group, std::string consumer,
+                   ConsumerOptions options = {})
+        : db_(db), key_(std::move(key)), group_(std::move(group)),
+          consumer_(std::move(consumer)), options_(options) {
+        // Fails harmlessly if the group already exists
+        if (options_.create_group) db_.xgroup_create(key_, group_, options_.group_start, true);
+        acks_.reserve(options_.ack_batch);
+    }
+
+    ~StreamConsumer() {
+        try {
+            flush();
+        } catch (...) {
+            // Unacknowledged entries stay pending and can be re-read
+        }
+    }
+
+    StreamConsumer(const StreamConsumer&) = delete;
+    StreamConsumer& operator=(const StreamConsumer&) = delete;
+
+    /**
+     * Read up to batch_size new entries without blocking
+     */
+    StreamBatch read() {
+        return db_.xreadgroup(group_, consumer_, key_, ">", options_.batch_size);
+    }
+
+    /**
+     * Read new entries, blocking for up to `timeout` until some arrive
+     * @return Empty batch on timeout
+     */
+    StreamBatch read(std::chrono::milliseconds timeout) {
+        auto& signal = detail::StreamSignal::for_key(key_);
+        auto deadline = Clock::now() + timeout;
+        for (;;) {
+            uint64_t seen = signal.epoch();
+            StreamBatch batch = read();
+            if (!batch.empty()) return batch;
+
+            flush();
+            auto now = Clock::now();
+            if (now >= deadline) return batch;
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+            signal.wait(seen, std::max(std::chrono::milliseconds(1),
+                                       std::min(remaining, options_.recheck_interval)));
+        }
+    }
+
+    /**
+     * Re-read entries delivered to this consumer but not yet acknowledged
+     */
+    StreamBatch pending() {
+        return db_.xreadgroup(group_, consumer_, key_, "0", options_.batch_size);
+    }
+
+    /**
+     * Queue an entry for acknowledgement
+     */
+    void ack(StreamId id) {
+        acks_.push_back(id);
+        if (acks_.size() >= options_.ack_batch) flush();
+    }
+
+    /**
+     * Queue every entry of a batch for acknowledgement
+     */
+    void ack(const StreamBatch& batch) {
+        for (auto entry : batch) ack(entry.id());
+    }
+
+    /**
+     * Send all queued acks in a single XACK
+     * @return Number of entries acknowledged
+     */
+    int64_t flush() {
+        if (acks_.empty()) return 0;
+        int64_t acked = db_.xack(key_, group_, acks_);
+        acks_.clear();
+        return acked;
+    }
+
+    /**
+     * Read one batch (blocking up to `timeout` if non-zero), call `handler`
+     * for each entry and queue it for acknowledgement. If the handler
+     * throws, that entry and the rest of the batch stay pending.
+     * @return Number of entries read
+     */
+    template <typename Handler>
+    size_t consume(Handler&& handler, std::chrono::milliseconds timeout = {}) {
+        StreamBatch batch = timeout.count() > 0 ? read(timeout) : read();
+        for (auto entry : batch) {
+            handler(entry);
+            ack(entry.id());
+        }
+        return batch.size();
+    }
+
+    size_t queued_acks() const { return acks_.size(); }
+    const std::string& key() const { return key_; }
+    const std::string& group() const { return group_; }
+    const std::string& name() const { return consumer_; }
+
+private:
+    Database& db_;
+    std::string key_;
+    std::string group_;
+    std::string consumer_;
+    ConsumerOptions options_;
+    std::vector<StreamId> acks_;
+};
+
+} // namespace redlite
+
+#endif // REDLITE_STREAM_HPP
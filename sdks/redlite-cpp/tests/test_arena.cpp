@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <redlite/redlite.hpp>
+#include <algorithm>
+
+using namespace redlite;
+
+#ifdef REDLITE_HAS_PMR
+
+static std::vector<std::string> copy(const StringList& list) {
+    return std::vector<std::string>(list.begin(), list.end());
+}
+
+TEST_CASE("Arena-backed reads", "[arena]") {
+    auto db = Database::open_memory();
+    ResultArena arena;
+
+    SECTION("lrange decodes into the arena") {
+        db.rpush("list", {"a", "b", std::string(100, 'c')});
+        auto items = db.lrange("list", 0, -1, arena);
+        REQUIRE(items.size() == 3);
+        REQUIRE(items[0] == "a");
+        REQUIRE(std::string_view(items[2]) == std::string(100, 'c'));
+        REQUIRE(items.get_allocator().resource() == arena.resource());
+        REQUIRE(items[2].get_allocator().resource() == arena.resource());
+    }
+
+    SECTION("mget keeps nil entries") {
+        db.set("k1", "v1");
+        auto values = db.mget({"k1", "missing"}, arena);
+        REQUIRE(values.size() == 2);
+        REQUIRE(values[0] == std::pmr::string("v1"));
+        REQUIRE_FALSE(values[1].has_value());
+    }
+
+    SECTION("hkeys, hvals, smembers, zrange, zrevrange") {
+        db.hset("h", {{"f1", "v1"}, {"f2", "v2"}});
+        REQUIRE(db.hkeys("h", arena).size() == 2);
+        auto vals = db.hvals("h", arena);
+        std::sort(vals.begin(), vals.end());
+        REQUIRE(copy(vals) == std::vector<std::string>{"v1", "v2"});
+
+        db.sadd("s", "x");
+        REQUIRE(copy(db.smembers("s", arena)) == std::vector<std::string>{"x"});
+
+        db.zadd("z", {{1, "one"}, {2, "two"}});
+        REQUIRE(copy(db.zrange("z", 0, -1, arena)) == std::vector<std::string>{"one", "two"});
+        REQUIRE(copy(db.zrevrange("z", 0, 0, arena)) == std::vector<std::string>{"two"});
+    }
+
+    SECTION("reset reuses the arena between requests") {
+        db.rpush("list", std::vector<std::string>(100, std::string(64, 'x')));
+        for (int round = 0; round < 3; ++round) {
+            {
+                auto items = db.lrange("list", 0, -1, arena);
+                REQUIRE(items.size() == 100);
+            }
+            arena.reset();
+        }
+    }
+
+    SECTION("any memory_resource works") {
+        db.rpush("list", "a");
+        auto items = db.lrange("list", 0, -1, std::pmr::new_delete_resource());
+        REQUIRE(items.size() == 1);
+    }
+}
+
+// Run with: ./test_arena "[benchmark]"
+TEST_CASE("Arena vs per-element strings", "[.][benchmark]") {
+    auto db = Database::open_memory();
+    db.rpush("list", std::vector<std::string>(10000, std::string(48, 'y')));
+    ResultArena arena(1 << 20);
+
+    BENCHMARK("lrange 10k -> std::vector<std::string>") {
+        return db.lrange("list", 0, -1).size();
+    };
+
+    BENCHMARK("lrange 10k -> ResultArena") {
+        size_t n = db.lrange("list", 0, -1, arena).size();
+        arena.reset();
+        return n;
+    };
+}
+
+#endif
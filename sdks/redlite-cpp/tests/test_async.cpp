@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <redlite/async.hpp>
+#include <atomic>
+#include <filesystem>
+#include <thread>
+
+using namespace redlite;
+
+TEST_CASE("Async database", "[async]") {
+    AsyncDatabase db(Database::open_memory());
+
+    SECTION("futures complete with results") {
+        REQUIRE(db.set("k", "v").get());
+        REQUIRE(db.get("k").get() == "v");
+        REQUIRE(db.incr("n").get() == 1);
+        REQUIRE(db.exists("k").get());
+        REQUIRE(db.del("k").get() == 1);
+        REQUIRE_FALSE(db.get("k").get().has_value());
+    }
+
+    SECTION("errors propagate through the future") {
+        auto f = db.submit([](Database&) -> int64_t { throw Error("boom"); });
+        REQUIRE_THROWS_AS(f.get(), Error);
+    }
+
+    SECTION("a failing write does not fail its batch") {
+        std::vector<Future<int64_t>> ok;
+        for (int i = 0; i < 10; ++i) ok.push_back(db.incr("counter"));
+        auto bad = db.submit_write([](Database&) -> int64_t { throw Error("boom"); });
+        for (int i = 0; i < 10; ++i) ok.push_back(db.incr("counter"));
+
+        for (auto& f : ok) f.get();
+        REQUIRE_THROWS_AS(bad.get(), Error);
+        REQUIRE(db.get("counter").get() == "20");
+    }
+
+    SECTION("generic submit and submit_write") {
+        db.submit_write([](Database& d) {
+            d.set("a", "1");
+            d.set("b", "2");
+        }).get();
+        auto n = db.submit([](Database& d) { return d.mget({"a", "b"}).size(); }).get();
+        REQUIRE(n == 2);
+    }
+
+    SECTION("callbacks run on completion") {
+        std::promise<std::optional<std::string>> got;
+        db.set("k", "v");
+        db.submit([](Database& d) { return d.get("k"); },
+                  [&](std::optional<std::string> v) { got.set_value(std::move(v)); },
+                  [&](std::exception_ptr e) { got.set_exception(e); });
+        REQUIRE(got.get_future().get() == "v");
+
+        std::promise<void> failed;
+        db.submit_write([](Database&) -> int64_t { throw Error("boom"); },
+                        [&](int64_t) { failed.set_value(); },
+                        [&](std::exception_ptr e) { failed.set_exception(e); });
+        REQUIRE_THROWS_AS(failed.get_future().get(), Error);
+    }
+
+    SECTION("many producers") {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&, t] {
+                std::vector<Future<bool>> pending;
+                for (int i = 0; i < 100; ++i) {
+                    pending.push_back(db.set("t" + std::to_string(t) + ":" + std::to_string(i), "v"));
+                }
+                for (auto& f : pending) REQUIRE(f.get());
+            });
+        }
+        for (auto& th : threads) th.join();
+        REQUIRE(db.submit([](Database& d) { return d.dbsize(); }).get() == 800);
+    }
+}
+
+TEST_CASE("AsyncDatabase drains its queue on destruction", "[async]") {
+    std::vector<Future<int64_t>> pending;
+    {
+        AsyncDatabase db(Database::open_memory());
+        for (int i = 0; i < 100; ++i) pending.push_back(db.incr("n"));
+    }
+    REQUIRE(pending.back().get() == 100);
+}
+
+// Run with: ./test_async "[benchmark]"
+TEST_CASE("Coalesced async writes vs synchronous writes", "[.][benchmark]") {
+    constexpr int N = 1000;
+    auto path = std::filesystem::temp_directory_path() / "redlite_async_bench.db";
+    std::filesystem::remove(path);
+    {
+        Database sync_db(path.string());
+        BENCHMARK("1000x SET synchronous") {
+            for (int i = 0; i < N; ++i) sync_db.set("key:" + std::to_string(i), "v");
+        };
+    }
+    {
+        AsyncDatabase async_db(path.string());
+        BENCHMARK("1000x SET async (coalesced)") {
+            std::vector<Future<bool>> pending;
+            pending.reserve(N);
+            for (int i = 0; i < N; ++i) pending.push_back(async_db.set("key:" + std::to_string(i), "v"));
+            for (auto& f : pending) f.get();
+        };
+    }
+    std::filesystem::remove(path);
+}
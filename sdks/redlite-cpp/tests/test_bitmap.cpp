@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+
+using namespace redlite;
+
+TEST_CASE("Bitmap commands", "[bitmap]") {
+    auto db = Database::open_memory();
+
+    SECTION("SETBIT and GETBIT") {
+        REQUIRE_FALSE(db.setbit("b", 7, true));
+        REQUIRE(db.getbit("b", 7));
+        REQUIRE_FALSE(db.getbit("b", 6));
+        REQUIRE(db.setbit("b", 7, false));
+        REQUIRE_FALSE(db.getbit("b", 7));
+        REQUIRE_FALSE(db.getbit("missing", 1000));
+
+        // Growing pads with zero bytes
+        db.setbit("b", 100, true);
+        REQUIRE(db.strlen("b") == 13);
+        REQUIRE(db.getbit("b", 100));
+    }
+
+    SECTION("BITCOUNT") {
+        db.set("s", "foobar");
+        REQUIRE(db.bitcount("s") == 26);
+        REQUIRE(db.bitcount("s", 1, 1) == 6);
+        REQUIRE(db.bitcount("s", -2, -1) == 7);
+        REQUIRE(db.bitcount("missing") == 0);
+    }
+
+    SECTION("BITOP") {
+        db.set("a", std::string("\xff\xf0", 2));
+        db.set("b", std::string("\x0f", 1));
+
+        REQUIRE(db.bitop(BitOp::And, "and", {"a", "b"}) == 2);
+        REQUIRE(db.get("and") == std::string("\x0f\x00", 2));
+        REQUIRE(db.bitop(BitOp::Or, "or", {"a", "b"}) == 2);
+        REQUIRE(db.get("or") == std::string("\xff\xf0", 2));
+        REQUIRE(db.bitop(BitOp::Xor, "xor", {"a", "b", "missing"}) == 2);
+        REQUIRE(db.get("xor") == std::string("\xf0\xf0", 2));
+        REQUIRE(db.bitop(BitOp::Not, "not", {"b"}) == 1);
+        REQUIRE(db.get("not") == std::string("\xf0", 1));
+
+        REQUIRE_THROWS_AS(db.bitop(BitOp::Not, "x", {"a", "b"}), Error);
+        db.hset("h", "f", "v");
+        REQUIRE_THROWS_AS(db.bitop(BitOp::Or, "x", {"a", "h"}), Error);
+        REQUIRE_THROWS_AS(db.setbit("h", 0, true), Error);
+    }
+
+    SECTION("bitfield_read") {
+        db.setbit("b", 0, true);
+        db.setbit("b", 15, true);
+        auto bits = db.bitfield_read("b");
+        REQUIRE(bits.size() == 2);
+        REQUIRE(bits.data()[0] == 0x80);
+        REQUIRE(bits.data()[1] == 0x01);
+
+        auto tail = db.bitfield_read("b", 1, 1);
+        REQUIRE(tail.size() == 1);
+        REQUIRE(tail.data()[0] == 0x01);
+        REQUIRE_FALSE(db.bitfield_read("missing"));
+    }
+}
+
+// Run with: ./test_bitmap "[benchmark]"
+// Daily-active-user rollup: 30 random 100M-bit days OR-ed and AND-ed.
+TEST_CASE("Bitmap rollup", "[.][benchmark]") {
+    constexpr size_t kBytes = 100000000 / 8;
+    constexpr int kDays = 30;
+    auto path = std::filesystem::temp_directory_path() / "redlite_bitmap_bench.db";
+    for (const char* suffix : {"", "-wal", "-shm"}) std::filesystem::remove(path.string() + suffix);
+
+    {
+        Database db(path.string());
+        std::mt19937_64 rng(42);
+        std::vector<std::string> days;
+        std::string day(kBytes, '\0');
+        for (int d = 0; d < kDays; ++d) {
+            for (size_t i = 0; i + 8 <= kBytes; i += 8) {
+                uint64_t w = rng() & rng();    // ~25% of users active per day
+                std::memcpy(&day[i], &w, 8);
+            }
+            days.push_back("dau:" + std::to_string(d));
+            db.set(days.back(), day);
+        }
+
+        auto time = [](const char* label, auto&& fn) {
+            auto start = std::chrono::steady_clock::now();
+            auto result = fn();
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            std::printf("%-28s %8.1f ms  (%lld)\n", label, elapsed.count(), static_cast<long long>(result));
+        };
+
+        time("BITCOUNT one day", [&] { return db.bitcount(days[0]); });
+        time("BITOP OR 30 days", [&] { return db.bitop(BitOp::Or, "month:any", days); });
+        time("BITOP AND 30 days", [&] { return db.bitop(BitOp::And, "month:all", days); });
+        time("BITCOUNT month", [&] { return db.bitcount("month:any"); });
+        time("SETBIT x10000 in place", [&] {
+            int64_t flipped = 0;
+            for (uint64_t i = 0; i < 10000; ++i) flipped += db.setbit(days[0], (i * 7919) % (kBytes * 8), true);
+            return flipped;
+        });
+        time("GETBIT x10000", [&] {
+            int64_t set = 0;
+            for (uint64_t i = 0; i < 10000; ++i) set += db.getbit(days[1], (i * 7919) % (kBytes * 8));
+            return set;
+        });
+        time("bitfield_read one day", [&] { return static_cast<int64_t>(db.bitfield_read(days[2]).size()); });
+    }
+
+    for (const char* suffix : {"", "-wal", "-shm"}) std::filesystem::remove(path.string() + suffix);
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/bulk.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace redlite;
+
+TEST_CASE("BulkLoader", "[bulk]") {
+    auto db = Database::open_memory();
+
+    SECTION("loads every record type") {
+        BulkLoader loader(db);
+        loader.set("s", "value");
+        loader.set("ttl", "v", 100);
+        loader.hset("h", {{"a", "1"}, {"b", "2"}});
+        loader.sadd("set", {"x", "y", "x"});
+        loader.zadd("z", 2.5, "m");
+        loader.zadd("z", {{1.0, "n"}, {3.0, "m"}});
+        REQUIRE(loader.buffered() == 10);
+
+        auto progress = loader.finish();
+        REQUIRE(progress.records == 10);
+        REQUIRE(progress.batches == 1);
+        REQUIRE(loader.buffered() == 0);
+
+        REQUIRE(db.get("s") == "value");
+        REQUIRE(db.ttl("ttl") > 0);
+        REQUIRE(db.hget("h", "b") == "2");
+        REQUIRE(db.hlen("h") == 2);
+        REQUIRE(db.scard("set") == 2);
+        REQUIRE(db.zscore("z", "m") == 3.0);
+        REQUIRE(db.zcard("z") == 2);
+    }
+
+    SECTION("flushes in batches and reports progress") {
+        BulkLoadOptions options;
+        options.batch_records = 100;
+        std::vector<uint64_t> seen;
+        options.on_progress = [&](const BulkProgress& p) { seen.push_back(p.records); };
+
+        BulkLoader loader(db, options);
+        for (int i = 0; i < 250; ++i) loader.hset("h", std::to_string(i), "v");
+        REQUIRE(seen == std::vector<uint64_t>{100, 200});
+        REQUIRE(db.hlen("h") == 200);
+
+        auto progress = loader.finish();
+        REQUIRE(progress.batches == 3);
+        REQUIRE(progress.records == 250);
+        REQUIRE(seen.back() == 250);
+        REQUIRE(db.hlen("h") == 250);
+    }
+
+    SECTION("wrong type rolls back the batch") {
+        db.sadd("taken", "m");
+        BulkLoader loader(db);
+        loader.set("fresh", "v");
+        loader.hset("taken", "f", "v");
+        REQUIRE_THROWS_AS(loader.flush(), Error);
+        REQUIRE(loader.buffered() == 0);
+        REQUIRE_FALSE(db.get("fresh"));
+
+        loader.set("fresh", "v");
+        REQUIRE(loader.finish().records == 1);
+        REQUIRE(db.get("fresh") == "v");
+    }
+
+    SECTION("finishes on destruction and is single-use") {
+        {
+            BulkLoader loader(db);
+            loader.set("k", "v");
+        }
+        REQUIRE(db.get("k") == "v");
+
+        BulkLoader loader(db);
+        loader.finish();
+        REQUIRE_THROWS_AS(loader.set("k", "v"), Error);
+    }
+}
+
+// Run with: ./test_bulk "[benchmark]"
+// Compares per-command writes in one transaction against BulkLoader.
+TEST_CASE("Bulk load throughput", "[.][benchmark]") {
+    constexpr int kKeys = 100000;
+    std::string payload(64, 'p');
+
+    auto run = [&](const char* path, auto&& load) {
+        std::remove(path);
+        Database db(path);
+        auto start = std::chrono::steady_clock::now();
+        load(db);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        REQUIRE(db.dbsize() == kKeys + 1);
+        std::remove(path);
+        return elapsed.count();
+    };
+
+    double per_call = run("bench_bulk_calls.db", [&](Database& db) {
+        auto tx = db.transaction();
+        for (int i = 0; i < kKeys; ++i) {
+            std::string id = std::to_string(i);
+            db.hset("user:" + id, {{"name", id}, {"bio", payload}});
+            db.zadd("users", {{static_cast<double>(i), id}});
+        }
+        tx.commit();
+    });
+
+    double bulk = run("bench_bulk_loader.db", [&](Database& db) {
+        BulkLoader loader(db);
+        for (int i = 0; i < kKeys; ++i) {
+            std::string id = std::to_string(i);
+            loader.hset("user:" + id, "name", id);
+            loader.hset("user:" + id, "bio", payload);
+            loader.zadd("users", i, id);
+        }
+        loader.finish();
+    });
+
+    std::printf("per-call: %.0f keys/s\n", kKeys / per_call);
+    std::printf("bulk:     %.0f keys/s (%.1fx)\n", kKeys / bulk, per_call / bulk);
+}
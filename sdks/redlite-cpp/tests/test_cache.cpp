@@ -0,0 +1,181 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/cache.hpp>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using namespace redlite;
+
+TEST_CASE("Cached string reads", "[cache]") {
+    CachedDatabase cache(Database::open_memory());
+
+    SECTION("second read is a hit") {
+        cache.set("k", "v");
+        REQUIRE(cache.get("k") == "v");
+        REQUIRE(cache.get("k") == "v");
+
+        auto stats = cache.stats();
+        REQUIRE(stats.misses == 1);
+        REQUIRE(stats.hits == 1);
+        REQUIRE(stats.entries == 1);
+        REQUIRE(stats.bytes > 0);
+        REQUIRE(stats.hit_rate() == 0.5);
+    }
+
+    SECTION("missing keys are not cached") {
+        REQUIRE_FALSE(cache.get("missing"));
+        REQUIRE_FALSE(cache.get("missing"));
+        REQUIRE(cache.stats().hits == 0);
+        REQUIRE(cache.stats().entries == 0);
+    }
+
+    SECTION("writes through the cache invalidate") {
+        cache.set("k", "1");
+        REQUIRE(cache.get("k") == "1");
+        REQUIRE(cache.incr("k") == 2);
+        REQUIRE(cache.get("k") == "2");
+        cache.append("k", "0");
+        REQUIRE(cache.get("k") == "20");
+        cache.del("k");
+        REQUIRE_FALSE(cache.get("k"));
+        REQUIRE(cache.stats().invalidations >= 3);
+    }
+
+    SECTION("writes that bypass the cache are caught by the version check") {
+        cache.set("k", "old");
+        REQUIRE(cache.get("k") == "old");
+        cache.database().set("k", "new");
+        REQUIRE(cache.get("k") == "new");
+    }
+
+    SECTION("delete and recreate is detected") {
+        cache.set("k", "v");
+        REQUIRE(cache.get("k") == "v");
+        cache.database().del("k");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));  // new created_at
+        cache.database().set("k", "w");
+        REQUIRE(cache.get("k") == "w");
+    }
+
+    SECTION("type change drops the entry") {
+        cache.set("k", "v");
+        REQUIRE(cache.get("k") == "v");
+        cache.database().del("k");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        cache.database().hset("k", "f", "1");
+        REQUIRE_FALSE(cache.get("k"));
+        REQUIRE(cache.hget("k", "f") == "1");
+    }
+}
+
+TEST_CASE("Cached hash reads", "[cache]") {
+    CachedDatabase cache(Database::open_memory());
+    cache.hset("h", {{"a", "1"}, {"b", "2"}});
+
+    SECTION("fields are cached individually") {
+        REQUIRE(cache.hget("h", "a") == "1");
+        REQUIRE(cache.hget("h", "a") == "1");
+        REQUIRE(cache.hget("h", "b") == "2");
+        REQUIRE(cache.stats().hits == 1);
+        REQUIRE(cache.stats().misses == 2);
+    }
+
+    SECTION("hgetall serves later field reads") {
+        auto all = cache.hgetall("h");
+        REQUIRE(all.size() == 2);
+        REQUIRE(cache.hgetall("h") == all);
+        REQUIRE(cache.hget("h", "b") == "2");
+        REQUIRE_FALSE(cache.hget("h", "zzz"));
+        REQUIRE(cache.stats().hits == 3);
+        REQUIRE(cache.stats().misses == 1);
+    }
+
+    SECTION("field writes invalidate") {
+        REQUIRE(cache.hget("h", "a") == "1");
+        cache.hset("h", "a", "9");
+        REQUIRE(cache.hget("h", "a") == "9");
+        cache.hincrby("h", "a", 1);
+        REQUIRE(cache.hget("h", "a") == "10");
+        cache.hdel("h", {"a"});
+        REQUIRE_FALSE(cache.hget("h", "a"));
+    }
+
+    SECTION("external field writes are caught") {
+        REQUIRE(cache.hgetall("h").size() == 2);
+        cache.database().hset("h", "c", "3");
+        REQUIRE(cache.hgetall("h").size() == 3);
+    }
+}
+
+TEST_CASE("Cache eviction and control", "[cache]") {
+    CacheOptions options;
+    options.max_bytes = 4096;
+    CachedDatabase cache(Database::open_memory(), options);
+
+    for (int i = 0; i < 20; ++i) {
+        cache.set("k" + std::to_string(i), std::string(1000, 'v'));
+        REQUIRE(cache.get("k" + std::to_string(i)));
+    }
+    auto stats = cache.stats();
+    REQUIRE(stats.evictions > 0);
+    REQUIRE(stats.bytes <= options.max_bytes);
+    REQUIRE(stats.entries < 20);
+
+    // Most recent entry survives, oldest was evicted
+    cache.reset_stats();
+    cache.get("k19");
+    cache.get("k0");
+    REQUIRE(cache.stats().hits == 1);
+    REQUIRE(cache.stats().misses == 1);
+
+    cache.invalidate("k0");
+    cache.clear();
+    REQUIRE(cache.stats().entries == 0);
+    REQUIRE(cache.stats().bytes == 0);
+}
+
+TEST_CASE("Cache revalidation window", "[cache]") {
+    CacheOptions options;
+    options.revalidate_after = std::chrono::hours(1);
+    CachedDatabase cache(Database::open_memory(), options);
+
+    cache.set("k", "old");
+    REQUIRE(cache.get("k") == "old");
+    cache.database().set("k", "new");
+    REQUIRE(cache.get("k") == "old");  // trusted inside the window
+
+    cache.invalidate("k");
+    REQUIRE(cache.get("k") == "new");
+}
+
+// Run with: ./test_cache "[benchmark]"
+// Compares repeated GET/HGETALL through the cache against direct reads.
+TEST_CASE("Cache hit throughput", "[.][benchmark]") {
+    constexpr int kKeys = 100;
+    constexpr int kOps = 100000;
+    CachedDatabase cache(Database::open_memory());
+    Database& db = cache.database();
+    std::unordered_map<std::string, std::string> fields;
+    for (int i = 0; i < 50; ++i) fields.emplace("f" + std::to_string(i), std::string(100, 'v'));
+    for (int i = 0; i < kKeys; ++i) {
+        db.set("s:" + std::to_string(i), std::string(4096, 'v'));
+        db.hset("h:" + std::to_string(i), fields);
+    }
+
+    auto time = [](auto&& op) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kOps; ++i) op(std::to_string(i % kKeys));
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return kOps / elapsed.count();
+    };
+
+    double get_direct = time([&](const std::string& n) { return db.get("s:" + n); });
+    double get_cached = time([&](const std::string& n) { return cache.get("s:" + n); });
+    double hgetall_direct = time([&](const std::string& n) { return db.hgetall("h:" + n); });
+    double hgetall_cached = time([&](const std::string& n) { return cache.hgetall("h:" + n); });
+
+    std::printf("%10s %14s %14s\n", "op", "direct ops/s", "cached ops/s");
+    std::printf("%10s %14.0f %14.0f\n", "get 4KB", get_direct, get_cached);
+    std::printf("%10s %14.0f %14.0f\n", "hgetall 50", hgetall_direct, hgetall_cached);
+    std::printf("hit rate %.3f\n", cache.stats().hit_rate());
+}
@@ -0,0 +1,139 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
+
+using namespace redlite;
+
+namespace {
+
+struct Sample {
+    int32_t sensor;
+    float reading;
+    int64_t at_ms;
+};
+
+enum class Level : uint8_t { Low = 1, High = 2 };
+
+// Stored as "name:age"
+struct Person {
+    std::string name;
+    int age = 0;
+};
+
+} // namespace
+
+template <>
+struct redlite::Codec<Person> {
+    template <typename Write>
+    static auto encode(const Person& p, Write&& write) {
+        return write(p.name + ":" + std::to_string(p.age));
+    }
+    static Person decode(std::string_view bytes) {
+        auto colon = bytes.find(':');
+        if (colon == std::string_view::npos) throw Error("bad person");
+        return {std::string(bytes.substr(0, colon)), Codec<int>::decode(bytes.substr(colon + 1))};
+    }
+};
+
+TEST_CASE("Typed values", "[codec]") {
+    auto db = Database::open_memory();
+
+    SECTION("integers are stored as text") {
+        REQUIRE(db.set("n", int64_t{-42}));
+        REQUIRE(db.get("n") == "-42");
+        REQUIRE(db.get<int64_t>("n") == -42);
+        REQUIRE(db.incr("n") == -41);
+        REQUIRE(db.get<int>("n") == -41);
+        REQUIRE(db.set("u", uint64_t{18446744073709551615ull}));
+        REQUIRE(db.get<uint64_t>("u") == 18446744073709551615ull);
+        REQUIRE(db.set("b", true));
+        REQUIRE(db.get<bool>("b") == true);
+    }
+
+    SECTION("floating point round-trips and works with INCRBYFLOAT") {
+        REQUIRE(db.set("f", 0.1));
+        REQUIRE(db.get<double>("f") == 0.1);
+        REQUIRE(db.incrbyfloat("f", 0.5) == db.get<double>("f"));
+        REQUIRE(db.set("g", 1e300));
+        REQUIRE(db.get<double>("g") == 1e300);
+    }
+
+    SECTION("trivially copyable structs are stored as raw bytes") {
+        Sample s{7, 21.5f, 1700000000123};
+        REQUIRE(db.set("s", s));
+        REQUIRE(db.strlen("s") == static_cast<int64_t>(sizeof(Sample)));
+        auto back = db.get<Sample>("s");
+        REQUIRE(back.has_value());
+        REQUIRE(back->sensor == 7);
+        REQUIRE(back->reading == 21.5f);
+        REQUIRE(back->at_ms == 1700000000123);
+
+        REQUIRE(db.set("lvl", Level::High));
+        REQUIRE(db.get<Level>("lvl") == Level::High);
+    }
+
+    SECTION("custom codec") {
+        REQUIRE(db.set("p", Person{"ada", 36}));
+        REQUIRE(db.get("p") == "ada:36");
+        auto p = db.get<Person>("p");
+        REQUIRE(p->name == "ada");
+        REQUIRE(p->age == 36);
+    }
+
+    SECTION("strings and byte vectors") {
+        REQUIRE(db.set("str", std::string("plain")));
+        REQUIRE(db.get<std::string>("str") == "plain");
+        std::vector<uint8_t> raw{0, 1, 2, 255};
+        REQUIRE(db.set("raw", raw, 0));
+        REQUIRE(db.get<std::vector<uint8_t>>("raw") == raw);
+    }
+
+    SECTION("missing keys and bad data") {
+        REQUIRE_FALSE(db.get<int64_t>("missing").has_value());
+        db.set("text", "not a number");
+        REQUIRE_THROWS_AS(db.get<int64_t>("text"), Error);
+        REQUIRE_THROWS_AS(db.get<double>("text"), Error);
+        REQUIRE_THROWS_AS(db.get<Sample>("text"), Error);
+        db.set("big", "99999999999");
+        REQUIRE_THROWS_AS(db.get<int32_t>("big"), Error);
+    }
+
+    SECTION("hash fields") {
+        REQUIRE(db.hset("h", "count", 5) == 1);
+        REQUIRE(db.hincrby("h", "count", 2) == 7);
+        REQUIRE(db.hget<int>("h", "count") == 7);
+        REQUIRE(db.hset("h", "sample", Sample{1, 2.0f, 3}) == 1);
+        REQUIRE(db.hget<Sample>("h", "sample")->at_ms == 3);
+        REQUIRE_FALSE(db.hget<int>("h", "missing").has_value());
+        REQUIRE(db.hset("h", "name", "text") == 1);
+        REQUIRE(db.hget("h", "name") == "text");
+    }
+}
+
+// Run with: ./test_codec "[benchmark]"
+// SET/GET of a small struct through the codec vs formatting it by hand.
+TEST_CASE("Typed SET/GET", "[.][benchmark]") {
+    constexpr int kOps = 100000;
+    auto db = Database::open_memory();
+    Sample s{1, 0.5f, 0};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kOps; ++i) {
+        s.at_ms = i;
+        db.set("sample", s);
+        if (db.get<Sample>("sample")->at_ms != i) FAIL("mismatch");
+    }
+    std::chrono::duration<double, std::micro> typed = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kOps; ++i) {
+        s.at_ms = i;
+        db.set("sample", std::to_string(s.sensor) + "," + std::to_string(s.reading) + "," + std::to_string(s.at_ms));
+        auto text = db.get("sample");
+        if (std::stoll(text->substr(text->rfind(',') + 1)) != i) FAIL("mismatch");
+    }
+    std::chrono::duration<double, std::micro> manual = std::chrono::steady_clock::now() - start;
+
+    std::printf("codec: %.2f us/op, hand-formatted: %.2f us/op\n", typed.count() / kOps, manual.count() / kOps);
+}
@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace redlite;
+
+namespace {
+
+void load_bay_area(Database& db) {
+    db.geoadd("cities", {{-122.4194, 37.7749, "SF"},
+                         {-122.2711, 37.8044, "Oakland"},
+                         {-121.8863, 37.3382, "SJ"},
+                         {-118.2437, 34.0522, "LA"}});
+}
+
+} // namespace
+
+TEST_CASE("GEO commands", "[geo]") {
+    auto db = Database::open_memory();
+    load_bay_area(db);
+
+    SECTION("geoadd options") {
+        REQUIRE(db.geoadd("cities", {{-122.0, 37.0, "SF"}}, {true, false, false}) == 0);
+        REQUIRE(db.geoadd("cities", {{-122.0, 37.0, "Nowhere"}}, {false, true, false}) == 0);
+        REQUIRE(db.geoadd("cities", {{-122.4194, 37.7749, "SF"}}, {false, false, true}) == 1);
+        REQUIRE_THROWS_AS(db.geoadd("cities", {{200.0, 0.0, "bad"}}), Error);
+    }
+
+    SECTION("geopos and geohash") {
+        auto pos = db.geopos("cities", {"SF", "missing"});
+        REQUIRE(pos.size() == 2);
+        REQUIRE(pos[0]->longitude == Catch::Approx(-122.4194));
+        REQUIRE(pos[0]->latitude == Catch::Approx(37.7749));
+        REQUIRE_FALSE(pos[1].has_value());
+
+        auto hashes = db.geohash("cities", {"SF", "missing"});
+        REQUIRE(hashes[0]->size() == 11);
+        REQUIRE(hashes[0]->rfind("9q8yy", 0) == 0);
+        REQUIRE_FALSE(hashes[1].has_value());
+    }
+
+    SECTION("geodist") {
+        auto km = db.geodist("cities", "SF", "Oakland", GeoUnit::Kilometers);
+        REQUIRE(km.has_value());
+        REQUIRE(*km == Catch::Approx(13.4).margin(0.5));
+        REQUIRE_FALSE(db.geodist("cities", "SF", "missing").has_value());
+    }
+
+    SECTION("geosearch by radius, nearest first") {
+        GeoSearchOptions opts;
+        opts.from_member = "SF";
+        opts.radius = 100;
+        opts.unit = GeoUnit::Kilometers;
+        auto hits = db.geosearch("cities", opts);
+        REQUIRE(hits.members() == std::vector<std::string>{"SF", "Oakland", "SJ"});
+        REQUIRE(hits[0].distance == Catch::Approx(0.0).margin(1e-9));
+        REQUIRE(hits[1].distance < hits[2].distance);
+        REQUIRE(hits[2].longitude == Catch::Approx(-121.8863));
+
+        opts.desc = true;
+        opts.count = 1;
+        REQUIRE(db.geosearch("cities", opts).members() == std::vector<std::string>{"SJ"});
+    }
+
+    SECTION("geosearch by box from a point") {
+        GeoSearchOptions opts;
+        opts.from_lon = -122.35;
+        opts.from_lat = 37.79;
+        opts.width = 30;
+        opts.height = 10;
+        opts.unit = GeoUnit::Kilometers;
+        auto hits = db.geosearch("cities", opts);
+        REQUIRE(hits.size() == 2);
+        for (auto h : hits) REQUIRE((h.member == "SF" || h.member == "Oakland"));
+    }
+
+    SECTION("geosearchstore") {
+        GeoSearchOptions opts;
+        opts.from_member = "SF";
+        opts.radius = 20;
+        opts.unit = GeoUnit::Kilometers;
+        REQUIRE(db.geosearchstore("near_sf", "cities", opts) == 2);
+        REQUIRE(db.zcard("near_sf") == 2);
+    }
+
+    SECTION("missing key and member") {
+        GeoSearchOptions opts;
+        opts.from_lon = 0;
+        opts.from_lat = 0;
+        opts.radius = 10;
+        REQUIRE(db.geosearch("nope", opts).empty());
+
+        opts.from_member = "missing";
+        REQUIRE_THROWS_AS(db.geosearch("cities", opts), Error);
+    }
+
+    SECTION("keys and members are length-delimited") {
+        std::string buffer = "citiesXYZ";
+        std::string_view key(buffer.data(), 6);
+        REQUIRE(db.geodist(key, "SF", "Oakland", GeoUnit::Kilometers).has_value());
+        REQUIRE_FALSE(db.geopos(buffer, {"SF"})[0].has_value());
+        REQUIRE_FALSE(db.geopos(key, {std::string("SF\0", 3)})[0].has_value());
+
+        GeoSearchOptions opts;
+        opts.from_member = "SF";
+        opts.radius = 20;
+        opts.unit = GeoUnit::Kilometers;
+        REQUIRE(db.geosearchstore(std::string_view(buffer.data() + 6, 3), key, opts) == 2);
+        REQUIRE(db.zcard("XYZ") == 2);
+    }
+}
+
+// Run with: ./test_geo "[benchmark]"
+// Nearby-driver lookups: 5 km radius, nearest 20, over 200k points.
+TEST_CASE("GEOSEARCH radius", "[.][benchmark]") {
+    constexpr int kPoints = 200000;
+    constexpr int kQueries = 2000;
+    auto db = Database::open_memory();
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> lon(-122.6, -121.8);
+    std::uniform_real_distribution<double> lat(37.2, 38.0);
+    std::vector<GeoMember> batch;
+    for (int i = 0; i < kPoints; ++i) {
+        batch.push_back({lon(rng), lat(rng), "driver:" + std::to_string(i)});
+        if (batch.size() == 1000) {
+            db.geoadd("drivers", batch);
+            batch.clear();
+        }
+    }
+
+    GeoSearchOptions opts;
+    opts.radius = 5;
+    opts.unit = GeoUnit::Kilometers;
+    opts.count = 20;
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kQueries; ++i) {
+        opts.from_lon = lon(rng);
+        opts.from_lat = lat(rng);
+        found += db.geosearch("drivers", opts).size();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("geosearch: %.0f us/query (%.1f hits avg)\n", elapsed.count() / kQueries,
+                static_cast<double>(found) / kQueries);
+}
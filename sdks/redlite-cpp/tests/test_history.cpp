@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
+
+using namespace redlite;
+
+namespace {
+
+int64_t now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+TEST_CASE("History reads", "[history]") {
+    auto db = Database::open_memory();
+    db.history_enable_key("doc");
+    for (int i = 0; i < 40; ++i) db.set("doc", "value " + std::string(200, 'x') + std::to_string(i));
+
+    SECTION("get returns every snapshot in order") {
+        auto entries = db.history_get("doc");
+        REQUIRE(entries.size() == 40);
+        for (size_t i = 0; i < entries.size(); ++i) {
+            REQUIRE(entries[i].value == "value " + std::string(200, 'x') + std::to_string(i));
+            if (i > 0) REQUIRE(entries[i].timestamp_ms >= entries[i - 1].timestamp_ms);
+        }
+    }
+
+    SECTION("get with a limit") {
+        auto entries = db.history_get("doc", 3);
+        REQUIRE(entries.size() == 3);
+        REQUIRE((*entries.begin()).value.substr(0, 6) == "value ");
+        REQUIRE_THROWS_AS(entries.at(3), std::out_of_range);
+    }
+
+    SECTION("getat sees the latest write") {
+        auto v = db.history_getat("doc", now_ms() + 1000);
+        REQUIRE(v.has_value());
+        REQUIRE(v->to_string() == "value " + std::string(200, 'x') + "39");
+        REQUIRE_FALSE(db.history_getat("doc", 1).has_value());
+    }
+
+    SECTION("untracked key") {
+        REQUIRE(db.history_get("other").empty());
+        REQUIRE_FALSE(db.history_getat("other", now_ms()).has_value());
+    }
+
+    SECTION("clear and prune") {
+        REQUIRE(db.history_prune(now_ms() + 1000, 7) == 40);
+        REQUIRE(db.history_get("doc").empty());
+        db.set("doc", "again");
+        REQUIRE(db.history_clear("doc") == 1);
+    }
+
+    SECTION("count retention") {
+        db.history_enable_key("capped", RetentionType::Count, 5);
+        for (int i = 0; i < 20; ++i) db.set("capped", std::to_string(i));
+        auto entries = db.history_get("capped");
+        REQUIRE_FALSE(entries.empty());
+        REQUIRE(entries.size() <= 5);
+        REQUIRE(entries[entries.size() - 1].value == "19");
+    }
+
+    SECTION("keys with embedded NUL") {
+        std::string key("a\0b", 3);
+        db.history_enable_global();
+        db.set(key, "v");
+        REQUIRE(db.history_get(key).size() == 1);
+        REQUIRE(db.history_getat(key, now_ms() + 1000)->to_string() == "v");
+        REQUIRE(db.history_get("a").empty());
+        REQUIRE(db.history_clear(key) == 1);
+    }
+
+    SECTION("move") {
+        auto entries = db.history_get("doc");
+        HistoryEntries moved = std::move(entries);
+        REQUIRE(moved.size() == 40);
+        REQUIRE(entries.empty());
+    }
+}
+
+// Run with: ./test_history "[benchmark]"
+// Point-in-time reads against a key with a long history.
+TEST_CASE("History getat", "[.][benchmark]") {
+    constexpr int kVersions = 20000;
+    constexpr int kReads = 10000;
+    auto db = Database::open_memory();
+    db.history_enable_key("doc");
+    std::string value(1024, 'x');
+    for (int i = 0; i < kVersions; ++i) {
+        value[i % value.size()] = static_cast<char>('a' + i % 26);
+        db.set("doc", value);
+    }
+
+    int64_t until = now_ms();
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kReads; ++i) {
+        if (db.history_getat("doc", until - i % 1000)) ++found;
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("getat: %.1f us/read (%zu found)\n", elapsed.count() / kReads, found);
+}
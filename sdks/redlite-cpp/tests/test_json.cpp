@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
+
+using namespace redlite;
+
+TEST_CASE("JSON batch paths", "[json]") {
+    auto db = Database::open_memory();
+    db.json_mset("user:1", {{"$", R"({"name":"alice","stats":{"visits":41}})"},
+                            {"$.tags", R"(["a","b"])"},
+                            {"$.stats.visits", "42"}});
+
+    SECTION("mget returns one value per path") {
+        auto values = db.json_mget("user:1", {"$.name", "$.stats.visits", "$.tags[1]", "$.missing", "$.tags[*]"});
+        REQUIRE(values.size() == 5);
+        REQUIRE(values[0] == R"("alice")");
+        REQUIRE(values[1] == "42");
+        REQUIRE(values[2] == R"("b")");
+        REQUIRE(values.is_nil(3));
+        REQUIRE(values[4] == R"(["a","b"])");
+    }
+
+    SECTION("missing key") {
+        auto values = db.json_mget("user:2", {"$.a", "$.b"});
+        REQUIRE(values.size() == 2);
+        REQUIRE(values.is_nil(0));
+        REQUIRE(values.is_nil(1));
+    }
+
+    SECTION("invalid value writes nothing") {
+        REQUIRE_THROWS_AS(db.json_mset("user:1", {{"$.name", R"("bob")"}, {"$.bad", "{"}}), Error);
+        REQUIRE(db.json_get("user:1", {"$.name"}) == R"("alice")");
+        REQUIRE_THROWS_AS(db.json_mset("user:1", {{"$.name", R"("bob")"}, {"$.name.first", R"("b")"}}), Error);
+        REQUIRE(db.json_get("user:1", {"$.name"}) == R"("alice")");
+    }
+
+    SECTION("numincrby on a plain path") {
+        REQUIRE(db.json_numincrby("user:1", "$.stats.visits", 1) == "43");
+        REQUIRE(db.json_numincrby("user:1", "$.stats.visits", 100) == "143");
+        REQUIRE(db.json_mget("user:1", {"$.stats"})[0] == R"({"visits":143})");
+    }
+
+    SECTION("wrong type") {
+        db.set("plain", "x");
+        REQUIRE_THROWS_AS(db.json_mget("plain", {"$"}), Error);
+    }
+}
+
+// Run with: ./test_json "[benchmark]"
+// Counter updates and field reads on a ~200 KB document.
+TEST_CASE("JSON large document", "[.][benchmark]") {
+    constexpr int kOps = 2000;
+    auto db = Database::open_memory();
+    std::string doc = R"({"counter":0,"items":[)";
+    for (int i = 0; i < 2000; ++i) {
+        if (i) doc += ',';
+        doc += R"({"id":)" + std::to_string(i) + R"(,"name":"item number )" + std::to_string(i) +
+               R"(","notes":"lorem ipsum dolor sit amet consectetur adipiscing elit"})";
+    }
+    doc += "]}";
+    db.json_set("doc", "$", doc);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kOps; ++i) db.json_numincrby("doc", "$.counter", 1);
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("numincrby: %.1f us/op (%zu byte doc)\n", elapsed.count() / kOps, doc.size());
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kOps; ++i) {
+        auto values = db.json_mget("doc", {"$.counter", "$.items[1500].name"});
+        if (values.size() != 2) FAIL("short result");
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("json_mget (2 paths): %.1f us/op\n", elapsed.count() / kOps);
+}
@@ -146,4 +146,28 @@ TEST_CASE("Key commands", "[keys]") {
         REQUIRE(db.select(0));
         REQUIRE(db.get("key").value() == "db0");
     }
+
+    SECTION("Keys are length-delimited") {
+        std::string long_key = "tenant:12345:session:" + std::string(60, 'a');
+        db.set(long_key, "v");
+        REQUIRE(db.get(long_key).value() == "v");
+
+        // A view into a larger buffer is not NUL-terminated at its end
+        std::string buffer = "user:1user:2";
+        std::string_view first(buffer.data(), 6);
+        db.set(first, "one");
+        REQUIRE(db.get("user:1").value() == "one");
+        REQUIRE_FALSE(db.exists("user:1user:2"));
+
+        // Embedded NUL bytes are preserved
+        std::string nul_key("a\0b", 3);
+        db.set(nul_key, "x");
+        REQUIRE(db.get(nul_key).value() == "x");
+        REQUIRE_FALSE(db.exists("a"));
+        REQUIRE(db.del(std::vector<std::string>{nul_key}) == 1);
+
+        db.hset("h", std::string("f\0g", 3), "v");
+        REQUIRE(db.hget("h", std::string("f\0g", 3)).value() == "v");
+        REQUIRE_FALSE(db.hget("h", "f").has_value());
+    }
 }
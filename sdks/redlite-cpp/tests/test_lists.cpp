@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
 
 using namespace redlite;
 
@@ -144,4 +146,59 @@ TEST_CASE("List commands", "[lists]") {
         REQUIRE_FALSE(db.lindex("mylist", 10).has_value());
         REQUIRE_FALSE(db.lindex("mylist", -10).has_value());
     }
+
+    SECTION("LPUSH and RPUSH from string views") {
+        std::string tail = "d";
+        REQUIRE(db.rpush("mylist", {std::string_view("b"), std::string_view("c"), tail}) == 3);
+        REQUIRE(db.lpush("mylist", {std::string_view("a")}) == 4);
+
+        // More values than fit in the stack buffer
+        std::vector<std::string> storage;
+        for (int i = 0; i < 100; ++i) storage.push_back(std::to_string(i));
+        std::vector<std::string_view> views(storage.begin(), storage.end());
+        REQUIRE(db.rpush("mylist", views) == 104);
+
+        auto range = db.lrange("mylist", 0, 4);
+        REQUIRE(range == std::vector<std::string>{"a", "b", "c", "d", "0"});
+        REQUIRE(db.lindex("mylist", -1) == "99");
+    }
+
+    SECTION("LLEN follows pushes and pops at both ends") {
+        for (int i = 0; i < 50; ++i) {
+            db.rpush("queue", std::to_string(i));
+            db.lpush("queue", std::to_string(-i));
+        }
+        REQUIRE(db.llen("queue") == 100);
+        REQUIRE(db.lpop("queue", 10).size() == 10);
+        REQUIRE(db.rpop("queue", 10).size() == 10);
+        REQUIRE(db.llen("queue") == 80);
+        REQUIRE(db.lindex("queue", 0) == "-39");
+        REQUIRE(db.lindex("queue", -1) == "39");
+
+        db.lpop("queue", 80);
+        REQUIRE(db.llen("queue") == 0);
+        REQUIRE_FALSE(db.exists("queue"));
+    }
+}
+
+// Run with: ./test_lists "[benchmark]"
+// Push/pop cost should stay flat as the queue grows.
+TEST_CASE("List queue throughput", "[.][benchmark]") {
+    auto db = Database::open_memory();
+    for (int backlog : {0, 10000, 100000}) {
+        db.del("queue");
+        std::vector<std::string> storage(backlog, std::string(16, 'x'));
+        std::vector<std::string_view> views(storage.begin(), storage.end());
+        if (backlog > 0) db.rpush("queue", views);
+
+        constexpr int kOps = 20000;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kOps; ++i) {
+            db.rpush("queue", std::string_view("item"));
+            db.lpop("queue");
+            db.llen("queue");
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("backlog %6d: %.0f ns per rpush+lpop+llen\n", backlog, elapsed.count() / kOps);
+    }
 }
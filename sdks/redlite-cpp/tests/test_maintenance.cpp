@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/maintenance.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+using namespace redlite;
+using namespace std::chrono_literals;
+
+namespace {
+
+void remove_db(const std::filesystem::path& path) {
+    for (const char* suffix : {"", "-wal", "-shm"}) std::filesystem::remove(path.string() + suffix);
+}
+
+// Write n keys that expire after 1ms and wait for them to expire
+void expire_keys(Database& db, int n, size_t value_size = 64) {
+    SetOptions opts;
+    opts.px = 1;
+    std::string value(value_size, 'v');
+    auto tx = db.transaction();
+    for (int i = 0; i < n; ++i) db.set("exp:" + std::to_string(i), value, opts);
+    tx.commit();
+    std::this_thread::sleep_for(5ms);
+}
+
+} // namespace
+
+TEST_CASE("Maintenance step", "[maintenance]") {
+    auto db = Database::open_memory();
+    db.set_autovacuum(false);
+    db.set("keep", "v");
+    expire_keys(db, 500);
+
+    SECTION("budget bounds each slice") {
+        auto first = db.maintenance_step(1);
+        REQUIRE(first.keys_reclaimed > 0);
+        REQUIRE(first.keys_reclaimed < 500);
+        REQUIRE(first.more);
+
+        while (db.maintenance_step(50000).more) {}
+        REQUIRE(db.dbsize() == 1);
+        auto stats = db.maintenance_stats();
+        REQUIRE(stats.keys_reclaimed == 500);
+        REQUIRE(stats.pause_max_us <= stats.pause_total_us);
+    }
+
+    SECTION("budget settings") {
+        db.set_autovacuum_budget(2000);
+        REQUIRE(db.autovacuum_budget() == 2000);
+        db.set_autovacuum_interval(5000);
+        REQUIRE(db.autovacuum_interval() == 5000);
+    }
+
+    SECTION("skipped inside a transaction") {
+        auto tx = db.transaction();
+        REQUIRE(db.maintenance_step().keys_reclaimed == 0);
+        tx.rollback();
+        REQUIRE(db.maintenance_step(50000).keys_reclaimed > 0);
+    }
+}
+
+TEST_CASE("Eviction from maintenance", "[maintenance]") {
+    auto db = Database::open(":memory:", OpenOptionsBuilder()
+        .max_memory(50 * 1024)
+        .eviction_policy(EvictionPolicy::AllKeysLRU)
+        .build());
+    std::string value(1024, 'v');
+    {
+        // Writes inside a transaction never evict
+        auto tx = db.transaction();
+        for (int i = 0; i < 100; ++i) db.set("k:" + std::to_string(i), value);
+        tx.commit();
+    }
+    db.get("k:0");
+    REQUIRE(db.dbsize() == 100);
+
+    uint64_t evicted = 0;
+    for (;;) {
+        auto step = db.maintenance_step(50000);
+        evicted += step.keys_evicted;
+        if (!step.more) break;
+    }
+    REQUIRE(evicted > 0);
+    REQUIRE(db.dbsize() == 100 - static_cast<int64_t>(evicted));
+    REQUIRE(db.maintenance_stats().keys_evicted == evicted);
+    REQUIRE(db.get("k:0") == value);
+}
+
+TEST_CASE("MaintenanceScheduler", "[maintenance]") {
+    auto path = std::filesystem::temp_directory_path() / "redlite_maintenance.db";
+    remove_db(path);
+    {
+        auto db = Database::open(path.string(), OpenOptionsBuilder().incremental_vacuum(true).build());
+        db.set_autovacuum(false);
+        db.set("keep", "v");
+        expire_keys(db, 2000, 1024);
+
+        MaintenanceOptions options;
+        options.interval = 10ms;
+        options.budget = 2ms;
+        MaintenanceScheduler maintenance(db, options);
+
+        auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (db.dbsize() > 1 && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(5ms);
+        REQUIRE(db.dbsize() == 1);
+
+        // Let the idle pass release pages and checkpoint
+        deadline = std::chrono::steady_clock::now() + 5s;
+        while (maintenance.report().checkpoints == 0 && std::chrono::steady_clock::now() < deadline) {
+            maintenance.wake();
+            std::this_thread::sleep_for(5ms);
+        }
+
+        auto report = maintenance.report();
+        maintenance.stop();
+        REQUIRE(report.last_error.empty());
+        REQUIRE(report.keys_reclaimed == 2000);
+        REQUIRE(report.pages_freed > 0);
+        REQUIRE(report.checkpoints > 0);
+        REQUIRE(report.worst_pause_us > 0);
+        REQUIRE(report.last_pass_keys_per_second > 0);
+        REQUIRE(report.totals.keys_reclaimed == 2000);
+
+        std::string text = report.to_prometheus();
+        REQUIRE(text.find("redlite_maintenance_keys_reclaimed_total 2000") != std::string::npos);
+        REQUIRE(text.find("# TYPE redlite_maintenance_pause_max_seconds gauge") != std::string::npos);
+    }
+    remove_db(path);
+}
+
+// Run with: ./test_maintenance "[benchmark]"
+// Longest foreground GET while 200k expired keys are reclaimed by vacuum()
+// versus the scheduler in 2ms slices.
+TEST_CASE("Maintenance pause times", "[.][benchmark]") {
+    constexpr int kKeys = 200000;
+    auto path = std::filesystem::temp_directory_path() / "redlite_maintenance_bench.db";
+
+    auto worst_get = [&](auto&& reclaim) {
+        remove_db(path);
+        auto db = Database::open(path.string(), OpenOptionsBuilder().incremental_vacuum(true).build());
+        db.set_autovacuum(false);
+        db.set("hot", "v");
+        expire_keys(db, kKeys, 256);
+
+        std::atomic<bool> done{false};
+        std::chrono::duration<double, std::milli> worst{0};
+        std::thread reader([&] {
+            while (!done) {
+                auto start = std::chrono::steady_clock::now();
+                db.get("hot");
+                worst = std::max(worst, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start));
+            }
+        });
+        auto start = std::chrono::steady_clock::now();
+        reclaim(db);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        done = true;
+        reader.join();
+        REQUIRE(db.dbsize() == 1);
+        std::printf("  reclaimed in %.2fs, worst GET %.1f ms\n", elapsed.count(), worst.count());
+        remove_db(path);
+    };
+
+    std::printf("vacuum():\n");
+    worst_get([](Database& db) { db.vacuum(); });
+
+    std::printf("MaintenanceScheduler (2ms slices):\n");
+    worst_get([](Database& db) {
+        MaintenanceOptions options;
+        options.budget = 2ms;
+        MaintenanceScheduler maintenance(db, options);
+        while (db.dbsize() > 1) std::this_thread::sleep_for(1ms);
+        std::printf("  %.0f keys/s, worst slice %llu us\n", maintenance.report().last_pass_keys_per_second,
+                    static_cast<unsigned long long>(maintenance.report().worst_pause_us));
+    });
+}
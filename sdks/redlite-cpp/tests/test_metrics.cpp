@@ -0,0 +1,137 @@
+#ifndef REDLITE_ENABLE_METRICS
+#define REDLITE_ENABLE_METRICS
+#endif
+
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
+
+using namespace redlite;
+using metrics::detail::Histogram;
+
+TEST_CASE("Histogram buckets", "[metrics]") {
+    SECTION("every value lands in a bucket that covers it") {
+        for (uint64_t v : {0ull, 1ull, 15ull, 16ull, 17ull, 31ull, 32ull, 1000ull, 123456789ull}) {
+            size_t i = Histogram::index(v);
+            REQUIRE(Histogram::upper(i) >= v);
+            if (i > 0) REQUIRE(Histogram::upper(i - 1) < v);
+        }
+        REQUIRE(Histogram::index(UINT64_MAX) == Histogram::kBuckets - 1);
+    }
+
+    SECTION("bucket width stays within 1/16 of the value") {
+        for (size_t i = Histogram::kSub; i + 1 < Histogram::kBuckets; ++i) {
+            uint64_t lower = Histogram::upper(i - 1) + 1;
+            REQUIRE(Histogram::upper(i) - lower + 1 <= lower / Histogram::kSub + 1);
+        }
+    }
+
+    SECTION("percentiles") {
+        Histogram h;
+        h.reset();
+        for (uint64_t v = 1; v <= 1000; ++v) h.record(v * 1000);
+        auto s = h.snapshot();
+        REQUIRE(s.count == 1000);
+        REQUIRE(s.min_ns == 1000);
+        REQUIRE(s.max_ns == 1000000);
+        auto p50 = s.percentile(0.5);
+        REQUIRE(p50 >= 500000);
+        REQUIRE(p50 <= 500000 * 17 / 16);
+        REQUIRE(s.percentile(1.0) == s.max_ns);
+    }
+}
+
+TEST_CASE("Command metrics", "[metrics]") {
+    auto db = Database::open_memory();
+    metrics::reset();
+
+    SECTION("counts calls, bytes and phases") {
+        for (int i = 0; i < 10; ++i) db.set("key", "value");
+        for (int i = 0; i < 5; ++i) REQUIRE(db.get("key") == "value");
+
+        auto snap = metrics::snapshot();
+        const CommandMetrics* set = snap.find("set");
+        const CommandMetrics* get = snap.find("get");
+        REQUIRE(set);
+        REQUIRE(get);
+        REQUIRE(set->calls == 10);
+        REQUIRE(set->bytes_in == 10 * 8);
+        REQUIRE(get->calls == 5);
+        REQUIRE(get->bytes_in == 5 * 3);
+        REQUIRE(get->bytes_out == 5 * 5);
+        REQUIRE(get->latency.count == 5);
+        REQUIRE(get->ffi.count == 5);
+        REQUIRE(get->ffi.sum_ns <= get->latency.sum_ns);
+        REQUIRE(get->ffi.sum_ns + get->cpp.sum_ns == get->latency.sum_ns);
+    }
+
+    SECTION("nested calls are recorded once") {
+        SetOptions opts;
+        opts.ex = 10;
+        db.set("key", "value", opts);
+        REQUIRE(metrics::snapshot().find("set")->calls == 1);
+    }
+
+    SECTION("exceptions count as errors") {
+        XAddOptions opts;
+        opts.nomkstream = true;
+        REQUIRE_THROWS_AS(db.xadd("missing", {{"f", "v"}}, opts), Error);
+        const CommandMetrics* xadd = metrics::snapshot().find("xadd");
+        REQUIRE(xadd);
+        REQUIRE(xadd->calls == 1);
+        REQUIRE(xadd->errors == 1);
+    }
+
+    SECTION("Prometheus export") {
+        db.hset("h", "f", "v");
+        std::string text = metrics::snapshot().to_prometheus();
+        REQUIRE(text.find("# TYPE redlite_command_calls_total counter") != std::string::npos);
+        REQUIRE(text.find("redlite_command_calls_total{command=\"hset\"} 1") != std::string::npos);
+        REQUIRE(text.find("redlite_command_duration_seconds_bucket{command=\"hset\",phase=\"ffi\",le=\"+Inf\"} 1") !=
+                std::string::npos);
+    }
+
+    SECTION("reset zeroes counters") {
+        db.set("key", "value");
+        metrics::reset();
+        REQUIRE(metrics::snapshot().find("set")->calls == 0);
+    }
+}
+
+TEST_CASE("Database stats", "[metrics]") {
+    auto db = Database::open_memory();
+    for (int i = 0; i < 20; ++i) db.set("k" + std::to_string(i), "v");
+    db.checkpoint();
+
+    auto stats = db.stats();
+    REQUIRE(stats.statements > 0);
+    REQUIRE(stats.statement_reuses() > 0);
+    REQUIRE(stats.cache_hits > 0);
+    REQUIRE(stats.checkpoints == 1);
+    REQUIRE(stats.lock_waits == 0);
+
+    std::string text = stats.to_prometheus();
+    REQUIRE(text.find("redlite_sqlite_checkpoints_total 1") != std::string::npos);
+    REQUIRE(text.find("# TYPE redlite_lock_wait_seconds_total counter") != std::string::npos);
+}
+
+// Run with: ./test_metrics "[benchmark]"
+// Per-call cost of the instrumentation on a hot GET.
+TEST_CASE("Metrics overhead", "[.][benchmark]") {
+    constexpr int kCalls = 200000;
+    auto db = Database::open_memory();
+    db.set("key", "value");
+    metrics::reset();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kCalls; ++i) db.get("key");
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    auto get = *metrics::snapshot().find("get");
+    std::printf("get: %.0f ns/call, p50 %llu ns, p99 %llu ns, ffi %.0f%%\n",
+                elapsed.count() / kCalls,
+                static_cast<unsigned long long>(get.latency.percentile(0.5)),
+                static_cast<unsigned long long>(get.latency.percentile(0.99)),
+                100.0 * get.ffi.sum_ns / get.latency.sum_ns);
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+using namespace redlite;
+
+namespace {
+
+void remove_db(const std::filesystem::path& path) {
+    for (const char* suffix : {"", "-wal", "-shm"}) std::filesystem::remove(path.string() + suffix);
+}
+
+std::filesystem::path temp_db(const char* name) {
+    auto path = std::filesystem::temp_directory_path() / name;
+    remove_db(path);
+    return path;
+}
+
+} // namespace
+
+TEST_CASE("Open options", "[open]") {
+    SECTION("builder sets only the given fields") {
+        auto options = OpenOptionsBuilder()
+            .cache_mb(8)
+            .synchronous(Synchronous::Full)
+            .page_size(16384)
+            .build();
+        REQUIRE(options.cache_mb == 8);
+        REQUIRE(options.synchronous == Synchronous::Full);
+        REQUIRE(options.page_size == 16384u);
+        REQUIRE_FALSE(options.mmap_size.has_value());
+        REQUIRE_FALSE(options.statement_cache.has_value());
+    }
+
+    SECTION("opens a file database with every knob set") {
+        auto path = temp_db("redlite_open_options.db");
+        {
+            auto db = Database::open(path.string(), OpenOptionsBuilder()
+                .cache_mb(8)
+                .mmap_size(0)
+                .synchronous(Synchronous::Full)
+                .page_size(16384)
+                .wal_autocheckpoint(0)
+                .temp_store_memory(false)
+                .busy_timeout_ms(100)
+                .statement_cache(64)
+                .build());
+            db.set("k", "v");
+            db.checkpoint();
+        }
+        {
+            Database db(path.string());
+            REQUIRE(db.get("k") == "v");
+        }
+        remove_db(path);
+    }
+
+    SECTION("rejects invalid settings") {
+        REQUIRE_THROWS_AS(Database::open(":memory:", OpenOptionsBuilder().page_size(1000).build()), Error);
+        REQUIRE_THROWS_AS(Database::open(":memory:", OpenOptionsBuilder().synchronous(static_cast<Synchronous>(9)).build()),
+                          Error);
+        REQUIRE_THROWS_AS(
+            Database::open(":memory:", OpenOptionsBuilder().eviction_policy(static_cast<EvictionPolicy>(9)).build()),
+            Error);
+    }
+}
+
+// Run with: ./test_open "[benchmark]"
+// Effect of each knob on a file database; see "Open Options" in the README.
+TEST_CASE("Open option effects", "[.][benchmark]") {
+    auto time = [](const char* label, const OpenOptions& options, auto&& setup, auto&& work) {
+        auto path = temp_db("redlite_open_bench.db");
+        {
+            auto db = Database::open(path.string(), options);
+            setup(db);
+            auto start = std::chrono::steady_clock::now();
+            int ops = work(db);
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            std::printf("%-36s %8.1f us/op\n", label, elapsed.count() / ops);
+        }
+        remove_db(path);
+    };
+    auto none = [](Database&) {};
+
+    // synchronous: one commit per SET
+    const std::string small(64, 'v');
+    auto commits = [&](Database& db) {
+        for (int i = 0; i < 2000; ++i) db.set("key:" + std::to_string(i), small);
+        return 2000;
+    };
+    time("synchronous=OFF    2000x SET", OpenOptionsBuilder().synchronous(Synchronous::Off).build(), none, commits);
+    time("synchronous=NORMAL 2000x SET", OpenOptionsBuilder().synchronous(Synchronous::Normal).build(), none, commits);
+    time("synchronous=FULL   2000x SET", OpenOptionsBuilder().synchronous(Synchronous::Full).build(), none, commits);
+
+    // mmap_size: random reads of a file much larger than the page cache
+    constexpr int kKeys = 20000;
+    const std::string kb(1024, 'r');
+    auto fill = [&](Database& db) {
+        auto tx = db.transaction();
+        for (int i = 0; i < kKeys; ++i) db.set("key:" + std::to_string(i), kb);
+        tx.commit();
+        db.checkpoint();
+    };
+    auto reads = [&](Database& db) {
+        std::mt19937 rng(42);
+        for (int i = 0; i < 100000; ++i) db.get("key:" + std::to_string(rng() % kKeys));
+        return 100000;
+    };
+    time("mmap_size=0     100k random GET", OpenOptionsBuilder().cache_mb(2).mmap_size(0).build(), fill, reads);
+    time("mmap_size=256MB 100k random GET", OpenOptionsBuilder().cache_mb(2).mmap_size(256LL << 20).build(), fill, reads);
+
+    // page_size: blob-heavy writes (16 KB values overflow 4 KB pages)
+    const std::string blob(16 * 1024, 'b');
+    auto blobs = [&](Database& db) {
+        auto tx = db.transaction();
+        for (int i = 0; i < 5000; ++i) db.set("blob:" + std::to_string(i), blob);
+        tx.commit();
+        return 5000;
+    };
+    time("page_size=4096  5000x 16KB SET", OpenOptionsBuilder().page_size(4096).build(), none, blobs);
+    time("page_size=16384 5000x 16KB SET", OpenOptionsBuilder().page_size(16384).build(), none, blobs);
+
+    // wal_autocheckpoint: checkpoints moved off the write path
+    time("wal_autocheckpoint=1000 2000x SET", OpenOptionsBuilder().wal_autocheckpoint(1000).build(), none, commits);
+    time("wal_autocheckpoint=0    2000x SET", OpenOptionsBuilder().wal_autocheckpoint(0).build(), none, commits);
+}
@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <redlite/redlite.hpp>
+#include <filesystem>
+
+using namespace redlite;
+
+TEST_CASE("Pipeline", "[pipeline]") {
+    auto db = Database::open_memory();
+
+    SECTION("typed replies") {
+        auto pipe = db.pipeline();
+        pipe.set("k", "v")
+            .get("k")
+            .get("missing")
+            .incr("n")
+            .incrby("n", 10)
+            .zadd("z", 1.5, "a")
+            .zscore("z", "a");
+        REQUIRE(pipe.size() == 7);
+
+        auto replies = pipe.exec();
+        REQUIRE(replies.size() == 7);
+        REQUIRE(pipe.empty());
+
+        REQUIRE(replies[0].type == Reply::Type::Ok);
+        REQUIRE(replies[1].type == Reply::Type::Bytes);
+        REQUIRE(replies[1].str == "v");
+        REQUIRE(replies[2].is_nil());
+        REQUIRE(replies[3].integer == 1);
+        REQUIRE(replies[4].integer == 11);
+        REQUIRE(replies[5].integer == 1);
+        REQUIRE(replies[6].type == Reply::Type::Double);
+        REQUIRE(replies[6].number == 1.5);
+    }
+
+    SECTION("writes are visible after exec") {
+        auto pipe = db.pipeline();
+        for (int i = 0; i < 100; ++i) {
+            std::string key = "user:" + std::to_string(i);
+            pipe.hset(key, "name", "n" + std::to_string(i)).expire(key, 3600);
+        }
+        auto replies = pipe.exec();
+        REQUIRE(replies.size() == 200);
+        REQUIRE(replies[0].integer == 1);
+        REQUIRE(replies[1].integer == 1);
+
+        REQUIRE(db.hget("user:42", "name") == "n42");
+        REQUIRE(db.ttl("user:42") > 0);
+    }
+
+    SECTION("errors stay in their slot") {
+        db.set("str", "hello");
+        auto replies = db.pipeline()
+            .incr("str")
+            .hset("str", "f", "v")
+            .command({"NOSUCHCMD", "x"})
+            .set("after", "ok")
+            .exec();
+
+        REQUIRE(replies.size() == 4);
+        REQUIRE(replies[0].is_error());
+        REQUIRE(replies[1].is_error());
+        REQUIRE(replies[2].is_error());
+        REQUIRE_FALSE(replies[2].str.empty());
+        REQUIRE(replies[3].type == Reply::Type::Ok);
+        REQUIRE(db.get("after") == "ok");
+    }
+
+    SECTION("raw command with binary values") {
+        std::string bin("a\0b", 3);
+        auto replies = db.pipeline()
+            .command({"SET", "bin", bin})
+            .command({"get", "bin"})
+            .exec();
+        REQUIRE(replies[1].str == bin);
+    }
+
+    SECTION("set with ttl, lists, sets") {
+        auto replies = db.pipeline()
+            .set("t", "v", 100)
+            .ttl("t")
+            .rpush("l", {"a", "b", "c"})
+            .llen("l")
+            .sadd("s", {"x", "y"})
+            .sismember("s", "x")
+            .del(std::vector<std::string>{"t", "l"})
+            .exec();
+        REQUIRE(replies[1].integer > 0);
+        REQUIRE(replies[2].integer == 3);
+        REQUIRE(replies[3].integer == 3);
+        REQUIRE(replies[4].integer == 2);
+        REQUIRE(replies[5].integer == 1);
+        REQUIRE(replies[6].integer == 2);
+    }
+
+    SECTION("empty pipeline") {
+        auto pipe = db.pipeline();
+        REQUIRE(pipe.exec().empty());
+    }
+}
+
+// Run with: ./test_pipeline "[benchmark]"
+TEST_CASE("Pipeline vs individual calls", "[.][benchmark]") {
+    auto path = std::filesystem::temp_directory_path() / "redlite_pipeline_bench.db";
+    std::filesystem::remove(path);
+    {
+        Database db(path.string());
+
+        BENCHMARK("500x HSET+EXPIRE individual") {
+            for (int i = 0; i < 500; ++i) {
+                std::string key = "user:" + std::to_string(i);
+                db.hset(key, "name", "value");
+                db.expire(key, 3600);
+            }
+        };
+
+        BENCHMARK("500x HSET+EXPIRE pipelined") {
+            auto pipe = db.pipeline();
+            for (int i = 0; i < 500; ++i) {
+                std::string key = "user:" + std::to_string(i);
+                pipe.hset(key, "name", "value").expire(key, 3600);
+            }
+            return pipe.exec().size();
+        };
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/pool.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+using namespace redlite;
+
+namespace {
+
+void remove_db(const std::filesystem::path& path) {
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + "-wal");
+    std::filesystem::remove(path.string() + "-shm");
+}
+
+std::filesystem::path temp_db(const char* name) {
+    auto path = std::filesystem::temp_directory_path() / name;
+    remove_db(path);
+    return path;
+}
+
+} // namespace
+
+TEST_CASE("Connection pool", "[pool]") {
+    auto path = temp_db("redlite_pool_test.db");
+    {
+        Pool pool(path.string(), 4);
+        REQUIRE(pool.reader_count() == 4);
+
+        SECTION("readers see committed writes") {
+            REQUIRE(pool.set("k", "v"));
+            REQUIRE(pool.get("k") == "v");
+
+            pool.hset("h", "f", "1");
+            REQUIRE(pool.hget("h", "f") == "1");
+            pool.rpush("l", {"a", "b"});
+            REQUIRE(pool.lrange("l", 0, -1) == std::vector<std::string>{"a", "b"});
+            pool.sadd("s", {"x"});
+            REQUIRE(pool.sismember("s", "x"));
+            pool.zadd("z", 1.5, "m");
+            REQUIRE(pool.zscore("z", "m") == 1.5);
+        }
+
+        SECTION("leases route to the right handle") {
+            auto w = pool.writer();
+            REQUIRE(w.is_writer());
+            w->set("a", "1");
+
+            auto r = pool.reader();
+            REQUIRE_FALSE(r.is_writer());
+            REQUIRE(r->get("a") == "1");
+        }
+
+        SECTION("write callback can group commands in a transaction") {
+            pool.write([](Database& db) {
+                auto tx = db.transaction();
+                db.set("a", "1");
+                db.set("b", "2");
+                tx.commit();
+            });
+            REQUIRE(pool.mget({"a", "b"}) == std::vector<std::optional<std::string>>{"1", "2"});
+        }
+
+        SECTION("lease returns its reader to the pool") {
+            std::vector<Pool::Lease> held;
+            for (size_t i = 0; i < pool.reader_count(); ++i) held.push_back(pool.reader());
+            held.pop_back();
+            auto again = pool.reader();
+            REQUIRE_FALSE(again.is_writer());
+        }
+
+        SECTION("reader sees an expired key as missing") {
+            pool.set("gone", "v");
+            pool.write([](Database& db) { db.pexpire("gone", 1); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            REQUIRE_FALSE(pool.get("gone").has_value());
+        }
+
+        SECTION("concurrent readers and a writer") {
+            pool.set("counter", "0");
+            std::atomic<int> reads{0};
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&] {
+                    for (int i = 0; i < 200; ++i) {
+                        if (pool.get("counter")) ++reads;
+                    }
+                });
+            }
+            for (int i = 0; i < 100; ++i) pool.incr("counter");
+            for (auto& th : threads) th.join();
+
+            REQUIRE(reads == 800);
+            REQUIRE(pool.get("counter") == "100");
+        }
+    }
+    remove_db(path);
+}
+
+TEST_CASE("Pool with open options", "[pool]") {
+    auto path = temp_db("redlite_pool_options.db");
+    {
+        Pool pool(path.string(), 2, OpenOptionsBuilder().wal_autocheckpoint(0).cache_mb(8).build());
+        REQUIRE(pool.reader_count() == 2);
+        pool.set("k", "v");
+        pool.write([](Database& db) { db.checkpoint(); });
+        REQUIRE(pool.get("k") == "v");
+        REQUIRE(pool.write([](Database& db) { return db.stats().checkpoints; }) == 1);
+    }
+    remove_db(path);
+}
+
+TEST_CASE("Pool rejects in-memory databases", "[pool]") {
+    REQUIRE_THROWS_AS(Pool(":memory:", 2), Error);
+}
+
+// Run with: ./test_pool "[benchmark]"
+// Prints GET throughput for 1..32 threads against a shared mutex-guarded
+// Database and a Pool with one reader per thread.
+TEST_CASE("Pool read scaling", "[.][benchmark]") {
+    constexpr int kKeys = 1000;
+    constexpr int kOpsPerThread = 20000;
+    auto path = temp_db("redlite_pool_bench.db");
+    {
+        Pool pool(path.string(), 32);
+        pool.write([&](Database& db) {
+            auto tx = db.transaction();
+            for (int i = 0; i < kKeys; ++i) db.set("key:" + std::to_string(i), std::string(64, 'v'));
+            tx.commit();
+        });
+
+        Database shared(path.string());
+        std::mutex shared_mutex;
+
+        auto run = [&](int threads, auto&& get) {
+            std::vector<std::thread> workers;
+            auto start = std::chrono::steady_clock::now();
+            for (int t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    for (int i = 0; i < kOpsPerThread; ++i) {
+                        get("key:" + std::to_string((i * 31 + t) % kKeys));
+                    }
+                });
+            }
+            for (auto& w : workers) w.join();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            return threads * kOpsPerThread / elapsed.count();
+        };
+
+        std::printf("%8s %16s %16s\n", "threads", "shared ops/s", "pool ops/s");
+        for (int threads : {1, 2, 4, 8, 16, 32}) {
+            double single = run(threads, [&](const std::string& key) {
+                std::lock_guard<std::mutex> lock(shared_mutex);
+                return shared.get(key);
+            });
+            double pooled = run(threads, [&](const std::string& key) { return pool.get(key); });
+            std::printf("%8d %16.0f %16.0f\n", threads, single, pooled);
+        }
+    }
+    remove_db(path);
+}
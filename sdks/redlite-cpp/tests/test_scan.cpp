@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/redlite.hpp>
+#include <algorithm>
+#include <set>
+
+using namespace redlite;
+
+TEST_CASE("Scan iterators", "[scan]") {
+    auto db = Database::open_memory();
+
+    SECTION("scan visits every key across pages") {
+        for (int i = 0; i < 250; ++i) db.set("user:" + std::to_string(i), "v");
+        db.set("other", "v");
+
+        std::set<std::string> seen;
+        for (auto key : db.scan("user:*", 16)) seen.emplace(key);
+        REQUIRE(seen.size() == 250);
+        REQUIRE(seen.count("other") == 0);
+
+        size_t all = 0;
+        for (auto key : db.scan()) { (void)key; ++all; }
+        REQUIRE(all == 251);
+    }
+
+    SECTION("scan on empty database") {
+        auto range = db.scan();
+        REQUIRE(range.begin() == range.end());
+    }
+
+    SECTION("page size equal to result size") {
+        for (int i = 0; i < 10; ++i) db.set("k" + std::to_string(i), "v");
+        size_t n = 0;
+        for (auto key : db.scan("*", 10)) { (void)key; ++n; }
+        REQUIRE(n == 10);
+    }
+
+    SECTION("hscan yields field/value views") {
+        std::unordered_map<std::string, std::string> fields;
+        for (int i = 0; i < 50; ++i) fields["f" + std::to_string(i)] = "v" + std::to_string(i);
+        db.hset("h", fields);
+
+        std::unordered_map<std::string, std::string> seen;
+        for (auto [field, value] : db.hscan("h", "*", 7)) seen.emplace(field, value);
+        REQUIRE(seen == fields);
+    }
+
+    SECTION("sscan with pattern") {
+        db.sadd("s", {"apple", "avocado", "banana"});
+        std::vector<std::string> seen;
+        for (auto m : db.sscan("s", "a*", 1)) seen.emplace_back(m);
+        std::sort(seen.begin(), seen.end());
+        REQUIRE(seen == std::vector<std::string>{"apple", "avocado"});
+    }
+
+    SECTION("zscan yields members in score order") {
+        db.zadd("z", {{3, "c"}, {1, "a"}, {2, "b"}});
+        std::vector<std::string> members;
+        std::vector<double> scores;
+        for (auto m : db.zscan("z", "*", 2)) {
+            members.emplace_back(m.member);
+            scores.push_back(m.score);
+        }
+        REQUIRE(members == std::vector<std::string>{"a", "b", "c"});
+        REQUIRE(scores == std::vector<double>{1, 2, 3});
+    }
+
+    SECTION("scans of missing keys are empty") {
+        auto h = db.hscan("missing");
+        REQUIRE(h.begin() == h.end());
+        auto z = db.zscan("missing");
+        REQUIRE(z.begin() == z.end());
+    }
+
+    SECTION("wrong type throws on first fetch") {
+        db.set("str", "v");
+        auto range = db.hscan("str");
+        REQUIRE_THROWS_AS(range.begin(), Error);
+    }
+}
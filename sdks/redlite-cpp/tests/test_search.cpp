@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
+
+using namespace redlite;
+
+namespace {
+
+// doc:0..n-1 under the "idx" index; every tenth body repeats "rust"
+void load_docs(Database& db, int n) {
+    db.ft_create("idx", {"doc:"}, {{"body"}, {"title"}, {"n", FtFieldType::Numeric, true}});
+    for (int i = 0; i < n; ++i) {
+        std::string key = "doc:" + std::to_string(i);
+        db.hset(key, "body", i % 10 == 0 ? "rust rust rust and more rust" : "rust notes number " + std::to_string(i));
+        db.hset(key, "title", "title " + std::to_string(i));
+        db.hset(key, "n", std::to_string(i));
+    }
+}
+
+} // namespace
+
+TEST_CASE("FT.SEARCH hits", "[search]") {
+    auto db = Database::open_memory();
+    load_docs(db, 50);
+    db.hset("other:1", "body", "rust");
+
+    SECTION("count") {
+        REQUIRE(db.ft_count("idx", "rust") == 50);
+        REQUIRE(db.ft_count("idx", "number") == 45);
+        REQUIRE(db.ft_count("idx", "missing") == 0);
+    }
+
+    SECTION("one page with fields") {
+        FtSearchOptions opts;
+        opts.offset = 5;
+        opts.num = 3;
+        auto hits = db.ft_search("idx", "rust", opts);
+        REQUIRE(hits.total() == 50);
+        REQUIRE(hits.keys() == std::vector<std::string>{"doc:5", "doc:6", "doc:7"});
+        REQUIRE(hits[0].field_count() == 3);
+        REQUIRE(hits[0].get("title") == "title 5");
+        REQUIRE_FALSE(hits[0].get("missing").has_value());
+    }
+
+    SECTION("scores, RETURN and NOCONTENT") {
+        FtSearchOptions opts;
+        opts.withscores = true;
+        opts.num = 5;
+        opts.return_fields = {"title"};
+        auto hits = db.ft_search("idx", "rust", opts);
+        REQUIRE(hits.size() == 5);
+        for (size_t i = 0; i + 1 < hits.size(); ++i) REQUIRE(hits[i].score() >= hits[i + 1].score());
+        for (auto hit : hits) {
+            REQUIRE(hit.key().back() == '0');
+            REQUIRE(hit.field_count() == 1);
+            REQUIRE(hit.field(0).name == "title");
+        }
+
+        opts.nocontent = true;
+        auto keys_only = db.ft_search("idx", "rust", opts);
+        REQUIRE(keys_only.size() == 5);
+        REQUIRE(keys_only[0].field_count() == 0);
+    }
+
+    SECTION("SORTBY") {
+        FtSearchOptions opts;
+        opts.num = 3;
+        opts.sortby = "n";
+        opts.sortby_desc = true;
+        auto hits = db.ft_search("idx", "rust", opts);
+        REQUIRE(hits.keys() == std::vector<std::string>{"doc:49", "doc:48", "doc:47"});
+    }
+
+    SECTION("unknown index") {
+        REQUIRE_THROWS_AS(db.ft_search("nope", "rust"), Error);
+        REQUIRE_THROWS_AS(db.ft_count("nope", "rust"), Error);
+    }
+
+    SECTION("drop index") {
+        REQUIRE(db.ft_dropindex("idx"));
+        REQUIRE_FALSE(db.ft_dropindex("idx"));
+    }
+}
+
+TEST_CASE("FT.SEARCH iterator", "[search]") {
+    auto db = Database::open_memory();
+    load_docs(db, 50);
+
+    SECTION("visits every match across pages") {
+        auto search = db.ft_search_iter("idx", "rust", {}, 7);
+        std::vector<std::string> keys;
+        for (auto hit : search) keys.emplace_back(hit.key());
+        REQUIRE(search.total() == 50);
+        REQUIRE(keys.size() == 50);
+        for (int i = 0; i < 50; ++i) REQUIRE(keys[i] == "doc:" + std::to_string(i));
+    }
+
+    SECTION("page size equal to result size") {
+        size_t n = 0;
+        for (auto hit : db.ft_search_iter("idx", "rust", {}, 50)) n += hit.key().empty() ? 0 : 1;
+        REQUIRE(n == 50);
+    }
+
+    SECTION("starts at the offset") {
+        FtSearchOptions opts;
+        opts.offset = 45;
+        std::vector<std::string> keys;
+        for (auto hit : db.ft_search_iter("idx", "rust", opts, 2)) keys.emplace_back(hit.key());
+        REQUIRE(keys == std::vector<std::string>{"doc:45", "doc:46", "doc:47", "doc:48", "doc:49"});
+    }
+
+    SECTION("no matches") {
+        auto search = db.ft_search_iter("idx", "missing");
+        REQUIRE(search.begin() == search.end());
+    }
+}
+
+// Run with: ./test_search "[benchmark]"
+// Reading the top 100 of 20k matches one page at a time.
+TEST_CASE("FT.SEARCH paging", "[.][benchmark]") {
+    constexpr int kDocs = 20000;
+    constexpr int kQueries = 200;
+    auto db = Database::open_memory();
+    load_docs(db, kDocs);
+
+    FtSearchOptions opts;
+    opts.num = 100;
+    for (bool withscores : {false, true}) {
+        opts.withscores = withscores;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kQueries; ++i) {
+            opts.offset = (i * 100) % kDocs;
+            auto hits = db.ft_search("idx", "rust", opts);
+            if (hits.size() != 100) FAIL("short page");
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("withscores=%d: %.0f us/page\n", withscores ? 1 : 0, elapsed.count() / kQueries);
+    }
+}
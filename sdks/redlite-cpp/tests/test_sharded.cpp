@@ -0,0 +1,177 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/sharded.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+using namespace redlite;
+
+namespace {
+
+void remove_shards(const std::string& path, size_t shards) {
+    for (size_t i = 0; i < shards; ++i) {
+        std::string file = ShardedDatabase::shard_path(path, i);
+        std::filesystem::remove(file);
+        std::filesystem::remove(file + "-wal");
+        std::filesystem::remove(file + "-shm");
+    }
+}
+
+} // namespace
+
+TEST_CASE("Shard routing", "[sharded]") {
+    SECTION("hash tags") {
+        REQUIRE(ShardedDatabase::hash_tag("user:1") == "user:1");
+        REQUIRE(ShardedDatabase::hash_tag("{user:1}:profile") == "user:1");
+        REQUIRE(ShardedDatabase::hash_tag("a{b}{c}") == "b");
+        REQUIRE(ShardedDatabase::hash_tag("a{}b") == "a{}b");
+        REQUIRE(ShardedDatabase::hash_tag("a{b") == "a{b");
+    }
+
+    SECTION("shard paths") {
+        REQUIRE(ShardedDatabase::shard_path("data.db", 3) == "data.3.db");
+        REQUIRE(ShardedDatabase::shard_path("/tmp/v1.0/data", 0) == "/tmp/v1.0/data.0");
+        REQUIRE(ShardedDatabase::shard_path(".hidden", 1) == ".hidden.1");
+        REQUIRE(ShardedDatabase::shard_path(":memory:", 2) == ":memory:");
+    }
+}
+
+TEST_CASE("Sharded database", "[sharded]") {
+    ShardedDatabase db(":memory:", 4);
+    REQUIRE(db.size() == 4);
+
+    SECTION("keys spread over shards and tags stay together") {
+        std::vector<size_t> used(db.size());
+        for (int i = 0; i < 100; ++i) ++used[db.shard_index("key:" + std::to_string(i))];
+        REQUIRE(std::count(used.begin(), used.end(), 0) == 0);
+
+        size_t shard = db.shard_index("{user:1}");
+        REQUIRE(db.shard_index("{user:1}:profile") == shard);
+        REQUIRE(db.shard_index("{user:1}:sessions") == shard);
+
+        db.set("{user:1}:name", "alice");
+        auto local = db.shard(shard).get("{user:1}:name").get();
+        REQUIRE(local == "alice");
+    }
+
+    SECTION("single-key commands") {
+        REQUIRE(db.set("k", "v"));
+        REQUIRE(db.get("k") == "v");
+        REQUIRE(db.incr("n") == 1);
+        REQUIRE(db.incrby("n", 4) == 5);
+        db.hset("h", "f", "1");
+        REQUIRE(db.hget("h", "f") == "1");
+        db.rpush("l", {"a", "b"});
+        REQUIRE(db.lrange("l", 0, -1) == std::vector<std::string>{"a", "b"});
+        db.sadd("s", {"x"});
+        REQUIRE(db.smembers("s") == std::vector<std::string>{"x"});
+        db.zadd("z", 1.0, "m");
+        REQUIRE(db.zrange("z", 0, -1) == std::vector<std::string>{"m"});
+        REQUIRE(db.expire("k", 100));
+        REQUIRE(db.ttl("k") > 0);
+        REQUIRE(db.del("k") == 1);
+        REQUIRE_FALSE(db.exists("k"));
+    }
+
+    SECTION("multi-key commands merge in order") {
+        std::unordered_map<std::string, std::string> pairs;
+        std::vector<std::string> keys;
+        for (int i = 0; i < 50; ++i) {
+            keys.push_back("key:" + std::to_string(i));
+            pairs[keys.back()] = "v" + std::to_string(i);
+        }
+        REQUIRE(db.mset(pairs));
+
+        keys.push_back("missing");
+        auto values = db.mget(keys);
+        REQUIRE(values.size() == 51);
+        for (int i = 0; i < 50; ++i) REQUIRE(values[i] == "v" + std::to_string(i));
+        REQUIRE_FALSE(values[50].has_value());
+
+        REQUIRE(db.exists(keys) == 50);
+        REQUIRE(db.del({"key:1", "key:2", "missing"}) == 2);
+        REQUIRE(db.exists(keys) == 48);
+        REQUIRE(db.mget({}).empty());
+    }
+
+    SECTION("scan merges shards in key order") {
+        std::vector<std::string> expected;
+        for (int i = 0; i < 200; ++i) {
+            expected.push_back("user:" + std::to_string(i));
+            db.set(expected.back(), "v");
+        }
+        db.set("other", "v");
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<std::string> seen;
+        for (auto key : db.scan("user:*", 7)) seen.emplace_back(key);
+        REQUIRE(seen == expected);
+
+        size_t n = 0;
+        for (auto key : db.scan("nothing:*")) n += key.size();
+        REQUIRE(n == 0);
+    }
+
+    SECTION("writes from many threads") {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&db, t] {
+                for (int i = 0; i < 100; ++i) db.set("t" + std::to_string(t) + ":" + std::to_string(i), "v");
+            });
+        }
+        for (auto& th : threads) th.join();
+
+        size_t n = 0;
+        for (auto key : db.scan("t*", 50)) n += key.empty() ? 0 : 1;
+        REQUIRE(n == 400);
+    }
+}
+
+TEST_CASE("Sharded files", "[sharded]") {
+    auto path = (std::filesystem::temp_directory_path() / "redlite_sharded_test.db").string();
+    remove_shards(path, 3);
+    {
+        ShardedDatabase db(path, 3);
+        for (int i = 0; i < 30; ++i) db.set("k" + std::to_string(i), std::to_string(i));
+    }
+    for (size_t i = 0; i < 3; ++i) REQUIRE(std::filesystem::exists(ShardedDatabase::shard_path(path, i)));
+    {
+        ShardedDatabase db(path, 3);
+        REQUIRE(db.get("k7") == "7");
+        std::vector<std::string> keys;
+        for (int i = 0; i < 30; ++i) keys.push_back("k" + std::to_string(i));
+        REQUIRE(db.exists(keys) == 30);
+    }
+    remove_shards(path, 3);
+}
+
+// Run with: ./test_sharded "[benchmark]"
+// SET throughput with 8 writer threads against 1, 2, 4 and 8 shard files.
+TEST_CASE("Sharded write scaling", "[.][benchmark]") {
+    constexpr int kThreads = 8;
+    constexpr int kPerThread = 5000;
+    auto path = (std::filesystem::temp_directory_path() / "redlite_sharded_bench.db").string();
+
+    for (size_t shards : {size_t{1}, size_t{2}, size_t{4}, size_t{8}}) {
+        remove_shards(path, shards);
+        {
+            ShardedDatabase db(path, shards);
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (int t = 0; t < kThreads; ++t) {
+                threads.emplace_back([&db, t] {
+                    std::string value(64, 'x');
+                    for (int i = 0; i < kPerThread; ++i) {
+                        db.set("t" + std::to_string(t) + ":" + std::to_string(i), value);
+                    }
+                });
+            }
+            for (auto& th : threads) th.join();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            std::printf("%zu shard(s): %.0f SET/s\n", shards, kThreads * kPerThread / elapsed.count());
+        }
+        remove_shards(path, shards);
+    }
+}
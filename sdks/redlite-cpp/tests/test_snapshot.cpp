@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace redlite;
+
+namespace {
+
+void remove_db(const std::filesystem::path& path) {
+    for (const char* suffix : {"", "-wal", "-shm"}) std::filesystem::remove(path.string() + suffix);
+}
+
+std::filesystem::path temp_file(const char* name) {
+    auto path = std::filesystem::temp_directory_path() / name;
+    remove_db(path);
+    return path;
+}
+
+} // namespace
+
+TEST_CASE("Snapshot export and import", "[snapshot]") {
+    auto snap = temp_file("redlite_test.rlsnap").string();
+    auto db = Database::open_memory();
+    db.set("s", "value");
+    db.set("ttl", "soon", 3600);
+    db.hset("h", "f", "v");
+    db.rpush("l", {"a", "b", "c"});
+    db.sadd("set", std::vector<std::string>{"x", "y"});
+    db.zadd("z", 1.5, "m");
+    db.xadd("stream", {{"k", "v"}});
+    db.geoadd("cities", {{-122.4194, 37.7749, "SF"}});
+    db.select(1);
+    db.set("other", "db1");
+    db.select(0);
+
+    auto out = db.export_snapshot(snap);
+    REQUIRE(out.keys == 9);
+    REQUIRE(out.bytes == std::filesystem::file_size(snap));
+
+    SECTION("round trip into a fresh database") {
+        auto copy = Database::open_memory();
+        copy.set("s", "replaced");
+        copy.set("untouched", "1");
+        auto in = copy.import_snapshot(snap);
+        REQUIRE(in.keys == out.keys);
+        REQUIRE(in.items == out.items);
+
+        REQUIRE(copy.get("s") == "value");
+        REQUIRE(copy.get("untouched") == "1");
+        REQUIRE(copy.ttl("ttl") > 3500);
+        REQUIRE(copy.hgetall("h").at("f") == "v");
+        REQUIRE(copy.lrange("l", 0, -1) == std::vector<std::string>{"a", "b", "c"});
+        REQUIRE(copy.smembers("set").size() == 2);
+        REQUIRE(copy.zscore("z", "m") == 1.5);
+        REQUIRE(copy.xlen("stream") == 1);
+        REQUIRE(copy.geopos("cities", {"SF"})[0]->latitude == Catch::Approx(37.7749));
+        copy.select(1);
+        REQUIRE(copy.get("other") == "db1");
+    }
+
+    SECTION("corrupt and missing files throw") {
+        {
+            std::fstream f(snap, std::ios::in | std::ios::out | std::ios::binary);
+            f.seekp(-4, std::ios::end);
+            f.put('\xff');
+        }
+        auto copy = Database::open_memory();
+        REQUIRE_THROWS_AS(copy.import_snapshot(snap), Error);
+        REQUIRE(copy.dbsize() == 0);
+        REQUIRE_THROWS_AS(copy.import_snapshot(snap + ".missing"), Error);
+    }
+
+    std::filesystem::remove(snap);
+}
+
+// Run with: ./test_snapshot "[benchmark]"
+// Export and import of 200k hash fields from a file database.
+TEST_CASE("Snapshot throughput", "[.][benchmark]") {
+    constexpr int kKeys = 20000;
+    constexpr int kFields = 10;
+    auto path = temp_file("redlite_snapshot_bench.db");
+    auto snap = temp_file("redlite_snapshot_bench.rlsnap").string();
+    auto restored = temp_file("redlite_snapshot_bench_restored.db");
+    {
+        Database db(path.string());
+        std::string value(100, 'v');
+        for (int i = 0; i < kKeys; ++i) {
+            for (int f = 0; f < kFields; ++f) db.hset("user:" + std::to_string(i), "f" + std::to_string(f), value);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto out = db.export_snapshot(snap);
+        std::chrono::duration<double> exported = std::chrono::steady_clock::now() - start;
+
+        Database copy(restored.string());
+        start = std::chrono::steady_clock::now();
+        auto in = copy.import_snapshot(snap);
+        std::chrono::duration<double> imported = std::chrono::steady_clock::now() - start;
+        REQUIRE(in.items == out.items);
+
+        std::printf("export: %.0f items/s, %.1f MB/s; import: %.0f items/s\n", out.items / exported.count(),
+                    out.bytes / exported.count() / 1e6, in.items / imported.count());
+    }
+    remove_db(path);
+    remove_db(restored);
+    std::filesystem::remove(snap);
+}
@@ -0,0 +1,196 @@
+#include <catch2/catch_test_macros.hpp>
+#include <redlite/stream.hpp>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <thread>
+
+using namespace redlite;
+
+TEST_CASE("Stream commands", "[stream]") {
+    auto db = Database::open_memory();
+
+    SECTION("XADD and XRANGE") {
+        auto first = db.xadd("s", {{"type", "click"}, {"x", "1"}});
+        auto second = db.xadd("s", {{"type", "view"}});
+        REQUIRE(first < second);
+        REQUIRE(db.xlen("s") == 2);
+
+        auto batch = db.xrange("s");
+        REQUIRE(batch.size() == 2);
+        REQUIRE(batch[0].id() == first);
+        REQUIRE(batch[0].size() == 2);
+        REQUIRE(batch[0][0].name == "type");
+        REQUIRE(batch[0][0].value == "click");
+        REQUIRE(batch[0].get("x") == std::string_view("1"));
+        REQUIRE_FALSE(batch[1].get("x"));
+
+        auto rev = db.xrevrange("s", StreamId::max(), StreamId::min(), 1);
+        REQUIRE(rev.size() == 1);
+        REQUIRE(rev[0].id() == second);
+    }
+
+    SECTION("explicit IDs, XREAD and trimming") {
+        std::vector<std::pair<std::string, std::string>> fields{{"f", "v"}};
+        for (int64_t ms = 1; ms <= 5; ++ms) {
+            XAddOptions opts;
+            opts.id = {ms, 0};
+            REQUIRE(db.xadd("s", fields, opts) == StreamId{ms, 0});
+        }
+        REQUIRE(db.xread("s", {2, 0}).size() == 3);
+        REQUIRE(db.xread("s", {2, 0}, 2).ids() == std::vector<StreamId>{{3, 0}, {4, 0}});
+        REQUIRE(db.xdel("s", {{1, 0}}) == 1);
+        REQUIRE(db.xtrim("s", 2) == 2);
+        REQUIRE(db.xlen("s") == 2);
+        REQUIRE(StreamId{4, 0}.to_string() == "4-0");
+    }
+
+    SECTION("XADD errors") {
+        XAddOptions opts;
+        opts.nomkstream = true;
+        REQUIRE_THROWS_AS(db.xadd("missing", {{"f", "v"}}, opts), Error);
+        REQUIRE(db.xlen("missing") == 0);
+    }
+
+    SECTION("consumer groups") {
+        db.xadd("s", {{"n", "1"}});
+        db.xadd("s", {{"n", "2"}});
+        REQUIRE(db.xgroup_create("s", "g"));
+
+        auto batch = db.xreadgroup("g", "c1", "s");
+        REQUIRE(batch.size() == 2);
+        REQUIRE(db.xreadgroup("g", "c1", "s").empty());
+        REQUIRE(db.xreadgroup("g", "c1", "s", "0").size() == 2);
+
+        REQUIRE(db.xack("s", "g", batch.ids()) == 2);
+        REQUIRE(db.xreadgroup("g", "c1", "s", "0").empty());
+        REQUIRE(db.xack("s", "g", {}) == 0);
+
+        REQUIRE(db.xgroup_createconsumer("s", "g", "c2"));
+        REQUIRE(db.xgroup_delconsumer("s", "g", "c2") == 0);
+        REQUIRE(db.xgroup_destroy("s", "g"));
+        REQUIRE_THROWS_AS(db.xreadgroup("g", "c1", "s"), Error);
+    }
+
+    SECTION("keys and group names are length-delimited") {
+        std::string buffer = "s:1s:2";
+        std::string_view key(buffer.data(), 3);
+        db.xadd(key, {{"n", "1"}});
+        REQUIRE(db.xlen("s:1") == 1);
+        REQUIRE(db.xlen(buffer) == 0);
+
+        std::string nul_group("g\0h", 3);
+        REQUIRE(db.xgroup_create(key, nul_group));
+        REQUIRE(db.xreadgroup(nul_group, "c", key).size() == 1);
+        REQUIRE_THROWS_AS(db.xreadgroup("g", "c", key), Error);
+    }
+}
+
+TEST_CASE("StreamConsumer", "[stream]") {
+    auto db = Database::open_memory();
+    ConsumerOptions options;
+    options.batch_size = 10;
+    options.ack_batch = 4;
+
+    SECTION("reads in batches and acks in bulk") {
+        for (int i = 0; i < 25; ++i) db.xadd("jobs", {{"n", std::to_string(i)}});
+        StreamConsumer consumer(db, "jobs", "workers", "w1", options);
+
+        std::vector<std::string> seen;
+        size_t total = 0;
+        while (size_t n = consumer.consume([&](StreamEntryView e) { seen.emplace_back(*e.get("n")); })) {
+            REQUIRE(n <= 10);
+            total += n;
+        }
+        REQUIRE(total == 25);
+        REQUIRE(seen.front() == "0");
+        REQUIRE(seen.back() == "24");
+        REQUIRE(consumer.queued_acks() < options.ack_batch);
+
+        consumer.flush();
+        REQUIRE(consumer.queued_acks() == 0);
+        REQUIRE(consumer.pending().empty());
+    }
+
+    SECTION("failed handler leaves entries pending") {
+        for (int i = 0; i < 3; ++i) db.xadd("jobs", {{"n", std::to_string(i)}});
+        StreamConsumer consumer(db, "jobs", "workers", "w1", options);
+
+        REQUIRE_THROWS(consumer.consume([](StreamEntryView e) {
+            if (e.get("n") == std::string_view("1")) throw Error("boom");
+        }));
+        consumer.flush();
+        auto pending = consumer.pending();
+        REQUIRE(pending.size() == 2);
+        REQUIRE(pending[0].get("n") == std::string_view("1"));
+    }
+
+    SECTION("acks are flushed on destruction") {
+        db.xadd("jobs", {{"n", "0"}});
+        {
+            StreamConsumer consumer(db, "jobs", "workers", "w1", options);
+            consumer.ack(consumer.read());
+            REQUIRE(consumer.queued_acks() == 1);
+        }
+        REQUIRE(db.xreadgroup("workers", "w1", "jobs", "0").empty());
+    }
+
+    SECTION("blocking read times out when idle") {
+        StreamConsumer consumer(db, "jobs", "workers", "w1", options);
+        auto start = std::chrono::steady_clock::now();
+        REQUIRE(consumer.read(std::chrono::milliseconds(20)).empty());
+        REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+    }
+
+    SECTION("blocking read wakes on XADD from another thread") {
+        options.recheck_interval = std::chrono::seconds(10);
+        StreamConsumer consumer(db, "jobs", "workers", "w1", options);
+        std::thread producer([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            db.xadd("jobs", {{"n", "late"}});
+        });
+
+        auto start = std::chrono::steady_clock::now();
+        auto batch = consumer.read(std::chrono::seconds(5));
+        auto waited = std::chrono::steady_clock::now() - start;
+        producer.join();
+
+        REQUIRE(batch.size() == 1);
+        REQUIRE(batch[0].get("n") == std::string_view("late"));
+        REQUIRE(waited < std::chrono::seconds(2));
+    }
+}
+
+// Run with: ./test_stream "[benchmark]"
+// Measures produce and consume+ack throughput for a single consumer.
+TEST_CASE("Stream consumer throughput", "[.][benchmark]") {
+    constexpr int kEntries = 200000;
+    auto db = Database::open_memory();
+    std::vector<std::pair<std::string, std::string>> fields{{"type", "event"}, {"payload", std::string(64, 'p')}};
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        auto tx = db.transaction();
+        for (int i = 0; i < kEntries; ++i) db.xadd("bench", fields);
+        tx.commit();
+    }
+    std::chrono::duration<double> produced = std::chrono::steady_clock::now() - start;
+
+    ConsumerOptions options;
+    options.batch_size = 1000;
+    options.ack_batch = 1000;
+    StreamConsumer consumer(db, "bench", "g", "c", options);
+
+    size_t bytes = 0;
+    start = std::chrono::steady_clock::now();
+    size_t total = 0;
+    while (size_t n = consumer.consume([&](StreamEntryView e) { bytes += e.get("payload")->size(); })) {
+        total += n;
+    }
+    consumer.flush();
+    std::chrono::duration<double> consumed = std::chrono::steady_clock::now() - start;
+
+    REQUIRE(total == kEntries);
+    std::printf("produce: %.0f entries/s\n", kEntries / produced.count());
+    std::printf("consume+ack: %.0f entries/s (%zu payload bytes)\n", kEntries / consumed.count(), bytes);
+}
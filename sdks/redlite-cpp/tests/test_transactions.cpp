@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <redlite/redlite.hpp>
+#include <filesystem>
+
+using namespace redlite;
+
+TEST_CASE("Transactions", "[transactions]") {
+    auto db = Database::open_memory();
+
+    SECTION("commit persists writes") {
+        auto tx = db.transaction();
+        REQUIRE(tx.active());
+        REQUIRE(db.in_transaction());
+        db.set("a", "1");
+        db.hset("h", "f", "v");
+        tx.commit();
+
+        REQUIRE_FALSE(tx.active());
+        REQUIRE_FALSE(db.in_transaction());
+        REQUIRE(db.get("a") == "1");
+        REQUIRE(db.hget("h", "f") == "v");
+    }
+
+    SECTION("destructor rolls back") {
+        {
+            auto tx = db.transaction();
+            db.set("a", "1");
+        }
+        REQUIRE_FALSE(db.in_transaction());
+        REQUIRE_FALSE(db.get("a").has_value());
+    }
+
+    SECTION("explicit rollback") {
+        auto tx = db.transaction();
+        db.set("a", "1");
+        tx.rollback();
+        REQUIRE_FALSE(db.get("a").has_value());
+        REQUIRE_THROWS_AS(tx.commit(), Error);
+    }
+
+    SECTION("rollback on exception") {
+        try {
+            auto tx = db.transaction();
+            db.set("a", "1");
+            throw std::runtime_error("boom");
+        } catch (const std::runtime_error&) {
+        }
+        REQUIRE_FALSE(db.get("a").has_value());
+    }
+
+    SECTION("nested transaction is rejected") {
+        auto tx = db.transaction();
+        REQUIRE_THROWS_AS(db.transaction(), Error);
+        tx.commit();
+    }
+
+    SECTION("pipeline inside transaction commits with it") {
+        auto tx = db.transaction();
+        db.pipeline().set("p1", "1").set("p2", "2").exec();
+        REQUIRE(db.in_transaction());
+        tx.rollback();
+        REQUIRE_FALSE(db.get("p1").has_value());
+    }
+
+    SECTION("guard is movable") {
+        auto tx = db.transaction();
+        Transaction moved = std::move(tx);
+        REQUIRE_FALSE(tx.active());
+        db.set("a", "1");
+        moved.commit();
+        REQUIRE(db.get("a") == "1");
+    }
+}
+
+// Run with: ./test_transactions "[benchmark]"
+TEST_CASE("Bulk load with and without a transaction", "[.][benchmark]") {
+    constexpr int N = 2000;
+    auto path = std::filesystem::temp_directory_path() / "redlite_tx_bench.db";
+    std::filesystem::remove(path);
+    {
+        Database db(path.string());
+        const std::string value(64, 'v');
+
+        BENCHMARK("2000x SET per-command commit") {
+            for (int i = 0; i < N; ++i) db.set("key:" + std::to_string(i), value);
+        };
+
+        BENCHMARK("2000x SET in one transaction") {
+            auto tx = db.transaction();
+            for (int i = 0; i < N; ++i) db.set("key:" + std::to_string(i), value);
+            tx.commit();
+        };
+    }
+    std::filesystem::remove(path);
+}
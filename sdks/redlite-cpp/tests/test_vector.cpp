@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace redlite;
+
+namespace {
+
+// 8 well separated clusters of 50 points in 16 dimensions
+void add_clusters(Database& db, const std::string& key) {
+    for (int c = 0; c < 8; ++c) {
+        for (int i = 0; i < 50; ++i) {
+            std::vector<float> v(16, 0.0f);
+            v[c * 2] = 1.0f;
+            v[c * 2 + 1] = i * 0.01f;
+            db.vadd(key, v, "c" + std::to_string(c) + "-" + std::to_string(i));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("Vector set commands", "[vector]") {
+    auto db = Database::open_memory();
+
+    SECTION("VADD and VSIM into a caller buffer") {
+        REQUIRE(db.vadd("v", {1.0f, 0.0f, 0.0f}, "x"));
+        REQUIRE(db.vadd("v", {0.0f, 1.0f, 0.0f}, "y", R"({"tag":"b"})"));
+        REQUIRE_FALSE(db.vadd("v", {0.9f, 0.1f, 0.0f}, "x"));
+
+        float query[3] = {1.0f, 0.0f, 0.0f};
+        double scores[4];
+        std::vector<std::string> names;
+        REQUIRE(db.vsim("v", query, 3, scores, 4, &names) == 2);
+        REQUIRE(names == std::vector<std::string>{"x", "y"});
+        REQUIRE(scores[0] > scores[1]);
+        REQUIRE(scores[1] == Catch::Approx(0.0));
+
+        // Without names, bounded by capacity
+        REQUIRE(db.vsim("v", query, 3, scores, 1) == 1);
+    }
+
+    SECTION("vector overload sizes scores to the result count") {
+        db.vadd("v", {1.0f, 2.0f}, "a");
+        std::vector<double> scores;
+        REQUIRE(db.vsim("v", {1.0f, 2.0f}, 10, scores) == 1);
+        REQUIRE(scores.size() == 1);
+        REQUIRE(scores[0] == Catch::Approx(1.0));
+    }
+
+    SECTION("missing key and empty query") {
+        double scores[1];
+        float query[1] = {1.0f};
+        REQUIRE(db.vsim("missing", query, 1, scores, 1) == 0);
+        REQUIRE_THROWS_AS(db.vsim("missing", query, 0, scores, 1), Error);
+    }
+
+    SECTION("keys and elements are length-delimited") {
+        std::string buffer = "v:1v:2";
+        std::string_view key(buffer.data(), 3);
+        REQUIRE(db.vadd(key, {1.0f, 0.0f}, std::string_view(buffer.data() + 3, 3)));
+        std::vector<double> scores;
+        std::vector<std::string> names;
+        REQUIRE(db.vsim("v:1", {1.0f, 0.0f}, 2, scores, &names) == 1);
+        REQUIRE(names == std::vector<std::string>{"v:2"});
+        REQUIRE(db.vsim(buffer, {1.0f, 0.0f}, 2, scores) == 0);
+        REQUIRE_FALSE(db.vindex_drop(key));
+    }
+
+    SECTION("IVF index") {
+        add_clusters(db, "v");
+        REQUIRE(db.vindex("v", 8) == 8);
+
+        std::vector<float> q(16, 0.0f);
+        q[6] = 1.0f;
+        q[7] = 0.2f;
+        std::vector<double> probed, exact;
+        std::vector<std::string> probed_names, exact_names;
+        REQUIRE(db.vsim("v", q, 5, probed, &probed_names, 1) == 5);
+        REQUIRE(db.vsim("v", q, 5, exact, &exact_names, 0) == 5);
+        REQUIRE(probed_names.front() == "c3-20");
+        REQUIRE(probed_names == exact_names);
+
+        // Added after VINDEX: still found
+        std::vector<float> late(16, 0.0f);
+        late[15] = 1.0f;
+        db.vadd("v", late, "late");
+        std::vector<std::string> names;
+        std::vector<double> scores;
+        db.vsim("v", late, 1, scores, &names, 1);
+        REQUIRE(names == std::vector<std::string>{"late"});
+
+        REQUIRE(db.vindex_drop("v"));
+        REQUIRE_FALSE(db.vindex_drop("v"));
+    }
+}
+
+// Run with: ./test_vector "[benchmark]"
+// Compares exact VSIM against the IVF index on random 128-dim vectors.
+TEST_CASE("VSIM throughput", "[.][benchmark]") {
+    constexpr int kVectors = 20000;
+    constexpr int kDim = 128;
+    constexpr int kQueries = 200;
+    auto db = Database::open_memory();
+
+    std::mt19937 rng(42);
+    std::normal_distribution<float> dist;
+    auto random_vector = [&] {
+        std::vector<float> v(kDim);
+        for (auto& x : v) x = dist(rng);
+        return v;
+    };
+    {
+        auto tx = db.transaction();
+        for (int i = 0; i < kVectors; ++i) db.vadd("bench", random_vector(), "e" + std::to_string(i));
+        tx.commit();
+    }
+    std::vector<std::vector<float>> queries;
+    for (int i = 0; i < kQueries; ++i) queries.push_back(random_vector());
+
+    std::vector<double> scores(10);
+    auto time = [&](int64_t nprobe) {
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& q : queries) db.vsim("bench", q.data(), q.size(), scores.data(), scores.size(), nullptr, nprobe);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return kQueries / elapsed.count();
+    };
+
+    double exact = time(0);
+    auto start = std::chrono::steady_clock::now();
+    int64_t lists = db.vindex("bench");
+    std::chrono::duration<double> built = std::chrono::steady_clock::now() - start;
+    double ivf = time(-1);
+
+    std::printf("exact: %.0f queries/s\n", exact);
+    std::printf("ivf (%lld lists, built in %.2fs): %.0f queries/s\n",
+                static_cast<long long>(lists), built.count(), ivf);
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <redlite/redlite.hpp>
+#include <algorithm>
+#include <functional>
+
+using namespace redlite;
+
+TEST_CASE("Zero-copy views", "[views]") {
+    auto db = Database::open_memory();
+
+    SECTION("get_view borrows the value") {
+        db.set("key", "hello world");
+        auto b = db.get_view("key");
+        REQUIRE(b);
+        REQUIRE(b.view() == "hello world");
+        REQUIRE(b.size() == 11);
+    }
+
+    SECTION("get_view on missing key is empty") {
+        auto b = db.get_view("missing");
+        REQUIRE_FALSE(b);
+        REQUIRE(b.view().empty());
+    }
+
+    SECTION("getrange_view") {
+        db.set("key", "Hello World");
+        REQUIRE(db.getrange_view("key", 0, 4).view() == "Hello");
+    }
+
+    SECTION("hget_view and hgetall_view") {
+        db.hset("h", {{"a", "1"}, {"b", "2"}});
+        REQUIRE(db.hget_view("h", "a").view() == "1");
+        REQUIRE_FALSE(db.hget_view("h", "zzz"));
+
+        auto all = db.hgetall_view("h");
+        REQUIRE(all.size() == 4);
+        for (size_t i = 0; i + 1 < all.size(); i += 2) {
+            if (all[i] == "a") REQUIRE(all[i + 1] == "1");
+            else REQUIRE(all[i + 1] == "2");
+        }
+    }
+
+    SECTION("lrange_view iterates without copying") {
+        db.rpush("list", {"a", "b", "c"});
+        auto arr = db.lrange_view("list", 0, -1);
+        REQUIRE(arr.size() == 3);
+        REQUIRE(arr[0] == "a");
+        REQUIRE(arr.at(2) == "c");
+        REQUIRE_THROWS_AS(arr.at(3), std::out_of_range);
+
+        std::vector<std::string_view> seen(arr.begin(), arr.end());
+        REQUIRE(seen == std::vector<std::string_view>{"a", "b", "c"});
+        REQUIRE(arr.to_vector() == db.lrange("list", 0, -1));
+    }
+
+    SECTION("lindex_view") {
+        db.rpush("list", {"a", "b", "c"});
+        REQUIRE(db.lindex_view("list", -1).view() == "c");
+        REQUIRE_FALSE(db.lindex_view("list", 10));
+    }
+
+    SECTION("smembers_view") {
+        db.sadd("set", {"x", "y"});
+        auto arr = db.smembers_view("set");
+        std::vector<std::string_view> members(arr.begin(), arr.end());
+        std::sort(members.begin(), members.end());
+        REQUIRE(members == std::vector<std::string_view>{"x", "y"});
+    }
+
+    SECTION("zrange_view and zrevrange_view") {
+        db.zadd("z", {{1, "one"}, {2, "two"}, {3, "three"}});
+        auto fwd = db.zrange_view("z", 0, -1);
+        REQUIRE(fwd.size() == 3);
+        REQUIRE(fwd[0] == "one");
+        auto rev = db.zrevrange_view("z", 0, 0);
+        REQUIRE(rev.size() == 1);
+        REQUIRE(rev[0] == "three");
+    }
+
+    SECTION("mget_view and hvals_view") {
+        db.set("k1", "v1");
+        db.set("k2", "v2");
+        auto arr = db.mget_view({"k1", "k2"});
+        REQUIRE(arr.size() == 2);
+        REQUIRE(arr[0] == "v1");
+        REQUIRE(arr[1] == "v2");
+
+        db.hset("h", "f", "v");
+        auto vals = db.hvals_view("h");
+        REQUIRE(vals.size() == 1);
+        REQUIRE(vals[0] == "v");
+    }
+
+    SECTION("empty results") {
+        auto arr = db.lrange_view("nolist", 0, -1);
+        REQUIRE(arr.empty());
+        REQUIRE(arr.begin() == arr.end());
+    }
+
+    SECTION("BytesArray is movable") {
+        db.rpush("list", {"a", "b"});
+        auto arr = db.lrange_view("list", 0, -1);
+        BytesArray moved = std::move(arr);
+        REQUIRE(moved.size() == 2);
+        REQUIRE(arr.empty());
+    }
+}
+
+// Run with: ./test_views "[benchmark]"
+TEST_CASE("Zero-copy views vs copying reads", "[.][benchmark]") {
+    auto db = Database::open_memory();
+    std::hash<std::string_view> hasher;
+
+    for (size_t size : {2048u, 65536u}) {
+        const std::string value(size, 'x');
+        db.set("blob", value);
+
+        BENCHMARK("get " + std::to_string(size) + "B") {
+            auto v = db.get("blob");
+            return hasher(*v);
+        };
+
+        BENCHMARK("get_view " + std::to_string(size) + "B") {
+            auto b = db.get_view("blob");
+            return hasher(b.view());
+        };
+    }
+
+    std::vector<std::string> items(1000, std::string(256, 'y'));
+    db.rpush("list", items);
+
+    BENCHMARK("lrange 1000x256B") {
+        size_t h = 0;
+        for (const auto& v : db.lrange("list", 0, -1)) h ^= hasher(v);
+        return h;
+    };
+
+    BENCHMARK("lrange_view 1000x256B") {
+        size_t h = 0;
+        for (auto v : db.lrange_view("list", 0, -1)) h ^= hasher(v);
+        return h;
+    };
+}
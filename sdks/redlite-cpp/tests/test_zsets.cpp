@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
 #include <redlite/redlite.hpp>
+#include <chrono>
+#include <cstdio>
 
 using namespace redlite;
 using Catch::Approx;
@@ -148,4 +150,120 @@ TEST_CASE("Sorted set commands", "[zsets]") {
         REQUIRE(range[1] == "c");
         REQUIRE(range[2] == "a");
     }
+
+    SECTION("Binary scores keep full precision") {
+        db.zadd("myzset", {{0.1, "a"}, {1e300, "b"}, {-2.5e-8, "c"}});
+
+        auto range = db.zrange_with_scores_view("myzset", 0, -1);
+        REQUIRE(range.size() == 3);
+        REQUIRE(range[0].member == "c");
+        REQUIRE(range[0].score == -2.5e-8);
+        REQUIRE(range[1].score == 0.1);
+        REQUIRE(range[2].score == 1e300);
+
+        auto rev = db.zrevrange_with_scores("myzset", 0, 0);
+        REQUIRE(rev.size() == 1);
+        REQUIRE(rev[0].member == "b");
+        REQUIRE(db.zrange_with_scores_view("nonexistent", 0, -1).empty());
+    }
+
+    SECTION("Binary-safe members") {
+        std::string member("a\0b", 3);
+        db.zadd("myzset", {{1.0, member}, {2.0, ""}});
+
+        auto range = db.zrange_with_scores_view("myzset", 0, -1);
+        REQUIRE(range[0].member == member);
+        REQUIRE(range[1].member.empty());
+        REQUIRE(db.zrank("myzset", member) == 0);
+    }
+
+    SECTION("ZRANGEBYSCORE with and without LIMIT") {
+        db.zadd("myzset", {{1.0, "a"}, {2.0, "b"}, {3.0, "c"}, {4.0, "d"}});
+
+        REQUIRE(db.zrangebyscore("myzset", 2.0, 3.0) == std::vector<std::string>{"b", "c"});
+        auto limited = db.zrangebyscore_with_scores("myzset", 1.0, 4.0, 1, 2);
+        REQUIRE(limited.size() == 2);
+        REQUIRE(limited[0].member == "b");
+        REQUIRE(limited[1].score == Approx(3.0));
+
+        size_t n = 0;
+        for (auto m : db.zrangebyscore_with_scores_view("myzset", 3.0, 10.0)) {
+            REQUIRE(m.score >= 3.0);
+            ++n;
+        }
+        REQUIRE(n == 2);
+    }
+
+    SECTION("ZRANK and ZREVRANK") {
+        db.zadd("myzset", {{1.0, "a"}, {2.0, "b"}, {3.0, "c"}});
+
+        REQUIRE(db.zrank("myzset", "a") == 0);
+        REQUIRE(db.zrank("myzset", "c") == 2);
+        REQUIRE(db.zrevrank("myzset", "c") == 0);
+        REQUIRE_FALSE(db.zrank("myzset", "nonexistent"));
+        REQUIRE_FALSE(db.zrevrank("nonexistent", "a"));
+    }
+
+    SECTION("ZUNIONSTORE and ZINTERSTORE") {
+        db.zadd("z1", {{1.0, "a"}, {2.0, "b"}});
+        db.zadd("z2", {{10.0, "b"}, {20.0, "c"}});
+
+        REQUIRE(db.zunionstore("union", {"z1", "z2"}) == 3);
+        REQUIRE(db.zscore("union", "b").value() == Approx(12.0));
+
+        REQUIRE(db.zinterstore("inter", {"z1", "z2"}, {2.0, 1.0}) == 1);
+        REQUIRE(db.zscore("inter", "b").value() == Approx(14.0));
+
+        REQUIRE(db.zinterstore("inter", {"z1", "z2"}, {}, "MAX") == 1);
+        REQUIRE(db.zscore("inter", "b").value() == Approx(10.0));
+
+        REQUIRE_THROWS_AS(db.zunionstore("union", {}), Error);
+    }
+}
+
+// Run with: ./test_zsets "[benchmark]"
+// Compares top-1000 ranges with text scores against the binary transport.
+TEST_CASE("Scored range throughput", "[.][benchmark]") {
+    constexpr int kMembers = 100000;
+    constexpr int kQueries = 2000;
+    const char* path = "bench_zsets.db";
+    std::remove(path);
+    Database db(path);
+    {
+        std::vector<ZMember> members;
+        members.reserve(kMembers);
+        for (int i = 0; i < kMembers; ++i) members.emplace_back(i * 1.37, "player:" + std::to_string(i));
+        db.zadd("board", members);
+    }
+
+    auto time = [&](auto&& op) {
+        auto start = std::chrono::steady_clock::now();
+        size_t total = 0;
+        for (int i = 0; i < kQueries; ++i) total += op();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        REQUIRE(total == static_cast<size_t>(kQueries) * 1000);
+        return kQueries / elapsed.count();
+    };
+
+    // Previous transport: scores formatted by the FFI and parsed back with stod
+    RedliteDb* raw = redlite_open(path);
+    double text = time([&] {
+        RedliteBytesArray arr = redlite_zrevrange_len(raw, "board", 5, 0, 999, 1);
+        size_t n = 0;
+        for (size_t i = 0; i + 1 < arr.len; i += 2) {
+            std::string score(reinterpret_cast<const char*>(arr.items[i + 1].data), arr.items[i + 1].len);
+            n += std::stod(score) >= 0;
+        }
+        redlite_free_bytes_array(arr);
+        return n;
+    });
+    redlite_close(raw);
+    double binary = time([&] { return db.zrevrange_with_scores_view("board", 0, 999).size(); });
+    double copied = time([&] { return db.zrevrange_with_scores("board", 0, 999).size(); });
+
+    std::printf("%24s %12s\n", "top-1000", "ranges/s");
+    std::printf("%24s %12.0f\n", "text scores (stod)", text);
+    std::printf("%24s %12.0f\n", "binary view", binary);
+    std::printf("%24s %12.0f\n", "binary to_vector", copied);
+    std::remove(path);
 }